@@ -0,0 +1,1204 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <inttypes.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <seagrass.h>
+#include <coral.h>
+
+/*
+ * aquarium-coral-bench
+ *
+ * Measures throughput (ops/sec) and p50/p99 latency (ns) of the hot
+ * operations of every container for growing entry counts and different
+ * key patterns.
+ *
+ *  -c <container>  array_list, linked_list, btree_container,
+ *                  hash_container, linked_hash_container,
+ *                  red_black_tree_container,
+ *                  linked_red_black_tree_container,
+ *                  typed_red_black_tree_container,
+ *                  concurrent_red_black_tree_container,
+ *                  concurrent_skip_list_container, sharded_container
+ *                  or all (default).
+ *  -p <pattern>    sequential, random, zipfian or all (default).
+ *  -m <count>      smallest entry count (default 1000).
+ *  -M <count>      largest entry count (default 1000000), the count is
+ *                  multiplied by ten per run so -M 100000000 covers 1K to
+ *                  100M entries.
+ *  -s <count>      maximum number of latency samples per operation
+ *                  (default 100000).
+ *  -a <allocator>  system (default) or pool to allocate the entries and
+ *                  items of each container from a coral_entry_pool, but
+ *                  for the concurrent skip list whose entries vary in size.
+ *  -t <threads>    largest thread count for the concurrent and sharded
+ *                  containers (default the number of processors), run with
+ *                  1, 2, 4 … threads up to it.
+ *
+ * Keys are unique so the insertion order is either sequential or a random
+ * permutation, while lookups follow the pattern: sequential, uniformly
+ * random or zipfian (theta 0.99) over the inserted keys. Entries hold the
+ * odd value 2 * key + 1 so that ceiling/floor/higher/lower probes with the
+ * even values on either side always fall between two entries.
+ *
+ * The concurrent and sharded containers report "get xN" and "mixed xN"
+ * rows instead, the ops/sec of N threads sharing the lookups, without
+ * latencies.
+ */
+
+#define BENCH_ZIPFIAN_THETA     0.99
+#define BENCH_POOL_SLAB_COUNT   4096
+
+enum bench_pattern {
+    BENCH_PATTERN_SEQUENTIAL,
+    BENCH_PATTERN_RANDOM,
+    BENCH_PATTERN_ZIPFIAN,
+    BENCH_PATTERN_COUNT
+};
+
+static const char *bench_pattern_names[] = {
+        "sequential",
+        "random",
+        "zipfian"
+};
+
+struct bench_zipfian {
+    uintmax_t count;
+    double zeta_n;
+    double alpha;
+    double eta;
+};
+
+struct bench {
+    enum bench_pattern pattern;
+    uintmax_t count;
+    uintmax_t *insert;      /* order in which keys are inserted */
+    uintmax_t *lookup;      /* order in which keys are looked up */
+    uintmax_t stride;       /* sample latency of every stride-th operation */
+    uint64_t *samples;
+    uintmax_t limit;        /* capacity of samples */
+    uintmax_t sampled;
+};
+
+static uint64_t state = 0x9e3779b97f4a7c15;
+
+static uint64_t bench_random(void) {
+    /* splitmix64 */
+    uint64_t z = (state += 0x9e3779b97f4a7c15);
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111eb;
+    return z ^ (z >> 31);
+}
+
+static double bench_random_double(void) {
+    return (double) (bench_random() >> 11) * 0x1.0p-53;
+}
+
+static void bench_zipfian_init(struct bench_zipfian *const object,
+                               const uintmax_t count) {
+    double zeta_2 = 0;
+    object->count = count;
+    object->zeta_n = 0;
+    for (uintmax_t i = 1; i <= count; i++) {
+        object->zeta_n += 1.0 / pow((double) i, BENCH_ZIPFIAN_THETA);
+        if (2 == i) {
+            zeta_2 = object->zeta_n;
+        }
+    }
+    object->alpha = 1.0 / (1.0 - BENCH_ZIPFIAN_THETA);
+    object->eta = (1.0 - pow(2.0 / (double) count,
+                             1.0 - BENCH_ZIPFIAN_THETA))
+                  / (1.0 - zeta_2 / object->zeta_n);
+}
+
+static uintmax_t bench_zipfian_next(const struct bench_zipfian *const object) {
+    const double u = bench_random_double();
+    const double uz = u * object->zeta_n;
+    if (uz < 1.0) {
+        return 0;
+    }
+    if (uz < 1.0 + pow(0.5, BENCH_ZIPFIAN_THETA)) {
+        return 1 < object->count ? 1 : 0;
+    }
+    const uintmax_t result = (uintmax_t) (
+            (double) object->count
+            * pow(object->eta * u - object->eta + 1.0, object->alpha));
+    return result < object->count ? result : object->count - 1;
+}
+
+static uint64_t bench_now(void) {
+    struct timespec ts;
+    seagrass_required_true(!clock_gettime(CLOCK_MONOTONIC, &ts));
+    return (uint64_t) ts.tv_sec * 1000000000u + (uint64_t) ts.tv_nsec;
+}
+
+static int bench_compare_uint64_t(const void *const a, const void *const b) {
+    const uint64_t A = *(const uint64_t *) a;
+    const uint64_t B = *(const uint64_t *) b;
+    return A < B ? -1 : A > B;
+}
+
+static int compare(const void *const a, const void *const b) {
+    return seagrass_uintmax_t_ptr_compare(a, b);
+}
+
+CORAL_TYPED_RED_BLACK_TREE_CONTAINER_DECLARE(
+        bench_uintmax_t_tree, uintmax_t,
+        CORAL_TYPED_RED_BLACK_TREE_CONTAINER_COMPARE)
+
+static void bench_init(struct bench *const object,
+                       const enum bench_pattern pattern,
+                       const uintmax_t count,
+                       const uintmax_t limit) {
+    *object = (struct bench) {
+            .pattern = pattern,
+            .count = count,
+            .limit = limit,
+            .stride = count > limit ? count / limit : 1
+    };
+    seagrass_required_true(NULL != (
+            object->insert = malloc(count * sizeof(uintmax_t))));
+    seagrass_required_true(NULL != (
+            object->lookup = malloc(count * sizeof(uintmax_t))));
+    seagrass_required_true(NULL != (
+            object->samples = malloc(limit * sizeof(uint64_t))));
+    for (uintmax_t i = 0; i < count; i++) {
+        object->insert[i] = i;
+    }
+    if (BENCH_PATTERN_SEQUENTIAL != pattern) {
+        for (uintmax_t i = count - 1; i > 0; i--) {
+            const uintmax_t j = bench_random() % (i + 1);
+            const uintmax_t swap = object->insert[i];
+            object->insert[i] = object->insert[j];
+            object->insert[j] = swap;
+        }
+    }
+    switch (pattern) {
+        case BENCH_PATTERN_SEQUENTIAL: {
+            for (uintmax_t i = 0; i < count; i++) {
+                object->lookup[i] = i;
+            }
+            break;
+        }
+        case BENCH_PATTERN_RANDOM: {
+            for (uintmax_t i = 0; i < count; i++) {
+                object->lookup[i] = object->insert[bench_random() % count];
+            }
+            break;
+        }
+        default: {
+            struct bench_zipfian zipfian;
+            bench_zipfian_init(&zipfian, count);
+            for (uintmax_t i = 0; i < count; i++) {
+                object->lookup[i] = object->insert[
+                        bench_zipfian_next(&zipfian)];
+            }
+            break;
+        }
+    }
+}
+
+static void bench_invalidate(struct bench *const object) {
+    free(object->insert);
+    free(object->lookup);
+    free(object->samples);
+    *object = (struct bench) {0};
+}
+
+static void bench_begin(struct bench *const object) {
+    object->sampled = 0;
+}
+
+static inline bool bench_is_sampled(const struct bench *const object,
+                                    const uintmax_t i) {
+    return !(i % object->stride) && object->sampled < object->limit;
+}
+
+static inline void bench_sample(struct bench *const object,
+                                const uint64_t start) {
+    object->samples[object->sampled++] = bench_now() - start;
+}
+
+static void bench_report(struct bench *const object,
+                         const char *const container,
+                         const char *const operation,
+                         const uintmax_t operations,
+                         const uint64_t elapsed) {
+    const double seconds = (double) (elapsed ? elapsed : 1) / 1e9;
+    printf("%-36s %-10s %10ju %-16s %14.0f",
+           container,
+           bench_pattern_names[object->pattern],
+           object->count,
+           operation,
+           (double) operations / seconds);
+    if (object->sampled) {
+        qsort(object->samples, object->sampled, sizeof(uint64_t),
+              bench_compare_uint64_t);
+        const uintmax_t p50 = object->sampled / 2;
+        const uintmax_t p99 = (object->sampled * 99) / 100;
+        printf(" %10ju %10ju\n",
+               (uintmax_t) object->samples[p50],
+               (uintmax_t) object->samples[p99]);
+    } else {
+        printf(" %10s %10s\n", "-", "-");
+    }
+    fflush(stdout);
+}
+
+/*
+ * Each loop below times the whole run for throughput and, on sampled
+ * iterations, also times the single operation for the latency percentiles.
+ */
+#define BENCH_LOOP(object, elapsed, i, ...) \
+    do { \
+        bench_begin(object); \
+        const uint64_t bench_start_ = bench_now(); \
+        for (uintmax_t i = 0; i < (object)->count; i++) { \
+            if (bench_is_sampled(object, i)) { \
+                const uint64_t bench_at_ = bench_now(); \
+                __VA_ARGS__ \
+                bench_sample(object, bench_at_); \
+            } else { \
+                __VA_ARGS__ \
+            } \
+        } \
+        (elapsed) = bench_now() - bench_start_; \
+    } while (0)
+
+static void bench_array_list(struct bench *const object) {
+    const char *const name = "array_list";
+    uint64_t elapsed;
+    struct coral_array_list list;
+    seagrass_required_true(!coral_array_list_init(
+            &list, sizeof(uintmax_t), 0));
+    BENCH_LOOP(object, elapsed, i, {
+        const uintmax_t value = 2 * object->insert[i] + 1;
+        seagrass_required_true(!coral_array_list_add(&list, &value));
+    });
+    bench_report(object, name, "add", object->count, elapsed);
+    uintmax_t sum = 0;
+    BENCH_LOOP(object, elapsed, i, {
+        uintmax_t *value;
+        seagrass_required_true(!coral_array_list_get(
+                &list, object->lookup[i], (void **) &value));
+        sum += *value;
+    });
+    bench_report(object, name, "get", object->count, elapsed);
+    uintmax_t *item;
+    seagrass_required_true(!coral_array_list_first(&list, (void **) &item));
+    BENCH_LOOP(object, elapsed, i, {
+        sum += *item;
+        if (i + 1 < object->count) {
+            seagrass_required_true(!coral_array_list_next(
+                    &list, item, (void **) &item));
+        }
+    });
+    bench_report(object, name, "next", object->count, elapsed);
+    BENCH_LOOP(object, elapsed, i, {
+        seagrass_required_true(!coral_array_list_remove_last(&list));
+    });
+    bench_report(object, name, "remove_last", object->count, elapsed);
+    seagrass_required_true(!coral_array_list_set_length(
+            &list, object->count));
+    bench_begin(object);
+    const uint64_t start = bench_now();
+    seagrass_required_true(!coral_array_list_invalidate(&list, NULL));
+    bench_report(object, name, "invalidate", object->count,
+                 bench_now() - start);
+    seagrass_required_true(sum || object->count <= 1);
+}
+
+static void bench_linked_list(struct bench *const object) {
+    const char *const name = "linked_list";
+    uint64_t elapsed;
+    struct coral_linked_list list;
+    seagrass_required_true(!coral_linked_list_init(&list));
+    union {
+        struct coral_linked_list_item *item;
+        uintmax_t *value;
+    } *items, ptr;
+    seagrass_required_true(NULL != (
+            items = malloc(object->count * sizeof(*items))));
+    for (uintmax_t i = 0; i < object->count; i++) {
+        seagrass_required_true(!coral_linked_list_alloc(
+                sizeof(uintmax_t), &items[i].item));
+        *items[i].value = 2 * object->insert[i] + 1;
+    }
+    BENCH_LOOP(object, elapsed, i, {
+        seagrass_required_true(!coral_linked_list_add(&list, items[i].item));
+    });
+    bench_report(object, name, "add", object->count, elapsed);
+    uintmax_t sum = 0;
+    seagrass_required_true(!coral_linked_list_first(&list, &ptr.item));
+    BENCH_LOOP(object, elapsed, i, {
+        sum += *ptr.value;
+        if (i + 1 < object->count) {
+            seagrass_required_true(!coral_linked_list_next(
+                    &list, ptr.item, &ptr.item));
+        }
+    });
+    bench_report(object, name, "next", object->count, elapsed);
+    BENCH_LOOP(object, elapsed, i, {
+        seagrass_required_true(!coral_linked_list_remove(
+                &list, items[i].item));
+    });
+    bench_report(object, name, "remove", object->count, elapsed);
+    for (uintmax_t i = 0; i < object->count; i++) {
+        seagrass_required_true(!coral_linked_list_add(&list, items[i].item));
+    }
+    bench_begin(object);
+    const uint64_t start = bench_now();
+    seagrass_required_true(!coral_linked_list_invalidate(&list, NULL));
+    bench_report(object, name, "invalidate", object->count,
+                 bench_now() - start);
+    free(items);
+    seagrass_required_true(sum || object->count <= 1);
+}
+
+static void bench_btree_container(struct bench *const object) {
+    const char *const name = "btree_container";
+    uint64_t elapsed;
+    struct coral_btree_container tree;
+    seagrass_required_true(!coral_btree_container_init(
+            &tree, compare));
+    union {
+        struct coral_btree_container_entry *entry;
+        uintmax_t *value;
+    } *items, ptr;
+    seagrass_required_true(NULL != (
+            items = malloc(object->count * sizeof(*items))));
+    for (uintmax_t i = 0; i < object->count; i++) {
+        seagrass_required_true(!coral_btree_container_alloc(
+                sizeof(uintmax_t), &items[i].entry));
+        *items[i].value = 2 * object->insert[i] + 1;
+    }
+    BENCH_LOOP(object, elapsed, i, {
+        seagrass_required_true(!coral_btree_container_add(
+                &tree, items[i].entry));
+    });
+    bench_report(object, name, "add", object->count, elapsed);
+    BENCH_LOOP(object, elapsed, i, {
+        const uintmax_t key = 2 * object->lookup[i] + 1;
+        seagrass_required_true(!coral_btree_container_get(
+                &tree, &key, &ptr.entry));
+    });
+    bench_report(object, name, "get", object->count, elapsed);
+    BENCH_LOOP(object, elapsed, i, {
+        const uintmax_t key = 2 * object->lookup[i];
+        seagrass_required_true(!coral_btree_container_ceiling(
+                &tree, &key, &ptr.entry));
+    });
+    bench_report(object, name, "ceiling", object->count, elapsed);
+    BENCH_LOOP(object, elapsed, i, {
+        const uintmax_t key = 2 * object->lookup[i] + 2;
+        seagrass_required_true(!coral_btree_container_floor(
+                &tree, &key, &ptr.entry));
+    });
+    bench_report(object, name, "floor", object->count, elapsed);
+    BENCH_LOOP(object, elapsed, i, {
+        const uintmax_t key = 2 * object->lookup[i];
+        seagrass_required_true(!coral_btree_container_higher(
+                &tree, &key, &ptr.entry));
+    });
+    bench_report(object, name, "higher", object->count, elapsed);
+    BENCH_LOOP(object, elapsed, i, {
+        const uintmax_t key = 2 * object->lookup[i] + 2;
+        seagrass_required_true(!coral_btree_container_lower(
+                &tree, &key, &ptr.entry));
+    });
+    bench_report(object, name, "lower", object->count, elapsed);
+    uintmax_t sum = 0;
+    seagrass_required_true(!coral_btree_container_first(
+            &tree, &ptr.entry));
+    BENCH_LOOP(object, elapsed, i, {
+        sum += *ptr.value;
+        if (i + 1 < object->count) {
+            seagrass_required_true(!coral_btree_container_next(
+                    ptr.entry, &ptr.entry));
+        }
+    });
+    bench_report(object, name, "next", object->count, elapsed);
+    BENCH_LOOP(object, elapsed, i, {
+        seagrass_required_true(!coral_btree_container_remove(
+                &tree, items[i].entry));
+    });
+    bench_report(object, name, "remove", object->count, elapsed);
+    for (uintmax_t i = 0; i < object->count; i++) {
+        seagrass_required_true(!coral_btree_container_add(
+                &tree, items[i].entry));
+    }
+    bench_begin(object);
+    const uint64_t start = bench_now();
+    seagrass_required_true(!coral_btree_container_invalidate(
+            &tree, NULL));
+    bench_report(object, name, "invalidate", object->count,
+                 bench_now() - start);
+    free(items);
+    seagrass_required_true(sum || object->count <= 1);
+}
+
+static size_t hash(const void *const a) {
+    return (size_t) *(const uintmax_t *) a;
+}
+
+static void bench_hash_container(struct bench *const object) {
+    const char *const name = "hash_container";
+    uint64_t elapsed;
+    struct coral_hash_container table;
+    seagrass_required_true(!coral_hash_container_init(
+            &table, hash, compare));
+    union {
+        struct coral_hash_container_entry *entry;
+        uintmax_t *value;
+    } *items, ptr;
+    seagrass_required_true(NULL != (
+            items = malloc(object->count * sizeof(*items))));
+    for (uintmax_t i = 0; i < object->count; i++) {
+        seagrass_required_true(!coral_hash_container_alloc(
+                sizeof(uintmax_t), &items[i].entry));
+        *items[i].value = 2 * object->insert[i] + 1;
+    }
+    BENCH_LOOP(object, elapsed, i, {
+        seagrass_required_true(!coral_hash_container_add(
+                &table, items[i].entry));
+    });
+    bench_report(object, name, "add", object->count, elapsed);
+    BENCH_LOOP(object, elapsed, i, {
+        const uintmax_t key = 2 * object->lookup[i] + 1;
+        seagrass_required_true(!coral_hash_container_get(
+                &table, &key, &ptr.entry));
+    });
+    bench_report(object, name, "get", object->count, elapsed);
+    uintmax_t sum = 0;
+    seagrass_required_true(!coral_hash_container_first(
+            &table, &ptr.entry));
+    BENCH_LOOP(object, elapsed, i, {
+        sum += *ptr.value;
+        if (i + 1 < object->count) {
+            seagrass_required_true(!coral_hash_container_next(
+                    &table, ptr.entry, &ptr.entry));
+        }
+    });
+    bench_report(object, name, "next", object->count, elapsed);
+    BENCH_LOOP(object, elapsed, i, {
+        seagrass_required_true(!coral_hash_container_remove(
+                &table, items[i].entry));
+    });
+    bench_report(object, name, "remove", object->count, elapsed);
+    for (uintmax_t i = 0; i < object->count; i++) {
+        seagrass_required_true(!coral_hash_container_add(
+                &table, items[i].entry));
+    }
+    bench_begin(object);
+    const uint64_t start = bench_now();
+    seagrass_required_true(!coral_hash_container_invalidate(
+            &table, NULL));
+    bench_report(object, name, "invalidate", object->count,
+                 bench_now() - start);
+    free(items);
+    seagrass_required_true(sum || object->count <= 1);
+}
+
+static void bench_linked_hash_container(struct bench *const object) {
+    const char *const name = "linked_hash_container";
+    uint64_t elapsed;
+    struct coral_linked_hash_container table;
+    seagrass_required_true(!coral_linked_hash_container_init(
+            &table, hash, compare));
+    union {
+        struct coral_linked_hash_container_entry *entry;
+        uintmax_t *value;
+    } *items, ptr;
+    seagrass_required_true(NULL != (
+            items = malloc(object->count * sizeof(*items))));
+    for (uintmax_t i = 0; i < object->count; i++) {
+        seagrass_required_true(!coral_linked_hash_container_alloc(
+                sizeof(uintmax_t), &items[i].entry));
+        *items[i].value = 2 * object->insert[i] + 1;
+    }
+    BENCH_LOOP(object, elapsed, i, {
+        seagrass_required_true(!coral_linked_hash_container_add(
+                &table, items[i].entry));
+    });
+    bench_report(object, name, "add", object->count, elapsed);
+    BENCH_LOOP(object, elapsed, i, {
+        const uintmax_t key = 2 * object->lookup[i] + 1;
+        seagrass_required_true(!coral_linked_hash_container_get(
+                &table, &key, &ptr.entry));
+    });
+    bench_report(object, name, "get", object->count, elapsed);
+    uintmax_t sum = 0;
+    seagrass_required_true(!coral_linked_hash_container_first(
+            &table, &ptr.entry));
+    BENCH_LOOP(object, elapsed, i, {
+        sum += *ptr.value;
+        if (i + 1 < object->count) {
+            seagrass_required_true(!coral_linked_hash_container_next(
+                    &table, ptr.entry, &ptr.entry));
+        }
+    });
+    bench_report(object, name, "next", object->count, elapsed);
+    BENCH_LOOP(object, elapsed, i, {
+        seagrass_required_true(!coral_linked_hash_container_remove(
+                &table, items[i].entry));
+    });
+    bench_report(object, name, "remove", object->count, elapsed);
+    for (uintmax_t i = 0; i < object->count; i++) {
+        seagrass_required_true(!coral_linked_hash_container_add(
+                &table, items[i].entry));
+    }
+    bench_begin(object);
+    const uint64_t start = bench_now();
+    seagrass_required_true(!coral_linked_hash_container_invalidate(
+            &table, NULL));
+    bench_report(object, name, "invalidate", object->count,
+                 bench_now() - start);
+    free(items);
+    seagrass_required_true(sum || object->count <= 1);
+}
+
+static void bench_red_black_tree_container(struct bench *const object) {
+    const char *const name = "red_black_tree_container";
+    uint64_t elapsed;
+    struct coral_red_black_tree_container tree;
+    seagrass_required_true(!coral_red_black_tree_container_init(
+            &tree, compare));
+    union {
+        struct coral_red_black_tree_container_entry *entry;
+        uintmax_t *value;
+    } *items, ptr;
+    seagrass_required_true(NULL != (
+            items = malloc(object->count * sizeof(*items))));
+    for (uintmax_t i = 0; i < object->count; i++) {
+        seagrass_required_true(!coral_red_black_tree_container_alloc(
+                sizeof(uintmax_t), &items[i].entry));
+        *items[i].value = 2 * object->insert[i] + 1;
+    }
+    BENCH_LOOP(object, elapsed, i, {
+        seagrass_required_true(!coral_red_black_tree_container_add(
+                &tree, items[i].entry));
+    });
+    bench_report(object, name, "add", object->count, elapsed);
+    BENCH_LOOP(object, elapsed, i, {
+        const uintmax_t key = 2 * object->lookup[i] + 1;
+        seagrass_required_true(!coral_red_black_tree_container_get(
+                &tree, &key, &ptr.entry));
+    });
+    bench_report(object, name, "get", object->count, elapsed);
+    BENCH_LOOP(object, elapsed, i, {
+        const uintmax_t key = 2 * object->lookup[i];
+        seagrass_required_true(!coral_red_black_tree_container_ceiling(
+                &tree, &key, &ptr.entry));
+    });
+    bench_report(object, name, "ceiling", object->count, elapsed);
+    BENCH_LOOP(object, elapsed, i, {
+        const uintmax_t key = 2 * object->lookup[i] + 2;
+        seagrass_required_true(!coral_red_black_tree_container_floor(
+                &tree, &key, &ptr.entry));
+    });
+    bench_report(object, name, "floor", object->count, elapsed);
+    BENCH_LOOP(object, elapsed, i, {
+        const uintmax_t key = 2 * object->lookup[i];
+        seagrass_required_true(!coral_red_black_tree_container_higher(
+                &tree, &key, &ptr.entry));
+    });
+    bench_report(object, name, "higher", object->count, elapsed);
+    BENCH_LOOP(object, elapsed, i, {
+        const uintmax_t key = 2 * object->lookup[i] + 2;
+        seagrass_required_true(!coral_red_black_tree_container_lower(
+                &tree, &key, &ptr.entry));
+    });
+    bench_report(object, name, "lower", object->count, elapsed);
+    uintmax_t sum = 0;
+    seagrass_required_true(!coral_red_black_tree_container_first(
+            &tree, &ptr.entry));
+    BENCH_LOOP(object, elapsed, i, {
+        sum += *ptr.value;
+        if (i + 1 < object->count) {
+            seagrass_required_true(!coral_red_black_tree_container_next(
+                    ptr.entry, &ptr.entry));
+        }
+    });
+    bench_report(object, name, "next", object->count, elapsed);
+    BENCH_LOOP(object, elapsed, i, {
+        seagrass_required_true(!coral_red_black_tree_container_remove(
+                &tree, items[i].entry));
+    });
+    bench_report(object, name, "remove", object->count, elapsed);
+    /* keys are a permutation of 0 .. count - 1 hence sorted by position */
+    struct coral_red_black_tree_container_entry **sorted;
+    seagrass_required_true(NULL != (
+            sorted = malloc(object->count * sizeof(*sorted))));
+    for (uintmax_t i = 0; i < object->count; i++) {
+        sorted[object->insert[i]] = items[i].entry;
+    }
+    bench_begin(object);
+    const uint64_t begin = bench_now();
+    seagrass_required_true(!coral_red_black_tree_container_build_sorted(
+            &tree, sorted, object->count));
+    bench_report(object, name, "build_sorted", object->count,
+                 bench_now() - begin);
+    free(sorted);
+    bench_begin(object);
+    const uint64_t start = bench_now();
+    seagrass_required_true(!coral_red_black_tree_container_invalidate(
+            &tree, NULL));
+    bench_report(object, name, "invalidate", object->count,
+                 bench_now() - start);
+    free(items);
+    seagrass_required_true(sum || object->count <= 1);
+}
+
+static void bench_linked_red_black_tree_container(struct bench *const object) {
+    const char *const name = "linked_red_black_tree_container";
+    uint64_t elapsed;
+    struct coral_linked_red_black_tree_container tree;
+    seagrass_required_true(!coral_linked_red_black_tree_container_init(
+            &tree, compare));
+    union {
+        struct coral_linked_red_black_tree_container_entry *entry;
+        uintmax_t *value;
+    } *items, ptr;
+    seagrass_required_true(NULL != (
+            items = malloc(object->count * sizeof(*items))));
+    for (uintmax_t i = 0; i < object->count; i++) {
+        seagrass_required_true(!coral_linked_red_black_tree_container_alloc(
+                sizeof(uintmax_t), &items[i].entry));
+        *items[i].value = 2 * object->insert[i] + 1;
+    }
+    BENCH_LOOP(object, elapsed, i, {
+        seagrass_required_true(!coral_linked_red_black_tree_container_add(
+                &tree, items[i].entry));
+    });
+    bench_report(object, name, "add", object->count, elapsed);
+    BENCH_LOOP(object, elapsed, i, {
+        const uintmax_t key = 2 * object->lookup[i] + 1;
+        seagrass_required_true(!coral_linked_red_black_tree_container_get(
+                &tree, &key, &ptr.entry));
+    });
+    bench_report(object, name, "get", object->count, elapsed);
+    BENCH_LOOP(object, elapsed, i, {
+        const uintmax_t key = 2 * object->lookup[i];
+        seagrass_required_true(!coral_linked_red_black_tree_container_ceiling(
+                &tree, &key, &ptr.entry));
+    });
+    bench_report(object, name, "ceiling", object->count, elapsed);
+    BENCH_LOOP(object, elapsed, i, {
+        const uintmax_t key = 2 * object->lookup[i] + 2;
+        seagrass_required_true(!coral_linked_red_black_tree_container_floor(
+                &tree, &key, &ptr.entry));
+    });
+    bench_report(object, name, "floor", object->count, elapsed);
+    BENCH_LOOP(object, elapsed, i, {
+        const uintmax_t key = 2 * object->lookup[i];
+        seagrass_required_true(!coral_linked_red_black_tree_container_higher(
+                &tree, &key, &ptr.entry));
+    });
+    bench_report(object, name, "higher", object->count, elapsed);
+    BENCH_LOOP(object, elapsed, i, {
+        const uintmax_t key = 2 * object->lookup[i] + 2;
+        seagrass_required_true(!coral_linked_red_black_tree_container_lower(
+                &tree, &key, &ptr.entry));
+    });
+    bench_report(object, name, "lower", object->count, elapsed);
+    uintmax_t sum = 0;
+    seagrass_required_true(!coral_linked_red_black_tree_container_sorted_first(
+            &tree, &ptr.entry));
+    BENCH_LOOP(object, elapsed, i, {
+        sum += *ptr.value;
+        if (i + 1 < object->count) {
+            seagrass_required_true(
+                    !coral_linked_red_black_tree_container_sorted_next(
+                            ptr.entry, &ptr.entry));
+        }
+    });
+    bench_report(object, name, "sorted_next", object->count, elapsed);
+    seagrass_required_true(!coral_linked_red_black_tree_container_first(
+            &tree, &ptr.entry));
+    BENCH_LOOP(object, elapsed, i, {
+        sum += *ptr.value;
+        if (i + 1 < object->count) {
+            seagrass_required_true(!coral_linked_red_black_tree_container_next(
+                    &tree, ptr.entry, &ptr.entry));
+        }
+    });
+    bench_report(object, name, "next", object->count, elapsed);
+    BENCH_LOOP(object, elapsed, i, {
+        seagrass_required_true(!coral_linked_red_black_tree_container_remove(
+                &tree, items[i].entry));
+    });
+    bench_report(object, name, "remove", object->count, elapsed);
+    /* keys are a permutation of 0 .. count - 1 hence sorted by position */
+    struct coral_linked_red_black_tree_container_entry **sorted;
+    seagrass_required_true(NULL != (
+            sorted = malloc(object->count * sizeof(*sorted))));
+    for (uintmax_t i = 0; i < object->count; i++) {
+        sorted[object->insert[i]] = items[i].entry;
+    }
+    bench_begin(object);
+    const uint64_t begin = bench_now();
+    seagrass_required_true(!coral_linked_red_black_tree_container_build_sorted(
+            &tree, sorted, object->count));
+    bench_report(object, name, "build_sorted", object->count,
+                 bench_now() - begin);
+    free(sorted);
+    bench_begin(object);
+    const uint64_t start = bench_now();
+    seagrass_required_true(!coral_linked_red_black_tree_container_invalidate(
+            &tree, NULL));
+    bench_report(object, name, "invalidate", object->count,
+                 bench_now() - start);
+    free(items);
+    seagrass_required_true(sum || object->count <= 1);
+}
+
+static void bench_typed_red_black_tree_container(struct bench *const object) {
+    const char *const name = "typed_red_black_tree_container";
+    uint64_t elapsed;
+    struct bench_uintmax_t_tree tree;
+    seagrass_required_true(!bench_uintmax_t_tree_init(&tree));
+    BENCH_LOOP(object, elapsed, i, {
+        const uintmax_t value = 2 * object->insert[i] + 1;
+        seagrass_required_true(!bench_uintmax_t_tree_add(&tree, &value));
+    });
+    bench_report(object, name, "add", object->count, elapsed);
+    const uintmax_t *value = NULL;
+    BENCH_LOOP(object, elapsed, i, {
+        const uintmax_t key = 2 * object->lookup[i] + 1;
+        seagrass_required_true(!bench_uintmax_t_tree_get(
+                &tree, &key, &value));
+    });
+    bench_report(object, name, "get", object->count, elapsed);
+    uintmax_t sum = 0;
+    seagrass_required_true(!bench_uintmax_t_tree_first(&tree, &value));
+    BENCH_LOOP(object, elapsed, i, {
+        sum += *value;
+        if (i + 1 < object->count) {
+            seagrass_required_true(!bench_uintmax_t_tree_next(
+                    value, &value));
+        }
+    });
+    bench_report(object, name, "next", object->count, elapsed);
+    BENCH_LOOP(object, elapsed, i, {
+        const uintmax_t key = 2 * object->insert[i] + 1;
+        seagrass_required_true(!bench_uintmax_t_tree_remove(&tree, &key));
+    });
+    bench_report(object, name, "remove", object->count, elapsed);
+    for (uintmax_t i = 0; i < object->count; i++) {
+        const uintmax_t key = 2 * object->insert[i] + 1;
+        seagrass_required_true(!bench_uintmax_t_tree_add(&tree, &key));
+    }
+    bench_begin(object);
+    const uint64_t start = bench_now();
+    seagrass_required_true(!bench_uintmax_t_tree_invalidate(&tree, NULL));
+    bench_report(object, name, "invalidate", object->count,
+                 bench_now() - start);
+    seagrass_required_true(sum || object->count <= 1);
+}
+
+/*
+ * The concurrent and sharded containers are driven by 1, 2, 4 … up to
+ * bench_threads threads that split the lookups between them. With write set
+ * every other lookup replaces the entry it found with a spare one. Spares
+ * are allocated up front, an entry pool being no place for many threads,
+ * and replaced entries are only freed once every thread is done as other
+ * threads may still be looking at them.
+ */
+static uintmax_t bench_threads = 1;
+
+struct bench_worker {
+    struct bench *bench;
+    void *container;
+    uintmax_t first;
+    uintmax_t last;
+    bool write;
+    uintmax_t removed_count;
+    void **removed;
+    uintmax_t spare_count;
+    void **spares;
+};
+
+static void bench_scale(struct bench *const object,
+                        const char *const name,
+                        void *const container,
+                        void *(*const work)(void *),
+                        void *(*const acquire)(void),
+                        void (*const release)(void *),
+                        const bool write) {
+    for (uintmax_t threads = 1; threads <= bench_threads; threads *= 2) {
+        pthread_t *const ids = calloc(threads, sizeof(pthread_t));
+        struct bench_worker *const workers = calloc(
+                threads, sizeof(struct bench_worker));
+        seagrass_required_true(ids && workers);
+        for (uintmax_t i = 0; i < threads; i++) {
+            workers[i] = (struct bench_worker) {
+                    .bench = object,
+                    .container = container,
+                    .first = object->count * i / threads,
+                    .last = object->count * (i + 1) / threads,
+                    .write = write
+            };
+            const uintmax_t spares = write
+                    ? (workers[i].last - workers[i].first + 1) / 2 : 0;
+            seagrass_required_true(NULL != (workers[i].removed = malloc(
+                    (spares + 1) * sizeof(void *))));
+            seagrass_required_true(NULL != (workers[i].spares = malloc(
+                    (spares + 1) * sizeof(void *))));
+            for (; workers[i].spare_count < spares;
+                   workers[i].spare_count++) {
+                workers[i].spares[workers[i].spare_count] = acquire();
+            }
+        }
+        bench_begin(object);
+        const uint64_t start = bench_now();
+        for (uintmax_t i = 0; i < threads; i++) {
+            seagrass_required_true(!pthread_create(&ids[i], NULL, work,
+                                                   &workers[i]));
+        }
+        for (uintmax_t i = 0; i < threads; i++) {
+            seagrass_required_true(!pthread_join(ids[i], NULL));
+        }
+        const uint64_t elapsed = bench_now() - start;
+        char operation[32];
+        snprintf(operation, sizeof(operation), "%s x%ju",
+                 write ? "mixed" : "get", threads);
+        bench_report(object, name, operation, object->count, elapsed);
+        for (uintmax_t i = 0; i < threads; i++) {
+            for (uintmax_t j = 0; j < workers[i].removed_count; j++) {
+                release(workers[i].removed[j]);
+            }
+            for (uintmax_t j = 0; j < workers[i].spare_count; j++) {
+                release(workers[i].spares[j]);
+            }
+            free(workers[i].removed);
+            free(workers[i].spares);
+        }
+        free(workers);
+        free(ids);
+        if (threads > UINTMAX_MAX / 2) {
+            break;
+        }
+    }
+}
+
+struct bench_take {
+    const uintmax_t *key;
+    struct coral_red_black_tree_container_entry *entry;
+};
+
+/* looks up and removes the entry in one critical section so that no other
+ * thread can remove it in between */
+static int bench_concurrent_red_black_tree_container_take(
+        struct coral_red_black_tree_container *const container,
+        void *const context) {
+    struct bench_take *const take = context;
+    int error;
+    if ((error = coral_red_black_tree_container_get(
+            container, take->key, &take->entry))) {
+        return error;
+    }
+    return coral_red_black_tree_container_remove(container, take->entry);
+}
+
+static void *bench_concurrent_red_black_tree_container_work(
+        void *const argument) {
+    struct bench_worker *const worker = argument;
+    struct coral_concurrent_red_black_tree_container *const tree
+            = worker->container;
+    for (uintmax_t i = worker->first; i < worker->last; i++) {
+        const uintmax_t key = 2 * worker->bench->lookup[i] + 1;
+        struct coral_red_black_tree_container_entry *entry;
+        if (!worker->write || (i & 1)) {
+            coral_concurrent_red_black_tree_container_get(tree, &key, &entry);
+            continue;
+        }
+        struct bench_take take = {.key = &key};
+        if (coral_concurrent_red_black_tree_container_write(
+                tree, bench_concurrent_red_black_tree_container_take,
+                &take)) {
+            continue;
+        }
+        worker->removed[worker->removed_count++] = take.entry;
+        entry = worker->spares[--worker->spare_count];
+        *(uintmax_t *) entry = key;
+        if (coral_concurrent_red_black_tree_container_add(tree, entry)) {
+            worker->spares[worker->spare_count++] = entry;
+        }
+    }
+    return NULL;
+}
+
+static void *bench_concurrent_red_black_tree_container_acquire(void) {
+    struct coral_red_black_tree_container_entry *entry;
+    seagrass_required_true(!coral_red_black_tree_container_alloc(
+            sizeof(uintmax_t), &entry));
+    return entry;
+}
+
+static void bench_concurrent_red_black_tree_container_release(
+        void *const entry) {
+    seagrass_required_true(!coral_red_black_tree_container_free(entry));
+}
+
+static void bench_concurrent_red_black_tree_container(
+        struct bench *const object) {
+    const char *const name = "concurrent_red_black_tree_container";
+    struct coral_concurrent_red_black_tree_container tree;
+    seagrass_required_true(!coral_concurrent_red_black_tree_container_init(
+            &tree, compare));
+    for (uintmax_t i = 0; i < object->count; i++) {
+        struct coral_red_black_tree_container_entry *entry;
+        seagrass_required_true(!coral_red_black_tree_container_alloc(
+                sizeof(uintmax_t), &entry));
+        *(uintmax_t *) entry = 2 * object->insert[i] + 1;
+        seagrass_required_true(!coral_concurrent_red_black_tree_container_add(
+                &tree, entry));
+    }
+    bench_scale(object, name, &tree,
+                bench_concurrent_red_black_tree_container_work,
+                bench_concurrent_red_black_tree_container_acquire,
+                bench_concurrent_red_black_tree_container_release, false);
+    bench_scale(object, name, &tree,
+                bench_concurrent_red_black_tree_container_work,
+                bench_concurrent_red_black_tree_container_acquire,
+                bench_concurrent_red_black_tree_container_release, true);
+    seagrass_required_true(
+            !coral_concurrent_red_black_tree_container_invalidate(
+                    &tree, NULL));
+}
+
+static void *bench_concurrent_skip_list_container_work(void *const argument) {
+    struct bench_worker *const worker = argument;
+    struct coral_concurrent_skip_list_container *const list
+            = worker->container;
+    for (uintmax_t i = worker->first; i < worker->last; i++) {
+        const uintmax_t key = 2 * worker->bench->lookup[i] + 1;
+        struct coral_concurrent_skip_list_container_entry *entry;
+        if (coral_concurrent_skip_list_container_get(list, &key, &entry)
+            || !worker->write || (i & 1)) {
+            continue;
+        }
+        if (!coral_concurrent_skip_list_container_remove(list, entry)) {
+            worker->removed[worker->removed_count++] = entry;
+        }
+        entry = worker->spares[--worker->spare_count];
+        *(uintmax_t *) entry = key;
+        if (coral_concurrent_skip_list_container_add(list, entry)) {
+            worker->spares[worker->spare_count++] = entry;
+        }
+    }
+    return NULL;
+}
+
+static void *bench_concurrent_skip_list_container_acquire(void) {
+    struct coral_concurrent_skip_list_container_entry *entry;
+    seagrass_required_true(!coral_concurrent_skip_list_container_alloc(
+            sizeof(uintmax_t), &entry));
+    return entry;
+}
+
+static void bench_concurrent_skip_list_container_release(void *const entry) {
+    seagrass_required_true(!coral_concurrent_skip_list_container_free(entry));
+}
+
+static void bench_concurrent_skip_list_container(struct bench *const object) {
+    const char *const name = "concurrent_skip_list_container";
+    /* entries vary in size with their height so they cannot come from an
+     * entry pool, keep them on the system allocator */
+    const struct coral_allocator *allocator;
+    seagrass_required_true(!coral_allocator_get_default(&allocator));
+    seagrass_required_true(!coral_allocator_set_default(NULL));
+    struct coral_concurrent_skip_list_container list;
+    seagrass_required_true(!coral_concurrent_skip_list_container_init(
+            &list, compare));
+    for (uintmax_t i = 0; i < object->count; i++) {
+        struct coral_concurrent_skip_list_container_entry *entry;
+        seagrass_required_true(!coral_concurrent_skip_list_container_alloc(
+                sizeof(uintmax_t), &entry));
+        *(uintmax_t *) entry = 2 * object->insert[i] + 1;
+        seagrass_required_true(!coral_concurrent_skip_list_container_add(
+                &list, entry));
+    }
+    bench_scale(object, name, &list,
+                bench_concurrent_skip_list_container_work,
+                bench_concurrent_skip_list_container_acquire,
+                bench_concurrent_skip_list_container_release, false);
+    bench_scale(object, name, &list,
+                bench_concurrent_skip_list_container_work,
+                bench_concurrent_skip_list_container_acquire,
+                bench_concurrent_skip_list_container_release, true);
+    seagrass_required_true(!coral_concurrent_skip_list_container_invalidate(
+            &list, NULL));
+    seagrass_required_true(!coral_allocator_set_default(allocator));
+}
+
+static void *bench_sharded_container_work(void *const argument) {
+    struct bench_worker *const worker = argument;
+    struct coral_sharded_container *const sharded = worker->container;
+    for (uintmax_t i = worker->first; i < worker->last; i++) {
+        const uintmax_t key = 2 * worker->bench->lookup[i] + 1;
+        struct coral_red_black_tree_container_entry *entry;
+        if (coral_sharded_container_get(sharded, &key, &entry)
+            || !worker->write || (i & 1)) {
+            continue;
+        }
+        if (!coral_sharded_container_remove(sharded, entry)) {
+            worker->removed[worker->removed_count++] = entry;
+        }
+        entry = worker->spares[--worker->spare_count];
+        *(uintmax_t *) entry = key;
+        if (coral_sharded_container_add(sharded, entry)) {
+            worker->spares[worker->spare_count++] = entry;
+        }
+    }
+    return NULL;
+}
+
+/* four shards per thread keep the odds of two threads meeting low */
+static void bench_sharded_container(struct bench *const object) {
+    const char *const name = "sharded_container";
+    struct coral_sharded_container sharded;
+    seagrass_required_true(!coral_sharded_container_init_with_hash(
+            &sharded, 4 * bench_threads, hash, compare));
+    for (uintmax_t i = 0; i < object->count; i++) {
+        struct coral_red_black_tree_container_entry *entry;
+        seagrass_required_true(!coral_red_black_tree_container_alloc(
+                sizeof(uintmax_t), &entry));
+        *(uintmax_t *) entry = 2 * object->insert[i] + 1;
+        seagrass_required_true(!coral_sharded_container_add(
+                &sharded, entry));
+    }
+    bench_scale(object, name, &sharded,
+                bench_sharded_container_work,
+                bench_concurrent_red_black_tree_container_acquire,
+                bench_concurrent_red_black_tree_container_release, false);
+    bench_scale(object, name, &sharded,
+                bench_sharded_container_work,
+                bench_concurrent_red_black_tree_container_acquire,
+                bench_concurrent_red_black_tree_container_release, true);
+    seagrass_required_true(!coral_sharded_container_invalidate(
+            &sharded, NULL));
+}
+
+static const struct {
+    const char *name;
+    void (*run)(struct bench *);
+} containers[] = {
+        {"array_list",                      bench_array_list},
+        {"linked_list",                     bench_linked_list},
+        {"btree_container",                 bench_btree_container},
+        {"hash_container",                  bench_hash_container},
+        {"linked_hash_container",           bench_linked_hash_container},
+        {"red_black_tree_container",        bench_red_black_tree_container},
+        {"linked_red_black_tree_container",
+                                     bench_linked_red_black_tree_container},
+        {"typed_red_black_tree_container",
+                                     bench_typed_red_black_tree_container},
+        {"concurrent_red_black_tree_container",
+                                     bench_concurrent_red_black_tree_container},
+        {"concurrent_skip_list_container",
+                                     bench_concurrent_skip_list_container},
+        {"sharded_container",               bench_sharded_container},
+};
+
+static void usage(const char *const program) {
+    fprintf(stderr, "usage: %s [-c container|all] [-p pattern|all] "
+                    "[-m min] [-M max] [-s samples] [-a system|pool] "
+                    "[-t threads]\n",
+            program);
+}
+
+int main(int argc, char *argv[]) {
+    const char *container = "all";
+    const char *pattern = "all";
+    uintmax_t min = 1000;
+    uintmax_t max = 1000000;
+    uintmax_t limit = 100000;
+    bool pool = false;
+    const long processors = sysconf(_SC_NPROCESSORS_ONLN);
+    bench_threads = processors > 0 ? (uintmax_t) processors : 1;
+    int option;
+    while (-1 != (option = getopt(argc, argv, "c:p:m:M:s:a:t:h"))) {
+        switch (option) {
+            case 'c':
+                container = optarg;
+                break;
+            case 'p':
+                pattern = optarg;
+                break;
+            case 'm':
+                min = strtoumax(optarg, NULL, 10);
+                break;
+            case 'M':
+                max = strtoumax(optarg, NULL, 10);
+                break;
+            case 's':
+                limit = strtoumax(optarg, NULL, 10);
+                break;
+            case 't':
+                bench_threads = strtoumax(optarg, NULL, 10);
+                break;
+            case 'a':
+                if (!strcmp("pool", optarg)) {
+                    pool = true;
+                } else if (strcmp("system", optarg)) {
+                    usage(argv[0]);
+                    return EXIT_FAILURE;
+                }
+                break;
+            default:
+                usage(argv[0]);
+                return EXIT_FAILURE;
+        }
+    }
+    if (!min || !limit || !bench_threads || min > max) {
+        usage(argv[0]);
+        return EXIT_FAILURE;
+    }
+    printf("%-36s %-10s %10s %-16s %14s %10s %10s\n",
+           "container", "pattern", "entries", "operation", "ops/sec",
+           "p50(ns)", "p99(ns)");
+    for (uintmax_t count = min; count <= max; count *= 10) {
+        for (enum bench_pattern p = 0; p < BENCH_PATTERN_COUNT; p++) {
+            if (strcmp("all", pattern)
+                && strcmp(bench_pattern_names[p], pattern)) {
+                continue;
+            }
+            struct bench object;
+            bench_init(&object, p, count, limit);
+            for (size_t i = 0; i < sizeof(containers) / sizeof(containers[0]);
+                 i++) {
+                if (strcmp("all", container)
+                    && strcmp(containers[i].name, container)) {
+                    continue;
+                }
+                /* every container has its own entry size hence pool */
+                struct coral_entry_pool entry_pool;
+                if (pool) {
+                    const struct coral_allocator *allocator;
+                    seagrass_required_true(!coral_entry_pool_init(
+                            &entry_pool, BENCH_POOL_SLAB_COUNT));
+                    seagrass_required_true(!coral_entry_pool_allocator(
+                            &entry_pool, &allocator));
+                    seagrass_required_true(!coral_allocator_set_default(
+                            allocator));
+                }
+                containers[i].run(&object);
+                if (pool) {
+                    seagrass_required_true(!coral_allocator_set_default(
+                            NULL));
+                    seagrass_required_true(!coral_entry_pool_invalidate(
+                            &entry_pool));
+                }
+            }
+            bench_invalidate(&object);
+        }
+        if (count > UINTMAX_MAX / 10) {
+            break;
+        }
+    }
+    return EXIT_SUCCESS;
+}
@@ -5,9 +5,25 @@
 #include <stdbool.h>
 #include <stdint.h>
 
+#include <coral/allocator.h>
+#include <coral/arena.h>
+#include <coral/btree_container.h>
 #include <coral/array_list.h>
+#include <coral/concurrent_linked_list.h>
+#include <coral/concurrent_red_black_tree_container.h>
+#include <coral/concurrent_skip_list_container.h>
+#include <coral/counters.h>
+#include <coral/entry_pool.h>
+#include <coral/epoch.h>
+#include <coral/hash_container.h>
+#include <coral/hash_table.h>
+#include <coral/linked_hash_container.h>
 #include <coral/linked_list.h>
 #include <coral/linked_red_black_tree_container.h>
+#include <coral/reader_writer_lock.h>
+#include <coral/red_black_tree.h>
 #include <coral/red_black_tree_container.h>
+#include <coral/sharded_container.h>
+#include <coral/typed_red_black_tree_container.h>
 
 #endif /* _CORAL_CORAL_H_ */
@@ -0,0 +1,62 @@
+#ifndef _CORAL_ALLOCATOR_H_
+#define _CORAL_ALLOCATOR_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <sea-urchin.h>
+
+#define CORAL_ALLOCATOR_ERROR_OUT_IS_NULL \
+    SEA_URCHIN_ERROR_OUT_IS_NULL
+#define CORAL_ALLOCATOR_ERROR_ALLOC_IS_NULL \
+    SEA_URCHIN_ERROR_VALUE_IS_NULL
+#define CORAL_ALLOCATOR_ERROR_FREE_IS_NULL \
+    SEA_URCHIN_ERROR_ITEM_IS_NULL
+
+/**
+ * @brief Allocator used for entry and item memory.
+ * <p>Entries and items remember the allocator they were allocated with so
+ * that they are always returned to it when freed, the allocator must
+ * therefore outlive all of its allocations.</p>
+ */
+struct coral_allocator {
+    /**
+     * @brief Allocate memory.
+     * @param [in] context of the allocator.
+     * @param [in] alignment which is a power of two multiple of
+     * <i>sizeof(void *)</i>.
+     * @param [in] size in bytes to allocate.
+     * @param [out] out receive the allocated memory.
+     * @return On success <i>0</i>, otherwise an error code.
+     */
+    int (*alloc)(void *context, size_t alignment, size_t size, void **out);
+    /**
+     * @brief Free memory.
+     * @param [in] context of the allocator.
+     * @param [in] memory previously allocated from this allocator.
+     */
+    void (*free)(void *context, void *memory);
+    void *context;
+};
+
+/**
+ * @brief Retrieve the default allocator.
+ * @param [out] out receive the default allocator.
+ * @return On success <i>0</i>, otherwise an error code.
+ * @throws CORAL_ALLOCATOR_ERROR_OUT_IS_NULL if out is <i>NULL</i>.
+ */
+int coral_allocator_get_default(const struct coral_allocator **out);
+
+/**
+ * @brief Install the default allocator.
+ * <p>The default allocator is used by all the entry and item allocations
+ * which do not specify an allocator.</p>
+ * @param [in] allocator to install or <i>NULL</i> to restore the system
+ * allocator.
+ * @return On success <i>0</i>, otherwise an error code.
+ * @throws CORAL_ALLOCATOR_ERROR_ALLOC_IS_NULL if alloc is <i>NULL</i>.
+ * @throws CORAL_ALLOCATOR_ERROR_FREE_IS_NULL if free is <i>NULL</i>.
+ */
+int coral_allocator_set_default(const struct coral_allocator *allocator);
+
+#endif /* _CORAL_ALLOCATOR_H_ */
@@ -0,0 +1,90 @@
+#ifndef _CORAL_ARENA_H_
+#define _CORAL_ARENA_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <sea-urchin.h>
+#include <coral/allocator.h>
+
+#define CORAL_ARENA_ERROR_OBJECT_IS_NULL \
+    SEA_URCHIN_ERROR_OBJECT_IS_NULL
+#define CORAL_ARENA_ERROR_OUT_IS_NULL \
+    SEA_URCHIN_ERROR_OUT_IS_NULL
+#define CORAL_ARENA_ERROR_SIZE_IS_ZERO \
+    SEA_URCHIN_ERROR_VALUE_IS_ZERO
+#define CORAL_ARENA_ERROR_SIZE_IS_TOO_LARGE \
+    SEA_URCHIN_ERROR_VALUE_IS_TOO_LARGE
+#define CORAL_ARENA_ERROR_MEMORY_ALLOCATION_FAILED \
+    SEA_URCHIN_ERROR_MEMORY_ALLOCATION_FAILED
+
+/**
+ * @brief Bump allocator carving allocations out of chunks.
+ * <p>Individual allocations are never freed, all of them are released at
+ * once when the arena is invalidated.</p>
+ * <p>An arena is not thread-safe.</p>
+ */
+struct coral_arena {
+    size_t size;
+    void *chunks;
+    unsigned char *cursor;
+    unsigned char *end;
+};
+
+/**
+ * @brief Initialize arena.
+ * @param [in] object instance to be initialized.
+ * @param [in] size in bytes of each chunk, allocations larger than this
+ * receive a chunk of their own.
+ * @return On success <i>0</i>, otherwise an error code.
+ * @throws CORAL_ARENA_ERROR_OBJECT_IS_NULL if object is <i>NULL</i>.
+ * @throws CORAL_ARENA_ERROR_SIZE_IS_ZERO if size is zero.
+ * @throws CORAL_ARENA_ERROR_SIZE_IS_TOO_LARGE if size is too large.
+ */
+int coral_arena_init(struct coral_arena *object, size_t size);
+
+/**
+ * @brief Invalidate arena.
+ * <p>All the chunks are released, hence every allocation made from the
+ * arena becomes invalid. The actual <u>arena instance is not
+ * deallocated</u> since it may have been embedded in a larger
+ * structure.</p>
+ * @param [in] object instance to be invalidated.
+ * @return On success <i>0</i>, otherwise an error code.
+ * @throws CORAL_ARENA_ERROR_OBJECT_IS_NULL if object is <i>NULL</i>.
+ */
+int coral_arena_invalidate(struct coral_arena *object);
+
+/**
+ * @brief Allocate memory from the arena.
+ * @param [in] object arena instance.
+ * @param [in] alignment which must be a power of two.
+ * @param [in] size in bytes to allocate.
+ * @param [out] out receive the allocated memory.
+ * @return On success <i>0</i>, otherwise an error code.
+ * @throws CORAL_ARENA_ERROR_OBJECT_IS_NULL if object is <i>NULL</i>.
+ * @throws CORAL_ARENA_ERROR_OUT_IS_NULL if out is <i>NULL</i>.
+ * @throws CORAL_ARENA_ERROR_SIZE_IS_ZERO if size is zero.
+ * @throws CORAL_ARENA_ERROR_SIZE_IS_TOO_LARGE if size is too large.
+ * @throws CORAL_ARENA_ERROR_MEMORY_ALLOCATION_FAILED if there is not
+ * enough memory to allocate a chunk.
+ */
+int coral_arena_alloc(struct coral_arena *object,
+                      size_t alignment,
+                      size_t size,
+                      void **out);
+
+/**
+ * @brief Retrieve an allocator drawing from the arena.
+ * <p>Freeing memory through the allocator does nothing, the memory is only
+ * released when the arena is invalidated.</p>
+ * @param [in] object arena instance which must outlive the allocator.
+ * @param [out] out receive the allocator.
+ * @return On success <i>0</i>, otherwise an error code.
+ * @throws CORAL_ARENA_ERROR_OBJECT_IS_NULL if object is <i>NULL</i>.
+ * @throws CORAL_ARENA_ERROR_OUT_IS_NULL if out is <i>NULL</i>.
+ */
+int coral_arena_allocator(struct coral_arena *object,
+                          struct coral_allocator *out);
+
+#endif /* _CORAL_ARENA_H_ */
@@ -0,0 +1,458 @@
+#ifndef _CORAL_BTREE_CONTAINER_H_
+#define _CORAL_BTREE_CONTAINER_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <sea-urchin.h>
+#include <rock.h>
+#include <coral/allocator.h>
+#include <coral/counters.h>
+#include <coral/red_black_tree_container.h>
+
+/* errors are shared with the red black tree container so that either can be
+ * swapped for the other */
+#define CORAL_BTREE_CONTAINER_ERROR_SIZE_IS_ZERO \
+    CORAL_RED_BLACK_TREE_CONTAINER_ERROR_SIZE_IS_ZERO
+#define CORAL_BTREE_CONTAINER_ERROR_SIZE_IS_TOO_LARGE \
+    CORAL_RED_BLACK_TREE_CONTAINER_ERROR_SIZE_IS_TOO_LARGE
+#define CORAL_BTREE_CONTAINER_ERROR_OUT_IS_NULL \
+    CORAL_RED_BLACK_TREE_CONTAINER_ERROR_OUT_IS_NULL
+#define CORAL_BTREE_CONTAINER_ERROR_MEMORY_ALLOCATION_FAILED \
+    CORAL_RED_BLACK_TREE_CONTAINER_ERROR_MEMORY_ALLOCATION_FAILED
+#define CORAL_BTREE_CONTAINER_ERROR_ENTRY_IS_NULL \
+    CORAL_RED_BLACK_TREE_CONTAINER_ERROR_ENTRY_IS_NULL
+#define CORAL_BTREE_CONTAINER_ERROR_OBJECT_IS_NULL \
+    CORAL_RED_BLACK_TREE_CONTAINER_ERROR_OBJECT_IS_NULL
+#define CORAL_BTREE_CONTAINER_ERROR_COMPARE_IS_NULL \
+    CORAL_RED_BLACK_TREE_CONTAINER_ERROR_COMPARE_IS_NULL
+#define CORAL_BTREE_CONTAINER_ERROR_ENTRY_ALREADY_EXISTS \
+    CORAL_RED_BLACK_TREE_CONTAINER_ERROR_ENTRY_ALREADY_EXISTS
+#define CORAL_BTREE_CONTAINER_ERROR_KEY_IS_NULL \
+    CORAL_RED_BLACK_TREE_CONTAINER_ERROR_KEY_IS_NULL
+#define CORAL_BTREE_CONTAINER_ERROR_ENTRY_NOT_FOUND \
+    CORAL_RED_BLACK_TREE_CONTAINER_ERROR_ENTRY_NOT_FOUND
+#define CORAL_BTREE_CONTAINER_ERROR_CONTAINER_IS_EMPTY \
+    CORAL_RED_BLACK_TREE_CONTAINER_ERROR_CONTAINER_IS_EMPTY
+#define CORAL_BTREE_CONTAINER_ERROR_END_OF_SEQUENCE \
+    CORAL_RED_BLACK_TREE_CONTAINER_ERROR_END_OF_SEQUENCE
+
+struct coral_btree_container_entry;
+
+struct coral_btree_container_node;
+
+/**
+ * @brief Ordered container of entries kept in a B+ tree.
+ * <p>Entries are held in leaves that are linked together in order and the
+ * branches above them only route lookups, so that a lookup touches a few
+ * cache line aligned nodes instead of one node per comparison and iteration
+ * walks the leaves sequentially.</p>
+ */
+struct coral_btree_container {
+    uintmax_t count;
+    struct coral_btree_container_node *root;
+
+    int (*compare)(const void *, const void *);
+    int (*compare_key)(const void *, const void *);
+#ifdef CORAL_COUNTERS
+    struct coral_atomic_counters counters;
+#endif
+};
+
+/**
+ * @brief Allocate memory for an entry.
+ * <p>Memory is obtained from the default allocator.</p>
+ * @param [in] size in bytes of entry to create.
+ * @param [out] out receive allocated entry.
+ * @return On success <i>0</i>, otherwise an error code.
+ * @throws CORAL_BTREE_CONTAINER_ERROR_OUT_IS_NULL if out is <i>NULL</i>.
+ * @throws CORAL_BTREE_CONTAINER_ERROR_SIZE_IS_ZERO if size if zero.
+ * @throws CORAL_BTREE_CONTAINER_ERROR_SIZE_IS_TOO_LARGE if size is too large.
+ * @throws CORAL_BTREE_CONTAINER_ERROR_MEMORY_ALLOCATION_FAILED if there is not
+ * enough memory to allocate an entry.
+ */
+int coral_btree_container_alloc(
+        size_t size,
+        struct coral_btree_container_entry **out);
+
+/**
+ * @brief Allocate memory for an entry from the given allocator.
+ * @param [in] allocator to allocate from or <i>NULL</i> for the default
+ * allocator.
+ * @param [in] size in bytes of entry to create.
+ * @param [out] out receive allocated entry.
+ * @return On success <i>0</i>, otherwise an error code.
+ * @throws CORAL_BTREE_CONTAINER_ERROR_OUT_IS_NULL if out is <i>NULL</i>.
+ * @throws CORAL_BTREE_CONTAINER_ERROR_SIZE_IS_ZERO if size if zero.
+ * @throws CORAL_BTREE_CONTAINER_ERROR_SIZE_IS_TOO_LARGE if size is too large.
+ * @throws CORAL_BTREE_CONTAINER_ERROR_MEMORY_ALLOCATION_FAILED if there is not
+ * enough memory to allocate an entry.
+ */
+int coral_btree_container_alloc_with(
+        const struct coral_allocator *allocator,
+        size_t size,
+        struct coral_btree_container_entry **out);
+
+/**
+ * @brief Free memory of an entry.
+ * <p>Memory is returned to the allocator the entry was allocated from.</p>
+ * @param [in] entry to be freed.
+ * @return On success <i>0</i>, otherwise an error code.
+ * @throws CORAL_BTREE_CONTAINER_ERROR_ENTRY_IS_NULL if entry is <i>NULL</i>.
+ */
+int coral_btree_container_free(
+        struct coral_btree_container_entry *entry);
+
+/**
+ * @brief Initialize B+ tree container.
+ * @param [in] object instance to be initialized.
+ * @param [in] compare comparison which must return an integer less than, equal
+ * to, or greater than zero if the <u>first key</u> is considered to be
+ * respectively less than, equal to, or greater than the <u>second key</u>.
+ * @return On success <i>0</i>, otherwise an error code.
+ * @throws CORAL_BTREE_CONTAINER_ERROR_OBJECT_IS_NULL if object is <i>NULL</i>.
+ * @throws CORAL_BTREE_CONTAINER_ERROR_COMPARE_IS_NULL if compare is
+ * <i>NULL</i>.
+ */
+int coral_btree_container_init(
+        struct coral_btree_container *object,
+        int (*compare)(const void *first,
+                       const void *second));
+
+/**
+ * @brief Initialize B+ tree container with a key comparison.
+ * <p>The key comparison allows the <i>_key</i> lookup functions to take a
+ * compact key instead of an entry shaped one.</p>
+ * @param [in] object instance to be initialized.
+ * @param [in] compare comparison which must return an integer less than, equal
+ * to, or greater than zero if the <u>first key</u> is considered to be
+ * respectively less than, equal to, or greater than the <u>second key</u>.
+ * @param [in] compare_key comparison which must return an integer less than,
+ * equal to, or greater than zero if the <u>key</u> is considered to be
+ * respectively less than, equal to, or greater than the <u>entry</u>. It must
+ * order the entries the same way as <i>compare</i> does.
+ * @return On success <i>0</i>, otherwise an error code.
+ * @throws CORAL_BTREE_CONTAINER_ERROR_OBJECT_IS_NULL if object is <i>NULL</i>.
+ * @throws CORAL_BTREE_CONTAINER_ERROR_COMPARE_IS_NULL if compare or compare_key
+ * is <i>NULL</i>.
+ */
+int coral_btree_container_init_with_key(
+        struct coral_btree_container *object,
+        int (*compare)(const void *first,
+                       const void *second),
+        int (*compare_key)(const void *key,
+                           const void *entry));
+
+/**
+ * @brief Invalidate B+ tree container.
+ * <p>The entries in the container are destroyed and each entry will have the
+ * provided <i>on destroy</i> callback invoked upon itself. The actual
+ * <u>container instance is not deallocated</u> since it may have been embedded
+ * in a larger structure.</p>
+ * @param [in] object instance to be invalidated.
+ * @param [in] on_destroy called just before the entry is to be destroyed.
+ * @return On success <i>0</i>, otherwise an error code.
+ * @throws CORAL_BTREE_CONTAINER_ERROR_OBJECT_IS_NULL if object is <i>NULL</i>.
+ */
+int coral_btree_container_invalidate(
+        struct coral_btree_container *object,
+        void (*on_destroy)(struct coral_btree_container_entry *entry));
+
+/**
+ * @brief Retrieve the count of entries.
+ * @param [in] object instance whose count we are to retrieve.
+ * @param [out] out receive the entry count.
+ * @return On success <i>0</i>, otherwise an error code.
+ * @throws CORAL_BTREE_CONTAINER_ERROR_OBJECT_IS_NULL if object is <i>NULL</i>.
+ * @throws CORAL_BTREE_CONTAINER_ERROR_OUT_IS_NULL if out is <i>NULL</i>.
+ */
+int coral_btree_container_count(
+        const struct coral_btree_container *object,
+        uintmax_t *out);
+
+/**
+ * @brief Add entry.
+ * @param [in] object container instance.
+ * @param [in] entry to add.
+ * @return On success <i>0</i>, otherwise an error code.
+ * @throws CORAL_BTREE_CONTAINER_ERROR_OBJECT_IS_NULL if object is <i>NULL</i>.
+ * @throws CORAL_BTREE_CONTAINER_ERROR_ENTRY_IS_NULL if entry is <i>NULL</i>.
+ * @throws CORAL_BTREE_CONTAINER_ERROR_ENTRY_ALREADY_EXITS if entry is already
+ * present in container.
+ */
+int coral_btree_container_add(
+        struct coral_btree_container *object,
+        const struct coral_btree_container_entry *entry);
+
+/**
+ * @brief Remove entry.
+ * @param [in] object container instance.
+ * @param [in] entry to remove.
+ * @return On success <i>0</i>, otherwise an error code.
+ * @throws CORAL_BTREE_CONTAINER_ERROR_OBJECT_IS_NULL if object is <i>NULL</i>.
+ * @throws CORAL_BTREE_CONTAINER_ERROR_ENTRY_IS_NULL if entry is <i>NULL</i>.
+ * @throws CORAL_BTREE_CONTAINER_ERROR_ENTRY_NOT_FOUND if entry is not present
+ * in a container.
+ */
+int coral_btree_container_remove(
+        struct coral_btree_container *object,
+        const struct coral_btree_container_entry *entry);
+
+/**
+ * @brief Retrieve entry for key.
+ * @param [in] object container instance.
+ * @param [in] key on which to find entry.
+ * @param [out] out receive matching entry.
+ * @return On success <i>0</i>, otherwise an error code.
+ * @throws CORAL_BTREE_CONTAINER_ERROR_OBJECT_IS_NULL if object is <i>NULL</i>.
+ * @throws CORAL_BTREE_CONTAINER_ERROR_KEY_IS_NULL if key is <i>NULL</i>.
+ * @throws CORAL_BTREE_CONTAINER_ERROR_OUT_IS_NULL if out is <i>NULL</i>.
+ * @throws CORAL_BTREE_CONTAINER_ERROR_ENTRY_NOT_FOUND if matching entry was not
+ * found.
+ */
+int coral_btree_container_get(
+        const struct coral_btree_container *object,
+        const void *key,
+        struct coral_btree_container_entry **out);
+
+/**
+ * @brief Retrieve entry for key using the key comparison.
+ * @param [in] object container instance.
+ * @param [in] key on which to find entry.
+ * @param [out] out receive matching entry.
+ * @return On success <i>0</i>, otherwise an error code.
+ * @throws CORAL_BTREE_CONTAINER_ERROR_OBJECT_IS_NULL if object is <i>NULL</i>.
+ * @throws CORAL_BTREE_CONTAINER_ERROR_KEY_IS_NULL if key is <i>NULL</i>.
+ * @throws CORAL_BTREE_CONTAINER_ERROR_OUT_IS_NULL if out is <i>NULL</i>.
+ * @throws CORAL_BTREE_CONTAINER_ERROR_COMPARE_IS_NULL if the container was not
+ * initialized with a key comparison.
+ * @throws CORAL_BTREE_CONTAINER_ERROR_ENTRY_NOT_FOUND if matching entry was not
+ * found.
+ */
+int coral_btree_container_get_key(
+        const struct coral_btree_container *object,
+        const void *key,
+        struct coral_btree_container_entry **out);
+
+/**
+ * @brief Retrieve entry or next higher for key.
+ * @param [in] object container instance.
+ * @param [in] key on which to find entry or next higher.
+ * @param [out] out receive matching entry.
+ * @return On success <i>0</i>, otherwise an error code.
+ * @throws CORAL_BTREE_CONTAINER_ERROR_OBJECT_IS_NULL if object is <i>NULL</i>.
+ * @throws CORAL_BTREE_CONTAINER_ERROR_KEY_IS_NULL if key is <i>NULL</i>.
+ * @throws CORAL_BTREE_CONTAINER_ERROR_OUT_IS_NULL if out is <i>NULL</i>.
+ * @throws CORAL_BTREE_CONTAINER_ERROR_ENTRY_NOT_FOUND if matching entry or next
+ * higher entry was not found.
+ */
+int coral_btree_container_ceiling(
+        const struct coral_btree_container *object,
+        const void *key,
+        struct coral_btree_container_entry **out);
+
+/**
+ * @brief Retrieve entry or next higher for key using the key comparison.
+ * @param [in] object container instance.
+ * @param [in] key on which to find entry or next higher.
+ * @param [out] out receive matching entry.
+ * @return On success <i>0</i>, otherwise an error code.
+ * @throws CORAL_BTREE_CONTAINER_ERROR_OBJECT_IS_NULL if object is <i>NULL</i>.
+ * @throws CORAL_BTREE_CONTAINER_ERROR_KEY_IS_NULL if key is <i>NULL</i>.
+ * @throws CORAL_BTREE_CONTAINER_ERROR_OUT_IS_NULL if out is <i>NULL</i>.
+ * @throws CORAL_BTREE_CONTAINER_ERROR_COMPARE_IS_NULL if the container was not
+ * initialized with a key comparison.
+ * @throws CORAL_BTREE_CONTAINER_ERROR_ENTRY_NOT_FOUND if matching entry or next
+ * higher entry was not found.
+ */
+int coral_btree_container_ceiling_key(
+        const struct coral_btree_container *object,
+        const void *key,
+        struct coral_btree_container_entry **out);
+
+/**
+ * @brief Retrieve entry or next lower for key.
+ * @param [in] object container instance.
+ * @param [in] key on which to find entry or next lower.
+ * @param [out] out receive matching entry.
+ * @return On success <i>0</i>, otherwise an error code.
+ * @throws CORAL_BTREE_CONTAINER_ERROR_OBJECT_IS_NULL if object is <i>NULL</i>.
+ * @throws CORAL_BTREE_CONTAINER_ERROR_KEY_IS_NULL if key is <i>NULL</i>.
+ * @throws CORAL_BTREE_CONTAINER_ERROR_OUT_IS_NULL if out is <i>NULL</i>.
+ * @throws CORAL_BTREE_CONTAINER_ERROR_ENTRY_NOT_FOUND if matching entry or next
+ * lower entry was not found.
+ */
+int coral_btree_container_floor(
+        const struct coral_btree_container *object,
+        const void *key,
+        struct coral_btree_container_entry **out);
+
+/**
+ * @brief Retrieve entry or next lower for key using the key comparison.
+ * @param [in] object container instance.
+ * @param [in] key on which to find entry or next lower.
+ * @param [out] out receive matching entry.
+ * @return On success <i>0</i>, otherwise an error code.
+ * @throws CORAL_BTREE_CONTAINER_ERROR_OBJECT_IS_NULL if object is <i>NULL</i>.
+ * @throws CORAL_BTREE_CONTAINER_ERROR_KEY_IS_NULL if key is <i>NULL</i>.
+ * @throws CORAL_BTREE_CONTAINER_ERROR_OUT_IS_NULL if out is <i>NULL</i>.
+ * @throws CORAL_BTREE_CONTAINER_ERROR_COMPARE_IS_NULL if the container was not
+ * initialized with a key comparison.
+ * @throws CORAL_BTREE_CONTAINER_ERROR_ENTRY_NOT_FOUND if matching entry or next
+ * lower entry was not found.
+ */
+int coral_btree_container_floor_key(
+        const struct coral_btree_container *object,
+        const void *key,
+        struct coral_btree_container_entry **out);
+
+/**
+ * @brief Retrieve next higher entry for key.
+ * @param [in] object container instance.
+ * @param [in] key on which to find next higher entry.
+ * @param [out] out receive matching entry.
+ * @return On success <i>0</i>, otherwise an error code.
+ * @throws CORAL_BTREE_CONTAINER_ERROR_OBJECT_IS_NULL if object is <i>NULL</i>.
+ * @throws CORAL_BTREE_CONTAINER_ERROR_KEY_IS_NULL if key is <i>NULL</i>.
+ * @throws CORAL_BTREE_CONTAINER_ERROR_OUT_IS_NULL if out is <i>NULL</i>.
+ * @throws CORAL_BTREE_CONTAINER_ERROR_ENTRY_NOT_FOUND if next higher entry was
+ * not found.
+ */
+int coral_btree_container_higher(
+        const struct coral_btree_container *object,
+        const void *key,
+        struct coral_btree_container_entry **out);
+
+/**
+ * @brief Retrieve next higher entry for key using the key comparison.
+ * @param [in] object container instance.
+ * @param [in] key on which to find next higher entry.
+ * @param [out] out receive matching entry.
+ * @return On success <i>0</i>, otherwise an error code.
+ * @throws CORAL_BTREE_CONTAINER_ERROR_OBJECT_IS_NULL if object is <i>NULL</i>.
+ * @throws CORAL_BTREE_CONTAINER_ERROR_KEY_IS_NULL if key is <i>NULL</i>.
+ * @throws CORAL_BTREE_CONTAINER_ERROR_OUT_IS_NULL if out is <i>NULL</i>.
+ * @throws CORAL_BTREE_CONTAINER_ERROR_COMPARE_IS_NULL if the container was not
+ * initialized with a key comparison.
+ * @throws CORAL_BTREE_CONTAINER_ERROR_ENTRY_NOT_FOUND if next higher entry was
+ * not found.
+ */
+int coral_btree_container_higher_key(
+        const struct coral_btree_container *object,
+        const void *key,
+        struct coral_btree_container_entry **out);
+
+/**
+ * @brief Retrieve next lower entry for key.
+ * @param [in] object container instance.
+ * @param [in] key on which to find next lower entry.
+ * @param [out] out receive matching entry.
+ * @return On success <i>0</i>, otherwise an error code.
+ * @throws CORAL_BTREE_CONTAINER_ERROR_OBJECT_IS_NULL if object is <i>NULL</i>.
+ * @throws CORAL_BTREE_CONTAINER_ERROR_KEY_IS_NULL if key is <i>NULL</i>.
+ * @throws CORAL_BTREE_CONTAINER_ERROR_OUT_IS_NULL if out is <i>NULL</i>.
+ * @throws CORAL_BTREE_CONTAINER_ERROR_ENTRY_NOT_FOUND if next lower entry was
+ * not found.
+ */
+int coral_btree_container_lower(
+        const struct coral_btree_container *object,
+        const void *key,
+        struct coral_btree_container_entry **out);
+
+/**
+ * @brief Retrieve next lower entry for key using the key comparison.
+ * @param [in] object container instance.
+ * @param [in] key on which to find next lower entry.
+ * @param [out] out receive matching entry.
+ * @return On success <i>0</i>, otherwise an error code.
+ * @throws CORAL_BTREE_CONTAINER_ERROR_OBJECT_IS_NULL if object is <i>NULL</i>.
+ * @throws CORAL_BTREE_CONTAINER_ERROR_KEY_IS_NULL if key is <i>NULL</i>.
+ * @throws CORAL_BTREE_CONTAINER_ERROR_OUT_IS_NULL if out is <i>NULL</i>.
+ * @throws CORAL_BTREE_CONTAINER_ERROR_COMPARE_IS_NULL if the container was not
+ * initialized with a key comparison.
+ * @throws CORAL_BTREE_CONTAINER_ERROR_ENTRY_NOT_FOUND if next lower entry was
+ * not found.
+ */
+int coral_btree_container_lower_key(
+        const struct coral_btree_container *object,
+        const void *key,
+        struct coral_btree_container_entry **out);
+
+/**
+ * @brief Receive first entry.
+ * @param [in] object container instance.
+ * @param [out] out receive first entry.
+ * @return On success <i>0</i>, otherwise an error code.
+ * @throws CORAL_BTREE_CONTAINER_ERROR_OBJECT_IS_NULL if object is <i>NULL</i>.
+ * @throws CORAL_BTREE_CONTAINER_ERROR_OUT_IS_NULL if out is <i>NULL</i>.
+ * @throws CORAL_BTREE_CONTAINER_ERROR_CONTAINER_IS_EMPTY if container is empty.
+ */
+int coral_btree_container_first(
+        const struct coral_btree_container *object,
+        struct coral_btree_container_entry **out);
+
+/**
+ * @brief Receive last entry.
+ * @param [in] object container instance.
+ * @param [out] out receive last entry.
+ * @return On success <i>0</i>, otherwise an error code.
+ * @throws CORAL_BTREE_CONTAINER_ERROR_OBJECT_IS_NULL if object is <i>NULL</i>.
+ * @throws CORAL_BTREE_CONTAINER_ERROR_OUT_IS_NULL if out is <i>NULL</i>.
+ * @throws CORAL_BTREE_CONTAINER_ERROR_CONTAINER_IS_EMPTY if container is empty.
+ */
+int coral_btree_container_last(
+        const struct coral_btree_container *object,
+        struct coral_btree_container_entry **out);
+
+/**
+ * @brief Retrieve the next entry.
+ * @param [in] entry current one.
+ * @param [out] out receive the next entry.
+ * @return On success <i>0</i>, otherwise an error code.
+ * @throws CORAL_BTREE_CONTAINER_ERROR_ENTRY_IS_NULL if entry is <i>NULL</i>.
+ * @throws CORAL_BTREE_CONTAINER_ERROR_OUT_IS_NULL if out is <i>NULL</i>.
+ * @throws CORAL_BTREE_CONTAINER_ERROR_END_OF_SEQUENCE if there are no next
+ * entries.
+ */
+int coral_btree_container_next(
+        const struct coral_btree_container_entry *entry,
+        struct coral_btree_container_entry **out);
+
+/**
+ * @brief Retrieve the previous entry.
+ * @param [in] entry current one.
+ * @param [out] out receive the previous entry.
+ * @return On success <i>0</i>, otherwise an error code.
+ * @throws CORAL_BTREE_CONTAINER_ERROR_ENTRY_IS_NULL if entry is <i>NULL</i>.
+ * @throws CORAL_BTREE_CONTAINER_ERROR_OUT_IS_NULL if out is <i>NULL</i>.
+ * @throws CORAL_BTREE_CONTAINER_ERROR_END_OF_SEQUENCE if there are no previous
+ * entries.
+ */
+int coral_btree_container_prev(
+        const struct coral_btree_container_entry *entry,
+        struct coral_btree_container_entry **out);
+
+/**
+ * @brief Retrieve a snapshot of the operation counters.
+ * <p>Counters are only maintained if the library was built with the
+ * <i>CORAL_COUNTERS</i> option, otherwise they always read as zero.</p>
+ * @param [in] object container instance.
+ * @param [out] out receive the operation counters.
+ * @return On success <i>0</i>, otherwise an error code.
+ * @throws CORAL_BTREE_CONTAINER_ERROR_OBJECT_IS_NULL if object is <i>NULL</i>.
+ * @throws CORAL_BTREE_CONTAINER_ERROR_OUT_IS_NULL if out is <i>NULL</i>.
+ */
+int coral_btree_container_counters(
+        const struct coral_btree_container *object,
+        struct coral_counters *out);
+
+/**
+ * @brief Reset the operation counters to zero.
+ * @param [in] object container instance.
+ * @return On success <i>0</i>, otherwise an error code.
+ * @throws CORAL_BTREE_CONTAINER_ERROR_OBJECT_IS_NULL if object is <i>NULL</i>.
+ */
+int coral_btree_container_counters_reset(
+        struct coral_btree_container *object);
+
+#endif /* _CORAL_BTREE_CONTAINER_H_ */
@@ -0,0 +1,272 @@
+#ifndef _CORAL_CONCURRENT_LINKED_LIST_H_
+#define _CORAL_CONCURRENT_LINKED_LIST_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+#include <sea-urchin.h>
+#include <coral/allocator.h>
+#include <coral/epoch.h>
+#include <coral/linked_list.h>
+#include <coral/red_black_tree_container.h>
+
+#define CORAL_CONCURRENT_LINKED_LIST_ERROR_SIZE_IS_ZERO \
+    CORAL_LINKED_LIST_ERROR_SIZE_IS_ZERO
+#define CORAL_CONCURRENT_LINKED_LIST_ERROR_SIZE_IS_TOO_LARGE \
+    CORAL_LINKED_LIST_ERROR_SIZE_IS_TOO_LARGE
+#define CORAL_CONCURRENT_LINKED_LIST_ERROR_OUT_IS_NULL \
+    CORAL_LINKED_LIST_ERROR_OUT_IS_NULL
+#define CORAL_CONCURRENT_LINKED_LIST_ERROR_MEMORY_ALLOCATION_FAILED \
+    CORAL_LINKED_LIST_ERROR_MEMORY_ALLOCATION_FAILED
+#define CORAL_CONCURRENT_LINKED_LIST_ERROR_ITEM_IS_NULL \
+    CORAL_LINKED_LIST_ERROR_ITEM_IS_NULL
+#define CORAL_CONCURRENT_LINKED_LIST_ERROR_OBJECT_IS_NULL \
+    CORAL_LINKED_LIST_ERROR_OBJECT_IS_NULL
+#define CORAL_CONCURRENT_LINKED_LIST_ERROR_LIST_IS_EMPTY \
+    CORAL_LINKED_LIST_ERROR_LIST_IS_EMPTY
+#define CORAL_CONCURRENT_LINKED_LIST_ERROR_END_OF_SEQUENCE \
+    CORAL_LINKED_LIST_ERROR_END_OF_SEQUENCE
+#define CORAL_CONCURRENT_LINKED_LIST_ERROR_COMPARE_IS_NULL \
+    CORAL_RED_BLACK_TREE_CONTAINER_ERROR_COMPARE_IS_NULL
+#define CORAL_CONCURRENT_LINKED_LIST_ERROR_KEY_IS_NULL \
+    CORAL_RED_BLACK_TREE_CONTAINER_ERROR_KEY_IS_NULL
+#define CORAL_CONCURRENT_LINKED_LIST_ERROR_ITEM_ALREADY_EXISTS \
+    CORAL_RED_BLACK_TREE_CONTAINER_ERROR_ENTRY_ALREADY_EXISTS
+#define CORAL_CONCURRENT_LINKED_LIST_ERROR_ITEM_NOT_FOUND \
+    CORAL_RED_BLACK_TREE_CONTAINER_ERROR_ENTRY_NOT_FOUND
+#define CORAL_CONCURRENT_LINKED_LIST_ERROR_THREAD_IS_NULL \
+    CORAL_EPOCH_ERROR_THREAD_IS_NULL
+
+struct coral_concurrent_linked_list_item;
+
+/**
+ * @brief Sorted linked list which many threads may add to, remove from and
+ * look into at the same time without taking any lock.
+ * <p>Items are linked in with compare and swap. Removing an item first marks
+ * the link out of it, after which no item may be linked in after it, and
+ * then unlinks it.</p>
+ * <p>Threads look at items from within critical sections of an epoch they
+ * share and retire the items they removed, which are then freed once no
+ * thread can still be looking at them.</p>
+ * <p>Every lookup walks the list from its start, which suits registries of a
+ * few dozen items.</p>
+ */
+struct coral_concurrent_linked_list {
+    int (*compare)(const void *, const void *);
+    atomic_uintptr_t head;
+    atomic_uintmax_t count;
+};
+
+/**
+ * @brief Allocate memory for an item.
+ * <p>Memory is obtained from the default allocator.</p>
+ * @param [in] size in bytes of item to create.
+ * @param [out] out receive allocated item.
+ * @return On success <i>0</i>, otherwise an error code.
+ * @throws CORAL_CONCURRENT_LINKED_LIST_ERROR_OUT_IS_NULL if out is
+ * <i>NULL</i>.
+ * @throws CORAL_CONCURRENT_LINKED_LIST_ERROR_SIZE_IS_ZERO if size is zero.
+ * @throws CORAL_CONCURRENT_LINKED_LIST_ERROR_SIZE_IS_TOO_LARGE if size is too
+ * large.
+ * @throws CORAL_CONCURRENT_LINKED_LIST_ERROR_MEMORY_ALLOCATION_FAILED if there
+ * is not enough memory to allocate an item.
+ */
+int coral_concurrent_linked_list_alloc(
+        size_t size,
+        struct coral_concurrent_linked_list_item **out);
+
+/**
+ * @brief Allocate memory for an item from the given allocator.
+ * @param [in] allocator to allocate from or <i>NULL</i> for the default
+ * allocator.
+ * @param [in] size in bytes of item to create.
+ * @param [out] out receive allocated item.
+ * @return On success <i>0</i>, otherwise an error code.
+ * @throws CORAL_CONCURRENT_LINKED_LIST_ERROR_OUT_IS_NULL if out is
+ * <i>NULL</i>.
+ * @throws CORAL_CONCURRENT_LINKED_LIST_ERROR_SIZE_IS_ZERO if size is zero.
+ * @throws CORAL_CONCURRENT_LINKED_LIST_ERROR_SIZE_IS_TOO_LARGE if size is too
+ * large.
+ * @throws CORAL_CONCURRENT_LINKED_LIST_ERROR_MEMORY_ALLOCATION_FAILED if there
+ * is not enough memory to allocate an item.
+ */
+int coral_concurrent_linked_list_alloc_with(
+        const struct coral_allocator *allocator,
+        size_t size,
+        struct coral_concurrent_linked_list_item **out);
+
+/**
+ * @brief Free memory of an item.
+ * <p>Memory is returned to the allocator the item was allocated from. A
+ * removed item may only be freed once no other thread can still be looking at
+ * it, retire it instead when other threads may be.</p>
+ * @param [in] item to be freed.
+ * @return On success <i>0</i>, otherwise an error code.
+ * @throws CORAL_CONCURRENT_LINKED_LIST_ERROR_ITEM_IS_NULL if item is
+ * <i>NULL</i>.
+ */
+int coral_concurrent_linked_list_free(
+        struct coral_concurrent_linked_list_item *item);
+
+/**
+ * @brief Free memory of an item once no thread can still be looking at it.
+ * <p>The item is freed through the epoch thread is registered with, once
+ * every thread that was in a critical section of that epoch has left it.</p>
+ * @param [in] thread registered with the epoch shared by the threads looking
+ * at items.
+ * @param [in] item to be freed, which must have been removed.
+ * @return On success <i>0</i>, otherwise an error code.
+ * @throws CORAL_CONCURRENT_LINKED_LIST_ERROR_THREAD_IS_NULL if thread is
+ * <i>NULL</i>.
+ * @throws CORAL_CONCURRENT_LINKED_LIST_ERROR_ITEM_IS_NULL if item is
+ * <i>NULL</i>.
+ * @throws CORAL_CONCURRENT_LINKED_LIST_ERROR_MEMORY_ALLOCATION_FAILED if there
+ * is not enough memory to defer freeing the item, item was not freed.
+ */
+int coral_concurrent_linked_list_retire(
+        struct coral_epoch_thread *thread,
+        struct coral_concurrent_linked_list_item *item);
+
+/**
+ * @brief Initialize concurrent linked list.
+ * @param [in] object instance to be initialized.
+ * @param [in] compare comparison which must return an integer less than, equal
+ * to, or greater than zero if the <u>first key</u> is considered to be
+ * respectively less than, equal to, or greater than the <u>second key</u>.
+ * @return On success <i>0</i>, otherwise an error code.
+ * @throws CORAL_CONCURRENT_LINKED_LIST_ERROR_OBJECT_IS_NULL if object is
+ * <i>NULL</i>.
+ * @throws CORAL_CONCURRENT_LINKED_LIST_ERROR_COMPARE_IS_NULL if compare is
+ * <i>NULL</i>.
+ */
+int coral_concurrent_linked_list_init(
+        struct coral_concurrent_linked_list *object,
+        int (*compare)(const void *first,
+                       const void *second));
+
+/**
+ * @brief Invalidate concurrent linked list.
+ * <p>The items in the linked list are destroyed and each item will have the
+ * provided <i>on destroy</i> callback invoked upon itself. The actual
+ * <u>linked list instance is not deallocated</u> since it may have been
+ * embedded in a larger structure.</p>
+ * <p>No other thread may be using the linked list.</p>
+ * @param [in] object instance to be invalidated.
+ * @param [in] on_destroy called just before the item is to be destroyed.
+ * @return On success <i>0</i>, otherwise an error code.
+ * @throws CORAL_CONCURRENT_LINKED_LIST_ERROR_OBJECT_IS_NULL if object is
+ * <i>NULL</i>.
+ */
+int coral_concurrent_linked_list_invalidate(
+        struct coral_concurrent_linked_list *object,
+        void (*on_destroy)(struct coral_concurrent_linked_list_item *item));
+
+/**
+ * @brief Retrieve the count of items.
+ * @param [in] object instance whose count we are to retrieve.
+ * @param [out] out receive the item count.
+ * @return On success <i>0</i>, otherwise an error code.
+ * @throws CORAL_CONCURRENT_LINKED_LIST_ERROR_OBJECT_IS_NULL if object is
+ * <i>NULL</i>.
+ * @throws CORAL_CONCURRENT_LINKED_LIST_ERROR_OUT_IS_NULL if out is
+ * <i>NULL</i>.
+ */
+int coral_concurrent_linked_list_count(
+        const struct coral_concurrent_linked_list *object,
+        uintmax_t *out);
+
+/**
+ * @brief Add item in order.
+ * @param [in] object linked list instance.
+ * @param [in] item to add.
+ * @return On success <i>0</i>, otherwise an error code.
+ * @throws CORAL_CONCURRENT_LINKED_LIST_ERROR_OBJECT_IS_NULL if object is
+ * <i>NULL</i>.
+ * @throws CORAL_CONCURRENT_LINKED_LIST_ERROR_ITEM_IS_NULL if item is
+ * <i>NULL</i>.
+ * @throws CORAL_CONCURRENT_LINKED_LIST_ERROR_ITEM_ALREADY_EXISTS if an equal
+ * item is already present in linked list.
+ */
+int coral_concurrent_linked_list_add(
+        struct coral_concurrent_linked_list *object,
+        const struct coral_concurrent_linked_list_item *item);
+
+/**
+ * @brief Remove item.
+ * <p>Once removed the item is no longer reachable from the linked list yet
+ * other threads may still be looking at it.</p>
+ * @param [in] object linked list instance.
+ * @param [in] item to remove.
+ * @return On success <i>0</i>, otherwise an error code.
+ * @throws CORAL_CONCURRENT_LINKED_LIST_ERROR_OBJECT_IS_NULL if object is
+ * <i>NULL</i>.
+ * @throws CORAL_CONCURRENT_LINKED_LIST_ERROR_ITEM_IS_NULL if item is
+ * <i>NULL</i>.
+ * @throws CORAL_CONCURRENT_LINKED_LIST_ERROR_ITEM_NOT_FOUND if item is not
+ * present in linked list, which includes it having just been removed by
+ * another thread.
+ */
+int coral_concurrent_linked_list_remove(
+        struct coral_concurrent_linked_list *object,
+        const struct coral_concurrent_linked_list_item *item);
+
+/**
+ * @brief Retrieve item for key.
+ * @param [in] object linked list instance.
+ * @param [in] key on which to find item.
+ * @param [out] out receive matching item.
+ * @return On success <i>0</i>, otherwise an error code.
+ * @throws CORAL_CONCURRENT_LINKED_LIST_ERROR_OBJECT_IS_NULL if object is
+ * <i>NULL</i>.
+ * @throws CORAL_CONCURRENT_LINKED_LIST_ERROR_KEY_IS_NULL if key is
+ * <i>NULL</i>.
+ * @throws CORAL_CONCURRENT_LINKED_LIST_ERROR_OUT_IS_NULL if out is
+ * <i>NULL</i>.
+ * @throws CORAL_CONCURRENT_LINKED_LIST_ERROR_ITEM_NOT_FOUND if matching item
+ * was not found.
+ */
+int coral_concurrent_linked_list_get(
+        const struct coral_concurrent_linked_list *object,
+        const void *key,
+        struct coral_concurrent_linked_list_item **out);
+
+/**
+ * @brief Retrieve first item.
+ * @param [in] object linked list instance.
+ * @param [out] out receive first item.
+ * @return On success <i>0</i>, otherwise an error code.
+ * @throws CORAL_CONCURRENT_LINKED_LIST_ERROR_OBJECT_IS_NULL if object is
+ * <i>NULL</i>.
+ * @throws CORAL_CONCURRENT_LINKED_LIST_ERROR_OUT_IS_NULL if out is
+ * <i>NULL</i>.
+ * @throws CORAL_CONCURRENT_LINKED_LIST_ERROR_LIST_IS_EMPTY if there are no
+ * items in the linked list.
+ */
+int coral_concurrent_linked_list_first(
+        const struct coral_concurrent_linked_list *object,
+        struct coral_concurrent_linked_list_item **out);
+
+/**
+ * @brief Retrieve the next item.
+ * <p>Should item have been removed meanwhile the items that followed it are
+ * carried on with.</p>
+ * @param [in] object linked list instance.
+ * @param [in] item current item.
+ * @param [out] out receive the next item.
+ * @return On success <i>0</i>, otherwise an error code.
+ * @throws CORAL_CONCURRENT_LINKED_LIST_ERROR_OBJECT_IS_NULL if object is
+ * <i>NULL</i>.
+ * @throws CORAL_CONCURRENT_LINKED_LIST_ERROR_ITEM_IS_NULL if item is
+ * <i>NULL</i>.
+ * @throws CORAL_CONCURRENT_LINKED_LIST_ERROR_OUT_IS_NULL if out is
+ * <i>NULL</i>.
+ * @throws CORAL_CONCURRENT_LINKED_LIST_ERROR_END_OF_SEQUENCE if there is no
+ * next item.
+ */
+int coral_concurrent_linked_list_next(
+        const struct coral_concurrent_linked_list *object,
+        const struct coral_concurrent_linked_list_item *item,
+        struct coral_concurrent_linked_list_item **out);
+
+#endif /* _CORAL_CONCURRENT_LINKED_LIST_H_ */
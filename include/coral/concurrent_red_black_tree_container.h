@@ -0,0 +1,409 @@
+#ifndef _CORAL_CONCURRENT_RED_BLACK_TREE_CONTAINER_H_
+#define _CORAL_CONCURRENT_RED_BLACK_TREE_CONTAINER_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <sea-urchin.h>
+#include <coral/reader_writer_lock.h>
+#include <coral/red_black_tree_container.h>
+
+#define CORAL_CONCURRENT_RED_BLACK_TREE_CONTAINER_ERROR_SIZE_IS_ZERO \
+    CORAL_RED_BLACK_TREE_CONTAINER_ERROR_SIZE_IS_ZERO
+#define CORAL_CONCURRENT_RED_BLACK_TREE_CONTAINER_ERROR_SIZE_IS_TOO_LARGE \
+    CORAL_RED_BLACK_TREE_CONTAINER_ERROR_SIZE_IS_TOO_LARGE
+#define CORAL_CONCURRENT_RED_BLACK_TREE_CONTAINER_ERROR_OUT_IS_NULL \
+    CORAL_RED_BLACK_TREE_CONTAINER_ERROR_OUT_IS_NULL
+#define CORAL_CONCURRENT_RED_BLACK_TREE_CONTAINER_ERROR_MEMORY_ALLOCATION_FAILED \
+    CORAL_RED_BLACK_TREE_CONTAINER_ERROR_MEMORY_ALLOCATION_FAILED
+#define CORAL_CONCURRENT_RED_BLACK_TREE_CONTAINER_ERROR_ENTRY_IS_NULL \
+    CORAL_RED_BLACK_TREE_CONTAINER_ERROR_ENTRY_IS_NULL
+#define CORAL_CONCURRENT_RED_BLACK_TREE_CONTAINER_ERROR_OBJECT_IS_NULL \
+    CORAL_RED_BLACK_TREE_CONTAINER_ERROR_OBJECT_IS_NULL
+#define CORAL_CONCURRENT_RED_BLACK_TREE_CONTAINER_ERROR_COMPARE_IS_NULL \
+    CORAL_RED_BLACK_TREE_CONTAINER_ERROR_COMPARE_IS_NULL
+#define CORAL_CONCURRENT_RED_BLACK_TREE_CONTAINER_ERROR_ENTRY_ALREADY_EXISTS \
+    CORAL_RED_BLACK_TREE_CONTAINER_ERROR_ENTRY_ALREADY_EXISTS
+#define CORAL_CONCURRENT_RED_BLACK_TREE_CONTAINER_ERROR_KEY_IS_NULL \
+    CORAL_RED_BLACK_TREE_CONTAINER_ERROR_KEY_IS_NULL
+#define CORAL_CONCURRENT_RED_BLACK_TREE_CONTAINER_ERROR_ENTRY_NOT_FOUND \
+    CORAL_RED_BLACK_TREE_CONTAINER_ERROR_ENTRY_NOT_FOUND
+#define CORAL_CONCURRENT_RED_BLACK_TREE_CONTAINER_ERROR_CONTAINER_IS_EMPTY \
+    CORAL_RED_BLACK_TREE_CONTAINER_ERROR_CONTAINER_IS_EMPTY
+#define CORAL_CONCURRENT_RED_BLACK_TREE_CONTAINER_ERROR_END_OF_SEQUENCE \
+    CORAL_RED_BLACK_TREE_CONTAINER_ERROR_END_OF_SEQUENCE
+#define CORAL_CONCURRENT_RED_BLACK_TREE_CONTAINER_ERROR_FUNCTION_IS_NULL \
+    SEA_URCHIN_ERROR_VALUE_IS_NULL
+
+/**
+ * @brief Red black tree container which may be used from many threads.
+ * <p>Lookups share the container under a reader writer lock while add and
+ * remove have it to themselves. Entries are those of the red black tree
+ * container and are allocated and freed with its functions.</p>
+ * <p>An entry handed out by a lookup stays valid until some thread removes
+ * and frees it, it is up to the caller to not free entries that other
+ * threads may still be looking at.</p>
+ */
+struct coral_concurrent_red_black_tree_container {
+    struct coral_red_black_tree_container container;
+    struct coral_reader_writer_lock lock;
+};
+
+/**
+ * @brief Initialize concurrent red black tree container.
+ * @param [in] object instance to be initialized.
+ * @param [in] compare comparison which must return an integer less than, equal
+ * to, or greater than zero if the <u>first key</u> is considered to be
+ * respectively less than, equal to, or greater than the <u>second key</u>.
+ * @return On success <i>0</i>, otherwise an error code.
+ * @throws CORAL_CONCURRENT_RED_BLACK_TREE_CONTAINER_ERROR_OBJECT_IS_NULL if
+ * object is <i>NULL</i>.
+ * @throws CORAL_CONCURRENT_RED_BLACK_TREE_CONTAINER_ERROR_COMPARE_IS_NULL if
+ * compare is <i>NULL</i>.
+ * @throws CORAL_CONCURRENT_RED_BLACK_TREE_CONTAINER_ERROR_MEMORY_ALLOCATION_FAILED
+ * if there is not enough memory for the lock.
+ */
+int coral_concurrent_red_black_tree_container_init(
+        struct coral_concurrent_red_black_tree_container *object,
+        int (*compare)(const void *first,
+                       const void *second));
+
+/**
+ * @brief Initialize concurrent red black tree container with a key comparison.
+ * <p>The key comparison allows the <i>_key</i> lookup functions to take a
+ * compact key instead of an entry shaped one.</p>
+ * @param [in] object instance to be initialized.
+ * @param [in] compare comparison which must return an integer less than, equal
+ * to, or greater than zero if the <u>first key</u> is considered to be
+ * respectively less than, equal to, or greater than the <u>second key</u>.
+ * @param [in] compare_key comparison which must return an integer less than,
+ * equal to, or greater than zero if the <u>key</u> is considered to be
+ * respectively less than, equal to, or greater than the <u>entry</u>. It must
+ * order the entries the same way as <i>compare</i> does.
+ * @return On success <i>0</i>, otherwise an error code.
+ * @throws CORAL_CONCURRENT_RED_BLACK_TREE_CONTAINER_ERROR_OBJECT_IS_NULL if
+ * object is <i>NULL</i>.
+ * @throws CORAL_CONCURRENT_RED_BLACK_TREE_CONTAINER_ERROR_COMPARE_IS_NULL if
+ * compare or compare_key is <i>NULL</i>.
+ * @throws CORAL_CONCURRENT_RED_BLACK_TREE_CONTAINER_ERROR_MEMORY_ALLOCATION_FAILED
+ * if there is not enough memory for the lock.
+ */
+int coral_concurrent_red_black_tree_container_init_with_key(
+        struct coral_concurrent_red_black_tree_container *object,
+        int (*compare)(const void *first,
+                       const void *second),
+        int (*compare_key)(const void *key,
+                           const void *entry));
+
+/**
+ * @brief Invalidate concurrent red black tree container.
+ * <p>The entries in the container are destroyed and each entry will have the
+ * provided <i>on destroy</i> callback invoked upon itself. The actual
+ * <u>container instance is not deallocated</u> since it may have been embedded
+ * in a larger structure.</p>
+ * <p>No other thread may be using the container.</p>
+ * @param [in] object instance to be invalidated.
+ * @param [in] on_destroy called just before the entry is to be destroyed.
+ * @return On success <i>0</i>, otherwise an error code.
+ * @throws CORAL_CONCURRENT_RED_BLACK_TREE_CONTAINER_ERROR_OBJECT_IS_NULL if
+ * object is <i>NULL</i>.
+ */
+int coral_concurrent_red_black_tree_container_invalidate(
+        struct coral_concurrent_red_black_tree_container *object,
+        void (*on_destroy)(struct coral_red_black_tree_container_entry *entry));
+
+/**
+ * @brief Retrieve the count of entries.
+ * @param [in] object instance whose count we are to retrieve.
+ * @param [out] out receive the entry count.
+ * @return On success <i>0</i>, otherwise an error code.
+ * @throws CORAL_CONCURRENT_RED_BLACK_TREE_CONTAINER_ERROR_OBJECT_IS_NULL if
+ * object is <i>NULL</i>.
+ * @throws CORAL_CONCURRENT_RED_BLACK_TREE_CONTAINER_ERROR_OUT_IS_NULL if out is
+ * <i>NULL</i>.
+ */
+int coral_concurrent_red_black_tree_container_count(
+        const struct coral_concurrent_red_black_tree_container *object,
+        uintmax_t *out);
+
+/**
+ * @brief Add entry.
+ * @param [in] object container instance.
+ * @param [in] entry to add.
+ * @return On success <i>0</i>, otherwise an error code.
+ * @throws CORAL_CONCURRENT_RED_BLACK_TREE_CONTAINER_ERROR_OBJECT_IS_NULL if
+ * object is <i>NULL</i>.
+ * @throws CORAL_CONCURRENT_RED_BLACK_TREE_CONTAINER_ERROR_ENTRY_IS_NULL if
+ * entry is <i>NULL</i>.
+ * @throws CORAL_CONCURRENT_RED_BLACK_TREE_CONTAINER_ERROR_ENTRY_ALREADY_EXISTS
+ * if entry is already present in container.
+ */
+int coral_concurrent_red_black_tree_container_add(
+        struct coral_concurrent_red_black_tree_container *object,
+        const struct coral_red_black_tree_container_entry *entry);
+
+/**
+ * @brief Remove entry.
+ * @param [in] object container instance.
+ * @param [in] entry to remove.
+ * @return On success <i>0</i>, otherwise an error code.
+ * @throws CORAL_CONCURRENT_RED_BLACK_TREE_CONTAINER_ERROR_OBJECT_IS_NULL if
+ * object is <i>NULL</i>.
+ * @throws CORAL_CONCURRENT_RED_BLACK_TREE_CONTAINER_ERROR_ENTRY_IS_NULL if
+ * entry is <i>NULL</i>.
+ */
+int coral_concurrent_red_black_tree_container_remove(
+        struct coral_concurrent_red_black_tree_container *object,
+        const struct coral_red_black_tree_container_entry *entry);
+
+/**
+ * @brief Retrieve entry for key.
+ * @param [in] object container instance.
+ * @param [in] key on which to find entry.
+ * @param [out] out receive matching entry.
+ * @return On success <i>0</i>, otherwise an error code.
+ * @throws CORAL_CONCURRENT_RED_BLACK_TREE_CONTAINER_ERROR_OBJECT_IS_NULL if
+ * object is <i>NULL</i>.
+ * @throws CORAL_CONCURRENT_RED_BLACK_TREE_CONTAINER_ERROR_KEY_IS_NULL if key is
+ * <i>NULL</i>.
+ * @throws CORAL_CONCURRENT_RED_BLACK_TREE_CONTAINER_ERROR_OUT_IS_NULL if out is
+ * <i>NULL</i>.
+ * @throws CORAL_CONCURRENT_RED_BLACK_TREE_CONTAINER_ERROR_ENTRY_NOT_FOUND if
+ * matching entry was not found.
+ */
+int coral_concurrent_red_black_tree_container_get(
+        const struct coral_concurrent_red_black_tree_container *object,
+        const void *key,
+        struct coral_red_black_tree_container_entry **out);
+
+/**
+ * @brief Retrieve entry for key using the key comparison.
+ * @param [in] object container instance.
+ * @param [in] key on which to find entry.
+ * @param [out] out receive matching entry.
+ * @return On success <i>0</i>, otherwise an error code.
+ * @throws CORAL_CONCURRENT_RED_BLACK_TREE_CONTAINER_ERROR_OBJECT_IS_NULL if
+ * object is <i>NULL</i>.
+ * @throws CORAL_CONCURRENT_RED_BLACK_TREE_CONTAINER_ERROR_KEY_IS_NULL if key is
+ * <i>NULL</i>.
+ * @throws CORAL_CONCURRENT_RED_BLACK_TREE_CONTAINER_ERROR_OUT_IS_NULL if out is
+ * <i>NULL</i>.
+ * @throws CORAL_CONCURRENT_RED_BLACK_TREE_CONTAINER_ERROR_COMPARE_IS_NULL if
+ * the container was not initialized with a key comparison.
+ * @throws CORAL_CONCURRENT_RED_BLACK_TREE_CONTAINER_ERROR_ENTRY_NOT_FOUND if
+ * matching entry was not found.
+ */
+int coral_concurrent_red_black_tree_container_get_key(
+        const struct coral_concurrent_red_black_tree_container *object,
+        const void *key,
+        struct coral_red_black_tree_container_entry **out);
+
+/**
+ * @brief Retrieve entry or next higher for key.
+ * @param [in] object container instance.
+ * @param [in] key on which to find entry or next higher.
+ * @param [out] out receive matching entry.
+ * @return On success <i>0</i>, otherwise an error code.
+ * @throws CORAL_CONCURRENT_RED_BLACK_TREE_CONTAINER_ERROR_OBJECT_IS_NULL if
+ * object is <i>NULL</i>.
+ * @throws CORAL_CONCURRENT_RED_BLACK_TREE_CONTAINER_ERROR_KEY_IS_NULL if key is
+ * <i>NULL</i>.
+ * @throws CORAL_CONCURRENT_RED_BLACK_TREE_CONTAINER_ERROR_OUT_IS_NULL if out is
+ * <i>NULL</i>.
+ * @throws CORAL_CONCURRENT_RED_BLACK_TREE_CONTAINER_ERROR_ENTRY_NOT_FOUND if
+ * matching entry or next higher entry was not found.
+ */
+int coral_concurrent_red_black_tree_container_ceiling(
+        const struct coral_concurrent_red_black_tree_container *object,
+        const void *key,
+        struct coral_red_black_tree_container_entry **out);
+
+/**
+ * @brief Retrieve entry or next higher for key using the key comparison.
+ * @param [in] object container instance.
+ * @param [in] key on which to find entry or next higher.
+ * @param [out] out receive matching entry.
+ * @return On success <i>0</i>, otherwise an error code.
+ * @throws CORAL_CONCURRENT_RED_BLACK_TREE_CONTAINER_ERROR_OBJECT_IS_NULL if
+ * object is <i>NULL</i>.
+ * @throws CORAL_CONCURRENT_RED_BLACK_TREE_CONTAINER_ERROR_KEY_IS_NULL if key is
+ * <i>NULL</i>.
+ * @throws CORAL_CONCURRENT_RED_BLACK_TREE_CONTAINER_ERROR_OUT_IS_NULL if out is
+ * <i>NULL</i>.
+ * @throws CORAL_CONCURRENT_RED_BLACK_TREE_CONTAINER_ERROR_COMPARE_IS_NULL if
+ * the container was not initialized with a key comparison.
+ * @throws CORAL_CONCURRENT_RED_BLACK_TREE_CONTAINER_ERROR_ENTRY_NOT_FOUND if
+ * matching entry or next higher entry was not found.
+ */
+int coral_concurrent_red_black_tree_container_ceiling_key(
+        const struct coral_concurrent_red_black_tree_container *object,
+        const void *key,
+        struct coral_red_black_tree_container_entry **out);
+
+/**
+ * @brief Retrieve entry or next lower for key.
+ * @param [in] object container instance.
+ * @param [in] key on which to find entry or next lower.
+ * @param [out] out receive matching entry.
+ * @return On success <i>0</i>, otherwise an error code.
+ * @throws CORAL_CONCURRENT_RED_BLACK_TREE_CONTAINER_ERROR_OBJECT_IS_NULL if
+ * object is <i>NULL</i>.
+ * @throws CORAL_CONCURRENT_RED_BLACK_TREE_CONTAINER_ERROR_KEY_IS_NULL if key is
+ * <i>NULL</i>.
+ * @throws CORAL_CONCURRENT_RED_BLACK_TREE_CONTAINER_ERROR_OUT_IS_NULL if out is
+ * <i>NULL</i>.
+ * @throws CORAL_CONCURRENT_RED_BLACK_TREE_CONTAINER_ERROR_ENTRY_NOT_FOUND if
+ * matching entry or next lower entry was not found.
+ */
+int coral_concurrent_red_black_tree_container_floor(
+        const struct coral_concurrent_red_black_tree_container *object,
+        const void *key,
+        struct coral_red_black_tree_container_entry **out);
+
+/**
+ * @brief Retrieve entry or next lower for key using the key comparison.
+ * @param [in] object container instance.
+ * @param [in] key on which to find entry or next lower.
+ * @param [out] out receive matching entry.
+ * @return On success <i>0</i>, otherwise an error code.
+ * @throws CORAL_CONCURRENT_RED_BLACK_TREE_CONTAINER_ERROR_OBJECT_IS_NULL if
+ * object is <i>NULL</i>.
+ * @throws CORAL_CONCURRENT_RED_BLACK_TREE_CONTAINER_ERROR_KEY_IS_NULL if key is
+ * <i>NULL</i>.
+ * @throws CORAL_CONCURRENT_RED_BLACK_TREE_CONTAINER_ERROR_OUT_IS_NULL if out is
+ * <i>NULL</i>.
+ * @throws CORAL_CONCURRENT_RED_BLACK_TREE_CONTAINER_ERROR_COMPARE_IS_NULL if
+ * the container was not initialized with a key comparison.
+ * @throws CORAL_CONCURRENT_RED_BLACK_TREE_CONTAINER_ERROR_ENTRY_NOT_FOUND if
+ * matching entry or next lower entry was not found.
+ */
+int coral_concurrent_red_black_tree_container_floor_key(
+        const struct coral_concurrent_red_black_tree_container *object,
+        const void *key,
+        struct coral_red_black_tree_container_entry **out);
+
+/**
+ * @brief Retrieve next higher entry for key.
+ * @param [in] object container instance.
+ * @param [in] key on which to find next higher entry.
+ * @param [out] out receive matching entry.
+ * @return On success <i>0</i>, otherwise an error code.
+ * @throws CORAL_CONCURRENT_RED_BLACK_TREE_CONTAINER_ERROR_OBJECT_IS_NULL if
+ * object is <i>NULL</i>.
+ * @throws CORAL_CONCURRENT_RED_BLACK_TREE_CONTAINER_ERROR_KEY_IS_NULL if key is
+ * <i>NULL</i>.
+ * @throws CORAL_CONCURRENT_RED_BLACK_TREE_CONTAINER_ERROR_OUT_IS_NULL if out is
+ * <i>NULL</i>.
+ * @throws CORAL_CONCURRENT_RED_BLACK_TREE_CONTAINER_ERROR_ENTRY_NOT_FOUND if
+ * next higher entry was not found.
+ */
+int coral_concurrent_red_black_tree_container_higher(
+        const struct coral_concurrent_red_black_tree_container *object,
+        const void *key,
+        struct coral_red_black_tree_container_entry **out);
+
+/**
+ * @brief Retrieve next higher entry for key using the key comparison.
+ * @param [in] object container instance.
+ * @param [in] key on which to find next higher entry.
+ * @param [out] out receive matching entry.
+ * @return On success <i>0</i>, otherwise an error code.
+ * @throws CORAL_CONCURRENT_RED_BLACK_TREE_CONTAINER_ERROR_OBJECT_IS_NULL if
+ * object is <i>NULL</i>.
+ * @throws CORAL_CONCURRENT_RED_BLACK_TREE_CONTAINER_ERROR_KEY_IS_NULL if key is
+ * <i>NULL</i>.
+ * @throws CORAL_CONCURRENT_RED_BLACK_TREE_CONTAINER_ERROR_OUT_IS_NULL if out is
+ * <i>NULL</i>.
+ * @throws CORAL_CONCURRENT_RED_BLACK_TREE_CONTAINER_ERROR_COMPARE_IS_NULL if
+ * the container was not initialized with a key comparison.
+ * @throws CORAL_CONCURRENT_RED_BLACK_TREE_CONTAINER_ERROR_ENTRY_NOT_FOUND if
+ * next higher entry was not found.
+ */
+int coral_concurrent_red_black_tree_container_higher_key(
+        const struct coral_concurrent_red_black_tree_container *object,
+        const void *key,
+        struct coral_red_black_tree_container_entry **out);
+
+/**
+ * @brief Retrieve next lower entry for key.
+ * @param [in] object container instance.
+ * @param [in] key on which to find next lower entry.
+ * @param [out] out receive matching entry.
+ * @return On success <i>0</i>, otherwise an error code.
+ * @throws CORAL_CONCURRENT_RED_BLACK_TREE_CONTAINER_ERROR_OBJECT_IS_NULL if
+ * object is <i>NULL</i>.
+ * @throws CORAL_CONCURRENT_RED_BLACK_TREE_CONTAINER_ERROR_KEY_IS_NULL if key is
+ * <i>NULL</i>.
+ * @throws CORAL_CONCURRENT_RED_BLACK_TREE_CONTAINER_ERROR_OUT_IS_NULL if out is
+ * <i>NULL</i>.
+ * @throws CORAL_CONCURRENT_RED_BLACK_TREE_CONTAINER_ERROR_ENTRY_NOT_FOUND if
+ * next lower entry was not found.
+ */
+int coral_concurrent_red_black_tree_container_lower(
+        const struct coral_concurrent_red_black_tree_container *object,
+        const void *key,
+        struct coral_red_black_tree_container_entry **out);
+
+/**
+ * @brief Retrieve next lower entry for key using the key comparison.
+ * @param [in] object container instance.
+ * @param [in] key on which to find next lower entry.
+ * @param [out] out receive matching entry.
+ * @return On success <i>0</i>, otherwise an error code.
+ * @throws CORAL_CONCURRENT_RED_BLACK_TREE_CONTAINER_ERROR_OBJECT_IS_NULL if
+ * object is <i>NULL</i>.
+ * @throws CORAL_CONCURRENT_RED_BLACK_TREE_CONTAINER_ERROR_KEY_IS_NULL if key is
+ * <i>NULL</i>.
+ * @throws CORAL_CONCURRENT_RED_BLACK_TREE_CONTAINER_ERROR_OUT_IS_NULL if out is
+ * <i>NULL</i>.
+ * @throws CORAL_CONCURRENT_RED_BLACK_TREE_CONTAINER_ERROR_COMPARE_IS_NULL if
+ * the container was not initialized with a key comparison.
+ * @throws CORAL_CONCURRENT_RED_BLACK_TREE_CONTAINER_ERROR_ENTRY_NOT_FOUND if
+ * next lower entry was not found.
+ */
+int coral_concurrent_red_black_tree_container_lower_key(
+        const struct coral_concurrent_red_black_tree_container *object,
+        const void *key,
+        struct coral_red_black_tree_container_entry **out);
+
+/**
+ * @brief Run function with the container shared with other readers.
+ * <p>Use it for anything the other functions do not cover, such as
+ * iterating over the entries, while no entry can be added or removed.</p>
+ * <p>Function must not call back into this container.</p>
+ * @param [in] object container instance.
+ * @param [in] function to run with the wrapped container.
+ * @param [in] context passed on to function.
+ * @return On success the value returned by function, otherwise an error code.
+ * @throws CORAL_CONCURRENT_RED_BLACK_TREE_CONTAINER_ERROR_OBJECT_IS_NULL if
+ * object is <i>NULL</i>.
+ * @throws CORAL_CONCURRENT_RED_BLACK_TREE_CONTAINER_ERROR_FUNCTION_IS_NULL if
+ * function is <i>NULL</i>.
+ */
+int coral_concurrent_red_black_tree_container_read(
+        const struct coral_concurrent_red_black_tree_container *object,
+        int (*function)(const struct coral_red_black_tree_container *container,
+                        void *context),
+        void *context);
+
+/**
+ * @brief Run function with the container to itself.
+ * <p>Use it to make several changes at once, such as removing a range of
+ * entries, without other threads seeing the changes half done.</p>
+ * <p>Function must not call back into this container.</p>
+ * @param [in] object container instance.
+ * @param [in] function to run with the wrapped container.
+ * @param [in] context passed on to function.
+ * @return On success the value returned by function, otherwise an error code.
+ * @throws CORAL_CONCURRENT_RED_BLACK_TREE_CONTAINER_ERROR_OBJECT_IS_NULL if
+ * object is <i>NULL</i>.
+ * @throws CORAL_CONCURRENT_RED_BLACK_TREE_CONTAINER_ERROR_FUNCTION_IS_NULL if
+ * function is <i>NULL</i>.
+ */
+int coral_concurrent_red_black_tree_container_write(
+        struct coral_concurrent_red_black_tree_container *object,
+        int (*function)(struct coral_red_black_tree_container *container,
+                        void *context),
+        void *context);
+
+#endif /* _CORAL_CONCURRENT_RED_BLACK_TREE_CONTAINER_H_ */
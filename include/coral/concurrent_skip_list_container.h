@@ -0,0 +1,403 @@
+#ifndef _CORAL_CONCURRENT_SKIP_LIST_CONTAINER_H_
+#define _CORAL_CONCURRENT_SKIP_LIST_CONTAINER_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+#include <sea-urchin.h>
+#include <coral/allocator.h>
+#include <coral/epoch.h>
+#include <coral/red_black_tree_container.h>
+
+#define CORAL_CONCURRENT_SKIP_LIST_CONTAINER_ERROR_SIZE_IS_ZERO \
+    CORAL_RED_BLACK_TREE_CONTAINER_ERROR_SIZE_IS_ZERO
+#define CORAL_CONCURRENT_SKIP_LIST_CONTAINER_ERROR_SIZE_IS_TOO_LARGE \
+    CORAL_RED_BLACK_TREE_CONTAINER_ERROR_SIZE_IS_TOO_LARGE
+#define CORAL_CONCURRENT_SKIP_LIST_CONTAINER_ERROR_OUT_IS_NULL \
+    CORAL_RED_BLACK_TREE_CONTAINER_ERROR_OUT_IS_NULL
+#define CORAL_CONCURRENT_SKIP_LIST_CONTAINER_ERROR_MEMORY_ALLOCATION_FAILED \
+    CORAL_RED_BLACK_TREE_CONTAINER_ERROR_MEMORY_ALLOCATION_FAILED
+#define CORAL_CONCURRENT_SKIP_LIST_CONTAINER_ERROR_ENTRY_IS_NULL \
+    CORAL_RED_BLACK_TREE_CONTAINER_ERROR_ENTRY_IS_NULL
+#define CORAL_CONCURRENT_SKIP_LIST_CONTAINER_ERROR_OBJECT_IS_NULL \
+    CORAL_RED_BLACK_TREE_CONTAINER_ERROR_OBJECT_IS_NULL
+#define CORAL_CONCURRENT_SKIP_LIST_CONTAINER_ERROR_COMPARE_IS_NULL \
+    CORAL_RED_BLACK_TREE_CONTAINER_ERROR_COMPARE_IS_NULL
+#define CORAL_CONCURRENT_SKIP_LIST_CONTAINER_ERROR_ENTRY_ALREADY_EXISTS \
+    CORAL_RED_BLACK_TREE_CONTAINER_ERROR_ENTRY_ALREADY_EXISTS
+#define CORAL_CONCURRENT_SKIP_LIST_CONTAINER_ERROR_KEY_IS_NULL \
+    CORAL_RED_BLACK_TREE_CONTAINER_ERROR_KEY_IS_NULL
+#define CORAL_CONCURRENT_SKIP_LIST_CONTAINER_ERROR_ENTRY_NOT_FOUND \
+    CORAL_RED_BLACK_TREE_CONTAINER_ERROR_ENTRY_NOT_FOUND
+#define CORAL_CONCURRENT_SKIP_LIST_CONTAINER_ERROR_CONTAINER_IS_EMPTY \
+    CORAL_RED_BLACK_TREE_CONTAINER_ERROR_CONTAINER_IS_EMPTY
+#define CORAL_CONCURRENT_SKIP_LIST_CONTAINER_ERROR_END_OF_SEQUENCE \
+    CORAL_RED_BLACK_TREE_CONTAINER_ERROR_END_OF_SEQUENCE
+#define CORAL_CONCURRENT_SKIP_LIST_CONTAINER_ERROR_THREAD_IS_NULL \
+    CORAL_EPOCH_ERROR_THREAD_IS_NULL
+
+/* levels of the tallest entry, enough for 4^16 entries */
+#define CORAL_CONCURRENT_SKIP_LIST_CONTAINER_MAXIMUM_HEIGHT 16
+
+struct coral_concurrent_skip_list_container_entry;
+
+/**
+ * @brief Sorted container which many threads may add to, remove from and
+ * look into at the same time without taking any lock.
+ * <p>Entries are linked into a skip list with compare and swap, an entry
+ * being removed is first marked on every level and then unlinked by
+ * whichever thread next walks past it.</p>
+ * <p>Removing an entry does not free it, it is up to the caller to not free
+ * entries that other threads may still be looking at. Threads that only look
+ * at entries from within critical sections of a shared epoch can have removed
+ * entries retired rather than freed.</p>
+ */
+struct coral_concurrent_skip_list_container {
+    int (*compare)(const void *, const void *);
+    atomic_uintptr_t head[CORAL_CONCURRENT_SKIP_LIST_CONTAINER_MAXIMUM_HEIGHT];
+    atomic_uintmax_t count;
+};
+
+/**
+ * @brief Allocate memory for an entry.
+ * <p>Memory is obtained from the default allocator.</p>
+ * @param [in] size in bytes of entry to create.
+ * @param [out] out receive allocated entry.
+ * @return On success <i>0</i>, otherwise an error code.
+ * @throws CORAL_CONCURRENT_SKIP_LIST_CONTAINER_ERROR_OUT_IS_NULL if out is
+ * <i>NULL</i>.
+ * @throws CORAL_CONCURRENT_SKIP_LIST_CONTAINER_ERROR_SIZE_IS_ZERO if size if
+ * zero.
+ * @throws CORAL_CONCURRENT_SKIP_LIST_CONTAINER_ERROR_SIZE_IS_TOO_LARGE if size
+ * is too large.
+ * @throws CORAL_CONCURRENT_SKIP_LIST_CONTAINER_ERROR_MEMORY_ALLOCATION_FAILED
+ * if there is not enough memory to allocate an entry.
+ */
+int coral_concurrent_skip_list_container_alloc(
+        size_t size,
+        struct coral_concurrent_skip_list_container_entry **out);
+
+/**
+ * @brief Allocate memory for an entry from the given allocator.
+ * <p>Entries vary in size with the height they draw, so they cannot come from
+ * an allocator handing out blocks of a single size such as an entry
+ * pool.</p>
+ * @param [in] allocator to allocate from or <i>NULL</i> for the default
+ * allocator.
+ * @param [in] size in bytes of entry to create.
+ * @param [out] out receive allocated entry.
+ * @return On success <i>0</i>, otherwise an error code.
+ * @throws CORAL_CONCURRENT_SKIP_LIST_CONTAINER_ERROR_OUT_IS_NULL if out is
+ * <i>NULL</i>.
+ * @throws CORAL_CONCURRENT_SKIP_LIST_CONTAINER_ERROR_SIZE_IS_ZERO if size if
+ * zero.
+ * @throws CORAL_CONCURRENT_SKIP_LIST_CONTAINER_ERROR_SIZE_IS_TOO_LARGE if size
+ * is too large.
+ * @throws CORAL_CONCURRENT_SKIP_LIST_CONTAINER_ERROR_MEMORY_ALLOCATION_FAILED
+ * if there is not enough memory to allocate an entry.
+ */
+int coral_concurrent_skip_list_container_alloc_with(
+        const struct coral_allocator *allocator,
+        size_t size,
+        struct coral_concurrent_skip_list_container_entry **out);
+
+/**
+ * @brief Free memory of an entry.
+ * <p>Memory is returned to the allocator the entry was allocated from. A
+ * removed entry may only be freed once no other thread can still be looking at
+ * it.</p>
+ * @param [in] entry to be freed.
+ * @return On success <i>0</i>, otherwise an error code.
+ * @throws CORAL_CONCURRENT_SKIP_LIST_CONTAINER_ERROR_ENTRY_IS_NULL if entry is
+ * <i>NULL</i>.
+ */
+int coral_concurrent_skip_list_container_free(
+        struct coral_concurrent_skip_list_container_entry *entry);
+
+/**
+ * @brief Free memory of an entry once no thread can still be looking at it.
+ * <p>The entry is freed through the epoch thread is registered with, once
+ * every thread that was in a critical section of that epoch has left it.
+ * Should another thread still be linking the entry, it is only freed once
+ * that is done and every thread has left the critical sections entered
+ * meanwhile.</p>
+ * @param [in] thread registered with the epoch shared by the threads looking
+ * at entries.
+ * @param [in] entry to be freed, which must have been removed.
+ * @return On success <i>0</i>, otherwise an error code.
+ * @throws CORAL_CONCURRENT_SKIP_LIST_CONTAINER_ERROR_THREAD_IS_NULL if thread
+ * is <i>NULL</i>.
+ * @throws CORAL_CONCURRENT_SKIP_LIST_CONTAINER_ERROR_ENTRY_IS_NULL if entry is
+ * <i>NULL</i>.
+ * @throws CORAL_CONCURRENT_SKIP_LIST_CONTAINER_ERROR_MEMORY_ALLOCATION_FAILED
+ * if there is not enough memory to defer freeing the entry, entry was not
+ * freed.
+ */
+int coral_concurrent_skip_list_container_retire(
+        struct coral_epoch_thread *thread,
+        struct coral_concurrent_skip_list_container_entry *entry);
+
+/**
+ * @brief Initialize concurrent skip list container.
+ * @param [in] object instance to be initialized.
+ * @param [in] compare comparison which must return an integer less than, equal
+ * to, or greater than zero if the <u>first key</u> is considered to be
+ * respectively less than, equal to, or greater than the <u>second key</u>.
+ * @return On success <i>0</i>, otherwise an error code.
+ * @throws CORAL_CONCURRENT_SKIP_LIST_CONTAINER_ERROR_OBJECT_IS_NULL if object
+ * is <i>NULL</i>.
+ * @throws CORAL_CONCURRENT_SKIP_LIST_CONTAINER_ERROR_COMPARE_IS_NULL if compare
+ * is <i>NULL</i>.
+ */
+int coral_concurrent_skip_list_container_init(
+        struct coral_concurrent_skip_list_container *object,
+        int (*compare)(const void *first,
+                       const void *second));
+
+/**
+ * @brief Invalidate concurrent skip list container.
+ * <p>The entries in the container are destroyed and each entry will have the
+ * provided <i>on destroy</i> callback invoked upon itself. The actual
+ * <u>container instance is not deallocated</u> since it may have been embedded
+ * in a larger structure.</p>
+ * <p>No other thread may be using the container.</p>
+ * @param [in] object instance to be invalidated.
+ * @param [in] on_destroy called just before the entry is to be destroyed.
+ * @return On success <i>0</i>, otherwise an error code.
+ * @throws CORAL_CONCURRENT_SKIP_LIST_CONTAINER_ERROR_OBJECT_IS_NULL if object
+ * is <i>NULL</i>.
+ */
+int coral_concurrent_skip_list_container_invalidate(
+        struct coral_concurrent_skip_list_container *object,
+        void (*on_destroy)(
+                struct coral_concurrent_skip_list_container_entry *entry));
+
+/**
+ * @brief Retrieve the count of entries.
+ * @param [in] object instance whose count we are to retrieve.
+ * @param [out] out receive the entry count.
+ * @return On success <i>0</i>, otherwise an error code.
+ * @throws CORAL_CONCURRENT_SKIP_LIST_CONTAINER_ERROR_OBJECT_IS_NULL if object
+ * is <i>NULL</i>.
+ * @throws CORAL_CONCURRENT_SKIP_LIST_CONTAINER_ERROR_OUT_IS_NULL if out is
+ * <i>NULL</i>.
+ */
+int coral_concurrent_skip_list_container_count(
+        const struct coral_concurrent_skip_list_container *object,
+        uintmax_t *out);
+
+/**
+ * @brief Add entry.
+ * @param [in] object container instance.
+ * @param [in] entry to add.
+ * @return On success <i>0</i>, otherwise an error code.
+ * @throws CORAL_CONCURRENT_SKIP_LIST_CONTAINER_ERROR_OBJECT_IS_NULL if object
+ * is <i>NULL</i>.
+ * @throws CORAL_CONCURRENT_SKIP_LIST_CONTAINER_ERROR_ENTRY_IS_NULL if entry is
+ * <i>NULL</i>.
+ * @throws CORAL_CONCURRENT_SKIP_LIST_CONTAINER_ERROR_ENTRY_ALREADY_EXISTS if
+ * entry is already present in container.
+ */
+int coral_concurrent_skip_list_container_add(
+        struct coral_concurrent_skip_list_container *object,
+        const struct coral_concurrent_skip_list_container_entry *entry);
+
+/**
+ * @brief Remove entry.
+ * <p>Once removed the entry is no longer reachable from the container yet other
+ * threads may still be looking at it. Should another thread still be linking
+ * the entry on its upper levels, the entry stays reachable until that thread
+ * is done.</p>
+ * @param [in] object container instance.
+ * @param [in] entry to remove.
+ * @return On success <i>0</i>, otherwise an error code.
+ * @throws CORAL_CONCURRENT_SKIP_LIST_CONTAINER_ERROR_OBJECT_IS_NULL if object
+ * is <i>NULL</i>.
+ * @throws CORAL_CONCURRENT_SKIP_LIST_CONTAINER_ERROR_ENTRY_IS_NULL if entry is
+ * <i>NULL</i>.
+ * @throws CORAL_CONCURRENT_SKIP_LIST_CONTAINER_ERROR_ENTRY_NOT_FOUND if entry
+ * is not present in container, which includes it having just been removed by
+ * another thread.
+ */
+int coral_concurrent_skip_list_container_remove(
+        struct coral_concurrent_skip_list_container *object,
+        const struct coral_concurrent_skip_list_container_entry *entry);
+
+/**
+ * @brief Retrieve entry for key.
+ * @param [in] object container instance.
+ * @param [in] key on which to find entry.
+ * @param [out] out receive matching entry.
+ * @return On success <i>0</i>, otherwise an error code.
+ * @throws CORAL_CONCURRENT_SKIP_LIST_CONTAINER_ERROR_OBJECT_IS_NULL if object
+ * is <i>NULL</i>.
+ * @throws CORAL_CONCURRENT_SKIP_LIST_CONTAINER_ERROR_KEY_IS_NULL if key is
+ * <i>NULL</i>.
+ * @throws CORAL_CONCURRENT_SKIP_LIST_CONTAINER_ERROR_OUT_IS_NULL if out is
+ * <i>NULL</i>.
+ * @throws CORAL_CONCURRENT_SKIP_LIST_CONTAINER_ERROR_ENTRY_NOT_FOUND if
+ * matching entry was not found.
+ */
+int coral_concurrent_skip_list_container_get(
+        const struct coral_concurrent_skip_list_container *object,
+        const void *key,
+        struct coral_concurrent_skip_list_container_entry **out);
+
+/**
+ * @brief Retrieve entry or next higher for key.
+ * @param [in] object container instance.
+ * @param [in] key on which to find entry or next higher.
+ * @param [out] out receive matching entry.
+ * @return On success <i>0</i>, otherwise an error code.
+ * @throws CORAL_CONCURRENT_SKIP_LIST_CONTAINER_ERROR_OBJECT_IS_NULL if object
+ * is <i>NULL</i>.
+ * @throws CORAL_CONCURRENT_SKIP_LIST_CONTAINER_ERROR_KEY_IS_NULL if key is
+ * <i>NULL</i>.
+ * @throws CORAL_CONCURRENT_SKIP_LIST_CONTAINER_ERROR_OUT_IS_NULL if out is
+ * <i>NULL</i>.
+ * @throws CORAL_CONCURRENT_SKIP_LIST_CONTAINER_ERROR_ENTRY_NOT_FOUND if
+ * matching entry or next higher entry was not found.
+ */
+int coral_concurrent_skip_list_container_ceiling(
+        const struct coral_concurrent_skip_list_container *object,
+        const void *key,
+        struct coral_concurrent_skip_list_container_entry **out);
+
+/**
+ * @brief Retrieve entry or next lower for key.
+ * @param [in] object container instance.
+ * @param [in] key on which to find entry or next lower.
+ * @param [out] out receive matching entry.
+ * @return On success <i>0</i>, otherwise an error code.
+ * @throws CORAL_CONCURRENT_SKIP_LIST_CONTAINER_ERROR_OBJECT_IS_NULL if object
+ * is <i>NULL</i>.
+ * @throws CORAL_CONCURRENT_SKIP_LIST_CONTAINER_ERROR_KEY_IS_NULL if key is
+ * <i>NULL</i>.
+ * @throws CORAL_CONCURRENT_SKIP_LIST_CONTAINER_ERROR_OUT_IS_NULL if out is
+ * <i>NULL</i>.
+ * @throws CORAL_CONCURRENT_SKIP_LIST_CONTAINER_ERROR_ENTRY_NOT_FOUND if
+ * matching entry or next lower entry was not found.
+ */
+int coral_concurrent_skip_list_container_floor(
+        const struct coral_concurrent_skip_list_container *object,
+        const void *key,
+        struct coral_concurrent_skip_list_container_entry **out);
+
+/**
+ * @brief Retrieve next higher entry for key.
+ * @param [in] object container instance.
+ * @param [in] key on which to find next higher entry.
+ * @param [out] out receive matching entry.
+ * @return On success <i>0</i>, otherwise an error code.
+ * @throws CORAL_CONCURRENT_SKIP_LIST_CONTAINER_ERROR_OBJECT_IS_NULL if object
+ * is <i>NULL</i>.
+ * @throws CORAL_CONCURRENT_SKIP_LIST_CONTAINER_ERROR_KEY_IS_NULL if key is
+ * <i>NULL</i>.
+ * @throws CORAL_CONCURRENT_SKIP_LIST_CONTAINER_ERROR_OUT_IS_NULL if out is
+ * <i>NULL</i>.
+ * @throws CORAL_CONCURRENT_SKIP_LIST_CONTAINER_ERROR_ENTRY_NOT_FOUND if next
+ * higher entry was not found.
+ */
+int coral_concurrent_skip_list_container_higher(
+        const struct coral_concurrent_skip_list_container *object,
+        const void *key,
+        struct coral_concurrent_skip_list_container_entry **out);
+
+/**
+ * @brief Retrieve next lower entry for key.
+ * @param [in] object container instance.
+ * @param [in] key on which to find next lower entry.
+ * @param [out] out receive matching entry.
+ * @return On success <i>0</i>, otherwise an error code.
+ * @throws CORAL_CONCURRENT_SKIP_LIST_CONTAINER_ERROR_OBJECT_IS_NULL if object
+ * is <i>NULL</i>.
+ * @throws CORAL_CONCURRENT_SKIP_LIST_CONTAINER_ERROR_KEY_IS_NULL if key is
+ * <i>NULL</i>.
+ * @throws CORAL_CONCURRENT_SKIP_LIST_CONTAINER_ERROR_OUT_IS_NULL if out is
+ * <i>NULL</i>.
+ * @throws CORAL_CONCURRENT_SKIP_LIST_CONTAINER_ERROR_ENTRY_NOT_FOUND if next
+ * lower entry was not found.
+ */
+int coral_concurrent_skip_list_container_lower(
+        const struct coral_concurrent_skip_list_container *object,
+        const void *key,
+        struct coral_concurrent_skip_list_container_entry **out);
+
+/**
+ * @brief Receive first entry.
+ * @param [in] object container instance.
+ * @param [out] out receive first entry.
+ * @return On success <i>0</i>, otherwise an error code.
+ * @throws CORAL_CONCURRENT_SKIP_LIST_CONTAINER_ERROR_OBJECT_IS_NULL if object
+ * is <i>NULL</i>.
+ * @throws CORAL_CONCURRENT_SKIP_LIST_CONTAINER_ERROR_OUT_IS_NULL if out is
+ * <i>NULL</i>.
+ * @throws CORAL_CONCURRENT_SKIP_LIST_CONTAINER_ERROR_CONTAINER_IS_EMPTY if
+ * container is empty.
+ */
+int coral_concurrent_skip_list_container_first(
+        const struct coral_concurrent_skip_list_container *object,
+        struct coral_concurrent_skip_list_container_entry **out);
+
+/**
+ * @brief Receive last entry.
+ * @param [in] object container instance.
+ * @param [out] out receive last entry.
+ * @return On success <i>0</i>, otherwise an error code.
+ * @throws CORAL_CONCURRENT_SKIP_LIST_CONTAINER_ERROR_OBJECT_IS_NULL if object
+ * is <i>NULL</i>.
+ * @throws CORAL_CONCURRENT_SKIP_LIST_CONTAINER_ERROR_OUT_IS_NULL if out is
+ * <i>NULL</i>.
+ * @throws CORAL_CONCURRENT_SKIP_LIST_CONTAINER_ERROR_CONTAINER_IS_EMPTY if
+ * container is empty.
+ */
+int coral_concurrent_skip_list_container_last(
+        const struct coral_concurrent_skip_list_container *object,
+        struct coral_concurrent_skip_list_container_entry **out);
+
+/**
+ * @brief Retrieve the next entry.
+ * <p>The entry may have been removed by another thread meanwhile, in which case
+ * the entry that followed it at the time is looked at instead.</p>
+ * @param [in] object container instance.
+ * @param [in] entry current one.
+ * @param [out] out receive the next entry.
+ * @return On success <i>0</i>, otherwise an error code.
+ * @throws CORAL_CONCURRENT_SKIP_LIST_CONTAINER_ERROR_OBJECT_IS_NULL if object
+ * is <i>NULL</i>.
+ * @throws CORAL_CONCURRENT_SKIP_LIST_CONTAINER_ERROR_ENTRY_IS_NULL if entry is
+ * <i>NULL</i>.
+ * @throws CORAL_CONCURRENT_SKIP_LIST_CONTAINER_ERROR_OUT_IS_NULL if out is
+ * <i>NULL</i>.
+ * @throws CORAL_CONCURRENT_SKIP_LIST_CONTAINER_ERROR_END_OF_SEQUENCE if there
+ * are no next entries.
+ */
+int coral_concurrent_skip_list_container_next(
+        const struct coral_concurrent_skip_list_container *object,
+        const struct coral_concurrent_skip_list_container_entry *entry,
+        struct coral_concurrent_skip_list_container_entry **out);
+
+/**
+ * @brief Retrieve the previous entry.
+ * <p>Entries only link to the entries after them so this looks the entry up
+ * again from the front of the container.</p>
+ * @param [in] object container instance.
+ * @param [in] entry current one.
+ * @param [out] out receive the previous entry.
+ * @return On success <i>0</i>, otherwise an error code.
+ * @throws CORAL_CONCURRENT_SKIP_LIST_CONTAINER_ERROR_OBJECT_IS_NULL if object
+ * is <i>NULL</i>.
+ * @throws CORAL_CONCURRENT_SKIP_LIST_CONTAINER_ERROR_ENTRY_IS_NULL if entry is
+ * <i>NULL</i>.
+ * @throws CORAL_CONCURRENT_SKIP_LIST_CONTAINER_ERROR_OUT_IS_NULL if out is
+ * <i>NULL</i>.
+ * @throws CORAL_CONCURRENT_SKIP_LIST_CONTAINER_ERROR_END_OF_SEQUENCE if there
+ * are no previous entries.
+ */
+int coral_concurrent_skip_list_container_prev(
+        const struct coral_concurrent_skip_list_container *object,
+        const struct coral_concurrent_skip_list_container_entry *entry,
+        struct coral_concurrent_skip_list_container_entry **out);
+
+#endif /* _CORAL_CONCURRENT_SKIP_LIST_CONTAINER_H_ */
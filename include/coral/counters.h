@@ -0,0 +1,63 @@
+#ifndef _CORAL_COUNTERS_H_
+#define _CORAL_COUNTERS_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+#include <sea-urchin.h>
+
+#define CORAL_COUNTERS_ERROR_OUT_IS_NULL \
+    SEA_URCHIN_ERROR_OUT_IS_NULL
+
+/**
+ * @brief Operation counters of a container.
+ * <p>Counters are only maintained if the library was built with the
+ * <i>CORAL_COUNTERS</i> option, otherwise they always read as zero.</p>
+ */
+struct coral_counters {
+    uintmax_t compare;      /* comparator invocations */
+    uintmax_t visit;        /* nodes visited while searching */
+    uintmax_t insert;       /* nodes inserted into the tree */
+    uintmax_t remove;       /* nodes removed from the tree */
+    uintmax_t rotate;       /* rotations rebalancing the tree */
+};
+
+/**
+ * @brief Operation counters as kept within a container.
+ * <p>Lookups bump them with relaxed atomic loads and stores rather than
+ * read-modify-writes, so lookups sharing a container between threads do
+ * not race but may miss each other's counts.</p>
+ */
+struct coral_atomic_counters {
+    atomic_uintmax_t compare;
+    atomic_uintmax_t visit;
+    atomic_uintmax_t insert;
+    atomic_uintmax_t remove;
+    atomic_uintmax_t rotate;
+};
+
+/**
+ * @brief Allocation counters shared by all the containers.
+ * <p>Counters are only maintained if the library was built with the
+ * <i>CORAL_COUNTERS</i> option, otherwise they always read as zero.</p>
+ */
+struct coral_allocation_counters {
+    uintmax_t alloc;        /* entries and items allocated */
+    uintmax_t free;         /* entries and items freed */
+};
+
+/**
+ * @brief Retrieve a snapshot of the allocation counters.
+ * @param [out] out receive the allocation counters.
+ * @return On success <i>0</i>, otherwise an error code.
+ * @throws CORAL_COUNTERS_ERROR_OUT_IS_NULL if out is <i>NULL</i>.
+ */
+int coral_allocation_counters(struct coral_allocation_counters *out);
+
+/**
+ * @brief Reset the allocation counters to zero.
+ */
+void coral_allocation_counters_reset(void);
+
+#endif /* _CORAL_COUNTERS_H_ */
@@ -0,0 +1,110 @@
+#ifndef _CORAL_ENTRY_POOL_H_
+#define _CORAL_ENTRY_POOL_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <sea-urchin.h>
+#include <coral/allocator.h>
+
+#define CORAL_ENTRY_POOL_ERROR_OBJECT_IS_NULL \
+    SEA_URCHIN_ERROR_OBJECT_IS_NULL
+#define CORAL_ENTRY_POOL_ERROR_OUT_IS_NULL \
+    SEA_URCHIN_ERROR_OUT_IS_NULL
+#define CORAL_ENTRY_POOL_ERROR_COUNT_IS_ZERO \
+    SEA_URCHIN_ERROR_VALUE_IS_ZERO
+#define CORAL_ENTRY_POOL_ERROR_SIZE_IS_TOO_LARGE \
+    SEA_URCHIN_ERROR_VALUE_IS_TOO_LARGE
+#define CORAL_ENTRY_POOL_ERROR_BLOCK_IS_NULL \
+    SEA_URCHIN_ERROR_ITEM_IS_NULL
+#define CORAL_ENTRY_POOL_ERROR_MEMORY_ALLOCATION_FAILED \
+    SEA_URCHIN_ERROR_MEMORY_ALLOCATION_FAILED
+#define CORAL_ENTRY_POOL_ERROR_ALIGNMENT_IS_INVALID \
+    SEA_URCHIN_ERROR_VALUE_IS_INVALID
+
+/**
+ * @brief Pool of fixed-size blocks carved out of large slabs.
+ * <p>The block size is fixed by the first allocation so that the pool can
+ * be handed to the <i>_alloc_with</i> function of any container without
+ * knowing the size of its hidden entry header. Freed blocks are kept on an
+ * intrusive free list and only returned to the system when the pool is
+ * invalidated.</p>
+ * <p>A pool is not thread-safe and must not be moved once initialized.</p>
+ */
+struct coral_entry_pool {
+    struct coral_allocator allocator;
+    size_t count;
+    size_t size;
+    size_t alignment;
+    void *slabs;
+    void *blocks;
+    unsigned char *cursor;
+    unsigned char *end;
+};
+
+/**
+ * @brief Initialize entry pool.
+ * @param [in] object instance to be initialized.
+ * @param [in] count of blocks in each slab.
+ * @return On success <i>0</i>, otherwise an error code.
+ * @throws CORAL_ENTRY_POOL_ERROR_OBJECT_IS_NULL if object is <i>NULL</i>.
+ * @throws CORAL_ENTRY_POOL_ERROR_COUNT_IS_ZERO if count is zero.
+ */
+int coral_entry_pool_init(struct coral_entry_pool *object, size_t count);
+
+/**
+ * @brief Invalidate entry pool.
+ * <p>All the slabs are released, hence every block allocated from the pool
+ * becomes invalid whether or not it was freed. The actual <u>pool instance
+ * is not deallocated</u> since it may have been embedded in a larger
+ * structure.</p>
+ * @param [in] object instance to be invalidated.
+ * @return On success <i>0</i>, otherwise an error code.
+ * @throws CORAL_ENTRY_POOL_ERROR_OBJECT_IS_NULL if object is <i>NULL</i>.
+ */
+int coral_entry_pool_invalidate(struct coral_entry_pool *object);
+
+/**
+ * @brief Retrieve the allocator of the entry pool.
+ * @param [in] object entry pool instance.
+ * @param [out] out receive the allocator which is only valid for as long as
+ * the entry pool is.
+ * @return On success <i>0</i>, otherwise an error code.
+ * @throws CORAL_ENTRY_POOL_ERROR_OBJECT_IS_NULL if object is <i>NULL</i>.
+ * @throws CORAL_ENTRY_POOL_ERROR_OUT_IS_NULL if out is <i>NULL</i>.
+ */
+int coral_entry_pool_allocator(const struct coral_entry_pool *object,
+                               const struct coral_allocator **out);
+
+/**
+ * @brief Allocate a block from the entry pool.
+ * @param [in] object entry pool instance.
+ * @param [in] alignment of the block which must be a power of two.
+ * @param [in] size in bytes of the block.
+ * @param [out] out receive the allocated block.
+ * @return On success <i>0</i>, otherwise an error code.
+ * @throws CORAL_ENTRY_POOL_ERROR_OBJECT_IS_NULL if object is <i>NULL</i>.
+ * @throws CORAL_ENTRY_POOL_ERROR_OUT_IS_NULL if out is <i>NULL</i>.
+ * @throws CORAL_ENTRY_POOL_ERROR_ALIGNMENT_IS_INVALID if the first allocation
+ * asks for an alignment which is not a power of two.
+ * @throws CORAL_ENTRY_POOL_ERROR_SIZE_IS_TOO_LARGE if size or alignment is
+ * larger than those fixed by the first allocation.
+ * @throws CORAL_ENTRY_POOL_ERROR_MEMORY_ALLOCATION_FAILED if there is not
+ * enough memory to allocate a slab.
+ */
+int coral_entry_pool_alloc(struct coral_entry_pool *object,
+                           size_t alignment,
+                           size_t size,
+                           void **out);
+
+/**
+ * @brief Return a block to the entry pool.
+ * @param [in] object entry pool instance.
+ * @param [in] block to be returned.
+ * @return On success <i>0</i>, otherwise an error code.
+ * @throws CORAL_ENTRY_POOL_ERROR_OBJECT_IS_NULL if object is <i>NULL</i>.
+ * @throws CORAL_ENTRY_POOL_ERROR_BLOCK_IS_NULL if block is <i>NULL</i>.
+ */
+int coral_entry_pool_free(struct coral_entry_pool *object, void *block);
+
+#endif /* _CORAL_ENTRY_POOL_H_ */
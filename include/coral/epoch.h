@@ -0,0 +1,192 @@
+#ifndef _CORAL_EPOCH_H_
+#define _CORAL_EPOCH_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+#include <pthread.h>
+#include <sea-urchin.h>
+
+#define CORAL_EPOCH_ERROR_OBJECT_IS_NULL \
+    SEA_URCHIN_ERROR_OBJECT_IS_NULL
+#define CORAL_EPOCH_ERROR_THREAD_IS_NULL \
+    SEA_URCHIN_ERROR_VALUE_IS_NULL
+#define CORAL_EPOCH_ERROR_ITEM_IS_NULL \
+    SEA_URCHIN_ERROR_ITEM_IS_NULL
+#define CORAL_EPOCH_ERROR_FUNCTION_IS_NULL \
+    SEA_URCHIN_ERROR_VALUE_IS_NULL
+#define CORAL_EPOCH_ERROR_MEMORY_ALLOCATION_FAILED \
+    SEA_URCHIN_ERROR_MEMORY_ALLOCATION_FAILED
+#define CORAL_EPOCH_ERROR_THREADS_ARE_REGISTERED \
+    SEA_URCHIN_ERROR_VALUE_IS_INVALID
+#define CORAL_EPOCH_ERROR_THREAD_IS_ACTIVE \
+    SEA_URCHIN_ERROR_VALUE_IS_INVALID
+#define CORAL_EPOCH_ERROR_THREAD_IS_NOT_ACTIVE \
+    SEA_URCHIN_ERROR_VALUE_IS_INVALID
+#define CORAL_EPOCH_ERROR_CALLER_IS_NOT_DEFERRED \
+    SEA_URCHIN_ERROR_VALUE_IS_INVALID
+
+struct coral_epoch_bag;
+
+/**
+ * @brief Thread taking part in an epoch.
+ * <p>Each thread registers an instance of its own, which starts on a cache
+ * line of its own so that threads entering and exiting critical sections
+ * never write to the same cache line.</p>
+ * <p>A thread is not thread-safe, only the thread that registered it may use
+ * it.</p>
+ */
+struct coral_epoch_thread {
+    _Alignas(64) atomic_uintmax_t state;
+    size_t depth;
+    struct coral_epoch *epoch;
+    struct coral_epoch_thread *next;
+    struct coral_epoch_bag *bag;
+    struct coral_epoch_bag *sealed;
+    struct coral_epoch_bag *spare;
+};
+
+/**
+ * @brief Epoch based reclamation of memory shared between threads.
+ * <p>Threads look at shared entries from within critical sections. An entry
+ * that was removed from a concurrent container is deferred rather than freed
+ * and its function only runs once every thread that was in a critical section
+ * when it got deferred has left it, at which point no thread can still be
+ * looking at it.</p>
+ * <p>The epoch moves on once every thread in a critical section has seen the
+ * current epoch, deferred entries are freed once the epoch has moved on twice
+ * since they were deferred.</p>
+ */
+struct coral_epoch {
+    _Alignas(64) atomic_uintmax_t global;
+    _Alignas(64) pthread_mutex_t mutex;
+    struct coral_epoch_thread *threads;
+    struct coral_epoch_bag *orphans;
+};
+
+/**
+ * @brief Initialize epoch.
+ * @param [in] object instance to be initialized.
+ * @return On success <i>0</i>, otherwise an error code.
+ * @throws CORAL_EPOCH_ERROR_OBJECT_IS_NULL if object is <i>NULL</i>.
+ * @throws CORAL_EPOCH_ERROR_MEMORY_ALLOCATION_FAILED if there is not enough
+ * memory for the mutex.
+ */
+int coral_epoch_init(struct coral_epoch *object);
+
+/**
+ * @brief Invalidate epoch.
+ * <p>Every function still deferred is run. The actual <u>epoch instance is
+ * not deallocated</u> since it may have been embedded in a larger
+ * structure.</p>
+ * @param [in] object instance to be invalidated.
+ * @return On success <i>0</i>, otherwise an error code.
+ * @throws CORAL_EPOCH_ERROR_OBJECT_IS_NULL if object is <i>NULL</i>.
+ * @throws CORAL_EPOCH_ERROR_THREADS_ARE_REGISTERED if threads have yet to be
+ * unregistered.
+ */
+int coral_epoch_invalidate(struct coral_epoch *object);
+
+/**
+ * @brief Register thread.
+ * <p>The thread instance must stay where it is until it is
+ * unregistered.</p>
+ * @param [in] object epoch instance.
+ * @param [in] thread instance to be registered.
+ * @return On success <i>0</i>, otherwise an error code.
+ * @throws CORAL_EPOCH_ERROR_OBJECT_IS_NULL if object is <i>NULL</i>.
+ * @throws CORAL_EPOCH_ERROR_THREAD_IS_NULL if thread is <i>NULL</i>.
+ * @throws CORAL_EPOCH_ERROR_MEMORY_ALLOCATION_FAILED if there is not enough
+ * memory to defer functions.
+ */
+int coral_epoch_register(struct coral_epoch *object,
+                         struct coral_epoch_thread *thread);
+
+/**
+ * @brief Unregister thread.
+ * <p>Functions the thread deferred that cannot run yet are handed over to
+ * the epoch, which runs them once it is safe to do so.</p>
+ * @param [in] thread instance to be unregistered.
+ * @return On success <i>0</i>, otherwise an error code.
+ * @throws CORAL_EPOCH_ERROR_THREAD_IS_NULL if thread is <i>NULL</i>.
+ * @throws CORAL_EPOCH_ERROR_THREAD_IS_ACTIVE if thread is in a critical
+ * section.
+ */
+int coral_epoch_unregister(struct coral_epoch_thread *thread);
+
+/**
+ * @brief Enter critical section.
+ * <p>Entries reached from within the critical section stay valid until it
+ * is exited. Critical sections may be nested, only exiting the outermost
+ * one lets the epoch move on.</p>
+ * @param [in] thread instance entering the critical section.
+ * @return On success <i>0</i>, otherwise an error code.
+ * @throws CORAL_EPOCH_ERROR_THREAD_IS_NULL if thread is <i>NULL</i>.
+ */
+int coral_epoch_enter(struct coral_epoch_thread *thread);
+
+/**
+ * @brief Exit critical section.
+ * @param [in] thread instance exiting the critical section.
+ * @return On success <i>0</i>, otherwise an error code.
+ * @throws CORAL_EPOCH_ERROR_THREAD_IS_NULL if thread is <i>NULL</i>.
+ * @throws CORAL_EPOCH_ERROR_THREAD_IS_NOT_ACTIVE if thread is not in a
+ * critical section.
+ */
+int coral_epoch_exit(struct coral_epoch_thread *thread);
+
+/**
+ * @brief Defer function until no thread can still be looking at item.
+ * <p>Item must already be unreachable by threads entering a critical section
+ * from now on, such as an entry removed from a concurrent container.
+ * Deferred functions are gathered into bags and every time a bag fills up the
+ * epoch is tried to be moved on and the functions that are safe to run are
+ * run.</p>
+ * <p>Function must not call back into the epoch but to defer again.</p>
+ * @param [in] thread instance deferring function.
+ * @param [in] item to be passed on to function.
+ * @param [in] function to run with item, such as one that frees it.
+ * @return On success <i>0</i>, otherwise an error code.
+ * @throws CORAL_EPOCH_ERROR_THREAD_IS_NULL if thread is <i>NULL</i>.
+ * @throws CORAL_EPOCH_ERROR_ITEM_IS_NULL if item is <i>NULL</i>.
+ * @throws CORAL_EPOCH_ERROR_FUNCTION_IS_NULL if function is <i>NULL</i>.
+ * @throws CORAL_EPOCH_ERROR_MEMORY_ALLOCATION_FAILED if there is not enough
+ * memory for another bag, function was not deferred.
+ */
+int coral_epoch_defer(struct coral_epoch_thread *thread,
+                      void *item,
+                      void (*function)(void *item));
+
+/**
+ * @brief Defer function again from within a deferred function.
+ * <p>For items that were not yet unreachable when their function ran, such
+ * as an entry another thread is still linking, function is deferred on the
+ * thread running the deferred functions. While the epoch is being
+ * invalidated no thread is left to be looking at item and function is run
+ * right away.</p>
+ * @param [in] item to be passed on to function.
+ * @param [in] function to run with item.
+ * @return On success <i>0</i>, otherwise an error code.
+ * @throws CORAL_EPOCH_ERROR_ITEM_IS_NULL if item is <i>NULL</i>.
+ * @throws CORAL_EPOCH_ERROR_FUNCTION_IS_NULL if function is <i>NULL</i>.
+ * @throws CORAL_EPOCH_ERROR_CALLER_IS_NOT_DEFERRED if not called from within
+ * a deferred function.
+ * @throws CORAL_EPOCH_ERROR_MEMORY_ALLOCATION_FAILED if there is not enough
+ * memory for another bag, function was not deferred.
+ */
+int coral_epoch_defer_again(void *item, void (*function)(void *item));
+
+/**
+ * @brief Try to move the epoch on and run deferred functions.
+ * <p>Functions deferred by thread, and those left behind by unregistered
+ * threads, are run once the epoch has moved on twice since they were
+ * deferred. The epoch does not move on while a thread is in a critical
+ * section it entered before the epoch last moved on.</p>
+ * @param [in] thread instance running deferred functions.
+ * @return On success <i>0</i>, otherwise an error code.
+ * @throws CORAL_EPOCH_ERROR_THREAD_IS_NULL if thread is <i>NULL</i>.
+ */
+int coral_epoch_collect(struct coral_epoch_thread *thread);
+
+#endif /* _CORAL_EPOCH_H_ */
@@ -0,0 +1,255 @@
+#ifndef _CORAL_HASH_CONTAINER_H_
+#define _CORAL_HASH_CONTAINER_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <sea-urchin.h>
+#include <rock.h>
+#include <coral/allocator.h>
+#include <coral/counters.h>
+#include <coral/red_black_tree_container.h>
+#include <coral/hash_table.h>
+
+/* errors are shared with the red black tree container so that either can be
+ * swapped for the other */
+#define CORAL_HASH_CONTAINER_ERROR_SIZE_IS_ZERO \
+    CORAL_RED_BLACK_TREE_CONTAINER_ERROR_SIZE_IS_ZERO
+#define CORAL_HASH_CONTAINER_ERROR_SIZE_IS_TOO_LARGE \
+    CORAL_RED_BLACK_TREE_CONTAINER_ERROR_SIZE_IS_TOO_LARGE
+#define CORAL_HASH_CONTAINER_ERROR_OUT_IS_NULL \
+    CORAL_RED_BLACK_TREE_CONTAINER_ERROR_OUT_IS_NULL
+#define CORAL_HASH_CONTAINER_ERROR_MEMORY_ALLOCATION_FAILED \
+    CORAL_RED_BLACK_TREE_CONTAINER_ERROR_MEMORY_ALLOCATION_FAILED
+#define CORAL_HASH_CONTAINER_ERROR_ENTRY_IS_NULL \
+    CORAL_RED_BLACK_TREE_CONTAINER_ERROR_ENTRY_IS_NULL
+#define CORAL_HASH_CONTAINER_ERROR_OBJECT_IS_NULL \
+    CORAL_RED_BLACK_TREE_CONTAINER_ERROR_OBJECT_IS_NULL
+#define CORAL_HASH_CONTAINER_ERROR_COMPARE_IS_NULL \
+    CORAL_RED_BLACK_TREE_CONTAINER_ERROR_COMPARE_IS_NULL
+#define CORAL_HASH_CONTAINER_ERROR_ENTRY_ALREADY_EXISTS \
+    CORAL_RED_BLACK_TREE_CONTAINER_ERROR_ENTRY_ALREADY_EXISTS
+#define CORAL_HASH_CONTAINER_ERROR_KEY_IS_NULL \
+    CORAL_RED_BLACK_TREE_CONTAINER_ERROR_KEY_IS_NULL
+#define CORAL_HASH_CONTAINER_ERROR_ENTRY_NOT_FOUND \
+    CORAL_RED_BLACK_TREE_CONTAINER_ERROR_ENTRY_NOT_FOUND
+#define CORAL_HASH_CONTAINER_ERROR_CONTAINER_IS_EMPTY \
+    CORAL_RED_BLACK_TREE_CONTAINER_ERROR_CONTAINER_IS_EMPTY
+#define CORAL_HASH_CONTAINER_ERROR_END_OF_SEQUENCE \
+    CORAL_RED_BLACK_TREE_CONTAINER_ERROR_END_OF_SEQUENCE
+#define CORAL_HASH_CONTAINER_ERROR_HASH_IS_NULL \
+    SEA_URCHIN_ERROR_VALUE_IS_NULL
+
+struct coral_hash_container_entry;
+
+/**
+ * @brief Unordered container of entries kept in an open addressing hash
+ * table.
+ * <p>Lookups hash the key, match a group of sixteen control bytes at once and
+ * only compare the entries whose control byte matched, so that a lookup
+ * usually costs one or two cache misses whatever the count of entries.</p>
+ */
+struct coral_hash_container {
+    struct coral_hash_table table;
+
+    size_t (*hash)(const void *);
+    int (*compare)(const void *, const void *);
+};
+
+/**
+ * @brief Allocate memory for an entry.
+ * <p>Memory is obtained from the default allocator.</p>
+ * @param [in] size in bytes of entry to create.
+ * @param [out] out receive allocated entry.
+ * @return On success <i>0</i>, otherwise an error code.
+ * @throws CORAL_HASH_CONTAINER_ERROR_OUT_IS_NULL if out is <i>NULL</i>.
+ * @throws CORAL_HASH_CONTAINER_ERROR_SIZE_IS_ZERO if size if zero.
+ * @throws CORAL_HASH_CONTAINER_ERROR_SIZE_IS_TOO_LARGE if size is too large.
+ * @throws CORAL_HASH_CONTAINER_ERROR_MEMORY_ALLOCATION_FAILED if there is not
+ * enough memory to allocate an entry.
+ */
+int coral_hash_container_alloc(
+        size_t size,
+        struct coral_hash_container_entry **out);
+
+/**
+ * @brief Allocate memory for an entry from the given allocator.
+ * @param [in] allocator to allocate from or <i>NULL</i> for the default
+ * allocator.
+ * @param [in] size in bytes of entry to create.
+ * @param [out] out receive allocated entry.
+ * @return On success <i>0</i>, otherwise an error code.
+ * @throws CORAL_HASH_CONTAINER_ERROR_OUT_IS_NULL if out is <i>NULL</i>.
+ * @throws CORAL_HASH_CONTAINER_ERROR_SIZE_IS_ZERO if size if zero.
+ * @throws CORAL_HASH_CONTAINER_ERROR_SIZE_IS_TOO_LARGE if size is too large.
+ * @throws CORAL_HASH_CONTAINER_ERROR_MEMORY_ALLOCATION_FAILED if there is not
+ * enough memory to allocate an entry.
+ */
+int coral_hash_container_alloc_with(
+        const struct coral_allocator *allocator,
+        size_t size,
+        struct coral_hash_container_entry **out);
+
+/**
+ * @brief Free memory of an entry.
+ * <p>Memory is returned to the allocator the entry was allocated from.</p>
+ * @param [in] entry to be freed.
+ * @return On success <i>0</i>, otherwise an error code.
+ * @throws CORAL_HASH_CONTAINER_ERROR_ENTRY_IS_NULL if entry is <i>NULL</i>.
+ */
+int coral_hash_container_free(
+        struct coral_hash_container_entry *entry);
+
+/**
+ * @brief Initialize hash container.
+ * @param [in] object instance to be initialized.
+ * @param [in] hash function which must return the same hash for entries that
+ * are considered to be equal.
+ * @param [in] compare comparison which must return zero if the <u>first
+ * key</u> is considered to be equal to the <u>second key</u> and any other
+ * value otherwise. An ordering comparison will do.
+ * @return On success <i>0</i>, otherwise an error code.
+ * @throws CORAL_HASH_CONTAINER_ERROR_OBJECT_IS_NULL if object is <i>NULL</i>.
+ * @throws CORAL_HASH_CONTAINER_ERROR_HASH_IS_NULL if hash is <i>NULL</i>.
+ * @throws CORAL_HASH_CONTAINER_ERROR_COMPARE_IS_NULL if compare is
+ * <i>NULL</i>.
+ */
+int coral_hash_container_init(
+        struct coral_hash_container *object,
+        size_t (*hash)(const void *entry),
+        int (*compare)(const void *first,
+                       const void *second));
+
+/**
+ * @brief Invalidate hash container.
+ * <p>The entries in the container are destroyed and each entry will have the
+ * provided <i>on destroy</i> callback invoked upon itself. The actual
+ * <u>container instance is not deallocated</u> since it may have been embedded
+ * in a larger structure.</p>
+ * @param [in] object instance to be invalidated.
+ * @param [in] on_destroy called just before the entry is to be destroyed.
+ * @return On success <i>0</i>, otherwise an error code.
+ * @throws CORAL_HASH_CONTAINER_ERROR_OBJECT_IS_NULL if object is <i>NULL</i>.
+ */
+int coral_hash_container_invalidate(
+        struct coral_hash_container *object,
+        void (*on_destroy)(struct coral_hash_container_entry *entry));
+
+/**
+ * @brief Retrieve the count of entries.
+ * @param [in] object instance whose count we are to retrieve.
+ * @param [out] out receive the entry count.
+ * @return On success <i>0</i>, otherwise an error code.
+ * @throws CORAL_HASH_CONTAINER_ERROR_OBJECT_IS_NULL if object is <i>NULL</i>.
+ * @throws CORAL_HASH_CONTAINER_ERROR_OUT_IS_NULL if out is <i>NULL</i>.
+ */
+int coral_hash_container_count(
+        const struct coral_hash_container *object,
+        uintmax_t *out);
+
+/**
+ * @brief Add entry.
+ * @param [in] object container instance.
+ * @param [in] entry to add.
+ * @return On success <i>0</i>, otherwise an error code.
+ * @throws CORAL_HASH_CONTAINER_ERROR_OBJECT_IS_NULL if object is <i>NULL</i>.
+ * @throws CORAL_HASH_CONTAINER_ERROR_ENTRY_IS_NULL if entry is <i>NULL</i>.
+ * @throws CORAL_HASH_CONTAINER_ERROR_ENTRY_ALREADY_EXITS if entry is already
+ * present in container.
+ */
+int coral_hash_container_add(
+        struct coral_hash_container *object,
+        const struct coral_hash_container_entry *entry);
+
+/**
+ * @brief Remove entry.
+ * @param [in] object container instance.
+ * @param [in] entry to remove.
+ * @return On success <i>0</i>, otherwise an error code.
+ * @throws CORAL_HASH_CONTAINER_ERROR_OBJECT_IS_NULL if object is <i>NULL</i>.
+ * @throws CORAL_HASH_CONTAINER_ERROR_ENTRY_IS_NULL if entry is <i>NULL</i>.
+ * @throws CORAL_HASH_CONTAINER_ERROR_ENTRY_NOT_FOUND if entry is not present
+ * in a container.
+ */
+int coral_hash_container_remove(
+        struct coral_hash_container *object,
+        const struct coral_hash_container_entry *entry);
+
+/**
+ * @brief Retrieve entry for key.
+ * <p>The key is passed to both the hash and the comparison so it must be
+ * shaped like an entry.</p>
+ * @param [in] object container instance.
+ * @param [in] key on which to find entry.
+ * @param [out] out receive matching entry.
+ * @return On success <i>0</i>, otherwise an error code.
+ * @throws CORAL_HASH_CONTAINER_ERROR_OBJECT_IS_NULL if object is <i>NULL</i>.
+ * @throws CORAL_HASH_CONTAINER_ERROR_KEY_IS_NULL if key is <i>NULL</i>.
+ * @throws CORAL_HASH_CONTAINER_ERROR_OUT_IS_NULL if out is <i>NULL</i>.
+ * @throws CORAL_HASH_CONTAINER_ERROR_ENTRY_NOT_FOUND if matching entry was not
+ * found.
+ */
+int coral_hash_container_get(
+        const struct coral_hash_container *object,
+        const void *key,
+        struct coral_hash_container_entry **out);
+
+/**
+ * @brief Retrieve the first entry.
+ * <p>Entries are visited in no particular order which changes as entries are
+ * added.</p>
+ * @param [in] object container instance.
+ * @param [out] out receive the first entry.
+ * @return On success <i>0</i>, otherwise an error code.
+ * @throws CORAL_HASH_CONTAINER_ERROR_OBJECT_IS_NULL if object is <i>NULL</i>.
+ * @throws CORAL_HASH_CONTAINER_ERROR_OUT_IS_NULL if out is <i>NULL</i>.
+ * @throws CORAL_HASH_CONTAINER_ERROR_CONTAINER_IS_EMPTY if container is
+ * empty.
+ */
+int coral_hash_container_first(
+        const struct coral_hash_container *object,
+        struct coral_hash_container_entry **out);
+
+/**
+ * @brief Retrieve the next entry.
+ * <p>Removing the current entry ends the iteration while adding an entry may
+ * reorder the entries.</p>
+ * @param [in] object container instance.
+ * @param [in] entry current one.
+ * @param [out] out receive the next entry.
+ * @return On success <i>0</i>, otherwise an error code.
+ * @throws CORAL_HASH_CONTAINER_ERROR_OBJECT_IS_NULL if object is <i>NULL</i>.
+ * @throws CORAL_HASH_CONTAINER_ERROR_ENTRY_IS_NULL if entry is <i>NULL</i>.
+ * @throws CORAL_HASH_CONTAINER_ERROR_OUT_IS_NULL if out is <i>NULL</i>.
+ * @throws CORAL_HASH_CONTAINER_ERROR_END_OF_SEQUENCE if there are no next
+ * entries.
+ */
+int coral_hash_container_next(
+        const struct coral_hash_container *object,
+        const struct coral_hash_container_entry *entry,
+        struct coral_hash_container_entry **out);
+
+/**
+ * @brief Retrieve a snapshot of the operation counters.
+ * <p>Counters are only maintained if the library was built with the
+ * <i>CORAL_COUNTERS</i> option, otherwise they always read as zero.</p>
+ * @param [in] object container instance.
+ * @param [out] out receive the operation counters.
+ * @return On success <i>0</i>, otherwise an error code.
+ * @throws CORAL_HASH_CONTAINER_ERROR_OBJECT_IS_NULL if object is <i>NULL</i>.
+ * @throws CORAL_HASH_CONTAINER_ERROR_OUT_IS_NULL if out is <i>NULL</i>.
+ */
+int coral_hash_container_counters(
+        const struct coral_hash_container *object,
+        struct coral_counters *out);
+
+/**
+ * @brief Reset the operation counters to zero.
+ * @param [in] object container instance.
+ * @return On success <i>0</i>, otherwise an error code.
+ * @throws CORAL_HASH_CONTAINER_ERROR_OBJECT_IS_NULL if object is <i>NULL</i>.
+ */
+int coral_hash_container_counters_reset(
+        struct coral_hash_container *object);
+
+#endif /* _CORAL_HASH_CONTAINER_H_ */
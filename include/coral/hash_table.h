@@ -0,0 +1,37 @@
+#ifndef _CORAL_HASH_TABLE_H_
+#define _CORAL_HASH_TABLE_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <coral/counters.h>
+
+/**
+ * @brief Open addressing table of items on which the hash containers are
+ * built.
+ * <p>Slots are grouped by sixteen and each slot has a control byte which is
+ * either empty, deleted or seven bits of the hash of its item. A lookup
+ * matches a whole group of control bytes at once and only compares the
+ * items whose control byte matched.</p>
+ * <p>When the table has to grow its items are not all moved at once, the old
+ * slots are kept aside and a group of them is moved by every add or remove
+ * until none are left. Lookups search both in the meantime.</p>
+ * <p>Its fields are private to the library.</p>
+ */
+struct coral_hash_table {
+    uintmax_t count;
+    size_t capacity;
+    size_t deleted;
+    unsigned char *control;
+    void **slots;
+    size_t old_capacity;
+    size_t old_count;
+    size_t migrated;
+    unsigned char *old_control;
+    void **old_slots;
+#ifdef CORAL_COUNTERS
+    struct coral_atomic_counters counters;
+#endif
+};
+
+#endif /* _CORAL_HASH_TABLE_H_ */
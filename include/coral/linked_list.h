@@ -6,6 +6,8 @@
 #include <stdbool.h>
 #include <sea-urchin.h>
 #include <rock.h>
+#include <coral/allocator.h>
+#include <coral/arena.h>
 
 #define CORAL_LINKED_LIST_ERROR_SIZE_IS_ZERO \
     SEA_URCHIN_ERROR_VALUE_IS_ZERO
@@ -25,16 +27,37 @@
     SEA_URCHIN_ERROR_END_OF_SEQUENCE
 #define CORAL_LINKED_LIST_ERROR_VALUE_IS_NULL \
     SEA_URCHIN_ERROR_VALUE_IS_NULL
+#define CORAL_LINKED_LIST_ERROR_NODE_IS_NULL \
+    SEA_URCHIN_ERROR_ITEM_IS_NULL
+#define CORAL_LINKED_LIST_ERROR_ITEM_IS_FROM_OTHER_LIST \
+    SEA_URCHIN_ERROR_VALUE_IS_INVALID
 
 struct coral_linked_list_item;
 
+/**
+ * @brief Node to embed in a structure so that it can be added to a linked
+ * list without allocating an item.
+ * <p>Use <i>rock_container_of</i> to get from the node to the structure
+ * embedding it.</p>
+ */
+struct coral_linked_list_node {
+    struct rock_linked_list_node node;
+    const struct coral_allocator *allocator; /* NULL for intrusive nodes */
+};
+
+#define CORAL_LINKED_LIST_ARENA_SIZE        (64 * 1024)
+
 struct coral_linked_list {
     uintmax_t count;
     struct rock_linked_list_node *list;
+    struct coral_arena arena;
+    struct coral_allocator allocator;   /* of the items from the arena */
+    uintmax_t foreign;      /* items not allocated from the arena */
 };
 
 /**
  * @brief Allocate memory for an item.
+ * <p>Memory is obtained from the default allocator.</p>
  * @param [in] size in bytes of item to create.
  * @param [out] out receive allocated item.
  * @return On success <i>0</i>, otherwise an error code.
@@ -47,8 +70,47 @@ struct coral_linked_list {
 int coral_linked_list_alloc(size_t size,
                             struct coral_linked_list_item **out);
 
+/**
+ * @brief Allocate memory for an item from the given allocator.
+ * @param [in] allocator to allocate from or <i>NULL</i> for the default
+ * allocator.
+ * @param [in] size in bytes of item to create.
+ * @param [out] out receive allocated item.
+ * @return On success <i>0</i>, otherwise an error code.
+ * @throws CORAL_LINKED_LIST_ERROR_OUT_IS_NULL if out is <i>NULL</i>.
+ * @throws CORAL_LINKED_LIST_ERROR_SIZE_IS_ZERO if size is zero.
+ * @throws CORAL_LINKED_LIST_ERROR_SIZE_IS_TOO_LARGE if size is too large.
+ * @throws CORAL_LINKED_LIST_ERROR_MEMORY_ALLOCATION_FAILED if there is not
+ * enough memory to allocate an entry.
+ */
+int coral_linked_list_alloc_with(const struct coral_allocator *allocator,
+                                 size_t size,
+                                 struct coral_linked_list_item **out);
+
+/**
+ * @brief Allocate memory for an item from the arena of the linked list.
+ * <p>Items allocated from the arena may only be added to this linked list,
+ * freeing them does not release their memory which is instead released all
+ * at once when the linked list is invalidated. The linked list must stay
+ * where it is for as long as it has items allocated from its arena.</p>
+ * @param [in] object linked list whose arena is to be used.
+ * @param [in] size in bytes of item to create.
+ * @param [out] out receive allocated item.
+ * @return On success <i>0</i>, otherwise an error code.
+ * @throws CORAL_LINKED_LIST_ERROR_OBJECT_IS_NULL if object is <i>NULL</i>.
+ * @throws CORAL_LINKED_LIST_ERROR_OUT_IS_NULL if out is <i>NULL</i>.
+ * @throws CORAL_LINKED_LIST_ERROR_SIZE_IS_ZERO if size is zero.
+ * @throws CORAL_LINKED_LIST_ERROR_SIZE_IS_TOO_LARGE if size is too large.
+ * @throws CORAL_LINKED_LIST_ERROR_MEMORY_ALLOCATION_FAILED if there is not
+ * enough memory to allocate an entry.
+ */
+int coral_linked_list_arena_alloc(struct coral_linked_list *object,
+                                  size_t size,
+                                  struct coral_linked_list_item **out);
+
 /**
  * @brief Free memory of an item.
+ * <p>Memory is returned to the allocator the item was allocated from.</p>
  * @param [in] item to be freed.
  * @return On success <i>0</i>, otherwise an error code.
  * @throws CORAL_LINKED_LIST_ERROR_ITEM_IS_NULL if item is <i>NULL</i>.
@@ -69,6 +131,11 @@ int coral_linked_list_init(struct coral_linked_list *object);
  * the provided <i>on destroy</i> callback invoked upon itself. The actual
  * <u>container instance is not deallocated</u> since it may have been embedded
  * in a larger structure.</p>
+ * <p>If there is no <i>on destroy</i> callback and all the items were
+ * allocated from the arena of the linked list then the items are not
+ * visited, the chunks of the arena are released instead.</p>
+ * <p>Intrusive nodes are only unlinked, they are owned by the caller and
+ * the <i>on destroy</i> callback is not invoked upon them.</p>
  * @param [in] object instance to be invalidated.
  * @param [in] on_destroy called just before the node is to be destroyed.
  * @return On success <i>0</i>, otherwise an error code.
@@ -96,6 +163,8 @@ int coral_linked_list_count(struct coral_linked_list *object,
  * @return On success <i>0</i>, otherwise an error code.
  * @throws CORAL_LINKED_LIST_ERROR_OBJECT_IS_NULL if object is <i>NULL</i>.
  * @throws CORAL_LINKED_LIST_ERROR_ITEM_IS_NULL if item is <i>NULL</i>.
+ * @throws CORAL_LINKED_LIST_ERROR_ITEM_IS_FROM_OTHER_LIST if item was
+ * allocated from the arena of another linked list.
  */
 int coral_linked_list_add(struct coral_linked_list *object,
                           struct coral_linked_list_item *item);
@@ -109,6 +178,8 @@ int coral_linked_list_add(struct coral_linked_list *object,
  * @throws CORAL_LINKED_LIST_ERROR_OBJECT_IS_NULL if object is <i>NULL</i>.
  * @throws CORAL_LINKED_LIST_ERROR_ITEM_IS_NULL if item is <i>NULL</i>.
  * @throws CORAL_LINKED_LIST_ERROR_VALUE_IS_NULL if value is <i>NULL</i>.
+ * @throws CORAL_LINKED_LIST_ERROR_ITEM_IS_FROM_OTHER_LIST if value was
+ * allocated from the arena of another linked list.
  */
 int coral_linked_list_insert(struct coral_linked_list *object,
                              struct coral_linked_list_item *item,
@@ -179,4 +250,109 @@ int coral_linked_list_prev(const struct coral_linked_list *object,
                            const struct coral_linked_list_item *item,
                            struct coral_linked_list_item **out);
 
+/**
+ * @brief Initialize intrusive node.
+ * @param [in] node instance to be initialized.
+ * @return On success <i>0</i>, otherwise an error code.
+ * @throws CORAL_LINKED_LIST_ERROR_NODE_IS_NULL if node is <i>NULL</i>.
+ */
+int coral_linked_list_node_init(struct coral_linked_list_node *node);
+
+/**
+ * @brief Add node to the end.
+ * @param [in] object linked list.
+ * @param [in] node to add.
+ * @return On success <i>0</i>, otherwise an error code.
+ * @throws CORAL_LINKED_LIST_ERROR_OBJECT_IS_NULL if object is <i>NULL</i>.
+ * @throws CORAL_LINKED_LIST_ERROR_NODE_IS_NULL if node is <i>NULL</i>.
+ * @throws CORAL_LINKED_LIST_ERROR_ITEM_IS_FROM_OTHER_LIST if node is that of
+ * an item allocated from the arena of another linked list.
+ */
+int coral_linked_list_add_node(struct coral_linked_list *object,
+                               struct coral_linked_list_node *node);
+
+/**
+ * @brief Insert value at node.
+ * @param [in] object linked list.
+ * @param [in] node at which value will be inserted.
+ * @param [in] value to insert.
+ * @return On success <i>0</i>, otherwise an error code.
+ * @throws CORAL_LINKED_LIST_ERROR_OBJECT_IS_NULL if object is <i>NULL</i>.
+ * @throws CORAL_LINKED_LIST_ERROR_NODE_IS_NULL if node is <i>NULL</i>.
+ * @throws CORAL_LINKED_LIST_ERROR_VALUE_IS_NULL if value is <i>NULL</i>.
+ * @throws CORAL_LINKED_LIST_ERROR_ITEM_IS_FROM_OTHER_LIST if value is that of
+ * an item allocated from the arena of another linked list.
+ */
+int coral_linked_list_insert_node(struct coral_linked_list *object,
+                                  struct coral_linked_list_node *node,
+                                  struct coral_linked_list_node *value);
+
+/**
+ * @brief Remove node.
+ * @param [in] object linked list.
+ * @param [in] node to be removed.
+ * @return On success <i>0</i>, otherwise an error code.
+ * @throws CORAL_LINKED_LIST_ERROR_OBJECT_IS_NULL if object is <i>NULL</i>.
+ * @throws CORAL_LINKED_LIST_ERROR_NODE_IS_NULL if node is <i>NULL</i>.
+ */
+int coral_linked_list_remove_node(struct coral_linked_list *object,
+                                  struct coral_linked_list_node *node);
+
+/**
+ * @brief Retrieve first node.
+ * @param [in] object linked list.
+ * @param [out] out receive first node.
+ * @return On success <i>0</i>, otherwise an error code.
+ * @throws CORAL_LINKED_LIST_ERROR_OBJECT_IS_NULL if object is <i>NULL</i>.
+ * @throws CORAL_LINKED_LIST_ERROR_OUT_IS_NULL if out is <i>NULL</i>.
+ * @throws CORAL_LINKED_LIST_ERROR_LIST_IS_EMPTY if there are no nodes in the
+ * linked list.
+ */
+int coral_linked_list_first_node(const struct coral_linked_list *object,
+                                 struct coral_linked_list_node **out);
+
+/**
+ * @brief Retrieve last node.
+ * @param [in] object linked list.
+ * @param [out] out receive last node.
+ * @return On success <i>0</i>, otherwise an error code.
+ * @throws CORAL_LINKED_LIST_ERROR_OBJECT_IS_NULL if object is <i>NULL</i>.
+ * @throws CORAL_LINKED_LIST_ERROR_OUT_IS_NULL if out is <i>NULL</i>.
+ * @throws CORAL_LINKED_LIST_ERROR_LIST_IS_EMPTY if there are no nodes in the
+ * linked list.
+ */
+int coral_linked_list_last_node(const struct coral_linked_list *object,
+                                struct coral_linked_list_node **out);
+
+/**
+ * @brief Retrieve the next node.
+ * @param [in] object linked list.
+ * @param [in] node current node.
+ * @param [out] out receive the next node.
+ * @return On success <i>0</i>, otherwise an error code.
+ * @throws CORAL_LINKED_LIST_ERROR_OBJECT_IS_NULL if object is <i>NULL</i>.
+ * @throws CORAL_LINKED_LIST_ERROR_NODE_IS_NULL if node is <i>NULL</i>.
+ * @throws CORAL_LINKED_LIST_ERROR_OUT_IS_NULL if out is <i>NULL</i>.
+ * @throws CORAL_LINKED_LIST_ERROR_END_OF_SEQUENCE if there is no next node.
+ */
+int coral_linked_list_next_node(const struct coral_linked_list *object,
+                                const struct coral_linked_list_node *node,
+                                struct coral_linked_list_node **out);
+
+/**
+ * @brief Retrieve the previous node.
+ * @param [in] object linked list.
+ * @param [in] node current node.
+ * @param [out] out receive the previous node.
+ * @return On success <i>0</i>, otherwise an error code.
+ * @throws CORAL_LINKED_LIST_ERROR_OBJECT_IS_NULL if object is <i>NULL</i>.
+ * @throws CORAL_LINKED_LIST_ERROR_NODE_IS_NULL if node is <i>NULL</i>.
+ * @throws CORAL_LINKED_LIST_ERROR_OUT_IS_NULL if out is <i>NULL</i>.
+ * @throws CORAL_LINKED_LIST_ERROR_END_OF_SEQUENCE if there is no previous
+ * node.
+ */
+int coral_linked_list_prev_node(const struct coral_linked_list *object,
+                                const struct coral_linked_list_node *node,
+                                struct coral_linked_list_node **out);
+
 #endif /* _CORAL_LINKED_LIST_H_ */
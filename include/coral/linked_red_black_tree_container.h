@@ -6,6 +6,9 @@
 #include <stdbool.h>
 #include <sea-urchin.h>
 #include <rock.h>
+#include <coral/allocator.h>
+#include <coral/counters.h>
+#include <coral/red_black_tree.h>
 
 #define CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_SIZE_IS_ZERO \
     SEA_URCHIN_ERROR_VALUE_IS_ZERO
@@ -18,33 +21,66 @@
 #define CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_ENTRY_IS_NULL \
     SEA_URCHIN_ERROR_ITEM_IS_NULL
 #define CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_OBJECT_IS_NULL \
-    ROCK_RED_BLACK_TREE_ERROR_OBJECT_IS_NULL
+    CORAL_RED_BLACK_TREE_ERROR_OBJECT_IS_NULL
 #define CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_COMPARE_IS_NULL \
-    ROCK_RED_BLACK_TREE_ERROR_COMPARE_IS_NULL
+    CORAL_RED_BLACK_TREE_ERROR_COMPARE_IS_NULL
 #define CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_ENTRY_ALREADY_EXISTS \
-    ROCK_RED_BLACK_TREE_ERROR_NODE_ALREADY_EXISTS
+    CORAL_RED_BLACK_TREE_ERROR_NODE_ALREADY_EXISTS
 #define CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_KEY_IS_NULL \
     SEA_URCHIN_ERROR_KEY_IS_NULL
 #define CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_ENTRY_NOT_FOUND \
-    ROCK_RED_BLACK_TREE_ERROR_NODE_NOT_FOUND
+    CORAL_RED_BLACK_TREE_ERROR_NODE_NOT_FOUND
 #define CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_CONTAINER_IS_EMPTY \
-    ROCK_RED_BLACK_TREE_ERROR_TREE_IS_EMPTY
+    CORAL_RED_BLACK_TREE_ERROR_TREE_IS_EMPTY
 #define CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_END_OF_SEQUENCE \
-    ROCK_RED_BLACK_TREE_ERROR_END_OF_SEQUENCE
+    CORAL_RED_BLACK_TREE_ERROR_END_OF_SEQUENCE
 #define CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_ITEM_IS_NULL \
     SEA_URCHIN_ERROR_VALUE_IS_NULL
+#define CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_NODE_IS_NULL \
+    SEA_URCHIN_ERROR_ITEM_IS_NULL
+#define CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_CONTAINER_IS_NOT_EMPTY \
+    CORAL_RED_BLACK_TREE_ERROR_TREE_IS_NOT_EMPTY
+#define CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_ENTRIES_ARE_NOT_SORTED \
+    SEA_URCHIN_ERROR_VALUE_IS_INVALID
+#define CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_INDEX_IS_OUT_OF_BOUNDS \
+    CORAL_RED_BLACK_TREE_ERROR_INDEX_IS_OUT_OF_BOUNDS
+#define CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_AGGREGATE_IS_NULL \
+    SEA_URCHIN_ERROR_VALUE_IS_NULL
+#define CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_CONTAINER_IS_INTRUSIVE \
+    SEA_URCHIN_ERROR_VALUE_IS_INVALID
 
 struct coral_linked_red_black_tree_container_entry;
 
+/**
+ * @brief Node to embed in a structure so that it can be added to a linked
+ * red black tree container without allocating an entry.
+ * <p>Use <i>rock_container_of</i> to get from the node to the structure
+ * embedding it.</p>
+ */
+struct coral_linked_red_black_tree_container_node {
+    struct coral_red_black_tree_node rbt_node;
+    struct rock_linked_list_node ll_node;
+};
+
 struct coral_linked_red_black_tree_container {
-    struct rock_red_black_tree tree;
+    struct coral_red_black_tree tree;
     struct rock_linked_list_node *list;
 
     int (*compare)(const void *, const void *);
+    int (*compare_key)(const void *, const void *);
+    int (*compare_node)(
+            const struct coral_linked_red_black_tree_container_node *,
+            const struct coral_linked_red_black_tree_container_node *);
+
+    size_t summary_size;
+    size_t summary_offset;
+    void (*lift)(const void *, void *);
+    void (*combine)(const void *, const void *, void *);
 };
 
 /**
  * @brief Allocate memory for an entry.
+ * <p>Memory is obtained from the default allocator.</p>
  * @param [in] size in bytes of entry to create.
  * @param [out] out receive allocated entry.
  * @return On success <i>0</i>, otherwise an error code.
@@ -61,8 +97,30 @@ int coral_linked_red_black_tree_container_alloc(
         size_t size,
         struct coral_linked_red_black_tree_container_entry **out);
 
+/**
+ * @brief Allocate memory for an entry from the given allocator.
+ * @param [in] allocator to allocate from or <i>NULL</i> for the default
+ * allocator.
+ * @param [in] size in bytes of entry to create.
+ * @param [out] out receive allocated entry.
+ * @return On success <i>0</i>, otherwise an error code.
+ * @throws CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_OUT_IS_NULL if out is
+ * <i>NULL</i>.
+ * @throws CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_SIZE_IS_ZERO if size
+ * is zero.
+ * @throws CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_SIZE_IS_TOO_LARGE if
+ * size is too large.
+ * @throws CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_MEMORY_ALLOCATION_FAILED
+ * if there is not enough memory to allocate an entry.
+ */
+int coral_linked_red_black_tree_container_alloc_with(
+        const struct coral_allocator *allocator,
+        size_t size,
+        struct coral_linked_red_black_tree_container_entry **out);
+
 /**
  * @brief Free memory of an entry.
+ * <p>Memory is returned to the allocator the entry was allocated from.</p>
  * @param [in] entry to be freed.
  * @return On success <i>0</i>, otherwise an error code.
  * @throws CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_ENTRY_IS_NULL if entry
@@ -71,6 +129,17 @@ int coral_linked_red_black_tree_container_alloc(
 int coral_linked_red_black_tree_container_free(
         struct coral_linked_red_black_tree_container_entry *entry);
 
+/**
+ * @brief Initialize node.
+ * <p>A node must be initialized before it is added to a container.</p>
+ * @param [in] node instance to be initialized.
+ * @return On success <i>0</i>, otherwise an error code.
+ * @throws CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_NODE_IS_NULL if node
+ * is <i>NULL</i>.
+ */
+int coral_linked_red_black_tree_container_node_init(
+        struct coral_linked_red_black_tree_container_node *node);
+
 /**
  * @brief Initialize red black tree container.
  * @param [in] object instance to be initialized.
@@ -89,12 +158,61 @@ int coral_linked_red_black_tree_container_init(
         int (*compare)(const void *first,
                        const void *second));
 
+/**
+ * @brief Initialize red black tree container with a key comparison.
+ * <p>The key comparison allows the <i>_key</i> lookup functions to take a
+ * compact key instead of an entry shaped one.</p>
+ * @param [in] object instance to be initialized.
+ * @param [in] compare comparison which must return an integer less than,
+ * equal to, or greater than zero if the <u>first key</u> is considered
+ * to be respectively less than, equal to, or greater than the <u>second
+ * key</u>.
+ * @param [in] compare_key comparison which must return an integer less
+ * than, equal to, or greater than zero if the <u>key</u> is considered to be
+ * respectively less than, equal to, or greater than the <u>entry</u>. It
+ * must order the entries the same way as <i>compare</i> does.
+ * @return On success <i>0</i>, otherwise an error code.
+ * @throws CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_OBJECT_IS_NULL if
+ * object is <i>NULL</i>.
+ * @throws CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_COMPARE_IS_NULL if
+ * compare or compare_key is <i>NULL</i>.
+ */
+int coral_linked_red_black_tree_container_init_with_key(
+        struct coral_linked_red_black_tree_container *object,
+        int (*compare)(const void *first,
+                       const void *second),
+        int (*compare_key)(const void *key,
+                           const void *entry));
+
+/**
+ * @brief Initialize red black tree container for intrusive nodes.
+ * <p>Only the <i>_node</i> functions may be used with the container.</p>
+ * @param [in] object instance to be initialized.
+ * @param [in] compare comparison which must return an integer less than,
+ * equal to, or greater than zero if the <u>first node</u> is considered
+ * to be respectively less than, equal to, or greater than the <u>second
+ * node</u>.
+ * @return On success <i>0</i>, otherwise an error code.
+ * @throws CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_OBJECT_IS_NULL if
+ * object is <i>NULL</i>.
+ * @throws CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_COMPARE_IS_NULL if
+ * compare is <i>NULL</i>.
+ */
+int coral_linked_red_black_tree_container_init_intrusive(
+        struct coral_linked_red_black_tree_container *object,
+        int (*compare)(
+            const struct coral_linked_red_black_tree_container_node *first,
+            const struct coral_linked_red_black_tree_container_node *second));
+
 /**
  * @brief Invalidate red black tree container.
  * <p>The entries in the container are destroyed and each entry will have
  * the provided <i>on destroy</i> callback invoked upon itself. The actual
  * <u>container instance is not deallocated</u> since it may have been embedded
  * in a larger structure.</p>
+ * <p>Intrusive nodes are owned by the caller, they are neither destroyed
+ * nor passed to the <i>on destroy</i> callback and must be initialized
+ * again before being reused.</p>
  * @param [in] object instance to be invalidated.
  * @param [in] on_destroy called just before the node is to be destroyed.
  * @return On success <i>0</i>, otherwise an error code.
@@ -129,6 +247,8 @@ int coral_linked_red_black_tree_container_count(
  * object is <i>NULL</i>.
  * @throws CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_ENTRY_IS_NULL if entry
  * is <i>NULL</i>.
+ * @throws CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_COMPARE_IS_NULL if the
+ * container holds intrusive nodes.
  * @throws CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_ENTRY_ALREADY_EXITS if
  * entry is already present in container.
  */
@@ -136,6 +256,35 @@ int coral_linked_red_black_tree_container_add(
         struct coral_linked_red_black_tree_container *object,
         const struct coral_linked_red_black_tree_container_entry *entry);
 
+/**
+ * @brief Build the container out of entries given in sorted order.
+ * <p>Instead of adding the entries one by one, which takes
+ * <i>O(n log n)</i> comparisons and rebalancing, the order of the entries
+ * is verified and a balanced tree is linked together in <i>O(n)</i>.</p>
+ * <p>The entries are linked in the order given which therefore also
+ * becomes their insertion order.</p>
+ * @param [in] object container instance which must be empty.
+ * @param [in] entries in strictly ascending order.
+ * @param [in] count of entries.
+ * @return On success <i>0</i>, otherwise an error code.
+ * @throws CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_OBJECT_IS_NULL if object
+ * is <i>NULL</i>.
+ * @throws CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_ENTRY_IS_NULL if entries,
+ * or any of the entries, is <i>NULL</i>.
+ * @throws CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_COMPARE_IS_NULL if the
+ * container holds intrusive nodes.
+ * @throws CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_CONTAINER_IS_NOT_EMPTY if
+ * container is not empty.
+ * @throws CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_ENTRY_ALREADY_EXISTS if
+ * two entries are equal.
+ * @throws CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_ENTRIES_ARE_NOT_SORTED if
+ * the entries are not in ascending order.
+ */
+int coral_linked_red_black_tree_container_build_sorted(
+        struct coral_linked_red_black_tree_container *object,
+        struct coral_linked_red_black_tree_container_entry *const *entries,
+        uintmax_t count);
+
 /**
  * @brief Remove entry.
  * @param [in] object container instance.
@@ -150,6 +299,59 @@ int coral_linked_red_black_tree_container_remove(
         struct coral_linked_red_black_tree_container *object,
         const struct coral_linked_red_black_tree_container_entry *entry);
 
+/**
+ * @brief Remove the entries from first up to and including last.
+ * <p>The range is cut out of the tree and what remains is joined back together,
+ * so the removal costs <i>O(log n + k)</i> for <i>k</i> entries without
+ * rebalancing after each of them. Neither bound need match an entry.</p>
+ * <p>The removed entries are also taken out of the insertion order.</p>
+ * @param [in] object container instance.
+ * @param [in] first key of the range.
+ * @param [in] last key of the range.
+ * @param [in] on_destroy called with each removed entry before it is freed, may
+ * be <i>NULL</i>.
+ * @return On success <i>0</i>, otherwise an error code.
+ * @throws CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_OBJECT_IS_NULL if object
+ * is <i>NULL</i>.
+ * @throws CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_KEY_IS_NULL if first or
+ * last is <i>NULL</i>.
+ * @throws CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_COMPARE_IS_NULL if the
+ * container holds intrusive nodes.
+ */
+int coral_linked_red_black_tree_container_remove_range(
+        struct coral_linked_red_black_tree_container *object,
+        const void *first,
+        const void *last,
+        void (*on_destroy)(
+                struct coral_linked_red_black_tree_container_entry *entry));
+
+/**
+ * @brief Remove the entries from first up to and including last using the key
+ * comparison.
+ * <p>The range is cut out of the tree and what remains is joined back together,
+ * so the removal costs <i>O(log n + k)</i> for <i>k</i> entries without
+ * rebalancing after each of them. Neither bound need match an entry.</p>
+ * <p>The removed entries are also taken out of the insertion order.</p>
+ * @param [in] object container instance.
+ * @param [in] first key of the range.
+ * @param [in] last key of the range.
+ * @param [in] on_destroy called with each removed entry before it is freed, may
+ * be <i>NULL</i>.
+ * @return On success <i>0</i>, otherwise an error code.
+ * @throws CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_OBJECT_IS_NULL if object
+ * is <i>NULL</i>.
+ * @throws CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_KEY_IS_NULL if first or
+ * last is <i>NULL</i>.
+ * @throws CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_COMPARE_IS_NULL if the
+ * container was not initialized with a key comparison.
+ */
+int coral_linked_red_black_tree_container_remove_range_key(
+        struct coral_linked_red_black_tree_container *object,
+        const void *first,
+        const void *last,
+        void (*on_destroy)(
+                struct coral_linked_red_black_tree_container_entry *entry));
+
 /**
  * @brief Retrieve entry for key.
  * @param [in] object container instance.
@@ -162,6 +364,8 @@ int coral_linked_red_black_tree_container_remove(
  * <i>NULL</i>.
  * @throws CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_OUT_IS_NULL if out is
  * <i>NULL</i>.
+ * @throws CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_COMPARE_IS_NULL if the
+ * container holds intrusive nodes.
  * @throws CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_ENTRY_NOT_FOUND if
  * matching entry was not found.
  */
@@ -170,6 +374,28 @@ int coral_linked_red_black_tree_container_get(
         const void *key,
         struct coral_linked_red_black_tree_container_entry **out);
 
+/**
+ * @brief Retrieve entry for key using the key comparison.
+ * @param [in] object container instance.
+ * @param [in] key on which to find entry.
+ * @param [out] out receive matching entry.
+ * @return On success <i>0</i>, otherwise an error code.
+ * @throws CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_OBJECT_IS_NULL if
+ * object is <i>NULL</i>.
+ * @throws CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_KEY_IS_NULL if key is
+ * <i>NULL</i>.
+ * @throws CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_OUT_IS_NULL if out is
+ * <i>NULL</i>.
+ * @throws CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_COMPARE_IS_NULL if the
+ * container was not initialized with a key comparison.
+ * @throws CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_ENTRY_NOT_FOUND if
+ * matching entry was not found.
+ */
+int coral_linked_red_black_tree_container_get_key(
+        const struct coral_linked_red_black_tree_container *object,
+        const void *key,
+        struct coral_linked_red_black_tree_container_entry **out);
+
 /**
  * @brief Retrieve entry or next higher for key.
  * @param [in] object container instance.
@@ -182,6 +408,8 @@ int coral_linked_red_black_tree_container_get(
  * <i>NULL</i>.
  * @throws CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_OUT_IS_NULL if out is
  * <i>NULL</i>.
+ * @throws CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_COMPARE_IS_NULL if the
+ * container holds intrusive nodes.
  * @throws CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_ENTRY_NOT_FOUND if
  * matching entry or next higher entry was not found.
  */
@@ -190,6 +418,28 @@ int coral_linked_red_black_tree_container_ceiling(
         const void *key,
         struct coral_linked_red_black_tree_container_entry **out);
 
+/**
+ * @brief Retrieve entry or next higher for key using the key comparison.
+ * @param [in] object container instance.
+ * @param [in] key on which to find entry or next higher.
+ * @param [out] out receive matching entry.
+ * @return On success <i>0</i>, otherwise an error code.
+ * @throws CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_OBJECT_IS_NULL if
+ * object is <i>NULL</i>.
+ * @throws CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_KEY_IS_NULL if key is
+ * <i>NULL</i>.
+ * @throws CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_OUT_IS_NULL if out is
+ * <i>NULL</i>.
+ * @throws CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_COMPARE_IS_NULL if the
+ * container was not initialized with a key comparison.
+ * @throws CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_ENTRY_NOT_FOUND if
+ * matching entry or next higher entry was not found.
+ */
+int coral_linked_red_black_tree_container_ceiling_key(
+        const struct coral_linked_red_black_tree_container *object,
+        const void *key,
+        struct coral_linked_red_black_tree_container_entry **out);
+
 /**
  * @brief Retrieve entry or next lower for key.
  * @param [in] object container instance.
@@ -202,6 +452,8 @@ int coral_linked_red_black_tree_container_ceiling(
  * <i>NULL</i>.
  * @throws CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_OUT_IS_NULL if out is
  * <i>NULL</i>.
+ * @throws CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_COMPARE_IS_NULL if the
+ * container holds intrusive nodes.
  * @throws CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_ENTRY_NOT_FOUND if
  * matching entry or next lower entry was not found.
  */
@@ -210,6 +462,28 @@ int coral_linked_red_black_tree_container_floor(
         const void *key,
         struct coral_linked_red_black_tree_container_entry **out);
 
+/**
+ * @brief Retrieve entry or next lower for key using the key comparison.
+ * @param [in] object container instance.
+ * @param [in] key on which to find entry or next lower.
+ * @param [out] out receive matching entry.
+ * @return On success <i>0</i>, otherwise an error code.
+ * @throws CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_OBJECT_IS_NULL if
+ * object is <i>NULL</i>.
+ * @throws CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_KEY_IS_NULL if key is
+ * <i>NULL</i>.
+ * @throws CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_OUT_IS_NULL if out is
+ * <i>NULL</i>.
+ * @throws CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_COMPARE_IS_NULL if the
+ * container was not initialized with a key comparison.
+ * @throws CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_ENTRY_NOT_FOUND if
+ * matching entry or next lower entry was not found.
+ */
+int coral_linked_red_black_tree_container_floor_key(
+        const struct coral_linked_red_black_tree_container *object,
+        const void *key,
+        struct coral_linked_red_black_tree_container_entry **out);
+
 /**
  * @brief Retrieve next higher entry for key.
  * @param [in] object container instance.
@@ -222,6 +496,8 @@ int coral_linked_red_black_tree_container_floor(
  * <i>NULL</i>.
  * @throws CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_OUT_IS_NULL if out is
  * <i>NULL</i>.
+ * @throws CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_COMPARE_IS_NULL if the
+ * container holds intrusive nodes.
  * @throws CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_ENTRY_NOT_FOUND if next
  * higher entry was not found.
  */
@@ -230,6 +506,28 @@ int coral_linked_red_black_tree_container_higher(
         const void *key,
         struct coral_linked_red_black_tree_container_entry **out);
 
+/**
+ * @brief Retrieve next higher entry for key using the key comparison.
+ * @param [in] object container instance.
+ * @param [in] key on which to find next higher entry.
+ * @param [out] out receive matching entry.
+ * @return On success <i>0</i>, otherwise an error code.
+ * @throws CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_OBJECT_IS_NULL if
+ * object is <i>NULL</i>.
+ * @throws CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_KEY_IS_NULL if key is
+ * <i>NULL</i>.
+ * @throws CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_OUT_IS_NULL if out is
+ * <i>NULL</i>.
+ * @throws CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_COMPARE_IS_NULL if the
+ * container was not initialized with a key comparison.
+ * @throws CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_ENTRY_NOT_FOUND if next
+ * higher entry was not found.
+ */
+int coral_linked_red_black_tree_container_higher_key(
+        const struct coral_linked_red_black_tree_container *object,
+        const void *key,
+        struct coral_linked_red_black_tree_container_entry **out);
+
 /**
  * @brief Retrieve next lower entry for key.
  * @param [in] object container instance.
@@ -242,6 +540,8 @@ int coral_linked_red_black_tree_container_higher(
  * <i>NULL</i>.
  * @throws CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_OUT_IS_NULL if out is
  * <i>NULL</i>.
+ * @throws CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_COMPARE_IS_NULL if the
+ * container holds intrusive nodes.
  * @throws CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_ENTRY_NOT_FOUND if next
  * lower entry was not found.
  */
@@ -250,6 +550,28 @@ int coral_linked_red_black_tree_container_lower(
         const void *key,
         struct coral_linked_red_black_tree_container_entry **out);
 
+/**
+ * @brief Retrieve next lower entry for key using the key comparison.
+ * @param [in] object container instance.
+ * @param [in] key on which to find next lower entry.
+ * @param [out] out receive matching entry.
+ * @return On success <i>0</i>, otherwise an error code.
+ * @throws CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_OBJECT_IS_NULL if
+ * object is <i>NULL</i>.
+ * @throws CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_KEY_IS_NULL if key is
+ * <i>NULL</i>.
+ * @throws CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_OUT_IS_NULL if out is
+ * <i>NULL</i>.
+ * @throws CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_COMPARE_IS_NULL if the
+ * container was not initialized with a key comparison.
+ * @throws CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_ENTRY_NOT_FOUND if next
+ * lower entry was not found.
+ */
+int coral_linked_red_black_tree_container_lower_key(
+        const struct coral_linked_red_black_tree_container *object,
+        const void *key,
+        struct coral_linked_red_black_tree_container_entry **out);
+
 /**
  * @brief Receive sorted first entry.
  * @param [in] object container instance.
@@ -314,6 +636,232 @@ int coral_linked_red_black_tree_container_sorted_prev(
         const struct coral_linked_red_black_tree_container_entry *entry,
         struct coral_linked_red_black_tree_container_entry **out);
 
+/**
+ * @brief Count the entries ordered before key.
+ * <p>The key need not match any entry, the count is found in <i>O(log n)</i>
+ * from the subtree sizes kept in the tree.</p>
+ * @param [in] object container instance.
+ * @param [in] key to count the entries before.
+ * @param [out] out receive the number of entries less than key.
+ * @return On success <i>0</i>, otherwise an error code.
+ * @throws CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_OBJECT_IS_NULL if object
+ * is <i>NULL</i>.
+ * @throws CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_KEY_IS_NULL if key is
+ * <i>NULL</i>.
+ * @throws CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_OUT_IS_NULL if out is
+ * <i>NULL</i>.
+ * @throws CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_COMPARE_IS_NULL if the
+ * container holds intrusive nodes.
+ */
+int coral_linked_red_black_tree_container_rank(
+        const struct coral_linked_red_black_tree_container *object,
+        const void *key,
+        uintmax_t *out);
+
+/**
+ * @brief Count the entries ordered before key using the key comparison.
+ * <p>The key need not match any entry, the count is found in <i>O(log n)</i>
+ * from the subtree sizes kept in the tree.</p>
+ * @param [in] object container instance.
+ * @param [in] key to count the entries before.
+ * @param [out] out receive the number of entries less than key.
+ * @return On success <i>0</i>, otherwise an error code.
+ * @throws CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_OBJECT_IS_NULL if object
+ * is <i>NULL</i>.
+ * @throws CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_KEY_IS_NULL if key is
+ * <i>NULL</i>.
+ * @throws CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_OUT_IS_NULL if out is
+ * <i>NULL</i>.
+ * @throws CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_COMPARE_IS_NULL if the
+ * container was not initialized with a key comparison.
+ */
+int coral_linked_red_black_tree_container_rank_key(
+        const struct coral_linked_red_black_tree_container *object,
+        const void *key,
+        uintmax_t *out);
+
+/**
+ * @brief Count the entries from first up to and including last.
+ * <p>Neither bound need match an entry. The count is found in <i>O(log n)</i>
+ * and is <i>0</i> if first is greater than last.</p>
+ * @param [in] object container instance.
+ * @param [in] first key of the range.
+ * @param [in] last key of the range.
+ * @param [out] out receive the number of entries in the range.
+ * @return On success <i>0</i>, otherwise an error code.
+ * @throws CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_OBJECT_IS_NULL if object
+ * is <i>NULL</i>.
+ * @throws CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_KEY_IS_NULL if first or
+ * last is <i>NULL</i>.
+ * @throws CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_OUT_IS_NULL if out is
+ * <i>NULL</i>.
+ * @throws CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_COMPARE_IS_NULL if the
+ * container holds intrusive nodes.
+ */
+int coral_linked_red_black_tree_container_count_range(
+        const struct coral_linked_red_black_tree_container *object,
+        const void *first,
+        const void *last,
+        uintmax_t *out);
+
+/**
+ * @brief Count the entries from first up to and including last using the key
+ * comparison.
+ * <p>Neither bound need match an entry. The count is found in <i>O(log n)</i>
+ * and is <i>0</i> if first is greater than last.</p>
+ * @param [in] object container instance.
+ * @param [in] first key of the range.
+ * @param [in] last key of the range.
+ * @param [out] out receive the number of entries in the range.
+ * @return On success <i>0</i>, otherwise an error code.
+ * @throws CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_OBJECT_IS_NULL if object
+ * is <i>NULL</i>.
+ * @throws CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_KEY_IS_NULL if first or
+ * last is <i>NULL</i>.
+ * @throws CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_OUT_IS_NULL if out is
+ * <i>NULL</i>.
+ * @throws CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_COMPARE_IS_NULL if the
+ * container was not initialized with a key comparison.
+ */
+int coral_linked_red_black_tree_container_count_range_key(
+        const struct coral_linked_red_black_tree_container *object,
+        const void *first,
+        const void *last,
+        uintmax_t *out);
+
+/**
+ * @brief Retrieve the entry at index in sorted order.
+ * @param [in] object container instance.
+ * @param [in] index of entry, the first entry is at <i>0</i>.
+ * @param [out] out receive the entry.
+ * @return On success <i>0</i>, otherwise an error code.
+ * @throws CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_OBJECT_IS_NULL if object
+ * is <i>NULL</i>.
+ * @throws CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_OUT_IS_NULL if out is
+ * <i>NULL</i>.
+ * @throws CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_INDEX_IS_OUT_OF_BOUNDS if
+ * index is not less than the number of entries.
+ */
+int coral_linked_red_black_tree_container_sorted_select(
+        const struct coral_linked_red_black_tree_container *object,
+        uintmax_t index,
+        struct coral_linked_red_black_tree_container_entry **out);
+
+/**
+ * @brief Keep a summary of every subtree for range aggregates.
+ * <p>Each entry holds <u>size</u> bytes of summary storage at <u>offset</u>
+ * within its data, which the container maintains through insertion, removal and
+ * rebalancing as the combination of all the entries in the subtree of the
+ * entry. The summaries form a monoid without identity: <u>combine</u> must be
+ * associative but need not be commutative.</p>
+ * <p>Only for containers of entries, it is not available for intrusive
+ * nodes.</p>
+ * @param [in] object container instance which must be empty.
+ * @param [in] size in bytes of a summary.
+ * @param [in] offset in bytes of the summary storage within the data of each
+ * entry.
+ * @param [in] lift write the summary of a single entry to out.
+ * @param [in] combine write the summary of first followed by second to out, out
+ * may be the same as first or second.
+ * @return On success <i>0</i>, otherwise an error code.
+ * @throws CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_OBJECT_IS_NULL if object
+ * is <i>NULL</i>.
+ * @throws CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_SIZE_IS_ZERO if size is
+ * zero.
+ * @throws CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_AGGREGATE_IS_NULL if lift
+ * or combine is <i>NULL</i>.
+ * @throws CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_CONTAINER_IS_NOT_EMPTY if
+ * container is not empty.
+ * @throws CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_CONTAINER_IS_INTRUSIVE if
+ * container was initialized for intrusive nodes.
+ */
+int coral_linked_red_black_tree_container_set_aggregate(
+        struct coral_linked_red_black_tree_container *object,
+        size_t size,
+        size_t offset,
+        void (*lift)(const void *entry, void *out),
+        void (*combine)(const void *first, const void *second, void *out));
+
+/**
+ * @brief Combine the summaries of the entries from first up to and including
+ * last.
+ * <p>Answered in <i>O(log n)</i> from the summaries kept for each subtree,
+ * neither bound need match an entry.</p>
+ * @param [in] object container instance.
+ * @param [in] first key of the range.
+ * @param [in] last key of the range.
+ * @param [out] out receive the summary of the range in the order of the
+ * entries.
+ * @return On success <i>0</i>, otherwise an error code.
+ * @throws CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_OBJECT_IS_NULL if object
+ * is <i>NULL</i>.
+ * @throws CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_KEY_IS_NULL if first or
+ * last is <i>NULL</i>.
+ * @throws CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_OUT_IS_NULL if out is
+ * <i>NULL</i>.
+ * @throws CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_COMPARE_IS_NULL if the
+ * container holds intrusive nodes.
+ * @throws CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_AGGREGATE_IS_NULL if the
+ * container keeps no summaries.
+ * @throws CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_ENTRY_NOT_FOUND if there
+ * are no entries in the range.
+ * @throws CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_MEMORY_ALLOCATION_FAILED
+ * if there is not enough memory to combine large summaries.
+ */
+int coral_linked_red_black_tree_container_aggregate(
+        const struct coral_linked_red_black_tree_container *object,
+        const void *first,
+        const void *last,
+        void *out);
+
+/**
+ * @brief Combine the summaries of the entries from first up to and including
+ * last using the key comparison.
+ * <p>Answered in <i>O(log n)</i> from the summaries kept for each subtree,
+ * neither bound need match an entry.</p>
+ * @param [in] object container instance.
+ * @param [in] first key of the range.
+ * @param [in] last key of the range.
+ * @param [out] out receive the summary of the range in the order of the
+ * entries.
+ * @return On success <i>0</i>, otherwise an error code.
+ * @throws CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_OBJECT_IS_NULL if object
+ * is <i>NULL</i>.
+ * @throws CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_KEY_IS_NULL if first or
+ * last is <i>NULL</i>.
+ * @throws CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_OUT_IS_NULL if out is
+ * <i>NULL</i>.
+ * @throws CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_COMPARE_IS_NULL if the
+ * container was not initialized with a key comparison.
+ * @throws CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_AGGREGATE_IS_NULL if the
+ * container keeps no summaries.
+ * @throws CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_ENTRY_NOT_FOUND if there
+ * are no entries in the range.
+ * @throws CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_MEMORY_ALLOCATION_FAILED
+ * if there is not enough memory to combine large summaries.
+ */
+int coral_linked_red_black_tree_container_aggregate_key(
+        const struct coral_linked_red_black_tree_container *object,
+        const void *first,
+        const void *last,
+        void *out);
+
+/**
+ * @brief Recompute the summaries after the data of entry has changed.
+ * <p>Only the data that the summary depends on may be changed, never the data
+ * that orders the entry.</p>
+ * @param [in] object container instance.
+ * @param [in] entry present in the container.
+ * @return On success <i>0</i>, otherwise an error code.
+ * @throws CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_OBJECT_IS_NULL if object
+ * is <i>NULL</i>.
+ * @throws CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_ENTRY_IS_NULL if entry is
+ * <i>NULL</i>.
+ */
+int coral_linked_red_black_tree_container_refresh(
+        struct coral_linked_red_black_tree_container *object,
+        struct coral_linked_red_black_tree_container_entry *entry);
+
 /**
  * @brief Receive first entry.
  * @param [in] object container instance.
@@ -398,6 +946,8 @@ int coral_linked_red_black_tree_container_prev(
  * is <i>NULL</i>.
  * @throws CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_ITEM_IS_NULL if item
  * is <i>NULL/i>.
+ * @throws CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_COMPARE_IS_NULL if the
+ * container holds intrusive nodes.
  * @throws CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_ENTRY_ALREADY_EXITS if
  * entry is already present in container.
  */
@@ -406,4 +956,152 @@ int coral_linked_red_black_tree_container_insert(
         struct coral_linked_red_black_tree_container_entry *entry,
         struct coral_linked_red_black_tree_container_entry *item);
 
+/**
+ * @brief Add node.
+ * @param [in] object container instance.
+ * @param [in] node to add.
+ * @return On success <i>0</i>, otherwise an error code.
+ * @throws CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_OBJECT_IS_NULL if
+ * object is <i>NULL</i>.
+ * @throws CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_NODE_IS_NULL if node
+ * is <i>NULL</i>.
+ * @throws CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_ENTRY_ALREADY_EXITS if
+ * entry is already present in container.
+ */
+int coral_linked_red_black_tree_container_add_node(
+        struct coral_linked_red_black_tree_container *object,
+        struct coral_linked_red_black_tree_container_node *node);
+
+/**
+ * @brief Remove node.
+ * @param [in] object container instance.
+ * @param [in] node to remove.
+ * @return On success <i>0</i>, otherwise an error code.
+ * @throws CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_OBJECT_IS_NULL if
+ * object is <i>NULL</i>.
+ * @throws CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_NODE_IS_NULL if node
+ * is <i>NULL</i>.
+ */
+int coral_linked_red_black_tree_container_remove_node(
+        struct coral_linked_red_black_tree_container *object,
+        struct coral_linked_red_black_tree_container_node *node);
+
+/**
+ * @brief Retrieve node for key.
+ * @param [in] object container instance.
+ * @param [in] key node on which to find node.
+ * @param [out] out receive matching node.
+ * @return On success <i>0</i>, otherwise an error code.
+ * @throws CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_OBJECT_IS_NULL if
+ * object is <i>NULL</i>.
+ * @throws CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_KEY_IS_NULL if key is
+ * <i>NULL</i>.
+ * @throws CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_OUT_IS_NULL if out is
+ * <i>NULL</i>.
+ * @throws CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_ENTRY_NOT_FOUND if
+ * matching node was not found.
+ */
+int coral_linked_red_black_tree_container_get_node(
+        const struct coral_linked_red_black_tree_container *object,
+        const struct coral_linked_red_black_tree_container_node *key,
+        struct coral_linked_red_black_tree_container_node **out);
+
+/**
+ * @brief Receive first node.
+ * @param [in] object container instance.
+ * @param [out] out receive first node.
+ * @return On success <i>0</i>, otherwise an error code.
+ * @throws CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_OBJECT_IS_NULL if
+ * object is <i>NULL</i>.
+ * @throws CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_OUT_IS_NULL if out is
+ * <i>NULL</i>.
+ * @throws CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_CONTAINER_IS_EMPTY if
+ * container is empty.
+ */
+int coral_linked_red_black_tree_container_first_node(
+        const struct coral_linked_red_black_tree_container *object,
+        struct coral_linked_red_black_tree_container_node **out);
+
+/**
+ * @brief Receive last node.
+ * @param [in] object container instance.
+ * @param [out] out receive last node.
+ * @return On success <i>0</i>, otherwise an error code.
+ * @throws CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_OBJECT_IS_NULL if
+ * object is <i>NULL</i>.
+ * @throws CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_OUT_IS_NULL if out is
+ * <i>NULL</i>.
+ * @throws CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_CONTAINER_IS_EMPTY if
+ * container is empty.
+ */
+int coral_linked_red_black_tree_container_last_node(
+        const struct coral_linked_red_black_tree_container *object,
+        struct coral_linked_red_black_tree_container_node **out);
+
+/**
+ * @brief Retrieve the next node.
+ * @param [in] object container instance.
+ * @param [in] node current one.
+ * @param [out] out receive the next node.
+ * @return On success <i>0</i>, otherwise an error code.
+ * @throws CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_OBJECT_IS_NULL if
+ * object is <i>NULL</i>.
+ * @throws CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_NODE_IS_NULL if node
+ * is <i>NULL</i>.
+ * @throws CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_OUT_IS_NULL if out is
+ * <i>NULL</i>.
+ * @throws CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_END_OF_SEQUENCE if there
+ * are no next nodes.
+ */
+int coral_linked_red_black_tree_container_next_node(
+        const struct coral_linked_red_black_tree_container *object,
+        const struct coral_linked_red_black_tree_container_node *node,
+        struct coral_linked_red_black_tree_container_node **out);
+
+/**
+ * @brief Retrieve the previous node.
+ * @param [in] object container instance.
+ * @param [in] node current one.
+ * @param [out] out receive the previous node.
+ * @return On success <i>0</i>, otherwise an error code.
+ * @throws CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_OBJECT_IS_NULL if
+ * object is <i>NULL</i>.
+ * @throws CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_NODE_IS_NULL if node
+ * is <i>NULL</i>.
+ * @throws CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_OUT_IS_NULL if out is
+ * <i>NULL</i>.
+ * @throws CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_END_OF_SEQUENCE if there
+ * are no previous nodes.
+ */
+int coral_linked_red_black_tree_container_prev_node(
+        const struct coral_linked_red_black_tree_container *object,
+        const struct coral_linked_red_black_tree_container_node *node,
+        struct coral_linked_red_black_tree_container_node **out);
+
+/**
+ * @brief Retrieve a snapshot of the operation counters.
+ * <p>Counters are only maintained if the library was built with the
+ * <i>CORAL_COUNTERS</i> option, otherwise they always read as zero.</p>
+ * @param [in] object container instance.
+ * @param [out] out receive the operation counters.
+ * @return On success <i>0</i>, otherwise an error code.
+ * @throws CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_OBJECT_IS_NULL if
+ * object is <i>NULL</i>.
+ * @throws CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_OUT_IS_NULL if out is
+ * <i>NULL</i>.
+ */
+int coral_linked_red_black_tree_container_counters(
+        const struct coral_linked_red_black_tree_container *object,
+        struct coral_counters *out);
+
+/**
+ * @brief Reset the operation counters to zero.
+ * @param [in] object container instance.
+ * @return On success <i>0</i>, otherwise an error code.
+ * @throws CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_OBJECT_IS_NULL if
+ * object is <i>NULL</i>.
+ */
+int coral_linked_red_black_tree_container_counters_reset(
+        struct coral_linked_red_black_tree_container *object);
+
 #endif /* _CORAL_LINKED_RED_BLACK_TREE_CONTAINER_H_ */
@@ -0,0 +1,26 @@
+#ifndef _CORAL_READER_WRITER_LOCK_H_
+#define _CORAL_READER_WRITER_LOCK_H_
+
+#include <stddef.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+#include <pthread.h>
+
+struct coral_reader_writer_lock_slot;
+
+/**
+ * @brief Reader writer lock on which the concurrent containers are built.
+ * <p>Readers are counted in one of several slots, each on a cache line of
+ * its own, picked by the calling thread. Readers on different cores thus
+ * never write to the same cache line, only a writer has to look at every
+ * slot while it waits for the readers to leave.</p>
+ * <p>Its fields are private to the library.</p>
+ */
+struct coral_reader_writer_lock {
+    struct coral_reader_writer_lock_slot *slots;
+    size_t mask;
+    atomic_bool writing;
+    pthread_mutex_t mutex;
+};
+
+#endif /* _CORAL_READER_WRITER_LOCK_H_ */
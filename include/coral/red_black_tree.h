@@ -0,0 +1,442 @@
+#ifndef _CORAL_RED_BLACK_TREE_H_
+#define _CORAL_RED_BLACK_TREE_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <sea-urchin.h>
+#include <rock.h>
+#include <coral/counters.h>
+
+#define CORAL_RED_BLACK_TREE_ERROR_OBJECT_IS_NULL \
+    ROCK_RED_BLACK_TREE_ERROR_OBJECT_IS_NULL
+#define CORAL_RED_BLACK_TREE_ERROR_COMPARE_IS_NULL \
+    ROCK_RED_BLACK_TREE_ERROR_COMPARE_IS_NULL
+#define CORAL_RED_BLACK_TREE_ERROR_NODE_IS_NULL \
+    SEA_URCHIN_ERROR_ITEM_IS_NULL
+#define CORAL_RED_BLACK_TREE_ERROR_LINK_IS_NULL \
+    SEA_URCHIN_ERROR_VALUE_IS_NULL
+#define CORAL_RED_BLACK_TREE_ERROR_NODE_AT_IS_NULL \
+    SEA_URCHIN_ERROR_VALUE_IS_NULL
+#define CORAL_RED_BLACK_TREE_ERROR_TREE_IS_NOT_EMPTY \
+    SEA_URCHIN_ERROR_VALUE_IS_INVALID
+#define CORAL_RED_BLACK_TREE_ERROR_AUGMENT_IS_NULL \
+    SEA_URCHIN_ERROR_VALUE_IS_NULL
+#define CORAL_RED_BLACK_TREE_ERROR_KEY_IS_NULL \
+    SEA_URCHIN_ERROR_KEY_IS_NULL
+#define CORAL_RED_BLACK_TREE_ERROR_OUT_IS_NULL \
+    SEA_URCHIN_ERROR_OUT_IS_NULL
+#define CORAL_RED_BLACK_TREE_ERROR_NODE_ALREADY_EXISTS \
+    ROCK_RED_BLACK_TREE_ERROR_NODE_ALREADY_EXISTS
+#define CORAL_RED_BLACK_TREE_ERROR_NODE_NOT_FOUND \
+    ROCK_RED_BLACK_TREE_ERROR_NODE_NOT_FOUND
+#define CORAL_RED_BLACK_TREE_ERROR_TREE_IS_EMPTY \
+    ROCK_RED_BLACK_TREE_ERROR_TREE_IS_EMPTY
+#define CORAL_RED_BLACK_TREE_ERROR_END_OF_SEQUENCE \
+    ROCK_RED_BLACK_TREE_ERROR_END_OF_SEQUENCE
+#define CORAL_RED_BLACK_TREE_ERROR_INDEX_IS_OUT_OF_BOUNDS \
+    ROCK_ARRAY_ERROR_INDEX_IS_OUT_OF_BOUNDS
+
+/**
+ * @brief Node of a red black tree.
+ * <p>Besides its links each node keeps the number of nodes in the subtree
+ * rooted at it, which lets the tree answer rank and select queries in
+ * <i>O(log n)</i>.</p>
+ */
+struct coral_red_black_tree_node {
+    struct coral_red_black_tree_node *parent;
+    struct coral_red_black_tree_node *left;
+    struct coral_red_black_tree_node *right;
+    uintmax_t size;
+    bool red;
+};
+
+/**
+ * @brief Red black tree of intrusive nodes.
+ * <p>The tree does not hold a comparison, instead it is handed to each
+ * function that has to order nodes together with a context. This lets
+ * the owner of the tree reach its own state from the comparison without
+ * any global or thread-local indirection.</p>
+ * <p>An augmented tree additionally calls augment whenever the children of
+ * a node have changed, children before their parents, so that the node can
+ * recompute whatever it keeps about its subtree.</p>
+ * <p>Built with <i>CORAL_COUNTERS</i> the tree counts the nodes its searches
+ * visit and the rotations rebalancing it, along with what the container
+ * owning it counts.</p>
+ */
+struct coral_red_black_tree {
+    uintmax_t count;
+    struct coral_red_black_tree_node *root;
+    void (*augment)(const struct coral_red_black_tree *object,
+                    struct coral_red_black_tree_node *node);
+#ifdef CORAL_COUNTERS
+    struct coral_atomic_counters counters;
+#endif
+};
+
+/**
+ * @brief Initialize node.
+ * @param [in] node instance to be initialized.
+ * @return On success <i>0</i>, otherwise an error code.
+ * @throws CORAL_RED_BLACK_TREE_ERROR_NODE_IS_NULL if node is <i>NULL</i>.
+ */
+int coral_red_black_tree_node_init(struct coral_red_black_tree_node *node);
+
+/**
+ * @brief Initialize red black tree.
+ * @param [in] object instance to be initialized.
+ * @return On success <i>0</i>, otherwise an error code.
+ * @throws CORAL_RED_BLACK_TREE_ERROR_OBJECT_IS_NULL if object is
+ * <i>NULL</i>.
+ */
+int coral_red_black_tree_init(struct coral_red_black_tree *object);
+
+/**
+ * @brief Initialize augmented red black tree.
+ * <p>Use <i>rock_container_of</i> from within augment to get from the tree
+ * to the structure embedding it.</p>
+ * @param [in] object instance to be initialized.
+ * @param [in] augment called with a node after its children have changed,
+ * the children of the node are up to date by then.
+ * @return On success <i>0</i>, otherwise an error code.
+ * @throws CORAL_RED_BLACK_TREE_ERROR_OBJECT_IS_NULL if object is
+ * <i>NULL</i>.
+ * @throws CORAL_RED_BLACK_TREE_ERROR_AUGMENT_IS_NULL if augment is
+ * <i>NULL</i>.
+ */
+int coral_red_black_tree_init_augmented(
+        struct coral_red_black_tree *object,
+        void (*augment)(const struct coral_red_black_tree *object,
+                        struct coral_red_black_tree_node *node));
+
+/**
+ * @brief Invalidate red black tree.
+ * <p>If given, on_destroy is called for every node in post-order, that is
+ * children before their parent, without rebalancing the tree. Hence the
+ * whole tree is torn down in <i>O(n)</i> and each node may be released as
+ * soon as on_destroy receives it.</p>
+ * @param [in] object instance to be invalidated.
+ * @param [in] on_destroy called with each node and the context, may be
+ * <i>NULL</i> if the nodes need not be visited.
+ * @param [in] context passed through to on_destroy.
+ * @return On success <i>0</i>, otherwise an error code.
+ * @throws CORAL_RED_BLACK_TREE_ERROR_OBJECT_IS_NULL if object is
+ * <i>NULL</i>.
+ */
+int coral_red_black_tree_invalidate(
+        struct coral_red_black_tree *object,
+        void (*on_destroy)(struct coral_red_black_tree_node *node,
+                           void *context),
+        void *context);
+
+/**
+ * @brief Find node matching key.
+ * @param [in] object red black tree instance.
+ * @param [in] key to look for.
+ * @param [in] compare comparison which must return an integer less than,
+ * equal to, or greater than zero if the <u>key</u> is considered to be
+ * respectively less than, equal to, or greater than the <u>node</u>.
+ * @param [in] context passed through to compare.
+ * @param [out] out receive the matching node or, if there is none, the
+ * last node visited which is <i>NULL</i> for an empty tree.
+ * @return On success <i>0</i>, otherwise an error code.
+ * @throws CORAL_RED_BLACK_TREE_ERROR_OBJECT_IS_NULL if object is
+ * <i>NULL</i>.
+ * @throws CORAL_RED_BLACK_TREE_ERROR_COMPARE_IS_NULL if compare is
+ * <i>NULL</i>.
+ * @throws CORAL_RED_BLACK_TREE_ERROR_OUT_IS_NULL if out is <i>NULL</i>.
+ * @throws CORAL_RED_BLACK_TREE_ERROR_NODE_NOT_FOUND if there is no node
+ * matching key.
+ */
+int coral_red_black_tree_find(
+        const struct coral_red_black_tree *object,
+        const void *key,
+        int (*compare)(const void *key,
+                       const struct coral_red_black_tree_node *node,
+                       void *context),
+        void *context,
+        struct coral_red_black_tree_node **out);
+
+/**
+ * @brief Insert node.
+ * @param [in] object red black tree instance.
+ * @param [in] key of the node as seen by compare.
+ * @param [in] node to insert.
+ * @param [in] compare comparison which must return an integer less than,
+ * equal to, or greater than zero if the <u>key</u> is considered to be
+ * respectively less than, equal to, or greater than the <u>node</u>.
+ * @param [in] context passed through to compare.
+ * @return On success <i>0</i>, otherwise an error code.
+ * @throws CORAL_RED_BLACK_TREE_ERROR_OBJECT_IS_NULL if object is
+ * <i>NULL</i>.
+ * @throws CORAL_RED_BLACK_TREE_ERROR_NODE_IS_NULL if node is <i>NULL</i>.
+ * @throws CORAL_RED_BLACK_TREE_ERROR_COMPARE_IS_NULL if compare is
+ * <i>NULL</i>.
+ * @throws CORAL_RED_BLACK_TREE_ERROR_NODE_ALREADY_EXISTS if a node matching
+ * key is already present.
+ */
+int coral_red_black_tree_insert(
+        struct coral_red_black_tree *object,
+        const void *key,
+        struct coral_red_black_tree_node *node,
+        int (*compare)(const void *key,
+                       const struct coral_red_black_tree_node *node,
+                       void *context),
+        void *context);
+
+/**
+ * @brief Attach node at a position found by the caller.
+ * <p>This lets callers descend the tree with their own, possibly inlined,
+ * comparison instead of going through a function pointer for every node
+ * visited. The node is linked in as a red leaf and the tree rebalanced.</p>
+ * @param [in] object red black tree instance.
+ * @param [in] parent of the node, <i>NULL</i> if the tree is empty.
+ * @param [in] link empty child slot of parent, or the root of the tree if
+ * parent is <i>NULL</i>, that is to receive the node.
+ * @param [in] node to attach.
+ * @return On success <i>0</i>, otherwise an error code.
+ * @throws CORAL_RED_BLACK_TREE_ERROR_OBJECT_IS_NULL if object is
+ * <i>NULL</i>.
+ * @throws CORAL_RED_BLACK_TREE_ERROR_LINK_IS_NULL if link is <i>NULL</i>.
+ * @throws CORAL_RED_BLACK_TREE_ERROR_NODE_IS_NULL if node is <i>NULL</i>.
+ */
+int coral_red_black_tree_attach(struct coral_red_black_tree *object,
+                                struct coral_red_black_tree_node *parent,
+                                struct coral_red_black_tree_node **link,
+                                struct coral_red_black_tree_node *node);
+
+/**
+ * @brief Build a balanced tree out of nodes given in sorted order.
+ * <p>The nodes are linked together in linear time without any comparison,
+ * it is up to the caller to hand them over in strictly ascending
+ * order.</p>
+ * @param [in] object red black tree instance which must be empty.
+ * @param [in] count of nodes.
+ * @param [in] node_at retrieve the node at index, each index from
+ * <i>0</i> to <i>count - 1</i> is asked for exactly once.
+ * @param [in] context passed through to node_at.
+ * @return On success <i>0</i>, otherwise an error code.
+ * @throws CORAL_RED_BLACK_TREE_ERROR_OBJECT_IS_NULL if object is
+ * <i>NULL</i>.
+ * @throws CORAL_RED_BLACK_TREE_ERROR_NODE_AT_IS_NULL if node_at is
+ * <i>NULL</i>.
+ * @throws CORAL_RED_BLACK_TREE_ERROR_TREE_IS_NOT_EMPTY if tree is not
+ * empty.
+ */
+int coral_red_black_tree_build(
+        struct coral_red_black_tree *object,
+        uintmax_t count,
+        struct coral_red_black_tree_node *(*node_at)(uintmax_t index,
+                                                      void *context),
+        void *context);
+
+/**
+ * @brief Remove node.
+ * @param [in] object red black tree instance.
+ * @param [in] node to remove which must be present in the tree.
+ * @return On success <i>0</i>, otherwise an error code.
+ * @throws CORAL_RED_BLACK_TREE_ERROR_OBJECT_IS_NULL if object is
+ * <i>NULL</i>.
+ * @throws CORAL_RED_BLACK_TREE_ERROR_NODE_IS_NULL if node is <i>NULL</i>.
+ */
+int coral_red_black_tree_remove(struct coral_red_black_tree *object,
+                                struct coral_red_black_tree_node *node);
+
+/**
+ * @brief Remove the nodes from first up to and including last.
+ * <p>The nodes are cut out by splitting the tree around the range and
+ * joining what remains. The tree is therefore restructured in
+ * <i>O(log n)</i> however many nodes are removed. Neither bound need match
+ * a node.</p>
+ * @param [in] object red black tree instance.
+ * @param [in] first key of the range.
+ * @param [in] last key of the range.
+ * @param [in] compare comparison which must return an integer less than,
+ * equal to, or greater than zero if the <u>key</u> is considered to be
+ * respectively less than, equal to, or greater than the <u>node</u>.
+ * @param [in] context passed through to compare.
+ * @param [out] out receive the removed nodes as a red black tree of their
+ * own, sharing the augment of object.
+ * @return On success <i>0</i>, otherwise an error code.
+ * @throws CORAL_RED_BLACK_TREE_ERROR_OBJECT_IS_NULL if object is
+ * <i>NULL</i>.
+ * @throws CORAL_RED_BLACK_TREE_ERROR_COMPARE_IS_NULL if compare is
+ * <i>NULL</i>.
+ * @throws CORAL_RED_BLACK_TREE_ERROR_OUT_IS_NULL if out is <i>NULL</i>.
+ */
+int coral_red_black_tree_remove_range(
+        struct coral_red_black_tree *object,
+        const void *first,
+        const void *last,
+        int (*compare)(const void *key,
+                       const struct coral_red_black_tree_node *node,
+                       void *context),
+        void *context,
+        struct coral_red_black_tree *out);
+
+/**
+ * @brief Move the nodes that are not less than key to a tree of their own.
+ * <p>The tree is split along the path to key in <i>O(log n)</i>, no node is
+ * visited outside of that path.</p>
+ * @param [in] object red black tree instance keeping the nodes less than
+ * key.
+ * @param [in] key at which to split.
+ * @param [in] compare comparison which must return an integer less than,
+ * equal to, or greater than zero if the <u>key</u> is considered to be
+ * respectively less than, equal to, or greater than the <u>node</u>.
+ * @param [in] context passed through to compare.
+ * @param [out] out receive the remaining nodes as a red black tree of their
+ * own, sharing the augment of object.
+ * @return On success <i>0</i>, otherwise an error code.
+ * @throws CORAL_RED_BLACK_TREE_ERROR_OBJECT_IS_NULL if object is
+ * <i>NULL</i>.
+ * @throws CORAL_RED_BLACK_TREE_ERROR_COMPARE_IS_NULL if compare is
+ * <i>NULL</i>.
+ * @throws CORAL_RED_BLACK_TREE_ERROR_OUT_IS_NULL if out is <i>NULL</i>.
+ */
+int coral_red_black_tree_split(
+        struct coral_red_black_tree *object,
+        const void *key,
+        int (*compare)(const void *key,
+                       const struct coral_red_black_tree_node *node,
+                       void *context),
+        void *context,
+        struct coral_red_black_tree *out);
+
+/**
+ * @brief Move all nodes of other after the nodes of object.
+ * <p>Every node of other must be ordered after every node of object, which
+ * is not checked. The trees are joined where their black heights match in
+ * <i>O(log n)</i> and other is left empty.</p>
+ * @param [in] object red black tree instance.
+ * @param [in] other red black tree instance whose nodes are moved.
+ * @return On success <i>0</i>, otherwise an error code.
+ * @throws CORAL_RED_BLACK_TREE_ERROR_OBJECT_IS_NULL if object or other is
+ * <i>NULL</i>.
+ */
+int coral_red_black_tree_join(struct coral_red_black_tree *object,
+                              struct coral_red_black_tree *other);
+
+/**
+ * @brief Retrieve first node.
+ * @param [in] object red black tree instance.
+ * @param [out] out receive first node.
+ * @return On success <i>0</i>, otherwise an error code.
+ * @throws CORAL_RED_BLACK_TREE_ERROR_OBJECT_IS_NULL if object is
+ * <i>NULL</i>.
+ * @throws CORAL_RED_BLACK_TREE_ERROR_OUT_IS_NULL if out is <i>NULL</i>.
+ * @throws CORAL_RED_BLACK_TREE_ERROR_TREE_IS_EMPTY if tree is empty.
+ */
+int coral_red_black_tree_first(const struct coral_red_black_tree *object,
+                               struct coral_red_black_tree_node **out);
+
+/**
+ * @brief Retrieve last node.
+ * @param [in] object red black tree instance.
+ * @param [out] out receive last node.
+ * @return On success <i>0</i>, otherwise an error code.
+ * @throws CORAL_RED_BLACK_TREE_ERROR_OBJECT_IS_NULL if object is
+ * <i>NULL</i>.
+ * @throws CORAL_RED_BLACK_TREE_ERROR_OUT_IS_NULL if out is <i>NULL</i>.
+ * @throws CORAL_RED_BLACK_TREE_ERROR_TREE_IS_EMPTY if tree is empty.
+ */
+int coral_red_black_tree_last(const struct coral_red_black_tree *object,
+                              struct coral_red_black_tree_node **out);
+
+/**
+ * @brief Retrieve the next node.
+ * @param [in] node current node.
+ * @param [out] out receive the next node.
+ * @return On success <i>0</i>, otherwise an error code.
+ * @throws CORAL_RED_BLACK_TREE_ERROR_NODE_IS_NULL if node is <i>NULL</i>.
+ * @throws CORAL_RED_BLACK_TREE_ERROR_OUT_IS_NULL if out is <i>NULL</i>.
+ * @throws CORAL_RED_BLACK_TREE_ERROR_END_OF_SEQUENCE if there is no next
+ * node.
+ */
+int coral_red_black_tree_next(const struct coral_red_black_tree_node *node,
+                              struct coral_red_black_tree_node **out);
+
+/**
+ * @brief Retrieve the previous node.
+ * @param [in] node current node.
+ * @param [out] out receive the previous node.
+ * @return On success <i>0</i>, otherwise an error code.
+ * @throws CORAL_RED_BLACK_TREE_ERROR_NODE_IS_NULL if node is <i>NULL</i>.
+ * @throws CORAL_RED_BLACK_TREE_ERROR_OUT_IS_NULL if out is <i>NULL</i>.
+ * @throws CORAL_RED_BLACK_TREE_ERROR_END_OF_SEQUENCE if there is no
+ * previous node.
+ */
+int coral_red_black_tree_prev(const struct coral_red_black_tree_node *node,
+                              struct coral_red_black_tree_node **out);
+
+/**
+ * @brief Retrieve the rank of node.
+ * @param [in] node present in a tree.
+ * @param [out] out receive the number of nodes ordered before node.
+ * @return On success <i>0</i>, otherwise an error code.
+ * @throws CORAL_RED_BLACK_TREE_ERROR_NODE_IS_NULL if node is <i>NULL</i>.
+ * @throws CORAL_RED_BLACK_TREE_ERROR_OUT_IS_NULL if out is <i>NULL</i>.
+ */
+int coral_red_black_tree_rank(const struct coral_red_black_tree_node *node,
+                              uintmax_t *out);
+
+/**
+ * @brief Retrieve the node at index in order.
+ * @param [in] object red black tree instance.
+ * @param [in] index of node, the first node is at <i>0</i>.
+ * @param [out] out receive the node.
+ * @return On success <i>0</i>, otherwise an error code.
+ * @throws CORAL_RED_BLACK_TREE_ERROR_OBJECT_IS_NULL if object is
+ * <i>NULL</i>.
+ * @throws CORAL_RED_BLACK_TREE_ERROR_OUT_IS_NULL if out is <i>NULL</i>.
+ * @throws CORAL_RED_BLACK_TREE_ERROR_INDEX_IS_OUT_OF_BOUNDS if index is not
+ * less than the number of nodes.
+ */
+int coral_red_black_tree_select(const struct coral_red_black_tree *object,
+                                uintmax_t index,
+                                struct coral_red_black_tree_node **out);
+
+/**
+ * @brief Count the nodes ordered before key.
+ * @param [in] object red black tree instance.
+ * @param [in] key to count the nodes before.
+ * @param [in] compare comparison which must return an integer less than,
+ * equal to, or greater than zero if the <u>key</u> is considered to be
+ * respectively less than, equal to, or greater than the <u>node</u>.
+ * @param [in] context passed through to compare.
+ * @param [out] out receive the number of nodes less than key, also when
+ * there is no node matching key.
+ * @return On success <i>0</i>, otherwise an error code.
+ * @throws CORAL_RED_BLACK_TREE_ERROR_OBJECT_IS_NULL if object is
+ * <i>NULL</i>.
+ * @throws CORAL_RED_BLACK_TREE_ERROR_COMPARE_IS_NULL if compare is
+ * <i>NULL</i>.
+ * @throws CORAL_RED_BLACK_TREE_ERROR_OUT_IS_NULL if out is <i>NULL</i>.
+ * @throws CORAL_RED_BLACK_TREE_ERROR_NODE_NOT_FOUND if there is no node
+ * matching key.
+ */
+int coral_red_black_tree_count_before(
+        const struct coral_red_black_tree *object,
+        const void *key,
+        int (*compare)(const void *key,
+                       const struct coral_red_black_tree_node *node,
+                       void *context),
+        void *context,
+        uintmax_t *out);
+
+/**
+ * @brief Call augment for node and each of its ancestors.
+ * <p>Needed only after something that augment depends on has changed in
+ * node outside of the tree, such as the value it summarizes. Does nothing
+ * if the tree is not augmented.</p>
+ * @param [in] object red black tree instance.
+ * @param [in] node present in the tree.
+ * @return On success <i>0</i>, otherwise an error code.
+ * @throws CORAL_RED_BLACK_TREE_ERROR_OBJECT_IS_NULL if object is
+ * <i>NULL</i>.
+ * @throws CORAL_RED_BLACK_TREE_ERROR_NODE_IS_NULL if node is <i>NULL</i>.
+ */
+int coral_red_black_tree_propagate(const struct coral_red_black_tree *object,
+                                   struct coral_red_black_tree_node *node);
+
+#endif /* _CORAL_RED_BLACK_TREE_H_ */
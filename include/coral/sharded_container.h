@@ -0,0 +1,234 @@
+#ifndef _CORAL_SHARDED_CONTAINER_H_
+#define _CORAL_SHARDED_CONTAINER_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <pthread.h>
+#include <sea-urchin.h>
+#include <coral/red_black_tree_container.h>
+
+#define CORAL_SHARDED_CONTAINER_ERROR_OUT_IS_NULL \
+    CORAL_RED_BLACK_TREE_CONTAINER_ERROR_OUT_IS_NULL
+#define CORAL_SHARDED_CONTAINER_ERROR_MEMORY_ALLOCATION_FAILED \
+    CORAL_RED_BLACK_TREE_CONTAINER_ERROR_MEMORY_ALLOCATION_FAILED
+#define CORAL_SHARDED_CONTAINER_ERROR_ENTRY_IS_NULL \
+    CORAL_RED_BLACK_TREE_CONTAINER_ERROR_ENTRY_IS_NULL
+#define CORAL_SHARDED_CONTAINER_ERROR_OBJECT_IS_NULL \
+    CORAL_RED_BLACK_TREE_CONTAINER_ERROR_OBJECT_IS_NULL
+#define CORAL_SHARDED_CONTAINER_ERROR_COMPARE_IS_NULL \
+    CORAL_RED_BLACK_TREE_CONTAINER_ERROR_COMPARE_IS_NULL
+#define CORAL_SHARDED_CONTAINER_ERROR_ENTRY_ALREADY_EXISTS \
+    CORAL_RED_BLACK_TREE_CONTAINER_ERROR_ENTRY_ALREADY_EXISTS
+#define CORAL_SHARDED_CONTAINER_ERROR_KEY_IS_NULL \
+    CORAL_RED_BLACK_TREE_CONTAINER_ERROR_KEY_IS_NULL
+#define CORAL_SHARDED_CONTAINER_ERROR_ENTRY_NOT_FOUND \
+    CORAL_RED_BLACK_TREE_CONTAINER_ERROR_ENTRY_NOT_FOUND
+#define CORAL_SHARDED_CONTAINER_ERROR_HASH_IS_NULL \
+    SEA_URCHIN_ERROR_VALUE_IS_NULL
+#define CORAL_SHARDED_CONTAINER_ERROR_SHARDS_IS_ZERO \
+    SEA_URCHIN_ERROR_VALUE_IS_ZERO
+#define CORAL_SHARDED_CONTAINER_ERROR_BOUNDS_IS_NULL \
+    SEA_URCHIN_ERROR_VALUE_IS_NULL
+#define CORAL_SHARDED_CONTAINER_ERROR_BOUNDS_ARE_NOT_SORTED \
+    SEA_URCHIN_ERROR_VALUE_IS_INVALID
+#define CORAL_SHARDED_CONTAINER_ERROR_FUNCTION_IS_NULL \
+    SEA_URCHIN_ERROR_VALUE_IS_NULL
+
+/**
+ * @brief Red black tree container behind a lock of its own.
+ * <p>Each shard starts on a cache line of its own so that threads working
+ * on different shards never write to the same cache line.</p>
+ */
+struct coral_sharded_container_shard {
+    _Alignas(64) pthread_mutex_t mutex;
+    struct coral_red_black_tree_container container;
+};
+
+/**
+ * @brief Sorted container split across red black tree containers, the
+ * shards, which may be used from many threads.
+ * <p>Every entry belongs to exactly one shard, picked either from the hash
+ * of the entry or from the range of keys the entry falls in. Threads only
+ * wait on each other when they work on the same shard.</p>
+ * <p>Entries are those of the red black tree container and are allocated
+ * and freed with its functions. An entry handed out by a lookup stays valid
+ * until some thread removes and frees it, it is up to the caller to not free
+ * entries that other threads may still be looking at.</p>
+ */
+struct coral_sharded_container {
+    struct coral_sharded_container_shard *shards;
+    size_t count;
+    int (*compare)(const void *, const void *);
+    size_t (*hash)(const void *);
+    const void *const *bounds;
+};
+
+/**
+ * @brief Initialize sharded container that picks shards by hash.
+ * <p>Entries are spread evenly across the shards whatever order they come
+ * in, iterating over them in order has to merge every shard.</p>
+ * @param [in] object instance to be initialized.
+ * @param [in] shards number of shards.
+ * @param [in] hash function which must return the same hash for entries that
+ * compare equal.
+ * @param [in] compare comparison which must return an integer less than, equal
+ * to, or greater than zero if the <u>first key</u> is considered to be
+ * respectively less than, equal to, or greater than the <u>second key</u>.
+ * @return On success <i>0</i>, otherwise an error code.
+ * @throws CORAL_SHARDED_CONTAINER_ERROR_OBJECT_IS_NULL if object is
+ * <i>NULL</i>.
+ * @throws CORAL_SHARDED_CONTAINER_ERROR_SHARDS_IS_ZERO if shards is zero.
+ * @throws CORAL_SHARDED_CONTAINER_ERROR_HASH_IS_NULL if hash is <i>NULL</i>.
+ * @throws CORAL_SHARDED_CONTAINER_ERROR_COMPARE_IS_NULL if compare is
+ * <i>NULL</i>.
+ * @throws CORAL_SHARDED_CONTAINER_ERROR_MEMORY_ALLOCATION_FAILED if there is
+ * not enough memory for the shards.
+ */
+int coral_sharded_container_init_with_hash(
+        struct coral_sharded_container *object,
+        size_t shards,
+        size_t (*hash)(const void *entry),
+        int (*compare)(const void *first,
+                       const void *second));
+
+/**
+ * @brief Initialize sharded container that picks shards by key range.
+ * <p>The bounds split the keys into one more shard than there are bounds.
+ * The first shard holds the entries before the first bound and shard
+ * <i>i</i> those from bound <i>i - 1</i> up to bound <i>i</i>. Keys that
+ * arrive in order then pile up in one shard at a time.</p>
+ * @param [in] object instance to be initialized.
+ * @param [in] bounds sorted keys at which a shard starts, which must stay
+ * valid until the container is invalidated.
+ * @param [in] count number of bounds.
+ * @param [in] compare comparison which must return an integer less than, equal
+ * to, or greater than zero if the <u>first key</u> is considered to be
+ * respectively less than, equal to, or greater than the <u>second key</u>.
+ * @return On success <i>0</i>, otherwise an error code.
+ * @throws CORAL_SHARDED_CONTAINER_ERROR_OBJECT_IS_NULL if object is
+ * <i>NULL</i>.
+ * @throws CORAL_SHARDED_CONTAINER_ERROR_BOUNDS_IS_NULL if bounds is
+ * <i>NULL</i> while count is not zero.
+ * @throws CORAL_SHARDED_CONTAINER_ERROR_COMPARE_IS_NULL if compare is
+ * <i>NULL</i>.
+ * @throws CORAL_SHARDED_CONTAINER_ERROR_BOUNDS_ARE_NOT_SORTED if a bound is
+ * not greater than the one before it.
+ * @throws CORAL_SHARDED_CONTAINER_ERROR_MEMORY_ALLOCATION_FAILED if there is
+ * not enough memory for the shards.
+ */
+int coral_sharded_container_init_with_bounds(
+        struct coral_sharded_container *object,
+        const void *const *bounds,
+        size_t count,
+        int (*compare)(const void *first,
+                       const void *second));
+
+/**
+ * @brief Invalidate sharded container.
+ * <p>The entries in the container are destroyed and each entry will have the
+ * provided <i>on destroy</i> callback invoked upon itself. The actual
+ * <u>container instance is not deallocated</u> since it may have been embedded
+ * in a larger structure.</p>
+ * <p>No other thread may be using the container.</p>
+ * @param [in] object instance to be invalidated.
+ * @param [in] on_destroy called just before the entry is to be destroyed.
+ * @return On success <i>0</i>, otherwise an error code.
+ * @throws CORAL_SHARDED_CONTAINER_ERROR_OBJECT_IS_NULL if object is
+ * <i>NULL</i>.
+ */
+int coral_sharded_container_invalidate(
+        struct coral_sharded_container *object,
+        void (*on_destroy)(struct coral_red_black_tree_container_entry *entry));
+
+/**
+ * @brief Retrieve the count of entries.
+ * <p>Shards are counted one after the other so entries added or removed
+ * meanwhile may or may not be counted.</p>
+ * @param [in] object instance whose count we are to retrieve.
+ * @param [out] out receive the entry count.
+ * @return On success <i>0</i>, otherwise an error code.
+ * @throws CORAL_SHARDED_CONTAINER_ERROR_OBJECT_IS_NULL if object is
+ * <i>NULL</i>.
+ * @throws CORAL_SHARDED_CONTAINER_ERROR_OUT_IS_NULL if out is <i>NULL</i>.
+ */
+int coral_sharded_container_count(
+        const struct coral_sharded_container *object,
+        uintmax_t *out);
+
+/**
+ * @brief Add entry.
+ * @param [in] object container instance.
+ * @param [in] entry to add.
+ * @return On success <i>0</i>, otherwise an error code.
+ * @throws CORAL_SHARDED_CONTAINER_ERROR_OBJECT_IS_NULL if object is
+ * <i>NULL</i>.
+ * @throws CORAL_SHARDED_CONTAINER_ERROR_ENTRY_IS_NULL if entry is
+ * <i>NULL</i>.
+ * @throws CORAL_SHARDED_CONTAINER_ERROR_ENTRY_ALREADY_EXISTS if entry is
+ * already present in container.
+ */
+int coral_sharded_container_add(
+        struct coral_sharded_container *object,
+        const struct coral_red_black_tree_container_entry *entry);
+
+/**
+ * @brief Remove entry.
+ * @param [in] object container instance.
+ * @param [in] entry to remove.
+ * @return On success <i>0</i>, otherwise an error code.
+ * @throws CORAL_SHARDED_CONTAINER_ERROR_OBJECT_IS_NULL if object is
+ * <i>NULL</i>.
+ * @throws CORAL_SHARDED_CONTAINER_ERROR_ENTRY_IS_NULL if entry is
+ * <i>NULL</i>.
+ * @throws CORAL_SHARDED_CONTAINER_ERROR_ENTRY_NOT_FOUND if entry is not
+ * present in container.
+ */
+int coral_sharded_container_remove(
+        struct coral_sharded_container *object,
+        const struct coral_red_black_tree_container_entry *entry);
+
+/**
+ * @brief Retrieve entry for key.
+ * @param [in] object container instance.
+ * @param [in] key on which to find entry.
+ * @param [out] out receive matching entry.
+ * @return On success <i>0</i>, otherwise an error code.
+ * @throws CORAL_SHARDED_CONTAINER_ERROR_OBJECT_IS_NULL if object is
+ * <i>NULL</i>.
+ * @throws CORAL_SHARDED_CONTAINER_ERROR_KEY_IS_NULL if key is <i>NULL</i>.
+ * @throws CORAL_SHARDED_CONTAINER_ERROR_OUT_IS_NULL if out is <i>NULL</i>.
+ * @throws CORAL_SHARDED_CONTAINER_ERROR_ENTRY_NOT_FOUND if matching entry was
+ * not found.
+ */
+int coral_sharded_container_get(
+        const struct coral_sharded_container *object,
+        const void *key,
+        struct coral_red_black_tree_container_entry **out);
+
+/**
+ * @brief Run function with every entry in order.
+ * <p>The shards are merged with a heap holding the smallest entry of each
+ * shard not yet visited. Every shard stays locked until the last entry has
+ * been visited, so no entry can be added or removed meanwhile.</p>
+ * <p>Function must not call back into this container, returning anything
+ * but <i>0</i> stops the iteration.</p>
+ * @param [in] object container instance.
+ * @param [in] function to run with each entry.
+ * @param [in] context passed on to function.
+ * @return On success <i>0</i> or the value returned by function that stopped
+ * the iteration, otherwise an error code.
+ * @throws CORAL_SHARDED_CONTAINER_ERROR_OBJECT_IS_NULL if object is
+ * <i>NULL</i>.
+ * @throws CORAL_SHARDED_CONTAINER_ERROR_FUNCTION_IS_NULL if function is
+ * <i>NULL</i>.
+ * @throws CORAL_SHARDED_CONTAINER_ERROR_MEMORY_ALLOCATION_FAILED if there is
+ * not enough memory for the heap.
+ */
+int coral_sharded_container_for_each(
+        const struct coral_sharded_container *object,
+        int (*function)(struct coral_red_black_tree_container_entry *entry,
+                        void *context),
+        void *context);
+
+#endif /* _CORAL_SHARDED_CONTAINER_H_ */
@@ -0,0 +1,317 @@
+#ifndef _CORAL_TYPED_RED_BLACK_TREE_CONTAINER_H_
+#define _CORAL_TYPED_RED_BLACK_TREE_CONTAINER_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <sea-urchin.h>
+#include <rock.h>
+#include <coral/allocator.h>
+#include <coral/red_black_tree.h>
+#include <coral/red_black_tree_container.h>
+
+/**
+ * @brief Three-way comparison of arithmetic values through pointers.
+ * <p>Suitable as the <u>compare</u> argument of
+ * <i>CORAL_TYPED_RED_BLACK_TREE_CONTAINER_DECLARE</i> for integer and
+ * floating point types.</p>
+ */
+#define CORAL_TYPED_RED_BLACK_TREE_CONTAINER_COMPARE(a, b) \
+    ((*(a) > *(b)) - (*(a) < *(b)))
+
+/**
+ * @brief Declare a red black tree container of values of a single type.
+ * <p>Unlike <i>coral_red_black_tree_container</i>, which orders entries
+ * through a function pointer, the comparison is expanded into the
+ * generated find, add and remove functions so that the compiler can
+ * inline it. Values are copied into entries obtained from the default
+ * allocator.</p>
+ * <p>The following are declared, all functions are <i>static inline</i>
+ * and return <i>0</i> on success or an error code otherwise:</p>
+ * <ul>
+ * <li><i>struct name</i> the container.</li>
+ * <li><i>name_init(object)</i> initialize the container.</li>
+ * <li><i>name_invalidate(object, on_destroy)</i> free all the entries,
+ * calling <u>on_destroy</u>, if not <i>NULL</i>, with each value
+ * first.</li>
+ * <li><i>name_count(object, out)</i> retrieve the number of values.</li>
+ * <li><i>name_add(object, value)</i> copy value into the container.</li>
+ * <li><i>name_remove(object, key)</i> remove the value matching key.</li>
+ * <li><i>name_contains(object, key, out)</i> check for a value matching
+ * key.</li>
+ * <li><i>name_get(object, key, out)</i> retrieve the value matching
+ * key.</li>
+ * <li><i>name_first(object, out)</i> and <i>name_last(object, out)</i>
+ * retrieve the smallest and largest value.</li>
+ * <li><i>name_next(value, out)</i> and <i>name_prev(value, out)</i>
+ * retrieve the neighbours of a value retrieved from the container.</li>
+ * </ul>
+ * <p>Errors are reported with the
+ * <i>CORAL_RED_BLACK_TREE_CONTAINER_ERROR_</i> codes, a <i>NULL</i> value
+ * is reported as <i>ENTRY_IS_NULL</i>.</p>
+ * @param name prefix of the generated structure and functions.
+ * @param type of the values held by the container.
+ * @param compare function or function-like macro receiving two
+ * <i>const type *</i> which must return an integer less than, equal to, or
+ * greater than zero if the first value is considered to be respectively
+ * less than, equal to, or greater than the second.
+ */
+#define CORAL_TYPED_RED_BLACK_TREE_CONTAINER_DECLARE(name, type, compare) \
+    struct name##_entry { \
+        struct coral_red_black_tree_node node; \
+        const struct coral_allocator *allocator; \
+        type data; \
+    }; \
+    \
+    struct name { \
+        struct coral_red_black_tree tree; \
+    }; \
+    \
+    static inline struct name##_entry *name##_entry_of( \
+            const struct coral_red_black_tree_node *const node) { \
+        return rock_container_of(node, struct name##_entry, node); \
+    } \
+    \
+    static inline struct coral_red_black_tree_node *name##_find( \
+            const struct name *const object, \
+            const type *const key, \
+            struct coral_red_black_tree_node **const parent, \
+            struct coral_red_black_tree_node ***const link) { \
+        struct coral_red_black_tree_node *last = NULL; \
+        struct coral_red_black_tree_node *const *at = &object->tree.root; \
+        while (*at) { \
+            last = *at; \
+            const int result = compare(key, &name##_entry_of(last)->data); \
+            if (!result) { \
+                return last; \
+            } \
+            at = result < 0 ? &last->left : &last->right; \
+        } \
+        *parent = last; \
+        *link = (struct coral_red_black_tree_node **) at; \
+        return NULL; \
+    } \
+    \
+    static inline int name##_init(struct name *const object) { \
+        if (!object) { \
+            return CORAL_RED_BLACK_TREE_CONTAINER_ERROR_OBJECT_IS_NULL; \
+        } \
+        return coral_red_black_tree_init(&object->tree); \
+    } \
+    \
+    static inline int name##_invalidate( \
+            struct name *const object, \
+            void (*const on_destroy)(type *)) { \
+        if (!object) { \
+            return CORAL_RED_BLACK_TREE_CONTAINER_ERROR_OBJECT_IS_NULL; \
+        } \
+        /* post-order walk, the tree is dropped so there is no rebalancing */ \
+        struct coral_red_black_tree_node *node = object->tree.root; \
+        while (node) { \
+            if (node->left) { \
+                node = node->left; \
+                continue; \
+            } \
+            if (node->right) { \
+                node = node->right; \
+                continue; \
+            } \
+            struct coral_red_black_tree_node *const parent = node->parent; \
+            if (parent) { \
+                *(parent->left == node ? &parent->left : &parent->right) \
+                        = NULL; \
+            } \
+            struct name##_entry *const entry = name##_entry_of(node); \
+            if (on_destroy) { \
+                on_destroy(&entry->data); \
+            } \
+            entry->allocator->free(entry->allocator->context, entry); \
+            node = parent; \
+        } \
+        return coral_red_black_tree_invalidate(&object->tree, NULL, NULL); \
+    } \
+    \
+    static inline int name##_count(const struct name *const object, \
+                                   uintmax_t *const out) { \
+        if (!object) { \
+            return CORAL_RED_BLACK_TREE_CONTAINER_ERROR_OBJECT_IS_NULL; \
+        } \
+        if (!out) { \
+            return CORAL_RED_BLACK_TREE_CONTAINER_ERROR_OUT_IS_NULL; \
+        } \
+        *out = object->tree.count; \
+        return 0; \
+    } \
+    \
+    static inline int name##_add(struct name *const object, \
+                                 const type *const value) { \
+        if (!object) { \
+            return CORAL_RED_BLACK_TREE_CONTAINER_ERROR_OBJECT_IS_NULL; \
+        } \
+        if (!value) { \
+            return CORAL_RED_BLACK_TREE_CONTAINER_ERROR_ENTRY_IS_NULL; \
+        } \
+        struct coral_red_black_tree_node *parent; \
+        struct coral_red_black_tree_node **link; \
+        if (name##_find(object, value, &parent, &link)) { \
+            return CORAL_RED_BLACK_TREE_CONTAINER_ERROR_ENTRY_ALREADY_EXISTS; \
+        } \
+        const struct coral_allocator *allocator; \
+        int error; \
+        if ((error = coral_allocator_get_default(&allocator))) { \
+            return error; \
+        } \
+        const size_t alignment = _Alignof(struct name##_entry) \
+                                 > sizeof(void *) \
+                                 ? _Alignof(struct name##_entry) \
+                                 : sizeof(void *); \
+        struct name##_entry *entry; \
+        if (allocator->alloc(allocator->context, alignment, \
+                             sizeof(*entry), (void **) &entry)) { \
+            return \
+                CORAL_RED_BLACK_TREE_CONTAINER_ERROR_MEMORY_ALLOCATION_FAILED; \
+        } \
+        entry->allocator = allocator; \
+        entry->data = *value; \
+        return coral_red_black_tree_attach(&object->tree, parent, link, \
+                                           &entry->node); \
+    } \
+    \
+    static inline int name##_remove(struct name *const object, \
+                                    const type *const key) { \
+        if (!object) { \
+            return CORAL_RED_BLACK_TREE_CONTAINER_ERROR_OBJECT_IS_NULL; \
+        } \
+        if (!key) { \
+            return CORAL_RED_BLACK_TREE_CONTAINER_ERROR_KEY_IS_NULL; \
+        } \
+        struct coral_red_black_tree_node *parent; \
+        struct coral_red_black_tree_node **link; \
+        struct coral_red_black_tree_node *const node \
+                = name##_find(object, key, &parent, &link); \
+        if (!node) { \
+            return CORAL_RED_BLACK_TREE_CONTAINER_ERROR_ENTRY_NOT_FOUND; \
+        } \
+        int error; \
+        if ((error = coral_red_black_tree_remove(&object->tree, node))) { \
+            return error; \
+        } \
+        struct name##_entry *const entry = name##_entry_of(node); \
+        entry->allocator->free(entry->allocator->context, entry); \
+        return 0; \
+    } \
+    \
+    static inline int name##_contains(const struct name *const object, \
+                                      const type *const key, \
+                                      bool *const out) { \
+        if (!object) { \
+            return CORAL_RED_BLACK_TREE_CONTAINER_ERROR_OBJECT_IS_NULL; \
+        } \
+        if (!key) { \
+            return CORAL_RED_BLACK_TREE_CONTAINER_ERROR_KEY_IS_NULL; \
+        } \
+        if (!out) { \
+            return CORAL_RED_BLACK_TREE_CONTAINER_ERROR_OUT_IS_NULL; \
+        } \
+        struct coral_red_black_tree_node *parent; \
+        struct coral_red_black_tree_node **link; \
+        *out = NULL != name##_find(object, key, &parent, &link); \
+        return 0; \
+    } \
+    \
+    static inline int name##_get(const struct name *const object, \
+                                 const type *const key, \
+                                 const type **const out) { \
+        if (!object) { \
+            return CORAL_RED_BLACK_TREE_CONTAINER_ERROR_OBJECT_IS_NULL; \
+        } \
+        if (!key) { \
+            return CORAL_RED_BLACK_TREE_CONTAINER_ERROR_KEY_IS_NULL; \
+        } \
+        if (!out) { \
+            return CORAL_RED_BLACK_TREE_CONTAINER_ERROR_OUT_IS_NULL; \
+        } \
+        struct coral_red_black_tree_node *parent; \
+        struct coral_red_black_tree_node **link; \
+        const struct coral_red_black_tree_node *const node \
+                = name##_find(object, key, &parent, &link); \
+        if (!node) { \
+            return CORAL_RED_BLACK_TREE_CONTAINER_ERROR_ENTRY_NOT_FOUND; \
+        } \
+        *out = &name##_entry_of(node)->data; \
+        return 0; \
+    } \
+    \
+    static inline int name##_first(const struct name *const object, \
+                                   const type **const out) { \
+        if (!object) { \
+            return CORAL_RED_BLACK_TREE_CONTAINER_ERROR_OBJECT_IS_NULL; \
+        } \
+        if (!out) { \
+            return CORAL_RED_BLACK_TREE_CONTAINER_ERROR_OUT_IS_NULL; \
+        } \
+        struct coral_red_black_tree_node *node; \
+        int error; \
+        if ((error = coral_red_black_tree_first(&object->tree, &node))) { \
+            return error; \
+        } \
+        *out = &name##_entry_of(node)->data; \
+        return 0; \
+    } \
+    \
+    static inline int name##_last(const struct name *const object, \
+                                  const type **const out) { \
+        if (!object) { \
+            return CORAL_RED_BLACK_TREE_CONTAINER_ERROR_OBJECT_IS_NULL; \
+        } \
+        if (!out) { \
+            return CORAL_RED_BLACK_TREE_CONTAINER_ERROR_OUT_IS_NULL; \
+        } \
+        struct coral_red_black_tree_node *node; \
+        int error; \
+        if ((error = coral_red_black_tree_last(&object->tree, &node))) { \
+            return error; \
+        } \
+        *out = &name##_entry_of(node)->data; \
+        return 0; \
+    } \
+    \
+    static inline int name##_next(const type *const value, \
+                                  const type **const out) { \
+        if (!value) { \
+            return CORAL_RED_BLACK_TREE_CONTAINER_ERROR_ENTRY_IS_NULL; \
+        } \
+        if (!out) { \
+            return CORAL_RED_BLACK_TREE_CONTAINER_ERROR_OUT_IS_NULL; \
+        } \
+        const struct name##_entry *const entry = rock_container_of( \
+                value, struct name##_entry, data); \
+        struct coral_red_black_tree_node *node; \
+        int error; \
+        if ((error = coral_red_black_tree_next(&entry->node, &node))) { \
+            return error; \
+        } \
+        *out = &name##_entry_of(node)->data; \
+        return 0; \
+    } \
+    \
+    static inline int name##_prev(const type *const value, \
+                                  const type **const out) { \
+        if (!value) { \
+            return CORAL_RED_BLACK_TREE_CONTAINER_ERROR_ENTRY_IS_NULL; \
+        } \
+        if (!out) { \
+            return CORAL_RED_BLACK_TREE_CONTAINER_ERROR_OUT_IS_NULL; \
+        } \
+        const struct name##_entry *const entry = rock_container_of( \
+                value, struct name##_entry, data); \
+        struct coral_red_black_tree_node *node; \
+        int error; \
+        if ((error = coral_red_black_tree_prev(&entry->node, &node))) { \
+            return error; \
+        } \
+        *out = &name##_entry_of(node)->data; \
+        return 0; \
+    }
+
+#endif /* _CORAL_TYPED_RED_BLACK_TREE_CONTAINER_H_ */
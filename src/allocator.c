@@ -0,0 +1,48 @@
+#include <stdlib.h>
+#include <stdatomic.h>
+#include <coral.h>
+
+#ifdef TEST
+#include <test/cmocka.h>
+#endif
+
+static int system_alloc(void *const context,
+                        const size_t alignment,
+                        const size_t size,
+                        void **const out) {
+    return posix_memalign(out, alignment, size);
+}
+
+static void system_free(void *const context, void *const memory) {
+    free(memory);
+}
+
+static const struct coral_allocator system_allocator = {
+        .alloc = system_alloc,
+        .free = system_free
+};
+
+static _Atomic(const struct coral_allocator *) default_allocator
+        = &system_allocator;
+
+int coral_allocator_get_default(const struct coral_allocator **const out) {
+    if (!out) {
+        return CORAL_ALLOCATOR_ERROR_OUT_IS_NULL;
+    }
+    *out = atomic_load_explicit(&default_allocator, memory_order_acquire);
+    return 0;
+}
+
+int coral_allocator_set_default(const struct coral_allocator *allocator) {
+    if (!allocator) {
+        allocator = &system_allocator;
+    }
+    if (!allocator->alloc) {
+        return CORAL_ALLOCATOR_ERROR_ALLOC_IS_NULL;
+    }
+    if (!allocator->free) {
+        return CORAL_ALLOCATOR_ERROR_FREE_IS_NULL;
+    }
+    atomic_store_explicit(&default_allocator, allocator, memory_order_release);
+    return 0;
+}
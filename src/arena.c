@@ -0,0 +1,131 @@
+#include <stdlib.h>
+#include <seagrass.h>
+#include <coral.h>
+
+#ifdef TEST
+#include <test/cmocka.h>
+#endif
+
+struct chunk {
+    struct chunk *next;
+    max_align_t data[];
+};
+
+static int arena_alloc(void *const context,
+                       const size_t alignment,
+                       const size_t size,
+                       void **const out) {
+    return coral_arena_alloc(context, alignment, size, out);
+}
+
+static void arena_free(void *const context, void *const memory) {
+    /* memory is released when the arena is invalidated */
+}
+
+int coral_arena_init(struct coral_arena *const object, const size_t size) {
+    if (!object) {
+        return CORAL_ARENA_ERROR_OBJECT_IS_NULL;
+    }
+    if (!size) {
+        return CORAL_ARENA_ERROR_SIZE_IS_ZERO;
+    }
+    if (size > SIZE_MAX - sizeof(struct chunk)) {
+        return CORAL_ARENA_ERROR_SIZE_IS_TOO_LARGE;
+    }
+    *object = (struct coral_arena) {0};
+    object->size = size;
+    return 0;
+}
+
+int coral_arena_invalidate(struct coral_arena *const object) {
+    if (!object) {
+        return CORAL_ARENA_ERROR_OBJECT_IS_NULL;
+    }
+    struct chunk *chunk = object->chunks;
+    while (chunk) {
+        struct chunk *const next = chunk->next;
+        free(chunk);
+        chunk = next;
+    }
+    *object = (struct coral_arena) {0};
+    return 0;
+}
+
+static unsigned char *align(unsigned char *const pointer,
+                            const size_t alignment) {
+    const uintptr_t value = (uintptr_t) pointer;
+    return pointer + (((value + alignment - 1) & ~(alignment - 1)) - value);
+}
+
+int coral_arena_alloc(struct coral_arena *const object,
+                      const size_t alignment,
+                      const size_t size,
+                      void **const out) {
+    if (!object) {
+        return CORAL_ARENA_ERROR_OBJECT_IS_NULL;
+    }
+    if (!out) {
+        return CORAL_ARENA_ERROR_OUT_IS_NULL;
+    }
+    if (!size) {
+        return CORAL_ARENA_ERROR_SIZE_IS_ZERO;
+    }
+    if (object->cursor) {
+        unsigned char *const cursor = align(object->cursor, alignment);
+        if (cursor <= object->end && size <= (size_t) (object->end - cursor)) {
+            *out = cursor;
+            object->cursor = cursor + size;
+            return 0;
+        }
+    }
+    int error;
+    uintmax_t alloc;
+    if ((error = seagrass_uintmax_t_add(size, alignment, &alloc))
+        || (error = seagrass_uintmax_t_add(
+                alloc, sizeof(struct chunk), &alloc))
+        || alloc > SIZE_MAX) {
+        seagrass_required_true(SEAGRASS_UINTMAX_T_ERROR_RESULT_IS_INCONSISTENT
+                               == error || !error);
+        return CORAL_ARENA_ERROR_SIZE_IS_TOO_LARGE;
+    }
+    /* oversized allocations receive a chunk of their own */
+    const bool oversized = alloc > object->size + sizeof(struct chunk);
+    if (!oversized) {
+        alloc = object->size + sizeof(struct chunk);
+    }
+    struct chunk *chunk;
+    if (!(chunk = malloc(alloc))) {
+        return CORAL_ARENA_ERROR_MEMORY_ALLOCATION_FAILED;
+    }
+    unsigned char *const cursor = align((unsigned char *) chunk->data,
+                                        alignment);
+    *out = cursor;
+    if (oversized && object->chunks) {
+        /* keep bumping through the current chunk */
+        struct chunk *const head = object->chunks;
+        chunk->next = head->next;
+        head->next = chunk;
+        return 0;
+    }
+    chunk->next = object->chunks;
+    object->chunks = chunk;
+    object->cursor = cursor + size;
+    object->end = (unsigned char *) chunk + alloc;
+    return 0;
+}
+
+int coral_arena_allocator(struct coral_arena *const object,
+                          struct coral_allocator *const out) {
+    if (!object) {
+        return CORAL_ARENA_ERROR_OBJECT_IS_NULL;
+    }
+    if (!out) {
+        return CORAL_ARENA_ERROR_OUT_IS_NULL;
+    }
+    *out = (struct coral_allocator) {
+            .alloc = arena_alloc,
+            .free = arena_free,
+            .context = object
+    };
+    return 0;
+}
@@ -0,0 +1,1025 @@
+#include <stdlib.h>
+#include <string.h>
+#include <seagrass.h>
+#include <coral.h>
+
+#include "counters.h"
+
+#ifdef TEST
+#include <test/cmocka.h>
+#endif
+
+/* Nodes are aligned to cache lines and span only a few of them, so that a
+ * lookup loads one small block per level and a scan walks the leaves. */
+#define CACHE_LINE 64
+#define LEAF_CAPACITY 16
+#define LEAF_MINIMUM (LEAF_CAPACITY / 2)
+#define BRANCH_CAPACITY 16
+#define BRANCH_MINIMUM (BRANCH_CAPACITY / 2)
+/* a tree of branches that are at least half full is never deeper */
+#define DEPTH_LIMIT 64
+
+struct coral_btree_container_entry {
+    void *data;
+};
+
+struct leaf;
+
+struct entry {
+    struct leaf *leaf;
+    size_t index;
+    const struct coral_allocator *allocator;
+    unsigned char data[];
+};
+
+struct branch;
+
+struct coral_btree_container_node {
+    struct branch *parent;
+    size_t count; /* entries of a leaf or children of a branch */
+    bool leaf;
+};
+
+struct leaf {
+    struct coral_btree_container_node node;
+    struct leaf *prev;
+    struct leaf *next;
+    struct entry *entries[LEAF_CAPACITY];
+};
+
+struct branch {
+    struct coral_btree_container_node node;
+    /* keys[i] is the first entry in the subtree of children[i + 1] */
+    struct entry *keys[BRANCH_CAPACITY - 1];
+    struct coral_btree_container_node *children[BRANCH_CAPACITY];
+};
+
+int coral_btree_container_alloc_with(
+        const struct coral_allocator *allocator,
+        const size_t size,
+        struct coral_btree_container_entry **const out) {
+    if (!size) {
+        return CORAL_BTREE_CONTAINER_ERROR_SIZE_IS_ZERO;
+    }
+    if (!out) {
+        return CORAL_BTREE_CONTAINER_ERROR_OUT_IS_NULL;
+    }
+    int error;
+    uintmax_t alloc;
+    if ((error = seagrass_uintmax_t_add(size, sizeof(struct entry), &alloc))
+        || alloc > SIZE_MAX) {
+        seagrass_required_true(SEAGRASS_UINTMAX_T_ERROR_RESULT_IS_INCONSISTENT
+                               == error || !error);
+        return CORAL_BTREE_CONTAINER_ERROR_SIZE_IS_TOO_LARGE;
+    }
+    if (!allocator) {
+        seagrass_required_true(!coral_allocator_get_default(&allocator));
+    }
+    struct entry *entry;
+    if (allocator->alloc(allocator->context, sizeof(void *), alloc,
+                         (void **) &entry)) {
+        return CORAL_BTREE_CONTAINER_ERROR_MEMORY_ALLOCATION_FAILED;
+    }
+    entry->leaf = NULL;
+    entry->index = 0;
+    entry->allocator = allocator;
+    coral_allocation_counters_alloc();
+    *out = (struct coral_btree_container_entry *) &entry->data;
+    return 0;
+}
+
+int coral_btree_container_alloc(
+        const size_t size,
+        struct coral_btree_container_entry **const out) {
+    return coral_btree_container_alloc_with(NULL, size, out);
+}
+
+int coral_btree_container_free(
+        struct coral_btree_container_entry *const entry) {
+    if (!entry) {
+        return CORAL_BTREE_CONTAINER_ERROR_ENTRY_IS_NULL;
+    }
+    struct entry *const A = rock_container_of(entry, struct entry, data);
+    coral_allocation_counters_free();
+    A->allocator->free(A->allocator->context, A);
+    return 0;
+}
+
+int coral_btree_container_init(
+        struct coral_btree_container *const object,
+        int (*const compare)(const void *first,
+                             const void *second)) {
+    if (!object) {
+        return CORAL_BTREE_CONTAINER_ERROR_OBJECT_IS_NULL;
+    }
+    if (!compare) {
+        return CORAL_BTREE_CONTAINER_ERROR_COMPARE_IS_NULL;
+    }
+    *object = (struct coral_btree_container) {
+            .compare = compare
+    };
+    return 0;
+}
+
+int coral_btree_container_init_with_key(
+        struct coral_btree_container *const object,
+        int (*const compare)(const void *first,
+                             const void *second),
+        int (*const compare_key)(const void *key,
+                                 const void *entry)) {
+    if (!object) {
+        return CORAL_BTREE_CONTAINER_ERROR_OBJECT_IS_NULL;
+    }
+    if (!compare_key) {
+        return CORAL_BTREE_CONTAINER_ERROR_COMPARE_IS_NULL;
+    }
+    int error;
+    if ((error = coral_btree_container_init(object, compare))) {
+        return error;
+    }
+    object->compare_key = compare_key;
+    return 0;
+}
+
+/* Nodes do not come from the default allocator which may well be an entry
+ * pool that only serves blocks the size of an entry. */
+static int alloc_node(const size_t size, void **const out) {
+    return posix_memalign(out, CACHE_LINE, size);
+}
+
+static void free_node(void *const node) {
+    free(node);
+}
+
+static void destroy(struct coral_btree_container_node *const node) {
+    if (!node->leaf) {
+        struct branch *const branch = (struct branch *) node;
+        for (size_t i = 0; i < node->count; i++) {
+            destroy(branch->children[i]);
+        }
+    }
+    free_node(node);
+}
+
+static struct leaf *leftmost(struct coral_btree_container_node *node) {
+    while (!node->leaf) {
+        node = ((struct branch *) node)->children[0];
+    }
+    return (struct leaf *) node;
+}
+
+static struct leaf *rightmost(struct coral_btree_container_node *node) {
+    while (!node->leaf) {
+        node = ((struct branch *) node)->children[node->count - 1];
+    }
+    return (struct leaf *) node;
+}
+
+int coral_btree_container_invalidate(
+        struct coral_btree_container *const object,
+        void (*const on_destroy)(struct coral_btree_container_entry *entry)) {
+    if (!object) {
+        return CORAL_BTREE_CONTAINER_ERROR_OBJECT_IS_NULL;
+    }
+    if (object->root) {
+        /* entries are released leaf by leaf in order */
+        for (struct leaf *leaf = leftmost(object->root); leaf;
+             leaf = leaf->next) {
+            for (size_t i = 0; i < leaf->node.count; i++) {
+                struct coral_btree_container_entry *const entry
+                        = (struct coral_btree_container_entry *)
+                                &leaf->entries[i]->data;
+                if (on_destroy) {
+                    on_destroy(entry);
+                }
+                seagrass_required_true(!coral_btree_container_free(entry));
+            }
+        }
+        destroy(object->root);
+    }
+    *object = (struct coral_btree_container) {0};
+    return 0;
+}
+
+int coral_btree_container_count(
+        const struct coral_btree_container *const object,
+        uintmax_t *const out) {
+    if (!object) {
+        return CORAL_BTREE_CONTAINER_ERROR_OBJECT_IS_NULL;
+    }
+    if (!out) {
+        return CORAL_BTREE_CONTAINER_ERROR_OUT_IS_NULL;
+    }
+    *out = object->count;
+    return 0;
+}
+
+static int entity_compare(const struct coral_btree_container *const object,
+                          const void *const key,
+                          const struct entry *const B) {
+    coral_counters_add(object, compare, 1);
+    return object->compare(key, &B->data);
+}
+
+static int key_compare(const struct coral_btree_container *const object,
+                       const void *const key,
+                       const struct entry *const B) {
+    coral_counters_add(object, compare, 1);
+    return object->compare_key(key, &B->data);
+}
+
+/* Descend to the leaf that holds key if it is present. */
+static struct leaf *descend(
+        const struct coral_btree_container *const object,
+        const void *const key,
+        int (*const compare)(const struct coral_btree_container *,
+                             const void *,
+                             const struct entry *)) {
+    struct coral_btree_container_node *node = object->root;
+    if (!node) {
+        return NULL;
+    }
+    coral_counters_add(object, visit, 1);
+    while (!node->leaf) {
+        const struct branch *const branch = (struct branch *) node;
+        /* the child after the last key that is not greater than key */
+        size_t first = 0;
+        size_t last = node->count - 1;
+        while (first < last) {
+            const size_t middle = first + (last - first) / 2;
+            if (compare(object, key, branch->keys[middle]) < 0) {
+                last = middle;
+            } else {
+                first = middle + 1;
+            }
+        }
+        node = branch->children[first];
+        coral_counters_add(object, visit, 1);
+    }
+    return (struct leaf *) node;
+}
+
+/* Position of the first entry of leaf that is not less than key. */
+static size_t search(const struct coral_btree_container *const object,
+                     const struct leaf *const leaf,
+                     const void *const key,
+                     int (*const compare)(const struct coral_btree_container *,
+                                          const void *,
+                                          const struct entry *),
+                     bool *const found) {
+    size_t first = 0;
+    size_t last = leaf->node.count;
+    *found = false;
+    while (first < last) {
+        const size_t middle = first + (last - first) / 2;
+        const int result = compare(object, key, leaf->entries[middle]);
+        if (result > 0) {
+            first = middle + 1;
+        } else {
+            last = middle;
+            *found = !result;
+        }
+    }
+    return first;
+}
+
+static void reindex(struct leaf *const leaf, const size_t from) {
+    for (size_t i = from; i < leaf->node.count; i++) {
+        leaf->entries[i]->leaf = leaf;
+        leaf->entries[i]->index = i;
+    }
+}
+
+static size_t index_of(const struct branch *const branch,
+                       const struct coral_btree_container_node *const child) {
+    size_t i = 0;
+    while (branch->children[i] != child) {
+        i++;
+    }
+    return i;
+}
+
+/* The first entry of leaf changed, update the key that refers to it. */
+static void refresh(struct leaf *const leaf) {
+    const struct coral_btree_container_node *child = &leaf->node;
+    struct branch *parent = child->parent;
+    while (parent && parent->children[0] == child) {
+        child = &parent->node;
+        parent = parent->node.parent;
+    }
+    if (parent) {
+        parent->keys[index_of(parent, child) - 1] = leaf->entries[0];
+    }
+}
+
+/* Link right, whose first entry is key, after left in the parent of left
+ * splitting the parent up the tree as needed. The branches are taken from
+ * spare which was allocated beforehand. */
+static void insert_child(struct coral_btree_container *const object,
+                         struct coral_btree_container_node *const left,
+                         struct entry *const key,
+                         struct coral_btree_container_node *const right,
+                         struct branch **spare) {
+    struct branch *const parent = left->parent;
+    if (!parent) {
+        struct branch *const root = *spare;
+        *root = (struct branch) {
+                .node.count = 2,
+                .keys = {key},
+                .children = {left, right}
+        };
+        left->parent = right->parent = root;
+        object->root = &root->node;
+        return;
+    }
+    const size_t at = 1 + index_of(parent, left);
+    const size_t count = parent->node.count;
+    if (count < BRANCH_CAPACITY) {
+        memmove(&parent->children[at + 1], &parent->children[at],
+                (count - at) * sizeof(parent->children[0]));
+        memmove(&parent->keys[at], &parent->keys[at - 1],
+                (count - at) * sizeof(parent->keys[0]));
+        parent->children[at] = right;
+        parent->keys[at - 1] = key;
+        parent->node.count++;
+        right->parent = parent;
+        return;
+    }
+    struct entry *keys[BRANCH_CAPACITY];
+    struct coral_btree_container_node *children[BRANCH_CAPACITY + 1];
+    memcpy(children, parent->children, at * sizeof(children[0]));
+    children[at] = right;
+    memcpy(&children[at + 1], &parent->children[at],
+           (count - at) * sizeof(children[0]));
+    memcpy(keys, parent->keys, (at - 1) * sizeof(keys[0]));
+    keys[at - 1] = key;
+    memcpy(&keys[at], &parent->keys[at - 1],
+           (count - at) * sizeof(keys[0]));
+    /* the key between the halves moves up to the grandparent */
+    const size_t half = (BRANCH_CAPACITY + 1) / 2;
+    struct branch *const sibling = *spare++;
+    *sibling = (struct branch) {
+            .node.count = BRANCH_CAPACITY + 1 - half
+    };
+    parent->node.count = half;
+    memcpy(parent->children, children, half * sizeof(children[0]));
+    memcpy(parent->keys, keys, (half - 1) * sizeof(keys[0]));
+    memcpy(sibling->children, &children[half],
+           sibling->node.count * sizeof(children[0]));
+    memcpy(sibling->keys, &keys[half],
+           (sibling->node.count - 1) * sizeof(keys[0]));
+    for (size_t i = 0; i < parent->node.count; i++) {
+        parent->children[i]->parent = parent;
+    }
+    for (size_t i = 0; i < sibling->node.count; i++) {
+        sibling->children[i]->parent = sibling;
+    }
+    insert_child(object, &parent->node, keys[half - 1], &sibling->node,
+                 spare);
+}
+
+static int insert(struct coral_btree_container *const object,
+                  struct entry *const A) {
+    struct leaf *const leaf = descend(object, &A->data, entity_compare);
+    if (!leaf) {
+        struct leaf *root;
+        if (alloc_node(sizeof(*root), (void **) &root)) {
+            return CORAL_BTREE_CONTAINER_ERROR_MEMORY_ALLOCATION_FAILED;
+        }
+        *root = (struct leaf) {
+                .node.count = 1,
+                .node.leaf = true,
+                .entries = {A}
+        };
+        reindex(root, 0);
+        object->root = &root->node;
+        return 0;
+    }
+    bool found;
+    const size_t at = search(object, leaf, &A->data, entity_compare, &found);
+    if (found) {
+        return CORAL_BTREE_CONTAINER_ERROR_ENTRY_ALREADY_EXISTS;
+    }
+    const size_t count = leaf->node.count;
+    if (count < LEAF_CAPACITY) {
+        memmove(&leaf->entries[at + 1], &leaf->entries[at],
+                (count - at) * sizeof(leaf->entries[0]));
+        leaf->entries[at] = A;
+        leaf->node.count++;
+        reindex(leaf, at);
+        if (!at) {
+            refresh(leaf);
+        }
+        return 0;
+    }
+    /* allocate every node the split may need so that it cannot fail */
+    size_t needed = 0;
+    const struct branch *parent = leaf->node.parent;
+    while (parent && parent->node.count == BRANCH_CAPACITY) {
+        needed++;
+        parent = parent->node.parent;
+    }
+    needed += !parent;
+    seagrass_required_true(needed < DEPTH_LIMIT);
+    struct branch *spare[DEPTH_LIMIT];
+    struct leaf *sibling;
+    if (alloc_node(sizeof(*sibling), (void **) &sibling)) {
+        return CORAL_BTREE_CONTAINER_ERROR_MEMORY_ALLOCATION_FAILED;
+    }
+    for (size_t i = 0; i < needed; i++) {
+        if (alloc_node(sizeof(*spare[i]), (void **) &spare[i])) {
+            while (i--) {
+                free_node(spare[i]);
+            }
+            free_node(sibling);
+            return CORAL_BTREE_CONTAINER_ERROR_MEMORY_ALLOCATION_FAILED;
+        }
+    }
+    struct entry *entries[LEAF_CAPACITY + 1];
+    memcpy(entries, leaf->entries, at * sizeof(entries[0]));
+    entries[at] = A;
+    memcpy(&entries[at + 1], &leaf->entries[at],
+           (count - at) * sizeof(entries[0]));
+    const size_t half = (LEAF_CAPACITY + 1) / 2;
+    *sibling = (struct leaf) {
+            .node.count = LEAF_CAPACITY + 1 - half,
+            .node.leaf = true,
+            .prev = leaf,
+            .next = leaf->next
+    };
+    if (leaf->next) {
+        leaf->next->prev = sibling;
+    }
+    leaf->next = sibling;
+    leaf->node.count = half;
+    memcpy(leaf->entries, entries, half * sizeof(entries[0]));
+    memcpy(sibling->entries, &entries[half],
+           sibling->node.count * sizeof(entries[0]));
+    reindex(leaf, 0);
+    reindex(sibling, 0);
+    if (!at) {
+        refresh(leaf);
+    }
+    insert_child(object, &leaf->node, sibling->entries[0], &sibling->node,
+                 spare);
+    return 0;
+}
+
+int coral_btree_container_add(
+        struct coral_btree_container *const object,
+        const struct coral_btree_container_entry *const entry) {
+    if (!object) {
+        return CORAL_BTREE_CONTAINER_ERROR_OBJECT_IS_NULL;
+    }
+    if (!entry) {
+        return CORAL_BTREE_CONTAINER_ERROR_ENTRY_IS_NULL;
+    }
+    struct entry *const A = rock_container_of(entry, struct entry, data);
+    int error;
+    if ((error = insert(object, A))) {
+        return error;
+    }
+    object->count++;
+    coral_counters_add(object, insert, 1);
+    return 0;
+}
+
+/* Drop the child at index from branch and restore the branch's occupancy
+ * by borrowing from or merging with a sibling. */
+static void remove_child(struct coral_btree_container *object,
+                         struct branch *branch,
+                         size_t index);
+
+static void rebalance(struct coral_btree_container *const object,
+                      struct branch *const branch) {
+    struct branch *const parent = branch->node.parent;
+    const size_t at = index_of(parent, &branch->node);
+    struct branch *const left = at
+            ? (struct branch *) parent->children[at - 1]
+            : NULL;
+    struct branch *const right = at + 1 < parent->node.count
+            ? (struct branch *) parent->children[at + 1]
+            : NULL;
+    const size_t count = branch->node.count;
+    if (left && left->node.count > BRANCH_MINIMUM) {
+        memmove(&branch->children[1], branch->children,
+                count * sizeof(branch->children[0]));
+        memmove(&branch->keys[1], branch->keys,
+                (count - 1) * sizeof(branch->keys[0]));
+        branch->children[0] = left->children[--left->node.count];
+        branch->children[0]->parent = branch;
+        branch->keys[0] = parent->keys[at - 1];
+        parent->keys[at - 1] = left->keys[left->node.count - 1];
+        branch->node.count++;
+        return;
+    }
+    if (right && right->node.count > BRANCH_MINIMUM) {
+        branch->children[count] = right->children[0];
+        branch->children[count]->parent = branch;
+        branch->keys[count - 1] = parent->keys[at];
+        parent->keys[at] = right->keys[0];
+        branch->node.count++;
+        right->node.count--;
+        memmove(right->children, &right->children[1],
+                right->node.count * sizeof(right->children[0]));
+        memmove(right->keys, &right->keys[1],
+                (right->node.count - 1) * sizeof(right->keys[0]));
+        return;
+    }
+    struct branch *const first = left ? left : branch;
+    struct branch *const second = left ? branch : right;
+    const size_t index = left ? at : at + 1;
+    first->keys[first->node.count - 1] = parent->keys[index - 1];
+    memcpy(&first->keys[first->node.count], second->keys,
+           (second->node.count - 1) * sizeof(second->keys[0]));
+    memcpy(&first->children[first->node.count], second->children,
+           second->node.count * sizeof(second->children[0]));
+    for (size_t i = 0; i < second->node.count; i++) {
+        second->children[i]->parent = first;
+    }
+    first->node.count += second->node.count;
+    free_node(second);
+    remove_child(object, parent, index);
+}
+
+static void remove_child(struct coral_btree_container *const object,
+                         struct branch *const branch,
+                         const size_t index) {
+    branch->node.count--;
+    memmove(&branch->children[index], &branch->children[index + 1],
+            (branch->node.count - index) * sizeof(branch->children[0]));
+    memmove(&branch->keys[index - 1], &branch->keys[index],
+            (branch->node.count - index) * sizeof(branch->keys[0]));
+    if (branch->node.parent) {
+        if (branch->node.count < BRANCH_MINIMUM) {
+            rebalance(object, branch);
+        }
+    } else if (1 == branch->node.count) {
+        /* the root is replaced by its only child */
+        object->root = branch->children[0];
+        object->root->parent = NULL;
+        free_node(branch);
+    }
+}
+
+static void erase(struct coral_btree_container *const object,
+                  struct entry *const A) {
+    struct leaf *const leaf = A->leaf;
+    const size_t at = A->index;
+    leaf->node.count--;
+    memmove(&leaf->entries[at], &leaf->entries[at + 1],
+            (leaf->node.count - at) * sizeof(leaf->entries[0]));
+    reindex(leaf, at);
+    A->leaf = NULL;
+    if (!leaf->node.parent) {
+        if (!leaf->node.count) {
+            object->root = NULL;
+            free_node(leaf);
+        }
+        return;
+    }
+    if (!at) {
+        refresh(leaf);
+    }
+    if (leaf->node.count >= LEAF_MINIMUM) {
+        return;
+    }
+    struct branch *const parent = leaf->node.parent;
+    const size_t index = index_of(parent, &leaf->node);
+    struct leaf *const left = index ? leaf->prev : NULL;
+    struct leaf *const right = index + 1 < parent->node.count
+            ? leaf->next
+            : NULL;
+    if (left && left->node.count > LEAF_MINIMUM) {
+        memmove(&leaf->entries[1], leaf->entries,
+                leaf->node.count * sizeof(leaf->entries[0]));
+        leaf->entries[0] = left->entries[--left->node.count];
+        leaf->node.count++;
+        reindex(leaf, 0);
+        parent->keys[index - 1] = leaf->entries[0];
+        return;
+    }
+    if (right && right->node.count > LEAF_MINIMUM) {
+        leaf->entries[leaf->node.count++] = right->entries[0];
+        right->node.count--;
+        memmove(right->entries, &right->entries[1],
+                right->node.count * sizeof(right->entries[0]));
+        reindex(leaf, leaf->node.count - 1);
+        reindex(right, 0);
+        parent->keys[index] = right->entries[0];
+        return;
+    }
+    struct leaf *const first = left ? left : leaf;
+    struct leaf *const second = left ? leaf : right;
+    memcpy(&first->entries[first->node.count], second->entries,
+           second->node.count * sizeof(second->entries[0]));
+    first->node.count += second->node.count;
+    reindex(first, first->node.count - second->node.count);
+    first->next = second->next;
+    if (second->next) {
+        second->next->prev = first;
+    }
+    free_node(second);
+    remove_child(object, parent, left ? index : index + 1);
+}
+
+int coral_btree_container_remove(
+        struct coral_btree_container *const object,
+        const struct coral_btree_container_entry *const entry) {
+    if (!object) {
+        return CORAL_BTREE_CONTAINER_ERROR_OBJECT_IS_NULL;
+    }
+    if (!entry) {
+        return CORAL_BTREE_CONTAINER_ERROR_ENTRY_IS_NULL;
+    }
+    struct entry *const A = rock_container_of(entry, struct entry, data);
+    if (!A->leaf) {
+        return CORAL_BTREE_CONTAINER_ERROR_ENTRY_NOT_FOUND;
+    }
+    erase(object, A);
+    object->count--;
+    coral_counters_add(object, remove, 1);
+    return 0;
+}
+
+static struct coral_btree_container_entry *to_entry(
+        const struct entry *const A) {
+    return (struct coral_btree_container_entry *) &A->data;
+}
+
+static int find(
+        const struct coral_btree_container *const object,
+        const void *const key,
+        int (*const compare)(const struct coral_btree_container *,
+                             const void *,
+                             const struct entry *),
+        struct coral_btree_container_entry **const out) {
+    const struct leaf *const leaf = descend(object, key, compare);
+    if (!leaf) {
+        return CORAL_BTREE_CONTAINER_ERROR_ENTRY_NOT_FOUND;
+    }
+    bool found;
+    const size_t at = search(object, leaf, key, compare, &found);
+    if (!found) {
+        return CORAL_BTREE_CONTAINER_ERROR_ENTRY_NOT_FOUND;
+    }
+    *out = to_entry(leaf->entries[at]);
+    return 0;
+}
+
+/* Entry at or after position at of leaf. */
+static int at_or_after(const struct leaf *const leaf,
+                       const size_t at,
+                       struct coral_btree_container_entry **const out) {
+    if (at < leaf->node.count) {
+        *out = to_entry(leaf->entries[at]);
+        return 0;
+    }
+    if (!leaf->next) {
+        return CORAL_BTREE_CONTAINER_ERROR_ENTRY_NOT_FOUND;
+    }
+    *out = to_entry(leaf->next->entries[0]);
+    return 0;
+}
+
+/* Entry before position at of leaf. */
+static int before(const struct leaf *const leaf,
+                  const size_t at,
+                  struct coral_btree_container_entry **const out) {
+    if (at) {
+        *out = to_entry(leaf->entries[at - 1]);
+        return 0;
+    }
+    if (!leaf->prev) {
+        return CORAL_BTREE_CONTAINER_ERROR_ENTRY_NOT_FOUND;
+    }
+    *out = to_entry(leaf->prev->entries[leaf->prev->node.count - 1]);
+    return 0;
+}
+
+static int find_ceiling(
+        const struct coral_btree_container *const object,
+        const void *const key,
+        int (*const compare)(const struct coral_btree_container *,
+                             const void *,
+                             const struct entry *),
+        struct coral_btree_container_entry **const out) {
+    const struct leaf *const leaf = descend(object, key, compare);
+    if (!leaf) {
+        return CORAL_BTREE_CONTAINER_ERROR_ENTRY_NOT_FOUND;
+    }
+    bool found;
+    return at_or_after(leaf, search(object, leaf, key, compare, &found),
+                       out);
+}
+
+static int find_floor(
+        const struct coral_btree_container *const object,
+        const void *const key,
+        int (*const compare)(const struct coral_btree_container *,
+                             const void *,
+                             const struct entry *),
+        struct coral_btree_container_entry **const out) {
+    const struct leaf *const leaf = descend(object, key, compare);
+    if (!leaf) {
+        return CORAL_BTREE_CONTAINER_ERROR_ENTRY_NOT_FOUND;
+    }
+    bool found;
+    const size_t at = search(object, leaf, key, compare, &found);
+    return before(leaf, at + found, out);
+}
+
+static int find_higher(
+        const struct coral_btree_container *const object,
+        const void *const key,
+        int (*const compare)(const struct coral_btree_container *,
+                             const void *,
+                             const struct entry *),
+        struct coral_btree_container_entry **const out) {
+    const struct leaf *const leaf = descend(object, key, compare);
+    if (!leaf) {
+        return CORAL_BTREE_CONTAINER_ERROR_ENTRY_NOT_FOUND;
+    }
+    bool found;
+    const size_t at = search(object, leaf, key, compare, &found);
+    return at_or_after(leaf, at + found, out);
+}
+
+static int find_lower(
+        const struct coral_btree_container *const object,
+        const void *const key,
+        int (*const compare)(const struct coral_btree_container *,
+                             const void *,
+                             const struct entry *),
+        struct coral_btree_container_entry **const out) {
+    const struct leaf *const leaf = descend(object, key, compare);
+    if (!leaf) {
+        return CORAL_BTREE_CONTAINER_ERROR_ENTRY_NOT_FOUND;
+    }
+    bool found;
+    return before(leaf, search(object, leaf, key, compare, &found), out);
+}
+
+int coral_btree_container_get(
+        const struct coral_btree_container *const object,
+        const void *const key,
+        struct coral_btree_container_entry **const out) {
+    if (!object) {
+        return CORAL_BTREE_CONTAINER_ERROR_OBJECT_IS_NULL;
+    }
+    if (!key) {
+        return CORAL_BTREE_CONTAINER_ERROR_KEY_IS_NULL;
+    }
+    if (!out) {
+        return CORAL_BTREE_CONTAINER_ERROR_OUT_IS_NULL;
+    }
+    return find(object, key, entity_compare, out);
+}
+
+int coral_btree_container_get_key(
+        const struct coral_btree_container *const object,
+        const void *const key,
+        struct coral_btree_container_entry **const out) {
+    if (!object) {
+        return CORAL_BTREE_CONTAINER_ERROR_OBJECT_IS_NULL;
+    }
+    if (!key) {
+        return CORAL_BTREE_CONTAINER_ERROR_KEY_IS_NULL;
+    }
+    if (!out) {
+        return CORAL_BTREE_CONTAINER_ERROR_OUT_IS_NULL;
+    }
+    if (!object->compare_key) {
+        return CORAL_BTREE_CONTAINER_ERROR_COMPARE_IS_NULL;
+    }
+    return find(object, key, key_compare, out);
+}
+
+int coral_btree_container_ceiling(
+        const struct coral_btree_container *const object,
+        const void *const key,
+        struct coral_btree_container_entry **const out) {
+    if (!object) {
+        return CORAL_BTREE_CONTAINER_ERROR_OBJECT_IS_NULL;
+    }
+    if (!key) {
+        return CORAL_BTREE_CONTAINER_ERROR_KEY_IS_NULL;
+    }
+    if (!out) {
+        return CORAL_BTREE_CONTAINER_ERROR_OUT_IS_NULL;
+    }
+    return find_ceiling(object, key, entity_compare, out);
+}
+
+int coral_btree_container_ceiling_key(
+        const struct coral_btree_container *const object,
+        const void *const key,
+        struct coral_btree_container_entry **const out) {
+    if (!object) {
+        return CORAL_BTREE_CONTAINER_ERROR_OBJECT_IS_NULL;
+    }
+    if (!key) {
+        return CORAL_BTREE_CONTAINER_ERROR_KEY_IS_NULL;
+    }
+    if (!out) {
+        return CORAL_BTREE_CONTAINER_ERROR_OUT_IS_NULL;
+    }
+    if (!object->compare_key) {
+        return CORAL_BTREE_CONTAINER_ERROR_COMPARE_IS_NULL;
+    }
+    return find_ceiling(object, key, key_compare, out);
+}
+
+int coral_btree_container_floor(
+        const struct coral_btree_container *const object,
+        const void *const key,
+        struct coral_btree_container_entry **const out) {
+    if (!object) {
+        return CORAL_BTREE_CONTAINER_ERROR_OBJECT_IS_NULL;
+    }
+    if (!key) {
+        return CORAL_BTREE_CONTAINER_ERROR_KEY_IS_NULL;
+    }
+    if (!out) {
+        return CORAL_BTREE_CONTAINER_ERROR_OUT_IS_NULL;
+    }
+    return find_floor(object, key, entity_compare, out);
+}
+
+int coral_btree_container_floor_key(
+        const struct coral_btree_container *const object,
+        const void *const key,
+        struct coral_btree_container_entry **const out) {
+    if (!object) {
+        return CORAL_BTREE_CONTAINER_ERROR_OBJECT_IS_NULL;
+    }
+    if (!key) {
+        return CORAL_BTREE_CONTAINER_ERROR_KEY_IS_NULL;
+    }
+    if (!out) {
+        return CORAL_BTREE_CONTAINER_ERROR_OUT_IS_NULL;
+    }
+    if (!object->compare_key) {
+        return CORAL_BTREE_CONTAINER_ERROR_COMPARE_IS_NULL;
+    }
+    return find_floor(object, key, key_compare, out);
+}
+
+int coral_btree_container_higher(
+        const struct coral_btree_container *const object,
+        const void *const key,
+        struct coral_btree_container_entry **const out) {
+    if (!object) {
+        return CORAL_BTREE_CONTAINER_ERROR_OBJECT_IS_NULL;
+    }
+    if (!key) {
+        return CORAL_BTREE_CONTAINER_ERROR_KEY_IS_NULL;
+    }
+    if (!out) {
+        return CORAL_BTREE_CONTAINER_ERROR_OUT_IS_NULL;
+    }
+    return find_higher(object, key, entity_compare, out);
+}
+
+int coral_btree_container_higher_key(
+        const struct coral_btree_container *const object,
+        const void *const key,
+        struct coral_btree_container_entry **const out) {
+    if (!object) {
+        return CORAL_BTREE_CONTAINER_ERROR_OBJECT_IS_NULL;
+    }
+    if (!key) {
+        return CORAL_BTREE_CONTAINER_ERROR_KEY_IS_NULL;
+    }
+    if (!out) {
+        return CORAL_BTREE_CONTAINER_ERROR_OUT_IS_NULL;
+    }
+    if (!object->compare_key) {
+        return CORAL_BTREE_CONTAINER_ERROR_COMPARE_IS_NULL;
+    }
+    return find_higher(object, key, key_compare, out);
+}
+
+int coral_btree_container_lower(
+        const struct coral_btree_container *const object,
+        const void *const key,
+        struct coral_btree_container_entry **const out) {
+    if (!object) {
+        return CORAL_BTREE_CONTAINER_ERROR_OBJECT_IS_NULL;
+    }
+    if (!key) {
+        return CORAL_BTREE_CONTAINER_ERROR_KEY_IS_NULL;
+    }
+    if (!out) {
+        return CORAL_BTREE_CONTAINER_ERROR_OUT_IS_NULL;
+    }
+    return find_lower(object, key, entity_compare, out);
+}
+
+int coral_btree_container_lower_key(
+        const struct coral_btree_container *const object,
+        const void *const key,
+        struct coral_btree_container_entry **const out) {
+    if (!object) {
+        return CORAL_BTREE_CONTAINER_ERROR_OBJECT_IS_NULL;
+    }
+    if (!key) {
+        return CORAL_BTREE_CONTAINER_ERROR_KEY_IS_NULL;
+    }
+    if (!out) {
+        return CORAL_BTREE_CONTAINER_ERROR_OUT_IS_NULL;
+    }
+    if (!object->compare_key) {
+        return CORAL_BTREE_CONTAINER_ERROR_COMPARE_IS_NULL;
+    }
+    return find_lower(object, key, key_compare, out);
+}
+
+int coral_btree_container_first(
+        const struct coral_btree_container *const object,
+        struct coral_btree_container_entry **const out) {
+    if (!object) {
+        return CORAL_BTREE_CONTAINER_ERROR_OBJECT_IS_NULL;
+    }
+    if (!out) {
+        return CORAL_BTREE_CONTAINER_ERROR_OUT_IS_NULL;
+    }
+    if (!object->root) {
+        return CORAL_BTREE_CONTAINER_ERROR_CONTAINER_IS_EMPTY;
+    }
+    *out = to_entry(leftmost(object->root)->entries[0]);
+    return 0;
+}
+
+int coral_btree_container_last(
+        const struct coral_btree_container *const object,
+        struct coral_btree_container_entry **const out) {
+    if (!object) {
+        return CORAL_BTREE_CONTAINER_ERROR_OBJECT_IS_NULL;
+    }
+    if (!out) {
+        return CORAL_BTREE_CONTAINER_ERROR_OUT_IS_NULL;
+    }
+    if (!object->root) {
+        return CORAL_BTREE_CONTAINER_ERROR_CONTAINER_IS_EMPTY;
+    }
+    const struct leaf *const leaf = rightmost(object->root);
+    *out = to_entry(leaf->entries[leaf->node.count - 1]);
+    return 0;
+}
+
+int coral_btree_container_next(
+        const struct coral_btree_container_entry *const entry,
+        struct coral_btree_container_entry **const out) {
+    if (!entry) {
+        return CORAL_BTREE_CONTAINER_ERROR_ENTRY_IS_NULL;
+    }
+    if (!out) {
+        return CORAL_BTREE_CONTAINER_ERROR_OUT_IS_NULL;
+    }
+    const struct entry *const A = rock_container_of(entry, struct entry, data);
+    seagrass_required_true(NULL != A->leaf);
+    if (at_or_after(A->leaf, 1 + A->index, out)) {
+        return CORAL_BTREE_CONTAINER_ERROR_END_OF_SEQUENCE;
+    }
+    return 0;
+}
+
+int coral_btree_container_prev(
+        const struct coral_btree_container_entry *const entry,
+        struct coral_btree_container_entry **const out) {
+    if (!entry) {
+        return CORAL_BTREE_CONTAINER_ERROR_ENTRY_IS_NULL;
+    }
+    if (!out) {
+        return CORAL_BTREE_CONTAINER_ERROR_OUT_IS_NULL;
+    }
+    const struct entry *const A = rock_container_of(entry, struct entry, data);
+    seagrass_required_true(NULL != A->leaf);
+    if (before(A->leaf, A->index, out)) {
+        return CORAL_BTREE_CONTAINER_ERROR_END_OF_SEQUENCE;
+    }
+    return 0;
+}
+
+int coral_btree_container_counters(
+        const struct coral_btree_container *const object,
+        struct coral_counters *const out) {
+    if (!object) {
+        return CORAL_BTREE_CONTAINER_ERROR_OBJECT_IS_NULL;
+    }
+    if (!out) {
+        return CORAL_BTREE_CONTAINER_ERROR_OUT_IS_NULL;
+    }
+    coral_counters_snapshot(object, out);
+    return 0;
+}
+
+int coral_btree_container_counters_reset(
+        struct coral_btree_container *const object) {
+    if (!object) {
+        return CORAL_BTREE_CONTAINER_ERROR_OBJECT_IS_NULL;
+    }
+    coral_counters_reset(object);
+    return 0;
+}
@@ -0,0 +1,335 @@
+#include <stdlib.h>
+#include <seagrass.h>
+#include <coral.h>
+
+#include "counters.h"
+
+#ifdef TEST
+#include <test/cmocka.h>
+#endif
+
+/* set in the link out of an item once that item is being removed */
+#define MARK ((uintptr_t) 1)
+
+struct coral_concurrent_linked_list_item {
+    void *data;
+};
+
+struct item {
+    atomic_uintptr_t next;
+    const struct coral_allocator *allocator;
+    unsigned char data[];
+};
+
+static uintptr_t load(atomic_uintptr_t *const link) {
+    return atomic_load_explicit(link, memory_order_acquire);
+}
+
+int coral_concurrent_linked_list_alloc_with(
+        const struct coral_allocator *allocator,
+        const size_t size,
+        struct coral_concurrent_linked_list_item **const out) {
+    if (!size) {
+        return CORAL_CONCURRENT_LINKED_LIST_ERROR_SIZE_IS_ZERO;
+    }
+    if (!out) {
+        return CORAL_CONCURRENT_LINKED_LIST_ERROR_OUT_IS_NULL;
+    }
+    int error;
+    uintmax_t alloc;
+    if ((error = seagrass_uintmax_t_add(size, sizeof(struct item), &alloc))
+        || alloc > SIZE_MAX) {
+        seagrass_required_true(SEAGRASS_UINTMAX_T_ERROR_RESULT_IS_INCONSISTENT
+                               == error || !error);
+        return CORAL_CONCURRENT_LINKED_LIST_ERROR_SIZE_IS_TOO_LARGE;
+    }
+    if (!allocator) {
+        seagrass_required_true(!coral_allocator_get_default(&allocator));
+    }
+    struct item *item;
+    if (allocator->alloc(allocator->context, sizeof(void *), alloc,
+                         (void **) &item)) {
+        return CORAL_CONCURRENT_LINKED_LIST_ERROR_MEMORY_ALLOCATION_FAILED;
+    }
+    atomic_init(&item->next, 0);
+    item->allocator = allocator;
+    coral_allocation_counters_alloc();
+    *out = (struct coral_concurrent_linked_list_item *) &item->data;
+    return 0;
+}
+
+int coral_concurrent_linked_list_alloc(
+        const size_t size,
+        struct coral_concurrent_linked_list_item **const out) {
+    return coral_concurrent_linked_list_alloc_with(NULL, size, out);
+}
+
+int coral_concurrent_linked_list_free(
+        struct coral_concurrent_linked_list_item *const item) {
+    if (!item) {
+        return CORAL_CONCURRENT_LINKED_LIST_ERROR_ITEM_IS_NULL;
+    }
+    struct item *const A = rock_container_of(item, struct item, data);
+    coral_allocation_counters_free();
+    A->allocator->free(A->allocator->context, A);
+    return 0;
+}
+
+static void retired(void *const item) {
+    seagrass_required_true(!coral_concurrent_linked_list_free(item));
+}
+
+int coral_concurrent_linked_list_retire(
+        struct coral_epoch_thread *const thread,
+        struct coral_concurrent_linked_list_item *const item) {
+    if (!thread) {
+        return CORAL_CONCURRENT_LINKED_LIST_ERROR_THREAD_IS_NULL;
+    }
+    if (!item) {
+        return CORAL_CONCURRENT_LINKED_LIST_ERROR_ITEM_IS_NULL;
+    }
+    return coral_epoch_defer(thread, item, retired);
+}
+
+int coral_concurrent_linked_list_init(
+        struct coral_concurrent_linked_list *const object,
+        int (*const compare)(const void *first,
+                             const void *second)) {
+    if (!object) {
+        return CORAL_CONCURRENT_LINKED_LIST_ERROR_OBJECT_IS_NULL;
+    }
+    if (!compare) {
+        return CORAL_CONCURRENT_LINKED_LIST_ERROR_COMPARE_IS_NULL;
+    }
+    *object = (struct coral_concurrent_linked_list) {
+            .compare = compare
+    };
+    atomic_init(&object->head, 0);
+    atomic_init(&object->count, 0);
+    return 0;
+}
+
+int coral_concurrent_linked_list_invalidate(
+        struct coral_concurrent_linked_list *const object,
+        void (*const on_destroy)(
+                struct coral_concurrent_linked_list_item *item)) {
+    if (!object) {
+        return CORAL_CONCURRENT_LINKED_LIST_ERROR_OBJECT_IS_NULL;
+    }
+    uintptr_t link = load(&object->head);
+    while (link) {
+        struct item *const A = (struct item *) link;
+        link = load(&A->next);
+        /* a marked item belongs to the thread that removed it */
+        if (link & MARK) {
+            link &= ~MARK;
+            continue;
+        }
+        struct coral_concurrent_linked_list_item *const item
+                = (struct coral_concurrent_linked_list_item *) &A->data;
+        if (on_destroy) {
+            on_destroy(item);
+        }
+        seagrass_required_true(!coral_concurrent_linked_list_free(item));
+    }
+    *object = (struct coral_concurrent_linked_list) {0};
+    return 0;
+}
+
+int coral_concurrent_linked_list_count(
+        const struct coral_concurrent_linked_list *const object,
+        uintmax_t *const out) {
+    if (!object) {
+        return CORAL_CONCURRENT_LINKED_LIST_ERROR_OBJECT_IS_NULL;
+    }
+    if (!out) {
+        return CORAL_CONCURRENT_LINKED_LIST_ERROR_OUT_IS_NULL;
+    }
+    *out = atomic_load_explicit(
+            &((struct coral_concurrent_linked_list *) object)->count,
+            memory_order_relaxed);
+    return 0;
+}
+
+/* Fill pred with the link leading to the first item at or after key and
+ * return that item, unlinking on the way the items that are being removed.
+ * Sets order to how that item compares with key. */
+static struct item *find(struct coral_concurrent_linked_list *const object,
+                         const void *const key,
+                         atomic_uintptr_t **const pred,
+                         int *const order) {
+    retry:;
+    atomic_uintptr_t *P = &object->head;
+    uintptr_t link = load(P);
+    for (*order = 1;; P = &((struct item *) link)->next, link = load(P)) {
+        /* the item before is itself being removed so we can no longer
+         * link after it, start over */
+        if (link & MARK) {
+            goto retry;
+        }
+        struct item *C;
+        while ((C = (struct item *) link)) {
+            const uintptr_t next = load(&C->next);
+            if (!(next & MARK)) {
+                break;
+            }
+            if (!atomic_compare_exchange_strong_explicit(
+                    P, &link, next & ~MARK,
+                    memory_order_acq_rel, memory_order_acquire)) {
+                goto retry;
+            }
+            link = next & ~MARK;
+        }
+        if (!C || (*order = object->compare(&C->data, key)) >= 0) {
+            *pred = P;
+            return C;
+        }
+    }
+}
+
+int coral_concurrent_linked_list_add(
+        struct coral_concurrent_linked_list *const object,
+        const struct coral_concurrent_linked_list_item *const item) {
+    if (!object) {
+        return CORAL_CONCURRENT_LINKED_LIST_ERROR_OBJECT_IS_NULL;
+    }
+    if (!item) {
+        return CORAL_CONCURRENT_LINKED_LIST_ERROR_ITEM_IS_NULL;
+    }
+    struct item *const A = rock_container_of(item, struct item, data);
+    for (;;) {
+        atomic_uintptr_t *pred;
+        int order;
+        struct item *const C = find(object, &A->data, &pred, &order);
+        if (C && !order) {
+            return CORAL_CONCURRENT_LINKED_LIST_ERROR_ITEM_ALREADY_EXISTS;
+        }
+        atomic_store_explicit(&A->next, (uintptr_t) C, memory_order_relaxed);
+        uintptr_t link = (uintptr_t) C;
+        if (atomic_compare_exchange_strong_explicit(
+                pred, &link, (uintptr_t) A,
+                memory_order_acq_rel, memory_order_relaxed)) {
+            break;
+        }
+    }
+    atomic_fetch_add_explicit(&object->count, 1, memory_order_relaxed);
+    return 0;
+}
+
+int coral_concurrent_linked_list_remove(
+        struct coral_concurrent_linked_list *const object,
+        const struct coral_concurrent_linked_list_item *const item) {
+    if (!object) {
+        return CORAL_CONCURRENT_LINKED_LIST_ERROR_OBJECT_IS_NULL;
+    }
+    if (!item) {
+        return CORAL_CONCURRENT_LINKED_LIST_ERROR_ITEM_IS_NULL;
+    }
+    struct item *const A = rock_container_of(item, struct item, data);
+    atomic_uintptr_t *pred;
+    int order;
+    if (find(object, &A->data, &pred, &order) != A) {
+        return CORAL_CONCURRENT_LINKED_LIST_ERROR_ITEM_NOT_FOUND;
+    }
+    /* whoever marks the link out of A is the one removing A, no item can be
+     * linked after A from then on */
+    uintptr_t link = load(&A->next);
+    do {
+        if (link & MARK) {
+            return CORAL_CONCURRENT_LINKED_LIST_ERROR_ITEM_NOT_FOUND;
+        }
+    } while (!atomic_compare_exchange_weak_explicit(
+            &A->next, &link, link | MARK,
+            memory_order_acq_rel, memory_order_acquire));
+    atomic_fetch_sub_explicit(&object->count, 1, memory_order_relaxed);
+    /* unlink A ourselves or have find walk past it, either way A is no longer
+     * reachable once we return and may be retired */
+    uintptr_t expected = (uintptr_t) A;
+    if (!atomic_compare_exchange_strong_explicit(
+            pred, &expected, link,
+            memory_order_acq_rel, memory_order_relaxed)) {
+        find(object, &A->data, &pred, &order);
+    }
+    return 0;
+}
+
+/* First item from link on that is not being removed. Lookups skip the items
+ * being removed but leave them for add and remove to unlink so that they
+ * never write to the linked list. */
+static struct item *live(uintptr_t link) {
+    struct item *C;
+    while ((C = (struct item *) (link & ~MARK))) {
+        link = load(&C->next);
+        if (!(link & MARK)) {
+            break;
+        }
+    }
+    return C;
+}
+
+int coral_concurrent_linked_list_get(
+        const struct coral_concurrent_linked_list *const object,
+        const void *const key,
+        struct coral_concurrent_linked_list_item **const out) {
+    if (!object) {
+        return CORAL_CONCURRENT_LINKED_LIST_ERROR_OBJECT_IS_NULL;
+    }
+    if (!key) {
+        return CORAL_CONCURRENT_LINKED_LIST_ERROR_KEY_IS_NULL;
+    }
+    if (!out) {
+        return CORAL_CONCURRENT_LINKED_LIST_ERROR_OUT_IS_NULL;
+    }
+    atomic_uintptr_t *const head
+            = &((struct coral_concurrent_linked_list *) object)->head;
+    int order = 1;
+    struct item *C = live(load(head));
+    while (C && (order = object->compare(&C->data, key)) < 0) {
+        C = live(load(&C->next));
+    }
+    if (!C || order) {
+        return CORAL_CONCURRENT_LINKED_LIST_ERROR_ITEM_NOT_FOUND;
+    }
+    *out = (struct coral_concurrent_linked_list_item *) &C->data;
+    return 0;
+}
+
+int coral_concurrent_linked_list_first(
+        const struct coral_concurrent_linked_list *const object,
+        struct coral_concurrent_linked_list_item **const out) {
+    if (!object) {
+        return CORAL_CONCURRENT_LINKED_LIST_ERROR_OBJECT_IS_NULL;
+    }
+    if (!out) {
+        return CORAL_CONCURRENT_LINKED_LIST_ERROR_OUT_IS_NULL;
+    }
+    struct item *const C = live(load(
+            &((struct coral_concurrent_linked_list *) object)->head));
+    if (!C) {
+        return CORAL_CONCURRENT_LINKED_LIST_ERROR_LIST_IS_EMPTY;
+    }
+    *out = (struct coral_concurrent_linked_list_item *) &C->data;
+    return 0;
+}
+
+int coral_concurrent_linked_list_next(
+        const struct coral_concurrent_linked_list *const object,
+        const struct coral_concurrent_linked_list_item *const item,
+        struct coral_concurrent_linked_list_item **const out) {
+    if (!object) {
+        return CORAL_CONCURRENT_LINKED_LIST_ERROR_OBJECT_IS_NULL;
+    }
+    if (!item) {
+        return CORAL_CONCURRENT_LINKED_LIST_ERROR_ITEM_IS_NULL;
+    }
+    if (!out) {
+        return CORAL_CONCURRENT_LINKED_LIST_ERROR_OUT_IS_NULL;
+    }
+    struct item *const A = rock_container_of(item, struct item, data);
+    struct item *const C = live(load(&A->next));
+    if (!C) {
+        return CORAL_CONCURRENT_LINKED_LIST_ERROR_END_OF_SEQUENCE;
+    }
+    *out = (struct coral_concurrent_linked_list_item *) &C->data;
+    return 0;
+}
@@ -0,0 +1,286 @@
+#include <stdlib.h>
+#include <seagrass.h>
+#include <coral.h>
+
+#include "reader_writer_lock.h"
+
+#ifdef TEST
+#include <test/cmocka.h>
+#endif
+
+/* Readers only change the lock, which lives in the container so that there
+ * is nothing to allocate per call, hence the lookups cast away the const. */
+static struct coral_reader_writer_lock *lock_of(
+        const struct coral_concurrent_red_black_tree_container *const object) {
+    return (struct coral_reader_writer_lock *) &object->lock;
+}
+
+/* the lock only fails when memory runs out, which shares its error code */
+static int init_lock(
+        struct coral_concurrent_red_black_tree_container *const object) {
+    int error;
+    if ((error = coral_reader_writer_lock_init(&object->lock))) {
+        seagrass_required_true(!coral_red_black_tree_container_invalidate(
+                &object->container, NULL));
+    }
+    return error;
+}
+
+int coral_concurrent_red_black_tree_container_init(
+        struct coral_concurrent_red_black_tree_container *const object,
+        int (*const compare)(const void *first,
+                             const void *second)) {
+    if (!object) {
+        return CORAL_CONCURRENT_RED_BLACK_TREE_CONTAINER_ERROR_OBJECT_IS_NULL;
+    }
+    int error;
+    if ((error = coral_red_black_tree_container_init(
+            &object->container, compare))) {
+        return error;
+    }
+    return init_lock(object);
+}
+
+int coral_concurrent_red_black_tree_container_init_with_key(
+        struct coral_concurrent_red_black_tree_container *const object,
+        int (*const compare)(const void *first,
+                             const void *second),
+        int (*const compare_key)(const void *key,
+                                 const void *entry)) {
+    if (!object) {
+        return CORAL_CONCURRENT_RED_BLACK_TREE_CONTAINER_ERROR_OBJECT_IS_NULL;
+    }
+    int error;
+    if ((error = coral_red_black_tree_container_init_with_key(
+            &object->container, compare, compare_key))) {
+        return error;
+    }
+    return init_lock(object);
+}
+
+int coral_concurrent_red_black_tree_container_invalidate(
+        struct coral_concurrent_red_black_tree_container *const object,
+        void (*const on_destroy)(
+                struct coral_red_black_tree_container_entry *entry)) {
+    if (!object) {
+        return CORAL_CONCURRENT_RED_BLACK_TREE_CONTAINER_ERROR_OBJECT_IS_NULL;
+    }
+    seagrass_required_true(!coral_red_black_tree_container_invalidate(
+            &object->container, on_destroy));
+    coral_reader_writer_lock_invalidate(&object->lock);
+    return 0;
+}
+
+int coral_concurrent_red_black_tree_container_count(
+        const struct coral_concurrent_red_black_tree_container *const object,
+        uintmax_t *const out) {
+    if (!object) {
+        return CORAL_CONCURRENT_RED_BLACK_TREE_CONTAINER_ERROR_OBJECT_IS_NULL;
+    }
+    coral_reader_writer_lock_read(lock_of(object));
+    const int error = coral_red_black_tree_container_count(
+            &object->container, out);
+    coral_reader_writer_lock_read_unlock(lock_of(object));
+    return error;
+}
+
+int coral_concurrent_red_black_tree_container_add(
+        struct coral_concurrent_red_black_tree_container *const object,
+        const struct coral_red_black_tree_container_entry *const entry) {
+    if (!object) {
+        return CORAL_CONCURRENT_RED_BLACK_TREE_CONTAINER_ERROR_OBJECT_IS_NULL;
+    }
+    coral_reader_writer_lock_write(&object->lock);
+    const int error = coral_red_black_tree_container_add(
+            &object->container, entry);
+    coral_reader_writer_lock_write_unlock(&object->lock);
+    return error;
+}
+
+int coral_concurrent_red_black_tree_container_remove(
+        struct coral_concurrent_red_black_tree_container *const object,
+        const struct coral_red_black_tree_container_entry *const entry) {
+    if (!object) {
+        return CORAL_CONCURRENT_RED_BLACK_TREE_CONTAINER_ERROR_OBJECT_IS_NULL;
+    }
+    coral_reader_writer_lock_write(&object->lock);
+    const int error = coral_red_black_tree_container_remove(
+            &object->container, entry);
+    coral_reader_writer_lock_write_unlock(&object->lock);
+    return error;
+}
+
+int coral_concurrent_red_black_tree_container_get(
+        const struct coral_concurrent_red_black_tree_container *const object,
+        const void *const key,
+        struct coral_red_black_tree_container_entry **const out) {
+    if (!object) {
+        return CORAL_CONCURRENT_RED_BLACK_TREE_CONTAINER_ERROR_OBJECT_IS_NULL;
+    }
+    coral_reader_writer_lock_read(lock_of(object));
+    const int error = coral_red_black_tree_container_get(
+            &object->container, key, out);
+    coral_reader_writer_lock_read_unlock(lock_of(object));
+    return error;
+}
+
+int coral_concurrent_red_black_tree_container_get_key(
+        const struct coral_concurrent_red_black_tree_container *const object,
+        const void *const key,
+        struct coral_red_black_tree_container_entry **const out) {
+    if (!object) {
+        return CORAL_CONCURRENT_RED_BLACK_TREE_CONTAINER_ERROR_OBJECT_IS_NULL;
+    }
+    coral_reader_writer_lock_read(lock_of(object));
+    const int error = coral_red_black_tree_container_get_key(
+            &object->container, key, out);
+    coral_reader_writer_lock_read_unlock(lock_of(object));
+    return error;
+}
+
+int coral_concurrent_red_black_tree_container_ceiling(
+        const struct coral_concurrent_red_black_tree_container *const object,
+        const void *const key,
+        struct coral_red_black_tree_container_entry **const out) {
+    if (!object) {
+        return CORAL_CONCURRENT_RED_BLACK_TREE_CONTAINER_ERROR_OBJECT_IS_NULL;
+    }
+    coral_reader_writer_lock_read(lock_of(object));
+    const int error = coral_red_black_tree_container_ceiling(
+            &object->container, key, out);
+    coral_reader_writer_lock_read_unlock(lock_of(object));
+    return error;
+}
+
+int coral_concurrent_red_black_tree_container_ceiling_key(
+        const struct coral_concurrent_red_black_tree_container *const object,
+        const void *const key,
+        struct coral_red_black_tree_container_entry **const out) {
+    if (!object) {
+        return CORAL_CONCURRENT_RED_BLACK_TREE_CONTAINER_ERROR_OBJECT_IS_NULL;
+    }
+    coral_reader_writer_lock_read(lock_of(object));
+    const int error = coral_red_black_tree_container_ceiling_key(
+            &object->container, key, out);
+    coral_reader_writer_lock_read_unlock(lock_of(object));
+    return error;
+}
+
+int coral_concurrent_red_black_tree_container_floor(
+        const struct coral_concurrent_red_black_tree_container *const object,
+        const void *const key,
+        struct coral_red_black_tree_container_entry **const out) {
+    if (!object) {
+        return CORAL_CONCURRENT_RED_BLACK_TREE_CONTAINER_ERROR_OBJECT_IS_NULL;
+    }
+    coral_reader_writer_lock_read(lock_of(object));
+    const int error = coral_red_black_tree_container_floor(
+            &object->container, key, out);
+    coral_reader_writer_lock_read_unlock(lock_of(object));
+    return error;
+}
+
+int coral_concurrent_red_black_tree_container_floor_key(
+        const struct coral_concurrent_red_black_tree_container *const object,
+        const void *const key,
+        struct coral_red_black_tree_container_entry **const out) {
+    if (!object) {
+        return CORAL_CONCURRENT_RED_BLACK_TREE_CONTAINER_ERROR_OBJECT_IS_NULL;
+    }
+    coral_reader_writer_lock_read(lock_of(object));
+    const int error = coral_red_black_tree_container_floor_key(
+            &object->container, key, out);
+    coral_reader_writer_lock_read_unlock(lock_of(object));
+    return error;
+}
+
+int coral_concurrent_red_black_tree_container_higher(
+        const struct coral_concurrent_red_black_tree_container *const object,
+        const void *const key,
+        struct coral_red_black_tree_container_entry **const out) {
+    if (!object) {
+        return CORAL_CONCURRENT_RED_BLACK_TREE_CONTAINER_ERROR_OBJECT_IS_NULL;
+    }
+    coral_reader_writer_lock_read(lock_of(object));
+    const int error = coral_red_black_tree_container_higher(
+            &object->container, key, out);
+    coral_reader_writer_lock_read_unlock(lock_of(object));
+    return error;
+}
+
+int coral_concurrent_red_black_tree_container_higher_key(
+        const struct coral_concurrent_red_black_tree_container *const object,
+        const void *const key,
+        struct coral_red_black_tree_container_entry **const out) {
+    if (!object) {
+        return CORAL_CONCURRENT_RED_BLACK_TREE_CONTAINER_ERROR_OBJECT_IS_NULL;
+    }
+    coral_reader_writer_lock_read(lock_of(object));
+    const int error = coral_red_black_tree_container_higher_key(
+            &object->container, key, out);
+    coral_reader_writer_lock_read_unlock(lock_of(object));
+    return error;
+}
+
+int coral_concurrent_red_black_tree_container_lower(
+        const struct coral_concurrent_red_black_tree_container *const object,
+        const void *const key,
+        struct coral_red_black_tree_container_entry **const out) {
+    if (!object) {
+        return CORAL_CONCURRENT_RED_BLACK_TREE_CONTAINER_ERROR_OBJECT_IS_NULL;
+    }
+    coral_reader_writer_lock_read(lock_of(object));
+    const int error = coral_red_black_tree_container_lower(
+            &object->container, key, out);
+    coral_reader_writer_lock_read_unlock(lock_of(object));
+    return error;
+}
+
+int coral_concurrent_red_black_tree_container_lower_key(
+        const struct coral_concurrent_red_black_tree_container *const object,
+        const void *const key,
+        struct coral_red_black_tree_container_entry **const out) {
+    if (!object) {
+        return CORAL_CONCURRENT_RED_BLACK_TREE_CONTAINER_ERROR_OBJECT_IS_NULL;
+    }
+    coral_reader_writer_lock_read(lock_of(object));
+    const int error = coral_red_black_tree_container_lower_key(
+            &object->container, key, out);
+    coral_reader_writer_lock_read_unlock(lock_of(object));
+    return error;
+}
+
+int coral_concurrent_red_black_tree_container_read(
+        const struct coral_concurrent_red_black_tree_container *const object,
+        int (*const function)(
+                const struct coral_red_black_tree_container *container,
+                void *context),
+        void *const context) {
+    if (!object) {
+        return CORAL_CONCURRENT_RED_BLACK_TREE_CONTAINER_ERROR_OBJECT_IS_NULL;
+    }
+    if (!function) {
+        return CORAL_CONCURRENT_RED_BLACK_TREE_CONTAINER_ERROR_FUNCTION_IS_NULL;
+    }
+    coral_reader_writer_lock_read(lock_of(object));
+    const int error = function(&object->container, context);
+    coral_reader_writer_lock_read_unlock(lock_of(object));
+    return error;
+}
+
+int coral_concurrent_red_black_tree_container_write(
+        struct coral_concurrent_red_black_tree_container *const object,
+        int (*const function)(struct coral_red_black_tree_container *container,
+                              void *context),
+        void *const context) {
+    if (!object) {
+        return CORAL_CONCURRENT_RED_BLACK_TREE_CONTAINER_ERROR_OBJECT_IS_NULL;
+    }
+    if (!function) {
+        return CORAL_CONCURRENT_RED_BLACK_TREE_CONTAINER_ERROR_FUNCTION_IS_NULL;
+    }
+    coral_reader_writer_lock_write(&object->lock);
+    const int error = function(&object->container, context);
+    coral_reader_writer_lock_write_unlock(&object->lock);
+    return error;
+}
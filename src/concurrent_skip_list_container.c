@@ -0,0 +1,575 @@
+#include <stdlib.h>
+#include <seagrass.h>
+#include <coral.h>
+
+#include "counters.h"
+
+#ifdef TEST
+#include <test/cmocka.h>
+#endif
+
+#define HEIGHT CORAL_CONCURRENT_SKIP_LIST_CONTAINER_MAXIMUM_HEIGHT
+/* set in the link out of an entry once that entry is being removed */
+#define MARK ((uintptr_t) 1)
+
+struct coral_concurrent_skip_list_container_entry {
+    void *data;
+};
+
+/* The links out of an entry, one per level, are stored right before it so
+ * that an entry only takes as many links as it has levels. */
+struct entry {
+    const struct coral_allocator *allocator;
+    size_t height;
+    atomic_size_t linking;
+    unsigned char data[];
+};
+
+static atomic_uintptr_t *links_of(const struct entry *const A) {
+    return (atomic_uintptr_t *) A - A->height;
+}
+
+static atomic_uintptr_t *head_of(
+        const struct coral_concurrent_skip_list_container *const object) {
+    return (atomic_uintptr_t *) object->head;
+}
+
+static uintptr_t load(atomic_uintptr_t *const link) {
+    return atomic_load_explicit(link, memory_order_acquire);
+}
+
+/* Each thread draws heights from a xorshift generator of its own, each level
+ * above the first is kept with a chance of one in four. */
+static atomic_uint_fast64_t seeds;
+static _Thread_local uint64_t seed;
+
+static size_t random_height(void) {
+    if (!seed) {
+        seed = (1 + atomic_fetch_add_explicit(&seeds, 1,
+                                              memory_order_relaxed))
+               * UINT64_C(0x9E3779B97F4A7C15);
+    }
+    seed ^= seed << 13;
+    seed ^= seed >> 7;
+    seed ^= seed << 17;
+    size_t height = 1;
+    for (uint64_t bits = seed; height < HEIGHT && !(bits & 3); bits >>= 2) {
+        height++;
+    }
+    return height;
+}
+
+int coral_concurrent_skip_list_container_alloc_with(
+        const struct coral_allocator *allocator,
+        const size_t size,
+        struct coral_concurrent_skip_list_container_entry **const out) {
+    if (!size) {
+        return CORAL_CONCURRENT_SKIP_LIST_CONTAINER_ERROR_SIZE_IS_ZERO;
+    }
+    if (!out) {
+        return CORAL_CONCURRENT_SKIP_LIST_CONTAINER_ERROR_OUT_IS_NULL;
+    }
+    const size_t height = random_height();
+    int error;
+    uintmax_t alloc;
+    if ((error = seagrass_uintmax_t_add(
+            size, sizeof(struct entry) + height * sizeof(atomic_uintptr_t),
+            &alloc))
+        || alloc > SIZE_MAX) {
+        seagrass_required_true(SEAGRASS_UINTMAX_T_ERROR_RESULT_IS_INCONSISTENT
+                               == error || !error);
+        return CORAL_CONCURRENT_SKIP_LIST_CONTAINER_ERROR_SIZE_IS_TOO_LARGE;
+    }
+    if (!allocator) {
+        seagrass_required_true(!coral_allocator_get_default(&allocator));
+    }
+    atomic_uintptr_t *links;
+    if (allocator->alloc(allocator->context, sizeof(void *), alloc,
+                         (void **) &links)) {
+        return CORAL_CONCURRENT_SKIP_LIST_CONTAINER_ERROR_MEMORY_ALLOCATION_FAILED;
+    }
+    for (size_t i = 0; i < height; i++) {
+        atomic_init(&links[i], 0);
+    }
+    struct entry *const entry = (struct entry *) &links[height];
+    entry->allocator = allocator;
+    entry->height = height;
+    atomic_init(&entry->linking, 0);
+    coral_allocation_counters_alloc();
+    *out = (struct coral_concurrent_skip_list_container_entry *) &entry->data;
+    return 0;
+}
+
+int coral_concurrent_skip_list_container_alloc(
+        const size_t size,
+        struct coral_concurrent_skip_list_container_entry **const out) {
+    return coral_concurrent_skip_list_container_alloc_with(NULL, size, out);
+}
+
+int coral_concurrent_skip_list_container_free(
+        struct coral_concurrent_skip_list_container_entry *const entry) {
+    if (!entry) {
+        return CORAL_CONCURRENT_SKIP_LIST_CONTAINER_ERROR_ENTRY_IS_NULL;
+    }
+    struct entry *const A = rock_container_of(entry, struct entry, data);
+    coral_allocation_counters_free();
+    A->allocator->free(A->allocator->context, links_of(A));
+    return 0;
+}
+
+static void retired(void *const entry) {
+    seagrass_required_true(!coral_concurrent_skip_list_container_free(entry));
+}
+
+/* An add still linking the entry on its upper levels may have linked it back
+ * in, it unlinks the entry itself before it is done. Freeing waits until the
+ * epoch has moved on twice since then. */
+static void linked(void *const entry) {
+    const struct entry *const A = rock_container_of(entry, struct entry, data);
+    seagrass_required_true(!coral_epoch_defer_again(
+            entry, atomic_load_explicit(&A->linking, memory_order_acquire)
+                   ? linked : retired));
+}
+
+int coral_concurrent_skip_list_container_retire(
+        struct coral_epoch_thread *const thread,
+        struct coral_concurrent_skip_list_container_entry *const entry) {
+    if (!thread) {
+        return CORAL_CONCURRENT_SKIP_LIST_CONTAINER_ERROR_THREAD_IS_NULL;
+    }
+    if (!entry) {
+        return CORAL_CONCURRENT_SKIP_LIST_CONTAINER_ERROR_ENTRY_IS_NULL;
+    }
+    const struct entry *const A = rock_container_of(entry, struct entry, data);
+    return coral_epoch_defer(
+            thread, entry,
+            atomic_load_explicit(&A->linking, memory_order_acquire)
+            ? linked : retired);
+}
+
+int coral_concurrent_skip_list_container_init(
+        struct coral_concurrent_skip_list_container *const object,
+        int (*const compare)(const void *first,
+                             const void *second)) {
+    if (!object) {
+        return CORAL_CONCURRENT_SKIP_LIST_CONTAINER_ERROR_OBJECT_IS_NULL;
+    }
+    if (!compare) {
+        return CORAL_CONCURRENT_SKIP_LIST_CONTAINER_ERROR_COMPARE_IS_NULL;
+    }
+    object->compare = compare;
+    for (size_t i = 0; i < HEIGHT; i++) {
+        atomic_init(&object->head[i], 0);
+    }
+    atomic_init(&object->count, 0);
+    return 0;
+}
+
+int coral_concurrent_skip_list_container_invalidate(
+        struct coral_concurrent_skip_list_container *const object,
+        void (*const on_destroy)(
+                struct coral_concurrent_skip_list_container_entry *entry)) {
+    if (!object) {
+        return CORAL_CONCURRENT_SKIP_LIST_CONTAINER_ERROR_OBJECT_IS_NULL;
+    }
+    uintptr_t link = load(&object->head[0]);
+    while (link) {
+        struct entry *const A = (struct entry *) link;
+        link = load(&links_of(A)[0]);
+        /* a marked entry belongs to the thread that removed it */
+        if (link & MARK) {
+            link &= ~MARK;
+            continue;
+        }
+        struct coral_concurrent_skip_list_container_entry *const entry
+                = (struct coral_concurrent_skip_list_container_entry *)
+                        &A->data;
+        if (on_destroy) {
+            on_destroy(entry);
+        }
+        seagrass_required_true(!coral_concurrent_skip_list_container_free(
+                entry));
+    }
+    *object = (struct coral_concurrent_skip_list_container) {0};
+    return 0;
+}
+
+int coral_concurrent_skip_list_container_count(
+        const struct coral_concurrent_skip_list_container *const object,
+        uintmax_t *const out) {
+    if (!object) {
+        return CORAL_CONCURRENT_SKIP_LIST_CONTAINER_ERROR_OBJECT_IS_NULL;
+    }
+    if (!out) {
+        return CORAL_CONCURRENT_SKIP_LIST_CONTAINER_ERROR_OUT_IS_NULL;
+    }
+    *out = atomic_load_explicit(
+            &((struct coral_concurrent_skip_list_container *) object)->count,
+            memory_order_relaxed);
+    return 0;
+}
+
+/* Fill preds with the links leading to and succs with the entries at or
+ * after key on every level, unlinking on the way the entries that are being
+ * removed. True if succs[0] is equal to key. */
+static bool find(struct coral_concurrent_skip_list_container *const object,
+                 const void *const key,
+                 atomic_uintptr_t **const preds,
+                 struct entry **const succs) {
+    retry:;
+    atomic_uintptr_t *pred = object->head;
+    int order = 1;
+    for (size_t level = HEIGHT; level--;) {
+        uintptr_t link = load(&pred[level]);
+        for (order = 1;;) {
+            /* pred itself is being removed so we can no longer link after
+             * it, start over */
+            if (link & MARK) {
+                goto retry;
+            }
+            struct entry *const C = (struct entry *) link;
+            if (!C) {
+                break;
+            }
+            const uintptr_t next = load(&links_of(C)[level]);
+            if (next & MARK) {
+                if (!atomic_compare_exchange_strong_explicit(
+                        &pred[level], &link, next & ~MARK,
+                        memory_order_acq_rel, memory_order_acquire)) {
+                    goto retry;
+                }
+                link = next & ~MARK;
+                continue;
+            }
+            if ((order = object->compare(&C->data, key)) >= 0) {
+                break;
+            }
+            pred = links_of(C);
+            link = next;
+        }
+        preds[level] = pred;
+        succs[level] = (struct entry *) link;
+    }
+    return !order;
+}
+
+/* Link A on its upper levels, giving up as soon as A is being removed. */
+static void link_above(
+        struct coral_concurrent_skip_list_container *const object,
+        struct entry *const A,
+        atomic_uintptr_t **const preds,
+        struct entry **const succs) {
+    atomic_uintptr_t *const links = links_of(A);
+    for (size_t level = 1; level < A->height; level++) {
+        for (;;) {
+            uintptr_t link = (uintptr_t) succs[level];
+            if (atomic_compare_exchange_strong_explicit(
+                    &preds[level][level], &link, (uintptr_t) A,
+                    memory_order_acq_rel, memory_order_relaxed)) {
+                break;
+            }
+            find(object, &A->data, preds, succs);
+            if (succs[0] != A) {
+                return;
+            }
+            link = load(&links[level]);
+            if (link == (uintptr_t) succs[level]) {
+                continue;
+            }
+            if ((link & MARK) || !atomic_compare_exchange_strong_explicit(
+                    &links[level], &link, (uintptr_t) succs[level],
+                    memory_order_acq_rel, memory_order_relaxed)) {
+                return;
+            }
+        }
+        /* the remover may have unlinked A before we linked it here, walk
+         * past A so that it does not stay behind */
+        if (load(&links[level]) & MARK) {
+            find(object, &A->data, preds, succs);
+            return;
+        }
+    }
+}
+
+int coral_concurrent_skip_list_container_add(
+        struct coral_concurrent_skip_list_container *const object,
+        const struct coral_concurrent_skip_list_container_entry *const entry) {
+    if (!object) {
+        return CORAL_CONCURRENT_SKIP_LIST_CONTAINER_ERROR_OBJECT_IS_NULL;
+    }
+    if (!entry) {
+        return CORAL_CONCURRENT_SKIP_LIST_CONTAINER_ERROR_ENTRY_IS_NULL;
+    }
+    struct entry *const A = rock_container_of(entry, struct entry, data);
+    atomic_uintptr_t *const links = links_of(A);
+    atomic_uintptr_t *preds[HEIGHT];
+    struct entry *succs[HEIGHT];
+    /* published along with A by linking it on the first level */
+    atomic_store_explicit(&A->linking, 1, memory_order_relaxed);
+    for (;;) {
+        if (find(object, &A->data, preds, succs)) {
+            atomic_store_explicit(&A->linking, 0, memory_order_relaxed);
+            return CORAL_CONCURRENT_SKIP_LIST_CONTAINER_ERROR_ENTRY_ALREADY_EXISTS;
+        }
+        for (size_t level = 0; level < A->height; level++) {
+            atomic_store_explicit(&links[level], (uintptr_t) succs[level],
+                                  memory_order_relaxed);
+        }
+        uintptr_t link = (uintptr_t) succs[0];
+        /* once linked on the first level A is in the container */
+        if (atomic_compare_exchange_strong_explicit(
+                &preds[0][0], &link, (uintptr_t) A,
+                memory_order_acq_rel, memory_order_relaxed)) {
+            break;
+        }
+    }
+    atomic_fetch_add_explicit(&object->count, 1, memory_order_relaxed);
+    link_above(object, A, preds, succs);
+    atomic_store_explicit(&A->linking, 0, memory_order_release);
+    return 0;
+}
+
+int coral_concurrent_skip_list_container_remove(
+        struct coral_concurrent_skip_list_container *const object,
+        const struct coral_concurrent_skip_list_container_entry *const entry) {
+    if (!object) {
+        return CORAL_CONCURRENT_SKIP_LIST_CONTAINER_ERROR_OBJECT_IS_NULL;
+    }
+    if (!entry) {
+        return CORAL_CONCURRENT_SKIP_LIST_CONTAINER_ERROR_ENTRY_IS_NULL;
+    }
+    struct entry *const A = rock_container_of(entry, struct entry, data);
+    atomic_uintptr_t *const links = links_of(A);
+    atomic_uintptr_t *preds[HEIGHT];
+    struct entry *succs[HEIGHT];
+    if (!find(object, &A->data, preds, succs) || succs[0] != A) {
+        return CORAL_CONCURRENT_SKIP_LIST_CONTAINER_ERROR_ENTRY_NOT_FOUND;
+    }
+    for (size_t level = A->height; --level;) {
+        uintptr_t link = load(&links[level]);
+        while (!(link & MARK) && !atomic_compare_exchange_weak_explicit(
+                &links[level], &link, link | MARK,
+                memory_order_acq_rel, memory_order_acquire));
+    }
+    /* whoever marks the first level is the one removing A */
+    uintptr_t link = load(&links[0]);
+    do {
+        if (link & MARK) {
+            return CORAL_CONCURRENT_SKIP_LIST_CONTAINER_ERROR_ENTRY_NOT_FOUND;
+        }
+    } while (!atomic_compare_exchange_weak_explicit(
+            &links[0], &link, link | MARK,
+            memory_order_acq_rel, memory_order_acquire));
+    atomic_fetch_sub_explicit(&object->count, 1, memory_order_relaxed);
+    /* an add still linking A on its upper levels may link it back in after
+     * this, it unlinks A itself before it is done and retire waits for it */
+    find(object, &A->data, preds, succs);
+    return 0;
+}
+
+/* Entry after the last one which orders before key, or also equal to key if
+ * past is set, with pred receiving that last one. A NULL key orders after
+ * every entry. Entries being removed are skipped but left for add and remove
+ * to unlink so that lookups never write to the container. */
+static struct entry *search(
+        const struct coral_concurrent_skip_list_container *const object,
+        const void *const key,
+        const bool past,
+        struct entry **const pred) {
+    atomic_uintptr_t *links = head_of(object);
+    struct entry *P = NULL;
+    struct entry *C = NULL;
+    /* the entry that stopped the level above stops this one too */
+    const struct entry *bound = NULL;
+    for (size_t level = HEIGHT; level--; bound = C) {
+        uintptr_t link = load(&links[level]) & ~MARK;
+        while ((C = (struct entry *) link) && C != bound) {
+            const uintptr_t next = load(&links_of(C)[level]);
+            if (next & MARK) {
+                link = next & ~MARK;
+                continue;
+            }
+            if (key) {
+                const int order = object->compare(&C->data, key);
+                if (order > 0 || (!past && !order)) {
+                    break;
+                }
+            }
+            P = C;
+            links = links_of(C);
+            link = next;
+        }
+    }
+    if (pred) {
+        *pred = P;
+    }
+    return C;
+}
+
+static int lookup(
+        const struct coral_concurrent_skip_list_container *const object,
+        const void *const key,
+        const bool past,
+        const bool before,
+        struct coral_concurrent_skip_list_container_entry **const out) {
+    if (!object) {
+        return CORAL_CONCURRENT_SKIP_LIST_CONTAINER_ERROR_OBJECT_IS_NULL;
+    }
+    if (!key) {
+        return CORAL_CONCURRENT_SKIP_LIST_CONTAINER_ERROR_KEY_IS_NULL;
+    }
+    if (!out) {
+        return CORAL_CONCURRENT_SKIP_LIST_CONTAINER_ERROR_OUT_IS_NULL;
+    }
+    struct entry *P;
+    struct entry *const C = search(object, key, past, &P);
+    struct entry *const B = before ? P : C;
+    if (!B) {
+        return CORAL_CONCURRENT_SKIP_LIST_CONTAINER_ERROR_ENTRY_NOT_FOUND;
+    }
+    *out = (struct coral_concurrent_skip_list_container_entry *) &B->data;
+    return 0;
+}
+
+int coral_concurrent_skip_list_container_get(
+        const struct coral_concurrent_skip_list_container *const object,
+        const void *const key,
+        struct coral_concurrent_skip_list_container_entry **const out) {
+    if (!object) {
+        return CORAL_CONCURRENT_SKIP_LIST_CONTAINER_ERROR_OBJECT_IS_NULL;
+    }
+    if (!key) {
+        return CORAL_CONCURRENT_SKIP_LIST_CONTAINER_ERROR_KEY_IS_NULL;
+    }
+    if (!out) {
+        return CORAL_CONCURRENT_SKIP_LIST_CONTAINER_ERROR_OUT_IS_NULL;
+    }
+    struct entry *const B = search(object, key, false, NULL);
+    if (!B || object->compare(&B->data, key)) {
+        return CORAL_CONCURRENT_SKIP_LIST_CONTAINER_ERROR_ENTRY_NOT_FOUND;
+    }
+    *out = (struct coral_concurrent_skip_list_container_entry *) &B->data;
+    return 0;
+}
+
+int coral_concurrent_skip_list_container_ceiling(
+        const struct coral_concurrent_skip_list_container *const object,
+        const void *const key,
+        struct coral_concurrent_skip_list_container_entry **const out) {
+    return lookup(object, key, false, false, out);
+}
+
+int coral_concurrent_skip_list_container_floor(
+        const struct coral_concurrent_skip_list_container *const object,
+        const void *const key,
+        struct coral_concurrent_skip_list_container_entry **const out) {
+    return lookup(object, key, true, true, out);
+}
+
+int coral_concurrent_skip_list_container_higher(
+        const struct coral_concurrent_skip_list_container *const object,
+        const void *const key,
+        struct coral_concurrent_skip_list_container_entry **const out) {
+    return lookup(object, key, true, false, out);
+}
+
+int coral_concurrent_skip_list_container_lower(
+        const struct coral_concurrent_skip_list_container *const object,
+        const void *const key,
+        struct coral_concurrent_skip_list_container_entry **const out) {
+    return lookup(object, key, false, true, out);
+}
+
+/* First entry from link on that is not being removed. */
+static struct entry *live(uintptr_t link) {
+    struct entry *C;
+    while ((C = (struct entry *) link)) {
+        link = load(&links_of(C)[0]);
+        if (!(link & MARK)) {
+            break;
+        }
+        link &= ~MARK;
+    }
+    return C;
+}
+
+int coral_concurrent_skip_list_container_first(
+        const struct coral_concurrent_skip_list_container *const object,
+        struct coral_concurrent_skip_list_container_entry **const out) {
+    if (!object) {
+        return CORAL_CONCURRENT_SKIP_LIST_CONTAINER_ERROR_OBJECT_IS_NULL;
+    }
+    if (!out) {
+        return CORAL_CONCURRENT_SKIP_LIST_CONTAINER_ERROR_OUT_IS_NULL;
+    }
+    struct entry *const B = live(load(&head_of(object)[0]));
+    if (!B) {
+        return CORAL_CONCURRENT_SKIP_LIST_CONTAINER_ERROR_CONTAINER_IS_EMPTY;
+    }
+    *out = (struct coral_concurrent_skip_list_container_entry *) &B->data;
+    return 0;
+}
+
+int coral_concurrent_skip_list_container_last(
+        const struct coral_concurrent_skip_list_container *const object,
+        struct coral_concurrent_skip_list_container_entry **const out) {
+    if (!object) {
+        return CORAL_CONCURRENT_SKIP_LIST_CONTAINER_ERROR_OBJECT_IS_NULL;
+    }
+    if (!out) {
+        return CORAL_CONCURRENT_SKIP_LIST_CONTAINER_ERROR_OUT_IS_NULL;
+    }
+    struct entry *B;
+    search(object, NULL, true, &B);
+    if (!B) {
+        return CORAL_CONCURRENT_SKIP_LIST_CONTAINER_ERROR_CONTAINER_IS_EMPTY;
+    }
+    *out = (struct coral_concurrent_skip_list_container_entry *) &B->data;
+    return 0;
+}
+
+int coral_concurrent_skip_list_container_next(
+        const struct coral_concurrent_skip_list_container *const object,
+        const struct coral_concurrent_skip_list_container_entry *const entry,
+        struct coral_concurrent_skip_list_container_entry **const out) {
+    if (!object) {
+        return CORAL_CONCURRENT_SKIP_LIST_CONTAINER_ERROR_OBJECT_IS_NULL;
+    }
+    if (!entry) {
+        return CORAL_CONCURRENT_SKIP_LIST_CONTAINER_ERROR_ENTRY_IS_NULL;
+    }
+    if (!out) {
+        return CORAL_CONCURRENT_SKIP_LIST_CONTAINER_ERROR_OUT_IS_NULL;
+    }
+    const struct entry *const A = rock_container_of(entry, struct entry, data);
+    /* a removed entry still links to what followed it */
+    struct entry *const B = live(load(&links_of(A)[0]) & ~MARK);
+    if (!B) {
+        return CORAL_CONCURRENT_SKIP_LIST_CONTAINER_ERROR_END_OF_SEQUENCE;
+    }
+    *out = (struct coral_concurrent_skip_list_container_entry *) &B->data;
+    return 0;
+}
+
+int coral_concurrent_skip_list_container_prev(
+        const struct coral_concurrent_skip_list_container *const object,
+        const struct coral_concurrent_skip_list_container_entry *const entry,
+        struct coral_concurrent_skip_list_container_entry **const out) {
+    if (!object) {
+        return CORAL_CONCURRENT_SKIP_LIST_CONTAINER_ERROR_OBJECT_IS_NULL;
+    }
+    if (!entry) {
+        return CORAL_CONCURRENT_SKIP_LIST_CONTAINER_ERROR_ENTRY_IS_NULL;
+    }
+    if (!out) {
+        return CORAL_CONCURRENT_SKIP_LIST_CONTAINER_ERROR_OUT_IS_NULL;
+    }
+    const struct entry *const A = rock_container_of(entry, struct entry, data);
+    struct entry *B;
+    search(object, &A->data, false, &B);
+    if (!B) {
+        return CORAL_CONCURRENT_SKIP_LIST_CONTAINER_ERROR_END_OF_SEQUENCE;
+    }
+    *out = (struct coral_concurrent_skip_list_container_entry *) &B->data;
+    return 0;
+}
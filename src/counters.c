@@ -0,0 +1,68 @@
+#include <stdatomic.h>
+#include <coral.h>
+
+#include "counters.h"
+
+#ifdef CORAL_COUNTERS
+
+void coral_atomic_counters_load(
+        const struct coral_atomic_counters *const object,
+        struct coral_counters *const out) {
+    struct coral_atomic_counters *const counters
+            = (struct coral_atomic_counters *) object;
+    *out = (struct coral_counters) {
+            .compare = atomic_load_explicit(&counters->compare,
+                                            memory_order_relaxed),
+            .visit = atomic_load_explicit(&counters->visit,
+                                          memory_order_relaxed),
+            .insert = atomic_load_explicit(&counters->insert,
+                                           memory_order_relaxed),
+            .remove = atomic_load_explicit(&counters->remove,
+                                           memory_order_relaxed),
+            .rotate = atomic_load_explicit(&counters->rotate,
+                                           memory_order_relaxed)
+    };
+}
+
+void coral_atomic_counters_store(struct coral_atomic_counters *const object,
+                                 const struct coral_counters *const in) {
+    atomic_store_explicit(&object->compare, in->compare,
+                          memory_order_relaxed);
+    atomic_store_explicit(&object->visit, in->visit, memory_order_relaxed);
+    atomic_store_explicit(&object->insert, in->insert, memory_order_relaxed);
+    atomic_store_explicit(&object->remove, in->remove, memory_order_relaxed);
+    atomic_store_explicit(&object->rotate, in->rotate, memory_order_relaxed);
+}
+
+static atomic_uintmax_t allocs;
+static atomic_uintmax_t frees;
+
+void coral_allocation_counters_alloc(void) {
+    atomic_fetch_add_explicit(&allocs, 1, memory_order_relaxed);
+}
+
+void coral_allocation_counters_free(void) {
+    atomic_fetch_add_explicit(&frees, 1, memory_order_relaxed);
+}
+
+#endif /* CORAL_COUNTERS */
+
+int coral_allocation_counters(struct coral_allocation_counters *const out) {
+    if (!out) {
+        return CORAL_COUNTERS_ERROR_OUT_IS_NULL;
+    }
+#ifdef CORAL_COUNTERS
+    out->alloc = atomic_load_explicit(&allocs, memory_order_relaxed);
+    out->free = atomic_load_explicit(&frees, memory_order_relaxed);
+#else
+    *out = (struct coral_allocation_counters) {0};
+#endif
+    return 0;
+}
+
+void coral_allocation_counters_reset(void) {
+#ifdef CORAL_COUNTERS
+    atomic_store_explicit(&allocs, 0, memory_order_relaxed);
+    atomic_store_explicit(&frees, 0, memory_order_relaxed);
+#endif
+}
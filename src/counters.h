@@ -0,0 +1,59 @@
+#ifndef _CORAL_SRC_COUNTERS_H_
+#define _CORAL_SRC_COUNTERS_H_
+
+#include <coral/counters.h>
+
+#ifdef CORAL_COUNTERS
+
+/* counters are statistics so they are updated even through const objects */
+#define coral_counters_add(object, counter, value) \
+    coral_counter_add(&((struct coral_atomic_counters *) \
+            &(object)->counters)->counter, (value))
+
+#define coral_counters_snapshot(object, out) \
+    coral_atomic_counters_load(&(object)->counters, (out))
+
+#define coral_counters_reset(object) \
+    coral_atomic_counters_store(&(object)->counters, \
+                                &(struct coral_counters) {0})
+
+/* A load and a store rather than a read-modify-write, which keeps bumping a
+ * counter as cheap as a plain add. */
+static inline void coral_counter_add(atomic_uintmax_t *const counter,
+                                     const uintmax_t value) {
+    atomic_store_explicit(
+            counter,
+            atomic_load_explicit(counter, memory_order_relaxed) + value,
+            memory_order_relaxed);
+}
+
+void coral_atomic_counters_load(const struct coral_atomic_counters *object,
+                                struct coral_counters *out);
+
+void coral_atomic_counters_store(struct coral_atomic_counters *object,
+                                 const struct coral_counters *in);
+
+void coral_allocation_counters_alloc(void);
+
+void coral_allocation_counters_free(void);
+
+#else
+
+#define coral_counters_add(object, counter, value) \
+    ((void) 0)
+
+#define coral_counters_snapshot(object, out) \
+    (*(out) = (struct coral_counters) {0})
+
+#define coral_counters_reset(object) \
+    ((void) 0)
+
+#define coral_allocation_counters_alloc() \
+    ((void) 0)
+
+#define coral_allocation_counters_free() \
+    ((void) 0)
+
+#endif /* CORAL_COUNTERS */
+
+#endif /* _CORAL_SRC_COUNTERS_H_ */
@@ -0,0 +1,159 @@
+#include <stdlib.h>
+#include <errno.h>
+#include <seagrass.h>
+#include <coral.h>
+
+#ifdef TEST
+#include <test/cmocka.h>
+#endif
+
+struct slab {
+    struct slab *next;
+};
+
+static int pool_alloc(void *const context,
+                      const size_t alignment,
+                      const size_t size,
+                      void **const out) {
+    return coral_entry_pool_alloc(context, alignment, size, out);
+}
+
+static void pool_free(void *const context, void *const memory) {
+    seagrass_required_true(!coral_entry_pool_free(context, memory));
+}
+
+int coral_entry_pool_init(struct coral_entry_pool *const object,
+                          const size_t count) {
+    if (!object) {
+        return CORAL_ENTRY_POOL_ERROR_OBJECT_IS_NULL;
+    }
+    if (!count) {
+        return CORAL_ENTRY_POOL_ERROR_COUNT_IS_ZERO;
+    }
+    *object = (struct coral_entry_pool) {0};
+    object->allocator = (struct coral_allocator) {
+            .alloc = pool_alloc,
+            .free = pool_free,
+            .context = object
+    };
+    object->count = count;
+    return 0;
+}
+
+int coral_entry_pool_invalidate(struct coral_entry_pool *const object) {
+    if (!object) {
+        return CORAL_ENTRY_POOL_ERROR_OBJECT_IS_NULL;
+    }
+    struct slab *slab = object->slabs;
+    while (slab) {
+        struct slab *const next = slab->next;
+        free(slab);
+        slab = next;
+    }
+    *object = (struct coral_entry_pool) {0};
+    return 0;
+}
+
+int coral_entry_pool_allocator(const struct coral_entry_pool *const object,
+                               const struct coral_allocator **const out) {
+    if (!object) {
+        return CORAL_ENTRY_POOL_ERROR_OBJECT_IS_NULL;
+    }
+    if (!out) {
+        return CORAL_ENTRY_POOL_ERROR_OUT_IS_NULL;
+    }
+    *out = &object->allocator;
+    return 0;
+}
+
+static size_t round_up(const size_t value, const size_t alignment) {
+    return (value + alignment - 1) & ~(alignment - 1);
+}
+
+/* fix the block layout from the first allocation that is made */
+static int layout(struct coral_entry_pool *const object,
+                  size_t alignment,
+                  const size_t size) {
+    if (alignment & (alignment - 1)) {
+        return CORAL_ENTRY_POOL_ERROR_ALIGNMENT_IS_INVALID;
+    }
+    if (alignment < sizeof(void *)) {
+        alignment = sizeof(void *);
+    }
+    if (size > SIZE_MAX - alignment) {
+        return CORAL_ENTRY_POOL_ERROR_SIZE_IS_TOO_LARGE;
+    }
+    object->alignment = alignment;
+    object->size = round_up(size < sizeof(void *) ? sizeof(void *) : size,
+                            alignment);
+    return 0;
+}
+
+static int slab_alloc(struct coral_entry_pool *const object) {
+    int error;
+    uintmax_t alloc;
+    const size_t header = round_up(sizeof(struct slab), object->alignment);
+    if ((error = seagrass_uintmax_t_multiply(
+            object->count, object->size, &alloc))
+        || (error = seagrass_uintmax_t_add(alloc, header, &alloc))
+        || alloc > SIZE_MAX) {
+        seagrass_required_true(SEAGRASS_UINTMAX_T_ERROR_RESULT_IS_INCONSISTENT
+                               == error || !error);
+        return CORAL_ENTRY_POOL_ERROR_SIZE_IS_TOO_LARGE;
+    }
+    struct slab *slab;
+    if ((error = posix_memalign((void **) &slab, object->alignment, alloc))) {
+        seagrass_required_true(ENOMEM == error);
+        return CORAL_ENTRY_POOL_ERROR_MEMORY_ALLOCATION_FAILED;
+    }
+    slab->next = object->slabs;
+    object->slabs = slab;
+    /* blocks are carved lazily so untouched pages are never faulted in */
+    object->cursor = (unsigned char *) slab + header;
+    object->end = (unsigned char *) slab + alloc;
+    return 0;
+}
+
+int coral_entry_pool_alloc(struct coral_entry_pool *const object,
+                           const size_t alignment,
+                           const size_t size,
+                           void **const out) {
+    if (!object) {
+        return CORAL_ENTRY_POOL_ERROR_OBJECT_IS_NULL;
+    }
+    if (!out) {
+        return CORAL_ENTRY_POOL_ERROR_OUT_IS_NULL;
+    }
+    int error;
+    if (!object->size && (error = layout(object, alignment, size))) {
+        return error;
+    }
+    if (size > object->size || alignment > object->alignment) {
+        return CORAL_ENTRY_POOL_ERROR_SIZE_IS_TOO_LARGE;
+    }
+    if (object->blocks) {
+        void **const block = object->blocks;
+        object->blocks = *block;
+        *out = block;
+        return 0;
+    }
+    if (object->cursor == object->end && (error = slab_alloc(object))) {
+        return error;
+    }
+    *out = object->cursor;
+    object->cursor += object->size;
+    return 0;
+}
+
+int coral_entry_pool_free(struct coral_entry_pool *const object,
+                          void *const block) {
+    if (!object) {
+        return CORAL_ENTRY_POOL_ERROR_OBJECT_IS_NULL;
+    }
+    if (!block) {
+        return CORAL_ENTRY_POOL_ERROR_BLOCK_IS_NULL;
+    }
+    *(void **) block = object->blocks;
+    object->blocks = block;
+    return 0;
+}
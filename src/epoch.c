@@ -0,0 +1,294 @@
+#include <stdlib.h>
+#include <seagrass.h>
+#include <coral.h>
+
+#ifdef TEST
+#include <test/cmocka.h>
+#endif
+
+/* number of functions a bag holds */
+#define CAPACITY 64
+/* set in the state of a thread while it is in a critical section, the epoch
+ * it entered in is kept in the bits above */
+#define ACTIVE ((uintmax_t) 1)
+
+struct coral_epoch_bag {
+    struct coral_epoch_bag *next;
+    uintmax_t epoch;
+    size_t count;
+    struct {
+        void *item;
+        void (*function)(void *item);
+    } items[CAPACITY];
+};
+
+/* set while deferred functions run, along with the thread they run on which
+ * is NULL while the epoch is being invalidated */
+static _Thread_local size_t running;
+static _Thread_local struct coral_epoch_thread *runner;
+
+int coral_epoch_init(struct coral_epoch *const object) {
+    if (!object) {
+        return CORAL_EPOCH_ERROR_OBJECT_IS_NULL;
+    }
+    *object = (struct coral_epoch) {0};
+    if (pthread_mutex_init(&object->mutex, NULL)) {
+        return CORAL_EPOCH_ERROR_MEMORY_ALLOCATION_FAILED;
+    }
+    atomic_init(&object->global, 0);
+    return 0;
+}
+
+/* Run the functions of every bag in the list on thread and free the bags,
+ * keeping one at hand for when the current bag of thread fills up. */
+static void run(struct coral_epoch_thread *const thread,
+                struct coral_epoch_bag *bag) {
+    struct coral_epoch_thread *const previous = runner;
+    running++;
+    runner = thread;
+    while (bag) {
+        struct coral_epoch_bag *const next = bag->next;
+        for (size_t i = 0; i < bag->count; i++) {
+            bag->items[i].function(bag->items[i].item);
+        }
+        if (thread && !thread->spare) {
+            bag->count = 0;
+            thread->spare = bag;
+        } else {
+            free(bag);
+        }
+        bag = next;
+    }
+    runner = previous;
+    running--;
+}
+
+int coral_epoch_invalidate(struct coral_epoch *const object) {
+    if (!object) {
+        return CORAL_EPOCH_ERROR_OBJECT_IS_NULL;
+    }
+    if (object->threads) {
+        return CORAL_EPOCH_ERROR_THREADS_ARE_REGISTERED;
+    }
+    run(NULL, object->orphans);
+    seagrass_required_true(!pthread_mutex_destroy(&object->mutex));
+    *object = (struct coral_epoch) {0};
+    return 0;
+}
+
+int coral_epoch_register(struct coral_epoch *const object,
+                         struct coral_epoch_thread *const thread) {
+    if (!object) {
+        return CORAL_EPOCH_ERROR_OBJECT_IS_NULL;
+    }
+    if (!thread) {
+        return CORAL_EPOCH_ERROR_THREAD_IS_NULL;
+    }
+    struct coral_epoch_bag *const bag = malloc(sizeof(*bag));
+    if (!bag) {
+        return CORAL_EPOCH_ERROR_MEMORY_ALLOCATION_FAILED;
+    }
+    bag->count = 0;
+    *thread = (struct coral_epoch_thread) {
+            .epoch = object,
+            .bag = bag
+    };
+    atomic_init(&thread->state, 0);
+    seagrass_required_true(!pthread_mutex_lock(&object->mutex));
+    thread->next = object->threads;
+    object->threads = thread;
+    seagrass_required_true(!pthread_mutex_unlock(&object->mutex));
+    return 0;
+}
+
+int coral_epoch_unregister(struct coral_epoch_thread *const thread) {
+    if (!thread) {
+        return CORAL_EPOCH_ERROR_THREAD_IS_NULL;
+    }
+    if (thread->depth) {
+        return CORAL_EPOCH_ERROR_THREAD_IS_ACTIVE;
+    }
+    struct coral_epoch *const object = thread->epoch;
+    struct coral_epoch_bag *bags = thread->sealed;
+    if (thread->bag->count) {
+        thread->bag->epoch = atomic_load(&object->global);
+        thread->bag->next = bags;
+        bags = thread->bag;
+    } else {
+        free(thread->bag);
+    }
+    free(thread->spare);
+    seagrass_required_true(!pthread_mutex_lock(&object->mutex));
+    struct coral_epoch_thread **link = &object->threads;
+    while (*link != thread) {
+        link = &(*link)->next;
+    }
+    *link = thread->next;
+    while (bags) {
+        struct coral_epoch_bag *const next = bags->next;
+        bags->next = object->orphans;
+        object->orphans = bags;
+        bags = next;
+    }
+    seagrass_required_true(!pthread_mutex_unlock(&object->mutex));
+    *thread = (struct coral_epoch_thread) {0};
+    return 0;
+}
+
+int coral_epoch_enter(struct coral_epoch_thread *const thread) {
+    if (!thread) {
+        return CORAL_EPOCH_ERROR_THREAD_IS_NULL;
+    }
+    if (!thread->depth++) {
+        /* Should the epoch move on before the state is stored we only hold
+         * it back from moving on any further, the entries deferred meanwhile
+         * were unreachable before we could look at them. The store must be
+         * seen by other threads before we load anything shared. */
+        const uintmax_t epoch = atomic_load_explicit(
+                &thread->epoch->global, memory_order_relaxed);
+        atomic_store(&thread->state, epoch << 1 | ACTIVE);
+    }
+    return 0;
+}
+
+int coral_epoch_exit(struct coral_epoch_thread *const thread) {
+    if (!thread) {
+        return CORAL_EPOCH_ERROR_THREAD_IS_NULL;
+    }
+    if (!thread->depth) {
+        return CORAL_EPOCH_ERROR_THREAD_IS_NOT_ACTIVE;
+    }
+    if (!--thread->depth) {
+        atomic_store_explicit(&thread->state, 0, memory_order_release);
+    }
+    return 0;
+}
+
+/* Move the epoch on if every thread in a critical section has seen it and
+ * take the bags left behind by unregistered threads that are now safe to
+ * run. */
+static uintmax_t advance(struct coral_epoch *const object,
+                         struct coral_epoch_bag **const out) {
+    struct coral_epoch_bag *ready = NULL;
+    seagrass_required_true(!pthread_mutex_lock(&object->mutex));
+    uintmax_t epoch = atomic_load(&object->global);
+    const struct coral_epoch_thread *thread = object->threads;
+    for (; thread; thread = thread->next) {
+        const uintmax_t state = atomic_load(&thread->state);
+        if ((state & ACTIVE) && state >> 1 != epoch) {
+            break;
+        }
+    }
+    if (!thread) {
+        atomic_store(&object->global, ++epoch);
+    }
+    struct coral_epoch_bag **link = &object->orphans;
+    while (*link) {
+        struct coral_epoch_bag *const bag = *link;
+        if (bag->epoch + 2 <= epoch) {
+            *link = bag->next;
+            bag->next = ready;
+            ready = bag;
+        } else {
+            link = &bag->next;
+        }
+    }
+    seagrass_required_true(!pthread_mutex_unlock(&object->mutex));
+    *out = ready;
+    return epoch;
+}
+
+static void collect(struct coral_epoch_thread *const thread) {
+    struct coral_epoch_bag *ready;
+    const uintmax_t epoch = advance(thread->epoch, &ready);
+    /* take the bags off the thread before running them, functions deferred
+     * again meanwhile may seal bags and collect in turn */
+    struct coral_epoch_bag **link = &thread->sealed;
+    while (*link) {
+        struct coral_epoch_bag *const bag = *link;
+        if (bag->epoch + 2 > epoch) {
+            link = &bag->next;
+            continue;
+        }
+        *link = bag->next;
+        bag->next = ready;
+        ready = bag;
+    }
+    run(thread, ready);
+}
+
+static void seal(struct coral_epoch_thread *const thread) {
+    struct coral_epoch_bag *const bag = thread->bag;
+    bag->epoch = atomic_load(&thread->epoch->global);
+    bag->next = thread->sealed;
+    thread->sealed = bag;
+}
+
+int coral_epoch_defer(struct coral_epoch_thread *const thread,
+                      void *const item,
+                      void (*const function)(void *item)) {
+    if (!thread) {
+        return CORAL_EPOCH_ERROR_THREAD_IS_NULL;
+    }
+    if (!item) {
+        return CORAL_EPOCH_ERROR_ITEM_IS_NULL;
+    }
+    if (!function) {
+        return CORAL_EPOCH_ERROR_FUNCTION_IS_NULL;
+    }
+    if (CAPACITY == thread->bag->count) {
+        struct coral_epoch_bag *bag = thread->spare;
+        if (!bag && !(bag = malloc(sizeof(*bag)))) {
+            collect(thread);
+            if (!(bag = thread->spare)) {
+                return CORAL_EPOCH_ERROR_MEMORY_ALLOCATION_FAILED;
+            }
+        }
+        thread->spare = NULL;
+        bag->count = 0;
+        seal(thread);
+        thread->bag = bag;
+        collect(thread);
+    }
+    struct coral_epoch_bag *const bag = thread->bag;
+    bag->items[bag->count].item = item;
+    bag->items[bag->count].function = function;
+    bag->count++;
+    return 0;
+}
+
+int coral_epoch_defer_again(void *const item,
+                            void (*const function)(void *item)) {
+    if (!item) {
+        return CORAL_EPOCH_ERROR_ITEM_IS_NULL;
+    }
+    if (!function) {
+        return CORAL_EPOCH_ERROR_FUNCTION_IS_NULL;
+    }
+    if (!running) {
+        return CORAL_EPOCH_ERROR_CALLER_IS_NOT_DEFERRED;
+    }
+    /* no thread is left to be looking at item while invalidating */
+    if (!runner) {
+        function(item);
+        return 0;
+    }
+    return coral_epoch_defer(runner, item, function);
+}
+
+int coral_epoch_collect(struct coral_epoch_thread *const thread) {
+    if (!thread) {
+        return CORAL_EPOCH_ERROR_THREAD_IS_NULL;
+    }
+    if (thread->bag->count) {
+        struct coral_epoch_bag *bag = thread->spare;
+        if (bag || (bag = malloc(sizeof(*bag)))) {
+            thread->spare = NULL;
+            bag->count = 0;
+            seal(thread);
+            thread->bag = bag;
+        }
+    }
+    collect(thread);
+    return 0;
+}
@@ -0,0 +1,262 @@
+#include <stdlib.h>
+#include <seagrass.h>
+#include <coral.h>
+
+#include "counters.h"
+#include "hash_table.h"
+
+#ifdef TEST
+#include <test/cmocka.h>
+#endif
+
+struct coral_hash_container_entry {
+    void *data;
+};
+
+struct entry {
+    size_t hash;
+    const struct coral_allocator *allocator;
+    unsigned char data[];
+};
+
+int coral_hash_container_alloc_with(
+        const struct coral_allocator *allocator,
+        const size_t size,
+        struct coral_hash_container_entry **const out) {
+    if (!size) {
+        return CORAL_HASH_CONTAINER_ERROR_SIZE_IS_ZERO;
+    }
+    if (!out) {
+        return CORAL_HASH_CONTAINER_ERROR_OUT_IS_NULL;
+    }
+    int error;
+    uintmax_t alloc;
+    if ((error = seagrass_uintmax_t_add(size, sizeof(struct entry), &alloc))
+        || alloc > SIZE_MAX) {
+        seagrass_required_true(SEAGRASS_UINTMAX_T_ERROR_RESULT_IS_INCONSISTENT
+                               == error || !error);
+        return CORAL_HASH_CONTAINER_ERROR_SIZE_IS_TOO_LARGE;
+    }
+    if (!allocator) {
+        seagrass_required_true(!coral_allocator_get_default(&allocator));
+    }
+    struct entry *entry;
+    if (allocator->alloc(allocator->context, sizeof(void *), alloc,
+                         (void **) &entry)) {
+        return CORAL_HASH_CONTAINER_ERROR_MEMORY_ALLOCATION_FAILED;
+    }
+    entry->hash = 0;
+    entry->allocator = allocator;
+    coral_allocation_counters_alloc();
+    *out = (struct coral_hash_container_entry *) &entry->data;
+    return 0;
+}
+
+int coral_hash_container_alloc(
+        const size_t size,
+        struct coral_hash_container_entry **const out) {
+    return coral_hash_container_alloc_with(NULL, size, out);
+}
+
+int coral_hash_container_free(
+        struct coral_hash_container_entry *const entry) {
+    if (!entry) {
+        return CORAL_HASH_CONTAINER_ERROR_ENTRY_IS_NULL;
+    }
+    struct entry *const A = rock_container_of(entry, struct entry, data);
+    coral_allocation_counters_free();
+    A->allocator->free(A->allocator->context, A);
+    return 0;
+}
+
+int coral_hash_container_init(
+        struct coral_hash_container *const object,
+        size_t (*const hash)(const void *entry),
+        int (*const compare)(const void *first,
+                             const void *second)) {
+    if (!object) {
+        return CORAL_HASH_CONTAINER_ERROR_OBJECT_IS_NULL;
+    }
+    if (!hash) {
+        return CORAL_HASH_CONTAINER_ERROR_HASH_IS_NULL;
+    }
+    if (!compare) {
+        return CORAL_HASH_CONTAINER_ERROR_COMPARE_IS_NULL;
+    }
+    *object = (struct coral_hash_container) {
+            .hash = hash,
+            .compare = compare
+    };
+    return 0;
+}
+
+static void destroy(void *const item, void *const context) {
+    void (*const *const on_destroy)(struct coral_hash_container_entry *)
+            = context;
+    struct entry *const A = item;
+    struct coral_hash_container_entry *const entry
+            = (struct coral_hash_container_entry *) &A->data;
+    if (*on_destroy) {
+        (*on_destroy)(entry);
+    }
+    seagrass_required_true(!coral_hash_container_free(entry));
+}
+
+int coral_hash_container_invalidate(
+        struct coral_hash_container *const object,
+        void (*on_destroy)(struct coral_hash_container_entry *entry)) {
+    if (!object) {
+        return CORAL_HASH_CONTAINER_ERROR_OBJECT_IS_NULL;
+    }
+    coral_hash_table_invalidate(&object->table, destroy, &on_destroy);
+    *object = (struct coral_hash_container) {0};
+    return 0;
+}
+
+int coral_hash_container_count(
+        const struct coral_hash_container *const object,
+        uintmax_t *const out) {
+    if (!object) {
+        return CORAL_HASH_CONTAINER_ERROR_OBJECT_IS_NULL;
+    }
+    if (!out) {
+        return CORAL_HASH_CONTAINER_ERROR_OUT_IS_NULL;
+    }
+    *out = object->table.count;
+    return 0;
+}
+
+static bool equal(const void *const key,
+                  const void *const item,
+                  const void *const context) {
+    const struct coral_hash_container *const object = context;
+    const struct entry *const B = item;
+    coral_counters_add(&object->table, compare, 1);
+    return !object->compare(key, &B->data);
+}
+
+static size_t hash_of(const void *const item) {
+    const struct entry *const A = item;
+    return A->hash;
+}
+
+int coral_hash_container_add(
+        struct coral_hash_container *const object,
+        const struct coral_hash_container_entry *const entry) {
+    if (!object) {
+        return CORAL_HASH_CONTAINER_ERROR_OBJECT_IS_NULL;
+    }
+    if (!entry) {
+        return CORAL_HASH_CONTAINER_ERROR_ENTRY_IS_NULL;
+    }
+    struct entry *const A = rock_container_of(entry, struct entry, data);
+    const size_t hash = object->hash(&A->data);
+    if (coral_hash_table_find(&object->table, hash, &A->data, equal,
+                              object)) {
+        return CORAL_HASH_CONTAINER_ERROR_ENTRY_ALREADY_EXISTS;
+    }
+    A->hash = hash;
+    if (coral_hash_table_insert(&object->table, hash, A, hash_of)) {
+        return CORAL_HASH_CONTAINER_ERROR_MEMORY_ALLOCATION_FAILED;
+    }
+    return 0;
+}
+
+int coral_hash_container_remove(
+        struct coral_hash_container *const object,
+        const struct coral_hash_container_entry *const entry) {
+    if (!object) {
+        return CORAL_HASH_CONTAINER_ERROR_OBJECT_IS_NULL;
+    }
+    if (!entry) {
+        return CORAL_HASH_CONTAINER_ERROR_ENTRY_IS_NULL;
+    }
+    const struct entry *const A = rock_container_of(entry, struct entry, data);
+    if (!coral_hash_table_remove(&object->table, A->hash, A, hash_of)) {
+        return CORAL_HASH_CONTAINER_ERROR_ENTRY_NOT_FOUND;
+    }
+    return 0;
+}
+
+int coral_hash_container_get(
+        const struct coral_hash_container *const object,
+        const void *const key,
+        struct coral_hash_container_entry **const out) {
+    if (!object) {
+        return CORAL_HASH_CONTAINER_ERROR_OBJECT_IS_NULL;
+    }
+    if (!key) {
+        return CORAL_HASH_CONTAINER_ERROR_KEY_IS_NULL;
+    }
+    if (!out) {
+        return CORAL_HASH_CONTAINER_ERROR_OUT_IS_NULL;
+    }
+    struct entry *const B = coral_hash_table_find(
+            &object->table, object->hash(key), key, equal, object);
+    if (!B) {
+        return CORAL_HASH_CONTAINER_ERROR_ENTRY_NOT_FOUND;
+    }
+    *out = (struct coral_hash_container_entry *) &B->data;
+    return 0;
+}
+
+int coral_hash_container_first(
+        const struct coral_hash_container *const object,
+        struct coral_hash_container_entry **const out) {
+    if (!object) {
+        return CORAL_HASH_CONTAINER_ERROR_OBJECT_IS_NULL;
+    }
+    if (!out) {
+        return CORAL_HASH_CONTAINER_ERROR_OUT_IS_NULL;
+    }
+    struct entry *const B = coral_hash_table_first(&object->table);
+    if (!B) {
+        return CORAL_HASH_CONTAINER_ERROR_CONTAINER_IS_EMPTY;
+    }
+    *out = (struct coral_hash_container_entry *) &B->data;
+    return 0;
+}
+
+int coral_hash_container_next(
+        const struct coral_hash_container *const object,
+        const struct coral_hash_container_entry *const entry,
+        struct coral_hash_container_entry **const out) {
+    if (!object) {
+        return CORAL_HASH_CONTAINER_ERROR_OBJECT_IS_NULL;
+    }
+    if (!entry) {
+        return CORAL_HASH_CONTAINER_ERROR_ENTRY_IS_NULL;
+    }
+    if (!out) {
+        return CORAL_HASH_CONTAINER_ERROR_OUT_IS_NULL;
+    }
+    const struct entry *const A = rock_container_of(entry, struct entry, data);
+    struct entry *const B = coral_hash_table_next(&object->table, A->hash, A);
+    if (!B) {
+        return CORAL_HASH_CONTAINER_ERROR_END_OF_SEQUENCE;
+    }
+    *out = (struct coral_hash_container_entry *) &B->data;
+    return 0;
+}
+
+int coral_hash_container_counters(
+        const struct coral_hash_container *const object,
+        struct coral_counters *const out) {
+    if (!object) {
+        return CORAL_HASH_CONTAINER_ERROR_OBJECT_IS_NULL;
+    }
+    if (!out) {
+        return CORAL_HASH_CONTAINER_ERROR_OUT_IS_NULL;
+    }
+    coral_counters_snapshot(&object->table, out);
+    return 0;
+}
+
+int coral_hash_container_counters_reset(
+        struct coral_hash_container *const object) {
+    if (!object) {
+        return CORAL_HASH_CONTAINER_ERROR_OBJECT_IS_NULL;
+    }
+    coral_counters_reset(&object->table);
+    return 0;
+}
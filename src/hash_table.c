@@ -0,0 +1,430 @@
+#include <stdlib.h>
+#include <limits.h>
+#include <seagrass.h>
+#include <coral.h>
+
+#include "counters.h"
+#include "hash_table.h"
+
+#ifdef TEST
+#include <test/cmocka.h>
+#endif
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#define GROUP_WIDTH 16
+#define MINIMUM_CAPACITY GROUP_WIDTH
+
+/* control bytes of full slots hold seven bits of the hash along with the
+ * high bit, which is clear for free slots so that a zeroed table is empty */
+#define FULL 0x80
+#define EMPTY 0x00
+#define DELETED 0x7F
+
+/* Spread the hash so that both the tag and the group index depend on all of
+ * its bits even when the caller hashes with the identity. */
+static inline size_t mix(const size_t hash) {
+    const size_t mixed = hash * (size_t) UINT64_C(0x9e3779b97f4a7c15);
+    return mixed ^ (mixed >> (sizeof(size_t) * CHAR_BIT / 2));
+}
+
+static inline unsigned char tag_of(const size_t mixed) {
+    return (unsigned char) (FULL | (mixed & 0x7f));
+}
+
+#if defined(__SSE2__)
+
+static inline uint32_t match_byte(const unsigned char *const group,
+                                  const unsigned char byte) {
+    const __m128i control = _mm_load_si128((const __m128i *) group);
+    return (uint32_t) _mm_movemask_epi8(
+            _mm_cmpeq_epi8(control, _mm_set1_epi8((char) byte)));
+}
+
+static inline uint32_t match_full(const unsigned char *const group) {
+    return (uint32_t) _mm_movemask_epi8(
+            _mm_load_si128((const __m128i *) group));
+}
+
+#else
+
+/* Without SSE2 a group is matched as two words, eight bytes at a time. */
+#define LOW_BITS UINT64_C(0x7f7f7f7f7f7f7f7f)
+#define HIGH_BITS UINT64_C(0x8080808080808080)
+
+static inline uint64_t load(const unsigned char *const bytes) {
+    uint64_t word = 0;
+    for (size_t i = 0; i < 8; i++) {
+        word |= (uint64_t) bytes[i] << (8 * i);
+    }
+    return word;
+}
+
+/* one bit per byte whose high bit is set, byte i gives bit i */
+static inline uint32_t gather(const uint64_t high) {
+    return (uint32_t) (((high >> 7) * UINT64_C(0x0102040810204080)) >> 56);
+}
+
+static inline uint32_t match_word(const uint64_t word,
+                                  const unsigned char byte) {
+    const uint64_t x = word ^ (UINT64_C(0x0101010101010101) * byte);
+    return gather(~(((x & LOW_BITS) + LOW_BITS) | x | LOW_BITS));
+}
+
+static inline uint32_t match_byte(const unsigned char *const group,
+                                  const unsigned char byte) {
+    return match_word(load(group), byte)
+           | match_word(load(group + 8), byte) << 8;
+}
+
+static inline uint32_t match_full(const unsigned char *const group) {
+    return gather(load(group) & HIGH_BITS)
+           | gather(load(group + 8) & HIGH_BITS) << 8;
+}
+
+#endif /* __SSE2__ */
+
+static inline size_t lowest(uint32_t mask) {
+#if defined(__GNUC__)
+    return (size_t) __builtin_ctz(mask);
+#else
+    size_t i = 0;
+    for (; !(mask & 1); mask >>= 1) {
+        i++;
+    }
+    return i;
+#endif
+}
+
+/* At most seven eighths of the slots are taken, deleted ones included, so
+ * that every probe sequence soon reaches a group with an empty slot. */
+static inline size_t limit(const size_t capacity) {
+    return capacity - capacity / 8;
+}
+
+/* Groups of the old table that are moved per add or remove. A table is only
+ * replaced once it reaches its limit while its replacement holds twice the
+ * slots, or as many when only deleted slots are cleared, so the old table is
+ * drained long before the new one could reach its own limit. */
+#define MIGRATION_STEP 1
+
+/* Item in the given slots equal to key or NULL if there is none. */
+static void *search(const struct coral_hash_table *const object,
+                    const unsigned char *const control,
+                    void *const *const slots,
+                    const size_t capacity,
+                    const size_t mixed,
+                    const void *const key,
+                    bool (*const equal)(const void *, const void *,
+                                        const void *),
+                    const void *const context) {
+    const unsigned char tag = tag_of(mixed);
+    const size_t mask = capacity / GROUP_WIDTH - 1;
+    size_t group = (mixed >> 7) & mask;
+    for (size_t step = 1;; step++) {
+        coral_counters_add(object, visit, 1);
+        const unsigned char *const bytes = &control[group * GROUP_WIDTH];
+        for (uint32_t match = match_byte(bytes, tag); match;
+             match &= match - 1) {
+            void *const item = slots[group * GROUP_WIDTH + lowest(match)];
+            if (equal(key, item, context)) {
+                return item;
+            }
+        }
+        if (match_byte(bytes, EMPTY)) {
+            return NULL;
+        }
+        group = (group + step) & mask;
+    }
+}
+
+void *coral_hash_table_find(
+        const struct coral_hash_table *const object,
+        const size_t hash,
+        const void *const key,
+        bool (*const equal)(const void *, const void *, const void *),
+        const void *const context) {
+    if (!object->count) {
+        return NULL;
+    }
+    const size_t mixed = mix(hash);
+    void *const item = search(object, object->control, object->slots,
+                              object->capacity, mixed, key, equal, context);
+    if (item || !object->old_count) {
+        return item;
+    }
+    return search(object, object->old_control, object->old_slots,
+                  object->old_capacity, mixed, key, equal, context);
+}
+
+/* Slot of item in the given slots or the capacity if it is not there. */
+static size_t locate(const unsigned char *const control,
+                     void *const *const slots,
+                     const size_t capacity,
+                     const size_t mixed,
+                     const void *const item) {
+    const unsigned char tag = tag_of(mixed);
+    const size_t mask = capacity / GROUP_WIDTH - 1;
+    size_t group = (mixed >> 7) & mask;
+    for (size_t step = 1;; step++) {
+        const unsigned char *const bytes = &control[group * GROUP_WIDTH];
+        for (uint32_t match = match_byte(bytes, tag); match;
+             match &= match - 1) {
+            const size_t slot = group * GROUP_WIDTH + lowest(match);
+            if (item == slots[slot]) {
+                return slot;
+            }
+        }
+        if (match_byte(bytes, EMPTY)) {
+            return capacity;
+        }
+        group = (group + step) & mask;
+    }
+}
+
+/* Put item in the first free slot of its probe sequence. */
+static void place(struct coral_hash_table *const object,
+                  const size_t hash,
+                  void *const item) {
+    const size_t mixed = mix(hash);
+    const size_t mask = object->capacity / GROUP_WIDTH - 1;
+    size_t group = (mixed >> 7) & mask;
+    for (size_t step = 1;; step++) {
+        const uint32_t available
+                = ~match_full(&object->control[group * GROUP_WIDTH]) & 0xffff;
+        if (available) {
+            const size_t slot = group * GROUP_WIDTH + lowest(available);
+            if (DELETED == object->control[slot]) {
+                object->deleted--;
+            }
+            object->control[slot] = tag_of(mixed);
+            object->slots[slot] = item;
+            return;
+        }
+        group = (group + step) & mask;
+    }
+}
+
+static void retire(struct coral_hash_table *const object) {
+    free(object->old_control);
+    object->old_capacity = 0;
+    object->old_count = 0;
+    object->migrated = 0;
+    object->old_control = NULL;
+    object->old_slots = NULL;
+}
+
+/* Move the items of up to groups groups of the old table into the new one.
+ * Moved slots are marked deleted so that probe sequences through them still
+ * reach the items that are yet to be moved. */
+static void migrate(struct coral_hash_table *const object,
+                    size_t groups,
+                    size_t (*const hash_of)(const void *)) {
+    for (; groups && object->old_count; groups--) {
+        const size_t group = object->migrated;
+        unsigned char *const control = &object->old_control[group];
+        uint32_t full = match_full(control);
+        for (; full; full &= full - 1) {
+            const size_t i = lowest(full);
+            void *const item = object->old_slots[group + i];
+            place(object, hash_of(item), item);
+            control[i] = DELETED;
+            object->old_count--;
+        }
+        object->migrated += GROUP_WIDTH;
+    }
+    if (object->old_control && !object->old_count) {
+        retire(object);
+    }
+}
+
+/* Start moving the items into a table of the given capacity, they are moved
+ * over by the adds and removes that follow. */
+static int resize(struct coral_hash_table *const object,
+                  const size_t capacity,
+                  size_t (*const hash_of)(const void *)) {
+    if (capacity > SIZE_MAX / (1 + sizeof(void *))) {
+        return SEA_URCHIN_ERROR_MEMORY_ALLOCATION_FAILED;
+    }
+    /* Control bytes come first so that every group is aligned. A zeroed
+     * table is empty and large ones come as fresh pages already zeroed, the
+     * adds that follow pay for clearing them as they touch them rather than
+     * the add growing the table. */
+    void *const memory = calloc(capacity, 1 + sizeof(void *));
+    if (!memory) {
+        return SEA_URCHIN_ERROR_MEMORY_ALLOCATION_FAILED;
+    }
+    /* never reached given the migration step, kept so that the items of an
+     * older table are not lost */
+    migrate(object, SIZE_MAX, hash_of);
+    object->old_capacity = object->capacity;
+    object->old_count = (size_t) object->count;
+    object->migrated = 0;
+    object->old_control = object->control;
+    object->old_slots = object->slots;
+    object->capacity = capacity;
+    object->deleted = 0;
+    object->control = memory;
+    object->slots = (void **) ((unsigned char *) memory + capacity);
+    if (!object->old_count) {
+        retire(object);
+    }
+    return 0;
+}
+
+int coral_hash_table_insert(struct coral_hash_table *const object,
+                            const size_t hash,
+                            void *const item,
+                            size_t (*const hash_of)(const void *)) {
+    migrate(object, MIGRATION_STEP, hash_of);
+    /* items still in the old table will be placed in this one */
+    const uintmax_t load = object->count + object->deleted;
+    if (load >= limit(object->capacity)) {
+        /* when deleted slots make up much of the load, only clear them */
+        size_t capacity = object->capacity;
+        if (!capacity) {
+            capacity = MINIMUM_CAPACITY;
+        } else if (object->count >= limit(capacity) / 2) {
+            if (capacity > SIZE_MAX / 2) {
+                return SEA_URCHIN_ERROR_MEMORY_ALLOCATION_FAILED;
+            }
+            capacity *= 2;
+        }
+        int error;
+        if ((error = resize(object, capacity, hash_of))) {
+            return error;
+        }
+        migrate(object, MIGRATION_STEP, hash_of);
+    }
+    place(object, hash, item);
+    object->count++;
+    coral_counters_add(object, insert, 1);
+    return 0;
+}
+
+/* Free the slot of a removed item, a probe sequence never went past a group
+ * that has an empty slot so the slot can be made empty again instead of
+ * deleted. */
+static bool vacate(unsigned char *const control, const size_t slot) {
+    const size_t group = slot & ~(size_t) (GROUP_WIDTH - 1);
+    if (match_byte(&control[group], EMPTY)) {
+        control[slot] = EMPTY;
+        return false;
+    }
+    control[slot] = DELETED;
+    return true;
+}
+
+bool coral_hash_table_remove(struct coral_hash_table *const object,
+                             const size_t hash,
+                             const void *const item,
+                             size_t (*const hash_of)(const void *)) {
+    if (!object->count) {
+        return false;
+    }
+    const size_t mixed = mix(hash);
+    size_t slot = locate(object->control, object->slots, object->capacity,
+                         mixed, item);
+    if (slot < object->capacity) {
+        if (vacate(object->control, slot)) {
+            object->deleted++;
+        }
+    } else if (!object->old_count
+               || object->old_capacity == (slot = locate(
+                       object->old_control, object->old_slots,
+                       object->old_capacity, mixed, item))) {
+        return false;
+    } else {
+        vacate(object->old_control, slot);
+        object->old_count--;
+    }
+    object->count--;
+    coral_counters_add(object, remove, 1);
+    migrate(object, MIGRATION_STEP, hash_of);
+    return true;
+}
+
+/* First item in the given slots at or after slot. */
+static void *scan(const unsigned char *const control,
+                  void *const *const slots,
+                  const size_t capacity,
+                  size_t slot) {
+    while (slot < capacity) {
+        const size_t group = slot & ~(size_t) (GROUP_WIDTH - 1);
+        uint32_t full = match_full(&control[group]);
+        full &= ~((UINT32_C(1) << (slot - group)) - 1);
+        if (full) {
+            return slots[group + lowest(full)];
+        }
+        slot = group + GROUP_WIDTH;
+    }
+    return NULL;
+}
+
+/* First item of the old table, those before migrated have been moved. */
+static void *scan_old(const struct coral_hash_table *const object,
+                      const size_t slot) {
+    if (!object->old_count) {
+        return NULL;
+    }
+    return scan(object->old_control, object->old_slots, object->old_capacity,
+                slot > object->migrated ? slot : object->migrated);
+}
+
+void *coral_hash_table_first(const struct coral_hash_table *const object) {
+    if (!object->count) {
+        return NULL;
+    }
+    void *const item = scan(object->control, object->slots,
+                            object->capacity, 0);
+    return item ? item : scan_old(object, 0);
+}
+
+void *coral_hash_table_next(const struct coral_hash_table *const object,
+                            const size_t hash,
+                            const void *const item) {
+    seagrass_required_true(object->count);
+    const size_t mixed = mix(hash);
+    const size_t slot = locate(object->control, object->slots,
+                               object->capacity, mixed, item);
+    if (slot < object->capacity) {
+        void *const next = scan(object->control, object->slots,
+                                object->capacity, 1 + slot);
+        return next ? next : scan_old(object, 0);
+    }
+    seagrass_required_true(object->old_count);
+    const size_t old = locate(object->old_control, object->old_slots,
+                              object->old_capacity, mixed, item);
+    seagrass_required_true(old < object->old_capacity);
+    return scan_old(object, 1 + old);
+}
+
+static void visit(const unsigned char *const control,
+                  void *const *const slots,
+                  const size_t capacity,
+                  void (*const on_item)(void *, void *),
+                  void *const context) {
+    for (size_t i = 0; i < capacity; i++) {
+        if (control[i] & FULL) {
+            on_item(slots[i], context);
+        }
+    }
+}
+
+void coral_hash_table_invalidate(struct coral_hash_table *const object,
+                                 void (*const on_item)(void *, void *),
+                                 void *const context) {
+    if (on_item) {
+        visit(object->control, object->slots, object->capacity, on_item,
+              context);
+        if (object->old_count) {
+            visit(object->old_control, object->old_slots,
+                  object->old_capacity, on_item, context);
+        }
+    }
+    free(object->old_control);
+    free(object->control);
+    *object = (struct coral_hash_table) {0};
+}
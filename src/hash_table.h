@@ -0,0 +1,41 @@
+#ifndef _CORAL_SRC_HASH_TABLE_H_
+#define _CORAL_SRC_HASH_TABLE_H_
+
+#include <coral/hash_table.h>
+
+/* Item equal to key or NULL if there is none. */
+void *coral_hash_table_find(
+        const struct coral_hash_table *object,
+        size_t hash,
+        const void *key,
+        bool (*equal)(const void *key, const void *item, const void *context),
+        const void *context);
+
+/* Add an item that is not present yet, the table grows as needed and
+ * hash_of must return the hash the item was added with. */
+int coral_hash_table_insert(struct coral_hash_table *object,
+                            size_t hash,
+                            void *item,
+                            size_t (*hash_of)(const void *item));
+
+/* Remove item, false if it is not present. Like insert it moves some items
+ * left behind by a resize for which hash_of is needed. */
+bool coral_hash_table_remove(struct coral_hash_table *object,
+                             size_t hash,
+                             const void *item,
+                             size_t (*hash_of)(const void *item));
+
+/* First item in slot order or NULL if the table is empty. */
+void *coral_hash_table_first(const struct coral_hash_table *object);
+
+/* Item after item in slot order or NULL if it was the last one. */
+void *coral_hash_table_next(const struct coral_hash_table *object,
+                            size_t hash,
+                            const void *item);
+
+/* Release the slots calling on_item, if given, with every item. */
+void coral_hash_table_invalidate(struct coral_hash_table *object,
+                                 void (*on_item)(void *item, void *context),
+                                 void *context);
+
+#endif /* _CORAL_SRC_HASH_TABLE_H_ */
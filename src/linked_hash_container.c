@@ -0,0 +1,378 @@
+#include <stdlib.h>
+#include <seagrass.h>
+#include <coral.h>
+
+#include "counters.h"
+#include "hash_table.h"
+
+#ifdef TEST
+#include <test/cmocka.h>
+#endif
+
+struct coral_linked_hash_container_entry {
+    void *data;
+};
+
+struct entry {
+    size_t hash;
+    struct rock_linked_list_node ll_node;
+    const struct coral_allocator *allocator;
+    unsigned char data[];
+};
+
+int coral_linked_hash_container_alloc_with(
+        const struct coral_allocator *allocator,
+        const size_t size,
+        struct coral_linked_hash_container_entry **const out) {
+    if (!size) {
+        return CORAL_LINKED_HASH_CONTAINER_ERROR_SIZE_IS_ZERO;
+    }
+    if (!out) {
+        return CORAL_LINKED_HASH_CONTAINER_ERROR_OUT_IS_NULL;
+    }
+    int error;
+    uintmax_t alloc;
+    if ((error = seagrass_uintmax_t_add(size, sizeof(struct entry), &alloc))
+        || alloc > SIZE_MAX) {
+        seagrass_required_true(SEAGRASS_UINTMAX_T_ERROR_RESULT_IS_INCONSISTENT
+                               == error || !error);
+        return CORAL_LINKED_HASH_CONTAINER_ERROR_SIZE_IS_TOO_LARGE;
+    }
+    if (!allocator) {
+        seagrass_required_true(!coral_allocator_get_default(&allocator));
+    }
+    struct entry *entry;
+    if (allocator->alloc(allocator->context, sizeof(void *), alloc,
+                         (void **) &entry)) {
+        return CORAL_LINKED_HASH_CONTAINER_ERROR_MEMORY_ALLOCATION_FAILED;
+    }
+    entry->hash = 0;
+    seagrass_required_true(!rock_linked_list_node_init(
+            &entry->ll_node));
+    entry->allocator = allocator;
+    coral_allocation_counters_alloc();
+    *out = (struct coral_linked_hash_container_entry *) &entry->data;
+    return 0;
+}
+
+int coral_linked_hash_container_alloc(
+        const size_t size,
+        struct coral_linked_hash_container_entry **const out) {
+    return coral_linked_hash_container_alloc_with(NULL, size, out);
+}
+
+int coral_linked_hash_container_free(
+        struct coral_linked_hash_container_entry *const entry) {
+    if (!entry) {
+        return CORAL_LINKED_HASH_CONTAINER_ERROR_ENTRY_IS_NULL;
+    }
+    struct entry *const A = rock_container_of(entry, struct entry, data);
+    coral_allocation_counters_free();
+    A->allocator->free(A->allocator->context, A);
+    return 0;
+}
+
+int coral_linked_hash_container_init(
+        struct coral_linked_hash_container *const object,
+        size_t (*const hash)(const void *entry),
+        int (*const compare)(const void *first,
+                             const void *second)) {
+    if (!object) {
+        return CORAL_LINKED_HASH_CONTAINER_ERROR_OBJECT_IS_NULL;
+    }
+    if (!hash) {
+        return CORAL_LINKED_HASH_CONTAINER_ERROR_HASH_IS_NULL;
+    }
+    if (!compare) {
+        return CORAL_LINKED_HASH_CONTAINER_ERROR_COMPARE_IS_NULL;
+    }
+    *object = (struct coral_linked_hash_container) {
+            .hash = hash,
+            .compare = compare
+    };
+    return 0;
+}
+
+int coral_linked_hash_container_invalidate(
+        struct coral_linked_hash_container *const object,
+        void (*const on_destroy)(
+                struct coral_linked_hash_container_entry *entry)) {
+    if (!object) {
+        return CORAL_LINKED_HASH_CONTAINER_ERROR_OBJECT_IS_NULL;
+    }
+    /* follow insertion order, the table is dropped without visiting it */
+    struct rock_linked_list_node *node = object->list;
+    for (uintmax_t i = 0; i < object->table.count; i++) {
+        struct rock_linked_list_node *next;
+        seagrass_required_true(!rock_linked_list_next(node, &next));
+        struct entry *const A = rock_container_of(node, struct entry,
+                                                  ll_node);
+        struct coral_linked_hash_container_entry *const entry
+                = (struct coral_linked_hash_container_entry *) &A->data;
+        if (on_destroy) {
+            on_destroy(entry);
+        }
+        seagrass_required_true(!coral_linked_hash_container_free(entry));
+        node = next;
+    }
+    coral_hash_table_invalidate(&object->table, NULL, NULL);
+    *object = (struct coral_linked_hash_container) {0};
+    return 0;
+}
+
+int coral_linked_hash_container_count(
+        const struct coral_linked_hash_container *const object,
+        uintmax_t *const out) {
+    if (!object) {
+        return CORAL_LINKED_HASH_CONTAINER_ERROR_OBJECT_IS_NULL;
+    }
+    if (!out) {
+        return CORAL_LINKED_HASH_CONTAINER_ERROR_OUT_IS_NULL;
+    }
+    *out = object->table.count;
+    return 0;
+}
+
+static bool equal(const void *const key,
+                  const void *const item,
+                  const void *const context) {
+    const struct coral_linked_hash_container *const object = context;
+    const struct entry *const B = item;
+    coral_counters_add(&object->table, compare, 1);
+    return !object->compare(key, &B->data);
+}
+
+static size_t hash_of(const void *const item) {
+    const struct entry *const A = item;
+    return A->hash;
+}
+
+static int attach(struct coral_linked_hash_container *const object,
+                  struct entry *const A) {
+    const size_t hash = object->hash(&A->data);
+    if (coral_hash_table_find(&object->table, hash, &A->data, equal,
+                              object)) {
+        return CORAL_LINKED_HASH_CONTAINER_ERROR_ENTRY_ALREADY_EXISTS;
+    }
+    A->hash = hash;
+    if (coral_hash_table_insert(&object->table, hash, A, hash_of)) {
+        return CORAL_LINKED_HASH_CONTAINER_ERROR_MEMORY_ALLOCATION_FAILED;
+    }
+    return 0;
+}
+
+int coral_linked_hash_container_add(
+        struct coral_linked_hash_container *const object,
+        const struct coral_linked_hash_container_entry *const entry) {
+    if (!object) {
+        return CORAL_LINKED_HASH_CONTAINER_ERROR_OBJECT_IS_NULL;
+    }
+    if (!entry) {
+        return CORAL_LINKED_HASH_CONTAINER_ERROR_ENTRY_IS_NULL;
+    }
+    int error;
+    struct entry *const A = rock_container_of(entry, struct entry, data);
+    if ((error = attach(object, A))) {
+        return error;
+    }
+    if (!object->list) {
+        object->list = &A->ll_node;
+    } else {
+        seagrass_required_true(!rock_linked_list_insert_before(
+                object->list, &A->ll_node));
+    }
+    return 0;
+}
+
+static void detach(struct coral_linked_hash_container *const object,
+                   struct rock_linked_list_node *const ll_node) {
+    if (ll_node == object->list) {
+        struct rock_linked_list_node *next;
+        seagrass_required_true(!rock_linked_list_next(ll_node, &next));
+        if (ll_node == next) {
+            object->list = NULL;
+        } else {
+            object->list = next;
+        }
+    }
+    seagrass_required_true(!rock_linked_list_remove(ll_node));
+}
+
+int coral_linked_hash_container_remove(
+        struct coral_linked_hash_container *const object,
+        const struct coral_linked_hash_container_entry *const entry) {
+    if (!object) {
+        return CORAL_LINKED_HASH_CONTAINER_ERROR_OBJECT_IS_NULL;
+    }
+    if (!entry) {
+        return CORAL_LINKED_HASH_CONTAINER_ERROR_ENTRY_IS_NULL;
+    }
+    struct entry *const A = rock_container_of(entry, struct entry, data);
+    if (!coral_hash_table_remove(&object->table, A->hash, A, hash_of)) {
+        return CORAL_LINKED_HASH_CONTAINER_ERROR_ENTRY_NOT_FOUND;
+    }
+    detach(object, &A->ll_node);
+    return 0;
+}
+
+int coral_linked_hash_container_get(
+        const struct coral_linked_hash_container *const object,
+        const void *const key,
+        struct coral_linked_hash_container_entry **const out) {
+    if (!object) {
+        return CORAL_LINKED_HASH_CONTAINER_ERROR_OBJECT_IS_NULL;
+    }
+    if (!key) {
+        return CORAL_LINKED_HASH_CONTAINER_ERROR_KEY_IS_NULL;
+    }
+    if (!out) {
+        return CORAL_LINKED_HASH_CONTAINER_ERROR_OUT_IS_NULL;
+    }
+    struct entry *const B = coral_hash_table_find(
+            &object->table, object->hash(key), key, equal, object);
+    if (!B) {
+        return CORAL_LINKED_HASH_CONTAINER_ERROR_ENTRY_NOT_FOUND;
+    }
+    *out = (struct coral_linked_hash_container_entry *) &B->data;
+    return 0;
+}
+
+int coral_linked_hash_container_first(
+        const struct coral_linked_hash_container *const object,
+        struct coral_linked_hash_container_entry **const out) {
+    if (!object) {
+        return CORAL_LINKED_HASH_CONTAINER_ERROR_OBJECT_IS_NULL;
+    }
+    if (!out) {
+        return CORAL_LINKED_HASH_CONTAINER_ERROR_OUT_IS_NULL;
+    }
+    if (!object->list) {
+        return CORAL_LINKED_HASH_CONTAINER_ERROR_CONTAINER_IS_EMPTY;
+    }
+    const struct entry *const A
+            = rock_container_of(object->list, struct entry, ll_node);
+    *out = (struct coral_linked_hash_container_entry *) &A->data;
+    return 0;
+}
+
+int coral_linked_hash_container_last(
+        const struct coral_linked_hash_container *const object,
+        struct coral_linked_hash_container_entry **const out) {
+    if (!object) {
+        return CORAL_LINKED_HASH_CONTAINER_ERROR_OBJECT_IS_NULL;
+    }
+    if (!out) {
+        return CORAL_LINKED_HASH_CONTAINER_ERROR_OUT_IS_NULL;
+    }
+    if (!object->list) {
+        return CORAL_LINKED_HASH_CONTAINER_ERROR_CONTAINER_IS_EMPTY;
+    }
+    struct rock_linked_list_node *node;
+    seagrass_required_true(!rock_linked_list_prev(object->list, &node));
+    const struct entry *const A
+            = rock_container_of(node, struct entry, ll_node);
+    *out = (struct coral_linked_hash_container_entry *) &A->data;
+    return 0;
+}
+
+int coral_linked_hash_container_next(
+        const struct coral_linked_hash_container *const object,
+        const struct coral_linked_hash_container_entry *const entry,
+        struct coral_linked_hash_container_entry **const out) {
+    if (!object) {
+        return CORAL_LINKED_HASH_CONTAINER_ERROR_OBJECT_IS_NULL;
+    }
+    if (!entry) {
+        return CORAL_LINKED_HASH_CONTAINER_ERROR_ENTRY_IS_NULL;
+    }
+    if (!out) {
+        return CORAL_LINKED_HASH_CONTAINER_ERROR_OUT_IS_NULL;
+    }
+    const struct entry *const B = rock_container_of(entry, struct entry, data);
+    struct rock_linked_list_node *node;
+    seagrass_required_true(!rock_linked_list_next(&B->ll_node, &node));
+    if (&B->ll_node == node || object->list == node) {
+        return CORAL_LINKED_HASH_CONTAINER_ERROR_END_OF_SEQUENCE;
+    }
+    const struct entry *const A
+            = rock_container_of(node, struct entry, ll_node);
+    *out = (struct coral_linked_hash_container_entry *) &A->data;
+    return 0;
+}
+
+int coral_linked_hash_container_prev(
+        const struct coral_linked_hash_container *const object,
+        const struct coral_linked_hash_container_entry *const entry,
+        struct coral_linked_hash_container_entry **const out) {
+    if (!object) {
+        return CORAL_LINKED_HASH_CONTAINER_ERROR_OBJECT_IS_NULL;
+    }
+    if (!entry) {
+        return CORAL_LINKED_HASH_CONTAINER_ERROR_ENTRY_IS_NULL;
+    }
+    if (!out) {
+        return CORAL_LINKED_HASH_CONTAINER_ERROR_OUT_IS_NULL;
+    }
+    const struct entry *const B = rock_container_of(entry, struct entry, data);
+    if (&B->ll_node == object->list) {
+        return CORAL_LINKED_HASH_CONTAINER_ERROR_END_OF_SEQUENCE;
+    }
+    struct rock_linked_list_node *node;
+    seagrass_required_true(!rock_linked_list_prev(&B->ll_node, &node));
+    if (&B->ll_node == node) {
+        return CORAL_LINKED_HASH_CONTAINER_ERROR_END_OF_SEQUENCE;
+    }
+    const struct entry *const A
+            = rock_container_of(node, struct entry, ll_node);
+    *out = (struct coral_linked_hash_container_entry *) &A->data;
+    return 0;
+}
+
+int coral_linked_hash_container_insert(
+        struct coral_linked_hash_container *const object,
+        struct coral_linked_hash_container_entry *const entry,
+        struct coral_linked_hash_container_entry *const item) {
+    if (!object) {
+        return CORAL_LINKED_HASH_CONTAINER_ERROR_OBJECT_IS_NULL;
+    }
+    if (!entry) {
+        return CORAL_LINKED_HASH_CONTAINER_ERROR_ENTRY_IS_NULL;
+    }
+    if (!item) {
+        return CORAL_LINKED_HASH_CONTAINER_ERROR_ITEM_IS_NULL;
+    }
+    int error;
+    struct entry *const A = rock_container_of(item, struct entry, data);
+    if ((error = attach(object, A))) {
+        return error;
+    }
+    struct entry *const B = rock_container_of(entry, struct entry, data);
+    seagrass_required_true(!rock_linked_list_insert_before(
+            &B->ll_node, &A->ll_node));
+    if (&B->ll_node == object->list) {
+        object->list = &A->ll_node;
+    }
+    return 0;
+}
+
+int coral_linked_hash_container_counters(
+        const struct coral_linked_hash_container *const object,
+        struct coral_counters *const out) {
+    if (!object) {
+        return CORAL_LINKED_HASH_CONTAINER_ERROR_OBJECT_IS_NULL;
+    }
+    if (!out) {
+        return CORAL_LINKED_HASH_CONTAINER_ERROR_OUT_IS_NULL;
+    }
+    coral_counters_snapshot(&object->table, out);
+    return 0;
+}
+
+int coral_linked_hash_container_counters_reset(
+        struct coral_linked_hash_container *const object) {
+    if (!object) {
+        return CORAL_LINKED_HASH_CONTAINER_ERROR_OBJECT_IS_NULL;
+    }
+    coral_counters_reset(&object->table);
+    return 0;
+}
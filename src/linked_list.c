@@ -1,9 +1,10 @@
 #include <stdlib.h>
 #include <assert.h>
-#include <errno.h>
 #include <seagrass.h>
 #include <coral.h>
 
+#include "counters.h"
+
 #ifdef TEST
 #include <test/cmocka.h>
 #endif
@@ -13,12 +14,14 @@ struct coral_linked_list_item {
 };
 
 struct item {
-    struct rock_linked_list_node node;
+    struct coral_linked_list_node node;
     unsigned char data[];
 };
 
-int coral_linked_list_alloc(const size_t size,
-                            struct coral_linked_list_item **const out) {
+int coral_linked_list_alloc_with(
+        const struct coral_allocator *allocator,
+        const size_t size,
+        struct coral_linked_list_item **const out) {
     if (!size) {
         return CORAL_LINKED_LIST_ERROR_SIZE_IS_ZERO;
     }
@@ -33,12 +36,78 @@ int coral_linked_list_alloc(const size_t size,
                                == error || !error);
         return CORAL_LINKED_LIST_ERROR_SIZE_IS_TOO_LARGE;
     }
+    if (!allocator) {
+        seagrass_required_true(!coral_allocator_get_default(&allocator));
+    }
     struct item *item;
-    if ((error = posix_memalign((void **) &item, sizeof(void *), alloc))) {
-        seagrass_required_true(ENOMEM == error);
+    if (allocator->alloc(allocator->context, sizeof(void *), alloc,
+                         (void **) &item)) {
         return CORAL_LINKED_LIST_ERROR_MEMORY_ALLOCATION_FAILED;
     }
-    seagrass_required_true(!rock_linked_list_node_init(&item->node));
+    seagrass_required_true(!rock_linked_list_node_init(&item->node.node));
+    item->node.allocator = allocator;
+    coral_allocation_counters_alloc();
+    *out = (struct coral_linked_list_item *) &item->data;
+    return 0;
+}
+
+int coral_linked_list_alloc(const size_t size,
+                            struct coral_linked_list_item **const out) {
+    return coral_linked_list_alloc_with(NULL, size, out);
+}
+
+static void arena_free(void *const context, void *const memory) {
+    /* memory is released when the linked list is invalidated */
+}
+
+static bool is_foreign(const struct coral_linked_list *const object,
+                       const struct coral_linked_list_node *const node) {
+    return &object->allocator != node->allocator;
+}
+
+/* Items from the arena of another linked list would be left dangling once
+ * that linked list is invalidated. */
+static bool is_from_other_list(
+        const struct coral_linked_list *const object,
+        const struct coral_linked_list_node *const node) {
+    return node->allocator && arena_free == node->allocator->free
+           && is_foreign(object, node);
+}
+
+int coral_linked_list_arena_alloc(struct coral_linked_list *const object,
+                                  const size_t size,
+                                  struct coral_linked_list_item **const out) {
+    if (!object) {
+        return CORAL_LINKED_LIST_ERROR_OBJECT_IS_NULL;
+    }
+    if (!size) {
+        return CORAL_LINKED_LIST_ERROR_SIZE_IS_ZERO;
+    }
+    if (!out) {
+        return CORAL_LINKED_LIST_ERROR_OUT_IS_NULL;
+    }
+    int error;
+    uintmax_t alloc;
+    if ((error = seagrass_uintmax_t_add(size, sizeof(struct item), &alloc))
+        || alloc > SIZE_MAX) {
+        seagrass_required_true(SEAGRASS_UINTMAX_T_ERROR_RESULT_IS_INCONSISTENT
+                               == error || !error);
+        return CORAL_LINKED_LIST_ERROR_SIZE_IS_TOO_LARGE;
+    }
+    struct item *item;
+    if ((error = coral_arena_alloc(&object->arena, _Alignof(struct item),
+                                   alloc, (void **) &item))) {
+        seagrass_required_true(CORAL_ARENA_ERROR_MEMORY_ALLOCATION_FAILED
+                               == error
+                               || CORAL_ARENA_ERROR_SIZE_IS_TOO_LARGE
+                                  == error);
+        return CORAL_ARENA_ERROR_MEMORY_ALLOCATION_FAILED == error
+               ? CORAL_LINKED_LIST_ERROR_MEMORY_ALLOCATION_FAILED
+               : CORAL_LINKED_LIST_ERROR_SIZE_IS_TOO_LARGE;
+    }
+    seagrass_required_true(!rock_linked_list_node_init(&item->node.node));
+    item->node.allocator = &object->allocator;
+    coral_allocation_counters_alloc();
     *out = (struct coral_linked_list_item *) &item->data;
     return 0;
 }
@@ -48,7 +117,8 @@ int coral_linked_list_free(struct coral_linked_list_item *const item) {
         return CORAL_LINKED_LIST_ERROR_ITEM_IS_NULL;
     }
     struct item *const A = rock_container_of(item, struct item, data);
-    free(A);
+    coral_allocation_counters_free();
+    A->node.allocator->free(A->node.allocator->context, A);
     return 0;
 }
 
@@ -56,7 +126,14 @@ int coral_linked_list_init(struct coral_linked_list *const object) {
     if (!object) {
         return CORAL_LINKED_LIST_ERROR_OBJECT_IS_NULL;
     }
-    *object = (struct coral_linked_list) {0};
+    *object = (struct coral_linked_list) {
+            .allocator = {
+                    .free = arena_free,
+                    .context = object
+            }
+    };
+    seagrass_required_true(!coral_arena_init(
+            &object->arena, CORAL_LINKED_LIST_ARENA_SIZE));
     return 0;
 }
 
@@ -66,31 +143,27 @@ int coral_linked_list_invalidate(
     if (!object) {
         return CORAL_LINKED_LIST_ERROR_OBJECT_IS_NULL;
     }
-    int error;
-    struct coral_linked_list_item *item;
-    if ((error = coral_linked_list_first(object, &item))) {
-        seagrass_required_true(
-                CORAL_LINKED_LIST_ERROR_LIST_IS_EMPTY
-                == error);
-    } else {
-        while (true) {
-            struct coral_linked_list_item *next;
-            if ((error = coral_linked_list_next(object, item, &next))) {
-                seagrass_required_true(
-                        CORAL_LINKED_LIST_ERROR_END_OF_SEQUENCE
-                        == error);
+    /* when only arena items remain they are released along with it */
+    if (on_destroy || object->foreign) {
+        while (object->list) {
+            struct coral_linked_list_node *const node = rock_container_of(
+                    object->list, struct coral_linked_list_node, node);
+            seagrass_required_true(!coral_linked_list_remove_node(
+                    object, node));
+            if (!node->allocator) {
+                /* intrusive nodes are owned by the caller */
+                continue;
             }
-            seagrass_required_true(!coral_linked_list_remove(object, item));
+            struct item *const A = rock_container_of(node, struct item, node);
+            struct coral_linked_list_item *const item
+                    = (struct coral_linked_list_item *) &A->data;
             if (on_destroy) {
                 on_destroy(item);
             }
             seagrass_required_true(!coral_linked_list_free(item));
-            if (error) {
-                break;
-            }
-            item = next;
         }
     }
+    seagrass_required_true(!coral_arena_invalidate(&object->arena));
     *object = (struct coral_linked_list) {0};
     return 0;
 }
@@ -107,6 +180,18 @@ int coral_linked_list_count(struct coral_linked_list *const object,
     return 0;
 }
 
+static struct coral_linked_list_item *to_item(
+        const struct coral_linked_list_node *const node) {
+    const struct item *const A = rock_container_of(node, struct item, node);
+    return (struct coral_linked_list_item *) &A->data;
+}
+
+static struct coral_linked_list_node *to_node(
+        const struct coral_linked_list_item *const item) {
+    struct item *const A = rock_container_of(item, struct item, data);
+    return &A->node;
+}
+
 int coral_linked_list_add(struct coral_linked_list *const object,
                           struct coral_linked_list_item *const item) {
     if (!object) {
@@ -115,61 +200,195 @@ int coral_linked_list_add(struct coral_linked_list *const object,
     if (!item) {
         return CORAL_LINKED_LIST_ERROR_ITEM_IS_NULL;
     }
+    return coral_linked_list_add_node(object, to_node(item));
+}
+
+int coral_linked_list_insert(struct coral_linked_list *const object,
+                             struct coral_linked_list_item *const item,
+                             struct coral_linked_list_item *const value) {
+    if (!object) {
+        return CORAL_LINKED_LIST_ERROR_OBJECT_IS_NULL;
+    }
+    if (!item) {
+        return CORAL_LINKED_LIST_ERROR_ITEM_IS_NULL;
+    }
+    if (!value) {
+        return CORAL_LINKED_LIST_ERROR_VALUE_IS_NULL;
+    }
+    return coral_linked_list_insert_node(object, to_node(item),
+                                         to_node(value));
+}
+
+int coral_linked_list_remove(struct coral_linked_list *const object,
+                             struct coral_linked_list_item *const item) {
+    if (!object) {
+        return CORAL_LINKED_LIST_ERROR_OBJECT_IS_NULL;
+    }
+    if (!item) {
+        return CORAL_LINKED_LIST_ERROR_ITEM_IS_NULL;
+    }
+    return coral_linked_list_remove_node(object, to_node(item));
+}
+
+int coral_linked_list_first(const struct coral_linked_list *const object,
+                            struct coral_linked_list_item **const out) {
+    if (!object) {
+        return CORAL_LINKED_LIST_ERROR_OBJECT_IS_NULL;
+    }
+    if (!out) {
+        return CORAL_LINKED_LIST_ERROR_OUT_IS_NULL;
+    }
+    int error;
+    struct coral_linked_list_node *node;
+    if ((error = coral_linked_list_first_node(object, &node))) {
+        return error;
+    }
+    *out = to_item(node);
+    return 0;
+}
+
+int coral_linked_list_last(const struct coral_linked_list *const object,
+                           struct coral_linked_list_item **const out) {
+    if (!object) {
+        return CORAL_LINKED_LIST_ERROR_OBJECT_IS_NULL;
+    }
+    if (!out) {
+        return CORAL_LINKED_LIST_ERROR_OUT_IS_NULL;
+    }
+    int error;
+    struct coral_linked_list_node *node;
+    if ((error = coral_linked_list_last_node(object, &node))) {
+        return error;
+    }
+    *out = to_item(node);
+    return 0;
+}
+
+int coral_linked_list_next(const struct coral_linked_list *const object,
+                           const struct coral_linked_list_item *const item,
+                           struct coral_linked_list_item **const out) {
+    if (!object) {
+        return CORAL_LINKED_LIST_ERROR_OBJECT_IS_NULL;
+    }
+    if (!item) {
+        return CORAL_LINKED_LIST_ERROR_ITEM_IS_NULL;
+    }
+    if (!out) {
+        return CORAL_LINKED_LIST_ERROR_OUT_IS_NULL;
+    }
+    int error;
+    struct coral_linked_list_node *node;
+    if ((error = coral_linked_list_next_node(object, to_node(item), &node))) {
+        return error;
+    }
+    *out = to_item(node);
+    return 0;
+}
+
+int coral_linked_list_prev(const struct coral_linked_list *const object,
+                           const struct coral_linked_list_item *const item,
+                           struct coral_linked_list_item **const out) {
+    if (!object) {
+        return CORAL_LINKED_LIST_ERROR_OBJECT_IS_NULL;
+    }
+    if (!item) {
+        return CORAL_LINKED_LIST_ERROR_ITEM_IS_NULL;
+    }
+    if (!out) {
+        return CORAL_LINKED_LIST_ERROR_OUT_IS_NULL;
+    }
+    int error;
+    struct coral_linked_list_node *node;
+    if ((error = coral_linked_list_prev_node(object, to_node(item), &node))) {
+        return error;
+    }
+    *out = to_item(node);
+    return 0;
+}
+
+int coral_linked_list_node_init(struct coral_linked_list_node *const node) {
+    if (!node) {
+        return CORAL_LINKED_LIST_ERROR_NODE_IS_NULL;
+    }
+    seagrass_required_true(!rock_linked_list_node_init(&node->node));
+    node->allocator = NULL;
+    return 0;
+}
+
+int coral_linked_list_add_node(struct coral_linked_list *const object,
+                               struct coral_linked_list_node *const node) {
+    if (!object) {
+        return CORAL_LINKED_LIST_ERROR_OBJECT_IS_NULL;
+    }
+    if (!node) {
+        return CORAL_LINKED_LIST_ERROR_NODE_IS_NULL;
+    }
+    if (is_from_other_list(object, node)) {
+        return CORAL_LINKED_LIST_ERROR_ITEM_IS_FROM_OTHER_LIST;
+    }
     seagrass_required_true(!seagrass_uintmax_t_add(
             1, object->count, &object->count));
-    struct item *const A = rock_container_of(item, struct item, data);
+    if (is_foreign(object, node)) {
+        object->foreign++;
+    }
     if (!object->list) {
-        object->list = &A->node;
+        object->list = &node->node;
     } else {
         seagrass_required_true(!rock_linked_list_insert_before(
-                object->list, &A->node));
+                object->list, &node->node));
     }
     return 0;
 }
 
-int coral_linked_list_insert(struct coral_linked_list *const object,
-                             struct coral_linked_list_item *const item,
-                             struct coral_linked_list_item *const value) {
+int coral_linked_list_insert_node(struct coral_linked_list *const object,
+                                  struct coral_linked_list_node *const node,
+                                  struct coral_linked_list_node *const value) {
     if (!object) {
         return CORAL_LINKED_LIST_ERROR_OBJECT_IS_NULL;
     }
-    if (!item) {
-        return CORAL_LINKED_LIST_ERROR_ITEM_IS_NULL;
+    if (!node) {
+        return CORAL_LINKED_LIST_ERROR_NODE_IS_NULL;
     }
     if (!value) {
         return CORAL_LINKED_LIST_ERROR_VALUE_IS_NULL;
     }
+    if (is_from_other_list(object, value)) {
+        return CORAL_LINKED_LIST_ERROR_ITEM_IS_FROM_OTHER_LIST;
+    }
     seagrass_required_true(!seagrass_uintmax_t_add(
             1, object->count, &object->count));
-    struct item *const A = rock_container_of(item, struct item, data);
-    struct item *const B = rock_container_of(value, struct item, data);
+    if (is_foreign(object, value)) {
+        object->foreign++;
+    }
     seagrass_required_true(!rock_linked_list_insert_before(
-            &A->node, &B->node));
-    if (object->list == &A->node) {
-        object->list = &B->node;
+            &node->node, &value->node));
+    if (object->list == &node->node) {
+        object->list = &value->node;
     }
     return 0;
 }
 
-int coral_linked_list_remove(struct coral_linked_list *const object,
-                             struct coral_linked_list_item *const item) {
+int coral_linked_list_remove_node(struct coral_linked_list *const object,
+                                  struct coral_linked_list_node *const node) {
     if (!object) {
         return CORAL_LINKED_LIST_ERROR_OBJECT_IS_NULL;
     }
-    if (!item) {
-        return CORAL_LINKED_LIST_ERROR_ITEM_IS_NULL;
+    if (!node) {
+        return CORAL_LINKED_LIST_ERROR_NODE_IS_NULL;
     }
-    struct item *const A = rock_container_of(item, struct item, data);
-    if (&A->node == object->list) {
+    if (&node->node == object->list) {
         struct rock_linked_list_node *next;
-        seagrass_required_true(!rock_linked_list_next(&A->node, &next));
-        if (&A->node == next) {
+        seagrass_required_true(!rock_linked_list_next(&node->node, &next));
+        if (&node->node == next) {
             object->list = NULL;
         } else {
             object->list = next;
         }
     }
-    seagrass_required_true(!rock_linked_list_remove(&A->node));
+    seagrass_required_true(!rock_linked_list_remove(&node->node));
+    if (is_foreign(object, node)) {
+        object->foreign--;
+    }
     if (object->count) {
         seagrass_required_true(!seagrass_uintmax_t_subtract(
                 object->count, 1, &object->count));
@@ -177,8 +396,8 @@ int coral_linked_list_remove(struct coral_linked_list *const object,
     return 0;
 }
 
-int coral_linked_list_first(const struct coral_linked_list *const object,
-                            struct coral_linked_list_item **const out) {
+int coral_linked_list_first_node(const struct coral_linked_list *const object,
+                                 struct coral_linked_list_node **const out) {
     if (!object) {
         return CORAL_LINKED_LIST_ERROR_OBJECT_IS_NULL;
     }
@@ -188,14 +407,13 @@ int coral_linked_list_first(const struct coral_linked_list *const object,
     if (!object->count) {
         return CORAL_LINKED_LIST_ERROR_LIST_IS_EMPTY;
     }
-    const struct item *const A =
-            rock_container_of(object->list, struct item, node);
-    *out = (struct coral_linked_list_item *) &A->data;
+    *out = rock_container_of(object->list, struct coral_linked_list_node,
+                             node);
     return 0;
 }
 
-int coral_linked_list_last(const struct coral_linked_list *const object,
-                           struct coral_linked_list_item **const out) {
+int coral_linked_list_last_node(const struct coral_linked_list *const object,
+                                struct coral_linked_list_node **const out) {
     if (!object) {
         return CORAL_LINKED_LIST_ERROR_OBJECT_IS_NULL;
     }
@@ -205,61 +423,55 @@ int coral_linked_list_last(const struct coral_linked_list *const object,
     if (!object->count) {
         return CORAL_LINKED_LIST_ERROR_LIST_IS_EMPTY;
     }
-    const struct item *const B
-            = rock_container_of(object->list, struct item, node);
     struct rock_linked_list_node *node;
-    seagrass_required_true(!rock_linked_list_prev(&B->node, &node));
-    const struct item *const A = rock_container_of(node, struct item, node);
-    *out = (struct coral_linked_list_item *) &A->data;
+    seagrass_required_true(!rock_linked_list_prev(object->list, &node));
+    *out = rock_container_of(node, struct coral_linked_list_node, node);
     return 0;
 }
 
-int coral_linked_list_next(const struct coral_linked_list *const object,
-                           const struct coral_linked_list_item *const item,
-                           struct coral_linked_list_item **const out) {
+int coral_linked_list_next_node(
+        const struct coral_linked_list *const object,
+        const struct coral_linked_list_node *const node,
+        struct coral_linked_list_node **const out) {
     if (!object) {
         return CORAL_LINKED_LIST_ERROR_OBJECT_IS_NULL;
     }
-    if (!item) {
-        return CORAL_LINKED_LIST_ERROR_ITEM_IS_NULL;
+    if (!node) {
+        return CORAL_LINKED_LIST_ERROR_NODE_IS_NULL;
     }
     if (!out) {
         return CORAL_LINKED_LIST_ERROR_OUT_IS_NULL;
     }
-    const struct item *const B = rock_container_of(item, struct item, data);
-    struct rock_linked_list_node *node;
-    seagrass_required_true(!rock_linked_list_next(&B->node, &node));
-    if (&B->node == node || object->list == node) {
+    struct rock_linked_list_node *next;
+    seagrass_required_true(!rock_linked_list_next(&node->node, &next));
+    if (&node->node == next || object->list == next) {
         return CORAL_LINKED_LIST_ERROR_END_OF_SEQUENCE;
     }
-    const struct item *const A = rock_container_of(node, struct item, node);
-    *out = (struct coral_linked_list_item *) &A->data;
+    *out = rock_container_of(next, struct coral_linked_list_node, node);
     return 0;
 }
 
-int coral_linked_list_prev(const struct coral_linked_list *const object,
-                           const struct coral_linked_list_item *const item,
-                           struct coral_linked_list_item **const out) {
+int coral_linked_list_prev_node(
+        const struct coral_linked_list *const object,
+        const struct coral_linked_list_node *const node,
+        struct coral_linked_list_node **const out) {
     if (!object) {
         return CORAL_LINKED_LIST_ERROR_OBJECT_IS_NULL;
     }
-    if (!item) {
-        return CORAL_LINKED_LIST_ERROR_ITEM_IS_NULL;
+    if (!node) {
+        return CORAL_LINKED_LIST_ERROR_NODE_IS_NULL;
     }
     if (!out) {
         return CORAL_LINKED_LIST_ERROR_OUT_IS_NULL;
     }
-    const struct item *const B = rock_container_of(item, struct item, data);
-    if (&B->node == object->list) {
+    if (&node->node == object->list) {
         return CORAL_LINKED_LIST_ERROR_END_OF_SEQUENCE;
     }
-    struct rock_linked_list_node *node;
-    seagrass_required_true(!rock_linked_list_prev(&B->node, &node));
-    if (&B->node == node) {
+    struct rock_linked_list_node *prev;
+    seagrass_required_true(!rock_linked_list_prev(&node->node, &prev));
+    if (&node->node == prev) {
         return CORAL_LINKED_LIST_ERROR_END_OF_SEQUENCE;
     }
-    const struct item *const A = rock_container_of(node, struct item, node);
-    *out = (struct coral_linked_list_item *) &A->data;
+    *out = rock_container_of(prev, struct coral_linked_list_node, node);
     return 0;
 }
-
@@ -1,9 +1,10 @@
 #include <stdlib.h>
 #include <assert.h>
-#include <errno.h>
 #include <seagrass.h>
 #include <coral.h>
 
+#include "counters.h"
+
 #ifdef TEST
 #include <test/cmocka.h>
 #endif
@@ -13,12 +14,14 @@ struct coral_linked_red_black_tree_container_entry {
 };
 
 struct entry {
-    struct rock_red_black_tree_node rbt_node;
+    struct coral_red_black_tree_node rbt_node;
     struct rock_linked_list_node ll_node;
+    const struct coral_allocator *allocator;
     unsigned char data[];
 };
 
-int coral_linked_red_black_tree_container_alloc(
+int coral_linked_red_black_tree_container_alloc_with(
+        const struct coral_allocator *allocator,
         const size_t size,
         struct coral_linked_red_black_tree_container_entry **const out) {
     if (!size) {
@@ -35,37 +38,122 @@ int coral_linked_red_black_tree_container_alloc(
                                == error || !error);
         return CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_SIZE_IS_TOO_LARGE;
     }
+    if (!allocator) {
+        seagrass_required_true(!coral_allocator_get_default(&allocator));
+    }
     struct entry *entry;
-    if ((error = posix_memalign((void **) &entry, sizeof(void *), alloc))) {
-        seagrass_required_true(ENOMEM == error);
+    if (allocator->alloc(allocator->context, sizeof(void *), alloc,
+                         (void **) &entry)) {
         return
         CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_MEMORY_ALLOCATION_FAILED;
     }
-    seagrass_required_true(!rock_red_black_tree_node_init(
+    seagrass_required_true(!coral_red_black_tree_node_init(
             &entry->rbt_node));
     seagrass_required_true(!rock_linked_list_node_init(
             &entry->ll_node));
+    entry->allocator = allocator;
+    coral_allocation_counters_alloc();
     *out = (struct coral_linked_red_black_tree_container_entry *) &entry->data;
     return 0;
 }
 
+int coral_linked_red_black_tree_container_alloc(
+        const size_t size,
+        struct coral_linked_red_black_tree_container_entry **const out) {
+    return coral_linked_red_black_tree_container_alloc_with(NULL, size, out);
+}
+
 int coral_linked_red_black_tree_container_free(
         struct coral_linked_red_black_tree_container_entry *const entry) {
     if (!entry) {
         return CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_ENTRY_IS_NULL;
     }
     struct entry *const A = rock_container_of(entry, struct entry, data);
-    free(A);
+    coral_allocation_counters_free();
+    A->allocator->free(A->allocator->context, A);
     return 0;
 }
 
-static _Thread_local const struct coral_linked_red_black_tree_container *this;
+int coral_linked_red_black_tree_container_node_init(
+        struct coral_linked_red_black_tree_container_node *const node) {
+    if (!node) {
+        return CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_NODE_IS_NULL;
+    }
+    seagrass_required_true(!coral_red_black_tree_node_init(&node->rbt_node));
+    seagrass_required_true(!rock_linked_list_node_init(&node->ll_node));
+    return 0;
+}
+
+static int entity_compare(const void *const key,
+                          const struct coral_red_black_tree_node *const node,
+                          void *const context) {
+    const struct coral_linked_red_black_tree_container *const object
+            = context;
+    const struct entry *const B = rock_container_of(node, struct entry,
+                                                    rbt_node);
+    coral_counters_add(&object->tree, compare, 1);
+    return object->compare(key, &B->data);
+}
+
+static struct coral_linked_red_black_tree_container_node *from_rbt_node(
+        const struct coral_red_black_tree_node *const node) {
+    return rock_container_of(
+            node, struct coral_linked_red_black_tree_container_node, rbt_node);
+}
+
+static struct coral_linked_red_black_tree_container_node *from_ll_node(
+        const struct rock_linked_list_node *const node) {
+    return rock_container_of(
+            node, struct coral_linked_red_black_tree_container_node, ll_node);
+}
+
+static int node_compare(const void *const key,
+                        const struct coral_red_black_tree_node *const node,
+                        void *const context) {
+    const struct coral_linked_red_black_tree_container *const object
+            = context;
+    coral_counters_add(&object->tree, compare, 1);
+    return object->compare_node(key, from_rbt_node(node));
+}
+
+static int key_compare(const void *const key,
+                       const struct coral_red_black_tree_node *const node,
+                       void *const context) {
+    const struct coral_linked_red_black_tree_container *const object
+            = context;
+    const struct entry *const B = rock_container_of(node, struct entry,
+                                                    rbt_node);
+    coral_counters_add(&object->tree, compare, 1);
+    return object->compare_key(key, &B->data);
+}
+
+static int find(
+        const struct coral_linked_red_black_tree_container *const object,
+        const void *const key,
+        int (*const compare)(const void *,
+                             const struct coral_red_black_tree_node *,
+                             void *),
+        struct coral_red_black_tree_node **const out) {
+    return coral_red_black_tree_find(
+            &object->tree, key, compare, (void *) object, out);
+}
 
-static int entity_compare(const struct rock_red_black_tree_node *const a,
-                          const struct rock_red_black_tree_node *const b) {
-    const struct entry *const A = rock_container_of(a, struct entry, rbt_node);
-    const struct entry *const B = rock_container_of(b, struct entry, rbt_node);
-    return this->compare(&A->data, &B->data);
+static int attach(
+        struct coral_linked_red_black_tree_container *const object,
+        const void *const key,
+        struct coral_red_black_tree_node *const node,
+        int (*const compare)(const void *,
+                             const struct coral_red_black_tree_node *,
+                             void *)) {
+    const int error = coral_red_black_tree_insert(
+            &object->tree, key, node, compare, object);
+    if (error) {
+        seagrass_required_true(CORAL_RED_BLACK_TREE_ERROR_NODE_ALREADY_EXISTS
+                               == error);
+        return CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_ENTRY_ALREADY_EXISTS;
+    }
+    coral_counters_add(&object->tree, insert, 1);
+    return 0;
 }
 
 int coral_linked_red_black_tree_container_init(
@@ -79,12 +167,45 @@ int coral_linked_red_black_tree_container_init(
         return CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_COMPARE_IS_NULL;
     }
     *object = (struct coral_linked_red_black_tree_container) {0};
-    seagrass_required_true(!rock_red_black_tree_init(
-            &object->tree, entity_compare));
+    seagrass_required_true(!coral_red_black_tree_init(&object->tree));
     object->compare = compare;
     return 0;
 }
 
+int coral_linked_red_black_tree_container_init_with_key(
+        struct coral_linked_red_black_tree_container *const object,
+        int (*const compare)(const void *first,
+                             const void *second),
+        int (*const compare_key)(const void *key,
+                                 const void *entry)) {
+    if (!compare_key) {
+        return CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_COMPARE_IS_NULL;
+    }
+    int error;
+    if ((error = coral_linked_red_black_tree_container_init(object, compare))) {
+        return error;
+    }
+    object->compare_key = compare_key;
+    return 0;
+}
+
+int coral_linked_red_black_tree_container_init_intrusive(
+        struct coral_linked_red_black_tree_container *const object,
+        int (*const compare)(
+            const struct coral_linked_red_black_tree_container_node *first,
+            const struct coral_linked_red_black_tree_container_node *second)) {
+    if (!object) {
+        return CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_OBJECT_IS_NULL;
+    }
+    if (!compare) {
+        return CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_COMPARE_IS_NULL;
+    }
+    *object = (struct coral_linked_red_black_tree_container) {0};
+    seagrass_required_true(!coral_red_black_tree_init(&object->tree));
+    object->compare_node = compare;
+    return 0;
+}
+
 int coral_linked_red_black_tree_container_invalidate(
         struct coral_linked_red_black_tree_container *object,
         void (*const on_destroy)(
@@ -92,36 +213,29 @@ int coral_linked_red_black_tree_container_invalidate(
     if (!object) {
         return CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_OBJECT_IS_NULL;
     }
-    int error;
-    struct coral_linked_red_black_tree_container_entry *entry;
-    if ((error = coral_linked_red_black_tree_container_first(object, &entry))) {
-        seagrass_required_true(
-                CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_CONTAINER_IS_EMPTY
-                == error);
+    if (object->compare_node) {
+        /* nodes are owned by the caller */
     } else {
-        while (true) {
-            struct coral_linked_red_black_tree_container_entry *next;
-            if ((error = coral_linked_red_black_tree_container_next(
-                    object, entry, &next))) {
-                seagrass_required_true(
-                        CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_END_OF_SEQUENCE
-                        == error);
-            }
-            seagrass_required_true(!coral_linked_red_black_tree_container_remove(
-                            object, entry));
+        /* follow insertion order, the tree is dropped without rebalancing */
+        struct rock_linked_list_node *node = object->list;
+        for (uintmax_t i = 0; i < object->tree.count; i++) {
+            struct rock_linked_list_node *next;
+            seagrass_required_true(!rock_linked_list_next(node, &next));
+            struct entry *const A = rock_container_of(node, struct entry,
+                                                      ll_node);
+            struct coral_linked_red_black_tree_container_entry *const entry
+                    = (struct coral_linked_red_black_tree_container_entry *)
+                            &A->data;
             if (on_destroy) {
                 on_destroy(entry);
             }
-            seagrass_required_true(!coral_linked_red_black_tree_container_free(
-                    entry));
-            if (error) {
-                break;
-            }
-            entry = next;
+            seagrass_required_true(
+                    !coral_linked_red_black_tree_container_free(entry));
+            node = next;
         }
     }
-    seagrass_required_true(!rock_red_black_tree_invalidate(
-            &object->tree, NULL));
+    seagrass_required_true(!coral_red_black_tree_invalidate(
+            &object->tree, NULL, NULL));
     *object = (struct coral_linked_red_black_tree_container) {0};
     return 0;
 }
@@ -135,8 +249,28 @@ int coral_linked_red_black_tree_container_count(
     if (!out) {
         return CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_OUT_IS_NULL;
     }
-    seagrass_required_true(!rock_red_black_tree_count(
-            &object->tree, out));
+    *out = object->tree.count;
+    return 0;
+}
+
+static int insert(
+        struct coral_linked_red_black_tree_container *const object,
+        const void *const key,
+        struct coral_red_black_tree_node *const rbt_node,
+        struct rock_linked_list_node *const ll_node,
+        int (*const compare)(const void *,
+                             const struct coral_red_black_tree_node *,
+                             void *)) {
+    int error;
+    if ((error = attach(object, key, rbt_node, compare))) {
+        return error;
+    }
+    if (!object->list) {
+        object->list = ll_node;
+    } else {
+        seagrass_required_true(!rock_linked_list_insert_before(
+                object->list, ll_node));
+    }
     return 0;
 }
 
@@ -149,26 +283,93 @@ int coral_linked_red_black_tree_container_add(
     if (!entry) {
         return CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_ENTRY_IS_NULL;
     }
-    int error;
+    if (!object->compare) {
+        return CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_COMPARE_IS_NULL;
+    }
     struct entry *const A = rock_container_of(entry, struct entry, data);
-    struct rock_red_black_tree_node *insertion_point;
-    this = object;
-    if (!(error = rock_red_black_tree_find(&object->tree,
-                                           NULL,
-                                           &A->rbt_node,
-                                           &insertion_point))) {
-        return CORAL_RED_BLACK_TREE_CONTAINER_ERROR_ENTRY_ALREADY_EXISTS;
-    }
-    seagrass_required_true(ROCK_RED_BLACK_TREE_ERROR_NODE_NOT_FOUND
-                           == error);
-    seagrass_required_true(!rock_red_black_tree_insert(
-            &object->tree, insertion_point, &A->rbt_node));
-    if (!object->list) {
-        object->list = &A->ll_node;
-    } else {
-        seagrass_required_true(!rock_linked_list_insert_before(
-                object->list, &A->ll_node));
+    return insert(object, &A->data, &A->rbt_node, &A->ll_node,
+                  entity_compare);
+}
+
+static void detach(
+        struct coral_linked_red_black_tree_container *const object,
+        struct rock_linked_list_node *const ll_node) {
+    if (ll_node == object->list) {
+        struct rock_linked_list_node *next;
+        seagrass_required_true(!rock_linked_list_next(ll_node, &next));
+        if (ll_node == next) {
+            object->list = NULL;
+        } else {
+            object->list = next;
+        }
+    }
+    seagrass_required_true(!rock_linked_list_remove(ll_node));
+}
+
+static void erase(
+        struct coral_linked_red_black_tree_container *const object,
+        struct coral_red_black_tree_node *const rbt_node,
+        struct rock_linked_list_node *const ll_node) {
+    detach(object, ll_node);
+    seagrass_required_true(!coral_red_black_tree_remove(
+            &object->tree, rbt_node));
+    coral_counters_add(&object->tree, remove, 1);
+}
+
+static struct coral_red_black_tree_node *entry_at(const uintmax_t index,
+                                                  void *const context) {
+    struct coral_linked_red_black_tree_container_entry *const *const entries
+            = context;
+    struct entry *const A = rock_container_of(entries[index], struct entry,
+                                              data);
+    return &A->rbt_node;
+}
+
+int coral_linked_red_black_tree_container_build_sorted(
+        struct coral_linked_red_black_tree_container *const object,
+        struct coral_linked_red_black_tree_container_entry *const *entries,
+        const uintmax_t count) {
+    if (!object) {
+        return CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_OBJECT_IS_NULL;
+    }
+    if (!entries && count) {
+        return CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_ENTRY_IS_NULL;
+    }
+    if (!object->compare) {
+        return CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_COMPARE_IS_NULL;
+    }
+    if (object->tree.root) {
+        return CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_CONTAINER_IS_NOT_EMPTY;
     }
+    for (uintmax_t i = 0; i < count; i++) {
+        if (!entries[i]) {
+            return CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_ENTRY_IS_NULL;
+        }
+        if (!i) {
+            continue;
+        }
+        coral_counters_add(&object->tree, compare, 1);
+        const int result = object->compare(entries[i - 1], entries[i]);
+        if (!result) {
+            return CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_ENTRY_ALREADY_EXISTS;
+        }
+        if (result > 0) {
+            return CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_ENTRIES_ARE_NOT_SORTED;
+        }
+    }
+    seagrass_required_true(!coral_red_black_tree_build(
+            &object->tree, count, entry_at, (void *) entries));
+    for (uintmax_t i = 0; i < count; i++) {
+        struct entry *const A = rock_container_of(entries[i], struct entry,
+                                                  data);
+        if (!object->list) {
+            object->list = &A->ll_node;
+        } else {
+            seagrass_required_true(!rock_linked_list_insert_before(
+                    object->list, &A->ll_node));
+        }
+    }
+    coral_counters_add(&object->tree, insert, count);
     return 0;
 }
 
@@ -182,45 +383,100 @@ int coral_linked_red_black_tree_container_remove(
         return CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_ENTRY_IS_NULL;
     }
     struct entry *const A = rock_container_of(entry, struct entry, data);
-    if (&A->ll_node == object->list) {
-        struct rock_linked_list_node *next;
-        seagrass_required_true(!rock_linked_list_next(
-                &A->ll_node, &next));
-        if (&A->ll_node == next) {
-            object->list = NULL;
-        } else {
-            object->list = next;
-        }
+    erase(object, &A->rbt_node, &A->ll_node);
+    return 0;
+}
+
+struct removal {
+    struct coral_linked_red_black_tree_container *object;
+    void (*on_destroy)(struct coral_linked_red_black_tree_container_entry *);
+};
+
+static void destroy_node(struct coral_red_black_tree_node *const node,
+                         void *const context) {
+    const struct removal *const removal = context;
+    struct entry *const A = rock_container_of(node, struct entry, rbt_node);
+    struct coral_linked_red_black_tree_container_entry *const entry
+            = (struct coral_linked_red_black_tree_container_entry *) &A->data;
+    detach(removal->object, &A->ll_node);
+    if (removal->on_destroy) {
+        removal->on_destroy(entry);
     }
-    seagrass_required_true(!rock_linked_list_remove(&A->ll_node));
-    seagrass_required_true(!rock_red_black_tree_remove(
-            &object->tree, &A->rbt_node));
+    seagrass_required_true(!coral_linked_red_black_tree_container_free(entry));
+}
+
+static void remove_range(
+        struct coral_linked_red_black_tree_container *const object,
+        const void *const first,
+        const void *const last,
+        int (*const compare)(const void *,
+                             const struct coral_red_black_tree_node *,
+                             void *),
+        void (*const on_destroy)(
+                struct coral_linked_red_black_tree_container_entry *)) {
+    struct coral_red_black_tree removed;
+    seagrass_required_true(!coral_red_black_tree_remove_range(
+            &object->tree, first, last, compare, object, &removed));
+    coral_counters_add(&object->tree, remove, removed.count);
+    struct removal removal = {
+            .object = object,
+            .on_destroy = on_destroy
+    };
+    /* entries leave the insertion order one by one, in O(1) each */
+    seagrass_required_true(!coral_red_black_tree_invalidate(
+            &removed, destroy_node, &removal));
+}
+
+int coral_linked_red_black_tree_container_remove_range(
+        struct coral_linked_red_black_tree_container *const object,
+        const void *const first,
+        const void *const last,
+        void (*const on_destroy)(
+                struct coral_linked_red_black_tree_container_entry *entry)) {
+    if (!object) {
+        return CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_OBJECT_IS_NULL;
+    }
+    if (!first || !last) {
+        return CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_KEY_IS_NULL;
+    }
+    if (!object->compare) {
+        return CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_COMPARE_IS_NULL;
+    }
+    remove_range(object, first, last, entity_compare, on_destroy);
     return 0;
 }
 
-int coral_linked_red_black_tree_container_get(
-        const struct coral_linked_red_black_tree_container *const object,
-        const void *const key,
-        struct coral_linked_red_black_tree_container_entry **const out) {
+int coral_linked_red_black_tree_container_remove_range_key(
+        struct coral_linked_red_black_tree_container *const object,
+        const void *const first,
+        const void *const last,
+        void (*const on_destroy)(
+                struct coral_linked_red_black_tree_container_entry *entry)) {
     if (!object) {
         return CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_OBJECT_IS_NULL;
     }
-    if (!key) {
+    if (!first || !last) {
         return CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_KEY_IS_NULL;
     }
-    if (!out) {
-        return CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_OUT_IS_NULL;
+    if (!object->compare_key) {
+        return CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_COMPARE_IS_NULL;
     }
+    remove_range(object, first, last, key_compare, on_destroy);
+    return 0;
+}
+
+static int find_equal(
+        const struct coral_linked_red_black_tree_container *const object,
+        const void *const key,
+        int (*const compare)(const void *,
+                             const struct coral_red_black_tree_node *,
+                             void *),
+        struct coral_linked_red_black_tree_container_entry **const out) {
     int error;
-    struct entry *const K = rock_container_of(key, struct entry, data);
-    struct rock_red_black_tree_node *node;
-    this = object;
-    if ((error = rock_red_black_tree_find(&object->tree,
-                                          NULL,
-                                          &K->rbt_node,
-                                          &node))) {
+    struct coral_red_black_tree_node *node;
+    if ((error = find(object, key, compare, &node))) {
         seagrass_required_true(
-                ROCK_RED_BLACK_TREE_ERROR_NODE_NOT_FOUND
+                CORAL_RED_BLACK_TREE_ERROR_NODE_NOT_FOUND
                 == error);
         return CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_ENTRY_NOT_FOUND;
     }
@@ -229,7 +485,26 @@ int coral_linked_red_black_tree_container_get(
     return 0;
 }
 
-int coral_linked_red_black_tree_container_ceiling(
+int coral_linked_red_black_tree_container_get(
+        const struct coral_linked_red_black_tree_container *const object,
+        const void *const key,
+        struct coral_linked_red_black_tree_container_entry **const out) {
+    if (!object) {
+        return CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_OBJECT_IS_NULL;
+    }
+    if (!key) {
+        return CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_KEY_IS_NULL;
+    }
+    if (!out) {
+        return CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_OUT_IS_NULL;
+    }
+    if (!object->compare) {
+        return CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_COMPARE_IS_NULL;
+    }
+    return find_equal(object, key, entity_compare, out);
+}
+
+int coral_linked_red_black_tree_container_get_key(
         const struct coral_linked_red_black_tree_container *const object,
         const void *const key,
         struct coral_linked_red_black_tree_container_entry **const out) {
@@ -242,22 +517,34 @@ int coral_linked_red_black_tree_container_ceiling(
     if (!out) {
         return CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_OUT_IS_NULL;
     }
+    if (!object->compare_key) {
+        return CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_COMPARE_IS_NULL;
+    }
+    return find_equal(object, key, key_compare, out);
+}
+
+static int find_ceiling(
+        const struct coral_linked_red_black_tree_container *const object,
+        const void *const key,
+        int (*const compare)(const void *,
+                             const struct coral_red_black_tree_node *,
+                             void *),
+        struct coral_linked_red_black_tree_container_entry **const out) {
     int error;
-    struct entry *const K = rock_container_of(key, struct entry, data);
-    struct rock_red_black_tree_node *node;
-    this = object;
-    if ((error = rock_red_black_tree_find(&object->tree,
-                                          NULL,
-                                          &K->rbt_node,
-                                          &node))) {
+    struct coral_red_black_tree_node *node;
+    if ((error = find(object, key, compare, &node))) {
         seagrass_required_true(
-                ROCK_RED_BLACK_TREE_ERROR_NODE_NOT_FOUND
+                CORAL_RED_BLACK_TREE_ERROR_NODE_NOT_FOUND
                 == error);
         if (!node) {
             return CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_ENTRY_NOT_FOUND;
         }
         struct entry *const B = rock_container_of(node, struct entry, rbt_node);
-        if (entity_compare(&K->rbt_node, &B->rbt_node) > 0) {
+        if (compare(key, &B->rbt_node, (void *) object) > 0
+            && (error = coral_red_black_tree_next(node, &node))) {
+            seagrass_required_true(
+                    CORAL_RED_BLACK_TREE_ERROR_END_OF_SEQUENCE
+                    == error);
             return CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_ENTRY_NOT_FOUND;
         }
     }
@@ -266,7 +553,26 @@ int coral_linked_red_black_tree_container_ceiling(
     return 0;
 }
 
-int coral_linked_red_black_tree_container_floor(
+int coral_linked_red_black_tree_container_ceiling(
+        const struct coral_linked_red_black_tree_container *const object,
+        const void *const key,
+        struct coral_linked_red_black_tree_container_entry **const out) {
+    if (!object) {
+        return CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_OBJECT_IS_NULL;
+    }
+    if (!key) {
+        return CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_KEY_IS_NULL;
+    }
+    if (!out) {
+        return CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_OUT_IS_NULL;
+    }
+    if (!object->compare) {
+        return CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_COMPARE_IS_NULL;
+    }
+    return find_ceiling(object, key, entity_compare, out);
+}
+
+int coral_linked_red_black_tree_container_ceiling_key(
         const struct coral_linked_red_black_tree_container *const object,
         const void *const key,
         struct coral_linked_red_black_tree_container_entry **const out) {
@@ -279,25 +585,33 @@ int coral_linked_red_black_tree_container_floor(
     if (!out) {
         return CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_OUT_IS_NULL;
     }
+    if (!object->compare_key) {
+        return CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_COMPARE_IS_NULL;
+    }
+    return find_ceiling(object, key, key_compare, out);
+}
+
+static int find_floor(
+        const struct coral_linked_red_black_tree_container *const object,
+        const void *const key,
+        int (*const compare)(const void *,
+                             const struct coral_red_black_tree_node *,
+                             void *),
+        struct coral_linked_red_black_tree_container_entry **const out) {
     int error;
-    struct entry *const K = rock_container_of(key, struct entry, data);
-    struct rock_red_black_tree_node *node;
-    this = object;
-    if ((error = rock_red_black_tree_find(&object->tree,
-                                          NULL,
-                                          &K->rbt_node,
-                                          &node))) {
+    struct coral_red_black_tree_node *node;
+    if ((error = find(object, key, compare, &node))) {
         seagrass_required_true(
-                ROCK_RED_BLACK_TREE_ERROR_NODE_NOT_FOUND
+                CORAL_RED_BLACK_TREE_ERROR_NODE_NOT_FOUND
                 == error);
         if (!node) {
             return CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_ENTRY_NOT_FOUND;
         }
         struct entry *const B = rock_container_of(node, struct entry, rbt_node);
-        if (entity_compare(&K->rbt_node, &B->rbt_node) < 0
-            && (error = rock_red_black_tree_prev(node, &node))) {
+        if (compare(key, &B->rbt_node, (void *) object) < 0
+            && (error = coral_red_black_tree_prev(node, &node))) {
             seagrass_required_true(
-                    ROCK_RED_BLACK_TREE_ERROR_END_OF_SEQUENCE
+                    CORAL_RED_BLACK_TREE_ERROR_END_OF_SEQUENCE
                     == error);
             return CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_ENTRY_NOT_FOUND;
         }
@@ -307,7 +621,26 @@ int coral_linked_red_black_tree_container_floor(
     return 0;
 }
 
-int coral_linked_red_black_tree_container_higher(
+int coral_linked_red_black_tree_container_floor(
+        const struct coral_linked_red_black_tree_container *const object,
+        const void *const key,
+        struct coral_linked_red_black_tree_container_entry **const out) {
+    if (!object) {
+        return CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_OBJECT_IS_NULL;
+    }
+    if (!key) {
+        return CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_KEY_IS_NULL;
+    }
+    if (!out) {
+        return CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_OUT_IS_NULL;
+    }
+    if (!object->compare) {
+        return CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_COMPARE_IS_NULL;
+    }
+    return find_floor(object, key, entity_compare, out);
+}
+
+int coral_linked_red_black_tree_container_floor_key(
         const struct coral_linked_red_black_tree_container *const object,
         const void *const key,
         struct coral_linked_red_black_tree_container_entry **const out) {
@@ -320,27 +653,39 @@ int coral_linked_red_black_tree_container_higher(
     if (!out) {
         return CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_OUT_IS_NULL;
     }
+    if (!object->compare_key) {
+        return CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_COMPARE_IS_NULL;
+    }
+    return find_floor(object, key, key_compare, out);
+}
+
+static int find_higher(
+        const struct coral_linked_red_black_tree_container *const object,
+        const void *const key,
+        int (*const compare)(const void *,
+                             const struct coral_red_black_tree_node *,
+                             void *),
+        struct coral_linked_red_black_tree_container_entry **const out) {
     int error;
-    struct entry *const K = rock_container_of(key, struct entry, data);
-    struct rock_red_black_tree_node *node;
-    this = object;
-    if ((error = rock_red_black_tree_find(&object->tree,
-                                          NULL,
-                                          &K->rbt_node,
-                                          &node))) {
+    struct coral_red_black_tree_node *node;
+    if ((error = find(object, key, compare, &node))) {
         seagrass_required_true(
-                ROCK_RED_BLACK_TREE_ERROR_NODE_NOT_FOUND
+                CORAL_RED_BLACK_TREE_ERROR_NODE_NOT_FOUND
                 == error);
         if (!node) {
             return CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_ENTRY_NOT_FOUND;
         }
         struct entry *const B = rock_container_of(node, struct entry, rbt_node);
-        if (entity_compare(&K->rbt_node, &B->rbt_node) > 0) {
+        if (compare(key, &B->rbt_node, (void *) object) > 0
+            && (error = coral_red_black_tree_next(node, &node))) {
+            seagrass_required_true(
+                    CORAL_RED_BLACK_TREE_ERROR_END_OF_SEQUENCE
+                    == error);
             return CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_ENTRY_NOT_FOUND;
         }
-    } else if ((error = rock_red_black_tree_next(node, &node))) {
+    } else if ((error = coral_red_black_tree_next(node, &node))) {
         seagrass_required_true(
-                ROCK_RED_BLACK_TREE_ERROR_END_OF_SEQUENCE
+                CORAL_RED_BLACK_TREE_ERROR_END_OF_SEQUENCE
                 == error);
         return CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_ENTRY_NOT_FOUND;
     }
@@ -349,7 +694,26 @@ int coral_linked_red_black_tree_container_higher(
     return 0;
 }
 
-int coral_linked_red_black_tree_container_lower(
+int coral_linked_red_black_tree_container_higher(
+        const struct coral_linked_red_black_tree_container *const object,
+        const void *const key,
+        struct coral_linked_red_black_tree_container_entry **const out) {
+    if (!object) {
+        return CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_OBJECT_IS_NULL;
+    }
+    if (!key) {
+        return CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_KEY_IS_NULL;
+    }
+    if (!out) {
+        return CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_OUT_IS_NULL;
+    }
+    if (!object->compare) {
+        return CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_COMPARE_IS_NULL;
+    }
+    return find_higher(object, key, entity_compare, out);
+}
+
+int coral_linked_red_black_tree_container_higher_key(
         const struct coral_linked_red_black_tree_container *const object,
         const void *const key,
         struct coral_linked_red_black_tree_container_entry **const out) {
@@ -362,26 +726,34 @@ int coral_linked_red_black_tree_container_lower(
     if (!out) {
         return CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_OUT_IS_NULL;
     }
+    if (!object->compare_key) {
+        return CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_COMPARE_IS_NULL;
+    }
+    return find_higher(object, key, key_compare, out);
+}
+
+static int find_lower(
+        const struct coral_linked_red_black_tree_container *const object,
+        const void *const key,
+        int (*const compare)(const void *,
+                             const struct coral_red_black_tree_node *,
+                             void *),
+        struct coral_linked_red_black_tree_container_entry **const out) {
     int error;
-    struct entry *const K = rock_container_of(key, struct entry, data);
-    struct rock_red_black_tree_node *node;
-    this = object;
-    if ((error = rock_red_black_tree_find(&object->tree,
-                                          NULL,
-                                          &K->rbt_node,
-                                          &node))) {
+    struct coral_red_black_tree_node *node;
+    if ((error = find(object, key, compare, &node))) {
         seagrass_required_true(
-                ROCK_RED_BLACK_TREE_ERROR_NODE_NOT_FOUND
+                CORAL_RED_BLACK_TREE_ERROR_NODE_NOT_FOUND
                 == error);
         if (!node) {
             return CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_ENTRY_NOT_FOUND;
         }
     }
     struct entry *const B = rock_container_of(node, struct entry, rbt_node);
-    if (entity_compare(&K->rbt_node, &B->rbt_node) <= 0
-        && (error = rock_red_black_tree_prev(node, &node))) {
+    if (compare(key, &B->rbt_node, (void *) object) <= 0
+        && (error = coral_red_black_tree_prev(node, &node))) {
         seagrass_required_true(
-                ROCK_RED_BLACK_TREE_ERROR_END_OF_SEQUENCE
+                CORAL_RED_BLACK_TREE_ERROR_END_OF_SEQUENCE
                 == error);
         return CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_ENTRY_NOT_FOUND;
     }
@@ -390,7 +762,45 @@ int coral_linked_red_black_tree_container_lower(
     return 0;
 }
 
-int coral_linked_red_black_tree_container_sorted_first(
+int coral_linked_red_black_tree_container_lower(
+        const struct coral_linked_red_black_tree_container *const object,
+        const void *const key,
+        struct coral_linked_red_black_tree_container_entry **const out) {
+    if (!object) {
+        return CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_OBJECT_IS_NULL;
+    }
+    if (!key) {
+        return CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_KEY_IS_NULL;
+    }
+    if (!out) {
+        return CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_OUT_IS_NULL;
+    }
+    if (!object->compare) {
+        return CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_COMPARE_IS_NULL;
+    }
+    return find_lower(object, key, entity_compare, out);
+}
+
+int coral_linked_red_black_tree_container_lower_key(
+        const struct coral_linked_red_black_tree_container *const object,
+        const void *const key,
+        struct coral_linked_red_black_tree_container_entry **const out) {
+    if (!object) {
+        return CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_OBJECT_IS_NULL;
+    }
+    if (!key) {
+        return CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_KEY_IS_NULL;
+    }
+    if (!out) {
+        return CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_OUT_IS_NULL;
+    }
+    if (!object->compare_key) {
+        return CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_COMPARE_IS_NULL;
+    }
+    return find_lower(object, key, key_compare, out);
+}
+
+int coral_linked_red_black_tree_container_sorted_first(
         const struct coral_linked_red_black_tree_container *const object,
         struct coral_linked_red_black_tree_container_entry **const out) {
     if (!object) {
@@ -400,10 +810,10 @@ int coral_linked_red_black_tree_container_sorted_first(
         return CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_OUT_IS_NULL;
     }
     int error;
-    struct rock_red_black_tree_node *node;
-    if ((error = rock_red_black_tree_first(&object->tree, &node))) {
+    struct coral_red_black_tree_node *node;
+    if ((error = coral_red_black_tree_first(&object->tree, &node))) {
         seagrass_required_true(
-                ROCK_RED_BLACK_TREE_ERROR_TREE_IS_EMPTY
+                CORAL_RED_BLACK_TREE_ERROR_TREE_IS_EMPTY
                 == error);
         return CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_CONTAINER_IS_EMPTY;
     }
@@ -422,10 +832,10 @@ int coral_linked_red_black_tree_container_sorted_last(
         return CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_OUT_IS_NULL;
     }
     int error;
-    struct rock_red_black_tree_node *node;
-    if ((error = rock_red_black_tree_last(&object->tree, &node))) {
+    struct coral_red_black_tree_node *node;
+    if ((error = coral_red_black_tree_last(&object->tree, &node))) {
         seagrass_required_true(
-                ROCK_RED_BLACK_TREE_ERROR_TREE_IS_EMPTY
+                CORAL_RED_BLACK_TREE_ERROR_TREE_IS_EMPTY
                 == error);
         return CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_CONTAINER_IS_EMPTY;
     }
@@ -445,10 +855,10 @@ int coral_linked_red_black_tree_container_sorted_next(
     }
     int error;
     struct entry *const A = rock_container_of(entry, struct entry, data);
-    struct rock_red_black_tree_node *node;
-    if ((error = rock_red_black_tree_next(&A->rbt_node, &node))) {
+    struct coral_red_black_tree_node *node;
+    if ((error = coral_red_black_tree_next(&A->rbt_node, &node))) {
         seagrass_required_true(
-                ROCK_RED_BLACK_TREE_ERROR_END_OF_SEQUENCE
+                CORAL_RED_BLACK_TREE_ERROR_END_OF_SEQUENCE
                 == error);
         return CORAL_RED_BLACK_TREE_CONTAINER_ERROR_END_OF_SEQUENCE;
     }
@@ -468,10 +878,10 @@ int coral_linked_red_black_tree_container_sorted_prev(
     }
     int error;
     struct entry *const A = rock_container_of(entry, struct entry, data);
-    struct rock_red_black_tree_node *node;
-    if ((error = rock_red_black_tree_prev(&A->rbt_node, &node))) {
+    struct coral_red_black_tree_node *node;
+    if ((error = coral_red_black_tree_prev(&A->rbt_node, &node))) {
         seagrass_required_true(
-                ROCK_RED_BLACK_TREE_ERROR_END_OF_SEQUENCE
+                CORAL_RED_BLACK_TREE_ERROR_END_OF_SEQUENCE
                 == error);
         return CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_END_OF_SEQUENCE;
     }
@@ -480,6 +890,328 @@ int coral_linked_red_black_tree_container_sorted_prev(
     return 0;
 }
 
+static uintmax_t count_before(
+        const struct coral_linked_red_black_tree_container *const object,
+        const void *const key,
+        int (*const compare)(const void *,
+                             const struct coral_red_black_tree_node *,
+                             void *),
+        bool *const found) {
+    int error;
+    uintmax_t out;
+    if ((error = coral_red_black_tree_count_before(
+            &object->tree, key, compare, (void *) object, &out))) {
+        seagrass_required_true(
+                CORAL_RED_BLACK_TREE_ERROR_NODE_NOT_FOUND
+                == error);
+    }
+    *found = !error;
+    return out;
+}
+
+static uintmax_t count_range(
+        const struct coral_linked_red_black_tree_container *const object,
+        const void *const first,
+        const void *const last,
+        int (*const compare)(const void *,
+                             const struct coral_red_black_tree_node *,
+                             void *)) {
+    bool found;
+    const uintmax_t before = count_before(object, first, compare, &found);
+    const uintmax_t until = count_before(object, last, compare, &found)
+                            + found;
+    return until > before ? until - before : 0;
+}
+
+int coral_linked_red_black_tree_container_rank(
+        const struct coral_linked_red_black_tree_container *const object,
+        const void *const key,
+        uintmax_t *const out) {
+    if (!object) {
+        return CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_OBJECT_IS_NULL;
+    }
+    if (!key) {
+        return CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_KEY_IS_NULL;
+    }
+    if (!out) {
+        return CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_OUT_IS_NULL;
+    }
+    if (!object->compare) {
+        return CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_COMPARE_IS_NULL;
+    }
+    bool found;
+    *out = count_before(object, key, entity_compare, &found);
+    return 0;
+}
+
+int coral_linked_red_black_tree_container_rank_key(
+        const struct coral_linked_red_black_tree_container *const object,
+        const void *const key,
+        uintmax_t *const out) {
+    if (!object) {
+        return CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_OBJECT_IS_NULL;
+    }
+    if (!key) {
+        return CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_KEY_IS_NULL;
+    }
+    if (!out) {
+        return CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_OUT_IS_NULL;
+    }
+    if (!object->compare_key) {
+        return CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_COMPARE_IS_NULL;
+    }
+    bool found;
+    *out = count_before(object, key, key_compare, &found);
+    return 0;
+}
+
+int coral_linked_red_black_tree_container_count_range(
+        const struct coral_linked_red_black_tree_container *const object,
+        const void *const first,
+        const void *const last,
+        uintmax_t *const out) {
+    if (!object) {
+        return CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_OBJECT_IS_NULL;
+    }
+    if (!first || !last) {
+        return CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_KEY_IS_NULL;
+    }
+    if (!out) {
+        return CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_OUT_IS_NULL;
+    }
+    if (!object->compare) {
+        return CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_COMPARE_IS_NULL;
+    }
+    *out = count_range(object, first, last, entity_compare);
+    return 0;
+}
+
+int coral_linked_red_black_tree_container_count_range_key(
+        const struct coral_linked_red_black_tree_container *const object,
+        const void *const first,
+        const void *const last,
+        uintmax_t *const out) {
+    if (!object) {
+        return CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_OBJECT_IS_NULL;
+    }
+    if (!first || !last) {
+        return CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_KEY_IS_NULL;
+    }
+    if (!out) {
+        return CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_OUT_IS_NULL;
+    }
+    if (!object->compare_key) {
+        return CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_COMPARE_IS_NULL;
+    }
+    *out = count_range(object, first, last, key_compare);
+    return 0;
+}
+
+int coral_linked_red_black_tree_container_sorted_select(
+        const struct coral_linked_red_black_tree_container *const object,
+        const uintmax_t index,
+        struct coral_linked_red_black_tree_container_entry **const out) {
+    if (!object) {
+        return CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_OBJECT_IS_NULL;
+    }
+    if (!out) {
+        return CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_OUT_IS_NULL;
+    }
+    int error;
+    struct coral_red_black_tree_node *node;
+    if ((error = coral_red_black_tree_select(&object->tree, index, &node))) {
+        seagrass_required_true(
+                CORAL_RED_BLACK_TREE_ERROR_INDEX_IS_OUT_OF_BOUNDS
+                == error);
+        return CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_INDEX_IS_OUT_OF_BOUNDS;
+    }
+    struct entry *const A = rock_container_of(node, struct entry, rbt_node);
+    *out = (struct coral_linked_red_black_tree_container_entry *) &A->data;
+    return 0;
+}
+
+static void *summary_of(
+        const struct coral_linked_red_black_tree_container *const object,
+        const struct coral_red_black_tree_node *const node) {
+    struct entry *const A = rock_container_of(node, struct entry, rbt_node);
+    return A->data + object->summary_offset;
+}
+
+static void aggregate_node(const struct coral_red_black_tree *const tree,
+                           struct coral_red_black_tree_node *const node) {
+    const struct coral_linked_red_black_tree_container *const object
+            = rock_container_of(
+                    tree, struct coral_linked_red_black_tree_container, tree);
+    struct entry *const A = rock_container_of(node, struct entry, rbt_node);
+    void *const summary = A->data + object->summary_offset;
+    object->lift(A->data, summary);
+    if (node->left) {
+        object->combine(summary_of(object, node->left), summary, summary);
+    }
+    if (node->right) {
+        object->combine(summary, summary_of(object, node->right), summary);
+    }
+}
+
+int coral_linked_red_black_tree_container_set_aggregate(
+        struct coral_linked_red_black_tree_container *const object,
+        const size_t size,
+        const size_t offset,
+        void (*const lift)(const void *entry, void *out),
+        void (*const combine)(const void *first, const void *second,
+                              void *out)) {
+    if (!object) {
+        return CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_OBJECT_IS_NULL;
+    }
+    if (!size) {
+        return CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_SIZE_IS_ZERO;
+    }
+    if (!lift || !combine) {
+        return CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_AGGREGATE_IS_NULL;
+    }
+    if (object->compare_node) {
+        return CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_CONTAINER_IS_INTRUSIVE;
+    }
+    if (object->tree.root) {
+        return CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_CONTAINER_IS_NOT_EMPTY;
+    }
+    seagrass_required_true(!coral_red_black_tree_init_augmented(
+            &object->tree, aggregate_node));
+    object->summary_size = size;
+    object->summary_offset = offset;
+    object->lift = lift;
+    object->combine = combine;
+    return 0;
+}
+
+static int aggregate(
+        const struct coral_linked_red_black_tree_container *const object,
+        const void *const first,
+        const void *const last,
+        int (*const compare)(const void *,
+                             const struct coral_red_black_tree_node *,
+                             void *),
+        void *const out) {
+    /* the range hangs off the highest node that lies within it */
+    struct coral_red_black_tree_node *node = object->tree.root;
+    while (node) {
+        if (compare(first, node, (void *) object) > 0) {
+            node = node->right;
+        } else if (compare(last, node, (void *) object) < 0) {
+            node = node->left;
+        } else {
+            break;
+        }
+    }
+    if (!node) {
+        return CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_ENTRY_NOT_FOUND;
+    }
+    union {
+        max_align_t alignment;
+        unsigned char data[64];
+    } local;
+    void *scratch = &local;
+    if (object->summary_size > sizeof(local)
+        && !(scratch = malloc(object->summary_size))) {
+        return CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_MEMORY_ALLOCATION_FAILED;
+    }
+    struct entry *A = rock_container_of(node, struct entry, rbt_node);
+    object->lift(A->data, out);
+    /* entries from first onwards are prepended in descending order */
+    for (struct coral_red_black_tree_node *i = node->left; i;) {
+        if (compare(first, i, (void *) object) > 0) {
+            i = i->right;
+            continue;
+        }
+        if (i->right) {
+            object->combine(summary_of(object, i->right), out, out);
+        }
+        A = rock_container_of(i, struct entry, rbt_node);
+        object->lift(A->data, scratch);
+        object->combine(scratch, out, out);
+        i = i->left;
+    }
+    /* entries up to last are appended in ascending order */
+    for (struct coral_red_black_tree_node *i = node->right; i;) {
+        if (compare(last, i, (void *) object) < 0) {
+            i = i->left;
+            continue;
+        }
+        if (i->left) {
+            object->combine(out, summary_of(object, i->left), out);
+        }
+        A = rock_container_of(i, struct entry, rbt_node);
+        object->lift(A->data, scratch);
+        object->combine(out, scratch, out);
+        i = i->right;
+    }
+    if (scratch != &local) {
+        free(scratch);
+    }
+    return 0;
+}
+
+int coral_linked_red_black_tree_container_aggregate(
+        const struct coral_linked_red_black_tree_container *const object,
+        const void *const first,
+        const void *const last,
+        void *const out) {
+    if (!object) {
+        return CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_OBJECT_IS_NULL;
+    }
+    if (!first || !last) {
+        return CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_KEY_IS_NULL;
+    }
+    if (!out) {
+        return CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_OUT_IS_NULL;
+    }
+    if (!object->compare) {
+        return CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_COMPARE_IS_NULL;
+    }
+    if (!object->combine) {
+        return CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_AGGREGATE_IS_NULL;
+    }
+    return aggregate(object, first, last, entity_compare, out);
+}
+
+int coral_linked_red_black_tree_container_aggregate_key(
+        const struct coral_linked_red_black_tree_container *const object,
+        const void *const first,
+        const void *const last,
+        void *const out) {
+    if (!object) {
+        return CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_OBJECT_IS_NULL;
+    }
+    if (!first || !last) {
+        return CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_KEY_IS_NULL;
+    }
+    if (!out) {
+        return CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_OUT_IS_NULL;
+    }
+    if (!object->compare_key) {
+        return CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_COMPARE_IS_NULL;
+    }
+    if (!object->combine) {
+        return CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_AGGREGATE_IS_NULL;
+    }
+    return aggregate(object, first, last, key_compare, out);
+}
+
+int coral_linked_red_black_tree_container_refresh(
+        struct coral_linked_red_black_tree_container *const object,
+        struct coral_linked_red_black_tree_container_entry *const entry) {
+    if (!object) {
+        return CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_OBJECT_IS_NULL;
+    }
+    if (!entry) {
+        return CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_ENTRY_IS_NULL;
+    }
+    struct entry *const A = rock_container_of(entry, struct entry, data);
+    seagrass_required_true(!coral_red_black_tree_propagate(
+            &object->tree, &A->rbt_node));
+    return 0;
+}
+
 int coral_linked_red_black_tree_container_first(
         const struct coral_linked_red_black_tree_container *const object,
         struct coral_linked_red_black_tree_container_entry **const out) {
@@ -589,20 +1321,14 @@ int coral_linked_red_black_tree_container_insert(
     if (!item) {
         return CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_ITEM_IS_NULL;
     }
+    if (!object->compare) {
+        return CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_COMPARE_IS_NULL;
+    }
     int error;
     struct entry *const A = rock_container_of(item, struct entry, data);
-    struct rock_red_black_tree_node *insertion_point;
-    this = object;
-    if (!(error = rock_red_black_tree_find(&object->tree,
-                                           NULL,
-                                           &A->rbt_node,
-                                           &insertion_point))) {
-        return CORAL_RED_BLACK_TREE_CONTAINER_ERROR_ENTRY_ALREADY_EXISTS;
-    }
-    seagrass_required_true(ROCK_RED_BLACK_TREE_ERROR_NODE_NOT_FOUND
-                           == error);
-    seagrass_required_true(!rock_red_black_tree_insert(
-            &object->tree, insertion_point, &A->rbt_node));
+    if ((error = attach(object, &A->data, &A->rbt_node, entity_compare))) {
+        return error;
+    }
     struct entry *const B = rock_container_of(entry, struct entry, data);
     seagrass_required_true(!rock_linked_list_insert_before(
             &B->ll_node, &A->ll_node));
@@ -611,3 +1337,154 @@ int coral_linked_red_black_tree_container_insert(
     }
     return 0;
 }
+
+int coral_linked_red_black_tree_container_add_node(
+        struct coral_linked_red_black_tree_container *const object,
+        struct coral_linked_red_black_tree_container_node *const node) {
+    if (!object) {
+        return CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_OBJECT_IS_NULL;
+    }
+    if (!node) {
+        return CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_NODE_IS_NULL;
+    }
+    return insert(object, node, &node->rbt_node, &node->ll_node,
+                  node_compare);
+}
+
+int coral_linked_red_black_tree_container_remove_node(
+        struct coral_linked_red_black_tree_container *const object,
+        struct coral_linked_red_black_tree_container_node *const node) {
+    if (!object) {
+        return CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_OBJECT_IS_NULL;
+    }
+    if (!node) {
+        return CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_NODE_IS_NULL;
+    }
+    erase(object, &node->rbt_node, &node->ll_node);
+    return 0;
+}
+
+int coral_linked_red_black_tree_container_get_node(
+        const struct coral_linked_red_black_tree_container *const object,
+        const struct coral_linked_red_black_tree_container_node *const key,
+        struct coral_linked_red_black_tree_container_node **const out) {
+    if (!object) {
+        return CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_OBJECT_IS_NULL;
+    }
+    if (!key) {
+        return CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_KEY_IS_NULL;
+    }
+    if (!out) {
+        return CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_OUT_IS_NULL;
+    }
+    int error;
+    struct coral_red_black_tree_node *node;
+    if ((error = find(object, key, node_compare, &node))) {
+        seagrass_required_true(
+                CORAL_RED_BLACK_TREE_ERROR_NODE_NOT_FOUND
+                == error);
+        return CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_ENTRY_NOT_FOUND;
+    }
+    *out = from_rbt_node(node);
+    return 0;
+}
+
+int coral_linked_red_black_tree_container_first_node(
+        const struct coral_linked_red_black_tree_container *const object,
+        struct coral_linked_red_black_tree_container_node **const out) {
+    if (!object) {
+        return CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_OBJECT_IS_NULL;
+    }
+    if (!out) {
+        return CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_OUT_IS_NULL;
+    }
+    if (!object->list) {
+        return CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_CONTAINER_IS_EMPTY;
+    }
+    *out = from_ll_node(object->list);
+    return 0;
+}
+
+int coral_linked_red_black_tree_container_last_node(
+        const struct coral_linked_red_black_tree_container *const object,
+        struct coral_linked_red_black_tree_container_node **const out) {
+    if (!object) {
+        return CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_OBJECT_IS_NULL;
+    }
+    if (!out) {
+        return CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_OUT_IS_NULL;
+    }
+    if (!object->list) {
+        return CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_CONTAINER_IS_EMPTY;
+    }
+    struct rock_linked_list_node *node;
+    seagrass_required_true(!rock_linked_list_prev(object->list, &node));
+    *out = from_ll_node(node);
+    return 0;
+}
+
+int coral_linked_red_black_tree_container_next_node(
+        const struct coral_linked_red_black_tree_container *const object,
+        const struct coral_linked_red_black_tree_container_node *const node,
+        struct coral_linked_red_black_tree_container_node **const out) {
+    if (!object) {
+        return CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_OBJECT_IS_NULL;
+    }
+    if (!node) {
+        return CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_NODE_IS_NULL;
+    }
+    if (!out) {
+        return CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_OUT_IS_NULL;
+    }
+    struct rock_linked_list_node *next;
+    seagrass_required_true(!rock_linked_list_next(&node->ll_node, &next));
+    if (&node->ll_node == next || object->list == next) {
+        return CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_END_OF_SEQUENCE;
+    }
+    *out = from_ll_node(next);
+    return 0;
+}
+
+int coral_linked_red_black_tree_container_prev_node(
+        const struct coral_linked_red_black_tree_container *const object,
+        const struct coral_linked_red_black_tree_container_node *const node,
+        struct coral_linked_red_black_tree_container_node **const out) {
+    if (!object) {
+        return CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_OBJECT_IS_NULL;
+    }
+    if (!node) {
+        return CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_NODE_IS_NULL;
+    }
+    if (!out) {
+        return CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_OUT_IS_NULL;
+    }
+    if (&node->ll_node == object->list) {
+        return CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_END_OF_SEQUENCE;
+    }
+    struct rock_linked_list_node *prev;
+    seagrass_required_true(!rock_linked_list_prev(&node->ll_node, &prev));
+    *out = from_ll_node(prev);
+    return 0;
+}
+
+int coral_linked_red_black_tree_container_counters(
+        const struct coral_linked_red_black_tree_container *const object,
+        struct coral_counters *const out) {
+    if (!object) {
+        return CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_OBJECT_IS_NULL;
+    }
+    if (!out) {
+        return CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_OUT_IS_NULL;
+    }
+    coral_counters_snapshot(&object->tree, out);
+    return 0;
+}
+
+int coral_linked_red_black_tree_container_counters_reset(
+        struct coral_linked_red_black_tree_container *const object) {
+    if (!object) {
+        return CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_OBJECT_IS_NULL;
+    }
+    coral_counters_reset(&object->tree);
+    return 0;
+}
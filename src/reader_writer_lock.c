@@ -0,0 +1,108 @@
+#include <stdlib.h>
+#include <sched.h>
+#include <unistd.h>
+#include <seagrass.h>
+#include <coral.h>
+
+#include "reader_writer_lock.h"
+
+#ifdef TEST
+#include <test/cmocka.h>
+#endif
+
+#define CACHE_LINE 64
+#define MAXIMUM_SLOTS 128
+
+struct coral_reader_writer_lock_slot {
+    atomic_size_t readers;
+    unsigned char padding[CACHE_LINE - sizeof(atomic_size_t)];
+};
+
+/* Threads are numbered as they first take a lock so that up to as many
+ * threads as there are slots each count in a slot of their own. */
+static atomic_size_t threads;
+static _Thread_local size_t thread = SIZE_MAX;
+
+static struct coral_reader_writer_lock_slot *slot_of(
+        const struct coral_reader_writer_lock *const object) {
+    if (SIZE_MAX == thread) {
+        thread = atomic_fetch_add_explicit(&threads, 1,
+                                           memory_order_relaxed)
+                 % MAXIMUM_SLOTS;
+    }
+    return &object->slots[thread & object->mask];
+}
+
+int coral_reader_writer_lock_init(
+        struct coral_reader_writer_lock *const object) {
+    const long processors = sysconf(_SC_NPROCESSORS_CONF);
+    size_t count = 1;
+    while (count < MAXIMUM_SLOTS && (long) count < processors) {
+        count <<= 1;
+    }
+    void *slots;
+    if (posix_memalign(&slots, CACHE_LINE,
+                       count * sizeof(struct coral_reader_writer_lock_slot))) {
+        return SEA_URCHIN_ERROR_MEMORY_ALLOCATION_FAILED;
+    }
+    if (pthread_mutex_init(&object->mutex, NULL)) {
+        free(slots);
+        return SEA_URCHIN_ERROR_MEMORY_ALLOCATION_FAILED;
+    }
+    object->slots = slots;
+    object->mask = count - 1;
+    for (size_t i = 0; i < count; i++) {
+        atomic_init(&object->slots[i].readers, 0);
+    }
+    atomic_init(&object->writing, false);
+    return 0;
+}
+
+void coral_reader_writer_lock_invalidate(
+        struct coral_reader_writer_lock *const object) {
+    seagrass_required_true(!pthread_mutex_destroy(&object->mutex));
+    free(object->slots);
+    object->slots = NULL;
+}
+
+void coral_reader_writer_lock_read(
+        struct coral_reader_writer_lock *const object) {
+    struct coral_reader_writer_lock_slot *const slot = slot_of(object);
+    /* announce the reader before looking for a writer while the writer
+     * announces itself before looking for readers, so at least one of
+     * them sees the other */
+    atomic_fetch_add_explicit(&slot->readers, 1, memory_order_seq_cst);
+    if (!atomic_load_explicit(&object->writing, memory_order_seq_cst)) {
+        return;
+    }
+    atomic_fetch_sub_explicit(&slot->readers, 1, memory_order_release);
+    /* no writer can be inside while we hold the mutex and the next one will
+     * wait for this reader */
+    seagrass_required_true(!pthread_mutex_lock(&object->mutex));
+    atomic_fetch_add_explicit(&slot->readers, 1, memory_order_relaxed);
+    seagrass_required_true(!pthread_mutex_unlock(&object->mutex));
+}
+
+void coral_reader_writer_lock_read_unlock(
+        struct coral_reader_writer_lock *const object) {
+    atomic_fetch_sub_explicit(&slot_of(object)->readers, 1,
+                              memory_order_release);
+}
+
+void coral_reader_writer_lock_write(
+        struct coral_reader_writer_lock *const object) {
+    seagrass_required_true(!pthread_mutex_lock(&object->mutex));
+    atomic_store_explicit(&object->writing, true, memory_order_seq_cst);
+    for (size_t i = 0; i <= object->mask; i++) {
+        while (atomic_load_explicit(&object->slots[i].readers,
+                                    memory_order_seq_cst)) {
+            sched_yield();
+        }
+    }
+}
+
+void coral_reader_writer_lock_write_unlock(
+        struct coral_reader_writer_lock *const object) {
+    atomic_store_explicit(&object->writing, false, memory_order_release);
+    seagrass_required_true(!pthread_mutex_unlock(&object->mutex));
+}
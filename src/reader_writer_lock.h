@@ -0,0 +1,27 @@
+#ifndef _CORAL_SRC_READER_WRITER_LOCK_H_
+#define _CORAL_SRC_READER_WRITER_LOCK_H_
+
+#include <coral/reader_writer_lock.h>
+
+/* Set up a slot per processor, fails if memory runs out. */
+int coral_reader_writer_lock_init(struct coral_reader_writer_lock *object);
+
+/* Release the slots, no thread may hold or wait for the lock. */
+void coral_reader_writer_lock_invalidate(
+        struct coral_reader_writer_lock *object);
+
+/* Share the lock with other readers, a thread must not take it again while
+ * it holds it since a waiting writer would then never get it. */
+void coral_reader_writer_lock_read(struct coral_reader_writer_lock *object);
+
+void coral_reader_writer_lock_read_unlock(
+        struct coral_reader_writer_lock *object);
+
+/* Have the lock to ourselves, writers queue on the mutex and readers that
+ * arrive meanwhile queue behind them. */
+void coral_reader_writer_lock_write(struct coral_reader_writer_lock *object);
+
+void coral_reader_writer_lock_write_unlock(
+        struct coral_reader_writer_lock *object);
+
+#endif /* _CORAL_SRC_READER_WRITER_LOCK_H_ */
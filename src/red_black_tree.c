@@ -0,0 +1,929 @@
+#include <stdlib.h>
+#include <seagrass.h>
+#include <coral.h>
+
+#include "counters.h"
+
+#ifdef TEST
+#include <test/cmocka.h>
+#endif
+
+int coral_red_black_tree_node_init(
+        struct coral_red_black_tree_node *const node) {
+    if (!node) {
+        return CORAL_RED_BLACK_TREE_ERROR_NODE_IS_NULL;
+    }
+    *node = (struct coral_red_black_tree_node) {0};
+    return 0;
+}
+
+int coral_red_black_tree_init(struct coral_red_black_tree *const object) {
+    if (!object) {
+        return CORAL_RED_BLACK_TREE_ERROR_OBJECT_IS_NULL;
+    }
+    *object = (struct coral_red_black_tree) {0};
+    return 0;
+}
+
+int coral_red_black_tree_init_augmented(
+        struct coral_red_black_tree *const object,
+        void (*const augment)(const struct coral_red_black_tree *object,
+                              struct coral_red_black_tree_node *node)) {
+    if (!object) {
+        return CORAL_RED_BLACK_TREE_ERROR_OBJECT_IS_NULL;
+    }
+    if (!augment) {
+        return CORAL_RED_BLACK_TREE_ERROR_AUGMENT_IS_NULL;
+    }
+    *object = (struct coral_red_black_tree) {
+            .augment = augment
+    };
+    return 0;
+}
+
+static void destroy(struct coral_red_black_tree_node *node,
+                    void (*const on_destroy)(struct coral_red_black_tree_node *,
+                                             void *),
+                    void *const context) {
+    /* post-order walk, the nodes are dropped so there is no rebalancing */
+    while (node) {
+        if (node->left) {
+            node = node->left;
+            continue;
+        }
+        if (node->right) {
+            node = node->right;
+            continue;
+        }
+        struct coral_red_black_tree_node *const parent = node->parent;
+        if (parent) {
+            *(parent->left == node ? &parent->left : &parent->right) = NULL;
+        }
+        on_destroy(node, context);
+        node = parent;
+    }
+}
+
+int coral_red_black_tree_invalidate(
+        struct coral_red_black_tree *const object,
+        void (*const on_destroy)(struct coral_red_black_tree_node *node,
+                                 void *context),
+        void *const context) {
+    if (!object) {
+        return CORAL_RED_BLACK_TREE_ERROR_OBJECT_IS_NULL;
+    }
+    if (on_destroy) {
+        destroy(object->root, on_destroy, context);
+    }
+    *object = (struct coral_red_black_tree) {0};
+    return 0;
+}
+
+int coral_red_black_tree_find(
+        const struct coral_red_black_tree *const object,
+        const void *const key,
+        int (*const compare)(const void *key,
+                             const struct coral_red_black_tree_node *node,
+                             void *context),
+        void *const context,
+        struct coral_red_black_tree_node **const out) {
+    if (!object) {
+        return CORAL_RED_BLACK_TREE_ERROR_OBJECT_IS_NULL;
+    }
+    if (!compare) {
+        return CORAL_RED_BLACK_TREE_ERROR_COMPARE_IS_NULL;
+    }
+    if (!out) {
+        return CORAL_RED_BLACK_TREE_ERROR_OUT_IS_NULL;
+    }
+    struct coral_red_black_tree_node *last = NULL;
+    struct coral_red_black_tree_node *node = object->root;
+    while (node) {
+        coral_counters_add(object, visit, 1);
+        const int result = compare(key, node, context);
+        if (!result) {
+            *out = node;
+            return 0;
+        }
+        last = node;
+        node = result < 0 ? node->left : node->right;
+    }
+    *out = last;
+    return CORAL_RED_BLACK_TREE_ERROR_NODE_NOT_FOUND;
+}
+
+static uintmax_t size_of(const struct coral_red_black_tree_node *const node) {
+    return node ? node->size : 0;
+}
+
+static void propagate(const struct coral_red_black_tree *const object,
+                      struct coral_red_black_tree_node *node) {
+    if (!object->augment) {
+        return;
+    }
+    for (; node; node = node->parent) {
+        object->augment(object, node);
+    }
+}
+
+static void replace(struct coral_red_black_tree *const object,
+                    const struct coral_red_black_tree_node *const node,
+                    struct coral_red_black_tree_node *const with) {
+    struct coral_red_black_tree_node *const parent = node->parent;
+    if (!parent) {
+        object->root = with;
+    } else if (parent->left == node) {
+        parent->left = with;
+    } else {
+        parent->right = with;
+    }
+}
+
+static void rotate_left(struct coral_red_black_tree *const object,
+                        struct coral_red_black_tree_node *const node) {
+    coral_counters_add(object, rotate, 1);
+    struct coral_red_black_tree_node *const pivot = node->right;
+    node->right = pivot->left;
+    if (pivot->left) {
+        pivot->left->parent = node;
+    }
+    replace(object, node, pivot);
+    pivot->parent = node->parent;
+    pivot->left = node;
+    node->parent = pivot;
+    pivot->size = node->size;
+    node->size = 1 + size_of(node->left) + size_of(node->right);
+    if (object->augment) {
+        object->augment(object, node);
+        object->augment(object, pivot);
+    }
+}
+
+static void rotate_right(struct coral_red_black_tree *const object,
+                         struct coral_red_black_tree_node *const node) {
+    coral_counters_add(object, rotate, 1);
+    struct coral_red_black_tree_node *const pivot = node->left;
+    node->left = pivot->right;
+    if (pivot->right) {
+        pivot->right->parent = node;
+    }
+    replace(object, node, pivot);
+    pivot->parent = node->parent;
+    pivot->right = node;
+    node->parent = pivot;
+    pivot->size = node->size;
+    node->size = 1 + size_of(node->left) + size_of(node->right);
+    if (object->augment) {
+        object->augment(object, node);
+        object->augment(object, pivot);
+    }
+}
+
+static bool is_red(const struct coral_red_black_tree_node *const node) {
+    return node && node->red;
+}
+
+static bool insert_fixup(struct coral_red_black_tree *const object,
+                         struct coral_red_black_tree_node *node) {
+    while (is_red(node->parent)) {
+        struct coral_red_black_tree_node *parent = node->parent;
+        struct coral_red_black_tree_node *const grandparent = parent->parent;
+        if (parent == grandparent->left) {
+            struct coral_red_black_tree_node *const uncle = grandparent->right;
+            if (is_red(uncle)) {
+                parent->red = uncle->red = false;
+                grandparent->red = true;
+                node = grandparent;
+                continue;
+            }
+            if (node == parent->right) {
+                rotate_left(object, parent);
+                node = parent;
+                parent = node->parent;
+            }
+            parent->red = false;
+            grandparent->red = true;
+            rotate_right(object, grandparent);
+        } else {
+            struct coral_red_black_tree_node *const uncle = grandparent->left;
+            if (is_red(uncle)) {
+                parent->red = uncle->red = false;
+                grandparent->red = true;
+                node = grandparent;
+                continue;
+            }
+            if (node == parent->left) {
+                rotate_right(object, parent);
+                node = parent;
+                parent = node->parent;
+            }
+            parent->red = false;
+            grandparent->red = true;
+            rotate_left(object, grandparent);
+        }
+    }
+    /* a red root turning black adds to the black height of the tree */
+    const bool grown = object->root->red;
+    object->root->red = false;
+    return grown;
+}
+
+static void attach(struct coral_red_black_tree *const object,
+                   struct coral_red_black_tree_node *const parent,
+                   struct coral_red_black_tree_node **const link,
+                   struct coral_red_black_tree_node *const node) {
+    seagrass_required_true(!seagrass_uintmax_t_add(
+            1, object->count, &object->count));
+    *node = (struct coral_red_black_tree_node) {
+            .parent = parent,
+            .size = 1,
+            .red = true
+    };
+    *link = node;
+    for (struct coral_red_black_tree_node *i = parent; i; i = i->parent) {
+        i->size++;
+    }
+    propagate(object, node);
+    insert_fixup(object, node);
+}
+
+int coral_red_black_tree_insert(
+        struct coral_red_black_tree *const object,
+        const void *const key,
+        struct coral_red_black_tree_node *const node,
+        int (*const compare)(const void *key,
+                             const struct coral_red_black_tree_node *node,
+                             void *context),
+        void *const context) {
+    if (!object) {
+        return CORAL_RED_BLACK_TREE_ERROR_OBJECT_IS_NULL;
+    }
+    if (!node) {
+        return CORAL_RED_BLACK_TREE_ERROR_NODE_IS_NULL;
+    }
+    if (!compare) {
+        return CORAL_RED_BLACK_TREE_ERROR_COMPARE_IS_NULL;
+    }
+    struct coral_red_black_tree_node *parent = NULL;
+    struct coral_red_black_tree_node **link = &object->root;
+    while (*link) {
+        parent = *link;
+        coral_counters_add(object, visit, 1);
+        const int result = compare(key, parent, context);
+        if (!result) {
+            return CORAL_RED_BLACK_TREE_ERROR_NODE_ALREADY_EXISTS;
+        }
+        link = result < 0 ? &parent->left : &parent->right;
+    }
+    attach(object, parent, link, node);
+    return 0;
+}
+
+int coral_red_black_tree_attach(
+        struct coral_red_black_tree *const object,
+        struct coral_red_black_tree_node *const parent,
+        struct coral_red_black_tree_node **const link,
+        struct coral_red_black_tree_node *const node) {
+    if (!object) {
+        return CORAL_RED_BLACK_TREE_ERROR_OBJECT_IS_NULL;
+    }
+    if (!link) {
+        return CORAL_RED_BLACK_TREE_ERROR_LINK_IS_NULL;
+    }
+    if (!node) {
+        return CORAL_RED_BLACK_TREE_ERROR_NODE_IS_NULL;
+    }
+    attach(object, parent, link, node);
+    return 0;
+}
+
+static struct coral_red_black_tree_node *build(
+        const struct coral_red_black_tree *const object,
+        struct coral_red_black_tree_node *const parent,
+        const uintmax_t first,
+        const uintmax_t last,
+        const uintmax_t depth,
+        const uintmax_t deepest,
+        struct coral_red_black_tree_node *(*const node_at)(uintmax_t,
+                                                            void *),
+        void *const context) {
+    if (first == last) {
+        return NULL;
+    }
+    const uintmax_t middle = first + (last - first) / 2;
+    struct coral_red_black_tree_node *const node = node_at(middle, context);
+    seagrass_required_true(NULL != node);
+    node->parent = parent;
+    node->left = build(object, node, first, middle, 1 + depth, deepest,
+                       node_at, context);
+    node->right = build(object, node, 1 + middle, last, 1 + depth, deepest,
+                        node_at, context);
+    node->size = last - first;
+    /* every path holds the same number of black nodes if only the nodes on
+     * the deepest, possibly incomplete, level are red */
+    node->red = depth && depth == deepest;
+    if (object->augment) {
+        object->augment(object, node);
+    }
+    return node;
+}
+
+int coral_red_black_tree_build(
+        struct coral_red_black_tree *const object,
+        const uintmax_t count,
+        struct coral_red_black_tree_node *(*const node_at)(uintmax_t index,
+                                                            void *context),
+        void *const context) {
+    if (!object) {
+        return CORAL_RED_BLACK_TREE_ERROR_OBJECT_IS_NULL;
+    }
+    if (!node_at) {
+        return CORAL_RED_BLACK_TREE_ERROR_NODE_AT_IS_NULL;
+    }
+    if (object->root) {
+        return CORAL_RED_BLACK_TREE_ERROR_TREE_IS_NOT_EMPTY;
+    }
+    uintmax_t deepest = 0;
+    for (uintmax_t i = count; i > 1; i >>= 1) {
+        deepest++;
+    }
+    object->root = build(object, NULL, 0, count, 0, deepest, node_at,
+                         context);
+    object->count = count;
+    return 0;
+}
+
+static void remove_fixup(struct coral_red_black_tree *const object,
+                         struct coral_red_black_tree_node *node,
+                         struct coral_red_black_tree_node *parent) {
+    while (node != object->root && !is_red(node)) {
+        if (node == parent->left) {
+            struct coral_red_black_tree_node *sibling = parent->right;
+            if (is_red(sibling)) {
+                sibling->red = false;
+                parent->red = true;
+                rotate_left(object, parent);
+                sibling = parent->right;
+            }
+            if (!is_red(sibling->left) && !is_red(sibling->right)) {
+                sibling->red = true;
+                node = parent;
+                parent = node->parent;
+                continue;
+            }
+            if (!is_red(sibling->right)) {
+                sibling->left->red = false;
+                sibling->red = true;
+                rotate_right(object, sibling);
+                sibling = parent->right;
+            }
+            sibling->red = parent->red;
+            parent->red = false;
+            sibling->right->red = false;
+            rotate_left(object, parent);
+        } else {
+            struct coral_red_black_tree_node *sibling = parent->left;
+            if (is_red(sibling)) {
+                sibling->red = false;
+                parent->red = true;
+                rotate_right(object, parent);
+                sibling = parent->left;
+            }
+            if (!is_red(sibling->left) && !is_red(sibling->right)) {
+                sibling->red = true;
+                node = parent;
+                parent = node->parent;
+                continue;
+            }
+            if (!is_red(sibling->left)) {
+                sibling->right->red = false;
+                sibling->red = true;
+                rotate_left(object, sibling);
+                sibling = parent->left;
+            }
+            sibling->red = parent->red;
+            parent->red = false;
+            sibling->left->red = false;
+            rotate_right(object, parent);
+        }
+        node = object->root;
+    }
+    if (node) {
+        node->red = false;
+    }
+}
+
+static void erase(struct coral_red_black_tree *const object,
+                  struct coral_red_black_tree_node *const node) {
+    /* the successor takes the place of a node with two children */
+    struct coral_red_black_tree_node *successor = NULL;
+    if (node->left && node->right) {
+        successor = node->right;
+        while (successor->left) {
+            successor = successor->left;
+        }
+    }
+    for (struct coral_red_black_tree_node *i
+            = (successor ? successor : node)->parent; i; i = i->parent) {
+        i->size--;
+    }
+    struct coral_red_black_tree_node *child;
+    struct coral_red_black_tree_node *parent;
+    bool red;
+    if (!successor) {
+        child = node->left ? node->left : node->right;
+        parent = node->parent;
+        red = node->red;
+        if (child) {
+            child->parent = parent;
+        }
+        replace(object, node, child);
+    } else {
+        child = successor->right;
+        red = successor->red;
+        if (successor->parent == node) {
+            parent = successor;
+        } else {
+            parent = successor->parent;
+            parent->left = child;
+            if (child) {
+                child->parent = parent;
+            }
+            successor->right = node->right;
+            successor->right->parent = successor;
+        }
+        replace(object, node, successor);
+        successor->parent = node->parent;
+        successor->left = node->left;
+        successor->left->parent = successor;
+        successor->red = node->red;
+        successor->size = node->size;
+    }
+    /* parent is the deepest node whose children changed */
+    propagate(object, parent);
+    if (!red) {
+        remove_fixup(object, child, parent);
+    }
+}
+
+int coral_red_black_tree_remove(
+        struct coral_red_black_tree *const object,
+        struct coral_red_black_tree_node *const node) {
+    if (!object) {
+        return CORAL_RED_BLACK_TREE_ERROR_OBJECT_IS_NULL;
+    }
+    if (!node) {
+        return CORAL_RED_BLACK_TREE_ERROR_NODE_IS_NULL;
+    }
+    erase(object, node);
+    seagrass_required_true(!seagrass_uintmax_t_subtract(
+            object->count, 1, &object->count));
+    return 0;
+}
+
+int coral_red_black_tree_first(
+        const struct coral_red_black_tree *const object,
+        struct coral_red_black_tree_node **const out) {
+    if (!object) {
+        return CORAL_RED_BLACK_TREE_ERROR_OBJECT_IS_NULL;
+    }
+    if (!out) {
+        return CORAL_RED_BLACK_TREE_ERROR_OUT_IS_NULL;
+    }
+    struct coral_red_black_tree_node *node = object->root;
+    if (!node) {
+        return CORAL_RED_BLACK_TREE_ERROR_TREE_IS_EMPTY;
+    }
+    while (node->left) {
+        node = node->left;
+    }
+    *out = node;
+    return 0;
+}
+
+int coral_red_black_tree_last(
+        const struct coral_red_black_tree *const object,
+        struct coral_red_black_tree_node **const out) {
+    if (!object) {
+        return CORAL_RED_BLACK_TREE_ERROR_OBJECT_IS_NULL;
+    }
+    if (!out) {
+        return CORAL_RED_BLACK_TREE_ERROR_OUT_IS_NULL;
+    }
+    struct coral_red_black_tree_node *node = object->root;
+    if (!node) {
+        return CORAL_RED_BLACK_TREE_ERROR_TREE_IS_EMPTY;
+    }
+    while (node->right) {
+        node = node->right;
+    }
+    *out = node;
+    return 0;
+}
+
+int coral_red_black_tree_next(
+        const struct coral_red_black_tree_node *node,
+        struct coral_red_black_tree_node **const out) {
+    if (!node) {
+        return CORAL_RED_BLACK_TREE_ERROR_NODE_IS_NULL;
+    }
+    if (!out) {
+        return CORAL_RED_BLACK_TREE_ERROR_OUT_IS_NULL;
+    }
+    struct coral_red_black_tree_node *next = node->right;
+    if (next) {
+        while (next->left) {
+            next = next->left;
+        }
+        *out = next;
+        return 0;
+    }
+    next = node->parent;
+    while (next && node == next->right) {
+        node = next;
+        next = next->parent;
+    }
+    if (!next) {
+        return CORAL_RED_BLACK_TREE_ERROR_END_OF_SEQUENCE;
+    }
+    *out = next;
+    return 0;
+}
+
+int coral_red_black_tree_prev(
+        const struct coral_red_black_tree_node *node,
+        struct coral_red_black_tree_node **const out) {
+    if (!node) {
+        return CORAL_RED_BLACK_TREE_ERROR_NODE_IS_NULL;
+    }
+    if (!out) {
+        return CORAL_RED_BLACK_TREE_ERROR_OUT_IS_NULL;
+    }
+    struct coral_red_black_tree_node *prev = node->left;
+    if (prev) {
+        while (prev->right) {
+            prev = prev->right;
+        }
+        *out = prev;
+        return 0;
+    }
+    prev = node->parent;
+    while (prev && node == prev->left) {
+        node = prev;
+        prev = prev->parent;
+    }
+    if (!prev) {
+        return CORAL_RED_BLACK_TREE_ERROR_END_OF_SEQUENCE;
+    }
+    *out = prev;
+    return 0;
+}
+
+int coral_red_black_tree_rank(const struct coral_red_black_tree_node *node,
+                              uintmax_t *const out) {
+    if (!node) {
+        return CORAL_RED_BLACK_TREE_ERROR_NODE_IS_NULL;
+    }
+    if (!out) {
+        return CORAL_RED_BLACK_TREE_ERROR_OUT_IS_NULL;
+    }
+    uintmax_t rank = size_of(node->left);
+    for (; node->parent; node = node->parent) {
+        if (node == node->parent->right) {
+            rank += 1 + size_of(node->parent->left);
+        }
+    }
+    *out = rank;
+    return 0;
+}
+
+int coral_red_black_tree_select(
+        const struct coral_red_black_tree *const object,
+        uintmax_t index,
+        struct coral_red_black_tree_node **const out) {
+    if (!object) {
+        return CORAL_RED_BLACK_TREE_ERROR_OBJECT_IS_NULL;
+    }
+    if (!out) {
+        return CORAL_RED_BLACK_TREE_ERROR_OUT_IS_NULL;
+    }
+    if (index >= object->count) {
+        return CORAL_RED_BLACK_TREE_ERROR_INDEX_IS_OUT_OF_BOUNDS;
+    }
+    struct coral_red_black_tree_node *node = object->root;
+    while (true) {
+        const uintmax_t left = size_of(node->left);
+        if (index < left) {
+            node = node->left;
+        } else if (index > left) {
+            index -= 1 + left;
+            node = node->right;
+        } else {
+            *out = node;
+            return 0;
+        }
+    }
+}
+
+int coral_red_black_tree_count_before(
+        const struct coral_red_black_tree *const object,
+        const void *const key,
+        int (*const compare)(const void *key,
+                             const struct coral_red_black_tree_node *node,
+                             void *context),
+        void *const context,
+        uintmax_t *const out) {
+    if (!object) {
+        return CORAL_RED_BLACK_TREE_ERROR_OBJECT_IS_NULL;
+    }
+    if (!compare) {
+        return CORAL_RED_BLACK_TREE_ERROR_COMPARE_IS_NULL;
+    }
+    if (!out) {
+        return CORAL_RED_BLACK_TREE_ERROR_OUT_IS_NULL;
+    }
+    uintmax_t count = 0;
+    const struct coral_red_black_tree_node *node = object->root;
+    while (node) {
+        coral_counters_add(object, visit, 1);
+        const int result = compare(key, node, context);
+        if (!result) {
+            *out = count + size_of(node->left);
+            return 0;
+        }
+        if (result < 0) {
+            node = node->left;
+        } else {
+            count += 1 + size_of(node->left);
+            node = node->right;
+        }
+    }
+    *out = count;
+    return CORAL_RED_BLACK_TREE_ERROR_NODE_NOT_FOUND;
+}
+
+int coral_red_black_tree_propagate(
+        const struct coral_red_black_tree *const object,
+        struct coral_red_black_tree_node *const node) {
+    if (!object) {
+        return CORAL_RED_BLACK_TREE_ERROR_OBJECT_IS_NULL;
+    }
+    if (!node) {
+        return CORAL_RED_BLACK_TREE_ERROR_NODE_IS_NULL;
+    }
+    propagate(object, node);
+    return 0;
+}
+
+static uintmax_t black_height(const struct coral_red_black_tree_node *node) {
+    uintmax_t height = 0;
+    for (; node; node = node->left) {
+        height += !node->red;
+    }
+    return height;
+}
+
+/* Link left, pivot and right, in this order, into a single tree and return
+ * its root. The black heights of left and right are given so that pivot
+ * can be attached where they match, the black height of the joined tree is
+ * returned through height. The root of object is used as scratch. */
+static struct coral_red_black_tree_node *join(
+        struct coral_red_black_tree *const object,
+        struct coral_red_black_tree_node *const left,
+        uintmax_t left_height,
+        struct coral_red_black_tree_node *const pivot,
+        struct coral_red_black_tree_node *const right,
+        uintmax_t right_height,
+        uintmax_t *const height) {
+    if (is_red(left)) {
+        left->red = false;
+        left_height++;
+    }
+    if (is_red(right)) {
+        right->red = false;
+        right_height++;
+    }
+    if (left_height == right_height) {
+        *pivot = (struct coral_red_black_tree_node) {
+                .left = left,
+                .right = right,
+                .size = 1 + size_of(left) + size_of(right)
+        };
+        if (left) {
+            left->parent = pivot;
+        }
+        if (right) {
+            right->parent = pivot;
+        }
+        object->root = pivot;
+        propagate(object, pivot);
+        *height = 1 + left_height;
+        return pivot;
+    }
+    /* descend the taller tree along the spine facing the shorter one to the
+     * first black node of the same black height and take its place */
+    const bool taller = left_height > right_height;
+    const uintmax_t target = taller ? right_height : left_height;
+    uintmax_t at = taller ? left_height : right_height;
+    struct coral_red_black_tree_node *parent = NULL;
+    struct coral_red_black_tree_node *node = taller ? left : right;
+    while (is_red(node) || at > target) {
+        at -= !node->red;
+        parent = node;
+        node = taller ? node->right : node->left;
+    }
+    struct coral_red_black_tree_node *const other = taller ? right : left;
+    *pivot = (struct coral_red_black_tree_node) {
+            .parent = parent,
+            .left = taller ? node : other,
+            .right = taller ? other : node,
+            .size = 1 + size_of(node) + size_of(other),
+            .red = true
+    };
+    if (node) {
+        node->parent = pivot;
+    }
+    if (other) {
+        other->parent = pivot;
+    }
+    *(taller ? &parent->right : &parent->left) = pivot;
+    for (struct coral_red_black_tree_node *i = parent; i; i = i->parent) {
+        i->size += 1 + size_of(other);
+    }
+    object->root = taller ? left : right;
+    propagate(object, pivot);
+    *height = (taller ? left_height : right_height)
+              + insert_fixup(object, pivot);
+    return object->root;
+}
+
+/* Split the subtree at node, whose black height is given, into the nodes
+ * ordered before key and the rest. Nodes matching key are placed with the
+ * nodes before it if inclusive is set. */
+static void split(
+        struct coral_red_black_tree *const object,
+        struct coral_red_black_tree_node *const node,
+        const uintmax_t height,
+        const void *const key,
+        int (*const compare)(const void *,
+                             const struct coral_red_black_tree_node *,
+                             void *),
+        void *const context,
+        const bool inclusive,
+        struct coral_red_black_tree_node **const left,
+        uintmax_t *const left_height,
+        struct coral_red_black_tree_node **const right,
+        uintmax_t *const right_height) {
+    if (!node) {
+        *left = *right = NULL;
+        *left_height = *right_height = 0;
+        return;
+    }
+    struct coral_red_black_tree_node *const first = node->left;
+    struct coral_red_black_tree_node *const last = node->right;
+    const uintmax_t child_height = height - !node->red;
+    if (first) {
+        first->parent = NULL;
+    }
+    if (last) {
+        last->parent = NULL;
+    }
+    struct coral_red_black_tree_node *middle;
+    uintmax_t middle_height;
+    coral_counters_add(object, visit, 1);
+    const int result = compare(key, node, context);
+    if (result < 0 || (!result && !inclusive)) {
+        split(object, first, child_height, key, compare, context, inclusive,
+              left, left_height, &middle, &middle_height);
+        *right = join(object, middle, middle_height, node, last,
+                      child_height, right_height);
+    } else {
+        split(object, last, child_height, key, compare, context, inclusive,
+              &middle, &middle_height, right, right_height);
+        *left = join(object, first, child_height, node, middle,
+                     middle_height, left_height);
+    }
+}
+
+/* Link left and right, in this order, into a single tree using the first
+ * node of right as the pivot. */
+static struct coral_red_black_tree_node *concatenate(
+        struct coral_red_black_tree *const object,
+        struct coral_red_black_tree_node *const left,
+        const uintmax_t left_height,
+        struct coral_red_black_tree_node *right) {
+    if (!left || !right) {
+        return left ? left : right;
+    }
+    struct coral_red_black_tree_node *pivot = right;
+    while (pivot->left) {
+        pivot = pivot->left;
+    }
+    object->root = right;
+    erase(object, pivot);
+    right = object->root;
+    uintmax_t height;
+    return join(object, left, left_height, pivot, right, black_height(right),
+                &height);
+}
+
+int coral_red_black_tree_remove_range(
+        struct coral_red_black_tree *const object,
+        const void *const first,
+        const void *const last,
+        int (*const compare)(const void *key,
+                             const struct coral_red_black_tree_node *node,
+                             void *context),
+        void *const context,
+        struct coral_red_black_tree *const out) {
+    if (!object) {
+        return CORAL_RED_BLACK_TREE_ERROR_OBJECT_IS_NULL;
+    }
+    if (!compare) {
+        return CORAL_RED_BLACK_TREE_ERROR_COMPARE_IS_NULL;
+    }
+    if (!out) {
+        return CORAL_RED_BLACK_TREE_ERROR_OUT_IS_NULL;
+    }
+    struct coral_red_black_tree_node *left;
+    struct coral_red_black_tree_node *middle;
+    struct coral_red_black_tree_node *right;
+    uintmax_t left_height;
+    uintmax_t middle_height;
+    uintmax_t right_height;
+    split(object, object->root, black_height(object->root), first, compare,
+          context, false, &left, &left_height, &right, &right_height);
+    split(object, right, right_height, last, compare, context, true,
+          &middle, &middle_height, &right, &right_height);
+    object->root = concatenate(object, left, left_height, right);
+    if (object->root) {
+        object->root->red = false;
+    }
+    object->count = size_of(object->root);
+    if (middle) {
+        middle->red = false;
+    }
+    *out = (struct coral_red_black_tree) {
+            .count = size_of(middle),
+            .root = middle,
+            .augment = object->augment
+    };
+    return 0;
+}
+
+int coral_red_black_tree_split(
+        struct coral_red_black_tree *const object,
+        const void *const key,
+        int (*const compare)(const void *key,
+                             const struct coral_red_black_tree_node *node,
+                             void *context),
+        void *const context,
+        struct coral_red_black_tree *const out) {
+    if (!object) {
+        return CORAL_RED_BLACK_TREE_ERROR_OBJECT_IS_NULL;
+    }
+    if (!compare) {
+        return CORAL_RED_BLACK_TREE_ERROR_COMPARE_IS_NULL;
+    }
+    if (!out) {
+        return CORAL_RED_BLACK_TREE_ERROR_OUT_IS_NULL;
+    }
+    struct coral_red_black_tree_node *left;
+    struct coral_red_black_tree_node *right;
+    uintmax_t left_height;
+    uintmax_t right_height;
+    split(object, object->root, black_height(object->root), key, compare,
+          context, false, &left, &left_height, &right, &right_height);
+    if (left) {
+        left->red = false;
+    }
+    if (right) {
+        right->red = false;
+    }
+    object->root = left;
+    object->count = size_of(left);
+    *out = (struct coral_red_black_tree) {
+            .count = size_of(right),
+            .root = right,
+            .augment = object->augment
+    };
+    return 0;
+}
+
+int coral_red_black_tree_join(struct coral_red_black_tree *const object,
+                              struct coral_red_black_tree *const other) {
+    if (!object || !other) {
+        return CORAL_RED_BLACK_TREE_ERROR_OBJECT_IS_NULL;
+    }
+    struct coral_red_black_tree_node *const root = concatenate(
+            object, object->root, black_height(object->root), other->root);
+    if (root) {
+        root->red = false;
+    }
+    object->root = root;
+    object->count = size_of(root);
+    *other = (struct coral_red_black_tree) {
+            .augment = other->augment
+    };
+    return 0;
+}
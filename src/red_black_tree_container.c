@@ -1,8 +1,9 @@
 #include <stdlib.h>
-#include <errno.h>
 #include <seagrass.h>
 #include <coral.h>
 
+#include "counters.h"
+
 #ifdef TEST
 #include <test/cmocka.h>
 #endif
@@ -12,11 +13,13 @@ struct coral_red_black_tree_container_entry {
 };
 
 struct entry {
-    struct rock_red_black_tree_node node;
+    struct coral_red_black_tree_node node;
+    const struct coral_allocator *allocator;
     unsigned char data[];
 };
 
-int coral_red_black_tree_container_alloc(
+int coral_red_black_tree_container_alloc_with(
+        const struct coral_allocator *allocator,
         const size_t size,
         struct coral_red_black_tree_container_entry **const out) {
     if (!size) {
@@ -33,33 +36,84 @@ int coral_red_black_tree_container_alloc(
                                == error || !error);
         return CORAL_RED_BLACK_TREE_CONTAINER_ERROR_SIZE_IS_TOO_LARGE;
     }
+    if (!allocator) {
+        seagrass_required_true(!coral_allocator_get_default(&allocator));
+    }
     struct entry *entry;
-    if ((error = posix_memalign((void **) &entry, sizeof(void *), alloc))) {
-        seagrass_required_true(ENOMEM == error);
+    if (allocator->alloc(allocator->context, sizeof(void *), alloc,
+                         (void **) &entry)) {
         return CORAL_RED_BLACK_TREE_CONTAINER_ERROR_MEMORY_ALLOCATION_FAILED;
     }
-    seagrass_required_true(!rock_red_black_tree_node_init(&entry->node));
+    seagrass_required_true(!coral_red_black_tree_node_init(&entry->node));
+    entry->allocator = allocator;
+    coral_allocation_counters_alloc();
     *out = (struct coral_red_black_tree_container_entry *) &entry->data;
     return 0;
 }
 
+int coral_red_black_tree_container_alloc(
+        const size_t size,
+        struct coral_red_black_tree_container_entry **const out) {
+    return coral_red_black_tree_container_alloc_with(NULL, size, out);
+}
+
 int coral_red_black_tree_container_free(
         struct coral_red_black_tree_container_entry *const entry) {
     if (!entry) {
         return CORAL_RED_BLACK_TREE_CONTAINER_ERROR_ENTRY_IS_NULL;
     }
     struct entry *const A = rock_container_of(entry, struct entry, data);
-    free(A);
+    coral_allocation_counters_free();
+    A->allocator->free(A->allocator->context, A);
     return 0;
 }
 
-static _Thread_local const struct coral_red_black_tree_container *this;
+int coral_red_black_tree_container_node_init(
+        struct coral_red_black_tree_container_node *const node) {
+    if (!node) {
+        return CORAL_RED_BLACK_TREE_CONTAINER_ERROR_NODE_IS_NULL;
+    }
+    seagrass_required_true(!coral_red_black_tree_node_init(&node->node));
+    return 0;
+}
+
+static int entity_compare(const void *const key,
+                          const struct coral_red_black_tree_node *const node,
+                          void *const context) {
+    const struct coral_red_black_tree_container *const object = context;
+    const struct entry *const B = rock_container_of(node, struct entry, node);
+    coral_counters_add(&object->tree, compare, 1);
+    return object->compare(key, &B->data);
+}
+
+static int key_compare(const void *const key,
+                       const struct coral_red_black_tree_node *const node,
+                       void *const context) {
+    const struct coral_red_black_tree_container *const object = context;
+    const struct entry *const B = rock_container_of(node, struct entry, node);
+    coral_counters_add(&object->tree, compare, 1);
+    return object->compare_key(key, &B->data);
+}
+
+static int node_compare(const void *const key,
+                        const struct coral_red_black_tree_node *const node,
+                        void *const context) {
+    const struct coral_red_black_tree_container *const object = context;
+    const struct coral_red_black_tree_container_node *const B
+            = rock_container_of(
+                    node, struct coral_red_black_tree_container_node, node);
+    coral_counters_add(&object->tree, compare, 1);
+    return object->compare_node(key, B);
+}
 
-static int entity_compare(const struct rock_red_black_tree_node *const a,
-                          const struct rock_red_black_tree_node *const b) {
-    const struct entry *const A = rock_container_of(a, struct entry, node);
-    const struct entry *const B = rock_container_of(b, struct entry, node);
-    return this->compare(&A->data, &B->data);
+static int find(const struct coral_red_black_tree_container *const object,
+                const void *const key,
+                int (*const compare)(const void *,
+                             const struct coral_red_black_tree_node *,
+                             void *),
+                struct coral_red_black_tree_node **const out) {
+    return coral_red_black_tree_find(
+            &object->tree, key, compare, (void *) object, out);
 }
 
 int coral_red_black_tree_container_init(
@@ -73,12 +127,61 @@ int coral_red_black_tree_container_init(
         return CORAL_RED_BLACK_TREE_CONTAINER_ERROR_COMPARE_IS_NULL;
     }
     *object = (struct coral_red_black_tree_container) {0};
-    seagrass_required_true(!rock_red_black_tree_init(
-            &object->tree, entity_compare));
+    seagrass_required_true(!coral_red_black_tree_init(&object->tree));
     object->compare = compare;
     return 0;
 }
 
+int coral_red_black_tree_container_init_with_key(
+        struct coral_red_black_tree_container *const object,
+        int (*const compare)(const void *first,
+                             const void *second),
+        int (*const compare_key)(const void *key,
+                                 const void *entry)) {
+    if (!compare_key) {
+        return CORAL_RED_BLACK_TREE_CONTAINER_ERROR_COMPARE_IS_NULL;
+    }
+    int error;
+    if ((error = coral_red_black_tree_container_init(object, compare))) {
+        return error;
+    }
+    object->compare_key = compare_key;
+    return 0;
+}
+
+int coral_red_black_tree_container_init_intrusive(
+        struct coral_red_black_tree_container *const object,
+        int (*const compare)(
+                const struct coral_red_black_tree_container_node *first,
+                const struct coral_red_black_tree_container_node *second)) {
+    if (!object) {
+        return CORAL_RED_BLACK_TREE_CONTAINER_ERROR_OBJECT_IS_NULL;
+    }
+    if (!compare) {
+        return CORAL_RED_BLACK_TREE_CONTAINER_ERROR_COMPARE_IS_NULL;
+    }
+    *object = (struct coral_red_black_tree_container) {0};
+    seagrass_required_true(!coral_red_black_tree_init(&object->tree));
+    object->compare_node = compare;
+    return 0;
+}
+
+struct invalidation {
+    void (*on_destroy)(struct coral_red_black_tree_container_entry *);
+};
+
+static void destroy_node(struct coral_red_black_tree_node *const node,
+                         void *const context) {
+    const struct invalidation *const invalidation = context;
+    struct entry *const A = rock_container_of(node, struct entry, node);
+    struct coral_red_black_tree_container_entry *const entry
+            = (struct coral_red_black_tree_container_entry *) &A->data;
+    if (invalidation->on_destroy) {
+        invalidation->on_destroy(entry);
+    }
+    seagrass_required_true(!coral_red_black_tree_container_free(entry));
+}
+
 int coral_red_black_tree_container_invalidate(
         struct coral_red_black_tree_container *const object,
         void (*on_destroy)(
@@ -86,36 +189,13 @@ int coral_red_black_tree_container_invalidate(
     if (!object) {
         return CORAL_RED_BLACK_TREE_CONTAINER_ERROR_OBJECT_IS_NULL;
     }
-    int error;
-    struct coral_red_black_tree_container_entry *entry;
-    if ((error = coral_red_black_tree_container_first(object, &entry))) {
-        seagrass_required_true(
-                CORAL_RED_BLACK_TREE_CONTAINER_ERROR_CONTAINER_IS_EMPTY
-                == error);
-    } else {
-        while (true) {
-            struct coral_red_black_tree_container_entry *next;
-            if ((error = coral_red_black_tree_container_next(entry, &next))) {
-                seagrass_required_true(
-                        CORAL_RED_BLACK_TREE_CONTAINER_ERROR_END_OF_SEQUENCE
-                        == error);
-            }
-            seagrass_required_true(!coral_red_black_tree_container_remove(
-                    object, entry));
-            if (on_destroy) {
-                on_destroy(entry);
-            }
-            seagrass_required_true(!coral_red_black_tree_container_free(
-                    entry));
-            if (!error) {
-                entry = next;
-            } else {
-                break;
-            }
-        }
-    }
-    seagrass_required_true(!rock_red_black_tree_invalidate(
-            &object->tree, NULL));
+    struct invalidation invalidation = {
+            .on_destroy = on_destroy
+    };
+    /* nodes are owned by the caller */
+    seagrass_required_true(!coral_red_black_tree_invalidate(
+            &object->tree, object->compare_node ? NULL : destroy_node,
+            &invalidation));
     *object = (struct coral_red_black_tree_container) {0};
     return 0;
 }
@@ -129,8 +209,24 @@ int coral_red_black_tree_container_count(
     if (!out) {
         return CORAL_RED_BLACK_TREE_CONTAINER_ERROR_OUT_IS_NULL;
     }
-    seagrass_required_true(!rock_red_black_tree_count(
-            &object->tree, out));
+    *out = object->tree.count;
+    return 0;
+}
+
+static int insert(struct coral_red_black_tree_container *const object,
+                  const void *const key,
+                  struct coral_red_black_tree_node *const node,
+                  int (*const compare)(const void *,
+                                       const struct coral_red_black_tree_node *,
+                                       void *)) {
+    const int error = coral_red_black_tree_insert(
+            &object->tree, key, node, compare, object);
+    if (error) {
+        seagrass_required_true(CORAL_RED_BLACK_TREE_ERROR_NODE_ALREADY_EXISTS
+                               == error);
+        return CORAL_RED_BLACK_TREE_CONTAINER_ERROR_ENTRY_ALREADY_EXISTS;
+    }
+    coral_counters_add(&object->tree, insert, 1);
     return 0;
 }
 
@@ -143,20 +239,56 @@ int coral_red_black_tree_container_add(
     if (!entry) {
         return CORAL_RED_BLACK_TREE_CONTAINER_ERROR_ENTRY_IS_NULL;
     }
-    int error;
+    if (!object->compare) {
+        return CORAL_RED_BLACK_TREE_CONTAINER_ERROR_COMPARE_IS_NULL;
+    }
     struct entry *const A = rock_container_of(entry, struct entry, data);
-    struct rock_red_black_tree_node *insertion_point;
-    this = object;
-    if (!(error = rock_red_black_tree_find(&object->tree,
-                                           NULL,
-                                           &A->node,
-                                           &insertion_point))) {
-        return CORAL_RED_BLACK_TREE_CONTAINER_ERROR_ENTRY_ALREADY_EXISTS;
+    return insert(object, &A->data, &A->node, entity_compare);
+}
+
+static struct coral_red_black_tree_node *entry_at(const uintmax_t index,
+                                                  void *const context) {
+    struct coral_red_black_tree_container_entry *const *const entries = context;
+    struct entry *const A = rock_container_of(entries[index], struct entry,
+                                              data);
+    return &A->node;
+}
+
+int coral_red_black_tree_container_build_sorted(
+        struct coral_red_black_tree_container *const object,
+        struct coral_red_black_tree_container_entry *const *const entries,
+        const uintmax_t count) {
+    if (!object) {
+        return CORAL_RED_BLACK_TREE_CONTAINER_ERROR_OBJECT_IS_NULL;
+    }
+    if (!entries && count) {
+        return CORAL_RED_BLACK_TREE_CONTAINER_ERROR_ENTRY_IS_NULL;
+    }
+    if (!object->compare) {
+        return CORAL_RED_BLACK_TREE_CONTAINER_ERROR_COMPARE_IS_NULL;
+    }
+    if (object->tree.root) {
+        return CORAL_RED_BLACK_TREE_CONTAINER_ERROR_CONTAINER_IS_NOT_EMPTY;
     }
-    seagrass_required_true(ROCK_RED_BLACK_TREE_ERROR_NODE_NOT_FOUND
-                           == error);
-    seagrass_required_true(!rock_red_black_tree_insert(
-            &object->tree, insertion_point, &A->node));
+    for (uintmax_t i = 0; i < count; i++) {
+        if (!entries[i]) {
+            return CORAL_RED_BLACK_TREE_CONTAINER_ERROR_ENTRY_IS_NULL;
+        }
+        if (!i) {
+            continue;
+        }
+        coral_counters_add(&object->tree, compare, 1);
+        const int result = object->compare(entries[i - 1], entries[i]);
+        if (!result) {
+            return CORAL_RED_BLACK_TREE_CONTAINER_ERROR_ENTRY_ALREADY_EXISTS;
+        }
+        if (result > 0) {
+            return CORAL_RED_BLACK_TREE_CONTAINER_ERROR_ENTRIES_ARE_NOT_SORTED;
+        }
+    }
+    seagrass_required_true(!coral_red_black_tree_build(
+            &object->tree, count, entry_at, (void *) entries));
+    coral_counters_add(&object->tree, insert, count);
     return 0;
 }
 
@@ -170,15 +302,115 @@ int coral_red_black_tree_container_remove(
         return CORAL_RED_BLACK_TREE_CONTAINER_ERROR_ENTRY_IS_NULL;
     }
     struct entry *const A = rock_container_of(entry, struct entry, data);
-    seagrass_required_true(!rock_red_black_tree_remove(
+    seagrass_required_true(!coral_red_black_tree_remove(
             &object->tree, &A->node));
+    coral_counters_add(&object->tree, remove, 1);
     return 0;
 }
 
-int coral_red_black_tree_container_get(
-        const struct coral_red_black_tree_container *const object,
+static void remove_range(
+        struct coral_red_black_tree_container *const object,
+        const void *const first,
+        const void *const last,
+        int (*const compare)(const void *,
+                             const struct coral_red_black_tree_node *,
+                             void *),
+        void (*const on_destroy)(
+                struct coral_red_black_tree_container_entry *)) {
+    struct coral_red_black_tree removed;
+    seagrass_required_true(!coral_red_black_tree_remove_range(
+            &object->tree, first, last, compare, object, &removed));
+    coral_counters_add(&object->tree, remove, removed.count);
+    struct invalidation invalidation = {
+            .on_destroy = on_destroy
+    };
+    seagrass_required_true(!coral_red_black_tree_invalidate(
+            &removed, destroy_node, &invalidation));
+}
+
+int coral_red_black_tree_container_remove_range(
+        struct coral_red_black_tree_container *const object,
+        const void *const first,
+        const void *const last,
+        void (*const on_destroy)(
+                struct coral_red_black_tree_container_entry *entry)) {
+    if (!object) {
+        return CORAL_RED_BLACK_TREE_CONTAINER_ERROR_OBJECT_IS_NULL;
+    }
+    if (!first || !last) {
+        return CORAL_RED_BLACK_TREE_CONTAINER_ERROR_KEY_IS_NULL;
+    }
+    if (!object->compare) {
+        return CORAL_RED_BLACK_TREE_CONTAINER_ERROR_COMPARE_IS_NULL;
+    }
+    remove_range(object, first, last, entity_compare, on_destroy);
+    return 0;
+}
+
+int coral_red_black_tree_container_remove_range_key(
+        struct coral_red_black_tree_container *const object,
+        const void *const first,
+        const void *const last,
+        void (*const on_destroy)(
+                struct coral_red_black_tree_container_entry *entry)) {
+    if (!object) {
+        return CORAL_RED_BLACK_TREE_CONTAINER_ERROR_OBJECT_IS_NULL;
+    }
+    if (!first || !last) {
+        return CORAL_RED_BLACK_TREE_CONTAINER_ERROR_KEY_IS_NULL;
+    }
+    if (!object->compare_key) {
+        return CORAL_RED_BLACK_TREE_CONTAINER_ERROR_COMPARE_IS_NULL;
+    }
+    remove_range(object, first, last, key_compare, on_destroy);
+    return 0;
+}
+
+static void split(struct coral_red_black_tree_container *const object,
+                  const void *const key,
+                  int (*const compare)(const void *,
+                                       const struct coral_red_black_tree_node *,
+                                       void *),
+                  struct coral_red_black_tree_container *const out) {
+    struct coral_red_black_tree right;
+    seagrass_required_true(!coral_red_black_tree_split(
+            &object->tree, key, compare, object, &right));
+    *out = (struct coral_red_black_tree_container) {
+            .tree = right,
+            .compare = object->compare,
+            .compare_key = object->compare_key,
+            .compare_node = object->compare_node,
+            .summary_size = object->summary_size,
+            .summary_offset = object->summary_offset,
+            .lift = object->lift,
+            .combine = object->combine
+    };
+}
+
+int coral_red_black_tree_container_split(
+        struct coral_red_black_tree_container *const object,
         const void *const key,
-        struct coral_red_black_tree_container_entry **const out) {
+        struct coral_red_black_tree_container *const out) {
+    if (!object) {
+        return CORAL_RED_BLACK_TREE_CONTAINER_ERROR_OBJECT_IS_NULL;
+    }
+    if (!key) {
+        return CORAL_RED_BLACK_TREE_CONTAINER_ERROR_KEY_IS_NULL;
+    }
+    if (!out) {
+        return CORAL_RED_BLACK_TREE_CONTAINER_ERROR_OUT_IS_NULL;
+    }
+    if (!object->compare) {
+        return CORAL_RED_BLACK_TREE_CONTAINER_ERROR_COMPARE_IS_NULL;
+    }
+    split(object, key, entity_compare, out);
+    return 0;
+}
+
+int coral_red_black_tree_container_split_key(
+        struct coral_red_black_tree_container *const object,
+        const void *const key,
+        struct coral_red_black_tree_container *const out) {
     if (!object) {
         return CORAL_RED_BLACK_TREE_CONTAINER_ERROR_OBJECT_IS_NULL;
     }
@@ -188,16 +420,224 @@ int coral_red_black_tree_container_get(
     if (!out) {
         return CORAL_RED_BLACK_TREE_CONTAINER_ERROR_OUT_IS_NULL;
     }
+    if (!object->compare_key) {
+        return CORAL_RED_BLACK_TREE_CONTAINER_ERROR_COMPARE_IS_NULL;
+    }
+    split(object, key, key_compare, out);
+    return 0;
+}
+
+static int order(const struct coral_red_black_tree_container *const object,
+                 const struct coral_red_black_tree_node *const first,
+                 const struct coral_red_black_tree_node *const second) {
+    coral_counters_add(&object->tree, compare, 1);
+    if (object->compare_node) {
+        return object->compare_node(
+                rock_container_of(first,
+                                  struct coral_red_black_tree_container_node,
+                                  node),
+                rock_container_of(second,
+                                  struct coral_red_black_tree_container_node,
+                                  node));
+    }
+    return object->compare(
+            &rock_container_of(first, struct entry, node)->data,
+            &rock_container_of(second, struct entry, node)->data);
+}
+
+int coral_red_black_tree_container_join(
+        struct coral_red_black_tree_container *const object,
+        struct coral_red_black_tree_container *const other) {
+    if (!object || !other) {
+        return CORAL_RED_BLACK_TREE_CONTAINER_ERROR_OBJECT_IS_NULL;
+    }
+    /* the joined tree keeps the order and summaries of object */
+    if (object->compare != other->compare
+        || object->compare_node != other->compare_node
+        || object->summary_size != other->summary_size
+        || object->summary_offset != other->summary_offset
+        || object->lift != other->lift
+        || object->combine != other->combine) {
+        return CORAL_RED_BLACK_TREE_CONTAINER_ERROR_CONTAINERS_ARE_INCOMPATIBLE;
+    }
+    struct coral_red_black_tree_node *last;
+    struct coral_red_black_tree_node *first;
+    if (!coral_red_black_tree_last(&object->tree, &last)
+        && !coral_red_black_tree_first(&other->tree, &first)) {
+        const int result = order(object, last, first);
+        if (!result) {
+            return CORAL_RED_BLACK_TREE_CONTAINER_ERROR_ENTRY_ALREADY_EXISTS;
+        }
+        if (result > 0) {
+            return CORAL_RED_BLACK_TREE_CONTAINER_ERROR_ENTRIES_ARE_NOT_SORTED;
+        }
+    }
+    seagrass_required_true(!coral_red_black_tree_join(
+            &object->tree, &other->tree));
+    return 0;
+}
+
+static struct coral_red_black_tree_node *node_in(const uintmax_t index,
+                                                 void *const context) {
+    struct coral_red_black_tree_node *const *const nodes = context;
+    return nodes[index];
+}
+
+static struct coral_red_black_tree_node *first_of(
+        const struct coral_red_black_tree *const tree) {
+    struct coral_red_black_tree_node *out;
+    return coral_red_black_tree_first(tree, &out) ? NULL : out;
+}
+
+static struct coral_red_black_tree_node *next_of(
+        const struct coral_red_black_tree_node *const node) {
+    struct coral_red_black_tree_node *out;
+    return coral_red_black_tree_next(node, &out) ? NULL : out;
+}
+
+/* Walk both containers in order at once and rebuild object from the
+ * entries found only in object, in both or only in other as requested.
+ * Entries of other are moved, and other emptied, only if those found only
+ * in other are kept, otherwise other is left as it is. */
+static int merge(struct coral_red_black_tree_container *const object,
+                 struct coral_red_black_tree_container *const other,
+                 const bool only_object,
+                 const bool both,
+                 const bool only_other,
+                 void (*const on_destroy)(
+                         struct coral_red_black_tree_container_entry *)) {
+    uintmax_t total = object->tree.count;
+    if (only_other && seagrass_uintmax_t_add(
+            total, other->tree.count, &total)) {
+        return CORAL_RED_BLACK_TREE_CONTAINER_ERROR_MEMORY_ALLOCATION_FAILED;
+    }
+    if (!total) {
+        return 0;
+    }
+    if (total > SIZE_MAX / sizeof(struct coral_red_black_tree_node *)) {
+        return CORAL_RED_BLACK_TREE_CONTAINER_ERROR_MEMORY_ALLOCATION_FAILED;
+    }
+    struct coral_red_black_tree_node **const nodes
+            = malloc(total * sizeof(*nodes));
+    if (!nodes) {
+        return CORAL_RED_BLACK_TREE_CONTAINER_ERROR_MEMORY_ALLOCATION_FAILED;
+    }
+    /* kept nodes fill the front in order, dropped ones the back */
+    uintmax_t kept = 0;
+    uintmax_t dropped = total;
+    struct coral_red_black_tree_node *a = first_of(&object->tree);
+    struct coral_red_black_tree_node *b = first_of(&other->tree);
+    while (a || (b && only_other)) {
+        const int result = !a ? 1 : !b ? -1 : order(object, a, b);
+        if (result < 0) {
+            nodes[only_object ? kept++ : --dropped] = a;
+            a = next_of(a);
+        } else if (result > 0) {
+            if (only_other) {
+                nodes[kept++] = b;
+            }
+            b = next_of(b);
+        } else {
+            nodes[both ? kept++ : --dropped] = a;
+            if (only_other) {
+                nodes[--dropped] = b;
+            }
+            a = next_of(a);
+            b = next_of(b);
+        }
+    }
+    object->tree.root = NULL;
+    object->tree.count = 0;
+    if (only_other) {
+        other->tree.root = NULL;
+        other->tree.count = 0;
+    }
+    seagrass_required_true(!coral_red_black_tree_build(
+            &object->tree, kept, node_in, nodes));
+    coral_counters_add(&object->tree, remove, total - kept);
+    for (uintmax_t i = dropped; i < total; i++) {
+        struct entry *const A = rock_container_of(nodes[i], struct entry,
+                                                  node);
+        struct coral_red_black_tree_container_entry *const entry
+                = (struct coral_red_black_tree_container_entry *) &A->data;
+        if (on_destroy) {
+            on_destroy(entry);
+        }
+        seagrass_required_true(!coral_red_black_tree_container_free(entry));
+    }
+    free(nodes);
+    return 0;
+}
+
+static int set_operation(
+        struct coral_red_black_tree_container *const object,
+        struct coral_red_black_tree_container *const other,
+        const bool only_object,
+        const bool both,
+        const bool only_other,
+        void (*const on_destroy)(
+                struct coral_red_black_tree_container_entry *)) {
+    if (!object || !other) {
+        return CORAL_RED_BLACK_TREE_CONTAINER_ERROR_OBJECT_IS_NULL;
+    }
+    if (!object->compare || !other->compare) {
+        return CORAL_RED_BLACK_TREE_CONTAINER_ERROR_COMPARE_IS_NULL;
+    }
+    if (object == other) {
+        /* every entry is found in both */
+        struct coral_red_black_tree_container none = {0};
+        return both ? 0 : merge(object, &none, false, false, false,
+                                on_destroy);
+    }
+    return merge(object, other, only_object, both, only_other, on_destroy);
+}
+
+int coral_red_black_tree_container_union(
+        struct coral_red_black_tree_container *const object,
+        struct coral_red_black_tree_container *const other,
+        void (*const on_destroy)(
+                struct coral_red_black_tree_container_entry *entry)) {
+    return set_operation(object, other, true, true, true, on_destroy);
+}
+
+int coral_red_black_tree_container_intersection(
+        struct coral_red_black_tree_container *const object,
+        const struct coral_red_black_tree_container *const other,
+        void (*const on_destroy)(
+                struct coral_red_black_tree_container_entry *entry)) {
+    return set_operation(object, (void *) other, false, true, false,
+                         on_destroy);
+}
+
+int coral_red_black_tree_container_difference(
+        struct coral_red_black_tree_container *const object,
+        const struct coral_red_black_tree_container *const other,
+        void (*const on_destroy)(
+                struct coral_red_black_tree_container_entry *entry)) {
+    return set_operation(object, (void *) other, true, false, false,
+                         on_destroy);
+}
+
+int coral_red_black_tree_container_symmetric_difference(
+        struct coral_red_black_tree_container *const object,
+        struct coral_red_black_tree_container *const other,
+        void (*const on_destroy)(
+                struct coral_red_black_tree_container_entry *entry)) {
+    return set_operation(object, other, true, false, true, on_destroy);
+}
+
+static int find_equal(
+        const struct coral_red_black_tree_container *const object,
+        const void *const key,
+        int (*const compare)(const void *,
+                             const struct coral_red_black_tree_node *,
+                             void *),
+        struct coral_red_black_tree_container_entry **const out) {
     int error;
-    struct entry *const K = rock_container_of(key, struct entry, data);
-    struct rock_red_black_tree_node *node;
-    this = object;
-    if ((error = rock_red_black_tree_find(&object->tree,
-                                          NULL,
-                                          &K->node,
-                                          &node))) {
+    struct coral_red_black_tree_node *node;
+    if ((error = find(object, key, compare, &node))) {
         seagrass_required_true(
-                ROCK_RED_BLACK_TREE_ERROR_NODE_NOT_FOUND
+                CORAL_RED_BLACK_TREE_ERROR_NODE_NOT_FOUND
                 == error);
         return CORAL_RED_BLACK_TREE_CONTAINER_ERROR_ENTRY_NOT_FOUND;
     }
@@ -206,7 +646,7 @@ int coral_red_black_tree_container_get(
     return 0;
 }
 
-int coral_red_black_tree_container_ceiling(
+int coral_red_black_tree_container_get(
         const struct coral_red_black_tree_container *const object,
         const void *const key,
         struct coral_red_black_tree_container_entry **const out) {
@@ -219,31 +659,13 @@ int coral_red_black_tree_container_ceiling(
     if (!out) {
         return CORAL_RED_BLACK_TREE_CONTAINER_ERROR_OUT_IS_NULL;
     }
-    int error;
-    struct entry *const K = rock_container_of(key, struct entry, data);
-    struct rock_red_black_tree_node *node;
-    this = object;
-    if ((error = rock_red_black_tree_find(&object->tree,
-                                          NULL,
-                                          &K->node,
-                                          &node))) {
-        seagrass_required_true(
-                ROCK_RED_BLACK_TREE_ERROR_NODE_NOT_FOUND
-                == error);
-        if (!node) {
-            return CORAL_RED_BLACK_TREE_CONTAINER_ERROR_ENTRY_NOT_FOUND;
-        }
-        struct entry *const B = rock_container_of(node, struct entry, node);
-        if (entity_compare(&K->node, &B->node) > 0) {
-            return CORAL_RED_BLACK_TREE_CONTAINER_ERROR_ENTRY_NOT_FOUND;
-        }
+    if (!object->compare) {
+        return CORAL_RED_BLACK_TREE_CONTAINER_ERROR_COMPARE_IS_NULL;
     }
-    struct entry *const A = rock_container_of(node, struct entry, node);
-    *out = (struct coral_red_black_tree_container_entry *) &A->data;
-    return 0;
+    return find_equal(object, key, entity_compare, out);
 }
 
-int coral_red_black_tree_container_floor(
+int coral_red_black_tree_container_get_key(
         const struct coral_red_black_tree_container *const object,
         const void *const key,
         struct coral_red_black_tree_container_entry **const out) {
@@ -256,25 +678,33 @@ int coral_red_black_tree_container_floor(
     if (!out) {
         return CORAL_RED_BLACK_TREE_CONTAINER_ERROR_OUT_IS_NULL;
     }
+    if (!object->compare_key) {
+        return CORAL_RED_BLACK_TREE_CONTAINER_ERROR_COMPARE_IS_NULL;
+    }
+    return find_equal(object, key, key_compare, out);
+}
+
+static int find_ceiling(
+        const struct coral_red_black_tree_container *const object,
+        const void *const key,
+        int (*const compare)(const void *,
+                             const struct coral_red_black_tree_node *,
+                             void *),
+        struct coral_red_black_tree_container_entry **const out) {
     int error;
-    struct entry *const K = rock_container_of(key, struct entry, data);
-    struct rock_red_black_tree_node *node;
-    this = object;
-    if ((error = rock_red_black_tree_find(&object->tree,
-                                          NULL,
-                                          &K->node,
-                                          &node))) {
+    struct coral_red_black_tree_node *node;
+    if ((error = find(object, key, compare, &node))) {
         seagrass_required_true(
-                ROCK_RED_BLACK_TREE_ERROR_NODE_NOT_FOUND
+                CORAL_RED_BLACK_TREE_ERROR_NODE_NOT_FOUND
                 == error);
         if (!node) {
             return CORAL_RED_BLACK_TREE_CONTAINER_ERROR_ENTRY_NOT_FOUND;
         }
         struct entry *const B = rock_container_of(node, struct entry, node);
-        if (entity_compare(&K->node, &B->node) < 0
-            && (error = rock_red_black_tree_prev(node, &node))) {
+        if (compare(key, &B->node, (void *) object) > 0
+            && (error = coral_red_black_tree_next(node, &node))) {
             seagrass_required_true(
-                    ROCK_RED_BLACK_TREE_ERROR_END_OF_SEQUENCE
+                    CORAL_RED_BLACK_TREE_ERROR_END_OF_SEQUENCE
                     == error);
             return CORAL_RED_BLACK_TREE_CONTAINER_ERROR_ENTRY_NOT_FOUND;
         }
@@ -284,7 +714,7 @@ int coral_red_black_tree_container_floor(
     return 0;
 }
 
-int coral_red_black_tree_container_higher(
+int coral_red_black_tree_container_ceiling(
         const struct coral_red_black_tree_container *const object,
         const void *const key,
         struct coral_red_black_tree_container_entry **const out) {
@@ -297,36 +727,13 @@ int coral_red_black_tree_container_higher(
     if (!out) {
         return CORAL_RED_BLACK_TREE_CONTAINER_ERROR_OUT_IS_NULL;
     }
-    int error;
-    struct entry *const K = rock_container_of(key, struct entry, data);
-    struct rock_red_black_tree_node *node;
-    this = object;
-    if ((error = rock_red_black_tree_find(&object->tree,
-                                          NULL,
-                                          &K->node,
-                                          &node))) {
-        seagrass_required_true(
-                ROCK_RED_BLACK_TREE_ERROR_NODE_NOT_FOUND
-                == error);
-        if (!node) {
-            return CORAL_RED_BLACK_TREE_CONTAINER_ERROR_ENTRY_NOT_FOUND;
-        }
-        struct entry *const B = rock_container_of(node, struct entry, node);
-        if (entity_compare(&K->node, &B->node) > 0) {
-            return CORAL_RED_BLACK_TREE_CONTAINER_ERROR_ENTRY_NOT_FOUND;
-        }
-    } else if ((error = rock_red_black_tree_next(node, &node))) {
-        seagrass_required_true(
-                ROCK_RED_BLACK_TREE_ERROR_END_OF_SEQUENCE
-                == error);
-        return CORAL_RED_BLACK_TREE_CONTAINER_ERROR_ENTRY_NOT_FOUND;
+    if (!object->compare) {
+        return CORAL_RED_BLACK_TREE_CONTAINER_ERROR_COMPARE_IS_NULL;
     }
-    struct entry *const A = rock_container_of(node, struct entry, node);
-    *out = (struct coral_red_black_tree_container_entry *) &A->data;
-    return 0;
+    return find_ceiling(object, key, entity_compare, out);
 }
 
-int coral_red_black_tree_container_lower(
+int coral_red_black_tree_container_ceiling_key(
         const struct coral_red_black_tree_container *const object,
         const void *const key,
         struct coral_red_black_tree_container_entry **const out) {
@@ -339,35 +746,222 @@ int coral_red_black_tree_container_lower(
     if (!out) {
         return CORAL_RED_BLACK_TREE_CONTAINER_ERROR_OUT_IS_NULL;
     }
+    if (!object->compare_key) {
+        return CORAL_RED_BLACK_TREE_CONTAINER_ERROR_COMPARE_IS_NULL;
+    }
+    return find_ceiling(object, key, key_compare, out);
+}
+
+static int find_floor(
+        const struct coral_red_black_tree_container *const object,
+        const void *const key,
+        int (*const compare)(const void *,
+                             const struct coral_red_black_tree_node *,
+                             void *),
+        struct coral_red_black_tree_container_entry **const out) {
     int error;
-    struct entry *const K = rock_container_of(key, struct entry, data);
-    struct rock_red_black_tree_node *node;
-    this = object;
-    if ((error = rock_red_black_tree_find(&object->tree,
-                                          NULL,
-                                          &K->node,
-                                          &node))) {
+    struct coral_red_black_tree_node *node;
+    if ((error = find(object, key, compare, &node))) {
         seagrass_required_true(
-                ROCK_RED_BLACK_TREE_ERROR_NODE_NOT_FOUND
+                CORAL_RED_BLACK_TREE_ERROR_NODE_NOT_FOUND
                 == error);
         if (!node) {
             return CORAL_RED_BLACK_TREE_CONTAINER_ERROR_ENTRY_NOT_FOUND;
         }
-    }
-    struct entry *const B = rock_container_of(node, struct entry, node);
-    if (entity_compare(&K->node, &B->node) <= 0
-        && (error = rock_red_black_tree_prev(node, &node))) {
-        seagrass_required_true(
-                ROCK_RED_BLACK_TREE_ERROR_END_OF_SEQUENCE
-                == error);
-        return CORAL_RED_BLACK_TREE_CONTAINER_ERROR_ENTRY_NOT_FOUND;
+        struct entry *const B = rock_container_of(node, struct entry, node);
+        if (compare(key, &B->node, (void *) object) < 0
+            && (error = coral_red_black_tree_prev(node, &node))) {
+            seagrass_required_true(
+                    CORAL_RED_BLACK_TREE_ERROR_END_OF_SEQUENCE
+                    == error);
+            return CORAL_RED_BLACK_TREE_CONTAINER_ERROR_ENTRY_NOT_FOUND;
+        }
     }
     struct entry *const A = rock_container_of(node, struct entry, node);
     *out = (struct coral_red_black_tree_container_entry *) &A->data;
     return 0;
 }
 
-int coral_red_black_tree_container_first(
+int coral_red_black_tree_container_floor(
+        const struct coral_red_black_tree_container *const object,
+        const void *const key,
+        struct coral_red_black_tree_container_entry **const out) {
+    if (!object) {
+        return CORAL_RED_BLACK_TREE_CONTAINER_ERROR_OBJECT_IS_NULL;
+    }
+    if (!key) {
+        return CORAL_RED_BLACK_TREE_CONTAINER_ERROR_KEY_IS_NULL;
+    }
+    if (!out) {
+        return CORAL_RED_BLACK_TREE_CONTAINER_ERROR_OUT_IS_NULL;
+    }
+    if (!object->compare) {
+        return CORAL_RED_BLACK_TREE_CONTAINER_ERROR_COMPARE_IS_NULL;
+    }
+    return find_floor(object, key, entity_compare, out);
+}
+
+int coral_red_black_tree_container_floor_key(
+        const struct coral_red_black_tree_container *const object,
+        const void *const key,
+        struct coral_red_black_tree_container_entry **const out) {
+    if (!object) {
+        return CORAL_RED_BLACK_TREE_CONTAINER_ERROR_OBJECT_IS_NULL;
+    }
+    if (!key) {
+        return CORAL_RED_BLACK_TREE_CONTAINER_ERROR_KEY_IS_NULL;
+    }
+    if (!out) {
+        return CORAL_RED_BLACK_TREE_CONTAINER_ERROR_OUT_IS_NULL;
+    }
+    if (!object->compare_key) {
+        return CORAL_RED_BLACK_TREE_CONTAINER_ERROR_COMPARE_IS_NULL;
+    }
+    return find_floor(object, key, key_compare, out);
+}
+
+static int find_higher(
+        const struct coral_red_black_tree_container *const object,
+        const void *const key,
+        int (*const compare)(const void *,
+                             const struct coral_red_black_tree_node *,
+                             void *),
+        struct coral_red_black_tree_container_entry **const out) {
+    int error;
+    struct coral_red_black_tree_node *node;
+    if ((error = find(object, key, compare, &node))) {
+        seagrass_required_true(
+                CORAL_RED_BLACK_TREE_ERROR_NODE_NOT_FOUND
+                == error);
+        if (!node) {
+            return CORAL_RED_BLACK_TREE_CONTAINER_ERROR_ENTRY_NOT_FOUND;
+        }
+        struct entry *const B = rock_container_of(node, struct entry, node);
+        if (compare(key, &B->node, (void *) object) > 0
+            && (error = coral_red_black_tree_next(node, &node))) {
+            seagrass_required_true(
+                    CORAL_RED_BLACK_TREE_ERROR_END_OF_SEQUENCE
+                    == error);
+            return CORAL_RED_BLACK_TREE_CONTAINER_ERROR_ENTRY_NOT_FOUND;
+        }
+    } else if ((error = coral_red_black_tree_next(node, &node))) {
+        seagrass_required_true(
+                CORAL_RED_BLACK_TREE_ERROR_END_OF_SEQUENCE
+                == error);
+        return CORAL_RED_BLACK_TREE_CONTAINER_ERROR_ENTRY_NOT_FOUND;
+    }
+    struct entry *const A = rock_container_of(node, struct entry, node);
+    *out = (struct coral_red_black_tree_container_entry *) &A->data;
+    return 0;
+}
+
+int coral_red_black_tree_container_higher(
+        const struct coral_red_black_tree_container *const object,
+        const void *const key,
+        struct coral_red_black_tree_container_entry **const out) {
+    if (!object) {
+        return CORAL_RED_BLACK_TREE_CONTAINER_ERROR_OBJECT_IS_NULL;
+    }
+    if (!key) {
+        return CORAL_RED_BLACK_TREE_CONTAINER_ERROR_KEY_IS_NULL;
+    }
+    if (!out) {
+        return CORAL_RED_BLACK_TREE_CONTAINER_ERROR_OUT_IS_NULL;
+    }
+    if (!object->compare) {
+        return CORAL_RED_BLACK_TREE_CONTAINER_ERROR_COMPARE_IS_NULL;
+    }
+    return find_higher(object, key, entity_compare, out);
+}
+
+int coral_red_black_tree_container_higher_key(
+        const struct coral_red_black_tree_container *const object,
+        const void *const key,
+        struct coral_red_black_tree_container_entry **const out) {
+    if (!object) {
+        return CORAL_RED_BLACK_TREE_CONTAINER_ERROR_OBJECT_IS_NULL;
+    }
+    if (!key) {
+        return CORAL_RED_BLACK_TREE_CONTAINER_ERROR_KEY_IS_NULL;
+    }
+    if (!out) {
+        return CORAL_RED_BLACK_TREE_CONTAINER_ERROR_OUT_IS_NULL;
+    }
+    if (!object->compare_key) {
+        return CORAL_RED_BLACK_TREE_CONTAINER_ERROR_COMPARE_IS_NULL;
+    }
+    return find_higher(object, key, key_compare, out);
+}
+
+static int find_lower(
+        const struct coral_red_black_tree_container *const object,
+        const void *const key,
+        int (*const compare)(const void *,
+                             const struct coral_red_black_tree_node *,
+                             void *),
+        struct coral_red_black_tree_container_entry **const out) {
+    int error;
+    struct coral_red_black_tree_node *node;
+    if ((error = find(object, key, compare, &node))) {
+        seagrass_required_true(
+                CORAL_RED_BLACK_TREE_ERROR_NODE_NOT_FOUND
+                == error);
+        if (!node) {
+            return CORAL_RED_BLACK_TREE_CONTAINER_ERROR_ENTRY_NOT_FOUND;
+        }
+    }
+    struct entry *const B = rock_container_of(node, struct entry, node);
+    if (compare(key, &B->node, (void *) object) <= 0
+        && (error = coral_red_black_tree_prev(node, &node))) {
+        seagrass_required_true(
+                CORAL_RED_BLACK_TREE_ERROR_END_OF_SEQUENCE
+                == error);
+        return CORAL_RED_BLACK_TREE_CONTAINER_ERROR_ENTRY_NOT_FOUND;
+    }
+    struct entry *const A = rock_container_of(node, struct entry, node);
+    *out = (struct coral_red_black_tree_container_entry *) &A->data;
+    return 0;
+}
+
+int coral_red_black_tree_container_lower(
+        const struct coral_red_black_tree_container *const object,
+        const void *const key,
+        struct coral_red_black_tree_container_entry **const out) {
+    if (!object) {
+        return CORAL_RED_BLACK_TREE_CONTAINER_ERROR_OBJECT_IS_NULL;
+    }
+    if (!key) {
+        return CORAL_RED_BLACK_TREE_CONTAINER_ERROR_KEY_IS_NULL;
+    }
+    if (!out) {
+        return CORAL_RED_BLACK_TREE_CONTAINER_ERROR_OUT_IS_NULL;
+    }
+    if (!object->compare) {
+        return CORAL_RED_BLACK_TREE_CONTAINER_ERROR_COMPARE_IS_NULL;
+    }
+    return find_lower(object, key, entity_compare, out);
+}
+
+int coral_red_black_tree_container_lower_key(
+        const struct coral_red_black_tree_container *const object,
+        const void *const key,
+        struct coral_red_black_tree_container_entry **const out) {
+    if (!object) {
+        return CORAL_RED_BLACK_TREE_CONTAINER_ERROR_OBJECT_IS_NULL;
+    }
+    if (!key) {
+        return CORAL_RED_BLACK_TREE_CONTAINER_ERROR_KEY_IS_NULL;
+    }
+    if (!out) {
+        return CORAL_RED_BLACK_TREE_CONTAINER_ERROR_OUT_IS_NULL;
+    }
+    if (!object->compare_key) {
+        return CORAL_RED_BLACK_TREE_CONTAINER_ERROR_COMPARE_IS_NULL;
+    }
+    return find_lower(object, key, key_compare, out);
+}
+
+int coral_red_black_tree_container_first(
         const struct coral_red_black_tree_container *const object,
         struct coral_red_black_tree_container_entry **const out) {
     if (!object) {
@@ -377,10 +971,10 @@ int coral_red_black_tree_container_first(
         return CORAL_RED_BLACK_TREE_CONTAINER_ERROR_OUT_IS_NULL;
     }
     int error;
-    struct rock_red_black_tree_node *node;
-    if ((error = rock_red_black_tree_first(&object->tree, &node))) {
+    struct coral_red_black_tree_node *node;
+    if ((error = coral_red_black_tree_first(&object->tree, &node))) {
         seagrass_required_true(
-                ROCK_RED_BLACK_TREE_ERROR_TREE_IS_EMPTY
+                CORAL_RED_BLACK_TREE_ERROR_TREE_IS_EMPTY
                 == error);
         return CORAL_RED_BLACK_TREE_CONTAINER_ERROR_CONTAINER_IS_EMPTY;
     }
@@ -399,10 +993,10 @@ int coral_red_black_tree_container_last(
         return CORAL_RED_BLACK_TREE_CONTAINER_ERROR_OUT_IS_NULL;
     }
     int error;
-    struct rock_red_black_tree_node *node;
-    if ((error = rock_red_black_tree_last(&object->tree, &node))) {
+    struct coral_red_black_tree_node *node;
+    if ((error = coral_red_black_tree_last(&object->tree, &node))) {
         seagrass_required_true(
-                ROCK_RED_BLACK_TREE_ERROR_TREE_IS_EMPTY
+                CORAL_RED_BLACK_TREE_ERROR_TREE_IS_EMPTY
                 == error);
         return CORAL_RED_BLACK_TREE_CONTAINER_ERROR_CONTAINER_IS_EMPTY;
     }
@@ -422,10 +1016,10 @@ int coral_red_black_tree_container_next(
     }
     int error;
     struct entry *const A = rock_container_of(entry, struct entry, data);
-    struct rock_red_black_tree_node *node;
-    if ((error = rock_red_black_tree_next(&A->node, &node))) {
+    struct coral_red_black_tree_node *node;
+    if ((error = coral_red_black_tree_next(&A->node, &node))) {
         seagrass_required_true(
-                ROCK_RED_BLACK_TREE_ERROR_END_OF_SEQUENCE
+                CORAL_RED_BLACK_TREE_ERROR_END_OF_SEQUENCE
                 == error);
         return CORAL_RED_BLACK_TREE_CONTAINER_ERROR_END_OF_SEQUENCE;
     }
@@ -445,10 +1039,10 @@ int coral_red_black_tree_container_prev(
     }
     int error;
     struct entry *const A = rock_container_of(entry, struct entry, data);
-    struct rock_red_black_tree_node *node;
-    if ((error = rock_red_black_tree_prev(&A->node, &node))) {
+    struct coral_red_black_tree_node *node;
+    if ((error = coral_red_black_tree_prev(&A->node, &node))) {
         seagrass_required_true(
-                ROCK_RED_BLACK_TREE_ERROR_END_OF_SEQUENCE
+                CORAL_RED_BLACK_TREE_ERROR_END_OF_SEQUENCE
                 == error);
         return CORAL_RED_BLACK_TREE_CONTAINER_ERROR_END_OF_SEQUENCE;
     }
@@ -456,3 +1050,489 @@ int coral_red_black_tree_container_prev(
     *out = (struct coral_red_black_tree_container_entry *) &B->data;
     return 0;
 }
+
+static uintmax_t count_before(
+        const struct coral_red_black_tree_container *const object,
+        const void *const key,
+        int (*const compare)(const void *,
+                             const struct coral_red_black_tree_node *,
+                             void *),
+        bool *const found) {
+    int error;
+    uintmax_t out;
+    if ((error = coral_red_black_tree_count_before(
+            &object->tree, key, compare, (void *) object, &out))) {
+        seagrass_required_true(
+                CORAL_RED_BLACK_TREE_ERROR_NODE_NOT_FOUND
+                == error);
+    }
+    *found = !error;
+    return out;
+}
+
+static uintmax_t count_range(
+        const struct coral_red_black_tree_container *const object,
+        const void *const first,
+        const void *const last,
+        int (*const compare)(const void *,
+                             const struct coral_red_black_tree_node *,
+                             void *)) {
+    bool found;
+    const uintmax_t before = count_before(object, first, compare, &found);
+    const uintmax_t until = count_before(object, last, compare, &found)
+                            + found;
+    return until > before ? until - before : 0;
+}
+
+int coral_red_black_tree_container_rank(
+        const struct coral_red_black_tree_container *const object,
+        const void *const key,
+        uintmax_t *const out) {
+    if (!object) {
+        return CORAL_RED_BLACK_TREE_CONTAINER_ERROR_OBJECT_IS_NULL;
+    }
+    if (!key) {
+        return CORAL_RED_BLACK_TREE_CONTAINER_ERROR_KEY_IS_NULL;
+    }
+    if (!out) {
+        return CORAL_RED_BLACK_TREE_CONTAINER_ERROR_OUT_IS_NULL;
+    }
+    if (!object->compare) {
+        return CORAL_RED_BLACK_TREE_CONTAINER_ERROR_COMPARE_IS_NULL;
+    }
+    bool found;
+    *out = count_before(object, key, entity_compare, &found);
+    return 0;
+}
+
+int coral_red_black_tree_container_rank_key(
+        const struct coral_red_black_tree_container *const object,
+        const void *const key,
+        uintmax_t *const out) {
+    if (!object) {
+        return CORAL_RED_BLACK_TREE_CONTAINER_ERROR_OBJECT_IS_NULL;
+    }
+    if (!key) {
+        return CORAL_RED_BLACK_TREE_CONTAINER_ERROR_KEY_IS_NULL;
+    }
+    if (!out) {
+        return CORAL_RED_BLACK_TREE_CONTAINER_ERROR_OUT_IS_NULL;
+    }
+    if (!object->compare_key) {
+        return CORAL_RED_BLACK_TREE_CONTAINER_ERROR_COMPARE_IS_NULL;
+    }
+    bool found;
+    *out = count_before(object, key, key_compare, &found);
+    return 0;
+}
+
+int coral_red_black_tree_container_count_range(
+        const struct coral_red_black_tree_container *const object,
+        const void *const first,
+        const void *const last,
+        uintmax_t *const out) {
+    if (!object) {
+        return CORAL_RED_BLACK_TREE_CONTAINER_ERROR_OBJECT_IS_NULL;
+    }
+    if (!first || !last) {
+        return CORAL_RED_BLACK_TREE_CONTAINER_ERROR_KEY_IS_NULL;
+    }
+    if (!out) {
+        return CORAL_RED_BLACK_TREE_CONTAINER_ERROR_OUT_IS_NULL;
+    }
+    if (!object->compare) {
+        return CORAL_RED_BLACK_TREE_CONTAINER_ERROR_COMPARE_IS_NULL;
+    }
+    *out = count_range(object, first, last, entity_compare);
+    return 0;
+}
+
+int coral_red_black_tree_container_count_range_key(
+        const struct coral_red_black_tree_container *const object,
+        const void *const first,
+        const void *const last,
+        uintmax_t *const out) {
+    if (!object) {
+        return CORAL_RED_BLACK_TREE_CONTAINER_ERROR_OBJECT_IS_NULL;
+    }
+    if (!first || !last) {
+        return CORAL_RED_BLACK_TREE_CONTAINER_ERROR_KEY_IS_NULL;
+    }
+    if (!out) {
+        return CORAL_RED_BLACK_TREE_CONTAINER_ERROR_OUT_IS_NULL;
+    }
+    if (!object->compare_key) {
+        return CORAL_RED_BLACK_TREE_CONTAINER_ERROR_COMPARE_IS_NULL;
+    }
+    *out = count_range(object, first, last, key_compare);
+    return 0;
+}
+
+int coral_red_black_tree_container_select(
+        const struct coral_red_black_tree_container *const object,
+        const uintmax_t index,
+        struct coral_red_black_tree_container_entry **const out) {
+    if (!object) {
+        return CORAL_RED_BLACK_TREE_CONTAINER_ERROR_OBJECT_IS_NULL;
+    }
+    if (!out) {
+        return CORAL_RED_BLACK_TREE_CONTAINER_ERROR_OUT_IS_NULL;
+    }
+    int error;
+    struct coral_red_black_tree_node *node;
+    if ((error = coral_red_black_tree_select(&object->tree, index, &node))) {
+        seagrass_required_true(
+                CORAL_RED_BLACK_TREE_ERROR_INDEX_IS_OUT_OF_BOUNDS
+                == error);
+        return CORAL_RED_BLACK_TREE_CONTAINER_ERROR_INDEX_IS_OUT_OF_BOUNDS;
+    }
+    struct entry *const A = rock_container_of(node, struct entry, node);
+    *out = (struct coral_red_black_tree_container_entry *) &A->data;
+    return 0;
+}
+
+static void *summary_of(
+        const struct coral_red_black_tree_container *const object,
+        const struct coral_red_black_tree_node *const node) {
+    struct entry *const A = rock_container_of(node, struct entry, node);
+    return A->data + object->summary_offset;
+}
+
+static void aggregate_node(const struct coral_red_black_tree *const tree,
+                           struct coral_red_black_tree_node *const node) {
+    const struct coral_red_black_tree_container *const object
+            = rock_container_of(tree, struct coral_red_black_tree_container,
+                                tree);
+    struct entry *const A = rock_container_of(node, struct entry, node);
+    void *const summary = A->data + object->summary_offset;
+    object->lift(A->data, summary);
+    if (node->left) {
+        object->combine(summary_of(object, node->left), summary, summary);
+    }
+    if (node->right) {
+        object->combine(summary, summary_of(object, node->right), summary);
+    }
+}
+
+int coral_red_black_tree_container_set_aggregate(
+        struct coral_red_black_tree_container *const object,
+        const size_t size,
+        const size_t offset,
+        void (*const lift)(const void *entry, void *out),
+        void (*const combine)(const void *first, const void *second,
+                              void *out)) {
+    if (!object) {
+        return CORAL_RED_BLACK_TREE_CONTAINER_ERROR_OBJECT_IS_NULL;
+    }
+    if (!size) {
+        return CORAL_RED_BLACK_TREE_CONTAINER_ERROR_SIZE_IS_ZERO;
+    }
+    if (!lift || !combine) {
+        return CORAL_RED_BLACK_TREE_CONTAINER_ERROR_AGGREGATE_IS_NULL;
+    }
+    if (object->compare_node) {
+        return CORAL_RED_BLACK_TREE_CONTAINER_ERROR_CONTAINER_IS_INTRUSIVE;
+    }
+    if (object->tree.root) {
+        return CORAL_RED_BLACK_TREE_CONTAINER_ERROR_CONTAINER_IS_NOT_EMPTY;
+    }
+    seagrass_required_true(!coral_red_black_tree_init_augmented(
+            &object->tree, aggregate_node));
+    object->summary_size = size;
+    object->summary_offset = offset;
+    object->lift = lift;
+    object->combine = combine;
+    return 0;
+}
+
+static int aggregate(
+        const struct coral_red_black_tree_container *const object,
+        const void *const first,
+        const void *const last,
+        int (*const compare)(const void *,
+                             const struct coral_red_black_tree_node *,
+                             void *),
+        void *const out) {
+    /* the range hangs off the highest node that lies within it */
+    struct coral_red_black_tree_node *node = object->tree.root;
+    while (node) {
+        if (compare(first, node, (void *) object) > 0) {
+            node = node->right;
+        } else if (compare(last, node, (void *) object) < 0) {
+            node = node->left;
+        } else {
+            break;
+        }
+    }
+    if (!node) {
+        return CORAL_RED_BLACK_TREE_CONTAINER_ERROR_ENTRY_NOT_FOUND;
+    }
+    union {
+        max_align_t alignment;
+        unsigned char data[64];
+    } local;
+    void *scratch = &local;
+    if (object->summary_size > sizeof(local)
+        && !(scratch = malloc(object->summary_size))) {
+        return CORAL_RED_BLACK_TREE_CONTAINER_ERROR_MEMORY_ALLOCATION_FAILED;
+    }
+    struct entry *A = rock_container_of(node, struct entry, node);
+    object->lift(A->data, out);
+    /* entries from first onwards are prepended in descending order */
+    for (struct coral_red_black_tree_node *i = node->left; i;) {
+        if (compare(first, i, (void *) object) > 0) {
+            i = i->right;
+            continue;
+        }
+        if (i->right) {
+            object->combine(summary_of(object, i->right), out, out);
+        }
+        A = rock_container_of(i, struct entry, node);
+        object->lift(A->data, scratch);
+        object->combine(scratch, out, out);
+        i = i->left;
+    }
+    /* entries up to last are appended in ascending order */
+    for (struct coral_red_black_tree_node *i = node->right; i;) {
+        if (compare(last, i, (void *) object) < 0) {
+            i = i->left;
+            continue;
+        }
+        if (i->left) {
+            object->combine(out, summary_of(object, i->left), out);
+        }
+        A = rock_container_of(i, struct entry, node);
+        object->lift(A->data, scratch);
+        object->combine(out, scratch, out);
+        i = i->right;
+    }
+    if (scratch != &local) {
+        free(scratch);
+    }
+    return 0;
+}
+
+int coral_red_black_tree_container_aggregate(
+        const struct coral_red_black_tree_container *const object,
+        const void *const first,
+        const void *const last,
+        void *const out) {
+    if (!object) {
+        return CORAL_RED_BLACK_TREE_CONTAINER_ERROR_OBJECT_IS_NULL;
+    }
+    if (!first || !last) {
+        return CORAL_RED_BLACK_TREE_CONTAINER_ERROR_KEY_IS_NULL;
+    }
+    if (!out) {
+        return CORAL_RED_BLACK_TREE_CONTAINER_ERROR_OUT_IS_NULL;
+    }
+    if (!object->compare) {
+        return CORAL_RED_BLACK_TREE_CONTAINER_ERROR_COMPARE_IS_NULL;
+    }
+    if (!object->combine) {
+        return CORAL_RED_BLACK_TREE_CONTAINER_ERROR_AGGREGATE_IS_NULL;
+    }
+    return aggregate(object, first, last, entity_compare, out);
+}
+
+int coral_red_black_tree_container_aggregate_key(
+        const struct coral_red_black_tree_container *const object,
+        const void *const first,
+        const void *const last,
+        void *const out) {
+    if (!object) {
+        return CORAL_RED_BLACK_TREE_CONTAINER_ERROR_OBJECT_IS_NULL;
+    }
+    if (!first || !last) {
+        return CORAL_RED_BLACK_TREE_CONTAINER_ERROR_KEY_IS_NULL;
+    }
+    if (!out) {
+        return CORAL_RED_BLACK_TREE_CONTAINER_ERROR_OUT_IS_NULL;
+    }
+    if (!object->compare_key) {
+        return CORAL_RED_BLACK_TREE_CONTAINER_ERROR_COMPARE_IS_NULL;
+    }
+    if (!object->combine) {
+        return CORAL_RED_BLACK_TREE_CONTAINER_ERROR_AGGREGATE_IS_NULL;
+    }
+    return aggregate(object, first, last, key_compare, out);
+}
+
+int coral_red_black_tree_container_refresh(
+        struct coral_red_black_tree_container *const object,
+        struct coral_red_black_tree_container_entry *const entry) {
+    if (!object) {
+        return CORAL_RED_BLACK_TREE_CONTAINER_ERROR_OBJECT_IS_NULL;
+    }
+    if (!entry) {
+        return CORAL_RED_BLACK_TREE_CONTAINER_ERROR_ENTRY_IS_NULL;
+    }
+    struct entry *const A = rock_container_of(entry, struct entry, data);
+    seagrass_required_true(!coral_red_black_tree_propagate(
+            &object->tree, &A->node));
+    return 0;
+}
+
+int coral_red_black_tree_container_add_node(
+        struct coral_red_black_tree_container *const object,
+        struct coral_red_black_tree_container_node *const node) {
+    if (!object) {
+        return CORAL_RED_BLACK_TREE_CONTAINER_ERROR_OBJECT_IS_NULL;
+    }
+    if (!node) {
+        return CORAL_RED_BLACK_TREE_CONTAINER_ERROR_NODE_IS_NULL;
+    }
+    return insert(object, node, &node->node, node_compare);
+}
+
+int coral_red_black_tree_container_remove_node(
+        struct coral_red_black_tree_container *const object,
+        struct coral_red_black_tree_container_node *const node) {
+    if (!object) {
+        return CORAL_RED_BLACK_TREE_CONTAINER_ERROR_OBJECT_IS_NULL;
+    }
+    if (!node) {
+        return CORAL_RED_BLACK_TREE_CONTAINER_ERROR_NODE_IS_NULL;
+    }
+    seagrass_required_true(!coral_red_black_tree_remove(
+            &object->tree, &node->node));
+    coral_counters_add(&object->tree, remove, 1);
+    return 0;
+}
+
+static struct coral_red_black_tree_container_node *to_node(
+        const struct coral_red_black_tree_node *const node) {
+    return rock_container_of(node, struct coral_red_black_tree_container_node,
+                             node);
+}
+
+int coral_red_black_tree_container_get_node(
+        const struct coral_red_black_tree_container *const object,
+        const struct coral_red_black_tree_container_node *const key,
+        struct coral_red_black_tree_container_node **const out) {
+    if (!object) {
+        return CORAL_RED_BLACK_TREE_CONTAINER_ERROR_OBJECT_IS_NULL;
+    }
+    if (!key) {
+        return CORAL_RED_BLACK_TREE_CONTAINER_ERROR_KEY_IS_NULL;
+    }
+    if (!out) {
+        return CORAL_RED_BLACK_TREE_CONTAINER_ERROR_OUT_IS_NULL;
+    }
+    int error;
+    struct coral_red_black_tree_node *node;
+    if ((error = find(object, key, node_compare, &node))) {
+        seagrass_required_true(
+                CORAL_RED_BLACK_TREE_ERROR_NODE_NOT_FOUND
+                == error);
+        return CORAL_RED_BLACK_TREE_CONTAINER_ERROR_ENTRY_NOT_FOUND;
+    }
+    *out = to_node(node);
+    return 0;
+}
+
+int coral_red_black_tree_container_first_node(
+        const struct coral_red_black_tree_container *const object,
+        struct coral_red_black_tree_container_node **const out) {
+    if (!object) {
+        return CORAL_RED_BLACK_TREE_CONTAINER_ERROR_OBJECT_IS_NULL;
+    }
+    if (!out) {
+        return CORAL_RED_BLACK_TREE_CONTAINER_ERROR_OUT_IS_NULL;
+    }
+    int error;
+    struct coral_red_black_tree_node *node;
+    if ((error = coral_red_black_tree_first(&object->tree, &node))) {
+        seagrass_required_true(
+                CORAL_RED_BLACK_TREE_ERROR_TREE_IS_EMPTY
+                == error);
+        return CORAL_RED_BLACK_TREE_CONTAINER_ERROR_CONTAINER_IS_EMPTY;
+    }
+    *out = to_node(node);
+    return 0;
+}
+
+int coral_red_black_tree_container_last_node(
+        const struct coral_red_black_tree_container *const object,
+        struct coral_red_black_tree_container_node **const out) {
+    if (!object) {
+        return CORAL_RED_BLACK_TREE_CONTAINER_ERROR_OBJECT_IS_NULL;
+    }
+    if (!out) {
+        return CORAL_RED_BLACK_TREE_CONTAINER_ERROR_OUT_IS_NULL;
+    }
+    int error;
+    struct coral_red_black_tree_node *node;
+    if ((error = coral_red_black_tree_last(&object->tree, &node))) {
+        seagrass_required_true(
+                CORAL_RED_BLACK_TREE_ERROR_TREE_IS_EMPTY
+                == error);
+        return CORAL_RED_BLACK_TREE_CONTAINER_ERROR_CONTAINER_IS_EMPTY;
+    }
+    *out = to_node(node);
+    return 0;
+}
+
+int coral_red_black_tree_container_next_node(
+        const struct coral_red_black_tree_container_node *const node,
+        struct coral_red_black_tree_container_node **const out) {
+    if (!node) {
+        return CORAL_RED_BLACK_TREE_CONTAINER_ERROR_NODE_IS_NULL;
+    }
+    if (!out) {
+        return CORAL_RED_BLACK_TREE_CONTAINER_ERROR_OUT_IS_NULL;
+    }
+    int error;
+    struct coral_red_black_tree_node *next;
+    if ((error = coral_red_black_tree_next(&node->node, &next))) {
+        seagrass_required_true(
+                CORAL_RED_BLACK_TREE_ERROR_END_OF_SEQUENCE
+                == error);
+        return CORAL_RED_BLACK_TREE_CONTAINER_ERROR_END_OF_SEQUENCE;
+    }
+    *out = to_node(next);
+    return 0;
+}
+
+int coral_red_black_tree_container_prev_node(
+        const struct coral_red_black_tree_container_node *const node,
+        struct coral_red_black_tree_container_node **const out) {
+    if (!node) {
+        return CORAL_RED_BLACK_TREE_CONTAINER_ERROR_NODE_IS_NULL;
+    }
+    if (!out) {
+        return CORAL_RED_BLACK_TREE_CONTAINER_ERROR_OUT_IS_NULL;
+    }
+    int error;
+    struct coral_red_black_tree_node *prev;
+    if ((error = coral_red_black_tree_prev(&node->node, &prev))) {
+        seagrass_required_true(
+                CORAL_RED_BLACK_TREE_ERROR_END_OF_SEQUENCE
+                == error);
+        return CORAL_RED_BLACK_TREE_CONTAINER_ERROR_END_OF_SEQUENCE;
+    }
+    *out = to_node(prev);
+    return 0;
+}
+
+int coral_red_black_tree_container_counters(
+        const struct coral_red_black_tree_container *const object,
+        struct coral_counters *const out) {
+    if (!object) {
+        return CORAL_RED_BLACK_TREE_CONTAINER_ERROR_OBJECT_IS_NULL;
+    }
+    if (!out) {
+        return CORAL_RED_BLACK_TREE_CONTAINER_ERROR_OUT_IS_NULL;
+    }
+    coral_counters_snapshot(&object->tree, out);
+    return 0;
+}
+
+int coral_red_black_tree_container_counters_reset(
+        struct coral_red_black_tree_container *const object) {
+    if (!object) {
+        return CORAL_RED_BLACK_TREE_CONTAINER_ERROR_OBJECT_IS_NULL;
+    }
+    coral_counters_reset(&object->tree);
+    return 0;
+}
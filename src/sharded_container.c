@@ -0,0 +1,319 @@
+#include <stdlib.h>
+#include <limits.h>
+#include <seagrass.h>
+#include <coral.h>
+
+#ifdef TEST
+#include <test/cmocka.h>
+#endif
+
+#define CACHE_LINE 64
+
+static int init(struct coral_sharded_container *const object,
+                const size_t count) {
+    void *shards;
+    if (posix_memalign(&shards, CACHE_LINE,
+                       count * sizeof(struct coral_sharded_container_shard))) {
+        return CORAL_SHARDED_CONTAINER_ERROR_MEMORY_ALLOCATION_FAILED;
+    }
+    object->shards = shards;
+    for (size_t i = 0; i < count; i++) {
+        struct coral_sharded_container_shard *const shard
+                = &object->shards[i];
+        if (pthread_mutex_init(&shard->mutex, NULL)) {
+            while (i--) {
+                seagrass_required_true(!pthread_mutex_destroy(
+                        &object->shards[i].mutex));
+            }
+            free(shards);
+            object->shards = NULL;
+            return CORAL_SHARDED_CONTAINER_ERROR_MEMORY_ALLOCATION_FAILED;
+        }
+        seagrass_required_true(!coral_red_black_tree_container_init(
+                &shard->container, object->compare));
+    }
+    object->count = count;
+    return 0;
+}
+
+int coral_sharded_container_init_with_hash(
+        struct coral_sharded_container *const object,
+        const size_t shards,
+        size_t (*const hash)(const void *entry),
+        int (*const compare)(const void *first,
+                             const void *second)) {
+    if (!object) {
+        return CORAL_SHARDED_CONTAINER_ERROR_OBJECT_IS_NULL;
+    }
+    if (!shards) {
+        return CORAL_SHARDED_CONTAINER_ERROR_SHARDS_IS_ZERO;
+    }
+    if (!hash) {
+        return CORAL_SHARDED_CONTAINER_ERROR_HASH_IS_NULL;
+    }
+    if (!compare) {
+        return CORAL_SHARDED_CONTAINER_ERROR_COMPARE_IS_NULL;
+    }
+    *object = (struct coral_sharded_container) {
+            .compare = compare,
+            .hash = hash
+    };
+    return init(object, shards);
+}
+
+int coral_sharded_container_init_with_bounds(
+        struct coral_sharded_container *const object,
+        const void *const *const bounds,
+        const size_t count,
+        int (*const compare)(const void *first,
+                             const void *second)) {
+    if (!object) {
+        return CORAL_SHARDED_CONTAINER_ERROR_OBJECT_IS_NULL;
+    }
+    if (!bounds && count) {
+        return CORAL_SHARDED_CONTAINER_ERROR_BOUNDS_IS_NULL;
+    }
+    if (!compare) {
+        return CORAL_SHARDED_CONTAINER_ERROR_COMPARE_IS_NULL;
+    }
+    for (size_t i = 1; i < count; i++) {
+        if (compare(bounds[i - 1], bounds[i]) >= 0) {
+            return CORAL_SHARDED_CONTAINER_ERROR_BOUNDS_ARE_NOT_SORTED;
+        }
+    }
+    *object = (struct coral_sharded_container) {
+            .compare = compare,
+            .bounds = bounds
+    };
+    return init(object, count + 1);
+}
+
+int coral_sharded_container_invalidate(
+        struct coral_sharded_container *const object,
+        void (*const on_destroy)(
+                struct coral_red_black_tree_container_entry *entry)) {
+    if (!object) {
+        return CORAL_SHARDED_CONTAINER_ERROR_OBJECT_IS_NULL;
+    }
+    for (size_t i = 0; i < object->count; i++) {
+        struct coral_sharded_container_shard *const shard
+                = &object->shards[i];
+        seagrass_required_true(!coral_red_black_tree_container_invalidate(
+                &shard->container, on_destroy));
+        seagrass_required_true(!pthread_mutex_destroy(&shard->mutex));
+    }
+    free(object->shards);
+    *object = (struct coral_sharded_container) {0};
+    return 0;
+}
+
+/* Hashes such as the identity of an integer key are spread over the shards
+ * by taking the upper bits of their product with the golden ratio. */
+static size_t mix(const size_t hash) {
+    const size_t mixed = hash * (size_t) UINT64_C(0x9e3779b97f4a7c15);
+    return mixed ^ (mixed >> (sizeof(size_t) * CHAR_BIT / 2));
+}
+
+static struct coral_sharded_container_shard *shard_of(
+        const struct coral_sharded_container *const object,
+        const void *const key) {
+    size_t i;
+    if (object->hash) {
+        i = mix(object->hash(key)) % object->count;
+    } else {
+        /* count the bounds at or before key */
+        size_t low = 0;
+        size_t high = object->count - 1;
+        while (low < high) {
+            const size_t middle = low + (high - low) / 2;
+            if (object->compare(object->bounds[middle], key) <= 0) {
+                low = middle + 1;
+            } else {
+                high = middle;
+            }
+        }
+        i = low;
+    }
+    return &object->shards[i];
+}
+
+static void lock(struct coral_sharded_container_shard *const shard) {
+    seagrass_required_true(!pthread_mutex_lock(&shard->mutex));
+}
+
+static void unlock(struct coral_sharded_container_shard *const shard) {
+    seagrass_required_true(!pthread_mutex_unlock(&shard->mutex));
+}
+
+int coral_sharded_container_count(
+        const struct coral_sharded_container *const object,
+        uintmax_t *const out) {
+    if (!object) {
+        return CORAL_SHARDED_CONTAINER_ERROR_OBJECT_IS_NULL;
+    }
+    if (!out) {
+        return CORAL_SHARDED_CONTAINER_ERROR_OUT_IS_NULL;
+    }
+    uintmax_t total = 0;
+    for (size_t i = 0; i < object->count; i++) {
+        struct coral_sharded_container_shard *const shard
+                = &object->shards[i];
+        uintmax_t count;
+        lock(shard);
+        seagrass_required_true(!coral_red_black_tree_container_count(
+                &shard->container, &count));
+        unlock(shard);
+        total += count;
+    }
+    *out = total;
+    return 0;
+}
+
+int coral_sharded_container_add(
+        struct coral_sharded_container *const object,
+        const struct coral_red_black_tree_container_entry *const entry) {
+    if (!object) {
+        return CORAL_SHARDED_CONTAINER_ERROR_OBJECT_IS_NULL;
+    }
+    if (!entry) {
+        return CORAL_SHARDED_CONTAINER_ERROR_ENTRY_IS_NULL;
+    }
+    struct coral_sharded_container_shard *const shard
+            = shard_of(object, entry);
+    lock(shard);
+    const int error = coral_red_black_tree_container_add(
+            &shard->container, entry);
+    unlock(shard);
+    return error;
+}
+
+int coral_sharded_container_remove(
+        struct coral_sharded_container *const object,
+        const struct coral_red_black_tree_container_entry *const entry) {
+    if (!object) {
+        return CORAL_SHARDED_CONTAINER_ERROR_OBJECT_IS_NULL;
+    }
+    if (!entry) {
+        return CORAL_SHARDED_CONTAINER_ERROR_ENTRY_IS_NULL;
+    }
+    struct coral_sharded_container_shard *const shard
+            = shard_of(object, entry);
+    /* only remove an entry that is still a member, another thread may
+     * have removed it since it was handed out */
+    struct coral_red_black_tree_container_entry *found;
+    lock(shard);
+    int error = coral_red_black_tree_container_get(
+            &shard->container, entry, &found);
+    if (!error) {
+        error = entry != found
+                ? CORAL_SHARDED_CONTAINER_ERROR_ENTRY_NOT_FOUND
+                : coral_red_black_tree_container_remove(
+                        &shard->container, entry);
+    }
+    unlock(shard);
+    return error;
+}
+
+int coral_sharded_container_get(
+        const struct coral_sharded_container *const object,
+        const void *const key,
+        struct coral_red_black_tree_container_entry **const out) {
+    if (!object) {
+        return CORAL_SHARDED_CONTAINER_ERROR_OBJECT_IS_NULL;
+    }
+    if (!key) {
+        return CORAL_SHARDED_CONTAINER_ERROR_KEY_IS_NULL;
+    }
+    if (!out) {
+        return CORAL_SHARDED_CONTAINER_ERROR_OUT_IS_NULL;
+    }
+    struct coral_sharded_container_shard *const shard
+            = shard_of(object, key);
+    lock(shard);
+    const int error = coral_red_black_tree_container_get(
+            &shard->container, key, out);
+    unlock(shard);
+    return error;
+}
+
+/* Restore the heap order below i, the smallest entry being at the top. */
+static void sift_down(const struct coral_sharded_container *const object,
+                      struct coral_red_black_tree_container_entry **const heap,
+                      const size_t count,
+                      size_t i) {
+    struct coral_red_black_tree_container_entry *const entry = heap[i];
+    for (size_t child; (child = 2 * i + 1) < count; i = child) {
+        if (child + 1 < count
+            && object->compare(heap[child + 1], heap[child]) < 0) {
+            child++;
+        }
+        if (object->compare(entry, heap[child]) <= 0) {
+            break;
+        }
+        heap[i] = heap[child];
+    }
+    heap[i] = entry;
+}
+
+static int merge(const struct coral_sharded_container *const object,
+                 struct coral_red_black_tree_container_entry **const heap,
+                 int (*const function)(
+                         struct coral_red_black_tree_container_entry *entry,
+                         void *context),
+                 void *const context) {
+    size_t count = 0;
+    for (size_t i = 0; i < object->count; i++) {
+        if (!coral_red_black_tree_container_first(
+                &object->shards[i].container, &heap[count])) {
+            count++;
+        }
+    }
+    for (size_t i = count / 2; i--;) {
+        sift_down(object, heap, count, i);
+    }
+    while (count) {
+        struct coral_red_black_tree_container_entry *const entry = heap[0];
+        int error;
+        if ((error = function(entry, context))) {
+            return error;
+        }
+        /* the next entry of a shard never orders before its current one */
+        if (coral_red_black_tree_container_next(entry, &heap[0])) {
+            heap[0] = heap[--count];
+        }
+        if (count) {
+            sift_down(object, heap, count, 0);
+        }
+    }
+    return 0;
+}
+
+int coral_sharded_container_for_each(
+        const struct coral_sharded_container *const object,
+        int (*const function)(
+                struct coral_red_black_tree_container_entry *entry,
+                void *context),
+        void *const context) {
+    if (!object) {
+        return CORAL_SHARDED_CONTAINER_ERROR_OBJECT_IS_NULL;
+    }
+    if (!function) {
+        return CORAL_SHARDED_CONTAINER_ERROR_FUNCTION_IS_NULL;
+    }
+    struct coral_red_black_tree_container_entry **const heap = malloc(
+            object->count * sizeof(*heap));
+    if (!heap) {
+        return CORAL_SHARDED_CONTAINER_ERROR_MEMORY_ALLOCATION_FAILED;
+    }
+    /* shards are always locked in the same order so that concurrent calls
+     * cannot deadlock */
+    for (size_t i = 0; i < object->count; i++) {
+        lock(&object->shards[i]);
+    }
+    const int error = merge(object, heap, function, context);
+    for (size_t i = object->count; i--;) {
+        unlock(&object->shards[i]);
+    }
+    free(heap);
+    return error;
+}
@@ -0,0 +1,29 @@
+#ifndef _CORAL_TEST_STATISTICS_ALLOCATOR_H_
+#define _CORAL_TEST_STATISTICS_ALLOCATOR_H_
+
+#include <stdint.h>
+#include <stdlib.h>
+
+/*
+ * Allocator for the unit tests which counts the allocations and frees made
+ * through it, pass a struct statistics as its context.
+ */
+struct statistics {
+    uintmax_t alloc;
+    uintmax_t free;
+};
+
+static int statistics_alloc(void *context, size_t alignment, size_t size,
+                            void **out) {
+    struct statistics *const statistics = context;
+    statistics->alloc++;
+    return posix_memalign(out, alignment, size);
+}
+
+static void statistics_free(void *context, void *memory) {
+    struct statistics *const statistics = context;
+    statistics->free++;
+    free(memory);
+}
+
+#endif /* _CORAL_TEST_STATISTICS_ALLOCATOR_H_ */
@@ -0,0 +1,87 @@
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <setjmp.h>
+#include <stdlib.h>
+#include <cmocka.h>
+#include <coral.h>
+
+#include <test/cmocka.h>
+
+#include "statistics_allocator.h"
+
+static void check_get_default_error_on_out_is_null(void **state) {
+    assert_int_equal(
+            coral_allocator_get_default(NULL),
+            CORAL_ALLOCATOR_ERROR_OUT_IS_NULL);
+}
+
+static void check_get_default(void **state) {
+    const struct coral_allocator *allocator = NULL;
+    assert_int_equal(coral_allocator_get_default(&allocator), 0);
+    assert_non_null(allocator);
+    assert_non_null(allocator->alloc);
+    assert_non_null(allocator->free);
+    void *memory;
+    assert_int_equal(allocator->alloc(allocator->context, sizeof(void *),
+                                      1, &memory), 0);
+    allocator->free(allocator->context, memory);
+}
+
+static void check_set_default_error_on_alloc_is_null(void **state) {
+    const struct coral_allocator allocator = {
+            .free = statistics_free
+    };
+    assert_int_equal(
+            coral_allocator_set_default(&allocator),
+            CORAL_ALLOCATOR_ERROR_ALLOC_IS_NULL);
+}
+
+static void check_set_default_error_on_free_is_null(void **state) {
+    const struct coral_allocator allocator = {
+            .alloc = statistics_alloc
+    };
+    assert_int_equal(
+            coral_allocator_set_default(&allocator),
+            CORAL_ALLOCATOR_ERROR_FREE_IS_NULL);
+}
+
+static void check_set_default(void **state) {
+    const struct coral_allocator *system;
+    assert_int_equal(coral_allocator_get_default(&system), 0);
+    struct statistics statistics = {};
+    const struct coral_allocator allocator = {
+            .alloc = statistics_alloc,
+            .free = statistics_free,
+            .context = &statistics
+    };
+    assert_int_equal(coral_allocator_set_default(&allocator), 0);
+    const struct coral_allocator *out;
+    assert_int_equal(coral_allocator_get_default(&out), 0);
+    assert_ptr_equal(out, &allocator);
+    struct coral_red_black_tree_container_entry *entry;
+    assert_int_equal(coral_red_black_tree_container_alloc(1, &entry), 0);
+    struct coral_linked_list_item *item;
+    assert_int_equal(coral_linked_list_alloc(1, &item), 0);
+    assert_int_equal(statistics.alloc, 2);
+    /* restore the system allocator */
+    assert_int_equal(coral_allocator_set_default(NULL), 0);
+    assert_int_equal(coral_allocator_get_default(&out), 0);
+    assert_ptr_equal(out, system);
+    /* memory is returned to the allocator it came from */
+    assert_int_equal(coral_red_black_tree_container_free(entry), 0);
+    assert_int_equal(coral_linked_list_free(item), 0);
+    assert_int_equal(statistics.free, 2);
+}
+
+int main(int argc, char *argv[]) {
+    const struct CMUnitTest tests[] = {
+            cmocka_unit_test(check_get_default_error_on_out_is_null),
+            cmocka_unit_test(check_get_default),
+            cmocka_unit_test(check_set_default_error_on_alloc_is_null),
+            cmocka_unit_test(check_set_default_error_on_free_is_null),
+            cmocka_unit_test(check_set_default),
+    };
+    //cmocka_set_message_output(CM_OUTPUT_XML);
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
@@ -0,0 +1,170 @@
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <setjmp.h>
+#include <cmocka.h>
+#include <coral.h>
+
+#include <test/cmocka.h>
+
+static void check_init_error_on_object_is_null(void **state) {
+    assert_int_equal(
+            coral_arena_init(NULL, 1),
+            CORAL_ARENA_ERROR_OBJECT_IS_NULL);
+}
+
+static void check_init_error_on_size_is_zero(void **state) {
+    assert_int_equal(
+            coral_arena_init((void *) 1, 0),
+            CORAL_ARENA_ERROR_SIZE_IS_ZERO);
+}
+
+static void check_init_error_on_size_is_too_large(void **state) {
+    assert_int_equal(
+            coral_arena_init((void *) 1, SIZE_MAX),
+            CORAL_ARENA_ERROR_SIZE_IS_TOO_LARGE);
+}
+
+static void check_init(void **state) {
+    struct coral_arena object;
+    assert_int_equal(coral_arena_init(&object, 64), 0);
+    assert_int_equal(object.size, 64);
+    assert_null(object.chunks);
+    assert_int_equal(coral_arena_invalidate(&object), 0);
+}
+
+static void check_invalidate_error_on_object_is_null(void **state) {
+    assert_int_equal(
+            coral_arena_invalidate(NULL),
+            CORAL_ARENA_ERROR_OBJECT_IS_NULL);
+}
+
+static void check_invalidate(void **state) {
+    struct coral_arena object;
+    assert_int_equal(coral_arena_init(&object, 64), 0);
+    void *memory;
+    for (uintmax_t i = 0; i < 32; i++) {
+        assert_int_equal(coral_arena_alloc(
+                &object, sizeof(void *), 24, &memory), 0);
+    }
+    assert_int_equal(coral_arena_invalidate(&object), 0);
+    assert_null(object.chunks);
+}
+
+static void check_alloc_error_on_object_is_null(void **state) {
+    assert_int_equal(
+            coral_arena_alloc(NULL, sizeof(void *), 1, (void *) 1),
+            CORAL_ARENA_ERROR_OBJECT_IS_NULL);
+}
+
+static void check_alloc_error_on_out_is_null(void **state) {
+    assert_int_equal(
+            coral_arena_alloc((void *) 1, sizeof(void *), 1, NULL),
+            CORAL_ARENA_ERROR_OUT_IS_NULL);
+}
+
+static void check_alloc_error_on_size_is_zero(void **state) {
+    assert_int_equal(
+            coral_arena_alloc((void *) 1, sizeof(void *), 0, (void *) 1),
+            CORAL_ARENA_ERROR_SIZE_IS_ZERO);
+}
+
+static void check_alloc_error_on_size_is_too_large(void **state) {
+    struct coral_arena object;
+    assert_int_equal(coral_arena_init(&object, 64), 0);
+    void *memory;
+    assert_int_equal(
+            coral_arena_alloc(&object, sizeof(void *), SIZE_MAX, &memory),
+            CORAL_ARENA_ERROR_SIZE_IS_TOO_LARGE);
+    assert_int_equal(coral_arena_invalidate(&object), 0);
+}
+
+static void check_alloc_error_on_memory_allocation_failed(void **state) {
+    struct coral_arena object;
+    assert_int_equal(coral_arena_init(&object, 64), 0);
+    malloc_is_overridden = calloc_is_overridden = realloc_is_overridden
+            = posix_memalign_is_overridden = true;
+    void *memory;
+    assert_int_equal(
+            coral_arena_alloc(&object, sizeof(void *), 1, &memory),
+            CORAL_ARENA_ERROR_MEMORY_ALLOCATION_FAILED);
+    malloc_is_overridden = calloc_is_overridden = realloc_is_overridden
+            = posix_memalign_is_overridden = false;
+    assert_int_equal(coral_arena_invalidate(&object), 0);
+}
+
+static void check_alloc(void **state) {
+    struct coral_arena object;
+    assert_int_equal(coral_arena_init(&object, 64), 0);
+    unsigned char *a, *b;
+    assert_int_equal(coral_arena_alloc(
+            &object, sizeof(void *), 3, (void **) &a), 0);
+    assert_int_equal(coral_arena_alloc(
+            &object, sizeof(void *), 8, (void **) &b), 0);
+    /* allocations are bumped through the same chunk */
+    assert_ptr_equal(a + sizeof(void *), b);
+    assert_int_equal((uintptr_t) b % sizeof(void *), 0);
+    assert_int_equal(coral_arena_invalidate(&object), 0);
+}
+
+static void check_alloc_case_oversized(void **state) {
+    struct coral_arena object;
+    assert_int_equal(coral_arena_init(&object, 64), 0);
+    unsigned char *a, *b, *c;
+    assert_int_equal(coral_arena_alloc(
+            &object, sizeof(void *), 8, (void **) &a), 0);
+    assert_int_equal(coral_arena_alloc(
+            &object, sizeof(void *), 1024, (void **) &b), 0);
+    /* the current chunk is still used after an oversized allocation */
+    assert_int_equal(coral_arena_alloc(
+            &object, sizeof(void *), 8, (void **) &c), 0);
+    assert_ptr_equal(a + 8, c);
+    assert_int_equal(coral_arena_invalidate(&object), 0);
+}
+
+static void check_allocator_error_on_object_is_null(void **state) {
+    assert_int_equal(
+            coral_arena_allocator(NULL, (void *) 1),
+            CORAL_ARENA_ERROR_OBJECT_IS_NULL);
+}
+
+static void check_allocator_error_on_out_is_null(void **state) {
+    assert_int_equal(
+            coral_arena_allocator((void *) 1, NULL),
+            CORAL_ARENA_ERROR_OUT_IS_NULL);
+}
+
+static void check_allocator(void **state) {
+    struct coral_arena object;
+    assert_int_equal(coral_arena_init(&object, 256), 0);
+    struct coral_allocator allocator;
+    assert_int_equal(coral_arena_allocator(&object, &allocator), 0);
+    struct coral_red_black_tree_container_entry *entry;
+    assert_int_equal(coral_red_black_tree_container_alloc_with(
+            &allocator, 8, &entry), 0);
+    assert_int_equal(coral_red_black_tree_container_free(entry), 0);
+    assert_int_equal(coral_arena_invalidate(&object), 0);
+}
+
+int main(int argc, char *argv[]) {
+    const struct CMUnitTest tests[] = {
+            cmocka_unit_test(check_init_error_on_object_is_null),
+            cmocka_unit_test(check_init_error_on_size_is_zero),
+            cmocka_unit_test(check_init_error_on_size_is_too_large),
+            cmocka_unit_test(check_init),
+            cmocka_unit_test(check_invalidate_error_on_object_is_null),
+            cmocka_unit_test(check_invalidate),
+            cmocka_unit_test(check_alloc_error_on_object_is_null),
+            cmocka_unit_test(check_alloc_error_on_out_is_null),
+            cmocka_unit_test(check_alloc_error_on_size_is_zero),
+            cmocka_unit_test(check_alloc_error_on_size_is_too_large),
+            cmocka_unit_test(check_alloc_error_on_memory_allocation_failed),
+            cmocka_unit_test(check_alloc),
+            cmocka_unit_test(check_alloc_case_oversized),
+            cmocka_unit_test(check_allocator_error_on_object_is_null),
+            cmocka_unit_test(check_allocator_error_on_out_is_null),
+            cmocka_unit_test(check_allocator),
+    };
+    //cmocka_set_message_output(CM_OUTPUT_XML);
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
@@ -0,0 +1,1500 @@
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <setjmp.h>
+#include <stdlib.h>
+#include <cmocka.h>
+#include <coral.h>
+#include <seagrass.h>
+
+#include <test/cmocka.h>
+
+#include "statistics_allocator.h"
+
+static void check_free_error_on_entry_is_null(void **state) {
+    assert_int_equal(
+            coral_btree_container_free(NULL),
+            CORAL_BTREE_CONTAINER_ERROR_ENTRY_IS_NULL);
+}
+
+static void check_free(void **state) {
+    struct coral_btree_container_entry *entry;
+    assert_int_equal(coral_btree_container_alloc(1, &entry), 0);
+    assert_int_equal(coral_btree_container_free(entry), 0);
+}
+
+static void check_alloc_error_on_size_is_zero(void **state) {
+    assert_int_equal(
+            coral_btree_container_alloc(0, (void *) 1),
+            CORAL_BTREE_CONTAINER_ERROR_SIZE_IS_ZERO);
+}
+
+static void check_alloc_error_on_out_is_null(void **state) {
+    assert_int_equal(
+            coral_btree_container_alloc(1, NULL),
+            CORAL_BTREE_CONTAINER_ERROR_OUT_IS_NULL);
+}
+
+static void check_alloc(void **state) {
+    struct coral_btree_container_entry *entry;
+    assert_int_equal(coral_btree_container_alloc(1, &entry), 0);
+    assert_int_equal(coral_btree_container_free(entry), 0);
+}
+
+static void check_alloc_error_on_size_is_too_large(void **state) {
+    assert_int_equal(
+            coral_btree_container_alloc(UINTMAX_MAX, (void *) 1),
+            CORAL_BTREE_CONTAINER_ERROR_SIZE_IS_TOO_LARGE);
+}
+
+static void check_alloc_error_on_memory_allocation_failed(void **state) {
+    malloc_is_overridden = calloc_is_overridden = realloc_is_overridden
+            = posix_memalign_is_overridden = true;
+    assert_int_equal(
+            coral_btree_container_alloc(1, (void *) 1),
+            CORAL_BTREE_CONTAINER_ERROR_MEMORY_ALLOCATION_FAILED);
+    malloc_is_overridden = calloc_is_overridden = realloc_is_overridden
+            = posix_memalign_is_overridden = false;
+}
+
+static void check_alloc_with(void **state) {
+    struct statistics statistics = {};
+    const struct coral_allocator allocator = {
+            .alloc = statistics_alloc,
+            .free = statistics_free,
+            .context = &statistics
+    };
+    struct coral_btree_container_entry *entry;
+    assert_int_equal(coral_btree_container_alloc_with(
+            &allocator, 1, &entry), 0);
+    assert_int_equal(statistics.alloc, 1);
+    assert_int_equal(coral_btree_container_free(entry), 0);
+    assert_int_equal(statistics.free, 1);
+}
+
+static void check_invalidate_error_on_object_is_null(void **state) {
+    assert_int_equal(
+            coral_btree_container_invalidate(NULL, (void *) 1),
+            CORAL_BTREE_CONTAINER_ERROR_OBJECT_IS_NULL);
+}
+
+static void check_invalidate(void **state) {
+    struct coral_btree_container object = {};
+    assert_int_equal(coral_btree_container_invalidate(
+            &object, NULL), 0);
+}
+
+static void check_init_error_on_object_is_null(void **state) {
+    assert_int_equal(
+            coral_btree_container_init(NULL, (void *) 1),
+            CORAL_BTREE_CONTAINER_ERROR_OBJECT_IS_NULL);
+}
+
+static void check_init_error_on_compare_is_null(void **state) {
+    assert_int_equal(
+            coral_btree_container_init((void *) 1, NULL),
+            CORAL_BTREE_CONTAINER_ERROR_COMPARE_IS_NULL);
+}
+
+static void check_init(void **state) {
+    srand(time(NULL));
+    const uintmax_t check = rand();
+    struct coral_btree_container object;
+    assert_int_equal(coral_btree_container_init(
+            &object, (void *) check), 0);
+    assert_int_equal(check, object.compare);
+    assert_int_equal(coral_btree_container_invalidate(
+            &object, NULL), 0);
+}
+
+static void check_count_error_on_object_is_null(void **state) {
+    assert_int_equal(
+            coral_btree_container_count(NULL, (void *) 1),
+            CORAL_BTREE_CONTAINER_ERROR_OBJECT_IS_NULL);
+}
+
+static void check_count_error_on_out_is_null(void **state) {
+    assert_int_equal(
+            coral_btree_container_count((void *) 1, NULL),
+            CORAL_BTREE_CONTAINER_ERROR_OUT_IS_NULL);
+}
+
+static void check_count(void **state) {
+    srand(time(NULL));
+    uintmax_t check = rand();
+    struct coral_btree_container object = {
+            .count = check
+    };
+    uintmax_t count;
+    assert_int_equal(coral_btree_container_count(
+            &object, &count), 0);
+    assert_int_equal(check, count);
+}
+
+static void check_add_error_on_object_is_null(void **state) {
+    assert_int_equal(
+            coral_btree_container_add(NULL, (void *) 1),
+            CORAL_BTREE_CONTAINER_ERROR_OBJECT_IS_NULL);
+}
+
+static void check_add_error_on_entry_is_null(void **state) {
+    assert_int_equal(
+            coral_btree_container_add((void *) 1, NULL),
+            CORAL_BTREE_CONTAINER_ERROR_ENTRY_IS_NULL);
+}
+
+static int compare(const void *a, const void *b) {
+    return seagrass_uintmax_t_ptr_compare(a, b);
+}
+
+static void check_add(void **state) {
+    struct coral_btree_container object;
+    assert_int_equal(coral_btree_container_init(&object, compare), 0);
+    union entry {
+        struct coral_btree_container_entry *entry;
+        uintmax_t *value;
+    } item;
+    assert_int_equal(coral_btree_container_alloc(
+            sizeof(*item.value), &item.entry), 0);
+    *item.value = 0;
+    assert_int_equal(coral_btree_container_add(
+            &object, item.entry), 0);
+    assert_int_equal(0, *item.value);
+    uintmax_t count;
+    assert_int_equal(coral_btree_container_count(
+            &object, &count), 0);
+    assert_int_equal(1, count);
+    assert_int_equal(coral_btree_container_invalidate(
+            &object, NULL), 0);
+}
+
+static void check_add_error_on_entry_already_exits(void **state) {
+    struct coral_btree_container object;
+    assert_int_equal(coral_btree_container_init(
+            &object, compare), 0);
+    union entry {
+        struct coral_btree_container_entry *entry;
+        uintmax_t *value;
+    } item;
+    assert_int_equal(coral_btree_container_alloc(
+            sizeof(*item.value), &item.entry), 0);
+    *item.value = 0;
+    assert_int_equal(
+            coral_btree_container_add(&object, item.entry), 0);
+    assert_int_equal(
+            coral_btree_container_add(&object, item.entry),
+            CORAL_BTREE_CONTAINER_ERROR_ENTRY_ALREADY_EXISTS);
+    assert_int_equal(coral_btree_container_invalidate(
+            &object, NULL), 0);
+}
+
+static void check_remove_error_on_object_is_null(void **state) {
+    assert_int_equal(
+            coral_btree_container_remove(NULL, (void *) 1),
+            CORAL_BTREE_CONTAINER_ERROR_OBJECT_IS_NULL);
+}
+
+static void check_remove_error_on_entry_is_null(void **state) {
+    assert_int_equal(
+            coral_btree_container_remove((void *) 1, NULL),
+            CORAL_BTREE_CONTAINER_ERROR_ENTRY_IS_NULL);
+}
+
+static void check_remove(void **state) {
+    struct coral_btree_container object;
+    assert_int_equal(coral_btree_container_init(&object, compare), 0);
+    union entry {
+        struct coral_btree_container_entry *entry;
+        uintmax_t *value;
+    } item;
+    assert_int_equal(coral_btree_container_alloc(
+            sizeof(*item.value), &item.entry), 0);
+    *item.value = 0;
+    assert_int_equal(coral_btree_container_add(
+            &object, item.entry), 0);
+    uintmax_t count;
+    assert_int_equal(coral_btree_container_count(
+            &object, &count), 0);
+    assert_int_equal(1, count);
+    assert_int_equal(coral_btree_container_remove(
+            &object, item.entry), 0);
+    assert_int_equal(coral_btree_container_count(
+            &object, &count), 0);
+    assert_int_equal(0, count);
+    assert_int_equal(coral_btree_container_free(
+            item.entry), 0);
+    assert_int_equal(coral_btree_container_invalidate(
+            &object, NULL), 0);
+}
+
+static void check_get_error_on_object_is_null(void **state) {
+    assert_int_equal(
+            coral_btree_container_get(NULL, (void *) 1, (void *) 1),
+            CORAL_BTREE_CONTAINER_ERROR_OBJECT_IS_NULL);
+}
+
+static void check_get_error_on_key_is_null(void **state) {
+    assert_int_equal(
+            coral_btree_container_get((void *) 1, NULL, (void *) 1),
+            CORAL_BTREE_CONTAINER_ERROR_KEY_IS_NULL);
+}
+
+static void check_get_error_on_out_is_null(void **state) {
+    assert_int_equal(
+            coral_btree_container_get((void *) 1, (void *) 1, NULL),
+            CORAL_BTREE_CONTAINER_ERROR_OUT_IS_NULL);
+}
+
+static void check_get(void **state) {
+    struct coral_btree_container object;
+    assert_int_equal(coral_btree_container_init(&object, compare), 0);
+    const uintmax_t count = 3;
+    union entry {
+        struct coral_btree_container_entry *entry;
+        uintmax_t *value;
+    } item[count];
+    for (uintmax_t i = 0; i < count; i++) {
+        assert_int_equal(coral_btree_container_alloc(
+                sizeof(uintmax_t), &item[i].entry), 0);
+        *item[i].value = i;
+        assert_int_equal(coral_btree_container_add(
+                &object, item[i].entry), 0);
+    }
+    const uintmax_t key = *item[1].value;
+    union entry other;
+    assert_int_equal(coral_btree_container_get(
+            &object, &key, &other.entry), 0);
+    assert_int_equal(*item[1].value, *other.value);
+    assert_ptr_equal(item[1].entry, other.entry);
+    assert_int_equal(coral_btree_container_invalidate(
+            &object, NULL), 0);
+}
+
+static void check_get_error_on_entry_not_found(void **state) {
+    struct coral_btree_container object;
+    assert_int_equal(coral_btree_container_init(&object, compare), 0);
+    const uintmax_t count = 3;
+    union entry {
+        struct coral_btree_container_entry *entry;
+        uintmax_t *value;
+    } item[count];
+    for (uintmax_t i = 0; i < count; i++) {
+        assert_int_equal(coral_btree_container_alloc(
+                sizeof(uintmax_t), &item[i].entry), 0);
+        *item[i].value = i;
+        assert_int_equal(coral_btree_container_add(
+                &object, item[i].entry), 0);
+    }
+    const uintmax_t key = UINTMAX_MAX;
+    union entry other;
+    assert_int_equal(
+            coral_btree_container_get(&object, &key, &other.entry),
+            CORAL_BTREE_CONTAINER_ERROR_ENTRY_NOT_FOUND);
+    assert_int_equal(coral_btree_container_invalidate(
+            &object, NULL), 0);
+}
+
+static void check_ceiling_error_on_object_is_null(void **state) {
+    assert_int_equal(
+            coral_btree_container_ceiling(
+                    NULL, (void *) 1, (void *) 1),
+            CORAL_BTREE_CONTAINER_ERROR_OBJECT_IS_NULL);
+}
+
+static void check_ceiling_error_on_key_is_null(void **state) {
+    assert_int_equal(
+            coral_btree_container_ceiling(
+                    (void *) 1, NULL, (void *) 1),
+            CORAL_BTREE_CONTAINER_ERROR_KEY_IS_NULL);
+}
+
+static void check_ceiling_error_on_out_is_null(void **state) {
+    assert_int_equal(
+            coral_btree_container_ceiling(
+                    (void *) 1, (void *) 1, NULL),
+            CORAL_BTREE_CONTAINER_ERROR_OUT_IS_NULL);
+}
+
+static void check_ceiling(void **state) {
+    struct coral_btree_container object;
+    assert_int_equal(coral_btree_container_init(&object, compare), 0);
+    const uintmax_t count = 3;
+    union entry {
+        struct coral_btree_container_entry *entry;
+        uintmax_t *value;
+    } item[count];
+    for (uintmax_t i = 0; i < count; i++) {
+        assert_int_equal(coral_btree_container_alloc(
+                sizeof(uintmax_t), &item[i].entry), 0);
+        *item[i].value = i * i;
+        assert_int_equal(coral_btree_container_add(
+                &object, item[i].entry), 0);
+    }
+    /* case: exact match */
+    uintmax_t key = *item[1].value;
+    union entry other;
+    assert_int_equal(coral_btree_container_ceiling(
+            &object, &key, &other.entry), 0);
+    assert_int_equal(*item[1].value, *other.value);
+    assert_ptr_equal(item[1].entry, other.entry);
+    /* case: higher match */
+    key = 3;
+    assert_int_equal(coral_btree_container_ceiling(
+            &object, &key, &other.entry), 0);
+    assert_int_equal(*item[2].value, *other.value);
+    assert_ptr_equal(item[2].entry, other.entry);
+    assert_int_equal(coral_btree_container_invalidate(
+            &object, NULL), 0);
+}
+
+static void check_ceiling_on_ancestor(void **state) {
+    struct coral_btree_container object;
+    assert_int_equal(coral_btree_container_init(&object, compare), 0);
+    const uintmax_t count = 2;
+    union entry {
+        struct coral_btree_container_entry *entry;
+        uintmax_t *value;
+    } item[count];
+    /* search for the key ends on the lower entry, the match is its parent */
+    for (uintmax_t i = 0; i < count; i++) {
+        assert_int_equal(coral_btree_container_alloc(
+                sizeof(uintmax_t), &item[i].entry), 0);
+        *item[i].value = 4 >> (2 * i);
+        assert_int_equal(coral_btree_container_add(
+                &object, item[i].entry), 0);
+    }
+    uintmax_t key = 2;
+    union entry other;
+    assert_int_equal(coral_btree_container_ceiling(
+            &object, &key, &other.entry), 0);
+    assert_int_equal(*item[0].value, *other.value);
+    assert_ptr_equal(item[0].entry, other.entry);
+    assert_int_equal(coral_btree_container_invalidate(
+            &object, NULL), 0);
+}
+
+static void check_ceiling_error_on_entry_not_found(void **state) {
+    struct coral_btree_container object;
+    assert_int_equal(coral_btree_container_init(&object, compare), 0);
+    const uintmax_t count = 3;
+    union entry {
+        struct coral_btree_container_entry *entry;
+        uintmax_t *value;
+    } item[count];
+    /* case: empty container */
+    const uintmax_t key = UINTMAX_MAX;
+    union entry other;
+    assert_int_equal(
+            coral_btree_container_ceiling(&object, &key, &other.entry),
+            CORAL_BTREE_CONTAINER_ERROR_ENTRY_NOT_FOUND);
+    for (uintmax_t i = 0; i < count; i++) {
+        assert_int_equal(coral_btree_container_alloc(
+                sizeof(uintmax_t), &item[i].entry), 0);
+        *item[i].value = i;
+        assert_int_equal(coral_btree_container_add(
+                &object, item[i].entry), 0);
+    }
+    /* case: non-empty container */
+    assert_int_equal(
+            coral_btree_container_ceiling(&object, &key, &other.entry),
+            CORAL_BTREE_CONTAINER_ERROR_ENTRY_NOT_FOUND);
+    assert_int_equal(coral_btree_container_invalidate(
+            &object, NULL), 0);
+}
+
+static void check_floor_error_on_object_is_null(void **state) {
+    assert_int_equal(
+            coral_btree_container_floor(
+                    NULL, (void *) 1, (void *) 1),
+            CORAL_BTREE_CONTAINER_ERROR_OBJECT_IS_NULL);
+}
+
+static void check_floor_error_on_key_is_null(void **state) {
+    assert_int_equal(
+            coral_btree_container_floor(
+                    (void *) 1, NULL, (void *) 1),
+            CORAL_BTREE_CONTAINER_ERROR_KEY_IS_NULL);
+}
+
+static void check_floor_error_on_out_is_null(void **state) {
+    assert_int_equal(
+            coral_btree_container_floor(
+                    (void *) 1, (void *) 1, NULL),
+            CORAL_BTREE_CONTAINER_ERROR_OUT_IS_NULL);
+}
+
+static void check_floor(void **state) {
+    struct coral_btree_container object;
+    assert_int_equal(coral_btree_container_init(&object, compare), 0);
+    const uintmax_t count = 3;
+    union entry {
+        struct coral_btree_container_entry *entry;
+        uintmax_t *value;
+    } item[count];
+    for (uintmax_t i = 0; i < count; i++) {
+        assert_int_equal(coral_btree_container_alloc(
+                sizeof(uintmax_t), &item[i].entry), 0);
+        *item[i].value = i * i;
+        assert_int_equal(coral_btree_container_add(
+                &object, item[i].entry), 0);
+    }
+    /* case: exact match */
+    uintmax_t key = *item[2].value;
+    union entry other;
+    assert_int_equal(coral_btree_container_floor(
+            &object, &key, &other.entry), 0);
+    assert_int_equal(*item[2].value, *other.value);
+    assert_ptr_equal(item[2].entry, other.entry);
+    /* case: lower match */
+    key = 3;
+    assert_int_equal(coral_btree_container_floor(
+            &object, &key, &other.entry), 0);
+    assert_int_equal(*item[1].value, *other.value);
+    assert_ptr_equal(item[1].entry, other.entry);
+    assert_int_equal(coral_btree_container_invalidate(
+            &object, NULL), 0);
+}
+
+static void check_floor_error_on_entry_not_found(void **state) {
+    struct coral_btree_container object;
+    assert_int_equal(coral_btree_container_init(&object, compare), 0);
+    const uintmax_t count = 3;
+    union entry {
+        struct coral_btree_container_entry *entry;
+        uintmax_t *value;
+    } item[count];
+    /* case: empty container */
+    const uintmax_t key = 0;
+    union entry other;
+    assert_int_equal(
+            coral_btree_container_floor(&object, &key, &other.entry),
+            CORAL_BTREE_CONTAINER_ERROR_ENTRY_NOT_FOUND);
+    for (uintmax_t i = 0; i < count; i++) {
+        assert_int_equal(coral_btree_container_alloc(
+                sizeof(uintmax_t), &item[i].entry), 0);
+        *item[i].value = 1 + i;
+        assert_int_equal(coral_btree_container_add(
+                &object, item[i].entry), 0);
+    }
+    /* case: non-empty container */
+    assert_int_equal(
+            coral_btree_container_floor(&object, &key, &other.entry),
+            CORAL_BTREE_CONTAINER_ERROR_ENTRY_NOT_FOUND);
+    assert_int_equal(coral_btree_container_invalidate(
+            &object, NULL), 0);
+}
+
+static void check_higher_error_on_object_is_null(void **state) {
+    assert_int_equal(
+            coral_btree_container_higher(
+                    NULL, (void *) 1, (void *) 1),
+            CORAL_BTREE_CONTAINER_ERROR_OBJECT_IS_NULL);
+}
+
+static void check_higher_error_on_key_is_null(void **state) {
+    assert_int_equal(
+            coral_btree_container_higher(
+                    (void *) 1, NULL, (void *) 1),
+            CORAL_BTREE_CONTAINER_ERROR_KEY_IS_NULL);
+}
+
+static void check_higher_error_on_out_is_null(void **state) {
+    assert_int_equal(
+            coral_btree_container_higher(
+                    (void *) 1, (void *) 1, NULL),
+            CORAL_BTREE_CONTAINER_ERROR_OUT_IS_NULL);
+}
+
+static void check_higher(void **state) {
+    struct coral_btree_container object;
+    assert_int_equal(coral_btree_container_init(&object, compare), 0);
+    const uintmax_t count = 3;
+    union entry {
+        struct coral_btree_container_entry *entry;
+        uintmax_t *value;
+    } item[count];
+    for (uintmax_t i = 0; i < count; i++) {
+        assert_int_equal(coral_btree_container_alloc(
+                sizeof(uintmax_t), &item[i].entry), 0);
+        *item[i].value = i * i;
+        assert_int_equal(coral_btree_container_add(
+                &object, item[i].entry), 0);
+    }
+    /* case: higher match */
+    uintmax_t key = *item[1].value;
+    union entry other;
+    assert_int_equal(coral_btree_container_higher(
+            &object, &key, &other.entry), 0);
+    assert_int_equal(*item[2].value, *other.value);
+    assert_ptr_equal(item[2].entry, other.entry);
+    assert_int_equal(coral_btree_container_invalidate(
+            &object, NULL), 0);
+}
+
+static void check_higher_on_ancestor(void **state) {
+    struct coral_btree_container object;
+    assert_int_equal(coral_btree_container_init(&object, compare), 0);
+    const uintmax_t count = 2;
+    union entry {
+        struct coral_btree_container_entry *entry;
+        uintmax_t *value;
+    } item[count];
+    /* search for the key ends on the lower entry, the match is its parent */
+    for (uintmax_t i = 0; i < count; i++) {
+        assert_int_equal(coral_btree_container_alloc(
+                sizeof(uintmax_t), &item[i].entry), 0);
+        *item[i].value = 4 >> (2 * i);
+        assert_int_equal(coral_btree_container_add(
+                &object, item[i].entry), 0);
+    }
+    uintmax_t key = 2;
+    union entry other;
+    assert_int_equal(coral_btree_container_higher(
+            &object, &key, &other.entry), 0);
+    assert_int_equal(*item[0].value, *other.value);
+    assert_ptr_equal(item[0].entry, other.entry);
+    assert_int_equal(coral_btree_container_invalidate(
+            &object, NULL), 0);
+}
+
+static void check_higher_error_on_entity_not_found(void **state) {
+    struct coral_btree_container object;
+    assert_int_equal(coral_btree_container_init(&object, compare), 0);
+    const uintmax_t count = 3;
+    union entry {
+        struct coral_btree_container_entry *entry;
+        uintmax_t *value;
+    } item[count];
+    /* case: empty container */
+    uintmax_t key = 0;
+    union entry other;
+    assert_int_equal(
+            coral_btree_container_higher(&object, &key, &other.entry),
+            CORAL_BTREE_CONTAINER_ERROR_ENTRY_NOT_FOUND);
+    for (uintmax_t i = 0; i < count; i++) {
+        assert_int_equal(coral_btree_container_alloc(
+                sizeof(uintmax_t), &item[i].entry), 0);
+        *item[i].value = i * i;
+        assert_int_equal(coral_btree_container_add(
+                &object, item[i].entry), 0);
+    }
+    /* case: non-empty container */
+    key = *item[2].value;
+    assert_int_equal(
+            coral_btree_container_higher(&object, &key, &other.entry),
+            CORAL_BTREE_CONTAINER_ERROR_ENTRY_NOT_FOUND);
+    assert_int_equal(coral_btree_container_invalidate(
+            &object, NULL), 0);
+}
+
+static void check_lower_error_on_object_is_null(void **state) {
+    assert_int_equal(
+            coral_btree_container_lower(
+                    NULL, (void *) 1, (void *) 1),
+            CORAL_BTREE_CONTAINER_ERROR_OBJECT_IS_NULL);
+}
+
+static void check_lower_error_on_key_is_null(void **state) {
+    assert_int_equal(
+            coral_btree_container_lower(
+                    (void *) 1, NULL, (void *) 1),
+            CORAL_BTREE_CONTAINER_ERROR_KEY_IS_NULL);
+}
+
+static void check_lower_error_on_out_is_null(void **state) {
+    assert_int_equal(
+            coral_btree_container_lower(
+                    (void *) 1, (void *) 1, NULL),
+            CORAL_BTREE_CONTAINER_ERROR_OUT_IS_NULL);
+}
+
+static void check_lower(void **state) {
+    struct coral_btree_container object;
+    assert_int_equal(coral_btree_container_init(&object, compare), 0);
+    const uintmax_t count = 3;
+    union entry {
+        struct coral_btree_container_entry *entry;
+        uintmax_t *value;
+    } item[count];
+    for (uintmax_t i = 0; i < count; i++) {
+        assert_int_equal(coral_btree_container_alloc(
+                sizeof(uintmax_t), &item[i].entry), 0);
+        *item[i].value = i * i;
+        assert_int_equal(coral_btree_container_add(
+                &object, item[i].entry), 0);
+    }
+    /* case: lower match */
+    uintmax_t key = 3;
+    union entry other;
+    assert_int_equal(coral_btree_container_lower(
+            &object, &key, &other.entry), 0);
+    assert_int_equal(*item[1].value, *other.value);
+    assert_ptr_equal(item[1].entry, other.entry);
+    assert_int_equal(coral_btree_container_invalidate(
+            &object, NULL), 0);
+}
+
+static void check_lower_error_on_entity_not_found(void **state) {
+    struct coral_btree_container object;
+    assert_int_equal(coral_btree_container_init(&object, compare), 0);
+    const uintmax_t count = 3;
+    union entry {
+        struct coral_btree_container_entry *entry;
+        uintmax_t *value;
+    } item[count];
+    /* case: empty container */
+    uintmax_t key = 0;
+    union entry other;
+    assert_int_equal(
+            coral_btree_container_lower(&object, &key, &other.entry),
+            CORAL_BTREE_CONTAINER_ERROR_ENTRY_NOT_FOUND);
+    for (uintmax_t i = 0; i < count; i++) {
+        assert_int_equal(coral_btree_container_alloc(
+                sizeof(uintmax_t), &item[i].entry), 0);
+        *item[i].value = i * i;
+        assert_int_equal(coral_btree_container_add(
+                &object, item[i].entry), 0);
+    }
+    /* case: non-empty container */
+    assert_int_equal(
+            coral_btree_container_lower(&object, &key, &other.entry),
+            CORAL_BTREE_CONTAINER_ERROR_ENTRY_NOT_FOUND);
+    assert_int_equal(coral_btree_container_invalidate(
+            &object, NULL), 0);
+}
+
+static void check_first_error_on_object_is_null(void **state) {
+    assert_int_equal(
+            coral_btree_container_first(NULL, (void *) 1),
+            CORAL_BTREE_CONTAINER_ERROR_OBJECT_IS_NULL);
+}
+
+static void check_first_error_on_out_is_null(void **state) {
+    assert_int_equal(
+            coral_btree_container_first((void *) 1, NULL),
+            CORAL_BTREE_CONTAINER_ERROR_OUT_IS_NULL);
+}
+
+static void check_first(void **state) {
+    struct coral_btree_container object;
+    assert_int_equal(coral_btree_container_init(&object, compare), 0);
+    const uintmax_t count = 3;
+    union entry {
+        struct coral_btree_container_entry *entry;
+        uintmax_t *value;
+    } item[count];
+    for (uintmax_t i = 0; i < count; i++) {
+        assert_int_equal(coral_btree_container_alloc(
+                sizeof(uintmax_t), &item[i].entry), 0);
+        *item[i].value = i * i;
+        assert_int_equal(coral_btree_container_add(
+                &object, item[i].entry), 0);
+    }
+    union entry other;
+    assert_int_equal(coral_btree_container_first(
+            &object, &other.entry), 0);
+    assert_int_equal(*item[0].value, *other.value);
+    assert_ptr_equal(item[0].entry, other.entry);
+    assert_int_equal(coral_btree_container_invalidate(
+            &object, NULL), 0);
+}
+
+static void check_first_error_on_container_is_empty(void **state) {
+    struct coral_btree_container object;
+    assert_int_equal(coral_btree_container_init(&object, compare), 0);
+    union entry {
+        struct coral_btree_container_entry *entry;
+        uintmax_t *value;
+    } item;
+    assert_int_equal(
+            coral_btree_container_first(&object, &item.entry),
+            CORAL_BTREE_CONTAINER_ERROR_CONTAINER_IS_EMPTY);
+    assert_int_equal(coral_btree_container_invalidate(
+            &object, NULL), 0);
+}
+
+static void check_last_error_on_object_is_null(void **state) {
+    assert_int_equal(
+            coral_btree_container_last(NULL, (void *) 1),
+            CORAL_BTREE_CONTAINER_ERROR_OBJECT_IS_NULL);
+}
+
+static void check_last_error_on_out_is_null(void **state) {
+    assert_int_equal(
+            coral_btree_container_last((void *) 1, NULL),
+            CORAL_BTREE_CONTAINER_ERROR_OUT_IS_NULL);
+}
+
+static void check_last(void **state) {
+    struct coral_btree_container object;
+    assert_int_equal(coral_btree_container_init(&object, compare), 0);
+    const uintmax_t count = 3;
+    union entry {
+        struct coral_btree_container_entry *entry;
+        uintmax_t *value;
+    } item[count];
+    for (uintmax_t i = 0; i < count; i++) {
+        assert_int_equal(coral_btree_container_alloc(
+                sizeof(uintmax_t), &item[i].entry), 0);
+        *item[i].value = i * i;
+        assert_int_equal(coral_btree_container_add(
+                &object, item[i].entry), 0);
+    }
+    union entry other;
+    assert_int_equal(coral_btree_container_last(
+            &object, &other.entry), 0);
+    assert_int_equal(*item[2].value, *other.value);
+    assert_ptr_equal(item[2].entry, other.entry);
+    assert_int_equal(coral_btree_container_invalidate(
+            &object, NULL), 0);
+}
+
+static void check_last_error_on_container_is_empty(void **state) {
+    struct coral_btree_container object;
+    assert_int_equal(coral_btree_container_init(&object, compare), 0);
+    union entry {
+        struct coral_btree_container_entry *entry;
+        uintmax_t *value;
+    } item;
+    assert_int_equal(
+            coral_btree_container_last(&object, &item.entry),
+            CORAL_BTREE_CONTAINER_ERROR_CONTAINER_IS_EMPTY);
+    assert_int_equal(coral_btree_container_invalidate(
+            &object, NULL), 0);
+}
+
+static void check_next_error_on_entry_is_null(void **state) {
+    assert_ptr_equal(
+            coral_btree_container_next(NULL, (void *) 1),
+            CORAL_BTREE_CONTAINER_ERROR_ENTRY_IS_NULL);
+}
+
+static void check_next_error_on_out_is_null(void **state) {
+    assert_ptr_equal(
+            coral_btree_container_next((void *) 1, NULL),
+            CORAL_BTREE_CONTAINER_ERROR_OUT_IS_NULL);
+}
+
+static void check_next(void **state) {
+    struct coral_btree_container object;
+    assert_int_equal(coral_btree_container_init(&object, compare), 0);
+    const uintmax_t count = 3;
+    union entry {
+        struct coral_btree_container_entry *entry;
+        uintmax_t *value;
+    } item[count];
+    for (uintmax_t i = 0; i < count; i++) {
+        assert_int_equal(coral_btree_container_alloc(
+                sizeof(uintmax_t), &item[i].entry), 0);
+        *item[i].value = i * i;
+        assert_int_equal(coral_btree_container_add(
+                &object, item[i].entry), 0);
+    }
+    union entry other;
+    assert_int_equal(coral_btree_container_first(
+            &object, &other.entry), 0);
+    assert_int_equal(coral_btree_container_next(
+            other.entry, &other.entry), 0);
+    assert_int_equal(*item[1].value, *other.value);
+    assert_ptr_equal(item[1].entry, other.entry);
+    assert_int_equal(coral_btree_container_invalidate(
+            &object, NULL), 0);
+}
+
+static void check_next_error_on_end_of_sequence(void **state) {
+    struct coral_btree_container object;
+    assert_int_equal(coral_btree_container_init(&object, compare), 0);
+    const uintmax_t count = 1;
+    union entry {
+        struct coral_btree_container_entry *entry;
+        uintmax_t *value;
+    } item[count];
+    for (uintmax_t i = 0; i < count; i++) {
+        assert_int_equal(coral_btree_container_alloc(
+                sizeof(uintmax_t), &item[i].entry), 0);
+        *item[i].value = i;
+        assert_int_equal(coral_btree_container_add(
+                &object, item[i].entry), 0);
+    }
+    union entry other;
+    assert_int_equal(coral_btree_container_first(
+            &object, &other.entry), 0);
+    assert_int_equal(
+            coral_btree_container_next(other.entry, &other.entry),
+            CORAL_BTREE_CONTAINER_ERROR_END_OF_SEQUENCE);
+    assert_int_equal(coral_btree_container_invalidate(
+            &object, NULL), 0);
+}
+
+static void check_prev_error_on_entry_is_null(void **state) {
+    assert_ptr_equal(
+            coral_btree_container_prev(NULL, (void *) 1),
+            CORAL_BTREE_CONTAINER_ERROR_ENTRY_IS_NULL);
+}
+
+static void check_prev_error_on_out_is_null(void **state) {
+    assert_ptr_equal(
+            coral_btree_container_prev((void *) 1, NULL),
+            CORAL_BTREE_CONTAINER_ERROR_OUT_IS_NULL);
+}
+
+static void check_prev(void **state) {
+    struct coral_btree_container object;
+    assert_int_equal(coral_btree_container_init(&object, compare), 0);
+    const uintmax_t count = 3;
+    union entry {
+        struct coral_btree_container_entry *entry;
+        uintmax_t *value;
+    } item[count];
+    for (uintmax_t i = 0; i < count; i++) {
+        assert_int_equal(coral_btree_container_alloc(
+                sizeof(uintmax_t), &item[i].entry), 0);
+        *item[i].value = i * i;
+        assert_int_equal(coral_btree_container_add(
+                &object, item[i].entry), 0);
+    }
+    union entry other;
+    assert_int_equal(coral_btree_container_last(
+            &object, &other.entry), 0);
+    assert_int_equal(coral_btree_container_prev(
+            other.entry, &other.entry), 0);
+    assert_int_equal(*item[1].value, *other.value);
+    assert_ptr_equal(item[1].entry, other.entry);
+    assert_int_equal(coral_btree_container_invalidate(
+            &object, NULL), 0);
+}
+
+static void check_prev_error_on_end_of_sequence(void **state) {
+    struct coral_btree_container object;
+    assert_int_equal(coral_btree_container_init(&object, compare), 0);
+    const uintmax_t count = 1;
+    union entry {
+        struct coral_btree_container_entry *entry;
+        uintmax_t *value;
+    } item[count];
+    for (uintmax_t i = 0; i < count; i++) {
+        assert_int_equal(coral_btree_container_alloc(
+                sizeof(uintmax_t), &item[i].entry), 0);
+        *item[i].value = i;
+        assert_int_equal(coral_btree_container_add(
+                &object, item[i].entry), 0);
+    }
+    union entry other;
+    assert_int_equal(coral_btree_container_last(
+            &object, &other.entry), 0);
+    assert_int_equal(
+            coral_btree_container_prev(other.entry, &other.entry),
+            CORAL_BTREE_CONTAINER_ERROR_END_OF_SEQUENCE);
+    assert_int_equal(coral_btree_container_invalidate(
+            &object, NULL), 0);
+}
+
+static void check_counters_error_on_object_is_null(void **state) {
+    assert_int_equal(
+            coral_btree_container_counters(NULL, (void *) 1),
+            CORAL_BTREE_CONTAINER_ERROR_OBJECT_IS_NULL);
+}
+
+static void check_counters_error_on_out_is_null(void **state) {
+    assert_int_equal(
+            coral_btree_container_counters((void *) 1, NULL),
+            CORAL_BTREE_CONTAINER_ERROR_OUT_IS_NULL);
+}
+
+static void check_counters(void **state) {
+    struct coral_btree_container object;
+    assert_int_equal(coral_btree_container_init(
+            &object, compare), 0);
+    const uintmax_t count = 3;
+    union entry {
+        struct coral_btree_container_entry *entry;
+        uintmax_t *value;
+    } item[count];
+    for (uintmax_t i = 0; i < count; i++) {
+        assert_int_equal(coral_btree_container_alloc(
+                sizeof(uintmax_t), &item[i].entry), 0);
+        *item[i].value = i;
+        assert_int_equal(coral_btree_container_add(
+                &object, item[i].entry), 0);
+    }
+    assert_int_equal(coral_btree_container_remove(
+            &object, item[0].entry), 0);
+    struct coral_counters counters;
+    assert_int_equal(coral_btree_container_counters(
+            &object, &counters), 0);
+#ifdef CORAL_COUNTERS
+    assert_int_equal(counters.insert, count);
+    assert_int_equal(counters.remove, 1);
+    assert_true(counters.compare >= counters.visit);
+    assert_true(counters.visit >= count - 1);
+#else
+    assert_int_equal(counters.compare, 0);
+    assert_int_equal(counters.visit, 0);
+    assert_int_equal(counters.insert, 0);
+    assert_int_equal(counters.remove, 0);
+#endif
+    assert_int_equal(coral_btree_container_free(item[0].entry), 0);
+    assert_int_equal(coral_btree_container_invalidate(
+            &object, NULL), 0);
+}
+
+static void check_counters_reset_error_on_object_is_null(void **state) {
+    assert_int_equal(
+            coral_btree_container_counters_reset(NULL),
+            CORAL_BTREE_CONTAINER_ERROR_OBJECT_IS_NULL);
+}
+
+static void check_counters_reset(void **state) {
+    struct coral_btree_container object;
+    assert_int_equal(coral_btree_container_init(
+            &object, compare), 0);
+    struct coral_btree_container_entry *entry;
+    assert_int_equal(coral_btree_container_alloc(
+            sizeof(uintmax_t), &entry), 0);
+    *(uintmax_t *) entry = 0;
+    assert_int_equal(coral_btree_container_add(&object, entry), 0);
+    assert_int_equal(coral_btree_container_counters_reset(&object), 0);
+    struct coral_counters counters;
+    assert_int_equal(coral_btree_container_counters(
+            &object, &counters), 0);
+    assert_int_equal(counters.compare, 0);
+    assert_int_equal(counters.visit, 0);
+    assert_int_equal(counters.insert, 0);
+    assert_int_equal(counters.remove, 0);
+    assert_int_equal(coral_btree_container_invalidate(
+            &object, NULL), 0);
+}
+
+struct record {
+    uintmax_t id;
+    char name[16];
+};
+
+static int compare_record(const void *a, const void *b) {
+    const struct record *const A = a;
+    const struct record *const B = b;
+    return seagrass_uintmax_t_ptr_compare(&A->id, &B->id);
+}
+
+static int compare_record_key(const void *key, const void *entry) {
+    const struct record *const B = entry;
+    return seagrass_uintmax_t_ptr_compare(key, &B->id);
+}
+
+static void check_init_with_key_error_on_object_is_null(void **state) {
+    assert_int_equal(
+            coral_btree_container_init_with_key(
+                    NULL, compare_record, compare_record_key),
+            CORAL_BTREE_CONTAINER_ERROR_OBJECT_IS_NULL);
+}
+
+static void check_init_with_key_error_on_compare_is_null(void **state) {
+    assert_int_equal(
+            coral_btree_container_init_with_key(
+                    (void *) 1, NULL, compare_record_key),
+            CORAL_BTREE_CONTAINER_ERROR_COMPARE_IS_NULL);
+    assert_int_equal(
+            coral_btree_container_init_with_key(
+                    (void *) 1, compare_record, NULL),
+            CORAL_BTREE_CONTAINER_ERROR_COMPARE_IS_NULL);
+}
+
+static void add_records(
+        struct coral_btree_container *const object) {
+    assert_int_equal(coral_btree_container_init_with_key(
+            object, compare_record, compare_record_key), 0);
+    for (uintmax_t i = 1; i <= 5; i += 2) {
+        union {
+            struct coral_btree_container_entry *entry;
+            struct record *record;
+        } ptr;
+        assert_int_equal(coral_btree_container_alloc(
+                sizeof(*ptr.record), &ptr.entry), 0);
+        ptr.record->id = i;
+        assert_int_equal(coral_btree_container_add(
+                object, ptr.entry), 0);
+    }
+}
+
+static void check_get_key_error_on_object_is_null(void **state) {
+    assert_int_equal(
+            coral_btree_container_get_key(
+                    NULL, (void *) 1, (void *) 1),
+            CORAL_BTREE_CONTAINER_ERROR_OBJECT_IS_NULL);
+}
+
+static void check_get_key_error_on_key_is_null(void **state) {
+    assert_int_equal(
+            coral_btree_container_get_key(
+                    (void *) 1, NULL, (void *) 1),
+            CORAL_BTREE_CONTAINER_ERROR_KEY_IS_NULL);
+}
+
+static void check_get_key_error_on_out_is_null(void **state) {
+    assert_int_equal(
+            coral_btree_container_get_key(
+                    (void *) 1, (void *) 1, NULL),
+            CORAL_BTREE_CONTAINER_ERROR_OUT_IS_NULL);
+}
+
+static void check_get_key_error_on_compare_is_null(void **state) {
+    struct coral_btree_container object;
+    assert_int_equal(coral_btree_container_init(
+            &object, compare), 0);
+    const uintmax_t key = 1;
+    struct coral_btree_container_entry *out;
+    assert_int_equal(
+            coral_btree_container_get_key(
+                    &object, &key, &out),
+            CORAL_BTREE_CONTAINER_ERROR_COMPARE_IS_NULL);
+    assert_int_equal(coral_btree_container_invalidate(
+            &object, NULL), 0);
+}
+
+static void check_get_key(void **state) {
+    struct coral_btree_container object;
+    add_records(&object);
+    const uintmax_t key = 3;
+    union {
+        struct coral_btree_container_entry *entry;
+        const struct record *record;
+    } out;
+    assert_int_equal(coral_btree_container_get_key(
+            &object, &key, &out.entry), 0);
+    assert_int_equal(out.record->id, 3);
+    const uintmax_t missing = 2;
+    assert_int_equal(
+            coral_btree_container_get_key(
+                    &object, &missing, &out.entry),
+            CORAL_BTREE_CONTAINER_ERROR_ENTRY_NOT_FOUND);
+    assert_int_equal(coral_btree_container_invalidate(
+            &object, NULL), 0);
+}
+
+static void check_ceiling_key(void **state) {
+    struct coral_btree_container object;
+    add_records(&object);
+    const uintmax_t keys[] = {0, 2, 3};
+    const uintmax_t ids[] = {1, 3, 3};
+    union {
+        struct coral_btree_container_entry *entry;
+        const struct record *record;
+    } out;
+    for (uintmax_t i = 0; i < 3; i++) {
+        assert_int_equal(coral_btree_container_ceiling_key(
+                &object, &keys[i], &out.entry), 0);
+        assert_int_equal(out.record->id, ids[i]);
+    }
+    const uintmax_t key = 6;
+    assert_int_equal(
+            coral_btree_container_ceiling_key(
+                    &object, &key, &out.entry),
+            CORAL_BTREE_CONTAINER_ERROR_ENTRY_NOT_FOUND);
+    assert_int_equal(coral_btree_container_invalidate(
+            &object, NULL), 0);
+}
+
+static void check_floor_key(void **state) {
+    struct coral_btree_container object;
+    add_records(&object);
+    const uintmax_t keys[] = {6, 4, 3};
+    const uintmax_t ids[] = {5, 3, 3};
+    union {
+        struct coral_btree_container_entry *entry;
+        const struct record *record;
+    } out;
+    for (uintmax_t i = 0; i < 3; i++) {
+        assert_int_equal(coral_btree_container_floor_key(
+                &object, &keys[i], &out.entry), 0);
+        assert_int_equal(out.record->id, ids[i]);
+    }
+    const uintmax_t key = 0;
+    assert_int_equal(
+            coral_btree_container_floor_key(
+                    &object, &key, &out.entry),
+            CORAL_BTREE_CONTAINER_ERROR_ENTRY_NOT_FOUND);
+    assert_int_equal(coral_btree_container_invalidate(
+            &object, NULL), 0);
+}
+
+static void check_higher_key(void **state) {
+    struct coral_btree_container object;
+    add_records(&object);
+    const uintmax_t keys[] = {0, 2, 3};
+    const uintmax_t ids[] = {1, 3, 5};
+    union {
+        struct coral_btree_container_entry *entry;
+        const struct record *record;
+    } out;
+    for (uintmax_t i = 0; i < 3; i++) {
+        assert_int_equal(coral_btree_container_higher_key(
+                &object, &keys[i], &out.entry), 0);
+        assert_int_equal(out.record->id, ids[i]);
+    }
+    const uintmax_t key = 5;
+    assert_int_equal(
+            coral_btree_container_higher_key(
+                    &object, &key, &out.entry),
+            CORAL_BTREE_CONTAINER_ERROR_ENTRY_NOT_FOUND);
+    assert_int_equal(coral_btree_container_invalidate(
+            &object, NULL), 0);
+}
+
+static void check_lower_key(void **state) {
+    struct coral_btree_container object;
+    add_records(&object);
+    const uintmax_t keys[] = {6, 4, 3};
+    const uintmax_t ids[] = {5, 3, 1};
+    union {
+        struct coral_btree_container_entry *entry;
+        const struct record *record;
+    } out;
+    for (uintmax_t i = 0; i < 3; i++) {
+        assert_int_equal(coral_btree_container_lower_key(
+                &object, &keys[i], &out.entry), 0);
+        assert_int_equal(out.record->id, ids[i]);
+    }
+    const uintmax_t key = 1;
+    assert_int_equal(
+            coral_btree_container_lower_key(
+                    &object, &key, &out.entry),
+            CORAL_BTREE_CONTAINER_ERROR_ENTRY_NOT_FOUND);
+    assert_int_equal(coral_btree_container_invalidate(
+            &object, NULL), 0);
+}
+
+static void check_remove_error_on_entry_not_found(void **state) {
+    struct coral_btree_container object;
+    assert_int_equal(coral_btree_container_init(&object, compare), 0);
+    struct coral_btree_container_entry *entry;
+    assert_int_equal(coral_btree_container_alloc(
+            sizeof(uintmax_t), &entry), 0);
+    *(uintmax_t *) entry = 0;
+    assert_int_equal(
+            coral_btree_container_remove(&object, entry),
+            CORAL_BTREE_CONTAINER_ERROR_ENTRY_NOT_FOUND);
+    assert_int_equal(coral_btree_container_free(entry), 0);
+    assert_int_equal(coral_btree_container_invalidate(&object, NULL), 0);
+}
+
+static void shuffle(uintmax_t *const values, const uintmax_t count) {
+    for (uintmax_t i = count - 1; i > 0; i--) {
+        const uintmax_t j = rand() % (i + 1);
+        const uintmax_t value = values[i];
+        values[i] = values[j];
+        values[j] = value;
+    }
+}
+
+/* entries must hold 0 up to count in steps of step when read both ways */
+static void expect_ordered(const struct coral_btree_container *const object,
+                           const uintmax_t count,
+                           const uintmax_t step) {
+    uintmax_t value;
+    assert_int_equal(coral_btree_container_count(object, &value), 0);
+    assert_int_equal(value, count);
+    struct coral_btree_container_entry *entry;
+    if (!count) {
+        assert_int_equal(
+                coral_btree_container_first(object, &entry),
+                CORAL_BTREE_CONTAINER_ERROR_CONTAINER_IS_EMPTY);
+        return;
+    }
+    assert_int_equal(coral_btree_container_first(object, &entry), 0);
+    for (uintmax_t i = 0; i < count; i++) {
+        assert_int_equal(*(uintmax_t *) entry, i * step);
+        assert_int_equal(coral_btree_container_next(entry, &entry),
+                         i + 1 < count
+                         ? 0
+                         : CORAL_BTREE_CONTAINER_ERROR_END_OF_SEQUENCE);
+    }
+    assert_int_equal(coral_btree_container_last(object, &entry), 0);
+    for (uintmax_t i = count; i--;) {
+        assert_int_equal(*(uintmax_t *) entry, i * step);
+        assert_int_equal(coral_btree_container_prev(entry, &entry),
+                         i ? 0 : CORAL_BTREE_CONTAINER_ERROR_END_OF_SEQUENCE);
+    }
+}
+
+static void add_values(struct coral_btree_container *const object,
+                       const uintmax_t *const values,
+                       const uintmax_t count) {
+    for (uintmax_t i = 0; i < count; i++) {
+        struct coral_btree_container_entry *entry;
+        assert_int_equal(coral_btree_container_alloc(
+                sizeof(uintmax_t), &entry), 0);
+        *(uintmax_t *) entry = values[i];
+        assert_int_equal(coral_btree_container_add(object, entry), 0);
+    }
+}
+
+static void check_add_many(void **state) {
+    srand(time(NULL));
+    struct coral_btree_container object;
+    assert_int_equal(coral_btree_container_init(&object, compare), 0);
+    const uintmax_t count = 5000;
+    uintmax_t *const values = malloc(count * sizeof(*values));
+    assert_non_null(values);
+    for (uintmax_t i = 0; i < count; i++) {
+        values[i] = i;
+    }
+    shuffle(values, count);
+    add_values(&object, values, count);
+    expect_ordered(&object, count, 1);
+    for (uintmax_t i = 0; i < count; i++) {
+        struct coral_btree_container_entry *entry;
+        assert_int_equal(coral_btree_container_get(
+                &object, &i, &entry), 0);
+        assert_int_equal(*(uintmax_t *) entry, i);
+    }
+    free(values);
+    assert_int_equal(coral_btree_container_invalidate(&object, NULL), 0);
+}
+
+static void check_remove_many(void **state) {
+    srand(time(NULL));
+    struct coral_btree_container object;
+    assert_int_equal(coral_btree_container_init(&object, compare), 0);
+    const uintmax_t count = 3000;
+    uintmax_t *const values = malloc(count * sizeof(*values));
+    assert_non_null(values);
+    for (uintmax_t i = 0; i < count; i++) {
+        values[i] = i;
+    }
+    add_values(&object, values, count);
+    shuffle(values, count);
+    for (uintmax_t i = 0; i < count; i++) {
+        struct coral_btree_container_entry *entry;
+        assert_int_equal(coral_btree_container_get(
+                &object, &values[i], &entry), 0);
+        assert_int_equal(coral_btree_container_remove(&object, entry), 0);
+        assert_int_equal(coral_btree_container_free(entry), 0);
+        assert_int_equal(
+                coral_btree_container_get(&object, &values[i], &entry),
+                CORAL_BTREE_CONTAINER_ERROR_ENTRY_NOT_FOUND);
+        uintmax_t remaining;
+        assert_int_equal(coral_btree_container_count(
+                &object, &remaining), 0);
+        assert_int_equal(remaining, count - i - 1);
+    }
+    expect_ordered(&object, 0, 1);
+    /* removing in order drains the leaves from the front */
+    for (uintmax_t i = 0; i < count; i++) {
+        values[i] = 2 * i;
+    }
+    add_values(&object, values, count);
+    for (uintmax_t i = 0; i < count / 2; i++) {
+        struct coral_btree_container_entry *entry;
+        assert_int_equal(coral_btree_container_first(&object, &entry), 0);
+        assert_int_equal(*(uintmax_t *) entry, 2 * i);
+        assert_int_equal(coral_btree_container_remove(&object, entry), 0);
+        assert_int_equal(coral_btree_container_free(entry), 0);
+    }
+    for (uintmax_t i = count / 2; i < count; i++) {
+        struct coral_btree_container_entry *entry;
+        assert_int_equal(coral_btree_container_last(&object, &entry), 0);
+        assert_int_equal(
+                *(uintmax_t *) entry, 2 * (count - 1 - (i - count / 2)));
+        assert_int_equal(coral_btree_container_remove(&object, entry), 0);
+        assert_int_equal(coral_btree_container_free(entry), 0);
+    }
+    expect_ordered(&object, 0, 1);
+    free(values);
+    assert_int_equal(coral_btree_container_invalidate(&object, NULL), 0);
+}
+
+static void check_lookup_across_leaves(void **state) {
+    struct coral_btree_container object;
+    assert_int_equal(coral_btree_container_init(&object, compare), 0);
+    const uintmax_t count = 500;
+    uintmax_t values[count];
+    for (uintmax_t i = 0; i < count; i++) {
+        values[i] = 2 * i;
+    }
+    add_values(&object, values, count);
+    expect_ordered(&object, count, 2);
+    struct coral_btree_container_entry *entry;
+    for (uintmax_t i = 0; i < count; i++) {
+        const uintmax_t even = 2 * i;
+        const uintmax_t odd = even + 1;
+        assert_int_equal(coral_btree_container_ceiling(
+                &object, &even, &entry), 0);
+        assert_int_equal(*(uintmax_t *) entry, even);
+        assert_int_equal(coral_btree_container_floor(
+                &object, &even, &entry), 0);
+        assert_int_equal(*(uintmax_t *) entry, even);
+        assert_int_equal(coral_btree_container_floor(
+                &object, &odd, &entry), 0);
+        assert_int_equal(*(uintmax_t *) entry, even);
+        assert_int_equal(coral_btree_container_lower(
+                &object, &odd, &entry), 0);
+        assert_int_equal(*(uintmax_t *) entry, even);
+        if (i + 1 < count) {
+            assert_int_equal(coral_btree_container_ceiling(
+                    &object, &odd, &entry), 0);
+            assert_int_equal(*(uintmax_t *) entry, even + 2);
+            assert_int_equal(coral_btree_container_higher(
+                    &object, &even, &entry), 0);
+            assert_int_equal(*(uintmax_t *) entry, even + 2);
+        } else {
+            assert_int_equal(
+                    coral_btree_container_ceiling(&object, &odd, &entry),
+                    CORAL_BTREE_CONTAINER_ERROR_ENTRY_NOT_FOUND);
+            assert_int_equal(
+                    coral_btree_container_higher(&object, &even, &entry),
+                    CORAL_BTREE_CONTAINER_ERROR_ENTRY_NOT_FOUND);
+        }
+        if (i) {
+            assert_int_equal(coral_btree_container_lower(
+                    &object, &even, &entry), 0);
+            assert_int_equal(*(uintmax_t *) entry, even - 2);
+        } else {
+            assert_int_equal(
+                    coral_btree_container_lower(&object, &even, &entry),
+                    CORAL_BTREE_CONTAINER_ERROR_ENTRY_NOT_FOUND);
+        }
+    }
+    assert_int_equal(coral_btree_container_invalidate(&object, NULL), 0);
+}
+
+static uintmax_t destroyed_entries;
+
+static void on_destroy(struct coral_btree_container_entry *const entry) {
+    destroyed_entries++;
+}
+
+static void check_invalidate_with_on_destroy(void **state) {
+    struct coral_btree_container object;
+    assert_int_equal(coral_btree_container_init(&object, compare), 0);
+    const uintmax_t count = 300;
+    uintmax_t values[count];
+    for (uintmax_t i = 0; i < count; i++) {
+        values[i] = i;
+    }
+    add_values(&object, values, count);
+    destroyed_entries = 0;
+    assert_int_equal(coral_btree_container_invalidate(
+            &object, on_destroy), 0);
+    assert_int_equal(destroyed_entries, count);
+    assert_null(object.root);
+    assert_int_equal(object.count, 0);
+}
+
+static void check_add_error_on_memory_allocation_failed(void **state) {
+    struct coral_btree_container object;
+    assert_int_equal(coral_btree_container_init(&object, compare), 0);
+    /* enough entries to fill a leaf so that the next one splits it */
+    const uintmax_t count = 16;
+    uintmax_t values[count];
+    for (uintmax_t i = 0; i < count; i++) {
+        values[i] = i;
+    }
+    add_values(&object, values, count);
+    struct coral_btree_container_entry *entry;
+    assert_int_equal(coral_btree_container_alloc(
+            sizeof(uintmax_t), &entry), 0);
+    *(uintmax_t *) entry = count;
+    posix_memalign_is_overridden = true;
+    assert_int_equal(
+            coral_btree_container_add(&object, entry),
+            CORAL_BTREE_CONTAINER_ERROR_MEMORY_ALLOCATION_FAILED);
+    posix_memalign_is_overridden = false;
+    expect_ordered(&object, count, 1);
+    assert_int_equal(coral_btree_container_add(&object, entry), 0);
+    expect_ordered(&object, count + 1, 1);
+    assert_int_equal(coral_btree_container_invalidate(&object, NULL), 0);
+}
+int main(int argc, char *argv[]) {
+    const struct CMUnitTest tests[] = {
+            cmocka_unit_test(check_free_error_on_entry_is_null),
+            cmocka_unit_test(check_free),
+            cmocka_unit_test(check_alloc_error_on_size_is_zero),
+            cmocka_unit_test(check_alloc_error_on_out_is_null),
+            cmocka_unit_test(check_alloc),
+            cmocka_unit_test(check_alloc_error_on_size_is_too_large),
+            cmocka_unit_test(check_alloc_error_on_memory_allocation_failed),
+            cmocka_unit_test(check_alloc_with),
+            cmocka_unit_test(check_invalidate_error_on_object_is_null),
+            cmocka_unit_test(check_invalidate),
+            cmocka_unit_test(check_init_error_on_object_is_null),
+            cmocka_unit_test(check_init_error_on_compare_is_null),
+            cmocka_unit_test(check_init),
+            cmocka_unit_test(check_count_error_on_object_is_null),
+            cmocka_unit_test(check_count_error_on_out_is_null),
+            cmocka_unit_test(check_count),
+            cmocka_unit_test(check_add_error_on_object_is_null),
+            cmocka_unit_test(check_add_error_on_entry_is_null),
+            cmocka_unit_test(check_add),
+            cmocka_unit_test(check_add_error_on_entry_already_exits),
+            cmocka_unit_test(check_remove_error_on_object_is_null),
+            cmocka_unit_test(check_remove_error_on_entry_is_null),
+            cmocka_unit_test(check_remove),
+            cmocka_unit_test(check_get_error_on_object_is_null),
+            cmocka_unit_test(check_get_error_on_key_is_null),
+            cmocka_unit_test(check_get_error_on_out_is_null),
+            cmocka_unit_test(check_get),
+            cmocka_unit_test(check_get_error_on_entry_not_found),
+            cmocka_unit_test(check_ceiling_error_on_object_is_null),
+            cmocka_unit_test(check_ceiling_error_on_key_is_null),
+            cmocka_unit_test(check_ceiling_error_on_out_is_null),
+            cmocka_unit_test(check_ceiling),
+            cmocka_unit_test(check_ceiling_on_ancestor),
+            cmocka_unit_test(check_ceiling_error_on_entry_not_found),
+            cmocka_unit_test(check_floor_error_on_object_is_null),
+            cmocka_unit_test(check_floor_error_on_key_is_null),
+            cmocka_unit_test(check_floor_error_on_out_is_null),
+            cmocka_unit_test(check_floor),
+            cmocka_unit_test(check_floor_error_on_entry_not_found),
+            cmocka_unit_test(check_higher_error_on_object_is_null),
+            cmocka_unit_test(check_higher_error_on_key_is_null),
+            cmocka_unit_test(check_higher_error_on_out_is_null),
+            cmocka_unit_test(check_higher),
+            cmocka_unit_test(check_higher_on_ancestor),
+            cmocka_unit_test(check_higher_error_on_entity_not_found),
+            cmocka_unit_test(check_lower_error_on_object_is_null),
+            cmocka_unit_test(check_lower_error_on_key_is_null),
+            cmocka_unit_test(check_lower_error_on_out_is_null),
+            cmocka_unit_test(check_lower),
+            cmocka_unit_test(check_lower_error_on_entity_not_found),
+            cmocka_unit_test(check_first_error_on_object_is_null),
+            cmocka_unit_test(check_first_error_on_out_is_null),
+            cmocka_unit_test(check_first),
+            cmocka_unit_test(check_first_error_on_container_is_empty),
+            cmocka_unit_test(check_last_error_on_object_is_null),
+            cmocka_unit_test(check_last_error_on_out_is_null),
+            cmocka_unit_test(check_last),
+            cmocka_unit_test(check_last_error_on_container_is_empty),
+            cmocka_unit_test(check_next_error_on_entry_is_null),
+            cmocka_unit_test(check_next_error_on_out_is_null),
+            cmocka_unit_test(check_next),
+            cmocka_unit_test(check_next_error_on_end_of_sequence),
+            cmocka_unit_test(check_prev_error_on_entry_is_null),
+            cmocka_unit_test(check_prev_error_on_out_is_null),
+            cmocka_unit_test(check_prev),
+            cmocka_unit_test(check_prev_error_on_end_of_sequence),
+            cmocka_unit_test(check_counters_error_on_object_is_null),
+            cmocka_unit_test(check_counters_error_on_out_is_null),
+            cmocka_unit_test(check_counters),
+            cmocka_unit_test(check_counters_reset_error_on_object_is_null),
+            cmocka_unit_test(check_counters_reset),
+            cmocka_unit_test(check_init_with_key_error_on_object_is_null),
+            cmocka_unit_test(check_init_with_key_error_on_compare_is_null),
+            cmocka_unit_test(check_get_key_error_on_object_is_null),
+            cmocka_unit_test(check_get_key_error_on_key_is_null),
+            cmocka_unit_test(check_get_key_error_on_out_is_null),
+            cmocka_unit_test(check_get_key_error_on_compare_is_null),
+            cmocka_unit_test(check_get_key),
+            cmocka_unit_test(check_ceiling_key),
+            cmocka_unit_test(check_floor_key),
+            cmocka_unit_test(check_higher_key),
+            cmocka_unit_test(check_lower_key),
+            cmocka_unit_test(check_remove_error_on_entry_not_found),
+            cmocka_unit_test(check_add_many),
+            cmocka_unit_test(check_remove_many),
+            cmocka_unit_test(check_lookup_across_leaves),
+            cmocka_unit_test(check_invalidate_with_on_destroy),
+            cmocka_unit_test(check_add_error_on_memory_allocation_failed),
+    };
+    //cmocka_set_message_output(CM_OUTPUT_XML);
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
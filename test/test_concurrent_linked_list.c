@@ -0,0 +1,521 @@
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <setjmp.h>
+#include <stdlib.h>
+#include <pthread.h>
+#include <cmocka.h>
+#include <coral.h>
+#include <seagrass.h>
+
+#include <test/cmocka.h>
+
+#include "statistics_allocator.h"
+
+static int compare(const void *a, const void *b) {
+    return seagrass_uintmax_t_ptr_compare(a, b);
+}
+
+static void check_free_error_on_item_is_null(void **state) {
+    assert_int_equal(
+            coral_concurrent_linked_list_free(NULL),
+            CORAL_CONCURRENT_LINKED_LIST_ERROR_ITEM_IS_NULL);
+}
+
+static void check_free(void **state) {
+    struct coral_concurrent_linked_list_item *item;
+    assert_int_equal(coral_concurrent_linked_list_alloc(1, &item), 0);
+    assert_int_equal(coral_concurrent_linked_list_free(item), 0);
+}
+
+static void check_retire_error_on_thread_is_null(void **state) {
+    struct coral_concurrent_linked_list_item *item;
+    assert_int_equal(coral_concurrent_linked_list_alloc(1, &item), 0);
+    assert_int_equal(
+            coral_concurrent_linked_list_retire(NULL, item),
+            CORAL_CONCURRENT_LINKED_LIST_ERROR_THREAD_IS_NULL);
+    assert_int_equal(coral_concurrent_linked_list_free(item), 0);
+}
+
+static void check_retire_error_on_item_is_null(void **state) {
+    struct coral_epoch_thread thread;
+    assert_int_equal(
+            coral_concurrent_linked_list_retire(&thread, NULL),
+            CORAL_CONCURRENT_LINKED_LIST_ERROR_ITEM_IS_NULL);
+}
+
+static void check_retire(void **state) {
+    struct coral_epoch epoch;
+    assert_int_equal(coral_epoch_init(&epoch), 0);
+    struct coral_epoch_thread thread;
+    assert_int_equal(coral_epoch_register(&epoch, &thread), 0);
+    struct coral_concurrent_linked_list_item *item;
+    assert_int_equal(coral_concurrent_linked_list_alloc(1, &item), 0);
+    assert_int_equal(coral_concurrent_linked_list_retire(&thread, item), 0);
+    assert_int_equal(coral_epoch_unregister(&thread), 0);
+    /* the item is freed here at the latest */
+    assert_int_equal(coral_epoch_invalidate(&epoch), 0);
+}
+
+static void check_alloc_error_on_size_is_zero(void **state) {
+    assert_int_equal(
+            coral_concurrent_linked_list_alloc(0, (void *) 1),
+            CORAL_CONCURRENT_LINKED_LIST_ERROR_SIZE_IS_ZERO);
+}
+
+static void check_alloc_error_on_out_is_null(void **state) {
+    assert_int_equal(
+            coral_concurrent_linked_list_alloc(1, NULL),
+            CORAL_CONCURRENT_LINKED_LIST_ERROR_OUT_IS_NULL);
+}
+
+static void check_alloc_error_on_size_is_too_large(void **state) {
+    assert_int_equal(
+            coral_concurrent_linked_list_alloc(UINTMAX_MAX, (void *) 1),
+            CORAL_CONCURRENT_LINKED_LIST_ERROR_SIZE_IS_TOO_LARGE);
+}
+
+static void check_alloc_error_on_memory_allocation_failed(void **state) {
+    malloc_is_overridden = calloc_is_overridden = realloc_is_overridden
+            = posix_memalign_is_overridden = true;
+    assert_int_equal(
+            coral_concurrent_linked_list_alloc(1, (void *) 1),
+            CORAL_CONCURRENT_LINKED_LIST_ERROR_MEMORY_ALLOCATION_FAILED);
+    malloc_is_overridden = calloc_is_overridden = realloc_is_overridden
+            = posix_memalign_is_overridden = false;
+}
+
+static void check_alloc_with(void **state) {
+    struct statistics statistics = {};
+    const struct coral_allocator allocator = {
+            .alloc = statistics_alloc,
+            .free = statistics_free,
+            .context = &statistics
+    };
+    struct coral_concurrent_linked_list_item *item;
+    assert_int_equal(coral_concurrent_linked_list_alloc_with(
+            &allocator, 1, &item), 0);
+    assert_int_equal(statistics.alloc, 1);
+    assert_int_equal(coral_concurrent_linked_list_free(item), 0);
+    assert_int_equal(statistics.free, 1);
+}
+
+static void check_init_error_on_object_is_null(void **state) {
+    assert_int_equal(
+            coral_concurrent_linked_list_init(NULL, compare),
+            CORAL_CONCURRENT_LINKED_LIST_ERROR_OBJECT_IS_NULL);
+}
+
+static void check_init_error_on_compare_is_null(void **state) {
+    struct coral_concurrent_linked_list object;
+    assert_int_equal(
+            coral_concurrent_linked_list_init(&object, NULL),
+            CORAL_CONCURRENT_LINKED_LIST_ERROR_COMPARE_IS_NULL);
+}
+
+static void check_init(void **state) {
+    struct coral_concurrent_linked_list object;
+    assert_int_equal(coral_concurrent_linked_list_init(&object, compare), 0);
+    assert_ptr_equal(object.compare, compare);
+    assert_int_equal(atomic_load(&object.head), 0);
+    assert_int_equal(atomic_load(&object.count), 0);
+    assert_int_equal(coral_concurrent_linked_list_invalidate(
+            &object, NULL), 0);
+}
+
+static void check_invalidate_error_on_object_is_null(void **state) {
+    assert_int_equal(
+            coral_concurrent_linked_list_invalidate(NULL, NULL),
+            CORAL_CONCURRENT_LINKED_LIST_ERROR_OBJECT_IS_NULL);
+}
+
+static void check_count_error_on_object_is_null(void **state) {
+    assert_int_equal(
+            coral_concurrent_linked_list_count(NULL, (void *) 1),
+            CORAL_CONCURRENT_LINKED_LIST_ERROR_OBJECT_IS_NULL);
+}
+
+static void check_count_error_on_out_is_null(void **state) {
+    assert_int_equal(
+            coral_concurrent_linked_list_count((void *) 1, NULL),
+            CORAL_CONCURRENT_LINKED_LIST_ERROR_OUT_IS_NULL);
+}
+
+static void check_add_error_on_object_is_null(void **state) {
+    assert_int_equal(
+            coral_concurrent_linked_list_add(NULL, (void *) 1),
+            CORAL_CONCURRENT_LINKED_LIST_ERROR_OBJECT_IS_NULL);
+}
+
+static void check_add_error_on_item_is_null(void **state) {
+    assert_int_equal(
+            coral_concurrent_linked_list_add((void *) 1, NULL),
+            CORAL_CONCURRENT_LINKED_LIST_ERROR_ITEM_IS_NULL);
+}
+
+static void check_remove_error_on_object_is_null(void **state) {
+    assert_int_equal(
+            coral_concurrent_linked_list_remove(NULL, (void *) 1),
+            CORAL_CONCURRENT_LINKED_LIST_ERROR_OBJECT_IS_NULL);
+}
+
+static void check_remove_error_on_item_is_null(void **state) {
+    assert_int_equal(
+            coral_concurrent_linked_list_remove((void *) 1, NULL),
+            CORAL_CONCURRENT_LINKED_LIST_ERROR_ITEM_IS_NULL);
+}
+
+static void check_get_error_on_object_is_null(void **state) {
+    assert_int_equal(
+            coral_concurrent_linked_list_get(NULL, (void *) 1, (void *) 1),
+            CORAL_CONCURRENT_LINKED_LIST_ERROR_OBJECT_IS_NULL);
+}
+
+static void check_get_error_on_key_is_null(void **state) {
+    assert_int_equal(
+            coral_concurrent_linked_list_get((void *) 1, NULL, (void *) 1),
+            CORAL_CONCURRENT_LINKED_LIST_ERROR_KEY_IS_NULL);
+}
+
+static void check_get_error_on_out_is_null(void **state) {
+    assert_int_equal(
+            coral_concurrent_linked_list_get((void *) 1, (void *) 1, NULL),
+            CORAL_CONCURRENT_LINKED_LIST_ERROR_OUT_IS_NULL);
+}
+
+static void check_first_error_on_object_is_null(void **state) {
+    assert_int_equal(
+            coral_concurrent_linked_list_first(NULL, (void *) 1),
+            CORAL_CONCURRENT_LINKED_LIST_ERROR_OBJECT_IS_NULL);
+}
+
+static void check_first_error_on_out_is_null(void **state) {
+    assert_int_equal(
+            coral_concurrent_linked_list_first((void *) 1, NULL),
+            CORAL_CONCURRENT_LINKED_LIST_ERROR_OUT_IS_NULL);
+}
+
+static void check_first_error_on_list_is_empty(void **state) {
+    struct coral_concurrent_linked_list object;
+    assert_int_equal(coral_concurrent_linked_list_init(&object, compare), 0);
+    struct coral_concurrent_linked_list_item *item;
+    assert_int_equal(
+            coral_concurrent_linked_list_first(&object, &item),
+            CORAL_CONCURRENT_LINKED_LIST_ERROR_LIST_IS_EMPTY);
+    assert_int_equal(coral_concurrent_linked_list_invalidate(
+            &object, NULL), 0);
+}
+
+static void check_next_error_on_object_is_null(void **state) {
+    assert_int_equal(
+            coral_concurrent_linked_list_next(NULL, (void *) 1, (void *) 1),
+            CORAL_CONCURRENT_LINKED_LIST_ERROR_OBJECT_IS_NULL);
+}
+
+static void check_next_error_on_item_is_null(void **state) {
+    assert_int_equal(
+            coral_concurrent_linked_list_next((void *) 1, NULL, (void *) 1),
+            CORAL_CONCURRENT_LINKED_LIST_ERROR_ITEM_IS_NULL);
+}
+
+static void check_next_error_on_out_is_null(void **state) {
+    assert_int_equal(
+            coral_concurrent_linked_list_next((void *) 1, (void *) 1, NULL),
+            CORAL_CONCURRENT_LINKED_LIST_ERROR_OUT_IS_NULL);
+}
+
+static struct coral_concurrent_linked_list_item *add_value(
+        struct coral_concurrent_linked_list *const object,
+        const uintmax_t value) {
+    struct coral_concurrent_linked_list_item *item;
+    assert_int_equal(coral_concurrent_linked_list_alloc(
+            sizeof(value), &item), 0);
+    *(uintmax_t *) item = value;
+    assert_int_equal(coral_concurrent_linked_list_add(object, item), 0);
+    return item;
+}
+
+static void check_add_get_and_remove(void **state) {
+    struct coral_concurrent_linked_list object;
+    assert_int_equal(coral_concurrent_linked_list_init(&object, compare), 0);
+    const uintmax_t values[] = {5, 1, 9, 3, 7};
+    struct coral_concurrent_linked_list_item *items[5];
+    for (uintmax_t i = 0; i < 5; i++) {
+        items[i] = add_value(&object, values[i]);
+    }
+    uintmax_t count;
+    assert_int_equal(coral_concurrent_linked_list_count(&object, &count), 0);
+    assert_int_equal(count, 5);
+    struct coral_concurrent_linked_list_item *item;
+    for (uintmax_t i = 0; i < 5; i++) {
+        assert_int_equal(coral_concurrent_linked_list_get(
+                &object, &values[i], &item), 0);
+        assert_ptr_equal(item, items[i]);
+    }
+    const uintmax_t missing = 4;
+    assert_int_equal(
+            coral_concurrent_linked_list_get(&object, &missing, &item),
+            CORAL_CONCURRENT_LINKED_LIST_ERROR_ITEM_NOT_FOUND);
+    assert_int_equal(coral_concurrent_linked_list_remove(
+            &object, items[2]), 0);
+    assert_int_equal(
+            coral_concurrent_linked_list_remove(&object, items[2]),
+            CORAL_CONCURRENT_LINKED_LIST_ERROR_ITEM_NOT_FOUND);
+    assert_int_equal(
+            coral_concurrent_linked_list_get(&object, &values[2], &item),
+            CORAL_CONCURRENT_LINKED_LIST_ERROR_ITEM_NOT_FOUND);
+    assert_int_equal(coral_concurrent_linked_list_count(&object, &count), 0);
+    assert_int_equal(count, 4);
+    assert_int_equal(coral_concurrent_linked_list_free(items[2]), 0);
+    assert_int_equal(coral_concurrent_linked_list_invalidate(
+            &object, NULL), 0);
+}
+
+static void check_add_error_on_item_already_exists(void **state) {
+    struct coral_concurrent_linked_list object;
+    assert_int_equal(coral_concurrent_linked_list_init(&object, compare), 0);
+    add_value(&object, 3);
+    struct coral_concurrent_linked_list_item *item;
+    assert_int_equal(coral_concurrent_linked_list_alloc(
+            sizeof(uintmax_t), &item), 0);
+    *(uintmax_t *) item = 3;
+    assert_int_equal(
+            coral_concurrent_linked_list_add(&object, item),
+            CORAL_CONCURRENT_LINKED_LIST_ERROR_ITEM_ALREADY_EXISTS);
+    /* an equal item that is not the one in the linked list is not removed */
+    assert_int_equal(
+            coral_concurrent_linked_list_remove(&object, item),
+            CORAL_CONCURRENT_LINKED_LIST_ERROR_ITEM_NOT_FOUND);
+    assert_int_equal(coral_concurrent_linked_list_free(item), 0);
+    assert_int_equal(coral_concurrent_linked_list_invalidate(
+            &object, NULL), 0);
+}
+
+static void check_first_and_next_in_order(void **state) {
+    struct coral_concurrent_linked_list object;
+    assert_int_equal(coral_concurrent_linked_list_init(&object, compare), 0);
+    for (uintmax_t i = 0; i < 100; i++) {
+        add_value(&object, (i * 37) % 100);
+    }
+    struct coral_concurrent_linked_list_item *item;
+    assert_int_equal(coral_concurrent_linked_list_first(&object, &item), 0);
+    for (uintmax_t i = 0; i < 99; i++) {
+        assert_int_equal(*(uintmax_t *) item, i);
+        assert_int_equal(coral_concurrent_linked_list_next(
+                &object, item, &item), 0);
+    }
+    assert_int_equal(*(uintmax_t *) item, 99);
+    assert_int_equal(
+            coral_concurrent_linked_list_next(&object, item, &item),
+            CORAL_CONCURRENT_LINKED_LIST_ERROR_END_OF_SEQUENCE);
+    assert_int_equal(coral_concurrent_linked_list_invalidate(
+            &object, NULL), 0);
+}
+
+static void check_next_after_remove(void **state) {
+    struct coral_concurrent_linked_list object;
+    assert_int_equal(coral_concurrent_linked_list_init(&object, compare), 0);
+    struct coral_concurrent_linked_list_item *items[4];
+    for (uintmax_t i = 0; i < 4; i++) {
+        items[i] = add_value(&object, i);
+    }
+    assert_int_equal(coral_concurrent_linked_list_remove(
+            &object, items[1]), 0);
+    assert_int_equal(coral_concurrent_linked_list_remove(
+            &object, items[2]), 0);
+    /* the removed item still leads on to what followed it */
+    struct coral_concurrent_linked_list_item *item;
+    assert_int_equal(coral_concurrent_linked_list_next(
+            &object, items[1], &item), 0);
+    assert_ptr_equal(item, items[3]);
+    assert_int_equal(coral_concurrent_linked_list_next(
+            &object, items[0], &item), 0);
+    assert_ptr_equal(item, items[3]);
+    assert_int_equal(coral_concurrent_linked_list_free(items[1]), 0);
+    assert_int_equal(coral_concurrent_linked_list_free(items[2]), 0);
+    assert_int_equal(coral_concurrent_linked_list_invalidate(
+            &object, NULL), 0);
+}
+
+static uintmax_t destroyed_items;
+
+static void on_destroy(struct coral_concurrent_linked_list_item *item) {
+    destroyed_items++;
+}
+
+static void check_invalidate_with_on_destroy(void **state) {
+    struct coral_concurrent_linked_list object;
+    assert_int_equal(coral_concurrent_linked_list_init(&object, compare), 0);
+    for (uintmax_t i = 0; i < 30; i++) {
+        add_value(&object, i);
+    }
+    destroyed_items = 0;
+    assert_int_equal(coral_concurrent_linked_list_invalidate(
+            &object, on_destroy), 0);
+    assert_int_equal(destroyed_items, 30);
+    assert_null(object.compare);
+}
+
+#define THREADS 4
+#define ROUNDS 2048
+#define VALUES 32
+
+struct worker {
+    struct coral_concurrent_linked_list *object;
+    struct coral_epoch *epoch;
+    uintmax_t index;
+};
+
+/* Even values are always present while the writers add and remove the odd
+ * ones, so readers must always find every even value in order. */
+static void *reader(void *const argument) {
+    struct worker *const worker = argument;
+    struct coral_epoch_thread thread;
+    seagrass_required_true(!coral_epoch_register(worker->epoch, &thread));
+    for (uintmax_t i = 0; i < ROUNDS / VALUES; i++) {
+        seagrass_required_true(!coral_epoch_enter(&thread));
+        struct coral_concurrent_linked_list_item *item;
+        seagrass_required_true(!coral_concurrent_linked_list_first(
+                worker->object, &item));
+        uintmax_t even = 0;
+        uintmax_t last = 0;
+        do {
+            const uintmax_t value = *(uintmax_t *) item;
+            seagrass_required_true(!even || last < value);
+            if (!(value % 2)) {
+                seagrass_required_true(2 * even++ == value);
+            }
+            last = value;
+        } while (!coral_concurrent_linked_list_next(
+                worker->object, item, &item));
+        seagrass_required_true(VALUES == even);
+        seagrass_required_true(!coral_epoch_exit(&thread));
+    }
+    seagrass_required_true(!coral_epoch_unregister(&thread));
+    return NULL;
+}
+
+/* Every writer toggles the same odd values and retires what it removes,
+ * walking the linked list from within critical sections only. */
+static void toggle(struct worker *const worker,
+                   struct coral_epoch_thread *const thread,
+                   const uintmax_t key) {
+    struct coral_concurrent_linked_list_item *item;
+    int error;
+    if (!coral_concurrent_linked_list_get(worker->object, &key, &item)) {
+        error = coral_concurrent_linked_list_remove(worker->object, item);
+        seagrass_required_true(
+                !error
+                || CORAL_CONCURRENT_LINKED_LIST_ERROR_ITEM_NOT_FOUND
+                   == error);
+        if (!error) {
+            seagrass_required_true(!coral_concurrent_linked_list_retire(
+                    thread, item));
+        }
+        return;
+    }
+    seagrass_required_true(!coral_concurrent_linked_list_alloc(
+            sizeof(uintmax_t), &item));
+    *(uintmax_t *) item = key;
+    error = coral_concurrent_linked_list_add(worker->object, item);
+    seagrass_required_true(
+            !error
+            || CORAL_CONCURRENT_LINKED_LIST_ERROR_ITEM_ALREADY_EXISTS
+               == error);
+    if (error) {
+        seagrass_required_true(!coral_concurrent_linked_list_free(item));
+    }
+}
+
+static void *writer(void *const argument) {
+    struct worker *const worker = argument;
+    struct coral_epoch_thread thread;
+    seagrass_required_true(!coral_epoch_register(worker->epoch, &thread));
+    for (uintmax_t i = 0; i < ROUNDS; i++) {
+        seagrass_required_true(!coral_epoch_enter(&thread));
+        toggle(worker, &thread, 2 * ((i + worker->index) % VALUES) + 1);
+        seagrass_required_true(!coral_epoch_exit(&thread));
+    }
+    seagrass_required_true(!coral_epoch_unregister(&thread));
+    return NULL;
+}
+
+static void check_readers_and_writers(void **state) {
+    struct coral_concurrent_linked_list object;
+    assert_int_equal(coral_concurrent_linked_list_init(&object, compare), 0);
+    struct coral_epoch epoch;
+    assert_int_equal(coral_epoch_init(&epoch), 0);
+    for (uintmax_t i = 0; i < VALUES; i++) {
+        add_value(&object, 2 * i);
+    }
+    pthread_t threads[2 * THREADS];
+    struct worker workers[2 * THREADS];
+    for (uintmax_t i = 0; i < 2 * THREADS; i++) {
+        workers[i] = (struct worker) {
+                .object = &object,
+                .epoch = &epoch,
+                .index = i % THREADS
+        };
+        assert_int_equal(pthread_create(&threads[i], NULL,
+                                        i < THREADS ? reader : writer,
+                                        &workers[i]), 0);
+    }
+    for (uintmax_t i = 0; i < 2 * THREADS; i++) {
+        assert_int_equal(pthread_join(threads[i], NULL), 0);
+    }
+    assert_int_equal(coral_epoch_invalidate(&epoch), 0);
+    /* whichever odd values are left, the count must match the items */
+    uintmax_t count;
+    assert_int_equal(coral_concurrent_linked_list_count(&object, &count), 0);
+    struct coral_concurrent_linked_list_item *item;
+    assert_int_equal(coral_concurrent_linked_list_first(&object, &item), 0);
+    uintmax_t items = 1;
+    while (!coral_concurrent_linked_list_next(&object, item, &item)) {
+        items++;
+    }
+    assert_int_equal(count, items);
+    assert_int_equal(coral_concurrent_linked_list_invalidate(
+            &object, NULL), 0);
+}
+
+int main(int argc, char *argv[]) {
+    const struct CMUnitTest tests[] = {
+            cmocka_unit_test(check_free_error_on_item_is_null),
+            cmocka_unit_test(check_free),
+            cmocka_unit_test(check_retire_error_on_thread_is_null),
+            cmocka_unit_test(check_retire_error_on_item_is_null),
+            cmocka_unit_test(check_retire),
+            cmocka_unit_test(check_alloc_error_on_size_is_zero),
+            cmocka_unit_test(check_alloc_error_on_out_is_null),
+            cmocka_unit_test(check_alloc_error_on_size_is_too_large),
+            cmocka_unit_test(check_alloc_error_on_memory_allocation_failed),
+            cmocka_unit_test(check_alloc_with),
+            cmocka_unit_test(check_init_error_on_object_is_null),
+            cmocka_unit_test(check_init_error_on_compare_is_null),
+            cmocka_unit_test(check_init),
+            cmocka_unit_test(check_invalidate_error_on_object_is_null),
+            cmocka_unit_test(check_count_error_on_object_is_null),
+            cmocka_unit_test(check_count_error_on_out_is_null),
+            cmocka_unit_test(check_add_error_on_object_is_null),
+            cmocka_unit_test(check_add_error_on_item_is_null),
+            cmocka_unit_test(check_remove_error_on_object_is_null),
+            cmocka_unit_test(check_remove_error_on_item_is_null),
+            cmocka_unit_test(check_get_error_on_object_is_null),
+            cmocka_unit_test(check_get_error_on_key_is_null),
+            cmocka_unit_test(check_get_error_on_out_is_null),
+            cmocka_unit_test(check_first_error_on_object_is_null),
+            cmocka_unit_test(check_first_error_on_out_is_null),
+            cmocka_unit_test(check_first_error_on_list_is_empty),
+            cmocka_unit_test(check_next_error_on_object_is_null),
+            cmocka_unit_test(check_next_error_on_item_is_null),
+            cmocka_unit_test(check_next_error_on_out_is_null),
+            cmocka_unit_test(check_add_get_and_remove),
+            cmocka_unit_test(check_add_error_on_item_already_exists),
+            cmocka_unit_test(check_first_and_next_in_order),
+            cmocka_unit_test(check_next_after_remove),
+            cmocka_unit_test(check_invalidate_with_on_destroy),
+            cmocka_unit_test(check_readers_and_writers),
+    };
+    //cmocka_set_message_output(CM_OUTPUT_XML);
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
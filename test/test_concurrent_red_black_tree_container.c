@@ -0,0 +1,459 @@
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <setjmp.h>
+#include <stdlib.h>
+#include <pthread.h>
+#include <cmocka.h>
+#include <coral.h>
+#include <seagrass.h>
+
+#include <test/cmocka.h>
+
+static int compare(const void *a, const void *b) {
+    return seagrass_uintmax_t_ptr_compare(a, b);
+}
+
+static int compare_key(const void *key, const void *entry) {
+    return seagrass_uintmax_t_ptr_compare(key, entry);
+}
+
+static void check_init_error_on_object_is_null(void **state) {
+    assert_int_equal(
+            coral_concurrent_red_black_tree_container_init(NULL, compare),
+            CORAL_CONCURRENT_RED_BLACK_TREE_CONTAINER_ERROR_OBJECT_IS_NULL);
+}
+
+static void check_init_error_on_compare_is_null(void **state) {
+    struct coral_concurrent_red_black_tree_container object;
+    assert_int_equal(
+            coral_concurrent_red_black_tree_container_init(&object, NULL),
+            CORAL_CONCURRENT_RED_BLACK_TREE_CONTAINER_ERROR_COMPARE_IS_NULL);
+}
+
+static void check_init_error_on_memory_allocation_failed(void **state) {
+    struct coral_concurrent_red_black_tree_container object;
+    posix_memalign_is_overridden = true;
+    assert_int_equal(
+            coral_concurrent_red_black_tree_container_init(&object, compare),
+            CORAL_CONCURRENT_RED_BLACK_TREE_CONTAINER_ERROR_MEMORY_ALLOCATION_FAILED);
+    posix_memalign_is_overridden = false;
+}
+
+static void check_init(void **state) {
+    struct coral_concurrent_red_black_tree_container object;
+    assert_int_equal(coral_concurrent_red_black_tree_container_init(
+            &object, compare), 0);
+    assert_non_null(object.lock.slots);
+    assert_int_equal(coral_concurrent_red_black_tree_container_invalidate(
+            &object, NULL), 0);
+}
+
+static void check_init_with_key_error_on_object_is_null(void **state) {
+    assert_int_equal(
+            coral_concurrent_red_black_tree_container_init_with_key(
+                    NULL, compare, compare_key),
+            CORAL_CONCURRENT_RED_BLACK_TREE_CONTAINER_ERROR_OBJECT_IS_NULL);
+}
+
+static void check_init_with_key_error_on_compare_is_null(void **state) {
+    struct coral_concurrent_red_black_tree_container object;
+    assert_int_equal(
+            coral_concurrent_red_black_tree_container_init_with_key(
+                    &object, NULL, compare_key),
+            CORAL_CONCURRENT_RED_BLACK_TREE_CONTAINER_ERROR_COMPARE_IS_NULL);
+    assert_int_equal(
+            coral_concurrent_red_black_tree_container_init_with_key(
+                    &object, compare, NULL),
+            CORAL_CONCURRENT_RED_BLACK_TREE_CONTAINER_ERROR_COMPARE_IS_NULL);
+}
+
+static void check_init_with_key(void **state) {
+    struct coral_concurrent_red_black_tree_container object;
+    assert_int_equal(coral_concurrent_red_black_tree_container_init_with_key(
+            &object, compare, compare_key), 0);
+    assert_int_equal(coral_concurrent_red_black_tree_container_invalidate(
+            &object, NULL), 0);
+}
+
+static void check_invalidate_error_on_object_is_null(void **state) {
+    assert_int_equal(
+            coral_concurrent_red_black_tree_container_invalidate(NULL, NULL),
+            CORAL_CONCURRENT_RED_BLACK_TREE_CONTAINER_ERROR_OBJECT_IS_NULL);
+}
+
+static void check_count_error_on_object_is_null(void **state) {
+    assert_int_equal(
+            coral_concurrent_red_black_tree_container_count(NULL, (void *) 1),
+            CORAL_CONCURRENT_RED_BLACK_TREE_CONTAINER_ERROR_OBJECT_IS_NULL);
+}
+
+static void check_add_error_on_object_is_null(void **state) {
+    assert_int_equal(
+            coral_concurrent_red_black_tree_container_add(NULL, (void *) 1),
+            CORAL_CONCURRENT_RED_BLACK_TREE_CONTAINER_ERROR_OBJECT_IS_NULL);
+}
+
+static void check_remove_error_on_object_is_null(void **state) {
+    assert_int_equal(
+            coral_concurrent_red_black_tree_container_remove(NULL, (void *) 1),
+            CORAL_CONCURRENT_RED_BLACK_TREE_CONTAINER_ERROR_OBJECT_IS_NULL);
+}
+
+static void check_get_error_on_object_is_null(void **state) {
+    assert_int_equal(
+            coral_concurrent_red_black_tree_container_get(
+                    NULL, (void *) 1, (void *) 1),
+            CORAL_CONCURRENT_RED_BLACK_TREE_CONTAINER_ERROR_OBJECT_IS_NULL);
+}
+
+static void check_get_key_error_on_object_is_null(void **state) {
+    assert_int_equal(
+            coral_concurrent_red_black_tree_container_get_key(
+                    NULL, (void *) 1, (void *) 1),
+            CORAL_CONCURRENT_RED_BLACK_TREE_CONTAINER_ERROR_OBJECT_IS_NULL);
+}
+
+static void check_ceiling_error_on_object_is_null(void **state) {
+    assert_int_equal(
+            coral_concurrent_red_black_tree_container_ceiling(
+                    NULL, (void *) 1, (void *) 1),
+            CORAL_CONCURRENT_RED_BLACK_TREE_CONTAINER_ERROR_OBJECT_IS_NULL);
+}
+
+static void check_ceiling_key_error_on_object_is_null(void **state) {
+    assert_int_equal(
+            coral_concurrent_red_black_tree_container_ceiling_key(
+                    NULL, (void *) 1, (void *) 1),
+            CORAL_CONCURRENT_RED_BLACK_TREE_CONTAINER_ERROR_OBJECT_IS_NULL);
+}
+
+static void check_floor_error_on_object_is_null(void **state) {
+    assert_int_equal(
+            coral_concurrent_red_black_tree_container_floor(
+                    NULL, (void *) 1, (void *) 1),
+            CORAL_CONCURRENT_RED_BLACK_TREE_CONTAINER_ERROR_OBJECT_IS_NULL);
+}
+
+static void check_floor_key_error_on_object_is_null(void **state) {
+    assert_int_equal(
+            coral_concurrent_red_black_tree_container_floor_key(
+                    NULL, (void *) 1, (void *) 1),
+            CORAL_CONCURRENT_RED_BLACK_TREE_CONTAINER_ERROR_OBJECT_IS_NULL);
+}
+
+static void check_higher_error_on_object_is_null(void **state) {
+    assert_int_equal(
+            coral_concurrent_red_black_tree_container_higher(
+                    NULL, (void *) 1, (void *) 1),
+            CORAL_CONCURRENT_RED_BLACK_TREE_CONTAINER_ERROR_OBJECT_IS_NULL);
+}
+
+static void check_higher_key_error_on_object_is_null(void **state) {
+    assert_int_equal(
+            coral_concurrent_red_black_tree_container_higher_key(
+                    NULL, (void *) 1, (void *) 1),
+            CORAL_CONCURRENT_RED_BLACK_TREE_CONTAINER_ERROR_OBJECT_IS_NULL);
+}
+
+static void check_lower_error_on_object_is_null(void **state) {
+    assert_int_equal(
+            coral_concurrent_red_black_tree_container_lower(
+                    NULL, (void *) 1, (void *) 1),
+            CORAL_CONCURRENT_RED_BLACK_TREE_CONTAINER_ERROR_OBJECT_IS_NULL);
+}
+
+static void check_lower_key_error_on_object_is_null(void **state) {
+    assert_int_equal(
+            coral_concurrent_red_black_tree_container_lower_key(
+                    NULL, (void *) 1, (void *) 1),
+            CORAL_CONCURRENT_RED_BLACK_TREE_CONTAINER_ERROR_OBJECT_IS_NULL);
+}
+
+static void check_read_error_on_object_is_null(void **state) {
+    assert_int_equal(
+            coral_concurrent_red_black_tree_container_read(
+                    NULL, (void *) 1, NULL),
+            CORAL_CONCURRENT_RED_BLACK_TREE_CONTAINER_ERROR_OBJECT_IS_NULL);
+}
+
+static void check_read_error_on_function_is_null(void **state) {
+    assert_int_equal(
+            coral_concurrent_red_black_tree_container_read(
+                    (void *) 1, NULL, NULL),
+            CORAL_CONCURRENT_RED_BLACK_TREE_CONTAINER_ERROR_FUNCTION_IS_NULL);
+}
+
+static void check_write_error_on_object_is_null(void **state) {
+    assert_int_equal(
+            coral_concurrent_red_black_tree_container_write(
+                    NULL, (void *) 1, NULL),
+            CORAL_CONCURRENT_RED_BLACK_TREE_CONTAINER_ERROR_OBJECT_IS_NULL);
+}
+
+static void check_write_error_on_function_is_null(void **state) {
+    assert_int_equal(
+            coral_concurrent_red_black_tree_container_write(
+                    (void *) 1, NULL, NULL),
+            CORAL_CONCURRENT_RED_BLACK_TREE_CONTAINER_ERROR_FUNCTION_IS_NULL);
+}
+
+static void add_value(
+        struct coral_concurrent_red_black_tree_container *const object,
+        const uintmax_t value) {
+    struct coral_red_black_tree_container_entry *entry;
+    assert_int_equal(coral_red_black_tree_container_alloc(
+            sizeof(uintmax_t), &entry), 0);
+    *(uintmax_t *) entry = value;
+    assert_int_equal(coral_concurrent_red_black_tree_container_add(
+            object, entry), 0);
+}
+
+static void check_add_get_and_remove(void **state) {
+    struct coral_concurrent_red_black_tree_container object;
+    assert_int_equal(coral_concurrent_red_black_tree_container_init(
+            &object, compare), 0);
+    for (uintmax_t i = 0; i < 10; i++) {
+        add_value(&object, 2 * i);
+    }
+    uintmax_t count;
+    assert_int_equal(coral_concurrent_red_black_tree_container_count(
+            &object, &count), 0);
+    assert_int_equal(count, 10);
+    struct coral_red_black_tree_container_entry *entry;
+    uintmax_t key = 4;
+    assert_int_equal(coral_concurrent_red_black_tree_container_get(
+            &object, &key, &entry), 0);
+    assert_int_equal(*(uintmax_t *) entry, 4);
+    assert_int_equal(
+            coral_concurrent_red_black_tree_container_add(&object, entry),
+            CORAL_CONCURRENT_RED_BLACK_TREE_CONTAINER_ERROR_ENTRY_ALREADY_EXISTS);
+    assert_int_equal(coral_concurrent_red_black_tree_container_remove(
+            &object, entry), 0);
+    assert_int_equal(coral_red_black_tree_container_free(entry), 0);
+    assert_int_equal(
+            coral_concurrent_red_black_tree_container_get(
+                    &object, &key, &entry),
+            CORAL_CONCURRENT_RED_BLACK_TREE_CONTAINER_ERROR_ENTRY_NOT_FOUND);
+    assert_int_equal(coral_concurrent_red_black_tree_container_count(
+            &object, &count), 0);
+    assert_int_equal(count, 9);
+    assert_int_equal(coral_concurrent_red_black_tree_container_invalidate(
+            &object, NULL), 0);
+}
+
+static void check_lookups(void **state) {
+    struct coral_concurrent_red_black_tree_container object;
+    assert_int_equal(coral_concurrent_red_black_tree_container_init_with_key(
+            &object, compare, compare_key), 0);
+    for (uintmax_t i = 0; i < 10; i++) {
+        add_value(&object, 2 * i);
+    }
+    struct coral_red_black_tree_container_entry *entry;
+    uintmax_t key = 5;
+    assert_int_equal(coral_concurrent_red_black_tree_container_get_key(
+            &object, &key, &entry),
+            CORAL_CONCURRENT_RED_BLACK_TREE_CONTAINER_ERROR_ENTRY_NOT_FOUND);
+    assert_int_equal(coral_concurrent_red_black_tree_container_ceiling(
+            &object, &key, &entry), 0);
+    assert_int_equal(*(uintmax_t *) entry, 6);
+    assert_int_equal(coral_concurrent_red_black_tree_container_ceiling_key(
+            &object, &key, &entry), 0);
+    assert_int_equal(*(uintmax_t *) entry, 6);
+    assert_int_equal(coral_concurrent_red_black_tree_container_floor(
+            &object, &key, &entry), 0);
+    assert_int_equal(*(uintmax_t *) entry, 4);
+    assert_int_equal(coral_concurrent_red_black_tree_container_floor_key(
+            &object, &key, &entry), 0);
+    assert_int_equal(*(uintmax_t *) entry, 4);
+    key = 6;
+    assert_int_equal(coral_concurrent_red_black_tree_container_get_key(
+            &object, &key, &entry), 0);
+    assert_int_equal(*(uintmax_t *) entry, 6);
+    assert_int_equal(coral_concurrent_red_black_tree_container_higher(
+            &object, &key, &entry), 0);
+    assert_int_equal(*(uintmax_t *) entry, 8);
+    assert_int_equal(coral_concurrent_red_black_tree_container_higher_key(
+            &object, &key, &entry), 0);
+    assert_int_equal(*(uintmax_t *) entry, 8);
+    assert_int_equal(coral_concurrent_red_black_tree_container_lower(
+            &object, &key, &entry), 0);
+    assert_int_equal(*(uintmax_t *) entry, 4);
+    assert_int_equal(coral_concurrent_red_black_tree_container_lower_key(
+            &object, &key, &entry), 0);
+    assert_int_equal(*(uintmax_t *) entry, 4);
+    assert_int_equal(coral_concurrent_red_black_tree_container_invalidate(
+            &object, NULL), 0);
+}
+
+static int sum(const struct coral_red_black_tree_container *const container,
+               void *const context) {
+    uintmax_t *const out = context;
+    struct coral_red_black_tree_container_entry *entry;
+    int error = coral_red_black_tree_container_first(container, &entry);
+    while (!error) {
+        *out += *(uintmax_t *) entry;
+        error = coral_red_black_tree_container_next(entry, &entry);
+    }
+    return CORAL_RED_BLACK_TREE_CONTAINER_ERROR_END_OF_SEQUENCE == error
+           ? 0 : error;
+}
+
+static int remove_first(struct coral_red_black_tree_container *const container,
+                        void *const context) {
+    int error;
+    struct coral_red_black_tree_container_entry *entry;
+    if ((error = coral_red_black_tree_container_first(container, &entry))) {
+        return error;
+    }
+    seagrass_required_true(!coral_red_black_tree_container_remove(
+            container, entry));
+    seagrass_required_true(!coral_red_black_tree_container_free(entry));
+    return 0;
+}
+
+static void check_read_and_write(void **state) {
+    struct coral_concurrent_red_black_tree_container object;
+    assert_int_equal(coral_concurrent_red_black_tree_container_init(
+            &object, compare), 0);
+    for (uintmax_t i = 1; i <= 10; i++) {
+        add_value(&object, i);
+    }
+    uintmax_t total = 0;
+    assert_int_equal(coral_concurrent_red_black_tree_container_read(
+            &object, sum, &total), 0);
+    assert_int_equal(total, 55);
+    assert_int_equal(coral_concurrent_red_black_tree_container_write(
+            &object, remove_first, NULL), 0);
+    total = 0;
+    assert_int_equal(coral_concurrent_red_black_tree_container_read(
+            &object, sum, &total), 0);
+    assert_int_equal(total, 54);
+    assert_int_equal(coral_concurrent_red_black_tree_container_invalidate(
+            &object, NULL), 0);
+    assert_int_equal(coral_concurrent_red_black_tree_container_init(
+            &object, compare), 0);
+    assert_int_equal(
+            coral_concurrent_red_black_tree_container_write(
+                    &object, remove_first, NULL),
+            CORAL_CONCURRENT_RED_BLACK_TREE_CONTAINER_ERROR_CONTAINER_IS_EMPTY);
+    assert_int_equal(coral_concurrent_red_black_tree_container_invalidate(
+            &object, NULL), 0);
+}
+
+#define THREADS 4
+#define ROUNDS 2048
+#define VALUES 64
+
+struct worker {
+    struct coral_concurrent_red_black_tree_container *object;
+    uintmax_t index;
+};
+
+/* Even values are always present, the writer adds and removes the odd ones,
+ * so readers must always find every even value and a count that lies
+ * between the even values alone and all values. */
+static void *reader(void *const argument) {
+    struct worker *const worker = argument;
+    for (uintmax_t i = 0; i < ROUNDS; i++) {
+        const uintmax_t key = 2 * ((i + worker->index) % VALUES);
+        struct coral_red_black_tree_container_entry *entry;
+        seagrass_required_true(!coral_concurrent_red_black_tree_container_get(
+                worker->object, &key, &entry));
+        seagrass_required_true(key == *(uintmax_t *) entry);
+        uintmax_t count;
+        seagrass_required_true(!coral_concurrent_red_black_tree_container_count(
+                worker->object, &count));
+        seagrass_required_true(VALUES <= count && count <= 2 * VALUES);
+    }
+    return NULL;
+}
+
+static void *writer(void *const argument) {
+    struct worker *const worker = argument;
+    for (uintmax_t i = 0; i < ROUNDS; i++) {
+        const uintmax_t key = 2 * (i % VALUES) + 1;
+        struct coral_red_black_tree_container_entry *entry;
+        if (!coral_concurrent_red_black_tree_container_get(
+                worker->object, &key, &entry)) {
+            seagrass_required_true(
+                    !coral_concurrent_red_black_tree_container_remove(
+                            worker->object, entry));
+            seagrass_required_true(!coral_red_black_tree_container_free(
+                    entry));
+        } else {
+            seagrass_required_true(!coral_red_black_tree_container_alloc(
+                    sizeof(uintmax_t), &entry));
+            *(uintmax_t *) entry = key;
+            seagrass_required_true(
+                    !coral_concurrent_red_black_tree_container_add(
+                            worker->object, entry));
+        }
+    }
+    return NULL;
+}
+
+static void check_readers_and_writer(void **state) {
+    struct coral_concurrent_red_black_tree_container object;
+    assert_int_equal(coral_concurrent_red_black_tree_container_init(
+            &object, compare), 0);
+    for (uintmax_t i = 0; i < VALUES; i++) {
+        add_value(&object, 2 * i);
+    }
+    pthread_t threads[THREADS + 1];
+    struct worker workers[THREADS + 1];
+    for (uintmax_t i = 0; i <= THREADS; i++) {
+        workers[i] = (struct worker) {
+                .object = &object,
+                .index = i
+        };
+        assert_int_equal(pthread_create(&threads[i], NULL,
+                                        i ? reader : writer, &workers[i]), 0);
+    }
+    for (uintmax_t i = 0; i <= THREADS; i++) {
+        assert_int_equal(pthread_join(threads[i], NULL), 0);
+    }
+    uintmax_t total = 0;
+    assert_int_equal(coral_concurrent_red_black_tree_container_read(
+            &object, sum, &total), 0);
+    /* every odd value was added and removed the same number of times */
+    assert_int_equal(total, VALUES * (VALUES - 1));
+    assert_int_equal(coral_concurrent_red_black_tree_container_invalidate(
+            &object, NULL), 0);
+}
+
+int main(int argc, char *argv[]) {
+    const struct CMUnitTest tests[] = {
+            cmocka_unit_test(check_init_error_on_object_is_null),
+            cmocka_unit_test(check_init_error_on_compare_is_null),
+            cmocka_unit_test(check_init_error_on_memory_allocation_failed),
+            cmocka_unit_test(check_init),
+            cmocka_unit_test(check_init_with_key_error_on_object_is_null),
+            cmocka_unit_test(check_init_with_key_error_on_compare_is_null),
+            cmocka_unit_test(check_init_with_key),
+            cmocka_unit_test(check_invalidate_error_on_object_is_null),
+            cmocka_unit_test(check_count_error_on_object_is_null),
+            cmocka_unit_test(check_add_error_on_object_is_null),
+            cmocka_unit_test(check_remove_error_on_object_is_null),
+            cmocka_unit_test(check_get_error_on_object_is_null),
+            cmocka_unit_test(check_get_key_error_on_object_is_null),
+            cmocka_unit_test(check_ceiling_error_on_object_is_null),
+            cmocka_unit_test(check_ceiling_key_error_on_object_is_null),
+            cmocka_unit_test(check_floor_error_on_object_is_null),
+            cmocka_unit_test(check_floor_key_error_on_object_is_null),
+            cmocka_unit_test(check_higher_error_on_object_is_null),
+            cmocka_unit_test(check_higher_key_error_on_object_is_null),
+            cmocka_unit_test(check_lower_error_on_object_is_null),
+            cmocka_unit_test(check_lower_key_error_on_object_is_null),
+            cmocka_unit_test(check_read_error_on_object_is_null),
+            cmocka_unit_test(check_read_error_on_function_is_null),
+            cmocka_unit_test(check_write_error_on_object_is_null),
+            cmocka_unit_test(check_write_error_on_function_is_null),
+            cmocka_unit_test(check_add_get_and_remove),
+            cmocka_unit_test(check_lookups),
+            cmocka_unit_test(check_read_and_write),
+            cmocka_unit_test(check_readers_and_writer),
+    };
+    //cmocka_set_message_output(CM_OUTPUT_XML);
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
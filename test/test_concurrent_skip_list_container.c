@@ -0,0 +1,853 @@
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <setjmp.h>
+#include <stdlib.h>
+#include <pthread.h>
+#include <cmocka.h>
+#include <coral.h>
+#include <seagrass.h>
+
+#include <test/cmocka.h>
+
+#include "statistics_allocator.h"
+
+static int compare(const void *a, const void *b) {
+    return seagrass_uintmax_t_ptr_compare(a, b);
+}
+
+static void check_free_error_on_entry_is_null(void **state) {
+    assert_int_equal(
+            coral_concurrent_skip_list_container_free(NULL),
+            CORAL_CONCURRENT_SKIP_LIST_CONTAINER_ERROR_ENTRY_IS_NULL);
+}
+
+static void check_free(void **state) {
+    struct coral_concurrent_skip_list_container_entry *entry;
+    assert_int_equal(coral_concurrent_skip_list_container_alloc(1, &entry), 0);
+    assert_int_equal(coral_concurrent_skip_list_container_free(entry), 0);
+}
+
+static void check_retire_error_on_thread_is_null(void **state) {
+    struct coral_concurrent_skip_list_container_entry *entry;
+    assert_int_equal(coral_concurrent_skip_list_container_alloc(1, &entry), 0);
+    assert_int_equal(
+            coral_concurrent_skip_list_container_retire(NULL, entry),
+            CORAL_CONCURRENT_SKIP_LIST_CONTAINER_ERROR_THREAD_IS_NULL);
+    assert_int_equal(coral_concurrent_skip_list_container_free(entry), 0);
+}
+
+static void check_retire_error_on_entry_is_null(void **state) {
+    struct coral_epoch_thread thread;
+    assert_int_equal(
+            coral_concurrent_skip_list_container_retire(&thread, NULL),
+            CORAL_CONCURRENT_SKIP_LIST_CONTAINER_ERROR_ENTRY_IS_NULL);
+}
+
+static void check_retire(void **state) {
+    struct coral_epoch epoch;
+    assert_int_equal(coral_epoch_init(&epoch), 0);
+    struct coral_epoch_thread thread;
+    assert_int_equal(coral_epoch_register(&epoch, &thread), 0);
+    struct coral_concurrent_skip_list_container_entry *entry;
+    assert_int_equal(coral_concurrent_skip_list_container_alloc(1, &entry), 0);
+    assert_int_equal(coral_concurrent_skip_list_container_retire(
+            &thread, entry), 0);
+    assert_int_equal(coral_epoch_unregister(&thread), 0);
+    /* the entry is freed here at the latest */
+    assert_int_equal(coral_epoch_invalidate(&epoch), 0);
+}
+
+static void check_alloc_error_on_size_is_zero(void **state) {
+    assert_int_equal(
+            coral_concurrent_skip_list_container_alloc(0, (void *) 1),
+            CORAL_CONCURRENT_SKIP_LIST_CONTAINER_ERROR_SIZE_IS_ZERO);
+}
+
+static void check_alloc_error_on_out_is_null(void **state) {
+    assert_int_equal(
+            coral_concurrent_skip_list_container_alloc(1, NULL),
+            CORAL_CONCURRENT_SKIP_LIST_CONTAINER_ERROR_OUT_IS_NULL);
+}
+
+static void check_alloc_error_on_size_is_too_large(void **state) {
+    assert_int_equal(
+            coral_concurrent_skip_list_container_alloc(UINTMAX_MAX, (void *) 1),
+            CORAL_CONCURRENT_SKIP_LIST_CONTAINER_ERROR_SIZE_IS_TOO_LARGE);
+}
+
+static void check_alloc_error_on_memory_allocation_failed(void **state) {
+    malloc_is_overridden = calloc_is_overridden = realloc_is_overridden
+            = posix_memalign_is_overridden = true;
+    assert_int_equal(
+            coral_concurrent_skip_list_container_alloc(1, (void *) 1),
+            CORAL_CONCURRENT_SKIP_LIST_CONTAINER_ERROR_MEMORY_ALLOCATION_FAILED);
+    malloc_is_overridden = calloc_is_overridden = realloc_is_overridden
+            = posix_memalign_is_overridden = false;
+}
+
+static void check_alloc_with(void **state) {
+    struct statistics statistics = {};
+    const struct coral_allocator allocator = {
+            .alloc = statistics_alloc,
+            .free = statistics_free,
+            .context = &statistics
+    };
+    struct coral_concurrent_skip_list_container_entry *entry;
+    assert_int_equal(coral_concurrent_skip_list_container_alloc_with(
+            &allocator, 1, &entry), 0);
+    assert_int_equal(statistics.alloc, 1);
+    assert_int_equal(coral_concurrent_skip_list_container_free(entry), 0);
+    assert_int_equal(statistics.free, 1);
+}
+
+static void check_init_error_on_object_is_null(void **state) {
+    assert_int_equal(
+            coral_concurrent_skip_list_container_init(NULL, compare),
+            CORAL_CONCURRENT_SKIP_LIST_CONTAINER_ERROR_OBJECT_IS_NULL);
+}
+
+static void check_init_error_on_compare_is_null(void **state) {
+    struct coral_concurrent_skip_list_container object;
+    assert_int_equal(
+            coral_concurrent_skip_list_container_init(&object, NULL),
+            CORAL_CONCURRENT_SKIP_LIST_CONTAINER_ERROR_COMPARE_IS_NULL);
+}
+
+static void check_init(void **state) {
+    struct coral_concurrent_skip_list_container object;
+    assert_int_equal(coral_concurrent_skip_list_container_init(
+            &object, compare), 0);
+    assert_ptr_equal(object.compare, compare);
+    uintmax_t count;
+    assert_int_equal(coral_concurrent_skip_list_container_count(
+            &object, &count), 0);
+    assert_int_equal(count, 0);
+    assert_int_equal(coral_concurrent_skip_list_container_invalidate(
+            &object, NULL), 0);
+}
+
+static void check_invalidate_error_on_object_is_null(void **state) {
+    assert_int_equal(
+            coral_concurrent_skip_list_container_invalidate(NULL, NULL),
+            CORAL_CONCURRENT_SKIP_LIST_CONTAINER_ERROR_OBJECT_IS_NULL);
+}
+
+static void check_count_error_on_object_is_null(void **state) {
+    assert_int_equal(
+            coral_concurrent_skip_list_container_count(NULL, (void *) 1),
+            CORAL_CONCURRENT_SKIP_LIST_CONTAINER_ERROR_OBJECT_IS_NULL);
+}
+
+static void check_count_error_on_out_is_null(void **state) {
+    assert_int_equal(
+            coral_concurrent_skip_list_container_count((void *) 1, NULL),
+            CORAL_CONCURRENT_SKIP_LIST_CONTAINER_ERROR_OUT_IS_NULL);
+}
+
+static void check_add_error_on_object_is_null(void **state) {
+    assert_int_equal(
+            coral_concurrent_skip_list_container_add(NULL, (void *) 1),
+            CORAL_CONCURRENT_SKIP_LIST_CONTAINER_ERROR_OBJECT_IS_NULL);
+}
+
+static void check_add_error_on_entry_is_null(void **state) {
+    assert_int_equal(
+            coral_concurrent_skip_list_container_add((void *) 1, NULL),
+            CORAL_CONCURRENT_SKIP_LIST_CONTAINER_ERROR_ENTRY_IS_NULL);
+}
+
+static void check_remove_error_on_object_is_null(void **state) {
+    assert_int_equal(
+            coral_concurrent_skip_list_container_remove(NULL, (void *) 1),
+            CORAL_CONCURRENT_SKIP_LIST_CONTAINER_ERROR_OBJECT_IS_NULL);
+}
+
+static void check_remove_error_on_entry_is_null(void **state) {
+    assert_int_equal(
+            coral_concurrent_skip_list_container_remove((void *) 1, NULL),
+            CORAL_CONCURRENT_SKIP_LIST_CONTAINER_ERROR_ENTRY_IS_NULL);
+}
+
+static void check_get_error_on_object_is_null(void **state) {
+    assert_int_equal(
+            coral_concurrent_skip_list_container_get(
+                    NULL, (void *) 1, (void *) 1),
+            CORAL_CONCURRENT_SKIP_LIST_CONTAINER_ERROR_OBJECT_IS_NULL);
+}
+
+static void check_get_error_on_key_is_null(void **state) {
+    assert_int_equal(
+            coral_concurrent_skip_list_container_get(
+                    (void *) 1, NULL, (void *) 1),
+            CORAL_CONCURRENT_SKIP_LIST_CONTAINER_ERROR_KEY_IS_NULL);
+}
+
+static void check_get_error_on_out_is_null(void **state) {
+    assert_int_equal(
+            coral_concurrent_skip_list_container_get(
+                    (void *) 1, (void *) 1, NULL),
+            CORAL_CONCURRENT_SKIP_LIST_CONTAINER_ERROR_OUT_IS_NULL);
+}
+
+static void check_ceiling_error_on_object_is_null(void **state) {
+    assert_int_equal(
+            coral_concurrent_skip_list_container_ceiling(
+                    NULL, (void *) 1, (void *) 1),
+            CORAL_CONCURRENT_SKIP_LIST_CONTAINER_ERROR_OBJECT_IS_NULL);
+}
+
+static void check_ceiling_error_on_key_is_null(void **state) {
+    assert_int_equal(
+            coral_concurrent_skip_list_container_ceiling(
+                    (void *) 1, NULL, (void *) 1),
+            CORAL_CONCURRENT_SKIP_LIST_CONTAINER_ERROR_KEY_IS_NULL);
+}
+
+static void check_ceiling_error_on_out_is_null(void **state) {
+    assert_int_equal(
+            coral_concurrent_skip_list_container_ceiling(
+                    (void *) 1, (void *) 1, NULL),
+            CORAL_CONCURRENT_SKIP_LIST_CONTAINER_ERROR_OUT_IS_NULL);
+}
+
+static void check_floor_error_on_object_is_null(void **state) {
+    assert_int_equal(
+            coral_concurrent_skip_list_container_floor(
+                    NULL, (void *) 1, (void *) 1),
+            CORAL_CONCURRENT_SKIP_LIST_CONTAINER_ERROR_OBJECT_IS_NULL);
+}
+
+static void check_floor_error_on_key_is_null(void **state) {
+    assert_int_equal(
+            coral_concurrent_skip_list_container_floor(
+                    (void *) 1, NULL, (void *) 1),
+            CORAL_CONCURRENT_SKIP_LIST_CONTAINER_ERROR_KEY_IS_NULL);
+}
+
+static void check_floor_error_on_out_is_null(void **state) {
+    assert_int_equal(
+            coral_concurrent_skip_list_container_floor(
+                    (void *) 1, (void *) 1, NULL),
+            CORAL_CONCURRENT_SKIP_LIST_CONTAINER_ERROR_OUT_IS_NULL);
+}
+
+static void check_higher_error_on_object_is_null(void **state) {
+    assert_int_equal(
+            coral_concurrent_skip_list_container_higher(
+                    NULL, (void *) 1, (void *) 1),
+            CORAL_CONCURRENT_SKIP_LIST_CONTAINER_ERROR_OBJECT_IS_NULL);
+}
+
+static void check_higher_error_on_key_is_null(void **state) {
+    assert_int_equal(
+            coral_concurrent_skip_list_container_higher(
+                    (void *) 1, NULL, (void *) 1),
+            CORAL_CONCURRENT_SKIP_LIST_CONTAINER_ERROR_KEY_IS_NULL);
+}
+
+static void check_higher_error_on_out_is_null(void **state) {
+    assert_int_equal(
+            coral_concurrent_skip_list_container_higher(
+                    (void *) 1, (void *) 1, NULL),
+            CORAL_CONCURRENT_SKIP_LIST_CONTAINER_ERROR_OUT_IS_NULL);
+}
+
+static void check_lower_error_on_object_is_null(void **state) {
+    assert_int_equal(
+            coral_concurrent_skip_list_container_lower(
+                    NULL, (void *) 1, (void *) 1),
+            CORAL_CONCURRENT_SKIP_LIST_CONTAINER_ERROR_OBJECT_IS_NULL);
+}
+
+static void check_lower_error_on_key_is_null(void **state) {
+    assert_int_equal(
+            coral_concurrent_skip_list_container_lower(
+                    (void *) 1, NULL, (void *) 1),
+            CORAL_CONCURRENT_SKIP_LIST_CONTAINER_ERROR_KEY_IS_NULL);
+}
+
+static void check_lower_error_on_out_is_null(void **state) {
+    assert_int_equal(
+            coral_concurrent_skip_list_container_lower(
+                    (void *) 1, (void *) 1, NULL),
+            CORAL_CONCURRENT_SKIP_LIST_CONTAINER_ERROR_OUT_IS_NULL);
+}
+
+static void check_first_error_on_object_is_null(void **state) {
+    assert_int_equal(
+            coral_concurrent_skip_list_container_first(NULL, (void *) 1),
+            CORAL_CONCURRENT_SKIP_LIST_CONTAINER_ERROR_OBJECT_IS_NULL);
+}
+
+static void check_first_error_on_out_is_null(void **state) {
+    assert_int_equal(
+            coral_concurrent_skip_list_container_first((void *) 1, NULL),
+            CORAL_CONCURRENT_SKIP_LIST_CONTAINER_ERROR_OUT_IS_NULL);
+}
+
+static void check_last_error_on_object_is_null(void **state) {
+    assert_int_equal(
+            coral_concurrent_skip_list_container_last(NULL, (void *) 1),
+            CORAL_CONCURRENT_SKIP_LIST_CONTAINER_ERROR_OBJECT_IS_NULL);
+}
+
+static void check_last_error_on_out_is_null(void **state) {
+    assert_int_equal(
+            coral_concurrent_skip_list_container_last((void *) 1, NULL),
+            CORAL_CONCURRENT_SKIP_LIST_CONTAINER_ERROR_OUT_IS_NULL);
+}
+
+static void check_next_error_on_object_is_null(void **state) {
+    assert_int_equal(
+            coral_concurrent_skip_list_container_next(
+                    NULL, (void *) 1, (void *) 1),
+            CORAL_CONCURRENT_SKIP_LIST_CONTAINER_ERROR_OBJECT_IS_NULL);
+}
+
+static void check_next_error_on_entry_is_null(void **state) {
+    assert_int_equal(
+            coral_concurrent_skip_list_container_next(
+                    (void *) 1, NULL, (void *) 1),
+            CORAL_CONCURRENT_SKIP_LIST_CONTAINER_ERROR_ENTRY_IS_NULL);
+}
+
+static void check_next_error_on_out_is_null(void **state) {
+    assert_int_equal(
+            coral_concurrent_skip_list_container_next(
+                    (void *) 1, (void *) 1, NULL),
+            CORAL_CONCURRENT_SKIP_LIST_CONTAINER_ERROR_OUT_IS_NULL);
+}
+
+static void check_prev_error_on_object_is_null(void **state) {
+    assert_int_equal(
+            coral_concurrent_skip_list_container_prev(
+                    NULL, (void *) 1, (void *) 1),
+            CORAL_CONCURRENT_SKIP_LIST_CONTAINER_ERROR_OBJECT_IS_NULL);
+}
+
+static void check_prev_error_on_entry_is_null(void **state) {
+    assert_int_equal(
+            coral_concurrent_skip_list_container_prev(
+                    (void *) 1, NULL, (void *) 1),
+            CORAL_CONCURRENT_SKIP_LIST_CONTAINER_ERROR_ENTRY_IS_NULL);
+}
+
+static void check_prev_error_on_out_is_null(void **state) {
+    assert_int_equal(
+            coral_concurrent_skip_list_container_prev(
+                    (void *) 1, (void *) 1, NULL),
+            CORAL_CONCURRENT_SKIP_LIST_CONTAINER_ERROR_OUT_IS_NULL);
+}
+
+static struct coral_concurrent_skip_list_container_entry *add_value(
+        struct coral_concurrent_skip_list_container *const object,
+        const uintmax_t value) {
+    struct coral_concurrent_skip_list_container_entry *entry;
+    assert_int_equal(coral_concurrent_skip_list_container_alloc(
+            sizeof(uintmax_t), &entry), 0);
+    *(uintmax_t *) entry = value;
+    assert_int_equal(coral_concurrent_skip_list_container_add(
+            object, entry), 0);
+    return entry;
+}
+
+static void check_add_get_and_remove(void **state) {
+    struct coral_concurrent_skip_list_container object;
+    assert_int_equal(coral_concurrent_skip_list_container_init(
+            &object, compare), 0);
+    for (uintmax_t i = 0; i < 10; i++) {
+        add_value(&object, 2 * i);
+    }
+    uintmax_t count;
+    assert_int_equal(coral_concurrent_skip_list_container_count(
+            &object, &count), 0);
+    assert_int_equal(count, 10);
+    struct coral_concurrent_skip_list_container_entry *entry;
+    uintmax_t key = 4;
+    assert_int_equal(coral_concurrent_skip_list_container_get(
+            &object, &key, &entry), 0);
+    assert_int_equal(*(uintmax_t *) entry, 4);
+    assert_int_equal(
+            coral_concurrent_skip_list_container_add(&object, entry),
+            CORAL_CONCURRENT_SKIP_LIST_CONTAINER_ERROR_ENTRY_ALREADY_EXISTS);
+    assert_int_equal(coral_concurrent_skip_list_container_remove(
+            &object, entry), 0);
+    assert_int_equal(
+            coral_concurrent_skip_list_container_remove(&object, entry),
+            CORAL_CONCURRENT_SKIP_LIST_CONTAINER_ERROR_ENTRY_NOT_FOUND);
+    assert_int_equal(coral_concurrent_skip_list_container_free(entry), 0);
+    assert_int_equal(
+            coral_concurrent_skip_list_container_get(&object, &key, &entry),
+            CORAL_CONCURRENT_SKIP_LIST_CONTAINER_ERROR_ENTRY_NOT_FOUND);
+    assert_int_equal(coral_concurrent_skip_list_container_count(
+            &object, &count), 0);
+    assert_int_equal(count, 9);
+    assert_int_equal(coral_concurrent_skip_list_container_invalidate(
+            &object, NULL), 0);
+}
+
+static void check_add_error_on_entry_already_exists(void **state) {
+    struct coral_concurrent_skip_list_container object;
+    assert_int_equal(coral_concurrent_skip_list_container_init(
+            &object, compare), 0);
+    add_value(&object, 7);
+    struct coral_concurrent_skip_list_container_entry *entry;
+    assert_int_equal(coral_concurrent_skip_list_container_alloc(
+            sizeof(uintmax_t), &entry), 0);
+    *(uintmax_t *) entry = 7;
+    assert_int_equal(
+            coral_concurrent_skip_list_container_add(&object, entry),
+            CORAL_CONCURRENT_SKIP_LIST_CONTAINER_ERROR_ENTRY_ALREADY_EXISTS);
+    /* an equal entry that is not the one in the container is not removed */
+    assert_int_equal(
+            coral_concurrent_skip_list_container_remove(&object, entry),
+            CORAL_CONCURRENT_SKIP_LIST_CONTAINER_ERROR_ENTRY_NOT_FOUND);
+    assert_int_equal(coral_concurrent_skip_list_container_free(entry), 0);
+    assert_int_equal(coral_concurrent_skip_list_container_invalidate(
+            &object, NULL), 0);
+}
+
+static void check_lookups(void **state) {
+    struct coral_concurrent_skip_list_container object;
+    assert_int_equal(coral_concurrent_skip_list_container_init(
+            &object, compare), 0);
+    for (uintmax_t i = 1; i < 10; i++) {
+        add_value(&object, 2 * i);
+    }
+    struct coral_concurrent_skip_list_container_entry *entry;
+    uintmax_t key = 5;
+    assert_int_equal(
+            coral_concurrent_skip_list_container_get(&object, &key, &entry),
+            CORAL_CONCURRENT_SKIP_LIST_CONTAINER_ERROR_ENTRY_NOT_FOUND);
+    assert_int_equal(coral_concurrent_skip_list_container_ceiling(
+            &object, &key, &entry), 0);
+    assert_int_equal(*(uintmax_t *) entry, 6);
+    assert_int_equal(coral_concurrent_skip_list_container_floor(
+            &object, &key, &entry), 0);
+    assert_int_equal(*(uintmax_t *) entry, 4);
+    key = 6;
+    assert_int_equal(coral_concurrent_skip_list_container_ceiling(
+            &object, &key, &entry), 0);
+    assert_int_equal(*(uintmax_t *) entry, 6);
+    assert_int_equal(coral_concurrent_skip_list_container_floor(
+            &object, &key, &entry), 0);
+    assert_int_equal(*(uintmax_t *) entry, 6);
+    assert_int_equal(coral_concurrent_skip_list_container_higher(
+            &object, &key, &entry), 0);
+    assert_int_equal(*(uintmax_t *) entry, 8);
+    assert_int_equal(coral_concurrent_skip_list_container_lower(
+            &object, &key, &entry), 0);
+    assert_int_equal(*(uintmax_t *) entry, 4);
+    key = 1;
+    assert_int_equal(
+            coral_concurrent_skip_list_container_floor(&object, &key, &entry),
+            CORAL_CONCURRENT_SKIP_LIST_CONTAINER_ERROR_ENTRY_NOT_FOUND);
+    key = 2;
+    assert_int_equal(
+            coral_concurrent_skip_list_container_lower(&object, &key, &entry),
+            CORAL_CONCURRENT_SKIP_LIST_CONTAINER_ERROR_ENTRY_NOT_FOUND);
+    key = 18;
+    assert_int_equal(
+            coral_concurrent_skip_list_container_higher(
+                    &object, &key, &entry),
+            CORAL_CONCURRENT_SKIP_LIST_CONTAINER_ERROR_ENTRY_NOT_FOUND);
+    key = 19;
+    assert_int_equal(
+            coral_concurrent_skip_list_container_ceiling(
+                    &object, &key, &entry),
+            CORAL_CONCURRENT_SKIP_LIST_CONTAINER_ERROR_ENTRY_NOT_FOUND);
+    assert_int_equal(coral_concurrent_skip_list_container_invalidate(
+            &object, NULL), 0);
+}
+
+static void check_first_and_last(void **state) {
+    struct coral_concurrent_skip_list_container object;
+    assert_int_equal(coral_concurrent_skip_list_container_init(
+            &object, compare), 0);
+    struct coral_concurrent_skip_list_container_entry *entry;
+    assert_int_equal(
+            coral_concurrent_skip_list_container_first(&object, &entry),
+            CORAL_CONCURRENT_SKIP_LIST_CONTAINER_ERROR_CONTAINER_IS_EMPTY);
+    assert_int_equal(
+            coral_concurrent_skip_list_container_last(&object, &entry),
+            CORAL_CONCURRENT_SKIP_LIST_CONTAINER_ERROR_CONTAINER_IS_EMPTY);
+    for (uintmax_t i = 0; i < 100; i++) {
+        add_value(&object, (37 * i) % 100);
+    }
+    assert_int_equal(coral_concurrent_skip_list_container_first(
+            &object, &entry), 0);
+    assert_int_equal(*(uintmax_t *) entry, 0);
+    assert_int_equal(coral_concurrent_skip_list_container_last(
+            &object, &entry), 0);
+    assert_int_equal(*(uintmax_t *) entry, 99);
+    assert_int_equal(coral_concurrent_skip_list_container_invalidate(
+            &object, NULL), 0);
+}
+
+static void check_next_and_prev(void **state) {
+    struct coral_concurrent_skip_list_container object;
+    assert_int_equal(coral_concurrent_skip_list_container_init(
+            &object, compare), 0);
+    const uintmax_t limit = 1000;
+    for (uintmax_t i = 0; i < limit; i++) {
+        add_value(&object, (7919 * i) % limit);
+    }
+    struct coral_concurrent_skip_list_container_entry *entry;
+    assert_int_equal(coral_concurrent_skip_list_container_first(
+            &object, &entry), 0);
+    for (uintmax_t i = 0; i < limit; i++) {
+        assert_int_equal(*(uintmax_t *) entry, i);
+        assert_int_equal(
+                coral_concurrent_skip_list_container_next(
+                        &object, entry, &entry),
+                i + 1 < limit ? 0
+                : CORAL_CONCURRENT_SKIP_LIST_CONTAINER_ERROR_END_OF_SEQUENCE);
+    }
+    assert_int_equal(coral_concurrent_skip_list_container_last(
+            &object, &entry), 0);
+    for (uintmax_t i = limit; i--;) {
+        assert_int_equal(*(uintmax_t *) entry, i);
+        assert_int_equal(
+                coral_concurrent_skip_list_container_prev(
+                        &object, entry, &entry),
+                i ? 0
+                  : CORAL_CONCURRENT_SKIP_LIST_CONTAINER_ERROR_END_OF_SEQUENCE);
+    }
+    assert_int_equal(coral_concurrent_skip_list_container_invalidate(
+            &object, NULL), 0);
+}
+
+static void check_next_after_remove(void **state) {
+    struct coral_concurrent_skip_list_container object;
+    assert_int_equal(coral_concurrent_skip_list_container_init(
+            &object, compare), 0);
+    add_value(&object, 1);
+    struct coral_concurrent_skip_list_container_entry *const entry
+            = add_value(&object, 2);
+    add_value(&object, 3);
+    add_value(&object, 4);
+    uintmax_t key = 3;
+    struct coral_concurrent_skip_list_container_entry *other;
+    assert_int_equal(coral_concurrent_skip_list_container_get(
+            &object, &key, &other), 0);
+    assert_int_equal(coral_concurrent_skip_list_container_remove(
+            &object, entry), 0);
+    assert_int_equal(coral_concurrent_skip_list_container_remove(
+            &object, other), 0);
+    /* the removed entry still leads on to what followed it */
+    struct coral_concurrent_skip_list_container_entry *out;
+    assert_int_equal(coral_concurrent_skip_list_container_next(
+            &object, entry, &out), 0);
+    assert_int_equal(*(uintmax_t *) out, 4);
+    assert_int_equal(coral_concurrent_skip_list_container_prev(
+            &object, entry, &out), 0);
+    assert_int_equal(*(uintmax_t *) out, 1);
+    assert_int_equal(coral_concurrent_skip_list_container_free(entry), 0);
+    assert_int_equal(coral_concurrent_skip_list_container_free(other), 0);
+    assert_int_equal(coral_concurrent_skip_list_container_invalidate(
+            &object, NULL), 0);
+}
+
+static uintmax_t destroyed_entries;
+
+static void on_destroy(
+        struct coral_concurrent_skip_list_container_entry *const entry) {
+    destroyed_entries++;
+}
+
+static void check_invalidate_with_on_destroy(void **state) {
+    struct coral_concurrent_skip_list_container object;
+    assert_int_equal(coral_concurrent_skip_list_container_init(
+            &object, compare), 0);
+    for (uintmax_t i = 0; i < 300; i++) {
+        add_value(&object, i);
+    }
+    destroyed_entries = 0;
+    assert_int_equal(coral_concurrent_skip_list_container_invalidate(
+            &object, on_destroy), 0);
+    assert_int_equal(destroyed_entries, 300);
+    assert_null(object.compare);
+}
+
+#define THREADS 4
+#define ROUNDS 2048
+#define VALUES 64
+
+struct worker {
+    struct coral_concurrent_skip_list_container *object;
+    struct coral_epoch *epoch;
+    uintmax_t index;
+    uintmax_t removed_count;
+    struct coral_concurrent_skip_list_container_entry *removed[ROUNDS];
+};
+
+/* Removed entries are only freed once every thread is done since other
+ * threads may still be walking past them. */
+static void toggle(struct worker *const worker, const uintmax_t key) {
+    struct coral_concurrent_skip_list_container_entry *entry;
+    int error;
+    if (!coral_concurrent_skip_list_container_get(
+            worker->object, &key, &entry)) {
+        error = coral_concurrent_skip_list_container_remove(
+                worker->object, entry);
+        seagrass_required_true(
+                !error
+                || CORAL_CONCURRENT_SKIP_LIST_CONTAINER_ERROR_ENTRY_NOT_FOUND
+                   == error);
+        if (!error) {
+            worker->removed[worker->removed_count++] = entry;
+        }
+        return;
+    }
+    seagrass_required_true(!coral_concurrent_skip_list_container_alloc(
+            sizeof(uintmax_t), &entry));
+    *(uintmax_t *) entry = key;
+    error = coral_concurrent_skip_list_container_add(worker->object, entry);
+    seagrass_required_true(
+            !error
+            || CORAL_CONCURRENT_SKIP_LIST_CONTAINER_ERROR_ENTRY_ALREADY_EXISTS
+               == error);
+    if (error) {
+        seagrass_required_true(!coral_concurrent_skip_list_container_free(
+                entry));
+    }
+}
+
+/* Even values are always present while the writers add and remove the odd
+ * ones, so readers must always find every even value in order. */
+static void *reader(void *const argument) {
+    struct worker *const worker = argument;
+    for (uintmax_t i = 0; i < ROUNDS / VALUES; i++) {
+        struct coral_concurrent_skip_list_container_entry *entry;
+        seagrass_required_true(!coral_concurrent_skip_list_container_first(
+                worker->object, &entry));
+        uintmax_t even = 0;
+        uintmax_t last = *(uintmax_t *) entry;
+        do {
+            const uintmax_t value = *(uintmax_t *) entry;
+            seagrass_required_true(!even || last < value);
+            if (!(value % 2)) {
+                seagrass_required_true(2 * even++ == value);
+            }
+            last = value;
+        } while (!coral_concurrent_skip_list_container_next(
+                worker->object, entry, &entry));
+        seagrass_required_true(VALUES == even);
+    }
+    return NULL;
+}
+
+/* Each writer toggles odd values of its own. */
+static void *writer(void *const argument) {
+    struct worker *const worker = argument;
+    for (uintmax_t i = 0; i < ROUNDS; i++) {
+        toggle(worker, 2 * ((i * THREADS + worker->index) % VALUES) + 1);
+    }
+    return NULL;
+}
+
+/* Every writer toggles the same odd values. */
+static void *contender(void *const argument) {
+    struct worker *const worker = argument;
+    for (uintmax_t i = 0; i < ROUNDS; i++) {
+        toggle(worker, 2 * ((i + worker->index) % VALUES) + 1);
+    }
+    return NULL;
+}
+
+static void run(struct coral_concurrent_skip_list_container *const object,
+                void *(*const write)(void *)) {
+    for (uintmax_t i = 0; i < VALUES; i++) {
+        add_value(object, 2 * i);
+    }
+    pthread_t threads[2 * THREADS];
+    struct worker *const workers = calloc(2 * THREADS, sizeof(*workers));
+    assert_non_null(workers);
+    for (uintmax_t i = 0; i < 2 * THREADS; i++) {
+        workers[i].object = object;
+        workers[i].index = i % THREADS;
+        assert_int_equal(pthread_create(&threads[i], NULL,
+                                        i < THREADS ? reader : write,
+                                        &workers[i]), 0);
+    }
+    for (uintmax_t i = 0; i < 2 * THREADS; i++) {
+        assert_int_equal(pthread_join(threads[i], NULL), 0);
+    }
+    for (uintmax_t i = 0; i < 2 * THREADS; i++) {
+        for (uintmax_t j = 0; j < workers[i].removed_count; j++) {
+            assert_int_equal(coral_concurrent_skip_list_container_free(
+                    workers[i].removed[j]), 0);
+        }
+    }
+    free(workers);
+}
+
+static void check_readers_and_writers(void **state) {
+    struct coral_concurrent_skip_list_container object;
+    assert_int_equal(coral_concurrent_skip_list_container_init(
+            &object, compare), 0);
+    run(&object, writer);
+    /* every odd value was toggled an even number of times */
+    uintmax_t count;
+    assert_int_equal(coral_concurrent_skip_list_container_count(
+            &object, &count), 0);
+    assert_int_equal(count, VALUES);
+    assert_int_equal(coral_concurrent_skip_list_container_invalidate(
+            &object, NULL), 0);
+}
+
+/* Readers look at entries from within critical sections while writers
+ * retire the entries they remove, which are then freed as soon as no reader
+ * can still be looking at them. */
+static void *retiring_reader(void *const argument) {
+    struct worker *const worker = argument;
+    struct coral_epoch_thread thread;
+    seagrass_required_true(!coral_epoch_register(worker->epoch, &thread));
+    for (uintmax_t i = 0; i < ROUNDS; i++) {
+        seagrass_required_true(!coral_epoch_enter(&thread));
+        const uintmax_t key = 2 * (i % VALUES) + 1;
+        struct coral_concurrent_skip_list_container_entry *entry;
+        if (!coral_concurrent_skip_list_container_ceiling(
+                worker->object, &key, &entry)) {
+            seagrass_required_true(key <= *(uintmax_t *) entry);
+            if (!coral_concurrent_skip_list_container_next(
+                    worker->object, entry, &entry)) {
+                seagrass_required_true(key < *(uintmax_t *) entry);
+            }
+        }
+        seagrass_required_true(!coral_epoch_exit(&thread));
+    }
+    seagrass_required_true(!coral_epoch_unregister(&thread));
+    return NULL;
+}
+
+static void *retiring_writer(void *const argument) {
+    struct worker *const worker = argument;
+    struct coral_epoch_thread thread;
+    seagrass_required_true(!coral_epoch_register(worker->epoch, &thread));
+    for (uintmax_t i = 0; i < ROUNDS; i++) {
+        seagrass_required_true(!coral_epoch_enter(&thread));
+        worker->removed_count = 0;
+        toggle(worker, 2 * ((i + worker->index) % VALUES) + 1);
+        seagrass_required_true(!coral_epoch_exit(&thread));
+        if (worker->removed_count) {
+            seagrass_required_true(
+                    !coral_concurrent_skip_list_container_retire(
+                            &thread, worker->removed[0]));
+        }
+    }
+    seagrass_required_true(!coral_epoch_unregister(&thread));
+    return NULL;
+}
+
+static void check_readers_and_retiring_writers(void **state) {
+    struct coral_concurrent_skip_list_container object;
+    assert_int_equal(coral_concurrent_skip_list_container_init(
+            &object, compare), 0);
+    struct coral_epoch epoch;
+    assert_int_equal(coral_epoch_init(&epoch), 0);
+    pthread_t threads[2 * THREADS];
+    struct worker *const workers = calloc(2 * THREADS, sizeof(*workers));
+    assert_non_null(workers);
+    for (uintmax_t i = 0; i < 2 * THREADS; i++) {
+        workers[i].object = &object;
+        workers[i].epoch = &epoch;
+        workers[i].index = i % THREADS;
+        assert_int_equal(pthread_create(
+                &threads[i], NULL,
+                i < THREADS ? retiring_reader : retiring_writer,
+                &workers[i]), 0);
+    }
+    for (uintmax_t i = 0; i < 2 * THREADS; i++) {
+        assert_int_equal(pthread_join(threads[i], NULL), 0);
+    }
+    free(workers);
+    assert_int_equal(coral_epoch_invalidate(&epoch), 0);
+    assert_int_equal(coral_concurrent_skip_list_container_invalidate(
+            &object, NULL), 0);
+}
+
+static void check_readers_and_contending_writers(void **state) {
+    struct coral_concurrent_skip_list_container object;
+    assert_int_equal(coral_concurrent_skip_list_container_init(
+            &object, compare), 0);
+    run(&object, contender);
+    /* whichever odd values are left, the count must match the entries */
+    uintmax_t count;
+    assert_int_equal(coral_concurrent_skip_list_container_count(
+            &object, &count), 0);
+    struct coral_concurrent_skip_list_container_entry *entry;
+    assert_int_equal(coral_concurrent_skip_list_container_first(
+            &object, &entry), 0);
+    uintmax_t entries = 1;
+    while (!coral_concurrent_skip_list_container_next(
+            &object, entry, &entry)) {
+        entries++;
+    }
+    assert_int_equal(count, entries);
+    assert_int_equal(coral_concurrent_skip_list_container_invalidate(
+            &object, NULL), 0);
+}
+
+int main(int argc, char *argv[]) {
+    const struct CMUnitTest tests[] = {
+            cmocka_unit_test(check_free_error_on_entry_is_null),
+            cmocka_unit_test(check_free),
+            cmocka_unit_test(check_retire_error_on_thread_is_null),
+            cmocka_unit_test(check_retire_error_on_entry_is_null),
+            cmocka_unit_test(check_retire),
+            cmocka_unit_test(check_alloc_error_on_size_is_zero),
+            cmocka_unit_test(check_alloc_error_on_out_is_null),
+            cmocka_unit_test(check_alloc_error_on_size_is_too_large),
+            cmocka_unit_test(check_alloc_error_on_memory_allocation_failed),
+            cmocka_unit_test(check_alloc_with),
+            cmocka_unit_test(check_init_error_on_object_is_null),
+            cmocka_unit_test(check_init_error_on_compare_is_null),
+            cmocka_unit_test(check_init),
+            cmocka_unit_test(check_invalidate_error_on_object_is_null),
+            cmocka_unit_test(check_count_error_on_object_is_null),
+            cmocka_unit_test(check_count_error_on_out_is_null),
+            cmocka_unit_test(check_add_error_on_object_is_null),
+            cmocka_unit_test(check_add_error_on_entry_is_null),
+            cmocka_unit_test(check_remove_error_on_object_is_null),
+            cmocka_unit_test(check_remove_error_on_entry_is_null),
+            cmocka_unit_test(check_get_error_on_object_is_null),
+            cmocka_unit_test(check_get_error_on_key_is_null),
+            cmocka_unit_test(check_get_error_on_out_is_null),
+            cmocka_unit_test(check_ceiling_error_on_object_is_null),
+            cmocka_unit_test(check_ceiling_error_on_key_is_null),
+            cmocka_unit_test(check_ceiling_error_on_out_is_null),
+            cmocka_unit_test(check_floor_error_on_object_is_null),
+            cmocka_unit_test(check_floor_error_on_key_is_null),
+            cmocka_unit_test(check_floor_error_on_out_is_null),
+            cmocka_unit_test(check_higher_error_on_object_is_null),
+            cmocka_unit_test(check_higher_error_on_key_is_null),
+            cmocka_unit_test(check_higher_error_on_out_is_null),
+            cmocka_unit_test(check_lower_error_on_object_is_null),
+            cmocka_unit_test(check_lower_error_on_key_is_null),
+            cmocka_unit_test(check_lower_error_on_out_is_null),
+            cmocka_unit_test(check_first_error_on_object_is_null),
+            cmocka_unit_test(check_first_error_on_out_is_null),
+            cmocka_unit_test(check_last_error_on_object_is_null),
+            cmocka_unit_test(check_last_error_on_out_is_null),
+            cmocka_unit_test(check_next_error_on_object_is_null),
+            cmocka_unit_test(check_next_error_on_entry_is_null),
+            cmocka_unit_test(check_next_error_on_out_is_null),
+            cmocka_unit_test(check_prev_error_on_object_is_null),
+            cmocka_unit_test(check_prev_error_on_entry_is_null),
+            cmocka_unit_test(check_prev_error_on_out_is_null),
+            cmocka_unit_test(check_add_get_and_remove),
+            cmocka_unit_test(check_add_error_on_entry_already_exists),
+            cmocka_unit_test(check_lookups),
+            cmocka_unit_test(check_first_and_last),
+            cmocka_unit_test(check_next_and_prev),
+            cmocka_unit_test(check_next_after_remove),
+            cmocka_unit_test(check_invalidate_with_on_destroy),
+            cmocka_unit_test(check_readers_and_writers),
+            cmocka_unit_test(check_readers_and_contending_writers),
+            cmocka_unit_test(check_readers_and_retiring_writers),
+    };
+    //cmocka_set_message_output(CM_OUTPUT_XML);
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
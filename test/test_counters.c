@@ -0,0 +1,54 @@
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <setjmp.h>
+#include <cmocka.h>
+#include <coral.h>
+
+#include <test/cmocka.h>
+
+static void check_allocation_counters_error_on_out_is_null(void **state) {
+    assert_int_equal(
+            coral_allocation_counters(NULL),
+            CORAL_COUNTERS_ERROR_OUT_IS_NULL);
+}
+
+static void check_allocation_counters(void **state) {
+    coral_allocation_counters_reset();
+    struct coral_red_black_tree_container_entry *entry;
+    assert_int_equal(coral_red_black_tree_container_alloc(1, &entry), 0);
+    struct coral_linked_list_item *item;
+    assert_int_equal(coral_linked_list_alloc(1, &item), 0);
+    assert_int_equal(coral_linked_list_free(item), 0);
+    struct coral_allocation_counters counters;
+    assert_int_equal(coral_allocation_counters(&counters), 0);
+#ifdef CORAL_COUNTERS
+    assert_int_equal(counters.alloc, 2);
+    assert_int_equal(counters.free, 1);
+#else
+    assert_int_equal(counters.alloc, 0);
+    assert_int_equal(counters.free, 0);
+#endif
+    assert_int_equal(coral_red_black_tree_container_free(entry), 0);
+}
+
+static void check_allocation_counters_reset(void **state) {
+    struct coral_linked_list_item *item;
+    assert_int_equal(coral_linked_list_alloc(1, &item), 0);
+    assert_int_equal(coral_linked_list_free(item), 0);
+    coral_allocation_counters_reset();
+    struct coral_allocation_counters counters;
+    assert_int_equal(coral_allocation_counters(&counters), 0);
+    assert_int_equal(counters.alloc, 0);
+    assert_int_equal(counters.free, 0);
+}
+
+int main(int argc, char *argv[]) {
+    const struct CMUnitTest tests[] = {
+            cmocka_unit_test(check_allocation_counters_error_on_out_is_null),
+            cmocka_unit_test(check_allocation_counters),
+            cmocka_unit_test(check_allocation_counters_reset),
+    };
+    //cmocka_set_message_output(CM_OUTPUT_XML);
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
@@ -0,0 +1,209 @@
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <setjmp.h>
+#include <cmocka.h>
+#include <coral.h>
+#include <seagrass.h>
+
+#include <test/cmocka.h>
+
+static void check_init_error_on_object_is_null(void **state) {
+    assert_int_equal(
+            coral_entry_pool_init(NULL, 1),
+            CORAL_ENTRY_POOL_ERROR_OBJECT_IS_NULL);
+}
+
+static void check_init_error_on_count_is_zero(void **state) {
+    assert_int_equal(
+            coral_entry_pool_init((void *) 1, 0),
+            CORAL_ENTRY_POOL_ERROR_COUNT_IS_ZERO);
+}
+
+static void check_init(void **state) {
+    struct coral_entry_pool object;
+    assert_int_equal(coral_entry_pool_init(&object, 8), 0);
+    assert_int_equal(object.count, 8);
+    assert_int_equal(object.size, 0);
+    assert_null(object.slabs);
+    assert_int_equal(coral_entry_pool_invalidate(&object), 0);
+}
+
+static void check_invalidate_error_on_object_is_null(void **state) {
+    assert_int_equal(
+            coral_entry_pool_invalidate(NULL),
+            CORAL_ENTRY_POOL_ERROR_OBJECT_IS_NULL);
+}
+
+static void check_invalidate(void **state) {
+    struct coral_entry_pool object;
+    assert_int_equal(coral_entry_pool_init(&object, 2), 0);
+    void *block;
+    for (uintmax_t i = 0; i < 5; i++) {
+        assert_int_equal(coral_entry_pool_alloc(
+                &object, sizeof(void *), 16, &block), 0);
+    }
+    assert_int_equal(coral_entry_pool_invalidate(&object), 0);
+}
+
+static void check_allocator_error_on_object_is_null(void **state) {
+    assert_int_equal(
+            coral_entry_pool_allocator(NULL, (void *) 1),
+            CORAL_ENTRY_POOL_ERROR_OBJECT_IS_NULL);
+}
+
+static void check_allocator_error_on_out_is_null(void **state) {
+    assert_int_equal(
+            coral_entry_pool_allocator((void *) 1, NULL),
+            CORAL_ENTRY_POOL_ERROR_OUT_IS_NULL);
+}
+
+static int compare(const void *a, const void *b) {
+    return seagrass_uintmax_t_ptr_compare(a, b);
+}
+
+static void check_allocator(void **state) {
+    struct coral_entry_pool object;
+    assert_int_equal(coral_entry_pool_init(&object, 8), 0);
+    const struct coral_allocator *allocator;
+    assert_int_equal(coral_entry_pool_allocator(&object, &allocator), 0);
+    assert_ptr_equal(allocator->context, &object);
+    struct coral_red_black_tree_container container;
+    assert_int_equal(coral_red_black_tree_container_init(
+            &container, compare), 0);
+    for (uintmax_t i = 0; i < 20; i++) {
+        union {
+            struct coral_red_black_tree_container_entry *entry;
+            uintmax_t *value;
+        } ptr;
+        assert_int_equal(coral_red_black_tree_container_alloc_with(
+                allocator, sizeof(*ptr.value), &ptr.entry), 0);
+        *ptr.value = i;
+        assert_int_equal(coral_red_black_tree_container_add(
+                &container, ptr.entry), 0);
+    }
+    assert_int_equal(coral_red_black_tree_container_invalidate(
+            &container, NULL), 0);
+    assert_int_equal(coral_entry_pool_invalidate(&object), 0);
+}
+
+static void check_alloc_error_on_object_is_null(void **state) {
+    assert_int_equal(
+            coral_entry_pool_alloc(NULL, sizeof(void *), 1, (void *) 1),
+            CORAL_ENTRY_POOL_ERROR_OBJECT_IS_NULL);
+}
+
+static void check_alloc_error_on_out_is_null(void **state) {
+    assert_int_equal(
+            coral_entry_pool_alloc((void *) 1, sizeof(void *), 1, NULL),
+            CORAL_ENTRY_POOL_ERROR_OUT_IS_NULL);
+}
+
+static void check_alloc_error_on_size_is_too_large(void **state) {
+    struct coral_entry_pool object;
+    assert_int_equal(coral_entry_pool_init(&object, 8), 0);
+    void *block;
+    assert_int_equal(coral_entry_pool_alloc(
+            &object, sizeof(void *), 16, &block), 0);
+    assert_int_equal(
+            coral_entry_pool_alloc(&object, sizeof(void *), 17, &block),
+            CORAL_ENTRY_POOL_ERROR_SIZE_IS_TOO_LARGE);
+    assert_int_equal(
+            coral_entry_pool_alloc(&object, 2 * sizeof(void *), 16, &block),
+            CORAL_ENTRY_POOL_ERROR_SIZE_IS_TOO_LARGE);
+    assert_int_equal(coral_entry_pool_invalidate(&object), 0);
+}
+
+static void check_alloc_error_on_alignment_is_invalid(void **state) {
+    struct coral_entry_pool object;
+    assert_int_equal(coral_entry_pool_init(&object, 8), 0);
+    void *block;
+    assert_int_equal(
+            coral_entry_pool_alloc(&object, 3 * sizeof(void *), 16, &block),
+            CORAL_ENTRY_POOL_ERROR_ALIGNMENT_IS_INVALID);
+    assert_int_equal(coral_entry_pool_invalidate(&object), 0);
+}
+
+static void check_alloc_error_on_memory_allocation_failed(void **state) {
+    struct coral_entry_pool object;
+    assert_int_equal(coral_entry_pool_init(&object, 8), 0);
+    malloc_is_overridden = calloc_is_overridden = realloc_is_overridden
+            = posix_memalign_is_overridden = true;
+    void *block;
+    assert_int_equal(
+            coral_entry_pool_alloc(&object, sizeof(void *), 16, &block),
+            CORAL_ENTRY_POOL_ERROR_MEMORY_ALLOCATION_FAILED);
+    malloc_is_overridden = calloc_is_overridden = realloc_is_overridden
+            = posix_memalign_is_overridden = false;
+    assert_int_equal(coral_entry_pool_invalidate(&object), 0);
+}
+
+static void check_alloc(void **state) {
+    struct coral_entry_pool object;
+    assert_int_equal(coral_entry_pool_init(&object, 2), 0);
+    void *a, *b, *c;
+    assert_int_equal(coral_entry_pool_alloc(
+            &object, sizeof(void *), 10, &a), 0);
+    assert_int_equal(object.size % sizeof(void *), 0);
+    assert_true(object.size >= 10);
+    assert_int_equal((uintptr_t) a % sizeof(void *), 0);
+    assert_int_equal(coral_entry_pool_alloc(
+            &object, sizeof(void *), 10, &b), 0);
+    assert_ptr_equal((unsigned char *) a + object.size, b);
+    /* third block comes from a new slab */
+    assert_int_equal(coral_entry_pool_alloc(
+            &object, sizeof(void *), 1, &c), 0);
+    assert_ptr_not_equal(c, a);
+    assert_ptr_not_equal(c, b);
+    assert_int_equal(coral_entry_pool_invalidate(&object), 0);
+}
+
+static void check_free_error_on_object_is_null(void **state) {
+    assert_int_equal(
+            coral_entry_pool_free(NULL, (void *) 1),
+            CORAL_ENTRY_POOL_ERROR_OBJECT_IS_NULL);
+}
+
+static void check_free_error_on_block_is_null(void **state) {
+    assert_int_equal(
+            coral_entry_pool_free((void *) 1, NULL),
+            CORAL_ENTRY_POOL_ERROR_BLOCK_IS_NULL);
+}
+
+static void check_free(void **state) {
+    struct coral_entry_pool object;
+    assert_int_equal(coral_entry_pool_init(&object, 4), 0);
+    void *a, *b;
+    assert_int_equal(coral_entry_pool_alloc(
+            &object, sizeof(void *), 16, &a), 0);
+    assert_int_equal(coral_entry_pool_free(&object, a), 0);
+    /* freed blocks are reused first */
+    assert_int_equal(coral_entry_pool_alloc(
+            &object, sizeof(void *), 16, &b), 0);
+    assert_ptr_equal(a, b);
+    assert_int_equal(coral_entry_pool_invalidate(&object), 0);
+}
+
+int main(int argc, char *argv[]) {
+    const struct CMUnitTest tests[] = {
+            cmocka_unit_test(check_init_error_on_object_is_null),
+            cmocka_unit_test(check_init_error_on_count_is_zero),
+            cmocka_unit_test(check_init),
+            cmocka_unit_test(check_invalidate_error_on_object_is_null),
+            cmocka_unit_test(check_invalidate),
+            cmocka_unit_test(check_allocator_error_on_object_is_null),
+            cmocka_unit_test(check_allocator_error_on_out_is_null),
+            cmocka_unit_test(check_allocator),
+            cmocka_unit_test(check_alloc_error_on_object_is_null),
+            cmocka_unit_test(check_alloc_error_on_out_is_null),
+            cmocka_unit_test(check_alloc_error_on_size_is_too_large),
+            cmocka_unit_test(check_alloc_error_on_alignment_is_invalid),
+            cmocka_unit_test(check_alloc_error_on_memory_allocation_failed),
+            cmocka_unit_test(check_alloc),
+            cmocka_unit_test(check_free_error_on_object_is_null),
+            cmocka_unit_test(check_free_error_on_block_is_null),
+            cmocka_unit_test(check_free),
+    };
+    //cmocka_set_message_output(CM_OUTPUT_XML);
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
@@ -0,0 +1,407 @@
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <setjmp.h>
+#include <stdlib.h>
+#include <pthread.h>
+#include <cmocka.h>
+#include <coral.h>
+#include <seagrass.h>
+
+#include <test/cmocka.h>
+
+static void count(void *const item) {
+    (*(uintmax_t *) item)++;
+}
+
+static void check_init_error_on_object_is_null(void **state) {
+    assert_int_equal(coral_epoch_init(NULL), CORAL_EPOCH_ERROR_OBJECT_IS_NULL);
+}
+
+static void check_init(void **state) {
+    struct coral_epoch object;
+    assert_int_equal(coral_epoch_init(&object), 0);
+    assert_null(object.threads);
+    assert_null(object.orphans);
+    assert_int_equal(coral_epoch_invalidate(&object), 0);
+}
+
+static void check_invalidate_error_on_object_is_null(void **state) {
+    assert_int_equal(coral_epoch_invalidate(NULL),
+                     CORAL_EPOCH_ERROR_OBJECT_IS_NULL);
+}
+
+static void check_invalidate_error_on_threads_are_registered(void **state) {
+    struct coral_epoch object;
+    assert_int_equal(coral_epoch_init(&object), 0);
+    struct coral_epoch_thread thread;
+    assert_int_equal(coral_epoch_register(&object, &thread), 0);
+    assert_int_equal(coral_epoch_invalidate(&object),
+                     CORAL_EPOCH_ERROR_THREADS_ARE_REGISTERED);
+    assert_int_equal(coral_epoch_unregister(&thread), 0);
+    assert_int_equal(coral_epoch_invalidate(&object), 0);
+}
+
+static void check_register_error_on_object_is_null(void **state) {
+    struct coral_epoch_thread thread;
+    assert_int_equal(coral_epoch_register(NULL, &thread),
+                     CORAL_EPOCH_ERROR_OBJECT_IS_NULL);
+}
+
+static void check_register_error_on_thread_is_null(void **state) {
+    struct coral_epoch object;
+    assert_int_equal(coral_epoch_register(&object, NULL),
+                     CORAL_EPOCH_ERROR_THREAD_IS_NULL);
+}
+
+static void check_register_error_on_memory_allocation_failed(void **state) {
+    struct coral_epoch object;
+    assert_int_equal(coral_epoch_init(&object), 0);
+    struct coral_epoch_thread thread;
+    malloc_is_overridden = true;
+    assert_int_equal(coral_epoch_register(&object, &thread),
+                     CORAL_EPOCH_ERROR_MEMORY_ALLOCATION_FAILED);
+    malloc_is_overridden = false;
+    assert_null(object.threads);
+    assert_int_equal(coral_epoch_invalidate(&object), 0);
+}
+
+static void check_register(void **state) {
+    struct coral_epoch object;
+    assert_int_equal(coral_epoch_init(&object), 0);
+    struct coral_epoch_thread threads[2];
+    assert_int_equal(coral_epoch_register(&object, &threads[0]), 0);
+    assert_int_equal(coral_epoch_register(&object, &threads[1]), 0);
+    assert_ptr_equal(threads[0].epoch, &object);
+    assert_ptr_equal(threads[1].epoch, &object);
+    assert_int_equal((uintptr_t) &threads[1] % 64, 0);
+    assert_int_equal(coral_epoch_unregister(&threads[0]), 0);
+    assert_ptr_equal(object.threads, &threads[1]);
+    assert_null(threads[0].epoch);
+    assert_int_equal(coral_epoch_unregister(&threads[1]), 0);
+    assert_null(object.threads);
+    assert_int_equal(coral_epoch_invalidate(&object), 0);
+}
+
+static void check_unregister_error_on_thread_is_null(void **state) {
+    assert_int_equal(coral_epoch_unregister(NULL),
+                     CORAL_EPOCH_ERROR_THREAD_IS_NULL);
+}
+
+static void check_unregister_error_on_thread_is_active(void **state) {
+    struct coral_epoch object;
+    assert_int_equal(coral_epoch_init(&object), 0);
+    struct coral_epoch_thread thread;
+    assert_int_equal(coral_epoch_register(&object, &thread), 0);
+    assert_int_equal(coral_epoch_enter(&thread), 0);
+    assert_int_equal(coral_epoch_unregister(&thread),
+                     CORAL_EPOCH_ERROR_THREAD_IS_ACTIVE);
+    assert_int_equal(coral_epoch_exit(&thread), 0);
+    assert_int_equal(coral_epoch_unregister(&thread), 0);
+    assert_int_equal(coral_epoch_invalidate(&object), 0);
+}
+
+static void check_enter_error_on_thread_is_null(void **state) {
+    assert_int_equal(coral_epoch_enter(NULL),
+                     CORAL_EPOCH_ERROR_THREAD_IS_NULL);
+}
+
+static void check_exit_error_on_thread_is_null(void **state) {
+    assert_int_equal(coral_epoch_exit(NULL),
+                     CORAL_EPOCH_ERROR_THREAD_IS_NULL);
+}
+
+static void check_exit_error_on_thread_is_not_active(void **state) {
+    struct coral_epoch object;
+    assert_int_equal(coral_epoch_init(&object), 0);
+    struct coral_epoch_thread thread;
+    assert_int_equal(coral_epoch_register(&object, &thread), 0);
+    assert_int_equal(coral_epoch_exit(&thread),
+                     CORAL_EPOCH_ERROR_THREAD_IS_NOT_ACTIVE);
+    assert_int_equal(coral_epoch_unregister(&thread), 0);
+    assert_int_equal(coral_epoch_invalidate(&object), 0);
+}
+
+static void check_defer_error_on_thread_is_null(void **state) {
+    uintmax_t counter = 0;
+    assert_int_equal(coral_epoch_defer(NULL, &counter, count),
+                     CORAL_EPOCH_ERROR_THREAD_IS_NULL);
+}
+
+static void check_defer_error_on_item_is_null(void **state) {
+    struct coral_epoch_thread thread;
+    assert_int_equal(coral_epoch_defer(&thread, NULL, count),
+                     CORAL_EPOCH_ERROR_ITEM_IS_NULL);
+}
+
+static void check_defer_error_on_function_is_null(void **state) {
+    struct coral_epoch_thread thread;
+    uintmax_t counter = 0;
+    assert_int_equal(coral_epoch_defer(&thread, &counter, NULL),
+                     CORAL_EPOCH_ERROR_FUNCTION_IS_NULL);
+}
+
+static void check_defer_error_on_memory_allocation_failed(void **state) {
+    struct coral_epoch object;
+    assert_int_equal(coral_epoch_init(&object), 0);
+    struct coral_epoch_thread threads[2];
+    assert_int_equal(coral_epoch_register(&object, &threads[0]), 0);
+    assert_int_equal(coral_epoch_register(&object, &threads[1]), 0);
+    /* the other thread holds the epoch back so no bag can be reused */
+    assert_int_equal(coral_epoch_enter(&threads[1]), 0);
+    uintmax_t counter = 0;
+    int error;
+    malloc_is_overridden = true;
+    for (uintmax_t i = 0; !(error = coral_epoch_defer(
+            &threads[0], &counter, count)); i++) {
+        assert_true(i < 1000);
+    }
+    malloc_is_overridden = false;
+    assert_int_equal(error, CORAL_EPOCH_ERROR_MEMORY_ALLOCATION_FAILED);
+    assert_int_equal(counter, 0);
+    assert_int_equal(coral_epoch_exit(&threads[1]), 0);
+    assert_int_equal(coral_epoch_unregister(&threads[0]), 0);
+    assert_int_equal(coral_epoch_unregister(&threads[1]), 0);
+    assert_int_equal(coral_epoch_invalidate(&object), 0);
+    assert_int_not_equal(counter, 0);
+}
+
+static void check_collect_error_on_thread_is_null(void **state) {
+    assert_int_equal(coral_epoch_collect(NULL),
+                     CORAL_EPOCH_ERROR_THREAD_IS_NULL);
+}
+
+static void check_defer_waits_for_exit(void **state) {
+    struct coral_epoch object;
+    assert_int_equal(coral_epoch_init(&object), 0);
+    struct coral_epoch_thread thread;
+    assert_int_equal(coral_epoch_register(&object, &thread), 0);
+    uintmax_t counter = 0;
+    assert_int_equal(coral_epoch_enter(&thread), 0);
+    assert_int_equal(coral_epoch_defer(&thread, &counter, count), 0);
+    for (uintmax_t i = 0; i < 4; i++) {
+        assert_int_equal(coral_epoch_collect(&thread), 0);
+    }
+    assert_int_equal(counter, 0);
+    assert_int_equal(coral_epoch_exit(&thread), 0);
+    assert_int_equal(coral_epoch_collect(&thread), 0);
+    assert_int_equal(coral_epoch_collect(&thread), 0);
+    assert_int_equal(counter, 1);
+    assert_int_equal(coral_epoch_unregister(&thread), 0);
+    assert_int_equal(coral_epoch_invalidate(&object), 0);
+    assert_int_equal(counter, 1);
+}
+
+static void check_defer_waits_for_other_thread(void **state) {
+    struct coral_epoch object;
+    assert_int_equal(coral_epoch_init(&object), 0);
+    struct coral_epoch_thread threads[2];
+    assert_int_equal(coral_epoch_register(&object, &threads[0]), 0);
+    assert_int_equal(coral_epoch_register(&object, &threads[1]), 0);
+    uintmax_t counter = 0;
+    assert_int_equal(coral_epoch_enter(&threads[1]), 0);
+    assert_int_equal(coral_epoch_defer(&threads[0], &counter, count), 0);
+    for (uintmax_t i = 0; i < 4; i++) {
+        assert_int_equal(coral_epoch_collect(&threads[0]), 0);
+    }
+    assert_int_equal(counter, 0);
+    /* nested critical sections hold the epoch back until the outermost */
+    assert_int_equal(coral_epoch_enter(&threads[1]), 0);
+    assert_int_equal(coral_epoch_exit(&threads[1]), 0);
+    assert_int_equal(coral_epoch_collect(&threads[0]), 0);
+    assert_int_equal(counter, 0);
+    assert_int_equal(coral_epoch_exit(&threads[1]), 0);
+    assert_int_equal(coral_epoch_collect(&threads[0]), 0);
+    assert_int_equal(coral_epoch_collect(&threads[0]), 0);
+    assert_int_equal(counter, 1);
+    assert_int_equal(coral_epoch_unregister(&threads[0]), 0);
+    assert_int_equal(coral_epoch_unregister(&threads[1]), 0);
+    assert_int_equal(coral_epoch_invalidate(&object), 0);
+}
+
+static void check_defer_fills_bags(void **state) {
+    struct coral_epoch object;
+    assert_int_equal(coral_epoch_init(&object), 0);
+    struct coral_epoch_thread thread;
+    assert_int_equal(coral_epoch_register(&object, &thread), 0);
+    uintmax_t counter = 0;
+    for (uintmax_t i = 0; i < 1000; i++) {
+        assert_int_equal(coral_epoch_enter(&thread), 0);
+        assert_int_equal(coral_epoch_defer(&thread, &counter, count), 0);
+        assert_int_equal(coral_epoch_exit(&thread), 0);
+    }
+    /* full bags are run as the epoch moves on */
+    assert_true(counter > 0);
+    assert_true(counter < 1000);
+    assert_int_equal(coral_epoch_unregister(&thread), 0);
+    assert_int_equal(coral_epoch_invalidate(&object), 0);
+    assert_int_equal(counter, 1000);
+}
+
+static void check_defer_again_error_on_item_is_null(void **state) {
+    assert_int_equal(coral_epoch_defer_again(NULL, count),
+                     CORAL_EPOCH_ERROR_ITEM_IS_NULL);
+}
+
+static void check_defer_again_error_on_function_is_null(void **state) {
+    assert_int_equal(coral_epoch_defer_again((void *) 1, NULL),
+                     CORAL_EPOCH_ERROR_FUNCTION_IS_NULL);
+}
+
+static void check_defer_again_error_on_caller_is_not_deferred(void **state) {
+    uintmax_t counter = 0;
+    assert_int_equal(coral_epoch_defer_again(&counter, count),
+                     CORAL_EPOCH_ERROR_CALLER_IS_NOT_DEFERRED);
+}
+
+/* Counts up to three, deferring itself again until then. */
+static void count_to_three(void *const item) {
+    if (3 > ++*(uintmax_t *) item) {
+        assert_int_equal(coral_epoch_defer_again(item, count_to_three), 0);
+    }
+}
+
+static void check_defer_again(void **state) {
+    struct coral_epoch object;
+    assert_int_equal(coral_epoch_init(&object), 0);
+    struct coral_epoch_thread thread;
+    assert_int_equal(coral_epoch_register(&object, &thread), 0);
+    uintmax_t counter = 0;
+    assert_int_equal(coral_epoch_defer(&thread, &counter, count_to_three), 0);
+    assert_int_equal(coral_epoch_collect(&thread), 0);
+    assert_int_equal(coral_epoch_collect(&thread), 0);
+    assert_int_equal(counter, 1);
+    /* deferred again it waits for the epoch to move on twice more */
+    assert_int_equal(coral_epoch_collect(&thread), 0);
+    assert_int_equal(counter, 1);
+    assert_int_equal(coral_epoch_collect(&thread), 0);
+    assert_int_equal(counter, 2);
+    /* while invalidating it runs right away */
+    assert_int_equal(coral_epoch_unregister(&thread), 0);
+    assert_int_equal(coral_epoch_invalidate(&object), 0);
+    assert_int_equal(counter, 3);
+}
+
+static void check_unregister_hands_over(void **state) {
+    struct coral_epoch object;
+    assert_int_equal(coral_epoch_init(&object), 0);
+    struct coral_epoch_thread threads[2];
+    assert_int_equal(coral_epoch_register(&object, &threads[0]), 0);
+    assert_int_equal(coral_epoch_register(&object, &threads[1]), 0);
+    uintmax_t counter = 0;
+    assert_int_equal(coral_epoch_enter(&threads[1]), 0);
+    assert_int_equal(coral_epoch_defer(&threads[0], &counter, count), 0);
+    assert_int_equal(coral_epoch_unregister(&threads[0]), 0);
+    assert_ptr_not_equal(object.orphans, NULL);
+    assert_int_equal(coral_epoch_collect(&threads[1]), 0);
+    assert_int_equal(counter, 0);
+    assert_int_equal(coral_epoch_exit(&threads[1]), 0);
+    for (uintmax_t i = 0; i < 3; i++) {
+        assert_int_equal(coral_epoch_collect(&threads[1]), 0);
+    }
+    assert_int_equal(counter, 1);
+    assert_null(object.orphans);
+    assert_int_equal(coral_epoch_unregister(&threads[1]), 0);
+    assert_int_equal(coral_epoch_invalidate(&object), 0);
+}
+
+#define THREADS 4
+#define ROUNDS 4096
+
+struct shared {
+    struct coral_epoch epoch;
+    _Atomic(uintmax_t *) value;
+};
+
+static void release(void *const item) {
+    /* poison the value so that a reader seeing it freed fails */
+    *(uintmax_t *) item = 0;
+    free(item);
+}
+
+/* Readers only ever see a value of the form 2 * n + 1. */
+static void *reader(void *const argument) {
+    struct shared *const shared = argument;
+    struct coral_epoch_thread thread;
+    seagrass_required_true(!coral_epoch_register(&shared->epoch, &thread));
+    for (uintmax_t i = 0; i < ROUNDS; i++) {
+        seagrass_required_true(!coral_epoch_enter(&thread));
+        const uintmax_t *const value = atomic_load(&shared->value);
+        seagrass_required_true(1 == *value % 2);
+        seagrass_required_true(!coral_epoch_exit(&thread));
+    }
+    seagrass_required_true(!coral_epoch_unregister(&thread));
+    return NULL;
+}
+
+/* Writers swap in a new value and defer freeing the one they swapped out. */
+static void *writer(void *const argument) {
+    struct shared *const shared = argument;
+    struct coral_epoch_thread thread;
+    seagrass_required_true(!coral_epoch_register(&shared->epoch, &thread));
+    for (uintmax_t i = 0; i < ROUNDS; i++) {
+        uintmax_t *const value = malloc(sizeof(*value));
+        seagrass_required_true(value);
+        *value = 2 * i + 1;
+        seagrass_required_true(!coral_epoch_enter(&thread));
+        uintmax_t *const old = atomic_exchange(&shared->value, value);
+        seagrass_required_true(!coral_epoch_exit(&thread));
+        seagrass_required_true(!coral_epoch_defer(&thread, old, release));
+    }
+    seagrass_required_true(!coral_epoch_unregister(&thread));
+    return NULL;
+}
+
+static void check_readers_and_writers(void **state) {
+    struct shared shared;
+    assert_int_equal(coral_epoch_init(&shared.epoch), 0);
+    uintmax_t *const value = malloc(sizeof(*value));
+    assert_non_null(value);
+    *value = 1;
+    atomic_init(&shared.value, value);
+    pthread_t threads[2 * THREADS];
+    for (uintmax_t i = 0; i < 2 * THREADS; i++) {
+        assert_int_equal(pthread_create(&threads[i], NULL,
+                                        i < THREADS ? reader : writer,
+                                        &shared), 0);
+    }
+    for (uintmax_t i = 0; i < 2 * THREADS; i++) {
+        assert_int_equal(pthread_join(threads[i], NULL), 0);
+    }
+    assert_int_equal(coral_epoch_invalidate(&shared.epoch), 0);
+    free(atomic_load(&shared.value));
+}
+
+int main(int argc, char *argv[]) {
+    const struct CMUnitTest tests[] = {
+            cmocka_unit_test(check_init_error_on_object_is_null),
+            cmocka_unit_test(check_init),
+            cmocka_unit_test(check_invalidate_error_on_object_is_null),
+            cmocka_unit_test(check_invalidate_error_on_threads_are_registered),
+            cmocka_unit_test(check_register_error_on_object_is_null),
+            cmocka_unit_test(check_register_error_on_thread_is_null),
+            cmocka_unit_test(check_register_error_on_memory_allocation_failed),
+            cmocka_unit_test(check_register),
+            cmocka_unit_test(check_unregister_error_on_thread_is_null),
+            cmocka_unit_test(check_unregister_error_on_thread_is_active),
+            cmocka_unit_test(check_enter_error_on_thread_is_null),
+            cmocka_unit_test(check_exit_error_on_thread_is_null),
+            cmocka_unit_test(check_exit_error_on_thread_is_not_active),
+            cmocka_unit_test(check_defer_error_on_thread_is_null),
+            cmocka_unit_test(check_defer_error_on_item_is_null),
+            cmocka_unit_test(check_defer_error_on_function_is_null),
+            cmocka_unit_test(check_defer_error_on_memory_allocation_failed),
+            cmocka_unit_test(check_collect_error_on_thread_is_null),
+            cmocka_unit_test(check_defer_waits_for_exit),
+            cmocka_unit_test(check_defer_waits_for_other_thread),
+            cmocka_unit_test(check_defer_fills_bags),
+            cmocka_unit_test(check_defer_again_error_on_item_is_null),
+            cmocka_unit_test(check_defer_again_error_on_function_is_null),
+            cmocka_unit_test(check_defer_again_error_on_caller_is_not_deferred),
+            cmocka_unit_test(check_defer_again),
+            cmocka_unit_test(check_unregister_hands_over),
+            cmocka_unit_test(check_readers_and_writers),
+    };
+    //cmocka_set_message_output(CM_OUTPUT_XML);
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
@@ -0,0 +1,701 @@
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <setjmp.h>
+#include <stdlib.h>
+#include <cmocka.h>
+#include <coral.h>
+#include <seagrass.h>
+
+#include <test/cmocka.h>
+
+#include "statistics_allocator.h"
+
+static void check_free_error_on_entry_is_null(void **state) {
+    assert_int_equal(
+            coral_hash_container_free(NULL),
+            CORAL_HASH_CONTAINER_ERROR_ENTRY_IS_NULL);
+}
+
+static void check_free(void **state) {
+    struct coral_hash_container_entry *entry;
+    assert_int_equal(coral_hash_container_alloc(1, &entry), 0);
+    assert_int_equal(coral_hash_container_free(entry), 0);
+}
+
+static void check_alloc_error_on_size_is_zero(void **state) {
+    assert_int_equal(
+            coral_hash_container_alloc(0, (void *) 1),
+            CORAL_HASH_CONTAINER_ERROR_SIZE_IS_ZERO);
+}
+
+static void check_alloc_error_on_out_is_null(void **state) {
+    assert_int_equal(
+            coral_hash_container_alloc(1, NULL),
+            CORAL_HASH_CONTAINER_ERROR_OUT_IS_NULL);
+}
+
+static void check_alloc(void **state) {
+    struct coral_hash_container_entry *entry;
+    assert_int_equal(coral_hash_container_alloc(1, &entry), 0);
+    assert_int_equal(coral_hash_container_free(entry), 0);
+}
+
+static void check_alloc_error_on_size_is_too_large(void **state) {
+    assert_int_equal(
+            coral_hash_container_alloc(UINTMAX_MAX, (void *) 1),
+            CORAL_HASH_CONTAINER_ERROR_SIZE_IS_TOO_LARGE);
+}
+
+static void check_alloc_error_on_memory_allocation_failed(void **state) {
+    malloc_is_overridden = calloc_is_overridden = realloc_is_overridden
+            = posix_memalign_is_overridden = true;
+    assert_int_equal(
+            coral_hash_container_alloc(1, (void *) 1),
+            CORAL_HASH_CONTAINER_ERROR_MEMORY_ALLOCATION_FAILED);
+    malloc_is_overridden = calloc_is_overridden = realloc_is_overridden
+            = posix_memalign_is_overridden = false;
+}
+
+static void check_alloc_with(void **state) {
+    struct statistics statistics = {};
+    const struct coral_allocator allocator = {
+            .alloc = statistics_alloc,
+            .free = statistics_free,
+            .context = &statistics
+    };
+    struct coral_hash_container_entry *entry;
+    assert_int_equal(coral_hash_container_alloc_with(
+            &allocator, 1, &entry), 0);
+    assert_int_equal(statistics.alloc, 1);
+    assert_int_equal(coral_hash_container_free(entry), 0);
+    assert_int_equal(statistics.free, 1);
+}
+
+static void check_invalidate_error_on_object_is_null(void **state) {
+    assert_int_equal(
+            coral_hash_container_invalidate(NULL, (void *) 1),
+            CORAL_HASH_CONTAINER_ERROR_OBJECT_IS_NULL);
+}
+
+static void check_invalidate(void **state) {
+    struct coral_hash_container object = {};
+    assert_int_equal(coral_hash_container_invalidate(
+            &object, NULL), 0);
+}
+
+static void check_init_error_on_object_is_null(void **state) {
+    assert_int_equal(
+            coral_hash_container_init(NULL, (void *) 1, (void *) 1),
+            CORAL_HASH_CONTAINER_ERROR_OBJECT_IS_NULL);
+}
+
+static void check_init_error_on_hash_is_null(void **state) {
+    assert_int_equal(
+            coral_hash_container_init((void *) 1, NULL, (void *) 1),
+            CORAL_HASH_CONTAINER_ERROR_HASH_IS_NULL);
+}
+
+static void check_init_error_on_compare_is_null(void **state) {
+    assert_int_equal(
+            coral_hash_container_init((void *) 1, (void *) 1, NULL),
+            CORAL_HASH_CONTAINER_ERROR_COMPARE_IS_NULL);
+}
+
+static void check_init(void **state) {
+    srand(time(NULL));
+    const uintmax_t check = rand();
+    struct coral_hash_container object;
+    assert_int_equal(coral_hash_container_init(
+            &object, (void *) 1, (void *) check), 0);
+    assert_int_equal(1, object.hash);
+    assert_int_equal(check, object.compare);
+    assert_int_equal(coral_hash_container_invalidate(
+            &object, NULL), 0);
+}
+
+static void check_count_error_on_object_is_null(void **state) {
+    assert_int_equal(
+            coral_hash_container_count(NULL, (void *) 1),
+            CORAL_HASH_CONTAINER_ERROR_OBJECT_IS_NULL);
+}
+
+static void check_count_error_on_out_is_null(void **state) {
+    assert_int_equal(
+            coral_hash_container_count((void *) 1, NULL),
+            CORAL_HASH_CONTAINER_ERROR_OUT_IS_NULL);
+}
+
+static void check_count(void **state) {
+    srand(time(NULL));
+    uintmax_t check = rand();
+    struct coral_hash_container object = {
+            .table.count = check
+    };
+    uintmax_t count;
+    assert_int_equal(coral_hash_container_count(
+            &object, &count), 0);
+    assert_int_equal(check, count);
+}
+
+static void check_add_error_on_object_is_null(void **state) {
+    assert_int_equal(
+            coral_hash_container_add(NULL, (void *) 1),
+            CORAL_HASH_CONTAINER_ERROR_OBJECT_IS_NULL);
+}
+
+static void check_add_error_on_entry_is_null(void **state) {
+    assert_int_equal(
+            coral_hash_container_add((void *) 1, NULL),
+            CORAL_HASH_CONTAINER_ERROR_ENTRY_IS_NULL);
+}
+
+static int compare(const void *a, const void *b) {
+    return seagrass_uintmax_t_ptr_compare(a, b);
+}
+
+static size_t hash(const void *a) {
+    return (size_t) *(const uintmax_t *) a;
+}
+
+static void check_add(void **state) {
+    struct coral_hash_container object;
+    assert_int_equal(coral_hash_container_init(&object, hash, compare), 0);
+    union entry {
+        struct coral_hash_container_entry *entry;
+        uintmax_t *value;
+    } item;
+    assert_int_equal(coral_hash_container_alloc(
+            sizeof(*item.value), &item.entry), 0);
+    *item.value = 0;
+    assert_int_equal(coral_hash_container_add(
+            &object, item.entry), 0);
+    assert_int_equal(0, *item.value);
+    uintmax_t count;
+    assert_int_equal(coral_hash_container_count(
+            &object, &count), 0);
+    assert_int_equal(1, count);
+    assert_int_equal(coral_hash_container_invalidate(
+            &object, NULL), 0);
+}
+
+static void check_add_error_on_entry_already_exits(void **state) {
+    struct coral_hash_container object;
+    assert_int_equal(coral_hash_container_init(
+            &object, hash, compare), 0);
+    union entry {
+        struct coral_hash_container_entry *entry;
+        uintmax_t *value;
+    } item;
+    assert_int_equal(coral_hash_container_alloc(
+            sizeof(*item.value), &item.entry), 0);
+    *item.value = 0;
+    assert_int_equal(
+            coral_hash_container_add(&object, item.entry), 0);
+    assert_int_equal(
+            coral_hash_container_add(&object, item.entry),
+            CORAL_HASH_CONTAINER_ERROR_ENTRY_ALREADY_EXISTS);
+    assert_int_equal(coral_hash_container_invalidate(
+            &object, NULL), 0);
+}
+
+static void check_remove_error_on_object_is_null(void **state) {
+    assert_int_equal(
+            coral_hash_container_remove(NULL, (void *) 1),
+            CORAL_HASH_CONTAINER_ERROR_OBJECT_IS_NULL);
+}
+
+static void check_remove_error_on_entry_is_null(void **state) {
+    assert_int_equal(
+            coral_hash_container_remove((void *) 1, NULL),
+            CORAL_HASH_CONTAINER_ERROR_ENTRY_IS_NULL);
+}
+
+static void check_remove(void **state) {
+    struct coral_hash_container object;
+    assert_int_equal(coral_hash_container_init(&object, hash, compare), 0);
+    union entry {
+        struct coral_hash_container_entry *entry;
+        uintmax_t *value;
+    } item;
+    assert_int_equal(coral_hash_container_alloc(
+            sizeof(*item.value), &item.entry), 0);
+    *item.value = 0;
+    assert_int_equal(coral_hash_container_add(
+            &object, item.entry), 0);
+    uintmax_t count;
+    assert_int_equal(coral_hash_container_count(
+            &object, &count), 0);
+    assert_int_equal(1, count);
+    assert_int_equal(coral_hash_container_remove(
+            &object, item.entry), 0);
+    assert_int_equal(coral_hash_container_count(
+            &object, &count), 0);
+    assert_int_equal(0, count);
+    assert_int_equal(coral_hash_container_free(
+            item.entry), 0);
+    assert_int_equal(coral_hash_container_invalidate(
+            &object, NULL), 0);
+}
+
+static void check_get_error_on_object_is_null(void **state) {
+    assert_int_equal(
+            coral_hash_container_get(NULL, (void *) 1, (void *) 1),
+            CORAL_HASH_CONTAINER_ERROR_OBJECT_IS_NULL);
+}
+
+static void check_get_error_on_key_is_null(void **state) {
+    assert_int_equal(
+            coral_hash_container_get((void *) 1, NULL, (void *) 1),
+            CORAL_HASH_CONTAINER_ERROR_KEY_IS_NULL);
+}
+
+static void check_get_error_on_out_is_null(void **state) {
+    assert_int_equal(
+            coral_hash_container_get((void *) 1, (void *) 1, NULL),
+            CORAL_HASH_CONTAINER_ERROR_OUT_IS_NULL);
+}
+
+static void check_get(void **state) {
+    struct coral_hash_container object;
+    assert_int_equal(coral_hash_container_init(&object, hash, compare), 0);
+    const uintmax_t count = 3;
+    union entry {
+        struct coral_hash_container_entry *entry;
+        uintmax_t *value;
+    } item[count];
+    for (uintmax_t i = 0; i < count; i++) {
+        assert_int_equal(coral_hash_container_alloc(
+                sizeof(uintmax_t), &item[i].entry), 0);
+        *item[i].value = i;
+        assert_int_equal(coral_hash_container_add(
+                &object, item[i].entry), 0);
+    }
+    const uintmax_t key = *item[1].value;
+    union entry other;
+    assert_int_equal(coral_hash_container_get(
+            &object, &key, &other.entry), 0);
+    assert_int_equal(*item[1].value, *other.value);
+    assert_ptr_equal(item[1].entry, other.entry);
+    assert_int_equal(coral_hash_container_invalidate(
+            &object, NULL), 0);
+}
+
+static void check_get_error_on_entry_not_found(void **state) {
+    struct coral_hash_container object;
+    assert_int_equal(coral_hash_container_init(&object, hash, compare), 0);
+    const uintmax_t count = 3;
+    union entry {
+        struct coral_hash_container_entry *entry;
+        uintmax_t *value;
+    } item[count];
+    for (uintmax_t i = 0; i < count; i++) {
+        assert_int_equal(coral_hash_container_alloc(
+                sizeof(uintmax_t), &item[i].entry), 0);
+        *item[i].value = i;
+        assert_int_equal(coral_hash_container_add(
+                &object, item[i].entry), 0);
+    }
+    const uintmax_t key = UINTMAX_MAX;
+    union entry other;
+    assert_int_equal(
+            coral_hash_container_get(&object, &key, &other.entry),
+            CORAL_HASH_CONTAINER_ERROR_ENTRY_NOT_FOUND);
+    assert_int_equal(coral_hash_container_invalidate(
+            &object, NULL), 0);
+}
+
+static void check_counters_error_on_object_is_null(void **state) {
+    assert_int_equal(
+            coral_hash_container_counters(NULL, (void *) 1),
+            CORAL_HASH_CONTAINER_ERROR_OBJECT_IS_NULL);
+}
+
+static void check_counters_error_on_out_is_null(void **state) {
+    assert_int_equal(
+            coral_hash_container_counters((void *) 1, NULL),
+            CORAL_HASH_CONTAINER_ERROR_OUT_IS_NULL);
+}
+
+static void check_counters(void **state) {
+    struct coral_hash_container object;
+    assert_int_equal(coral_hash_container_init(
+            &object, hash, compare), 0);
+    const uintmax_t count = 3;
+    union entry {
+        struct coral_hash_container_entry *entry;
+        uintmax_t *value;
+    } item[count];
+    for (uintmax_t i = 0; i < count; i++) {
+        assert_int_equal(coral_hash_container_alloc(
+                sizeof(uintmax_t), &item[i].entry), 0);
+        *item[i].value = i;
+        assert_int_equal(coral_hash_container_add(
+                &object, item[i].entry), 0);
+    }
+    assert_int_equal(coral_hash_container_remove(
+            &object, item[0].entry), 0);
+    struct coral_counters counters;
+    assert_int_equal(coral_hash_container_counters(
+            &object, &counters), 0);
+#ifdef CORAL_COUNTERS
+    assert_int_equal(counters.insert, count);
+    assert_int_equal(counters.remove, 1);
+    /* groups are matched without comparing entries whose tag differs */
+    assert_true(counters.visit >= count - 1);
+#else
+    assert_int_equal(counters.compare, 0);
+    assert_int_equal(counters.visit, 0);
+    assert_int_equal(counters.insert, 0);
+    assert_int_equal(counters.remove, 0);
+#endif
+    assert_int_equal(coral_hash_container_free(item[0].entry), 0);
+    assert_int_equal(coral_hash_container_invalidate(
+            &object, NULL), 0);
+}
+
+static void check_counters_reset_error_on_object_is_null(void **state) {
+    assert_int_equal(
+            coral_hash_container_counters_reset(NULL),
+            CORAL_HASH_CONTAINER_ERROR_OBJECT_IS_NULL);
+}
+
+static void check_counters_reset(void **state) {
+    struct coral_hash_container object;
+    assert_int_equal(coral_hash_container_init(
+            &object, hash, compare), 0);
+    struct coral_hash_container_entry *entry;
+    assert_int_equal(coral_hash_container_alloc(
+            sizeof(uintmax_t), &entry), 0);
+    *(uintmax_t *) entry = 0;
+    assert_int_equal(coral_hash_container_add(&object, entry), 0);
+    assert_int_equal(coral_hash_container_counters_reset(&object), 0);
+    struct coral_counters counters;
+    assert_int_equal(coral_hash_container_counters(
+            &object, &counters), 0);
+    assert_int_equal(counters.compare, 0);
+    assert_int_equal(counters.visit, 0);
+    assert_int_equal(counters.insert, 0);
+    assert_int_equal(counters.remove, 0);
+    assert_int_equal(coral_hash_container_invalidate(
+            &object, NULL), 0);
+}
+
+static void check_remove_error_on_entry_not_found(void **state) {
+    struct coral_hash_container object;
+    assert_int_equal(coral_hash_container_init(&object, hash, compare), 0);
+    struct coral_hash_container_entry *entry;
+    assert_int_equal(coral_hash_container_alloc(
+            sizeof(uintmax_t), &entry), 0);
+    *(uintmax_t *) entry = 0;
+    assert_int_equal(
+            coral_hash_container_remove(&object, entry),
+            CORAL_HASH_CONTAINER_ERROR_ENTRY_NOT_FOUND);
+    assert_int_equal(coral_hash_container_free(entry), 0);
+    assert_int_equal(coral_hash_container_invalidate(&object, NULL), 0);
+}
+
+static void check_first_error_on_object_is_null(void **state) {
+    assert_int_equal(
+            coral_hash_container_first(NULL, (void *) 1),
+            CORAL_HASH_CONTAINER_ERROR_OBJECT_IS_NULL);
+}
+
+static void check_first_error_on_out_is_null(void **state) {
+    assert_int_equal(
+            coral_hash_container_first((void *) 1, NULL),
+            CORAL_HASH_CONTAINER_ERROR_OUT_IS_NULL);
+}
+
+static void check_first_error_on_container_is_empty(void **state) {
+    struct coral_hash_container object;
+    assert_int_equal(coral_hash_container_init(&object, hash, compare), 0);
+    struct coral_hash_container_entry *entry;
+    assert_int_equal(
+            coral_hash_container_first(&object, &entry),
+            CORAL_HASH_CONTAINER_ERROR_CONTAINER_IS_EMPTY);
+    assert_int_equal(coral_hash_container_invalidate(&object, NULL), 0);
+}
+
+static void check_next_error_on_object_is_null(void **state) {
+    assert_int_equal(
+            coral_hash_container_next(NULL, (void *) 1, (void *) 1),
+            CORAL_HASH_CONTAINER_ERROR_OBJECT_IS_NULL);
+}
+
+static void check_next_error_on_entry_is_null(void **state) {
+    assert_int_equal(
+            coral_hash_container_next((void *) 1, NULL, (void *) 1),
+            CORAL_HASH_CONTAINER_ERROR_ENTRY_IS_NULL);
+}
+
+static void check_next_error_on_out_is_null(void **state) {
+    assert_int_equal(
+            coral_hash_container_next((void *) 1, (void *) 1, NULL),
+            CORAL_HASH_CONTAINER_ERROR_OUT_IS_NULL);
+}
+
+static void add_values(struct coral_hash_container *const object,
+                       const uintmax_t first,
+                       const uintmax_t last) {
+    for (uintmax_t i = first; i < last; i++) {
+        struct coral_hash_container_entry *entry;
+        assert_int_equal(coral_hash_container_alloc(
+                sizeof(uintmax_t), &entry), 0);
+        *(uintmax_t *) entry = i;
+        assert_int_equal(coral_hash_container_add(object, entry), 0);
+    }
+}
+
+/* every value from first up to last is present exactly once */
+static void expect_values(const struct coral_hash_container *const object,
+                          const uintmax_t first,
+                          const uintmax_t last) {
+    uintmax_t count;
+    assert_int_equal(coral_hash_container_count(object, &count), 0);
+    assert_int_equal(count, last - first);
+    bool *const seen = calloc(last - first + 1, sizeof(*seen));
+    assert_non_null(seen);
+    struct coral_hash_container_entry *entry;
+    int error = coral_hash_container_first(object, &entry);
+    for (uintmax_t i = 0; i < count; i++) {
+        assert_int_equal(error, 0);
+        const uintmax_t value = *(uintmax_t *) entry;
+        assert_true(first <= value && value < last);
+        assert_false(seen[value - first]);
+        seen[value - first] = true;
+        error = coral_hash_container_next(object, entry, &entry);
+    }
+    assert_int_equal(error, count
+                            ? CORAL_HASH_CONTAINER_ERROR_END_OF_SEQUENCE
+                            : CORAL_HASH_CONTAINER_ERROR_CONTAINER_IS_EMPTY);
+    free(seen);
+    for (uintmax_t i = first; i < last; i++) {
+        assert_int_equal(coral_hash_container_get(object, &i, &entry), 0);
+        assert_int_equal(*(uintmax_t *) entry, i);
+    }
+}
+
+static void check_first_and_next(void **state) {
+    struct coral_hash_container object;
+    assert_int_equal(coral_hash_container_init(&object, hash, compare), 0);
+    add_values(&object, 0, 100);
+    expect_values(&object, 0, 100);
+    assert_int_equal(coral_hash_container_invalidate(&object, NULL), 0);
+}
+
+static void remove_values(struct coral_hash_container *const object,
+                          const uintmax_t first,
+                          const uintmax_t last) {
+    for (uintmax_t i = first; i < last; i++) {
+        struct coral_hash_container_entry *entry;
+        assert_int_equal(coral_hash_container_get(object, &i, &entry), 0);
+        assert_int_equal(coral_hash_container_remove(object, entry), 0);
+        assert_int_equal(coral_hash_container_free(entry), 0);
+        assert_int_equal(
+                coral_hash_container_get(object, &i, &entry),
+                CORAL_HASH_CONTAINER_ERROR_ENTRY_NOT_FOUND);
+    }
+}
+
+static void check_add_and_remove_many(void **state) {
+    struct coral_hash_container object;
+    assert_int_equal(coral_hash_container_init(&object, hash, compare), 0);
+    add_values(&object, 0, 10000);
+    expect_values(&object, 0, 10000);
+    remove_values(&object, 0, 5000);
+    expect_values(&object, 5000, 10000);
+    add_values(&object, 0, 5000);
+    expect_values(&object, 0, 10000);
+    remove_values(&object, 0, 10000);
+    expect_values(&object, 0, 0);
+    assert_int_equal(coral_hash_container_invalidate(&object, NULL), 0);
+}
+
+static void check_churn(void **state) {
+    struct coral_hash_container object;
+    assert_int_equal(coral_hash_container_init(&object, hash, compare), 0);
+    /* a window sliding over the keys leaves deleted slots behind which must
+     * be reclaimed instead of growing the table without bound */
+    const uintmax_t window = 100;
+    add_values(&object, 0, window);
+    for (uintmax_t i = 0; i < 20000; i++) {
+        remove_values(&object, i, i + 1);
+        add_values(&object, i + window, i + window + 1);
+    }
+    expect_values(&object, 20000, 20000 + window);
+    assert_true(object.table.capacity <= 4 * window);
+    assert_int_equal(coral_hash_container_invalidate(&object, NULL), 0);
+}
+
+static size_t collide(const void *a) {
+    return 42;
+}
+
+static void check_colliding_hashes(void **state) {
+    struct coral_hash_container object;
+    assert_int_equal(coral_hash_container_init(&object, collide, compare), 0);
+    add_values(&object, 0, 300);
+    expect_values(&object, 0, 300);
+    remove_values(&object, 0, 150);
+    expect_values(&object, 150, 300);
+    assert_int_equal(coral_hash_container_invalidate(&object, NULL), 0);
+}
+
+static uintmax_t destroyed_entries;
+
+static void on_destroy(struct coral_hash_container_entry *const entry) {
+    destroyed_entries++;
+}
+
+static void check_invalidate_with_on_destroy(void **state) {
+    struct coral_hash_container object;
+    assert_int_equal(coral_hash_container_init(&object, hash, compare), 0);
+    add_values(&object, 0, 300);
+    destroyed_entries = 0;
+    assert_int_equal(coral_hash_container_invalidate(
+            &object, on_destroy), 0);
+    assert_int_equal(destroyed_entries, 300);
+    assert_null(object.table.control);
+    assert_int_equal(object.table.count, 0);
+}
+
+static void check_add_error_on_memory_allocation_failed(void **state) {
+    struct coral_hash_container object;
+    assert_int_equal(coral_hash_container_init(&object, hash, compare), 0);
+    /* fills the first table up to its limit so that the next add grows it */
+    add_values(&object, 0, 14);
+    struct coral_hash_container_entry *entry;
+    assert_int_equal(coral_hash_container_alloc(
+            sizeof(uintmax_t), &entry), 0);
+    *(uintmax_t *) entry = 14;
+    calloc_is_overridden = true;
+    assert_int_equal(
+            coral_hash_container_add(&object, entry),
+            CORAL_HASH_CONTAINER_ERROR_MEMORY_ALLOCATION_FAILED);
+    calloc_is_overridden = false;
+    expect_values(&object, 0, 14);
+    assert_int_equal(coral_hash_container_add(&object, entry), 0);
+    expect_values(&object, 0, 15);
+    assert_int_equal(coral_hash_container_invalidate(&object, NULL), 0);
+}
+
+/* add values from first on until a table is being replaced, the value
+ * after the last one added is returned */
+static uintmax_t add_until_resizing(
+        struct coral_hash_container *const object,
+        uintmax_t i) {
+    do {
+        add_values(object, i, i + 1);
+        i++;
+    } while (!object->table.old_count);
+    return i;
+}
+
+static void check_add_during_resize(void **state) {
+    struct coral_hash_container object;
+    assert_int_equal(coral_hash_container_init(
+            &object, hash, compare), 0);
+    add_values(&object, 0, 1000);
+    const uintmax_t count = add_until_resizing(&object, 1000);
+    expect_values(&object, 0, count);
+    /* every add moves at most one group of the old table */
+    uintmax_t i = count;
+    for (; object.table.old_control; i++) {
+        const size_t old_count = object.table.old_count;
+        add_values(&object, i, i + 1);
+        assert_true(old_count - object.table.old_count <= 16);
+        expect_values(&object, 0, i + 1);
+    }
+    assert_int_equal(object.table.old_count, 0);
+    assert_null(object.table.old_slots);
+    expect_values(&object, 0, i);
+    assert_int_equal(coral_hash_container_invalidate(&object, NULL), 0);
+}
+
+static void check_remove_during_resize(void **state) {
+    struct coral_hash_container object;
+    assert_int_equal(coral_hash_container_init(
+            &object, hash, compare), 0);
+    const uintmax_t count = add_until_resizing(&object, 0);
+    /* values are removed from both the old and the new table */
+    uintmax_t i = 0;
+    for (; object.table.old_control; i++) {
+        remove_values(&object, i, i + 1);
+        expect_values(&object, i + 1, count);
+    }
+    assert_true(i < count);
+    remove_values(&object, i, count);
+    expect_values(&object, 0, 0);
+    assert_int_equal(coral_hash_container_invalidate(&object, NULL), 0);
+}
+
+static void check_invalidate_during_resize(void **state) {
+    struct coral_hash_container object;
+    assert_int_equal(coral_hash_container_init(
+            &object, hash, compare), 0);
+    const uintmax_t count = add_until_resizing(&object, 0);
+    assert_non_null(object.table.old_control);
+    destroyed_entries = 0;
+    assert_int_equal(coral_hash_container_invalidate(
+            &object, on_destroy), 0);
+    assert_int_equal(destroyed_entries, count);
+    assert_null(object.table.old_control);
+}
+
+int main(int argc, char *argv[]) {
+    const struct CMUnitTest tests[] = {
+            cmocka_unit_test(check_free_error_on_entry_is_null),
+            cmocka_unit_test(check_free),
+            cmocka_unit_test(check_alloc_error_on_size_is_zero),
+            cmocka_unit_test(check_alloc_error_on_out_is_null),
+            cmocka_unit_test(check_alloc),
+            cmocka_unit_test(check_alloc_error_on_size_is_too_large),
+            cmocka_unit_test(check_alloc_error_on_memory_allocation_failed),
+            cmocka_unit_test(check_alloc_with),
+            cmocka_unit_test(check_invalidate_error_on_object_is_null),
+            cmocka_unit_test(check_invalidate),
+            cmocka_unit_test(check_init_error_on_object_is_null),
+            cmocka_unit_test(check_init_error_on_hash_is_null),
+            cmocka_unit_test(check_init_error_on_compare_is_null),
+            cmocka_unit_test(check_init),
+            cmocka_unit_test(check_count_error_on_object_is_null),
+            cmocka_unit_test(check_count_error_on_out_is_null),
+            cmocka_unit_test(check_count),
+            cmocka_unit_test(check_add_error_on_object_is_null),
+            cmocka_unit_test(check_add_error_on_entry_is_null),
+            cmocka_unit_test(check_add),
+            cmocka_unit_test(check_add_error_on_entry_already_exits),
+            cmocka_unit_test(check_remove_error_on_object_is_null),
+            cmocka_unit_test(check_remove_error_on_entry_is_null),
+            cmocka_unit_test(check_remove),
+            cmocka_unit_test(check_get_error_on_object_is_null),
+            cmocka_unit_test(check_get_error_on_key_is_null),
+            cmocka_unit_test(check_get_error_on_out_is_null),
+            cmocka_unit_test(check_get),
+            cmocka_unit_test(check_get_error_on_entry_not_found),
+            cmocka_unit_test(check_counters_error_on_object_is_null),
+            cmocka_unit_test(check_counters_error_on_out_is_null),
+            cmocka_unit_test(check_counters),
+            cmocka_unit_test(check_counters_reset_error_on_object_is_null),
+            cmocka_unit_test(check_counters_reset),
+            cmocka_unit_test(check_remove_error_on_entry_not_found),
+            cmocka_unit_test(check_first_error_on_object_is_null),
+            cmocka_unit_test(check_first_error_on_out_is_null),
+            cmocka_unit_test(check_first_error_on_container_is_empty),
+            cmocka_unit_test(check_next_error_on_object_is_null),
+            cmocka_unit_test(check_next_error_on_entry_is_null),
+            cmocka_unit_test(check_next_error_on_out_is_null),
+            cmocka_unit_test(check_first_and_next),
+            cmocka_unit_test(check_add_and_remove_many),
+            cmocka_unit_test(check_churn),
+            cmocka_unit_test(check_colliding_hashes),
+            cmocka_unit_test(check_invalidate_with_on_destroy),
+            cmocka_unit_test(check_add_error_on_memory_allocation_failed),
+            cmocka_unit_test(check_add_during_resize),
+            cmocka_unit_test(check_remove_during_resize),
+            cmocka_unit_test(check_invalidate_during_resize),
+    };
+    //cmocka_set_message_output(CM_OUTPUT_XML);
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
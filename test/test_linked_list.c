@@ -2,11 +2,14 @@
 #include <stddef.h>
 #include <stdint.h>
 #include <setjmp.h>
+#include <stdlib.h>
 #include <cmocka.h>
 #include <coral.h>
 
 #include <test/cmocka.h>
 
+#include "statistics_allocator.h"
+
 static void check_free_error_on_item_is_null(void **state) {
     assert_int_equal(
             coral_linked_list_free(NULL),
@@ -53,6 +56,125 @@ static void check_alloc_error_on_memory_allocation_failed(void **state) {
             = posix_memalign_is_overridden = false;
 }
 
+static void check_alloc_with(void **state) {
+    struct statistics statistics = {};
+    const struct coral_allocator allocator = {
+            .alloc = statistics_alloc,
+            .free = statistics_free,
+            .context = &statistics
+    };
+    struct coral_linked_list_item *item;
+    assert_int_equal(coral_linked_list_alloc_with(
+            &allocator, 1, &item), 0);
+    assert_int_equal(statistics.alloc, 1);
+    assert_int_equal(coral_linked_list_free(item), 0);
+    assert_int_equal(statistics.free, 1);
+}
+
+static void check_arena_alloc_error_on_object_is_null(void **state) {
+    assert_int_equal(
+            coral_linked_list_arena_alloc(NULL, 1, (void *) 1),
+            CORAL_LINKED_LIST_ERROR_OBJECT_IS_NULL);
+}
+
+static void check_arena_alloc_error_on_size_is_zero(void **state) {
+    assert_int_equal(
+            coral_linked_list_arena_alloc((void *) 1, 0, (void *) 1),
+            CORAL_LINKED_LIST_ERROR_SIZE_IS_ZERO);
+}
+
+static void check_arena_alloc_error_on_out_is_null(void **state) {
+    assert_int_equal(
+            coral_linked_list_arena_alloc((void *) 1, 1, NULL),
+            CORAL_LINKED_LIST_ERROR_OUT_IS_NULL);
+}
+
+static void check_arena_alloc_error_on_size_is_too_large(void **state) {
+    struct coral_linked_list object;
+    assert_int_equal(coral_linked_list_init(&object), 0);
+    assert_int_equal(
+            coral_linked_list_arena_alloc(&object, UINTMAX_MAX, (void *) 1),
+            CORAL_LINKED_LIST_ERROR_SIZE_IS_TOO_LARGE);
+    assert_int_equal(coral_linked_list_invalidate(&object, NULL), 0);
+}
+
+static void check_arena_alloc_error_on_memory_allocation_failed(
+        void **state) {
+    struct coral_linked_list object;
+    assert_int_equal(coral_linked_list_init(&object), 0);
+    malloc_is_overridden = calloc_is_overridden = realloc_is_overridden
+            = posix_memalign_is_overridden = true;
+    assert_int_equal(
+            coral_linked_list_arena_alloc(&object, 1, (void *) 1),
+            CORAL_LINKED_LIST_ERROR_MEMORY_ALLOCATION_FAILED);
+    malloc_is_overridden = calloc_is_overridden = realloc_is_overridden
+            = posix_memalign_is_overridden = false;
+    assert_int_equal(coral_linked_list_invalidate(&object, NULL), 0);
+}
+
+static void check_arena_alloc(void **state) {
+    struct coral_linked_list object;
+    assert_int_equal(coral_linked_list_init(&object), 0);
+    union {
+        struct coral_linked_list_item *item;
+        uintmax_t *value;
+    } ptr;
+    for (uintmax_t i = 0; i < 10000; i++) {
+        assert_int_equal(coral_linked_list_arena_alloc(
+                &object, sizeof(*ptr.value), &ptr.item), 0);
+        *ptr.value = i;
+        assert_int_equal(coral_linked_list_add(&object, ptr.item), 0);
+    }
+    assert_int_equal(object.count, 10000);
+    assert_int_equal(object.foreign, 0);
+    assert_int_equal(coral_linked_list_first(&object, &ptr.item), 0);
+    assert_int_equal(*ptr.value, 0);
+    assert_int_equal(coral_linked_list_last(&object, &ptr.item), 0);
+    assert_int_equal(*ptr.value, 9999);
+    /* the items are released along with the arena */
+    assert_int_equal(coral_linked_list_invalidate(&object, NULL), 0);
+}
+
+static uintmax_t destroyed;
+
+static void on_destroy(struct coral_linked_list_item *item) {
+    destroyed++;
+}
+
+static void check_invalidate_case_arena_with_on_destroy(void **state) {
+    struct coral_linked_list object;
+    assert_int_equal(coral_linked_list_init(&object), 0);
+    struct coral_linked_list_item *item;
+    for (uintmax_t i = 0; i < 3; i++) {
+        assert_int_equal(coral_linked_list_arena_alloc(
+                &object, 1, &item), 0);
+        assert_int_equal(coral_linked_list_add(&object, item), 0);
+    }
+    destroyed = 0;
+    assert_int_equal(coral_linked_list_invalidate(&object, on_destroy), 0);
+    assert_int_equal(destroyed, 3);
+}
+
+static void check_invalidate_case_arena_with_foreign_items(void **state) {
+    struct coral_linked_list object;
+    assert_int_equal(coral_linked_list_init(&object), 0);
+    struct coral_linked_list_item *item;
+    assert_int_equal(coral_linked_list_arena_alloc(&object, 1, &item), 0);
+    assert_int_equal(coral_linked_list_add(&object, item), 0);
+    struct coral_linked_list_item *value;
+    assert_int_equal(coral_linked_list_alloc(1, &value), 0);
+    assert_int_equal(coral_linked_list_insert(&object, item, value), 0);
+    assert_int_equal(object.foreign, 1);
+    assert_int_equal(coral_linked_list_alloc(1, &value), 0);
+    assert_int_equal(coral_linked_list_add(&object, value), 0);
+    assert_int_equal(object.foreign, 2);
+    assert_int_equal(coral_linked_list_remove(&object, value), 0);
+    assert_int_equal(object.foreign, 1);
+    assert_int_equal(coral_linked_list_free(value), 0);
+    /* foreign items are still visited and freed */
+    assert_int_equal(coral_linked_list_invalidate(&object, NULL), 0);
+}
+
 static void check_invalidate_error_on_object_is_null(void **state) {
     assert_int_equal(
             coral_linked_list_invalidate(NULL, (void *) 1),
@@ -114,6 +236,20 @@ static void check_add_error_on_item_is_null(void **state) {
             CORAL_LINKED_LIST_ERROR_ITEM_IS_NULL);
 }
 
+static void check_add_error_on_item_is_from_other_list(void **state) {
+    struct coral_linked_list object[2];
+    assert_int_equal(coral_linked_list_init(&object[0]), 0);
+    assert_int_equal(coral_linked_list_init(&object[1]), 0);
+    struct coral_linked_list_item *item;
+    assert_int_equal(coral_linked_list_arena_alloc(&object[0], 1, &item), 0);
+    assert_int_equal(coral_linked_list_add(&object[1], item),
+                     CORAL_LINKED_LIST_ERROR_ITEM_IS_FROM_OTHER_LIST);
+    assert_int_equal(object[1].count, 0);
+    assert_int_equal(object[1].foreign, 0);
+    assert_int_equal(coral_linked_list_invalidate(&object[0], NULL), 0);
+    assert_int_equal(coral_linked_list_invalidate(&object[1], NULL), 0);
+}
+
 static void check_add(void **state) {
     srand(time(NULL));
     const uintmax_t limit = 2;
@@ -153,6 +289,23 @@ static void check_insert_error_on_value_is_null(void **state) {
             CORAL_LINKED_LIST_ERROR_VALUE_IS_NULL);
 }
 
+static void check_insert_error_on_item_is_from_other_list(void **state) {
+    struct coral_linked_list object[2];
+    assert_int_equal(coral_linked_list_init(&object[0]), 0);
+    assert_int_equal(coral_linked_list_init(&object[1]), 0);
+    struct coral_linked_list_item *item;
+    assert_int_equal(coral_linked_list_arena_alloc(&object[1], 1, &item), 0);
+    assert_int_equal(coral_linked_list_add(&object[1], item), 0);
+    struct coral_linked_list_item *value;
+    assert_int_equal(coral_linked_list_arena_alloc(&object[0], 1, &value), 0);
+    assert_int_equal(coral_linked_list_insert(&object[1], item, value),
+                     CORAL_LINKED_LIST_ERROR_ITEM_IS_FROM_OTHER_LIST);
+    assert_int_equal(object[1].count, 1);
+    assert_int_equal(object[1].foreign, 0);
+    assert_int_equal(coral_linked_list_invalidate(&object[0], NULL), 0);
+    assert_int_equal(coral_linked_list_invalidate(&object[1], NULL), 0);
+}
+
 static void check_insert(void **state) {
     struct coral_linked_list object;
     assert_int_equal(coral_linked_list_init(&object), 0);
@@ -442,6 +595,153 @@ static void check_prev(void **state) {
     assert_int_equal(coral_linked_list_invalidate(&object, NULL), 0);
 }
 
+struct thing {
+    uintmax_t value;
+    struct coral_linked_list_node node;
+};
+
+static void check_node_init_error_on_node_is_null(void **state) {
+    assert_int_equal(
+            coral_linked_list_node_init(NULL),
+            CORAL_LINKED_LIST_ERROR_NODE_IS_NULL);
+}
+
+static void check_add_node_error_on_object_is_null(void **state) {
+    assert_int_equal(
+            coral_linked_list_add_node(NULL, (void *) 1),
+            CORAL_LINKED_LIST_ERROR_OBJECT_IS_NULL);
+}
+
+static void check_add_node_error_on_node_is_null(void **state) {
+    assert_int_equal(
+            coral_linked_list_add_node((void *) 1, NULL),
+            CORAL_LINKED_LIST_ERROR_NODE_IS_NULL);
+}
+
+static void check_add_node(void **state) {
+    struct coral_linked_list object;
+    assert_int_equal(coral_linked_list_init(&object), 0);
+    struct thing things[2];
+    for (uintmax_t i = 0; i < 2; i++) {
+        assert_int_equal(coral_linked_list_node_init(&things[i].node), 0);
+        assert_int_equal(coral_linked_list_add_node(
+                &object, &things[i].node), 0);
+    }
+    uintmax_t count;
+    assert_int_equal(coral_linked_list_count(&object, &count), 0);
+    assert_int_equal(count, 2);
+    assert_int_equal(coral_linked_list_invalidate(&object, NULL), 0);
+}
+
+static void check_insert_node_error_on_object_is_null(void **state) {
+    assert_int_equal(
+            coral_linked_list_insert_node(NULL, (void *) 1, (void *) 1),
+            CORAL_LINKED_LIST_ERROR_OBJECT_IS_NULL);
+}
+
+static void check_insert_node_error_on_node_is_null(void **state) {
+    assert_int_equal(
+            coral_linked_list_insert_node((void *) 1, NULL, (void *) 1),
+            CORAL_LINKED_LIST_ERROR_NODE_IS_NULL);
+}
+
+static void check_insert_node_error_on_value_is_null(void **state) {
+    assert_int_equal(
+            coral_linked_list_insert_node((void *) 1, (void *) 1, NULL),
+            CORAL_LINKED_LIST_ERROR_VALUE_IS_NULL);
+}
+
+static void check_insert_node(void **state) {
+    struct coral_linked_list object;
+    assert_int_equal(coral_linked_list_init(&object), 0);
+    struct thing a, b;
+    assert_int_equal(coral_linked_list_node_init(&a.node), 0);
+    assert_int_equal(coral_linked_list_node_init(&b.node), 0);
+    assert_int_equal(coral_linked_list_add_node(&object, &a.node), 0);
+    assert_int_equal(coral_linked_list_insert_node(
+            &object, &a.node, &b.node), 0);
+    struct coral_linked_list_node *node;
+    assert_int_equal(coral_linked_list_first_node(&object, &node), 0);
+    assert_ptr_equal(node, &b.node);
+    assert_int_equal(coral_linked_list_invalidate(&object, NULL), 0);
+}
+
+static void check_remove_node_error_on_object_is_null(void **state) {
+    assert_int_equal(
+            coral_linked_list_remove_node(NULL, (void *) 1),
+            CORAL_LINKED_LIST_ERROR_OBJECT_IS_NULL);
+}
+
+static void check_remove_node_error_on_node_is_null(void **state) {
+    assert_int_equal(
+            coral_linked_list_remove_node((void *) 1, NULL),
+            CORAL_LINKED_LIST_ERROR_NODE_IS_NULL);
+}
+
+static void check_remove_node(void **state) {
+    struct coral_linked_list object;
+    assert_int_equal(coral_linked_list_init(&object), 0);
+    struct thing a;
+    assert_int_equal(coral_linked_list_node_init(&a.node), 0);
+    assert_int_equal(coral_linked_list_add_node(&object, &a.node), 0);
+    assert_int_equal(coral_linked_list_remove_node(&object, &a.node), 0);
+    uintmax_t count;
+    assert_int_equal(coral_linked_list_count(&object, &count), 0);
+    assert_int_equal(count, 0);
+    struct coral_linked_list_node *node;
+    assert_int_equal(coral_linked_list_first_node(&object, &node),
+                     CORAL_LINKED_LIST_ERROR_LIST_IS_EMPTY);
+    assert_int_equal(coral_linked_list_last_node(&object, &node),
+                     CORAL_LINKED_LIST_ERROR_LIST_IS_EMPTY);
+    assert_int_equal(coral_linked_list_invalidate(&object, NULL), 0);
+}
+
+static void check_next_node_and_prev_node(void **state) {
+    struct coral_linked_list object;
+    assert_int_equal(coral_linked_list_init(&object), 0);
+    struct thing things[3];
+    for (uintmax_t i = 0; i < 3; i++) {
+        assert_int_equal(coral_linked_list_node_init(&things[i].node), 0);
+        assert_int_equal(coral_linked_list_add_node(
+                &object, &things[i].node), 0);
+    }
+    struct coral_linked_list_node *node;
+    assert_int_equal(coral_linked_list_first_node(&object, &node), 0);
+    for (uintmax_t i = 0; i < 2; i++) {
+        assert_ptr_equal(node, &things[i].node);
+        assert_int_equal(coral_linked_list_next_node(
+                &object, node, &node), 0);
+    }
+    assert_ptr_equal(node, &things[2].node);
+    assert_int_equal(coral_linked_list_next_node(&object, node, &node),
+                     CORAL_LINKED_LIST_ERROR_END_OF_SEQUENCE);
+    assert_int_equal(coral_linked_list_last_node(&object, &node), 0);
+    for (uintmax_t i = 2; i; i--) {
+        assert_ptr_equal(node, &things[i].node);
+        assert_int_equal(coral_linked_list_prev_node(
+                &object, node, &node), 0);
+    }
+    assert_ptr_equal(node, &things[0].node);
+    assert_int_equal(coral_linked_list_prev_node(&object, node, &node),
+                     CORAL_LINKED_LIST_ERROR_END_OF_SEQUENCE);
+    assert_int_equal(coral_linked_list_invalidate(&object, NULL), 0);
+}
+
+static void check_invalidate_with_nodes(void **state) {
+    struct coral_linked_list object;
+    assert_int_equal(coral_linked_list_init(&object), 0);
+    struct thing a;
+    assert_int_equal(coral_linked_list_node_init(&a.node), 0);
+    assert_int_equal(coral_linked_list_add_node(&object, &a.node), 0);
+    struct coral_linked_list_item *item;
+    assert_int_equal(coral_linked_list_alloc(sizeof(uintmax_t), &item), 0);
+    assert_int_equal(coral_linked_list_add(&object, item), 0);
+    destroyed = 0;
+    assert_int_equal(coral_linked_list_invalidate(&object, on_destroy), 0);
+    /* intrusive nodes are only unlinked */
+    assert_int_equal(destroyed, 1);
+}
+
 int main(int argc, char *argv[]) {
     const struct CMUnitTest tests[] = {
             cmocka_unit_test(check_free_error_on_item_is_null),
@@ -451,8 +751,19 @@ int main(int argc, char *argv[]) {
             cmocka_unit_test(check_alloc),
             cmocka_unit_test(check_alloc_error_on_size_is_too_large),
             cmocka_unit_test(check_alloc_error_on_memory_allocation_failed),
+            cmocka_unit_test(check_alloc_with),
             cmocka_unit_test(check_invalidate_error_on_object_is_null),
+            cmocka_unit_test(check_arena_alloc_error_on_object_is_null),
+            cmocka_unit_test(check_arena_alloc_error_on_size_is_zero),
+            cmocka_unit_test(check_arena_alloc_error_on_out_is_null),
+            cmocka_unit_test(check_arena_alloc_error_on_size_is_too_large),
+            cmocka_unit_test(
+                    check_arena_alloc_error_on_memory_allocation_failed),
+            cmocka_unit_test(check_arena_alloc),
             cmocka_unit_test(check_invalidate),
+            cmocka_unit_test(check_invalidate_case_arena_with_on_destroy),
+            cmocka_unit_test(
+                    check_invalidate_case_arena_with_foreign_items),
             cmocka_unit_test(check_init_error_on_object_is_null),
             cmocka_unit_test(check_init),
             cmocka_unit_test(check_count_error_on_object_is_null),
@@ -460,10 +771,12 @@ int main(int argc, char *argv[]) {
             cmocka_unit_test(check_count),
             cmocka_unit_test(check_add_error_on_object_is_null),
             cmocka_unit_test(check_add_error_on_item_is_null),
+            cmocka_unit_test(check_add_error_on_item_is_from_other_list),
             cmocka_unit_test(check_add),
             cmocka_unit_test(check_insert_error_on_object_is_null),
             cmocka_unit_test(check_insert_error_on_item_is_null),
             cmocka_unit_test(check_insert_error_on_value_is_null),
+            cmocka_unit_test(check_insert_error_on_item_is_from_other_list),
             cmocka_unit_test(check_insert),
             cmocka_unit_test(check_remove_error_on_object_is_null),
             cmocka_unit_test(check_remove_error_on_item_is_null),
@@ -487,6 +800,19 @@ int main(int argc, char *argv[]) {
             cmocka_unit_test(check_prev_error_on_out_is_null),
             cmocka_unit_test(check_prev_error_on_end_of_sequence),
             cmocka_unit_test(check_prev),
+            cmocka_unit_test(check_node_init_error_on_node_is_null),
+            cmocka_unit_test(check_add_node_error_on_object_is_null),
+            cmocka_unit_test(check_add_node_error_on_node_is_null),
+            cmocka_unit_test(check_add_node),
+            cmocka_unit_test(check_insert_node_error_on_object_is_null),
+            cmocka_unit_test(check_insert_node_error_on_node_is_null),
+            cmocka_unit_test(check_insert_node_error_on_value_is_null),
+            cmocka_unit_test(check_insert_node),
+            cmocka_unit_test(check_remove_node_error_on_object_is_null),
+            cmocka_unit_test(check_remove_node_error_on_node_is_null),
+            cmocka_unit_test(check_remove_node),
+            cmocka_unit_test(check_next_node_and_prev_node),
+            cmocka_unit_test(check_invalidate_with_nodes),
     };
     //cmocka_set_message_output(CM_OUTPUT_XML);
     return cmocka_run_group_tests(tests, NULL, NULL);
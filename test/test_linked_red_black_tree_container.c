@@ -2,12 +2,15 @@
 #include <stddef.h>
 #include <stdint.h>
 #include <setjmp.h>
+#include <stdlib.h>
 #include <cmocka.h>
 #include <coral.h>
 #include <seagrass.h>
 
 #include <test/cmocka.h>
 
+#include "statistics_allocator.h"
+
 static void check_free_error_on_entry_is_null(void **state) {
     assert_int_equal(
             coral_linked_red_black_tree_container_free(NULL),
@@ -55,6 +58,21 @@ static void check_alloc_error_on_memory_allocation_failed(void **state) {
             = posix_memalign_is_overridden = false;
 }
 
+static void check_alloc_with(void **state) {
+    struct statistics statistics = {};
+    const struct coral_allocator allocator = {
+            .alloc = statistics_alloc,
+            .free = statistics_free,
+            .context = &statistics
+    };
+    struct coral_linked_red_black_tree_container_entry *entry;
+    assert_int_equal(coral_linked_red_black_tree_container_alloc_with(
+            &allocator, 1, &entry), 0);
+    assert_int_equal(statistics.alloc, 1);
+    assert_int_equal(coral_linked_red_black_tree_container_free(entry), 0);
+    assert_int_equal(statistics.free, 1);
+}
+
 static void check_invalidate_error_on_object_is_null(void **state) {
     assert_int_equal(
             coral_linked_red_black_tree_container_invalidate(NULL, (void *) 1),
@@ -454,6 +472,33 @@ static void check_ceiling(void **state) {
             &object, NULL), 0);
 }
 
+static void check_ceiling_on_ancestor(void **state) {
+    struct coral_linked_red_black_tree_container object;
+    assert_int_equal(coral_linked_red_black_tree_container_init(
+            &object, compare), 0);
+    const uintmax_t count = 2;
+    union entry {
+        struct coral_linked_red_black_tree_container_entry *entry;
+        uintmax_t *value;
+    } item[count];
+    /* search for the key ends on the lower entry, the match is its parent */
+    for (uintmax_t i = 0; i < count; i++) {
+        assert_int_equal(coral_linked_red_black_tree_container_alloc(
+                sizeof(uintmax_t), &item[i].entry), 0);
+        *item[i].value = 4 >> (2 * i);
+        assert_int_equal(coral_linked_red_black_tree_container_add(
+                &object, item[i].entry), 0);
+    }
+    uintmax_t key = 2;
+    union entry other;
+    assert_int_equal(coral_linked_red_black_tree_container_ceiling(
+            &object, &key, &other.entry), 0);
+    assert_int_equal(*item[0].value, *other.value);
+    assert_ptr_equal(item[0].entry, other.entry);
+    assert_int_equal(coral_linked_red_black_tree_container_invalidate(
+            &object, NULL), 0);
+}
+
 static void check_ceiling_error_on_entry_not_found(void **state) {
     struct coral_linked_red_black_tree_container object;
     assert_int_equal(coral_linked_red_black_tree_container_init(
@@ -620,6 +665,33 @@ static void check_higher(void **state) {
             &object, NULL), 0);
 }
 
+static void check_higher_on_ancestor(void **state) {
+    struct coral_linked_red_black_tree_container object;
+    assert_int_equal(coral_linked_red_black_tree_container_init(
+            &object, compare), 0);
+    const uintmax_t count = 2;
+    union entry {
+        struct coral_linked_red_black_tree_container_entry *entry;
+        uintmax_t *value;
+    } item[count];
+    /* search for the key ends on the lower entry, the match is its parent */
+    for (uintmax_t i = 0; i < count; i++) {
+        assert_int_equal(coral_linked_red_black_tree_container_alloc(
+                sizeof(uintmax_t), &item[i].entry), 0);
+        *item[i].value = 4 >> (2 * i);
+        assert_int_equal(coral_linked_red_black_tree_container_add(
+                &object, item[i].entry), 0);
+    }
+    uintmax_t key = 2;
+    union entry other;
+    assert_int_equal(coral_linked_red_black_tree_container_higher(
+            &object, &key, &other.entry), 0);
+    assert_int_equal(*item[0].value, *other.value);
+    assert_ptr_equal(item[0].entry, other.entry);
+    assert_int_equal(coral_linked_red_black_tree_container_invalidate(
+            &object, NULL), 0);
+}
+
 static void check_higher_error_on_entity_not_found(void **state) {
     struct coral_linked_red_black_tree_container object;
     assert_int_equal(coral_linked_red_black_tree_container_init(
@@ -1233,6 +1305,1568 @@ static void check_prev_error_on_end_of_sequence(void **state) {
             &object, NULL), 0);
 }
 
+static void check_counters_error_on_object_is_null(void **state) {
+    assert_int_equal(
+            coral_linked_red_black_tree_container_counters(NULL, (void *) 1),
+            CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_OBJECT_IS_NULL);
+}
+
+static void check_counters_error_on_out_is_null(void **state) {
+    assert_int_equal(
+            coral_linked_red_black_tree_container_counters((void *) 1, NULL),
+            CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_OUT_IS_NULL);
+}
+
+static void check_counters(void **state) {
+    struct coral_linked_red_black_tree_container object;
+    assert_int_equal(coral_linked_red_black_tree_container_init(
+            &object, compare), 0);
+    const uintmax_t count = 3;
+    union entry {
+        struct coral_linked_red_black_tree_container_entry *entry;
+        uintmax_t *value;
+    } item[count];
+    for (uintmax_t i = 0; i < count; i++) {
+        assert_int_equal(coral_linked_red_black_tree_container_alloc(
+                sizeof(uintmax_t), &item[i].entry), 0);
+        *item[i].value = i;
+        assert_int_equal(coral_linked_red_black_tree_container_add(
+                &object, item[i].entry), 0);
+    }
+    assert_int_equal(coral_linked_red_black_tree_container_remove(
+            &object, item[0].entry), 0);
+    struct coral_counters counters;
+    assert_int_equal(coral_linked_red_black_tree_container_counters(
+            &object, &counters), 0);
+#ifdef CORAL_COUNTERS
+    assert_int_equal(counters.insert, count);
+    assert_int_equal(counters.remove, 1);
+    assert_true(counters.compare >= counters.visit);
+    assert_true(counters.visit >= count - 1);
+    /* adding in order rotates once, at the third entry */
+    assert_int_equal(counters.rotate, 1);
+#else
+    assert_int_equal(counters.compare, 0);
+    assert_int_equal(counters.visit, 0);
+    assert_int_equal(counters.insert, 0);
+    assert_int_equal(counters.remove, 0);
+    assert_int_equal(counters.rotate, 0);
+#endif
+    assert_int_equal(coral_linked_red_black_tree_container_free(item[0].entry), 0);
+    assert_int_equal(coral_linked_red_black_tree_container_invalidate(
+            &object, NULL), 0);
+}
+
+static void check_counters_reset_error_on_object_is_null(void **state) {
+    assert_int_equal(
+            coral_linked_red_black_tree_container_counters_reset(NULL),
+            CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_OBJECT_IS_NULL);
+}
+
+static void check_counters_reset(void **state) {
+    struct coral_linked_red_black_tree_container object;
+    assert_int_equal(coral_linked_red_black_tree_container_init(
+            &object, compare), 0);
+    struct coral_linked_red_black_tree_container_entry *entry;
+    assert_int_equal(coral_linked_red_black_tree_container_alloc(
+            sizeof(uintmax_t), &entry), 0);
+    *(uintmax_t *) entry = 0;
+    assert_int_equal(coral_linked_red_black_tree_container_add(&object, entry), 0);
+    assert_int_equal(coral_linked_red_black_tree_container_counters_reset(&object), 0);
+    struct coral_counters counters;
+    assert_int_equal(coral_linked_red_black_tree_container_counters(
+            &object, &counters), 0);
+    assert_int_equal(counters.compare, 0);
+    assert_int_equal(counters.visit, 0);
+    assert_int_equal(counters.insert, 0);
+    assert_int_equal(counters.remove, 0);
+    assert_int_equal(counters.rotate, 0);
+    assert_int_equal(coral_linked_red_black_tree_container_invalidate(
+            &object, NULL), 0);
+}
+
+struct thing {
+    uintmax_t value;
+    struct coral_linked_red_black_tree_container_node node;
+};
+
+static int compare_thing(
+        const struct coral_linked_red_black_tree_container_node *first,
+        const struct coral_linked_red_black_tree_container_node *second) {
+    const struct thing *const a = rock_container_of(first, struct thing, node);
+    const struct thing *const b = rock_container_of(second, struct thing, node);
+    return seagrass_uintmax_t_ptr_compare(&a->value, &b->value);
+}
+
+static void check_node_init_error_on_node_is_null(void **state) {
+    assert_int_equal(
+            coral_linked_red_black_tree_container_node_init(NULL),
+            CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_NODE_IS_NULL);
+}
+
+static void check_init_intrusive_error_on_object_is_null(void **state) {
+    assert_int_equal(
+            coral_linked_red_black_tree_container_init_intrusive(
+                    NULL, compare_thing),
+            CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_OBJECT_IS_NULL);
+}
+
+static void check_init_intrusive_error_on_compare_is_null(void **state) {
+    assert_int_equal(
+            coral_linked_red_black_tree_container_init_intrusive(
+                    (void *) 1, NULL),
+            CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_COMPARE_IS_NULL);
+}
+
+static void check_intrusive_error_on_compare_is_null(void **state) {
+    struct coral_linked_red_black_tree_container object;
+    assert_int_equal(coral_linked_red_black_tree_container_init_intrusive(
+            &object, compare_thing), 0);
+    const uintmax_t key = 1;
+    struct coral_linked_red_black_tree_container_entry *entry;
+    uintmax_t count;
+    assert_int_equal(
+            coral_linked_red_black_tree_container_add(
+                    &object, (void *) 1),
+            CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_COMPARE_IS_NULL);
+    assert_int_equal(
+            coral_linked_red_black_tree_container_insert(
+                    &object, (void *) 1, (void *) 1),
+            CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_COMPARE_IS_NULL);
+    assert_int_equal(
+            coral_linked_red_black_tree_container_get(
+                    &object, &key, &entry),
+            CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_COMPARE_IS_NULL);
+    assert_int_equal(
+            coral_linked_red_black_tree_container_ceiling(
+                    &object, &key, &entry),
+            CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_COMPARE_IS_NULL);
+    assert_int_equal(
+            coral_linked_red_black_tree_container_floor(
+                    &object, &key, &entry),
+            CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_COMPARE_IS_NULL);
+    assert_int_equal(
+            coral_linked_red_black_tree_container_higher(
+                    &object, &key, &entry),
+            CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_COMPARE_IS_NULL);
+    assert_int_equal(
+            coral_linked_red_black_tree_container_lower(
+                    &object, &key, &entry),
+            CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_COMPARE_IS_NULL);
+    assert_int_equal(
+            coral_linked_red_black_tree_container_rank(
+                    &object, &key, &count),
+            CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_COMPARE_IS_NULL);
+    assert_int_equal(
+            coral_linked_red_black_tree_container_count_range(
+                    &object, &key, &key, &count),
+            CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_COMPARE_IS_NULL);
+    assert_int_equal(
+            coral_linked_red_black_tree_container_aggregate(
+                    &object, &key, &key, &count),
+            CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_COMPARE_IS_NULL);
+    assert_int_equal(coral_linked_red_black_tree_container_invalidate(
+            &object, NULL), 0);
+}
+
+static void check_add_node_error_on_object_is_null(void **state) {
+    assert_int_equal(
+            coral_linked_red_black_tree_container_add_node(NULL, (void *) 1),
+            CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_OBJECT_IS_NULL);
+}
+
+static void check_add_node_error_on_node_is_null(void **state) {
+    assert_int_equal(
+            coral_linked_red_black_tree_container_add_node((void *) 1, NULL),
+            CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_NODE_IS_NULL);
+}
+
+static void check_add_node(void **state) {
+    struct coral_linked_red_black_tree_container object;
+    assert_int_equal(coral_linked_red_black_tree_container_init_intrusive(
+            &object, compare_thing), 0);
+    struct thing things[3];
+    for (uintmax_t i = 0; i < 3; i++) {
+        things[i].value = 2 - i;
+        assert_int_equal(coral_linked_red_black_tree_container_node_init(
+                &things[i].node), 0);
+        assert_int_equal(coral_linked_red_black_tree_container_add_node(
+                &object, &things[i].node), 0);
+    }
+    uintmax_t count;
+    assert_int_equal(coral_linked_red_black_tree_container_count(
+            &object, &count), 0);
+    assert_int_equal(3, count);
+    assert_int_equal(coral_linked_red_black_tree_container_invalidate(
+            &object, NULL), 0);
+}
+
+static void check_add_node_error_on_entry_already_exits(void **state) {
+    struct coral_linked_red_black_tree_container object;
+    assert_int_equal(coral_linked_red_black_tree_container_init_intrusive(
+            &object, compare_thing), 0);
+    struct thing a = {.value = 1};
+    struct thing b = {.value = 1};
+    assert_int_equal(coral_linked_red_black_tree_container_node_init(
+            &a.node), 0);
+    assert_int_equal(coral_linked_red_black_tree_container_node_init(
+            &b.node), 0);
+    assert_int_equal(coral_linked_red_black_tree_container_add_node(
+            &object, &a.node), 0);
+    assert_int_equal(
+            coral_linked_red_black_tree_container_add_node(&object, &b.node),
+            CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_ENTRY_ALREADY_EXISTS);
+    assert_int_equal(coral_linked_red_black_tree_container_invalidate(
+            &object, NULL), 0);
+}
+
+static void check_remove_node_error_on_object_is_null(void **state) {
+    assert_int_equal(
+            coral_linked_red_black_tree_container_remove_node(NULL, (void *) 1),
+            CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_OBJECT_IS_NULL);
+}
+
+static void check_remove_node_error_on_node_is_null(void **state) {
+    assert_int_equal(
+            coral_linked_red_black_tree_container_remove_node((void *) 1, NULL),
+            CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_NODE_IS_NULL);
+}
+
+static void check_remove_node(void **state) {
+    struct coral_linked_red_black_tree_container object;
+    assert_int_equal(coral_linked_red_black_tree_container_init_intrusive(
+            &object, compare_thing), 0);
+    struct thing a = {.value = 1};
+    assert_int_equal(coral_linked_red_black_tree_container_node_init(
+            &a.node), 0);
+    assert_int_equal(coral_linked_red_black_tree_container_add_node(
+            &object, &a.node), 0);
+    assert_int_equal(coral_linked_red_black_tree_container_remove_node(
+            &object, &a.node), 0);
+    uintmax_t count;
+    assert_int_equal(coral_linked_red_black_tree_container_count(
+            &object, &count), 0);
+    assert_int_equal(0, count);
+    assert_int_equal(coral_linked_red_black_tree_container_invalidate(
+            &object, NULL), 0);
+}
+
+static void check_get_node_error_on_object_is_null(void **state) {
+    assert_int_equal(
+            coral_linked_red_black_tree_container_get_node(
+                    NULL, (void *) 1, (void *) 1),
+            CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_OBJECT_IS_NULL);
+}
+
+static void check_get_node_error_on_key_is_null(void **state) {
+    assert_int_equal(
+            coral_linked_red_black_tree_container_get_node(
+                    (void *) 1, NULL, (void *) 1),
+            CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_KEY_IS_NULL);
+}
+
+static void check_get_node_error_on_out_is_null(void **state) {
+    assert_int_equal(
+            coral_linked_red_black_tree_container_get_node(
+                    (void *) 1, (void *) 1, NULL),
+            CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_OUT_IS_NULL);
+}
+
+static void check_get_node(void **state) {
+    struct coral_linked_red_black_tree_container object;
+    assert_int_equal(coral_linked_red_black_tree_container_init_intrusive(
+            &object, compare_thing), 0);
+    struct thing a = {.value = 7};
+    assert_int_equal(coral_linked_red_black_tree_container_node_init(
+            &a.node), 0);
+    assert_int_equal(coral_linked_red_black_tree_container_add_node(
+            &object, &a.node), 0);
+    const struct thing key = {.value = 7};
+    struct coral_linked_red_black_tree_container_node *out;
+    assert_int_equal(coral_linked_red_black_tree_container_get_node(
+            &object, &key.node, &out), 0);
+    assert_ptr_equal(out, &a.node);
+    assert_ptr_equal(rock_container_of(out, struct thing, node), &a);
+    assert_int_equal(coral_linked_red_black_tree_container_invalidate(
+            &object, NULL), 0);
+}
+
+static void check_get_node_error_on_entry_not_found(void **state) {
+    struct coral_linked_red_black_tree_container object;
+    assert_int_equal(coral_linked_red_black_tree_container_init_intrusive(
+            &object, compare_thing), 0);
+    const struct thing key = {.value = 7};
+    struct coral_linked_red_black_tree_container_node *out;
+    assert_int_equal(
+            coral_linked_red_black_tree_container_get_node(
+                    &object, &key.node, &out),
+            CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_ENTRY_NOT_FOUND);
+    assert_int_equal(coral_linked_red_black_tree_container_invalidate(
+            &object, NULL), 0);
+}
+
+static void check_first_node_error_on_container_is_empty(void **state) {
+    struct coral_linked_red_black_tree_container object;
+    assert_int_equal(coral_linked_red_black_tree_container_init_intrusive(
+            &object, compare_thing), 0);
+    struct coral_linked_red_black_tree_container_node *out;
+    assert_int_equal(
+            coral_linked_red_black_tree_container_first_node(&object, &out),
+            CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_CONTAINER_IS_EMPTY);
+    assert_int_equal(
+            coral_linked_red_black_tree_container_last_node(&object, &out),
+            CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_CONTAINER_IS_EMPTY);
+    assert_int_equal(coral_linked_red_black_tree_container_invalidate(
+            &object, NULL), 0);
+}
+
+static void check_next_node_and_prev_node(void **state) {
+    struct coral_linked_red_black_tree_container object;
+    assert_int_equal(coral_linked_red_black_tree_container_init_intrusive(
+            &object, compare_thing), 0);
+    struct thing things[3];
+    for (uintmax_t i = 0; i < 3; i++) {
+        things[i].value = 2 - i;
+        assert_int_equal(coral_linked_red_black_tree_container_node_init(
+                &things[i].node), 0);
+        assert_int_equal(coral_linked_red_black_tree_container_add_node(
+                &object, &things[i].node), 0);
+    }
+    /* iteration follows insertion order */
+    struct coral_linked_red_black_tree_container_node *node;
+    assert_int_equal(coral_linked_red_black_tree_container_first_node(
+            &object, &node), 0);
+    for (uintmax_t i = 0; i < 2; i++) {
+        assert_ptr_equal(node, &things[i].node);
+        assert_int_equal(coral_linked_red_black_tree_container_next_node(
+                &object, node, &node), 0);
+    }
+    assert_ptr_equal(node, &things[2].node);
+    assert_int_equal(
+            coral_linked_red_black_tree_container_next_node(
+                    &object, node, &node),
+            CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_END_OF_SEQUENCE);
+    assert_int_equal(coral_linked_red_black_tree_container_last_node(
+            &object, &node), 0);
+    for (uintmax_t i = 2; i; i--) {
+        assert_ptr_equal(node, &things[i].node);
+        assert_int_equal(coral_linked_red_black_tree_container_prev_node(
+                &object, node, &node), 0);
+    }
+    assert_ptr_equal(node, &things[0].node);
+    assert_int_equal(
+            coral_linked_red_black_tree_container_prev_node(
+                    &object, node, &node),
+            CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_END_OF_SEQUENCE);
+    assert_int_equal(coral_linked_red_black_tree_container_invalidate(
+            &object, NULL), 0);
+}
+
+struct record {
+    uintmax_t id;
+    char name[16];
+};
+
+static int compare_record(const void *a, const void *b) {
+    const struct record *const A = a;
+    const struct record *const B = b;
+    return seagrass_uintmax_t_ptr_compare(&A->id, &B->id);
+}
+
+static int compare_record_key(const void *key, const void *entry) {
+    const struct record *const B = entry;
+    return seagrass_uintmax_t_ptr_compare(key, &B->id);
+}
+
+static void check_init_with_key_error_on_object_is_null(void **state) {
+    assert_int_equal(
+            coral_linked_red_black_tree_container_init_with_key(
+                    NULL, compare_record, compare_record_key),
+            CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_OBJECT_IS_NULL);
+}
+
+static void check_init_with_key_error_on_compare_is_null(void **state) {
+    assert_int_equal(
+            coral_linked_red_black_tree_container_init_with_key(
+                    (void *) 1, NULL, compare_record_key),
+            CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_COMPARE_IS_NULL);
+    assert_int_equal(
+            coral_linked_red_black_tree_container_init_with_key(
+                    (void *) 1, compare_record, NULL),
+            CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_COMPARE_IS_NULL);
+}
+
+static void add_records(
+        struct coral_linked_red_black_tree_container *const object) {
+    assert_int_equal(coral_linked_red_black_tree_container_init_with_key(
+            object, compare_record, compare_record_key), 0);
+    for (uintmax_t i = 1; i <= 5; i += 2) {
+        union {
+            struct coral_linked_red_black_tree_container_entry *entry;
+            struct record *record;
+        } ptr;
+        assert_int_equal(coral_linked_red_black_tree_container_alloc(
+                sizeof(*ptr.record), &ptr.entry), 0);
+        ptr.record->id = i;
+        assert_int_equal(coral_linked_red_black_tree_container_add(
+                object, ptr.entry), 0);
+    }
+}
+
+static void check_get_key_error_on_object_is_null(void **state) {
+    assert_int_equal(
+            coral_linked_red_black_tree_container_get_key(
+                    NULL, (void *) 1, (void *) 1),
+            CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_OBJECT_IS_NULL);
+}
+
+static void check_get_key_error_on_key_is_null(void **state) {
+    assert_int_equal(
+            coral_linked_red_black_tree_container_get_key(
+                    (void *) 1, NULL, (void *) 1),
+            CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_KEY_IS_NULL);
+}
+
+static void check_get_key_error_on_out_is_null(void **state) {
+    assert_int_equal(
+            coral_linked_red_black_tree_container_get_key(
+                    (void *) 1, (void *) 1, NULL),
+            CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_OUT_IS_NULL);
+}
+
+static void check_get_key_error_on_compare_is_null(void **state) {
+    struct coral_linked_red_black_tree_container object;
+    assert_int_equal(coral_linked_red_black_tree_container_init(
+            &object, compare), 0);
+    const uintmax_t key = 1;
+    struct coral_linked_red_black_tree_container_entry *out;
+    assert_int_equal(
+            coral_linked_red_black_tree_container_get_key(
+                    &object, &key, &out),
+            CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_COMPARE_IS_NULL);
+    assert_int_equal(coral_linked_red_black_tree_container_invalidate(
+            &object, NULL), 0);
+}
+
+static void check_get_key(void **state) {
+    struct coral_linked_red_black_tree_container object;
+    add_records(&object);
+    const uintmax_t key = 3;
+    union {
+        struct coral_linked_red_black_tree_container_entry *entry;
+        const struct record *record;
+    } out;
+    assert_int_equal(coral_linked_red_black_tree_container_get_key(
+            &object, &key, &out.entry), 0);
+    assert_int_equal(out.record->id, 3);
+    const uintmax_t missing = 2;
+    assert_int_equal(
+            coral_linked_red_black_tree_container_get_key(
+                    &object, &missing, &out.entry),
+            CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_ENTRY_NOT_FOUND);
+    assert_int_equal(coral_linked_red_black_tree_container_invalidate(
+            &object, NULL), 0);
+}
+
+static void check_ceiling_key(void **state) {
+    struct coral_linked_red_black_tree_container object;
+    add_records(&object);
+    const uintmax_t keys[] = {0, 2, 3};
+    const uintmax_t ids[] = {1, 3, 3};
+    union {
+        struct coral_linked_red_black_tree_container_entry *entry;
+        const struct record *record;
+    } out;
+    for (uintmax_t i = 0; i < 3; i++) {
+        assert_int_equal(coral_linked_red_black_tree_container_ceiling_key(
+                &object, &keys[i], &out.entry), 0);
+        assert_int_equal(out.record->id, ids[i]);
+    }
+    const uintmax_t key = 6;
+    assert_int_equal(
+            coral_linked_red_black_tree_container_ceiling_key(
+                    &object, &key, &out.entry),
+            CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_ENTRY_NOT_FOUND);
+    assert_int_equal(coral_linked_red_black_tree_container_invalidate(
+            &object, NULL), 0);
+}
+
+static void check_floor_key(void **state) {
+    struct coral_linked_red_black_tree_container object;
+    add_records(&object);
+    const uintmax_t keys[] = {6, 4, 3};
+    const uintmax_t ids[] = {5, 3, 3};
+    union {
+        struct coral_linked_red_black_tree_container_entry *entry;
+        const struct record *record;
+    } out;
+    for (uintmax_t i = 0; i < 3; i++) {
+        assert_int_equal(coral_linked_red_black_tree_container_floor_key(
+                &object, &keys[i], &out.entry), 0);
+        assert_int_equal(out.record->id, ids[i]);
+    }
+    const uintmax_t key = 0;
+    assert_int_equal(
+            coral_linked_red_black_tree_container_floor_key(
+                    &object, &key, &out.entry),
+            CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_ENTRY_NOT_FOUND);
+    assert_int_equal(coral_linked_red_black_tree_container_invalidate(
+            &object, NULL), 0);
+}
+
+static void check_higher_key(void **state) {
+    struct coral_linked_red_black_tree_container object;
+    add_records(&object);
+    const uintmax_t keys[] = {0, 2, 3};
+    const uintmax_t ids[] = {1, 3, 5};
+    union {
+        struct coral_linked_red_black_tree_container_entry *entry;
+        const struct record *record;
+    } out;
+    for (uintmax_t i = 0; i < 3; i++) {
+        assert_int_equal(coral_linked_red_black_tree_container_higher_key(
+                &object, &keys[i], &out.entry), 0);
+        assert_int_equal(out.record->id, ids[i]);
+    }
+    const uintmax_t key = 5;
+    assert_int_equal(
+            coral_linked_red_black_tree_container_higher_key(
+                    &object, &key, &out.entry),
+            CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_ENTRY_NOT_FOUND);
+    assert_int_equal(coral_linked_red_black_tree_container_invalidate(
+            &object, NULL), 0);
+}
+
+static void check_lower_key(void **state) {
+    struct coral_linked_red_black_tree_container object;
+    add_records(&object);
+    const uintmax_t keys[] = {6, 4, 3};
+    const uintmax_t ids[] = {5, 3, 1};
+    union {
+        struct coral_linked_red_black_tree_container_entry *entry;
+        const struct record *record;
+    } out;
+    for (uintmax_t i = 0; i < 3; i++) {
+        assert_int_equal(coral_linked_red_black_tree_container_lower_key(
+                &object, &keys[i], &out.entry), 0);
+        assert_int_equal(out.record->id, ids[i]);
+    }
+    const uintmax_t key = 1;
+    assert_int_equal(
+            coral_linked_red_black_tree_container_lower_key(
+                    &object, &key, &out.entry),
+            CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_ENTRY_NOT_FOUND);
+    assert_int_equal(coral_linked_red_black_tree_container_invalidate(
+            &object, NULL), 0);
+}
+
+union value_entry {
+    struct coral_linked_red_black_tree_container_entry *entry;
+    uintmax_t *value;
+};
+
+static void check_build_sorted_error_on_object_is_null(void **state) {
+    assert_int_equal(
+            coral_linked_red_black_tree_container_build_sorted(
+                    NULL, (void *) 1, 1),
+            CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_OBJECT_IS_NULL);
+}
+
+static void check_build_sorted_error_on_entry_is_null(void **state) {
+    struct coral_linked_red_black_tree_container object;
+    assert_int_equal(coral_linked_red_black_tree_container_init(
+            &object, compare), 0);
+    assert_int_equal(
+            coral_linked_red_black_tree_container_build_sorted(
+                    &object, NULL, 1),
+            CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_ENTRY_IS_NULL);
+    struct coral_linked_red_black_tree_container_entry *entries[] = {NULL};
+    assert_int_equal(
+            coral_linked_red_black_tree_container_build_sorted(
+                    &object, entries, 1),
+            CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_ENTRY_IS_NULL);
+    assert_int_equal(coral_linked_red_black_tree_container_invalidate(
+            &object, NULL), 0);
+}
+
+static void alloc_sorted(union value_entry *const items,
+                         const uintmax_t count) {
+    for (uintmax_t i = 0; i < count; i++) {
+        assert_int_equal(coral_linked_red_black_tree_container_alloc(
+                sizeof(*items[i].value), &items[i].entry), 0);
+        *items[i].value = 2 * i;
+    }
+}
+
+static void free_sorted(union value_entry *const items,
+                        const uintmax_t count) {
+    for (uintmax_t i = 0; i < count; i++) {
+        assert_int_equal(coral_linked_red_black_tree_container_free(
+                items[i].entry), 0);
+    }
+}
+
+static void check_build_sorted_error_on_container_is_not_empty(
+        void **state) {
+    struct coral_linked_red_black_tree_container object;
+    assert_int_equal(coral_linked_red_black_tree_container_init(
+            &object, compare), 0);
+    union value_entry items[2];
+    alloc_sorted(items, 2);
+    assert_int_equal(coral_linked_red_black_tree_container_add(
+            &object, items[0].entry), 0);
+    assert_int_equal(
+            coral_linked_red_black_tree_container_build_sorted(
+                    &object, &items[1].entry, 1),
+            CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_CONTAINER_IS_NOT_EMPTY);
+    assert_int_equal(coral_linked_red_black_tree_container_free(
+            items[1].entry), 0);
+    assert_int_equal(coral_linked_red_black_tree_container_invalidate(
+            &object, NULL), 0);
+}
+
+static void check_build_sorted_error_on_entry_already_exists(
+        void **state) {
+    struct coral_linked_red_black_tree_container object;
+    assert_int_equal(coral_linked_red_black_tree_container_init(
+            &object, compare), 0);
+    union value_entry items[3];
+    alloc_sorted(items, 3);
+    *items[2].value = *items[1].value;
+    struct coral_linked_red_black_tree_container_entry *entries[] = {
+            items[0].entry, items[1].entry, items[2].entry
+    };
+    assert_int_equal(
+            coral_linked_red_black_tree_container_build_sorted(
+                    &object, entries, 3),
+            CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_ENTRY_ALREADY_EXISTS);
+    assert_null(object.tree.root);
+    free_sorted(items, 3);
+    assert_int_equal(coral_linked_red_black_tree_container_invalidate(
+            &object, NULL), 0);
+}
+
+static void check_build_sorted_error_on_entries_are_not_sorted(
+        void **state) {
+    struct coral_linked_red_black_tree_container object;
+    assert_int_equal(coral_linked_red_black_tree_container_init(
+            &object, compare), 0);
+    union value_entry items[3];
+    alloc_sorted(items, 3);
+    struct coral_linked_red_black_tree_container_entry *entries[] = {
+            items[0].entry, items[2].entry, items[1].entry
+    };
+    assert_int_equal(
+            coral_linked_red_black_tree_container_build_sorted(
+                    &object, entries, 3),
+            CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_ENTRIES_ARE_NOT_SORTED);
+    assert_null(object.tree.root);
+    free_sorted(items, 3);
+    assert_int_equal(coral_linked_red_black_tree_container_invalidate(
+            &object, NULL), 0);
+}
+
+static void check_build_sorted(void **state) {
+    struct coral_linked_red_black_tree_container object;
+    assert_int_equal(coral_linked_red_black_tree_container_init(
+            &object, compare), 0);
+    assert_int_equal(coral_linked_red_black_tree_container_build_sorted(
+            &object, NULL, 0), 0);
+    union value_entry items[100];
+    alloc_sorted(items, 100);
+    struct coral_linked_red_black_tree_container_entry *entries[100];
+    for (uintmax_t i = 0; i < 100; i++) {
+        entries[i] = items[i].entry;
+    }
+    assert_int_equal(coral_linked_red_black_tree_container_build_sorted(
+            &object, entries, 100), 0);
+    uintmax_t count;
+    assert_int_equal(coral_linked_red_black_tree_container_count(
+            &object, &count), 0);
+    assert_int_equal(count, 100);
+    struct coral_linked_red_black_tree_container_entry *entry;
+    for (uintmax_t i = 0; i < 100; i++) {
+        const uintmax_t key = 2 * i;
+        assert_int_equal(coral_linked_red_black_tree_container_get(
+                &object, &key, &entry), 0);
+        assert_ptr_equal(entry, items[i].entry);
+    }
+    /* insertion order follows the order of the entries */
+    assert_int_equal(coral_linked_red_black_tree_container_first(
+            &object, &entry), 0);
+    for (uintmax_t i = 1; i < 100; i++) {
+        assert_int_equal(coral_linked_red_black_tree_container_next(
+                &object, entry, &entry), 0);
+        assert_ptr_equal(entry, items[i].entry);
+    }
+    /* the tree stays usable once built */
+    union value_entry item;
+    assert_int_equal(coral_linked_red_black_tree_container_alloc(
+            sizeof(*item.value), &item.entry), 0);
+    *item.value = 51;
+    assert_int_equal(coral_linked_red_black_tree_container_add(
+            &object, item.entry), 0);
+    assert_int_equal(coral_linked_red_black_tree_container_remove(
+            &object, items[50].entry), 0);
+    assert_int_equal(coral_linked_red_black_tree_container_free(
+            items[50].entry), 0);
+    assert_int_equal(coral_linked_red_black_tree_container_count(
+            &object, &count), 0);
+    assert_int_equal(count, 100);
+    assert_int_equal(coral_linked_red_black_tree_container_invalidate(
+            &object, NULL), 0);
+}
+
+static void check_rank_error_on_object_is_null(void **state) {
+    assert_int_equal(
+            coral_linked_red_black_tree_container_rank(
+                    NULL, (void *) 1, (void *) 1),
+            CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_OBJECT_IS_NULL);
+}
+
+static void check_rank_error_on_key_is_null(void **state) {
+    assert_int_equal(
+            coral_linked_red_black_tree_container_rank(
+                    (void *) 1, NULL, (void *) 1),
+            CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_KEY_IS_NULL);
+}
+
+static void check_rank_error_on_out_is_null(void **state) {
+    assert_int_equal(
+            coral_linked_red_black_tree_container_rank(
+                    (void *) 1, (void *) 1, NULL),
+            CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_OUT_IS_NULL);
+}
+
+static void check_rank(void **state) {
+    struct coral_linked_red_black_tree_container object;
+    assert_int_equal(coral_linked_red_black_tree_container_init(
+            &object, compare), 0);
+    union value_entry items[100];
+    alloc_sorted(items, 100);
+    for (uintmax_t i = 0; i < 100; i++) {
+        assert_int_equal(coral_linked_red_black_tree_container_add(
+                &object, items[99 - i].entry), 0);
+    }
+    for (uintmax_t i = 0; i < 100; i++) {
+        uintmax_t rank;
+        uintmax_t key = 2 * i;
+        assert_int_equal(coral_linked_red_black_tree_container_rank(
+                &object, &key, &rank), 0);
+        assert_int_equal(rank, i);
+        key++;
+        assert_int_equal(coral_linked_red_black_tree_container_rank(
+                &object, &key, &rank), 0);
+        assert_int_equal(rank, 1 + i);
+    }
+    assert_int_equal(coral_linked_red_black_tree_container_invalidate(
+            &object, NULL), 0);
+}
+
+static void check_rank_key_error_on_object_is_null(void **state) {
+    assert_int_equal(
+            coral_linked_red_black_tree_container_rank_key(
+                    NULL, (void *) 1, (void *) 1),
+            CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_OBJECT_IS_NULL);
+}
+
+static void check_rank_key_error_on_key_is_null(void **state) {
+    assert_int_equal(
+            coral_linked_red_black_tree_container_rank_key(
+                    (void *) 1, NULL, (void *) 1),
+            CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_KEY_IS_NULL);
+}
+
+static void check_rank_key_error_on_out_is_null(void **state) {
+    assert_int_equal(
+            coral_linked_red_black_tree_container_rank_key(
+                    (void *) 1, (void *) 1, NULL),
+            CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_OUT_IS_NULL);
+}
+
+static void check_rank_key_error_on_compare_is_null(void **state) {
+    struct coral_linked_red_black_tree_container object;
+    assert_int_equal(coral_linked_red_black_tree_container_init(
+            &object, compare), 0);
+    const uintmax_t key = 1;
+    uintmax_t rank;
+    assert_int_equal(
+            coral_linked_red_black_tree_container_rank_key(
+                    &object, &key, &rank),
+            CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_COMPARE_IS_NULL);
+    assert_int_equal(coral_linked_red_black_tree_container_invalidate(
+            &object, NULL), 0);
+}
+
+static void check_rank_key(void **state) {
+    struct coral_linked_red_black_tree_container object;
+    add_records(&object);
+    const uintmax_t keys[] = {0, 1, 3, 4, 6};
+    const uintmax_t ranks[] = {0, 0, 1, 2, 3};
+    for (uintmax_t i = 0; i < 5; i++) {
+        uintmax_t rank;
+        assert_int_equal(coral_linked_red_black_tree_container_rank_key(
+                &object, &keys[i], &rank), 0);
+        assert_int_equal(rank, ranks[i]);
+    }
+    assert_int_equal(coral_linked_red_black_tree_container_invalidate(
+            &object, NULL), 0);
+}
+
+static void check_count_range_error_on_object_is_null(void **state) {
+    assert_int_equal(
+            coral_linked_red_black_tree_container_count_range(
+                    NULL, (void *) 1, (void *) 1, (void *) 1),
+            CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_OBJECT_IS_NULL);
+}
+
+static void check_count_range_error_on_key_is_null(void **state) {
+    assert_int_equal(
+            coral_linked_red_black_tree_container_count_range(
+                    (void *) 1, NULL, (void *) 1, (void *) 1),
+            CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_KEY_IS_NULL);
+    assert_int_equal(
+            coral_linked_red_black_tree_container_count_range(
+                    (void *) 1, (void *) 1, NULL, (void *) 1),
+            CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_KEY_IS_NULL);
+}
+
+static void check_count_range_error_on_out_is_null(void **state) {
+    assert_int_equal(
+            coral_linked_red_black_tree_container_count_range(
+                    (void *) 1, (void *) 1, (void *) 1, NULL),
+            CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_OUT_IS_NULL);
+}
+
+static void check_count_range(void **state) {
+    struct coral_linked_red_black_tree_container object;
+    assert_int_equal(coral_linked_red_black_tree_container_init(
+            &object, compare), 0);
+    union value_entry items[100];
+    alloc_sorted(items, 100);
+    for (uintmax_t i = 0; i < 100; i++) {
+        assert_int_equal(coral_linked_red_black_tree_container_add(
+                &object, items[i].entry), 0);
+    }
+    const uintmax_t firsts[] = {10, 11, 20, 0, 0, 300};
+    const uintmax_t lasts[] = {20, 19, 10, 198, 500, 400};
+    const uintmax_t counts[] = {6, 4, 0, 100, 100, 0};
+    for (uintmax_t i = 0; i < 6; i++) {
+        uintmax_t count;
+        assert_int_equal(coral_linked_red_black_tree_container_count_range(
+                &object, &firsts[i], &lasts[i], &count), 0);
+        assert_int_equal(count, counts[i]);
+    }
+    assert_int_equal(coral_linked_red_black_tree_container_invalidate(
+            &object, NULL), 0);
+}
+
+static void check_count_range_key_error_on_object_is_null(void **state) {
+    assert_int_equal(
+            coral_linked_red_black_tree_container_count_range_key(
+                    NULL, (void *) 1, (void *) 1, (void *) 1),
+            CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_OBJECT_IS_NULL);
+}
+
+static void check_count_range_key_error_on_key_is_null(void **state) {
+    assert_int_equal(
+            coral_linked_red_black_tree_container_count_range_key(
+                    (void *) 1, NULL, (void *) 1, (void *) 1),
+            CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_KEY_IS_NULL);
+    assert_int_equal(
+            coral_linked_red_black_tree_container_count_range_key(
+                    (void *) 1, (void *) 1, NULL, (void *) 1),
+            CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_KEY_IS_NULL);
+}
+
+static void check_count_range_key_error_on_out_is_null(void **state) {
+    assert_int_equal(
+            coral_linked_red_black_tree_container_count_range_key(
+                    (void *) 1, (void *) 1, (void *) 1, NULL),
+            CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_OUT_IS_NULL);
+}
+
+static void check_count_range_key_error_on_compare_is_null(
+        void **state) {
+    struct coral_linked_red_black_tree_container object;
+    assert_int_equal(coral_linked_red_black_tree_container_init(
+            &object, compare), 0);
+    const uintmax_t key = 1;
+    uintmax_t count;
+    assert_int_equal(
+            coral_linked_red_black_tree_container_count_range_key(
+                    &object, &key, &key, &count),
+            CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_COMPARE_IS_NULL);
+    assert_int_equal(coral_linked_red_black_tree_container_invalidate(
+            &object, NULL), 0);
+}
+
+static void check_count_range_key(void **state) {
+    struct coral_linked_red_black_tree_container object;
+    add_records(&object);
+    const uintmax_t firsts[] = {1, 2, 4, 0};
+    const uintmax_t lasts[] = {5, 4, 2, 1};
+    const uintmax_t counts[] = {3, 1, 0, 1};
+    for (uintmax_t i = 0; i < 4; i++) {
+        uintmax_t count;
+        assert_int_equal(coral_linked_red_black_tree_container_count_range_key(
+                &object, &firsts[i], &lasts[i], &count), 0);
+        assert_int_equal(count, counts[i]);
+    }
+    assert_int_equal(coral_linked_red_black_tree_container_invalidate(
+            &object, NULL), 0);
+}
+
+static void check_sorted_select_error_on_object_is_null(void **state) {
+    assert_int_equal(
+            coral_linked_red_black_tree_container_sorted_select(
+                    NULL, 0, (void *) 1),
+            CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_OBJECT_IS_NULL);
+}
+
+static void check_sorted_select_error_on_out_is_null(void **state) {
+    assert_int_equal(
+            coral_linked_red_black_tree_container_sorted_select(
+                    (void *) 1, 0, NULL),
+            CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_OUT_IS_NULL);
+}
+
+static void check_sorted_select_error_on_index_is_out_of_bounds(void **state) {
+    struct coral_linked_red_black_tree_container object;
+    assert_int_equal(coral_linked_red_black_tree_container_init(
+            &object, compare), 0);
+    struct coral_linked_red_black_tree_container_entry *entry;
+    assert_int_equal(
+            coral_linked_red_black_tree_container_sorted_select(
+                    &object, 0, &entry),
+            CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_INDEX_IS_OUT_OF_BOUNDS);
+    assert_int_equal(coral_linked_red_black_tree_container_invalidate(
+            &object, NULL), 0);
+}
+
+static void check_sorted_select(void **state) {
+    struct coral_linked_red_black_tree_container object;
+    assert_int_equal(coral_linked_red_black_tree_container_init(
+            &object, compare), 0);
+    union value_entry items[100];
+    alloc_sorted(items, 100);
+    for (uintmax_t i = 0; i < 100; i++) {
+        assert_int_equal(coral_linked_red_black_tree_container_add(
+                &object, items[(i * 7) % 100].entry), 0);
+    }
+    for (uintmax_t i = 0; i < 100; i += 2) {
+        assert_int_equal(coral_linked_red_black_tree_container_remove(
+                &object, items[i].entry), 0);
+        assert_int_equal(coral_linked_red_black_tree_container_free(
+                items[i].entry), 0);
+    }
+    struct coral_linked_red_black_tree_container_entry *entry;
+    for (uintmax_t i = 0; i < 50; i++) {
+        assert_int_equal(coral_linked_red_black_tree_container_sorted_select(
+                &object, i, &entry), 0);
+        assert_ptr_equal(entry, items[1 + 2 * i].entry);
+    }
+    assert_int_equal(
+            coral_linked_red_black_tree_container_sorted_select(
+                    &object, 50, &entry),
+            CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_INDEX_IS_OUT_OF_BOUNDS);
+    assert_int_equal(coral_linked_red_black_tree_container_invalidate(
+            &object, NULL), 0);
+}
+
+struct sample {
+    uintmax_t time;
+    uintmax_t value;
+    struct window {
+        uintmax_t first;
+        uintmax_t last;
+        uintmax_t sum;
+    } window;
+};
+
+union sample_entry {
+    struct coral_linked_red_black_tree_container_entry *entry;
+    struct sample *sample;
+};
+
+static int compare_sample(const void *a, const void *b) {
+    const struct sample *const A = a;
+    const struct sample *const B = b;
+    return seagrass_uintmax_t_ptr_compare(&A->time, &B->time);
+}
+
+static int compare_sample_key(const void *key, const void *entry) {
+    const struct sample *const B = entry;
+    return seagrass_uintmax_t_ptr_compare(key, &B->time);
+}
+
+static void lift_window(const void *entry, void *out) {
+    const struct sample *const A = entry;
+    struct window *const B = out;
+    B->first = B->last = B->sum = A->value;
+}
+
+static void combine_window(const void *first, const void *second,
+                           void *out) {
+    const struct window *const A = first;
+    const struct window *const B = second;
+    *(struct window *) out = (struct window) {
+            .first = A->first,
+            .last = B->last,
+            .sum = A->sum + B->sum
+    };
+}
+
+static void add_samples(
+        struct coral_linked_red_black_tree_container *const object,
+        union sample_entry *const items,
+        const uintmax_t count) {
+    assert_int_equal(coral_linked_red_black_tree_container_init_with_key(
+            object, compare_sample, compare_sample_key), 0);
+    assert_int_equal(coral_linked_red_black_tree_container_set_aggregate(
+            object, sizeof(struct window),
+            offsetof(struct sample, window), lift_window, combine_window),
+                     0);
+    for (uintmax_t i = 0; i < count; i++) {
+        const uintmax_t at = (i * 7) % count;
+        assert_int_equal(coral_linked_red_black_tree_container_alloc(
+                sizeof(*items[at].sample), &items[at].entry), 0);
+        items[at].sample->time = 2 * at;
+        items[at].sample->value = 1 + at;
+        assert_int_equal(coral_linked_red_black_tree_container_add(
+                object, items[at].entry), 0);
+    }
+}
+
+static void expect_window(
+        const struct coral_linked_red_black_tree_container *const object,
+        const union sample_entry *const items,
+        const uintmax_t count,
+        const uintmax_t first,
+        const uintmax_t last) {
+    struct window expected = {0};
+    bool empty = true;
+    for (uintmax_t i = 0; i < count; i++) {
+        const struct sample *const sample = items[i].sample;
+        if (!sample || sample->time < first || sample->time > last) {
+            continue;
+        }
+        if (empty) {
+            expected.first = sample->value;
+            empty = false;
+        }
+        expected.last = sample->value;
+        expected.sum += sample->value;
+    }
+    struct window window;
+    if (empty) {
+        assert_int_equal(
+                coral_linked_red_black_tree_container_aggregate_key(
+                        object, &first, &last, &window),
+                CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_ENTRY_NOT_FOUND);
+        return;
+    }
+    assert_int_equal(coral_linked_red_black_tree_container_aggregate_key(
+            object, &first, &last, &window), 0);
+    assert_int_equal(window.first, expected.first);
+    assert_int_equal(window.last, expected.last);
+    assert_int_equal(window.sum, expected.sum);
+}
+
+static void check_set_aggregate_error_on_object_is_null(void **state) {
+    assert_int_equal(
+            coral_linked_red_black_tree_container_set_aggregate(
+                    NULL, 1, 0, lift_window, combine_window),
+            CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_OBJECT_IS_NULL);
+}
+
+static void check_set_aggregate_error_on_size_is_zero(void **state) {
+    assert_int_equal(
+            coral_linked_red_black_tree_container_set_aggregate(
+                    (void *) 1, 0, 0, lift_window, combine_window),
+            CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_SIZE_IS_ZERO);
+}
+
+static void check_set_aggregate_error_on_aggregate_is_null(void **state) {
+    assert_int_equal(
+            coral_linked_red_black_tree_container_set_aggregate(
+                    (void *) 1, 1, 0, NULL, combine_window),
+            CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_AGGREGATE_IS_NULL);
+    assert_int_equal(
+            coral_linked_red_black_tree_container_set_aggregate(
+                    (void *) 1, 1, 0, lift_window, NULL),
+            CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_AGGREGATE_IS_NULL);
+}
+
+static void check_set_aggregate_error_on_container_is_not_empty(
+        void **state) {
+    struct coral_linked_red_black_tree_container object;
+    union sample_entry items[1];
+    add_samples(&object, items, 1);
+    assert_int_equal(
+            coral_linked_red_black_tree_container_set_aggregate(
+                    &object, sizeof(struct window),
+                    offsetof(struct sample, window), lift_window,
+                    combine_window),
+            CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_CONTAINER_IS_NOT_EMPTY);
+    assert_int_equal(coral_linked_red_black_tree_container_invalidate(
+            &object, NULL), 0);
+}
+
+static void check_set_aggregate_error_on_container_is_intrusive(
+        void **state) {
+    struct coral_linked_red_black_tree_container object;
+    assert_int_equal(coral_linked_red_black_tree_container_init_intrusive(
+            &object, compare_thing), 0);
+    assert_int_equal(
+            coral_linked_red_black_tree_container_set_aggregate(
+                    &object, sizeof(struct window),
+                    offsetof(struct sample, window), lift_window,
+                    combine_window),
+            CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_CONTAINER_IS_INTRUSIVE);
+    assert_int_equal(coral_linked_red_black_tree_container_invalidate(
+            &object, NULL), 0);
+}
+
+static void check_set_aggregate(void **state) {
+    struct coral_linked_red_black_tree_container object;
+    union sample_entry items[100];
+    add_samples(&object, items, 100);
+    for (uintmax_t first = 0; first < 210; first += 7) {
+        for (uintmax_t last = 0; last < 210; last += 11) {
+            expect_window(&object, items, 100, first, last);
+        }
+    }
+    /* summaries follow the entries through removal and rebalancing */
+    for (uintmax_t i = 0; i < 100; i += 3) {
+        assert_int_equal(coral_linked_red_black_tree_container_remove(
+                &object, items[i].entry), 0);
+        assert_int_equal(coral_linked_red_black_tree_container_free(
+                items[i].entry), 0);
+        items[i].sample = NULL;
+    }
+    for (uintmax_t first = 0; first < 210; first += 7) {
+        for (uintmax_t last = 0; last < 210; last += 11) {
+            expect_window(&object, items, 100, first, last);
+        }
+    }
+    assert_int_equal(coral_linked_red_black_tree_container_invalidate(
+            &object, NULL), 0);
+}
+
+static void check_set_aggregate_case_build_sorted(void **state) {
+    struct coral_linked_red_black_tree_container object;
+    assert_int_equal(coral_linked_red_black_tree_container_init(
+            &object, compare_sample), 0);
+    assert_int_equal(coral_linked_red_black_tree_container_set_aggregate(
+            &object, sizeof(struct window),
+            offsetof(struct sample, window), lift_window, combine_window),
+                     0);
+    union sample_entry items[50];
+    struct coral_linked_red_black_tree_container_entry *entries[50];
+    for (uintmax_t i = 0; i < 50; i++) {
+        assert_int_equal(coral_linked_red_black_tree_container_alloc(
+                sizeof(*items[i].sample), &items[i].entry), 0);
+        items[i].sample->time = i;
+        items[i].sample->value = 1 + i;
+        entries[i] = items[i].entry;
+    }
+    assert_int_equal(coral_linked_red_black_tree_container_build_sorted(
+            &object, entries, 50), 0);
+    const struct sample first = {.time = 10};
+    const struct sample last = {.time = 19};
+    struct window window;
+    assert_int_equal(coral_linked_red_black_tree_container_aggregate(
+            &object, &first, &last, &window), 0);
+    assert_int_equal(window.first, 11);
+    assert_int_equal(window.last, 20);
+    assert_int_equal(window.sum, 155);
+    assert_int_equal(coral_linked_red_black_tree_container_invalidate(
+            &object, NULL), 0);
+}
+
+static void check_aggregate_error_on_object_is_null(void **state) {
+    assert_int_equal(
+            coral_linked_red_black_tree_container_aggregate(
+                    NULL, (void *) 1, (void *) 1, (void *) 1),
+            CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_OBJECT_IS_NULL);
+}
+
+static void check_aggregate_error_on_key_is_null(void **state) {
+    assert_int_equal(
+            coral_linked_red_black_tree_container_aggregate(
+                    (void *) 1, NULL, (void *) 1, (void *) 1),
+            CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_KEY_IS_NULL);
+    assert_int_equal(
+            coral_linked_red_black_tree_container_aggregate(
+                    (void *) 1, (void *) 1, NULL, (void *) 1),
+            CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_KEY_IS_NULL);
+}
+
+static void check_aggregate_error_on_out_is_null(void **state) {
+    assert_int_equal(
+            coral_linked_red_black_tree_container_aggregate(
+                    (void *) 1, (void *) 1, (void *) 1, NULL),
+            CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_OUT_IS_NULL);
+}
+
+static void check_aggregate_error_on_aggregate_is_null(void **state) {
+    struct coral_linked_red_black_tree_container object;
+    assert_int_equal(coral_linked_red_black_tree_container_init(
+            &object, compare_sample), 0);
+    const struct sample key = {0};
+    struct window window;
+    assert_int_equal(
+            coral_linked_red_black_tree_container_aggregate(
+                    &object, &key, &key, &window),
+            CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_AGGREGATE_IS_NULL);
+    assert_int_equal(coral_linked_red_black_tree_container_invalidate(
+            &object, NULL), 0);
+}
+
+static void check_aggregate_error_on_entry_not_found(void **state) {
+    struct coral_linked_red_black_tree_container object;
+    union sample_entry items[4];
+    add_samples(&object, items, 4);
+    const struct sample first = {.time = 3};
+    const struct sample last = {.time = 3};
+    struct window window;
+    assert_int_equal(
+            coral_linked_red_black_tree_container_aggregate(
+                    &object, &first, &last, &window),
+            CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_ENTRY_NOT_FOUND);
+    assert_int_equal(coral_linked_red_black_tree_container_invalidate(
+            &object, NULL), 0);
+}
+
+static void check_aggregate(void **state) {
+    struct coral_linked_red_black_tree_container object;
+    union sample_entry items[16];
+    add_samples(&object, items, 16);
+    const struct sample first = {.time = 3};
+    const struct sample last = {.time = 9};
+    struct window window;
+    assert_int_equal(coral_linked_red_black_tree_container_aggregate(
+            &object, &first, &last, &window), 0);
+    assert_int_equal(window.first, 3);
+    assert_int_equal(window.last, 5);
+    assert_int_equal(window.sum, 12);
+    assert_int_equal(coral_linked_red_black_tree_container_invalidate(
+            &object, NULL), 0);
+}
+
+static void check_aggregate_key_error_on_object_is_null(void **state) {
+    assert_int_equal(
+            coral_linked_red_black_tree_container_aggregate_key(
+                    NULL, (void *) 1, (void *) 1, (void *) 1),
+            CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_OBJECT_IS_NULL);
+}
+
+static void check_aggregate_key_error_on_key_is_null(void **state) {
+    assert_int_equal(
+            coral_linked_red_black_tree_container_aggregate_key(
+                    (void *) 1, NULL, (void *) 1, (void *) 1),
+            CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_KEY_IS_NULL);
+    assert_int_equal(
+            coral_linked_red_black_tree_container_aggregate_key(
+                    (void *) 1, (void *) 1, NULL, (void *) 1),
+            CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_KEY_IS_NULL);
+}
+
+static void check_aggregate_key_error_on_out_is_null(void **state) {
+    assert_int_equal(
+            coral_linked_red_black_tree_container_aggregate_key(
+                    (void *) 1, (void *) 1, (void *) 1, NULL),
+            CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_OUT_IS_NULL);
+}
+
+static void check_aggregate_key_error_on_compare_is_null(void **state) {
+    struct coral_linked_red_black_tree_container object;
+    assert_int_equal(coral_linked_red_black_tree_container_init(
+            &object, compare_sample), 0);
+    const uintmax_t key = 0;
+    struct window window;
+    assert_int_equal(
+            coral_linked_red_black_tree_container_aggregate_key(
+                    &object, &key, &key, &window),
+            CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_COMPARE_IS_NULL);
+    assert_int_equal(coral_linked_red_black_tree_container_invalidate(
+            &object, NULL), 0);
+}
+
+static void check_aggregate_key(void **state) {
+    struct coral_linked_red_black_tree_container object;
+    union sample_entry items[16];
+    add_samples(&object, items, 16);
+    for (uintmax_t first = 0; first < 34; first++) {
+        for (uintmax_t last = first; last < 34; last++) {
+            expect_window(&object, items, 16, first, last);
+        }
+    }
+    assert_int_equal(coral_linked_red_black_tree_container_invalidate(
+            &object, NULL), 0);
+}
+
+struct histogram {
+    uintmax_t time;
+    uintmax_t buckets[16];
+};
+
+static int compare_histogram(const void *a, const void *b) {
+    const struct histogram *const A = a;
+    const struct histogram *const B = b;
+    return seagrass_uintmax_t_ptr_compare(&A->time, &B->time);
+}
+
+static void lift_histogram(const void *entry, void *out) {
+    const struct histogram *const A = entry;
+    uintmax_t *const buckets = out;
+    for (uintmax_t i = 0; i < 16; i++) {
+        buckets[i] = i == A->time % 16;
+    }
+}
+
+static void combine_histogram(const void *first, const void *second,
+                              void *out) {
+    const uintmax_t *const A = first;
+    const uintmax_t *const B = second;
+    uintmax_t *const C = out;
+    for (uintmax_t i = 0; i < 16; i++) {
+        C[i] = A[i] + B[i];
+    }
+}
+
+static void check_aggregate_case_large_summary(void **state) {
+    struct coral_linked_red_black_tree_container object;
+    assert_int_equal(coral_linked_red_black_tree_container_init(
+            &object, compare_histogram), 0);
+    assert_int_equal(coral_linked_red_black_tree_container_set_aggregate(
+            &object, sizeof(uintmax_t[16]),
+            offsetof(struct histogram, buckets), lift_histogram,
+            combine_histogram), 0);
+    for (uintmax_t i = 0; i < 100; i++) {
+        union {
+            struct coral_linked_red_black_tree_container_entry *entry;
+            struct histogram *histogram;
+        } item;
+        assert_int_equal(coral_linked_red_black_tree_container_alloc(
+                sizeof(*item.histogram), &item.entry), 0);
+        item.histogram->time = (i * 7) % 100;
+        assert_int_equal(coral_linked_red_black_tree_container_add(
+                &object, item.entry), 0);
+    }
+    const struct histogram first = {.time = 10};
+    const struct histogram last = {.time = 41};
+    uintmax_t buckets[16];
+    assert_int_equal(coral_linked_red_black_tree_container_aggregate(
+            &object, &first, &last, buckets), 0);
+    for (uintmax_t i = 0; i < 16; i++) {
+        assert_int_equal(buckets[i], 2);
+    }
+    malloc_is_overridden = true;
+    assert_int_equal(
+            coral_linked_red_black_tree_container_aggregate(
+                    &object, &first, &last, buckets),
+            CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_MEMORY_ALLOCATION_FAILED);
+    malloc_is_overridden = false;
+    assert_int_equal(coral_linked_red_black_tree_container_invalidate(
+            &object, NULL), 0);
+}
+
+static void check_refresh_error_on_object_is_null(void **state) {
+    assert_int_equal(
+            coral_linked_red_black_tree_container_refresh(
+                    NULL, (void *) 1),
+            CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_OBJECT_IS_NULL);
+}
+
+static void check_refresh_error_on_entry_is_null(void **state) {
+    assert_int_equal(
+            coral_linked_red_black_tree_container_refresh(
+                    (void *) 1, NULL),
+            CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_ENTRY_IS_NULL);
+}
+
+static void check_refresh(void **state) {
+    struct coral_linked_red_black_tree_container object;
+    union sample_entry items[32];
+    add_samples(&object, items, 32);
+    for (uintmax_t i = 0; i < 32; i += 5) {
+        items[i].sample->value = 1000 + i;
+        assert_int_equal(coral_linked_red_black_tree_container_refresh(
+                &object, items[i].entry), 0);
+    }
+    expect_window(&object, items, 32, 0, 64);
+    expect_window(&object, items, 32, 9, 41);
+    assert_int_equal(coral_linked_red_black_tree_container_invalidate(
+            &object, NULL), 0);
+}
+
+
+static uintmax_t removed_entries;
+
+static void on_remove(
+        struct coral_linked_red_black_tree_container_entry *const entry) {
+    removed_entries++;
+}
+
+static void check_remove_range_error_on_object_is_null(void **state) {
+    assert_int_equal(
+            coral_linked_red_black_tree_container_remove_range(
+                    NULL, (void *) 1, (void *) 1, NULL),
+            CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_OBJECT_IS_NULL);
+}
+
+static void check_remove_range_error_on_key_is_null(void **state) {
+    assert_int_equal(
+            coral_linked_red_black_tree_container_remove_range(
+                    (void *) 1, NULL, (void *) 1, NULL),
+            CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_KEY_IS_NULL);
+    assert_int_equal(
+            coral_linked_red_black_tree_container_remove_range(
+                    (void *) 1, (void *) 1, NULL, NULL),
+            CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_KEY_IS_NULL);
+}
+
+static void check_remove_range_error_on_compare_is_null(void **state) {
+    struct coral_linked_red_black_tree_container object;
+    assert_int_equal(coral_linked_red_black_tree_container_init_intrusive(
+            &object, compare_thing), 0);
+    const uintmax_t key = 1;
+    assert_int_equal(
+            coral_linked_red_black_tree_container_remove_range(
+                    &object, &key, &key, NULL),
+            CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_COMPARE_IS_NULL);
+    assert_int_equal(coral_linked_red_black_tree_container_invalidate(
+            &object, NULL), 0);
+}
+
+static void check_remove_range(void **state) {
+    struct coral_linked_red_black_tree_container object;
+    assert_int_equal(coral_linked_red_black_tree_container_init(
+            &object, compare), 0);
+    union value_entry items[100];
+    alloc_sorted(items, 100);
+    /* added out of order so that the insertion order differs */
+    for (uintmax_t i = 0; i < 100; i++) {
+        assert_int_equal(coral_linked_red_black_tree_container_add(
+                &object, items[(37 * i) % 100].entry), 0);
+    }
+    bool present[100];
+    for (uintmax_t i = 0; i < 100; i++) {
+        present[i] = true;
+    }
+    const uintmax_t firsts[] = {10, 11, 150, 0, 40, 300, 30};
+    const uintmax_t lasts[] = {20, 19, 500, 0, 41, 400, 29};
+    uintmax_t count = 100;
+    for (uintmax_t i = 0; i < 7; i++) {
+        removed_entries = 0;
+        assert_int_equal(coral_linked_red_black_tree_container_remove_range(
+                &object, &firsts[i], &lasts[i], on_remove), 0);
+        uintmax_t removed = 0;
+        for (uintmax_t j = 0; j < 100; j++) {
+            const uintmax_t value = 2 * j;
+            if (present[j] && value >= firsts[i] && value <= lasts[i]) {
+                present[j] = false;
+                removed++;
+            }
+        }
+        assert_int_equal(removed_entries, removed);
+        count -= removed;
+        uintmax_t out;
+        assert_int_equal(coral_linked_red_black_tree_container_count(
+                &object, &out), 0);
+        assert_int_equal(out, count);
+        for (uintmax_t j = 0; j < 100; j++) {
+            const uintmax_t value = 2 * j;
+            struct coral_linked_red_black_tree_container_entry *entry;
+            assert_int_equal(
+                    coral_linked_red_black_tree_container_get(
+                            &object, &value, &entry),
+                    present[j]
+                    ? 0
+                    : CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_ENTRY_NOT_FOUND);
+        }
+        /* the insertion order is kept for the remaining entries */
+        struct coral_linked_red_black_tree_container_entry *entry = NULL;
+        uintmax_t at = 0;
+        for (uintmax_t j = 0; j < 100; j++) {
+            const uintmax_t k = (37 * j) % 100;
+            if (!present[k]) {
+                continue;
+            }
+            if (at++) {
+                assert_int_equal(coral_linked_red_black_tree_container_next(
+                        &object, entry, &entry), 0);
+            } else {
+                assert_int_equal(coral_linked_red_black_tree_container_first(
+                        &object, &entry), 0);
+            }
+            assert_ptr_equal(entry, items[k].entry);
+        }
+        if (at) {
+            assert_int_equal(
+                    coral_linked_red_black_tree_container_next(
+                            &object, entry, &entry),
+                    CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_END_OF_SEQUENCE);
+        }
+    }
+    assert_int_equal(coral_linked_red_black_tree_container_invalidate(
+            &object, NULL), 0);
+}
+
+static void check_remove_range_key_error_on_object_is_null(void **state) {
+    assert_int_equal(
+            coral_linked_red_black_tree_container_remove_range_key(
+                    NULL, (void *) 1, (void *) 1, NULL),
+            CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_OBJECT_IS_NULL);
+}
+
+static void check_remove_range_key_error_on_key_is_null(void **state) {
+    assert_int_equal(
+            coral_linked_red_black_tree_container_remove_range_key(
+                    (void *) 1, NULL, (void *) 1, NULL),
+            CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_KEY_IS_NULL);
+    assert_int_equal(
+            coral_linked_red_black_tree_container_remove_range_key(
+                    (void *) 1, (void *) 1, NULL, NULL),
+            CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_KEY_IS_NULL);
+}
+
+static void check_remove_range_key_error_on_compare_is_null(
+        void **state) {
+    struct coral_linked_red_black_tree_container object;
+    assert_int_equal(coral_linked_red_black_tree_container_init(
+            &object, compare), 0);
+    const uintmax_t key = 1;
+    assert_int_equal(
+            coral_linked_red_black_tree_container_remove_range_key(
+                    &object, &key, &key, NULL),
+            CORAL_LINKED_RED_BLACK_TREE_CONTAINER_ERROR_COMPARE_IS_NULL);
+    assert_int_equal(coral_linked_red_black_tree_container_invalidate(
+            &object, NULL), 0);
+}
+
+static void check_remove_range_key(void **state) {
+    struct coral_linked_red_black_tree_container object;
+    add_records(&object);
+    const uintmax_t first = 2;
+    const uintmax_t last = 5;
+    removed_entries = 0;
+    assert_int_equal(coral_linked_red_black_tree_container_remove_range_key(
+            &object, &first, &last, on_remove), 0);
+    assert_int_equal(removed_entries, 2);
+    uintmax_t count;
+    assert_int_equal(coral_linked_red_black_tree_container_count(
+                &object, &count), 0);
+    assert_int_equal(count, 1);
+    const uintmax_t key = 1;
+    struct coral_linked_red_black_tree_container_entry *entry;
+    assert_int_equal(coral_linked_red_black_tree_container_get_key(
+            &object, &key, &entry), 0);
+    assert_int_equal(coral_linked_red_black_tree_container_invalidate(
+            &object, NULL), 0);
+}
 int main(int argc, char *argv[]) {
     const struct CMUnitTest tests[] = {
             cmocka_unit_test(check_free_error_on_entry_is_null),
@@ -1242,6 +2876,7 @@ int main(int argc, char *argv[]) {
             cmocka_unit_test(check_alloc),
             cmocka_unit_test(check_alloc_error_on_size_is_too_large),
             cmocka_unit_test(check_alloc_error_on_memory_allocation_failed),
+            cmocka_unit_test(check_alloc_with),
             cmocka_unit_test(check_invalidate_error_on_object_is_null),
             cmocka_unit_test(check_invalidate),
             cmocka_unit_test(check_init_error_on_object_is_null),
@@ -1271,6 +2906,7 @@ int main(int argc, char *argv[]) {
             cmocka_unit_test(check_ceiling_error_on_key_is_null),
             cmocka_unit_test(check_ceiling_error_on_out_is_null),
             cmocka_unit_test(check_ceiling),
+            cmocka_unit_test(check_ceiling_on_ancestor),
             cmocka_unit_test(check_ceiling_error_on_entry_not_found),
             cmocka_unit_test(check_floor_error_on_object_is_null),
             cmocka_unit_test(check_floor_error_on_key_is_null),
@@ -1281,6 +2917,7 @@ int main(int argc, char *argv[]) {
             cmocka_unit_test(check_higher_error_on_key_is_null),
             cmocka_unit_test(check_higher_error_on_out_is_null),
             cmocka_unit_test(check_higher),
+            cmocka_unit_test(check_higher_on_ancestor),
             cmocka_unit_test(check_higher_error_on_entity_not_found),
             cmocka_unit_test(check_lower_error_on_object_is_null),
             cmocka_unit_test(check_lower_error_on_key_is_null),
@@ -1321,6 +2958,103 @@ int main(int argc, char *argv[]) {
             cmocka_unit_test(check_prev_error_on_out_is_null),
             cmocka_unit_test(check_prev),
             cmocka_unit_test(check_prev_error_on_end_of_sequence),
+            cmocka_unit_test(check_counters_error_on_object_is_null),
+            cmocka_unit_test(check_counters_error_on_out_is_null),
+            cmocka_unit_test(check_counters),
+            cmocka_unit_test(check_counters_reset_error_on_object_is_null),
+            cmocka_unit_test(check_counters_reset),
+            cmocka_unit_test(check_node_init_error_on_node_is_null),
+            cmocka_unit_test(check_init_intrusive_error_on_object_is_null),
+            cmocka_unit_test(check_init_intrusive_error_on_compare_is_null),
+            cmocka_unit_test(check_intrusive_error_on_compare_is_null),
+            cmocka_unit_test(check_add_node_error_on_object_is_null),
+            cmocka_unit_test(check_add_node_error_on_node_is_null),
+            cmocka_unit_test(check_add_node),
+            cmocka_unit_test(check_add_node_error_on_entry_already_exits),
+            cmocka_unit_test(check_remove_node_error_on_object_is_null),
+            cmocka_unit_test(check_remove_node_error_on_node_is_null),
+            cmocka_unit_test(check_remove_node),
+            cmocka_unit_test(check_get_node_error_on_object_is_null),
+            cmocka_unit_test(check_get_node_error_on_key_is_null),
+            cmocka_unit_test(check_get_node_error_on_out_is_null),
+            cmocka_unit_test(check_get_node),
+            cmocka_unit_test(check_get_node_error_on_entry_not_found),
+            cmocka_unit_test(check_first_node_error_on_container_is_empty),
+            cmocka_unit_test(check_next_node_and_prev_node),
+            cmocka_unit_test(check_init_with_key_error_on_object_is_null),
+            cmocka_unit_test(check_init_with_key_error_on_compare_is_null),
+            cmocka_unit_test(check_get_key_error_on_object_is_null),
+            cmocka_unit_test(check_get_key_error_on_key_is_null),
+            cmocka_unit_test(check_get_key_error_on_out_is_null),
+            cmocka_unit_test(check_get_key_error_on_compare_is_null),
+            cmocka_unit_test(check_get_key),
+            cmocka_unit_test(check_ceiling_key),
+            cmocka_unit_test(check_floor_key),
+            cmocka_unit_test(check_higher_key),
+            cmocka_unit_test(check_lower_key),
+            cmocka_unit_test(check_build_sorted_error_on_object_is_null),
+            cmocka_unit_test(check_build_sorted_error_on_entry_is_null),
+            cmocka_unit_test(
+                    check_build_sorted_error_on_container_is_not_empty),
+            cmocka_unit_test(check_build_sorted_error_on_entry_already_exists),
+            cmocka_unit_test(
+                    check_build_sorted_error_on_entries_are_not_sorted),
+            cmocka_unit_test(check_build_sorted),
+            cmocka_unit_test(check_rank_error_on_object_is_null),
+            cmocka_unit_test(check_rank_error_on_key_is_null),
+            cmocka_unit_test(check_rank_error_on_out_is_null),
+            cmocka_unit_test(check_rank),
+            cmocka_unit_test(check_rank_key_error_on_object_is_null),
+            cmocka_unit_test(check_rank_key_error_on_key_is_null),
+            cmocka_unit_test(check_rank_key_error_on_out_is_null),
+            cmocka_unit_test(check_rank_key_error_on_compare_is_null),
+            cmocka_unit_test(check_rank_key),
+            cmocka_unit_test(check_count_range_error_on_object_is_null),
+            cmocka_unit_test(check_count_range_error_on_key_is_null),
+            cmocka_unit_test(check_count_range_error_on_out_is_null),
+            cmocka_unit_test(check_count_range),
+            cmocka_unit_test(check_count_range_key_error_on_object_is_null),
+            cmocka_unit_test(check_count_range_key_error_on_key_is_null),
+            cmocka_unit_test(check_count_range_key_error_on_out_is_null),
+            cmocka_unit_test(check_count_range_key_error_on_compare_is_null),
+            cmocka_unit_test(check_count_range_key),
+            cmocka_unit_test(check_sorted_select_error_on_object_is_null),
+            cmocka_unit_test(check_sorted_select_error_on_out_is_null),
+            cmocka_unit_test(
+                    check_sorted_select_error_on_index_is_out_of_bounds),
+            cmocka_unit_test(check_sorted_select),
+            cmocka_unit_test(check_set_aggregate_error_on_object_is_null),
+            cmocka_unit_test(check_set_aggregate_error_on_size_is_zero),
+            cmocka_unit_test(check_set_aggregate_error_on_aggregate_is_null),
+            cmocka_unit_test(
+                    check_set_aggregate_error_on_container_is_not_empty),
+            cmocka_unit_test(
+                    check_set_aggregate_error_on_container_is_intrusive),
+            cmocka_unit_test(check_set_aggregate),
+            cmocka_unit_test(check_set_aggregate_case_build_sorted),
+            cmocka_unit_test(check_aggregate_error_on_object_is_null),
+            cmocka_unit_test(check_aggregate_error_on_key_is_null),
+            cmocka_unit_test(check_aggregate_error_on_out_is_null),
+            cmocka_unit_test(check_aggregate_error_on_aggregate_is_null),
+            cmocka_unit_test(check_aggregate_error_on_entry_not_found),
+            cmocka_unit_test(check_aggregate),
+            cmocka_unit_test(check_aggregate_key_error_on_object_is_null),
+            cmocka_unit_test(check_aggregate_key_error_on_key_is_null),
+            cmocka_unit_test(check_aggregate_key_error_on_out_is_null),
+            cmocka_unit_test(check_aggregate_key_error_on_compare_is_null),
+            cmocka_unit_test(check_aggregate_key),
+            cmocka_unit_test(check_aggregate_case_large_summary),
+            cmocka_unit_test(check_refresh_error_on_object_is_null),
+            cmocka_unit_test(check_refresh_error_on_entry_is_null),
+            cmocka_unit_test(check_refresh),
+            cmocka_unit_test(check_remove_range_error_on_object_is_null),
+            cmocka_unit_test(check_remove_range_error_on_key_is_null),
+            cmocka_unit_test(check_remove_range_error_on_compare_is_null),
+            cmocka_unit_test(check_remove_range),
+            cmocka_unit_test(check_remove_range_key_error_on_object_is_null),
+            cmocka_unit_test(check_remove_range_key_error_on_key_is_null),
+            cmocka_unit_test(check_remove_range_key_error_on_compare_is_null),
+            cmocka_unit_test(check_remove_range_key),
     };
     //cmocka_set_message_output(CM_OUTPUT_XML);
     return cmocka_run_group_tests(tests, NULL, NULL);
@@ -0,0 +1,1074 @@
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <setjmp.h>
+#include <cmocka.h>
+#include <coral.h>
+#include <seagrass.h>
+
+#include <test/cmocka.h>
+
+struct number {
+    struct coral_red_black_tree_node node;
+    uintmax_t value;
+};
+
+static int compare_number(const void *const key,
+                          const struct coral_red_black_tree_node *const node,
+                          void *const context) {
+    const uintmax_t *const a = key;
+    const struct number *const B = rock_container_of(node, struct number,
+                                                     node);
+    if (context) {
+        (*(uintmax_t *) context)++;
+    }
+    return seagrass_uintmax_t_compare(*a, B->value);
+}
+
+static uintmax_t black_height(const struct coral_red_black_tree_node *node) {
+    if (!node) {
+        return 1;
+    }
+    if (node->left) {
+        assert_ptr_equal(node->left->parent, node);
+    }
+    if (node->right) {
+        assert_ptr_equal(node->right->parent, node);
+    }
+    if (node->red) {
+        assert_true(!node->left || !node->left->red);
+        assert_true(!node->right || !node->right->red);
+    }
+    assert_int_equal(node->size,
+                     1 + (node->left ? node->left->size : 0)
+                     + (node->right ? node->right->size : 0));
+    const uintmax_t left = black_height(node->left);
+    assert_int_equal(left, black_height(node->right));
+    return left + !node->red;
+}
+
+static void check_invariants(const struct coral_red_black_tree *const object) {
+    if (object->root) {
+        assert_null(object->root->parent);
+        assert_false(object->root->red);
+    }
+    black_height(object->root);
+}
+
+static void insert_numbers(struct coral_red_black_tree *const object,
+                           struct number *const numbers,
+                           const uintmax_t count) {
+    for (uintmax_t i = 0; i < count; i++) {
+        /* interleave values so that every rotation case is exercised */
+        numbers[i].value = (i * 7) % count;
+        assert_int_equal(coral_red_black_tree_insert(
+                object, &numbers[i].value, &numbers[i].node, compare_number,
+                NULL), 0);
+        check_invariants(object);
+    }
+}
+
+static void check_node_init_error_on_node_is_null(void **state) {
+    assert_int_equal(
+            coral_red_black_tree_node_init(NULL),
+            CORAL_RED_BLACK_TREE_ERROR_NODE_IS_NULL);
+}
+
+static void check_node_init(void **state) {
+    struct coral_red_black_tree_node node;
+    assert_int_equal(coral_red_black_tree_node_init(&node), 0);
+    assert_null(node.parent);
+    assert_null(node.left);
+    assert_null(node.right);
+    assert_int_equal(node.size, 0);
+    assert_false(node.red);
+}
+
+static void check_init_error_on_object_is_null(void **state) {
+    assert_int_equal(
+            coral_red_black_tree_init(NULL),
+            CORAL_RED_BLACK_TREE_ERROR_OBJECT_IS_NULL);
+}
+
+static void check_init(void **state) {
+    struct coral_red_black_tree object;
+    assert_int_equal(coral_red_black_tree_init(&object), 0);
+    assert_int_equal(object.count, 0);
+    assert_null(object.root);
+    assert_null(object.augment);
+    assert_int_equal(coral_red_black_tree_invalidate(&object, NULL, NULL), 0);
+}
+
+static void check_invalidate_error_on_object_is_null(void **state) {
+    assert_int_equal(
+            coral_red_black_tree_invalidate(NULL, NULL, NULL),
+            CORAL_RED_BLACK_TREE_ERROR_OBJECT_IS_NULL);
+}
+
+static void on_destroy(struct coral_red_black_tree_node *const node,
+                       void *const context) {
+    /* children are destroyed before their parent */
+    assert_null(node->left);
+    assert_null(node->right);
+    (*(uintmax_t *) context)++;
+}
+
+static void check_invalidate(void **state) {
+    struct coral_red_black_tree object;
+    assert_int_equal(coral_red_black_tree_init(&object), 0);
+    struct number numbers[8];
+    insert_numbers(&object, numbers, 8);
+    assert_int_equal(coral_red_black_tree_invalidate(&object, NULL, NULL), 0);
+    assert_int_equal(object.count, 0);
+    assert_null(object.root);
+}
+
+static void check_invalidate_case_on_destroy(void **state) {
+    struct coral_red_black_tree object;
+    assert_int_equal(coral_red_black_tree_init(&object), 0);
+    struct number numbers[64];
+    insert_numbers(&object, numbers, 64);
+    uintmax_t destroyed = 0;
+    assert_int_equal(coral_red_black_tree_invalidate(
+            &object, on_destroy, &destroyed), 0);
+    assert_int_equal(destroyed, 64);
+    assert_int_equal(object.count, 0);
+    assert_null(object.root);
+}
+
+static void check_find_error_on_object_is_null(void **state) {
+    assert_int_equal(
+            coral_red_black_tree_find(NULL, (void *) 1, (void *) 1, NULL,
+                                      (void *) 1),
+            CORAL_RED_BLACK_TREE_ERROR_OBJECT_IS_NULL);
+}
+
+static void check_find_error_on_compare_is_null(void **state) {
+    assert_int_equal(
+            coral_red_black_tree_find((void *) 1, (void *) 1, NULL, NULL,
+                                      (void *) 1),
+            CORAL_RED_BLACK_TREE_ERROR_COMPARE_IS_NULL);
+}
+
+static void check_find_error_on_out_is_null(void **state) {
+    assert_int_equal(
+            coral_red_black_tree_find((void *) 1, (void *) 1, (void *) 1,
+                                      NULL, NULL),
+            CORAL_RED_BLACK_TREE_ERROR_OUT_IS_NULL);
+}
+
+static void check_find_error_on_node_not_found(void **state) {
+    struct coral_red_black_tree object;
+    assert_int_equal(coral_red_black_tree_init(&object), 0);
+    struct coral_red_black_tree_node *node = (void *) 1;
+    const uintmax_t key = 4;
+    assert_int_equal(
+            coral_red_black_tree_find(&object, &key, compare_number, NULL,
+                                      &node),
+            CORAL_RED_BLACK_TREE_ERROR_NODE_NOT_FOUND);
+    assert_null(node);
+    struct number numbers[4];
+    insert_numbers(&object, numbers, 4);
+    assert_int_equal(
+            coral_red_black_tree_find(&object, &key, compare_number, NULL,
+                                      &node),
+            CORAL_RED_BLACK_TREE_ERROR_NODE_NOT_FOUND);
+    /* the last node visited is where the key would be inserted */
+    assert_int_equal(rock_container_of(node, struct number, node)->value, 3);
+    assert_int_equal(coral_red_black_tree_invalidate(&object, NULL, NULL), 0);
+}
+
+static void check_find(void **state) {
+    struct coral_red_black_tree object;
+    assert_int_equal(coral_red_black_tree_init(&object), 0);
+    struct number numbers[16];
+    insert_numbers(&object, numbers, 16);
+    uintmax_t compared = 0;
+    for (uintmax_t i = 0; i < 16; i++) {
+        struct coral_red_black_tree_node *node;
+        assert_int_equal(coral_red_black_tree_find(
+                &object, &i, compare_number, &compared, &node), 0);
+        assert_int_equal(
+                rock_container_of(node, struct number, node)->value, i);
+    }
+    /* context is handed through to each comparison */
+    assert_true(compared >= 16);
+    assert_int_equal(coral_red_black_tree_invalidate(&object, NULL, NULL), 0);
+}
+
+static void check_insert_error_on_object_is_null(void **state) {
+    assert_int_equal(
+            coral_red_black_tree_insert(NULL, (void *) 1, (void *) 1,
+                                        (void *) 1, NULL),
+            CORAL_RED_BLACK_TREE_ERROR_OBJECT_IS_NULL);
+}
+
+static void check_insert_error_on_node_is_null(void **state) {
+    assert_int_equal(
+            coral_red_black_tree_insert((void *) 1, (void *) 1, NULL,
+                                        (void *) 1, NULL),
+            CORAL_RED_BLACK_TREE_ERROR_NODE_IS_NULL);
+}
+
+static void check_insert_error_on_compare_is_null(void **state) {
+    assert_int_equal(
+            coral_red_black_tree_insert((void *) 1, (void *) 1, (void *) 1,
+                                        NULL, NULL),
+            CORAL_RED_BLACK_TREE_ERROR_COMPARE_IS_NULL);
+}
+
+static void check_insert_error_on_node_already_exists(void **state) {
+    struct coral_red_black_tree object;
+    assert_int_equal(coral_red_black_tree_init(&object), 0);
+    struct number numbers[4];
+    insert_numbers(&object, numbers, 4);
+    struct number number = {.value = 2};
+    assert_int_equal(
+            coral_red_black_tree_insert(&object, &number.value, &number.node,
+                                        compare_number, NULL),
+            CORAL_RED_BLACK_TREE_ERROR_NODE_ALREADY_EXISTS);
+    assert_int_equal(object.count, 4);
+    assert_int_equal(coral_red_black_tree_invalidate(&object, NULL, NULL), 0);
+}
+
+static void check_insert(void **state) {
+    struct coral_red_black_tree object;
+    assert_int_equal(coral_red_black_tree_init(&object), 0);
+    struct number numbers[128];
+    insert_numbers(&object, numbers, 128);
+    assert_int_equal(object.count, 128);
+    assert_int_equal(coral_red_black_tree_invalidate(&object, NULL, NULL), 0);
+}
+
+static void check_attach_error_on_object_is_null(void **state) {
+    assert_int_equal(
+            coral_red_black_tree_attach(NULL, NULL, (void *) 1, (void *) 1),
+            CORAL_RED_BLACK_TREE_ERROR_OBJECT_IS_NULL);
+}
+
+static void check_attach_error_on_link_is_null(void **state) {
+    assert_int_equal(
+            coral_red_black_tree_attach((void *) 1, NULL, NULL, (void *) 1),
+            CORAL_RED_BLACK_TREE_ERROR_LINK_IS_NULL);
+}
+
+static void check_attach_error_on_node_is_null(void **state) {
+    assert_int_equal(
+            coral_red_black_tree_attach((void *) 1, NULL, (void *) 1, NULL),
+            CORAL_RED_BLACK_TREE_ERROR_NODE_IS_NULL);
+}
+
+static void check_attach(void **state) {
+    struct coral_red_black_tree object;
+    assert_int_equal(coral_red_black_tree_init(&object), 0);
+    struct number numbers[128];
+    for (uintmax_t i = 0; i < 128; i++) {
+        numbers[i].value = (i * 7) % 128;
+        /* descend without a comparison callback */
+        struct coral_red_black_tree_node *parent = NULL;
+        struct coral_red_black_tree_node **link = &object.root;
+        while (*link) {
+            parent = *link;
+            link = numbers[i].value < rock_container_of(
+                    parent, struct number, node)->value
+                   ? &parent->left
+                   : &parent->right;
+        }
+        assert_int_equal(coral_red_black_tree_attach(
+                &object, parent, link, &numbers[i].node), 0);
+        check_invariants(&object);
+    }
+    assert_int_equal(object.count, 128);
+    struct coral_red_black_tree_node *node;
+    assert_int_equal(coral_red_black_tree_first(&object, &node), 0);
+    for (uintmax_t i = 1; i < 128; i++) {
+        assert_int_equal(coral_red_black_tree_next(node, &node), 0);
+        assert_int_equal(
+                rock_container_of(node, struct number, node)->value, i);
+    }
+    assert_int_equal(coral_red_black_tree_invalidate(&object, NULL, NULL), 0);
+}
+
+static struct coral_red_black_tree_node *number_at(const uintmax_t index,
+                                                   void *const context) {
+    struct number *const numbers = context;
+    return &numbers[index].node;
+}
+
+static void check_build_error_on_object_is_null(void **state) {
+    assert_int_equal(
+            coral_red_black_tree_build(NULL, 1, number_at, NULL),
+            CORAL_RED_BLACK_TREE_ERROR_OBJECT_IS_NULL);
+}
+
+static void check_build_error_on_node_at_is_null(void **state) {
+    assert_int_equal(
+            coral_red_black_tree_build((void *) 1, 1, NULL, NULL),
+            CORAL_RED_BLACK_TREE_ERROR_NODE_AT_IS_NULL);
+}
+
+static void check_build_error_on_tree_is_not_empty(void **state) {
+    struct coral_red_black_tree object;
+    assert_int_equal(coral_red_black_tree_init(&object), 0);
+    struct number numbers[4];
+    insert_numbers(&object, numbers, 4);
+    assert_int_equal(
+            coral_red_black_tree_build(&object, 1, number_at, numbers),
+            CORAL_RED_BLACK_TREE_ERROR_TREE_IS_NOT_EMPTY);
+    assert_int_equal(coral_red_black_tree_invalidate(&object, NULL, NULL), 0);
+}
+
+static void check_build(void **state) {
+    struct number numbers[130];
+    for (uintmax_t count = 0; count <= 130; count++) {
+        struct coral_red_black_tree object;
+        assert_int_equal(coral_red_black_tree_init(&object), 0);
+        for (uintmax_t i = 0; i < count; i++) {
+            numbers[i].value = i;
+        }
+        assert_int_equal(coral_red_black_tree_build(
+                &object, count, number_at, numbers), 0);
+        check_invariants(&object);
+        assert_int_equal(object.count, count);
+        struct coral_red_black_tree_node *node;
+        for (uintmax_t i = 0; i < count; i++) {
+            assert_int_equal(coral_red_black_tree_find(
+                    &object, &i, compare_number, NULL, &node), 0);
+            assert_ptr_equal(node, &numbers[i].node);
+        }
+        /* the built tree is balanced well enough to keep on changing */
+        for (uintmax_t i = 0; i < count; i += 2) {
+            assert_int_equal(coral_red_black_tree_remove(
+                    &object, &numbers[i].node), 0);
+            check_invariants(&object);
+        }
+        assert_int_equal(coral_red_black_tree_invalidate(
+                &object, NULL, NULL), 0);
+    }
+}
+
+static void check_remove_error_on_object_is_null(void **state) {
+    assert_int_equal(
+            coral_red_black_tree_remove(NULL, (void *) 1),
+            CORAL_RED_BLACK_TREE_ERROR_OBJECT_IS_NULL);
+}
+
+static void check_remove_error_on_node_is_null(void **state) {
+    assert_int_equal(
+            coral_red_black_tree_remove((void *) 1, NULL),
+            CORAL_RED_BLACK_TREE_ERROR_NODE_IS_NULL);
+}
+
+static void check_remove(void **state) {
+    struct coral_red_black_tree object;
+    assert_int_equal(coral_red_black_tree_init(&object), 0);
+    struct number numbers[128];
+    insert_numbers(&object, numbers, 128);
+    for (uintmax_t i = 0; i < 128; i++) {
+        /* remove in a different order than they were inserted in */
+        struct number *const number = &numbers[(i * 5) % 128];
+        assert_int_equal(coral_red_black_tree_remove(
+                &object, &number->node), 0);
+        check_invariants(&object);
+        struct coral_red_black_tree_node *node;
+        assert_int_equal(
+                coral_red_black_tree_find(&object, &number->value,
+                                          compare_number, NULL, &node),
+                CORAL_RED_BLACK_TREE_ERROR_NODE_NOT_FOUND);
+        assert_int_equal(object.count, 127 - i);
+    }
+    assert_null(object.root);
+    assert_int_equal(coral_red_black_tree_invalidate(&object, NULL, NULL), 0);
+}
+
+static void check_first_error_on_object_is_null(void **state) {
+    assert_int_equal(
+            coral_red_black_tree_first(NULL, (void *) 1),
+            CORAL_RED_BLACK_TREE_ERROR_OBJECT_IS_NULL);
+}
+
+static void check_first_error_on_out_is_null(void **state) {
+    assert_int_equal(
+            coral_red_black_tree_first((void *) 1, NULL),
+            CORAL_RED_BLACK_TREE_ERROR_OUT_IS_NULL);
+}
+
+static void check_first_error_on_tree_is_empty(void **state) {
+    struct coral_red_black_tree object;
+    assert_int_equal(coral_red_black_tree_init(&object), 0);
+    struct coral_red_black_tree_node *node;
+    assert_int_equal(
+            coral_red_black_tree_first(&object, &node),
+            CORAL_RED_BLACK_TREE_ERROR_TREE_IS_EMPTY);
+    assert_int_equal(coral_red_black_tree_invalidate(&object, NULL, NULL), 0);
+}
+
+static void check_first(void **state) {
+    struct coral_red_black_tree object;
+    assert_int_equal(coral_red_black_tree_init(&object), 0);
+    struct number numbers[16];
+    insert_numbers(&object, numbers, 16);
+    struct coral_red_black_tree_node *node;
+    assert_int_equal(coral_red_black_tree_first(&object, &node), 0);
+    assert_int_equal(rock_container_of(node, struct number, node)->value, 0);
+    assert_int_equal(coral_red_black_tree_invalidate(&object, NULL, NULL), 0);
+}
+
+static void check_last_error_on_object_is_null(void **state) {
+    assert_int_equal(
+            coral_red_black_tree_last(NULL, (void *) 1),
+            CORAL_RED_BLACK_TREE_ERROR_OBJECT_IS_NULL);
+}
+
+static void check_last_error_on_out_is_null(void **state) {
+    assert_int_equal(
+            coral_red_black_tree_last((void *) 1, NULL),
+            CORAL_RED_BLACK_TREE_ERROR_OUT_IS_NULL);
+}
+
+static void check_last_error_on_tree_is_empty(void **state) {
+    struct coral_red_black_tree object;
+    assert_int_equal(coral_red_black_tree_init(&object), 0);
+    struct coral_red_black_tree_node *node;
+    assert_int_equal(
+            coral_red_black_tree_last(&object, &node),
+            CORAL_RED_BLACK_TREE_ERROR_TREE_IS_EMPTY);
+    assert_int_equal(coral_red_black_tree_invalidate(&object, NULL, NULL), 0);
+}
+
+static void check_last(void **state) {
+    struct coral_red_black_tree object;
+    assert_int_equal(coral_red_black_tree_init(&object), 0);
+    struct number numbers[16];
+    insert_numbers(&object, numbers, 16);
+    struct coral_red_black_tree_node *node;
+    assert_int_equal(coral_red_black_tree_last(&object, &node), 0);
+    assert_int_equal(rock_container_of(node, struct number, node)->value, 15);
+    assert_int_equal(coral_red_black_tree_invalidate(&object, NULL, NULL), 0);
+}
+
+static void check_next_error_on_node_is_null(void **state) {
+    assert_int_equal(
+            coral_red_black_tree_next(NULL, (void *) 1),
+            CORAL_RED_BLACK_TREE_ERROR_NODE_IS_NULL);
+}
+
+static void check_next_error_on_out_is_null(void **state) {
+    assert_int_equal(
+            coral_red_black_tree_next((void *) 1, NULL),
+            CORAL_RED_BLACK_TREE_ERROR_OUT_IS_NULL);
+}
+
+static void check_next_error_on_end_of_sequence(void **state) {
+    struct coral_red_black_tree object;
+    assert_int_equal(coral_red_black_tree_init(&object), 0);
+    struct number numbers[4];
+    insert_numbers(&object, numbers, 4);
+    struct coral_red_black_tree_node *node;
+    assert_int_equal(coral_red_black_tree_last(&object, &node), 0);
+    assert_int_equal(
+            coral_red_black_tree_next(node, &node),
+            CORAL_RED_BLACK_TREE_ERROR_END_OF_SEQUENCE);
+    assert_int_equal(coral_red_black_tree_invalidate(&object, NULL, NULL), 0);
+}
+
+static void check_next(void **state) {
+    struct coral_red_black_tree object;
+    assert_int_equal(coral_red_black_tree_init(&object), 0);
+    struct number numbers[64];
+    insert_numbers(&object, numbers, 64);
+    struct coral_red_black_tree_node *node;
+    assert_int_equal(coral_red_black_tree_first(&object, &node), 0);
+    for (uintmax_t i = 1; i < 64; i++) {
+        assert_int_equal(coral_red_black_tree_next(node, &node), 0);
+        assert_int_equal(
+                rock_container_of(node, struct number, node)->value, i);
+    }
+    assert_int_equal(coral_red_black_tree_invalidate(&object, NULL, NULL), 0);
+}
+
+static void check_prev_error_on_node_is_null(void **state) {
+    assert_int_equal(
+            coral_red_black_tree_prev(NULL, (void *) 1),
+            CORAL_RED_BLACK_TREE_ERROR_NODE_IS_NULL);
+}
+
+static void check_prev_error_on_out_is_null(void **state) {
+    assert_int_equal(
+            coral_red_black_tree_prev((void *) 1, NULL),
+            CORAL_RED_BLACK_TREE_ERROR_OUT_IS_NULL);
+}
+
+static void check_prev_error_on_end_of_sequence(void **state) {
+    struct coral_red_black_tree object;
+    assert_int_equal(coral_red_black_tree_init(&object), 0);
+    struct number numbers[4];
+    insert_numbers(&object, numbers, 4);
+    struct coral_red_black_tree_node *node;
+    assert_int_equal(coral_red_black_tree_first(&object, &node), 0);
+    assert_int_equal(
+            coral_red_black_tree_prev(node, &node),
+            CORAL_RED_BLACK_TREE_ERROR_END_OF_SEQUENCE);
+    assert_int_equal(coral_red_black_tree_invalidate(&object, NULL, NULL), 0);
+}
+
+static void check_prev(void **state) {
+    struct coral_red_black_tree object;
+    assert_int_equal(coral_red_black_tree_init(&object), 0);
+    struct number numbers[64];
+    insert_numbers(&object, numbers, 64);
+    struct coral_red_black_tree_node *node;
+    assert_int_equal(coral_red_black_tree_last(&object, &node), 0);
+    for (uintmax_t i = 63; i > 0; i--) {
+        assert_int_equal(coral_red_black_tree_prev(node, &node), 0);
+        assert_int_equal(
+                rock_container_of(node, struct number, node)->value, i - 1);
+    }
+    assert_int_equal(coral_red_black_tree_invalidate(&object, NULL, NULL), 0);
+}
+
+static void check_rank_error_on_node_is_null(void **state) {
+    assert_int_equal(
+            coral_red_black_tree_rank(NULL, (void *) 1),
+            CORAL_RED_BLACK_TREE_ERROR_NODE_IS_NULL);
+}
+
+static void check_rank_error_on_out_is_null(void **state) {
+    assert_int_equal(
+            coral_red_black_tree_rank((void *) 1, NULL),
+            CORAL_RED_BLACK_TREE_ERROR_OUT_IS_NULL);
+}
+
+static void check_rank(void **state) {
+    struct coral_red_black_tree object;
+    assert_int_equal(coral_red_black_tree_init(&object), 0);
+    struct number numbers[64];
+    insert_numbers(&object, numbers, 64);
+    for (uintmax_t i = 0; i < 64; i++) {
+        uintmax_t rank;
+        assert_int_equal(coral_red_black_tree_rank(&numbers[i].node, &rank),
+                         0);
+        assert_int_equal(rank, numbers[i].value);
+    }
+    assert_int_equal(coral_red_black_tree_invalidate(&object, NULL, NULL), 0);
+}
+
+static void check_select_error_on_object_is_null(void **state) {
+    assert_int_equal(
+            coral_red_black_tree_select(NULL, 0, (void *) 1),
+            CORAL_RED_BLACK_TREE_ERROR_OBJECT_IS_NULL);
+}
+
+static void check_select_error_on_out_is_null(void **state) {
+    assert_int_equal(
+            coral_red_black_tree_select((void *) 1, 0, NULL),
+            CORAL_RED_BLACK_TREE_ERROR_OUT_IS_NULL);
+}
+
+static void check_select_error_on_index_is_out_of_bounds(void **state) {
+    struct coral_red_black_tree object;
+    assert_int_equal(coral_red_black_tree_init(&object), 0);
+    struct coral_red_black_tree_node *node;
+    assert_int_equal(
+            coral_red_black_tree_select(&object, 0, &node),
+            CORAL_RED_BLACK_TREE_ERROR_INDEX_IS_OUT_OF_BOUNDS);
+    struct number numbers[4];
+    insert_numbers(&object, numbers, 4);
+    assert_int_equal(
+            coral_red_black_tree_select(&object, 4, &node),
+            CORAL_RED_BLACK_TREE_ERROR_INDEX_IS_OUT_OF_BOUNDS);
+    assert_int_equal(coral_red_black_tree_invalidate(&object, NULL, NULL), 0);
+}
+
+static void check_select(void **state) {
+    struct coral_red_black_tree object;
+    assert_int_equal(coral_red_black_tree_init(&object), 0);
+    struct number numbers[64];
+    insert_numbers(&object, numbers, 64);
+    /* sizes follow the nodes through the rotations of remove */
+    for (uintmax_t i = 0; i < 64; i += 3) {
+        assert_int_equal(coral_red_black_tree_remove(
+                &object, &numbers[i].node), 0);
+        check_invariants(&object);
+    }
+    uintmax_t index = 0;
+    struct coral_red_black_tree_node *node;
+    assert_int_equal(coral_red_black_tree_first(&object, &node), 0);
+    do {
+        struct coral_red_black_tree_node *selected;
+        assert_int_equal(coral_red_black_tree_select(
+                &object, index++, &selected), 0);
+        assert_ptr_equal(selected, node);
+    } while (!coral_red_black_tree_next(node, &node));
+    assert_int_equal(index, object.count);
+    assert_int_equal(coral_red_black_tree_invalidate(&object, NULL, NULL), 0);
+}
+
+static void check_count_before_error_on_object_is_null(void **state) {
+    assert_int_equal(
+            coral_red_black_tree_count_before(NULL, (void *) 1, (void *) 1,
+                                              NULL, (void *) 1),
+            CORAL_RED_BLACK_TREE_ERROR_OBJECT_IS_NULL);
+}
+
+static void check_count_before_error_on_compare_is_null(void **state) {
+    assert_int_equal(
+            coral_red_black_tree_count_before((void *) 1, (void *) 1, NULL,
+                                              NULL, (void *) 1),
+            CORAL_RED_BLACK_TREE_ERROR_COMPARE_IS_NULL);
+}
+
+static void check_count_before_error_on_out_is_null(void **state) {
+    assert_int_equal(
+            coral_red_black_tree_count_before((void *) 1, (void *) 1,
+                                              (void *) 1, NULL, NULL),
+            CORAL_RED_BLACK_TREE_ERROR_OUT_IS_NULL);
+}
+
+static void check_count_before_error_on_node_not_found(void **state) {
+    struct coral_red_black_tree object;
+    assert_int_equal(coral_red_black_tree_init(&object), 0);
+    struct number numbers[16];
+    insert_numbers(&object, numbers, 16);
+    assert_int_equal(coral_red_black_tree_remove(
+            &object, &numbers[1].node), 0);
+    /* the count is given also for a key without a matching node */
+    uintmax_t count;
+    assert_int_equal(
+            coral_red_black_tree_count_before(
+                    &object, &numbers[1].value, compare_number, NULL,
+                    &count),
+            CORAL_RED_BLACK_TREE_ERROR_NODE_NOT_FOUND);
+    assert_int_equal(count, numbers[1].value);
+    const uintmax_t key = 100;
+    assert_int_equal(
+            coral_red_black_tree_count_before(
+                    &object, &key, compare_number, NULL, &count),
+            CORAL_RED_BLACK_TREE_ERROR_NODE_NOT_FOUND);
+    assert_int_equal(count, 15);
+    assert_int_equal(coral_red_black_tree_invalidate(&object, NULL, NULL), 0);
+}
+
+static void check_count_before(void **state) {
+    struct coral_red_black_tree object;
+    assert_int_equal(coral_red_black_tree_init(&object), 0);
+    struct number numbers[64];
+    insert_numbers(&object, numbers, 64);
+    uintmax_t compared = 0;
+    for (uintmax_t i = 0; i < 64; i++) {
+        uintmax_t count;
+        assert_int_equal(coral_red_black_tree_count_before(
+                &object, &i, compare_number, &compared, &count), 0);
+        assert_int_equal(count, i);
+    }
+    assert_true(compared >= 64);
+    assert_int_equal(coral_red_black_tree_invalidate(&object, NULL, NULL), 0);
+}
+
+struct summed {
+    struct coral_red_black_tree_node node;
+    uintmax_t value;
+    uintmax_t sum;
+};
+
+static uintmax_t sum_of(const struct coral_red_black_tree_node *const node) {
+    return node ? rock_container_of(node, struct summed, node)->sum : 0;
+}
+
+static void augment_sum(const struct coral_red_black_tree *const object,
+                        struct coral_red_black_tree_node *const node) {
+    struct summed *const A = rock_container_of(node, struct summed, node);
+    A->sum = sum_of(node->left) + A->value + sum_of(node->right);
+}
+
+static int compare_summed(const void *const key,
+                          const struct coral_red_black_tree_node *const node,
+                          void *const context) {
+    const struct summed *const B = rock_container_of(node, struct summed,
+                                                     node);
+    return seagrass_uintmax_t_compare(*(const uintmax_t *) key, B->value);
+}
+
+static uintmax_t check_sums(const struct coral_red_black_tree_node *node) {
+    if (!node) {
+        return 0;
+    }
+    const uintmax_t sum = check_sums(node->left)
+                          + rock_container_of(node, struct summed,
+                                              node)->value
+                          + check_sums(node->right);
+    assert_int_equal(sum_of(node), sum);
+    return sum;
+}
+
+static void check_init_augmented_error_on_object_is_null(void **state) {
+    assert_int_equal(
+            coral_red_black_tree_init_augmented(NULL, augment_sum),
+            CORAL_RED_BLACK_TREE_ERROR_OBJECT_IS_NULL);
+}
+
+static void check_init_augmented_error_on_augment_is_null(void **state) {
+    assert_int_equal(
+            coral_red_black_tree_init_augmented((void *) 1, NULL),
+            CORAL_RED_BLACK_TREE_ERROR_AUGMENT_IS_NULL);
+}
+
+static void check_init_augmented(void **state) {
+    struct coral_red_black_tree object;
+    assert_int_equal(coral_red_black_tree_init_augmented(
+            &object, augment_sum), 0);
+    assert_ptr_equal(object.augment, augment_sum);
+    struct summed summed[64];
+    for (uintmax_t i = 0; i < 64; i++) {
+        summed[i].value = (i * 7) % 64;
+        assert_int_equal(coral_red_black_tree_insert(
+                &object, &summed[i].value, &summed[i].node, compare_summed,
+                NULL), 0);
+        check_invariants(&object);
+        check_sums(object.root);
+    }
+    assert_int_equal(sum_of(object.root), 64 * 63 / 2);
+    for (uintmax_t i = 0; i < 64; i += 3) {
+        assert_int_equal(coral_red_black_tree_remove(
+                &object, &summed[i].node), 0);
+        check_invariants(&object);
+        check_sums(object.root);
+    }
+    assert_int_equal(coral_red_black_tree_invalidate(&object, NULL, NULL), 0);
+}
+
+static struct coral_red_black_tree_node *summed_at(const uintmax_t index,
+                                                   void *const context) {
+    struct summed *const summed = context;
+    summed[index].value = index;
+    return &summed[index].node;
+}
+
+static void check_init_augmented_case_build(void **state) {
+    struct coral_red_black_tree object;
+    assert_int_equal(coral_red_black_tree_init_augmented(
+            &object, augment_sum), 0);
+    struct summed summed[100];
+    assert_int_equal(coral_red_black_tree_build(
+            &object, 100, summed_at, summed), 0);
+    check_invariants(&object);
+    assert_int_equal(check_sums(object.root), 100 * 99 / 2);
+    assert_int_equal(coral_red_black_tree_invalidate(&object, NULL, NULL), 0);
+}
+
+static void check_propagate_error_on_object_is_null(void **state) {
+    assert_int_equal(
+            coral_red_black_tree_propagate(NULL, (void *) 1),
+            CORAL_RED_BLACK_TREE_ERROR_OBJECT_IS_NULL);
+}
+
+static void check_propagate_error_on_node_is_null(void **state) {
+    assert_int_equal(
+            coral_red_black_tree_propagate((void *) 1, NULL),
+            CORAL_RED_BLACK_TREE_ERROR_NODE_IS_NULL);
+}
+
+static void check_propagate(void **state) {
+    struct coral_red_black_tree object;
+    assert_int_equal(coral_red_black_tree_init_augmented(
+            &object, augment_sum), 0);
+    struct summed summed[16];
+    assert_int_equal(coral_red_black_tree_build(
+            &object, 16, summed_at, summed), 0);
+    /* the last node stays last so the order is unaffected */
+    summed[15].value = 100;
+    assert_int_equal(coral_red_black_tree_propagate(
+            &object, &summed[15].node), 0);
+    assert_int_equal(check_sums(object.root), 15 * 14 / 2 + 100);
+    assert_int_equal(coral_red_black_tree_invalidate(&object, NULL, NULL), 0);
+}
+
+static void check_remove_range_error_on_object_is_null(void **state) {
+    assert_int_equal(
+            coral_red_black_tree_remove_range(NULL, (void *) 1, (void *) 1,
+                                              (void *) 1, NULL, (void *) 1),
+            CORAL_RED_BLACK_TREE_ERROR_OBJECT_IS_NULL);
+}
+
+static void check_remove_range_error_on_compare_is_null(void **state) {
+    assert_int_equal(
+            coral_red_black_tree_remove_range((void *) 1, (void *) 1,
+                                              (void *) 1, NULL, NULL,
+                                              (void *) 1),
+            CORAL_RED_BLACK_TREE_ERROR_COMPARE_IS_NULL);
+}
+
+static void check_remove_range_error_on_out_is_null(void **state) {
+    assert_int_equal(
+            coral_red_black_tree_remove_range((void *) 1, (void *) 1,
+                                              (void *) 1, (void *) 1, NULL,
+                                              NULL),
+            CORAL_RED_BLACK_TREE_ERROR_OUT_IS_NULL);
+}
+
+static void check_remove_range(void **state) {
+    for (uintmax_t first = 0; first < 70; first += 3) {
+        for (uintmax_t last = 0; last < 70; last += 5) {
+            struct coral_red_black_tree object;
+            assert_int_equal(coral_red_black_tree_init(&object), 0);
+            struct number numbers[64];
+            insert_numbers(&object, numbers, 64);
+            struct coral_red_black_tree removed_tree;
+            assert_int_equal(coral_red_black_tree_remove_range(
+                    &object, &first, &last, compare_number, NULL,
+                    &removed_tree), 0);
+            check_invariants(&object);
+            check_invariants(&removed_tree);
+            const uintmax_t end = last < 63 ? last : 63;
+            const uintmax_t removed = first <= end ? 1 + end - first : 0;
+            assert_int_equal(removed_tree.count, removed);
+            for (uintmax_t i = first; i <= end; i++) {
+                struct coral_red_black_tree_node *node;
+                assert_int_equal(coral_red_black_tree_find(
+                        &removed_tree, &i, compare_number, NULL, &node), 0);
+            }
+            uintmax_t destroyed = 0;
+            assert_int_equal(coral_red_black_tree_invalidate(
+                    &removed_tree, on_destroy, &destroyed), 0);
+            assert_int_equal(destroyed, removed);
+            assert_int_equal(object.count, 64 - removed);
+            assert_int_equal(object.root ? object.root->size : 0,
+                             64 - removed);
+            for (uintmax_t i = 0; i < 64; i++) {
+                struct coral_red_black_tree_node *node;
+                assert_int_equal(
+                        coral_red_black_tree_find(
+                                &object, &i, compare_number, NULL, &node),
+                        i >= first && i <= last
+                        ? CORAL_RED_BLACK_TREE_ERROR_NODE_NOT_FOUND
+                        : 0);
+            }
+            assert_int_equal(coral_red_black_tree_invalidate(
+                    &object, NULL, NULL), 0);
+        }
+    }
+}
+
+static void check_remove_range_case_augmented(void **state) {
+    struct coral_red_black_tree object;
+    assert_int_equal(coral_red_black_tree_init_augmented(
+            &object, augment_sum), 0);
+    struct summed summed[200];
+    assert_int_equal(coral_red_black_tree_build(
+            &object, 200, summed_at, summed), 0);
+    const uintmax_t ranges[][2] = {{0, 9}, {190, 250}, {50, 50}, {20, 120}};
+    for (uintmax_t i = 0; i < 4; i++) {
+        struct coral_red_black_tree removed;
+        assert_int_equal(coral_red_black_tree_remove_range(
+                &object, &ranges[i][0], &ranges[i][1], compare_summed, NULL,
+                &removed), 0);
+        check_invariants(&object);
+        check_sums(object.root);
+        check_invariants(&removed);
+        check_sums(removed.root);
+    }
+    /* left are 10 to 19 and 121 to 189 */
+    assert_int_equal(object.count, 10 + 69);
+    assert_int_equal(check_sums(object.root),
+                     (10 + 19) * 10 / 2 + (121 + 189) * 69 / 2);
+    assert_int_equal(coral_red_black_tree_invalidate(&object, NULL, NULL), 0);
+}
+
+static void check_split_error_on_object_is_null(void **state) {
+    assert_int_equal(
+            coral_red_black_tree_split(NULL, (void *) 1, (void *) 1, NULL,
+                                       (void *) 1),
+            CORAL_RED_BLACK_TREE_ERROR_OBJECT_IS_NULL);
+}
+
+static void check_split_error_on_compare_is_null(void **state) {
+    assert_int_equal(
+            coral_red_black_tree_split((void *) 1, (void *) 1, NULL, NULL,
+                                       (void *) 1),
+            CORAL_RED_BLACK_TREE_ERROR_COMPARE_IS_NULL);
+}
+
+static void check_split_error_on_out_is_null(void **state) {
+    assert_int_equal(
+            coral_red_black_tree_split((void *) 1, (void *) 1, (void *) 1,
+                                       NULL, NULL),
+            CORAL_RED_BLACK_TREE_ERROR_OUT_IS_NULL);
+}
+
+static void check_split(void **state) {
+    for (uintmax_t key = 0; key <= 65; key++) {
+        struct coral_red_black_tree object;
+        assert_int_equal(coral_red_black_tree_init(&object), 0);
+        struct number numbers[64];
+        insert_numbers(&object, numbers, 64);
+        struct coral_red_black_tree right;
+        assert_int_equal(coral_red_black_tree_split(
+                &object, &key, compare_number, NULL, &right), 0);
+        check_invariants(&object);
+        check_invariants(&right);
+        const uintmax_t count = key < 64 ? key : 64;
+        assert_int_equal(object.count, count);
+        assert_int_equal(right.count, 64 - count);
+        for (uintmax_t i = 0; i < 64; i++) {
+            struct coral_red_black_tree_node *node;
+            assert_int_equal(
+                    coral_red_black_tree_find(
+                            i < key ? &object : &right, &i, compare_number,
+                            NULL, &node),
+                    0);
+            assert_int_equal(
+                    coral_red_black_tree_find(
+                            i < key ? &right : &object, &i, compare_number,
+                            NULL, &node),
+                    CORAL_RED_BLACK_TREE_ERROR_NODE_NOT_FOUND);
+        }
+        assert_int_equal(coral_red_black_tree_invalidate(
+                &object, NULL, NULL), 0);
+        assert_int_equal(coral_red_black_tree_invalidate(
+                &right, NULL, NULL), 0);
+    }
+}
+
+static void check_join_error_on_object_is_null(void **state) {
+    assert_int_equal(
+            coral_red_black_tree_join(NULL, (void *) 1),
+            CORAL_RED_BLACK_TREE_ERROR_OBJECT_IS_NULL);
+    assert_int_equal(
+            coral_red_black_tree_join((void *) 1, NULL),
+            CORAL_RED_BLACK_TREE_ERROR_OBJECT_IS_NULL);
+}
+
+static void check_join(void **state) {
+    for (uintmax_t at = 0; at <= 64; at++) {
+        struct coral_red_black_tree object;
+        assert_int_equal(coral_red_black_tree_init(&object), 0);
+        struct coral_red_black_tree other;
+        assert_int_equal(coral_red_black_tree_init(&other), 0);
+        struct number numbers[64];
+        for (uintmax_t i = 0; i < 64; i++) {
+            numbers[i].value = i;
+            assert_int_equal(coral_red_black_tree_insert(
+                    i < at ? &object : &other, &numbers[i].value,
+                    &numbers[i].node, compare_number, NULL), 0);
+        }
+        assert_int_equal(coral_red_black_tree_join(&object, &other), 0);
+        check_invariants(&object);
+        assert_int_equal(object.count, 64);
+        assert_int_equal(other.count, 0);
+        assert_null(other.root);
+        struct coral_red_black_tree_node *node;
+        assert_int_equal(coral_red_black_tree_first(&object, &node), 0);
+        for (uintmax_t i = 0; i < 64; i++) {
+            assert_ptr_equal(node, &numbers[i].node);
+            assert_int_equal(coral_red_black_tree_next(node, &node),
+                             i < 63
+                             ? 0
+                             : CORAL_RED_BLACK_TREE_ERROR_END_OF_SEQUENCE);
+        }
+        assert_int_equal(coral_red_black_tree_invalidate(
+                &object, NULL, NULL), 0);
+    }
+}
+
+static void check_split_case_augmented(void **state) {
+    struct coral_red_black_tree object;
+    assert_int_equal(coral_red_black_tree_init_augmented(
+            &object, augment_sum), 0);
+    struct summed summed[200];
+    assert_int_equal(coral_red_black_tree_build(
+            &object, 200, summed_at, summed), 0);
+    const uintmax_t key = 77;
+    struct coral_red_black_tree right;
+    assert_int_equal(coral_red_black_tree_split(
+            &object, &key, compare_summed, NULL, &right), 0);
+    check_invariants(&object);
+    check_invariants(&right);
+    assert_int_equal(check_sums(object.root), 77 * 76 / 2);
+    assert_int_equal(check_sums(right.root), 200 * 199 / 2 - 77 * 76 / 2);
+    assert_int_equal(coral_red_black_tree_join(&object, &right), 0);
+    check_invariants(&object);
+    assert_int_equal(check_sums(object.root), 200 * 199 / 2);
+    assert_int_equal(coral_red_black_tree_invalidate(&object, NULL, NULL), 0);
+}
+
+int main(int argc, char *argv[]) {
+    const struct CMUnitTest tests[] = {
+            cmocka_unit_test(check_node_init_error_on_node_is_null),
+            cmocka_unit_test(check_node_init),
+            cmocka_unit_test(check_init_error_on_object_is_null),
+            cmocka_unit_test(check_init),
+            cmocka_unit_test(check_invalidate_error_on_object_is_null),
+            cmocka_unit_test(check_invalidate),
+            cmocka_unit_test(check_invalidate_case_on_destroy),
+            cmocka_unit_test(check_find_error_on_object_is_null),
+            cmocka_unit_test(check_find_error_on_compare_is_null),
+            cmocka_unit_test(check_find_error_on_out_is_null),
+            cmocka_unit_test(check_find_error_on_node_not_found),
+            cmocka_unit_test(check_find),
+            cmocka_unit_test(check_insert_error_on_object_is_null),
+            cmocka_unit_test(check_insert_error_on_node_is_null),
+            cmocka_unit_test(check_insert_error_on_compare_is_null),
+            cmocka_unit_test(check_insert_error_on_node_already_exists),
+            cmocka_unit_test(check_insert),
+            cmocka_unit_test(check_attach_error_on_object_is_null),
+            cmocka_unit_test(check_attach_error_on_link_is_null),
+            cmocka_unit_test(check_attach_error_on_node_is_null),
+            cmocka_unit_test(check_attach),
+            cmocka_unit_test(check_build_error_on_object_is_null),
+            cmocka_unit_test(check_build_error_on_node_at_is_null),
+            cmocka_unit_test(check_build_error_on_tree_is_not_empty),
+            cmocka_unit_test(check_build),
+            cmocka_unit_test(check_remove_error_on_object_is_null),
+            cmocka_unit_test(check_remove_error_on_node_is_null),
+            cmocka_unit_test(check_remove),
+            cmocka_unit_test(check_first_error_on_object_is_null),
+            cmocka_unit_test(check_first_error_on_out_is_null),
+            cmocka_unit_test(check_first_error_on_tree_is_empty),
+            cmocka_unit_test(check_first),
+            cmocka_unit_test(check_last_error_on_object_is_null),
+            cmocka_unit_test(check_last_error_on_out_is_null),
+            cmocka_unit_test(check_last_error_on_tree_is_empty),
+            cmocka_unit_test(check_last),
+            cmocka_unit_test(check_next_error_on_node_is_null),
+            cmocka_unit_test(check_next_error_on_out_is_null),
+            cmocka_unit_test(check_next_error_on_end_of_sequence),
+            cmocka_unit_test(check_next),
+            cmocka_unit_test(check_prev_error_on_node_is_null),
+            cmocka_unit_test(check_prev_error_on_out_is_null),
+            cmocka_unit_test(check_prev_error_on_end_of_sequence),
+            cmocka_unit_test(check_prev),
+            cmocka_unit_test(check_rank_error_on_node_is_null),
+            cmocka_unit_test(check_rank_error_on_out_is_null),
+            cmocka_unit_test(check_rank),
+            cmocka_unit_test(check_select_error_on_object_is_null),
+            cmocka_unit_test(check_select_error_on_out_is_null),
+            cmocka_unit_test(check_select_error_on_index_is_out_of_bounds),
+            cmocka_unit_test(check_select),
+            cmocka_unit_test(check_count_before_error_on_object_is_null),
+            cmocka_unit_test(check_count_before_error_on_compare_is_null),
+            cmocka_unit_test(check_count_before_error_on_out_is_null),
+            cmocka_unit_test(check_count_before_error_on_node_not_found),
+            cmocka_unit_test(check_count_before),
+            cmocka_unit_test(check_init_augmented_error_on_object_is_null),
+            cmocka_unit_test(check_init_augmented_error_on_augment_is_null),
+            cmocka_unit_test(check_init_augmented),
+            cmocka_unit_test(check_init_augmented_case_build),
+            cmocka_unit_test(check_propagate_error_on_object_is_null),
+            cmocka_unit_test(check_propagate_error_on_node_is_null),
+            cmocka_unit_test(check_propagate),
+            cmocka_unit_test(check_remove_range_error_on_object_is_null),
+            cmocka_unit_test(check_remove_range_error_on_compare_is_null),
+            cmocka_unit_test(check_remove_range_error_on_out_is_null),
+            cmocka_unit_test(check_remove_range),
+            cmocka_unit_test(check_remove_range_case_augmented),
+            cmocka_unit_test(check_split_error_on_object_is_null),
+            cmocka_unit_test(check_split_error_on_compare_is_null),
+            cmocka_unit_test(check_split_error_on_out_is_null),
+            cmocka_unit_test(check_split),
+            cmocka_unit_test(check_join_error_on_object_is_null),
+            cmocka_unit_test(check_join),
+            cmocka_unit_test(check_split_case_augmented),
+    };
+    //cmocka_set_message_output(CM_OUTPUT_XML);
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
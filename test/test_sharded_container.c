@@ -0,0 +1,479 @@
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <setjmp.h>
+#include <stdlib.h>
+#include <pthread.h>
+#include <cmocka.h>
+#include <coral.h>
+#include <seagrass.h>
+
+#include <test/cmocka.h>
+
+static int compare(const void *a, const void *b) {
+    return seagrass_uintmax_t_ptr_compare(a, b);
+}
+
+static size_t hash(const void *a) {
+    return (size_t) *(const uintmax_t *) a;
+}
+
+static const uintmax_t bound_values[] = {100, 200, 300};
+static const void *const bounds[] = {
+        &bound_values[0],
+        &bound_values[1],
+        &bound_values[2]
+};
+
+static void check_init_with_hash_error_on_object_is_null(void **state) {
+    assert_int_equal(
+            coral_sharded_container_init_with_hash(NULL, 1, hash, compare),
+            CORAL_SHARDED_CONTAINER_ERROR_OBJECT_IS_NULL);
+}
+
+static void check_init_with_hash_error_on_shards_is_zero(void **state) {
+    struct coral_sharded_container object;
+    assert_int_equal(
+            coral_sharded_container_init_with_hash(
+                    &object, 0, hash, compare),
+            CORAL_SHARDED_CONTAINER_ERROR_SHARDS_IS_ZERO);
+}
+
+static void check_init_with_hash_error_on_hash_is_null(void **state) {
+    struct coral_sharded_container object;
+    assert_int_equal(
+            coral_sharded_container_init_with_hash(
+                    &object, 1, NULL, compare),
+            CORAL_SHARDED_CONTAINER_ERROR_HASH_IS_NULL);
+}
+
+static void check_init_with_hash_error_on_compare_is_null(void **state) {
+    struct coral_sharded_container object;
+    assert_int_equal(
+            coral_sharded_container_init_with_hash(&object, 1, hash, NULL),
+            CORAL_SHARDED_CONTAINER_ERROR_COMPARE_IS_NULL);
+}
+
+static void check_init_with_hash_error_on_memory_allocation_failed(
+        void **state) {
+    struct coral_sharded_container object;
+    posix_memalign_is_overridden = true;
+    assert_int_equal(
+            coral_sharded_container_init_with_hash(
+                    &object, 1, hash, compare),
+            CORAL_SHARDED_CONTAINER_ERROR_MEMORY_ALLOCATION_FAILED);
+    posix_memalign_is_overridden = false;
+}
+
+static void check_init_with_hash(void **state) {
+    struct coral_sharded_container object;
+    assert_int_equal(coral_sharded_container_init_with_hash(
+            &object, 8, hash, compare), 0);
+    assert_non_null(object.shards);
+    assert_int_equal(object.count, 8);
+    assert_int_equal((uintptr_t) object.shards % 64, 0);
+    assert_int_equal(sizeof(*object.shards) % 64, 0);
+    assert_int_equal(coral_sharded_container_invalidate(&object, NULL), 0);
+}
+
+static void check_init_with_bounds_error_on_object_is_null(void **state) {
+    assert_int_equal(
+            coral_sharded_container_init_with_bounds(
+                    NULL, bounds, 3, compare),
+            CORAL_SHARDED_CONTAINER_ERROR_OBJECT_IS_NULL);
+}
+
+static void check_init_with_bounds_error_on_bounds_is_null(void **state) {
+    struct coral_sharded_container object;
+    assert_int_equal(
+            coral_sharded_container_init_with_bounds(
+                    &object, NULL, 3, compare),
+            CORAL_SHARDED_CONTAINER_ERROR_BOUNDS_IS_NULL);
+}
+
+static void check_init_with_bounds_error_on_compare_is_null(void **state) {
+    struct coral_sharded_container object;
+    assert_int_equal(
+            coral_sharded_container_init_with_bounds(
+                    &object, bounds, 3, NULL),
+            CORAL_SHARDED_CONTAINER_ERROR_COMPARE_IS_NULL);
+}
+
+static void check_init_with_bounds_error_on_bounds_are_not_sorted(
+        void **state) {
+    struct coral_sharded_container object;
+    const void *const unsorted[] = {
+            &bound_values[1],
+            &bound_values[0]
+    };
+    assert_int_equal(
+            coral_sharded_container_init_with_bounds(
+                    &object, unsorted, 2, compare),
+            CORAL_SHARDED_CONTAINER_ERROR_BOUNDS_ARE_NOT_SORTED);
+}
+
+static void check_init_with_bounds(void **state) {
+    struct coral_sharded_container object;
+    assert_int_equal(coral_sharded_container_init_with_bounds(
+            &object, bounds, 3, compare), 0);
+    assert_int_equal(object.count, 4);
+    assert_int_equal(coral_sharded_container_invalidate(&object, NULL), 0);
+    assert_int_equal(coral_sharded_container_init_with_bounds(
+            &object, NULL, 0, compare), 0);
+    assert_int_equal(object.count, 1);
+    assert_int_equal(coral_sharded_container_invalidate(&object, NULL), 0);
+}
+
+static void check_invalidate_error_on_object_is_null(void **state) {
+    assert_int_equal(
+            coral_sharded_container_invalidate(NULL, NULL),
+            CORAL_SHARDED_CONTAINER_ERROR_OBJECT_IS_NULL);
+}
+
+static void check_count_error_on_object_is_null(void **state) {
+    assert_int_equal(
+            coral_sharded_container_count(NULL, (void *) 1),
+            CORAL_SHARDED_CONTAINER_ERROR_OBJECT_IS_NULL);
+}
+
+static void check_count_error_on_out_is_null(void **state) {
+    assert_int_equal(
+            coral_sharded_container_count((void *) 1, NULL),
+            CORAL_SHARDED_CONTAINER_ERROR_OUT_IS_NULL);
+}
+
+static void check_add_error_on_object_is_null(void **state) {
+    assert_int_equal(
+            coral_sharded_container_add(NULL, (void *) 1),
+            CORAL_SHARDED_CONTAINER_ERROR_OBJECT_IS_NULL);
+}
+
+static void check_add_error_on_entry_is_null(void **state) {
+    assert_int_equal(
+            coral_sharded_container_add((void *) 1, NULL),
+            CORAL_SHARDED_CONTAINER_ERROR_ENTRY_IS_NULL);
+}
+
+static void check_remove_error_on_object_is_null(void **state) {
+    assert_int_equal(
+            coral_sharded_container_remove(NULL, (void *) 1),
+            CORAL_SHARDED_CONTAINER_ERROR_OBJECT_IS_NULL);
+}
+
+static void check_remove_error_on_entry_is_null(void **state) {
+    assert_int_equal(
+            coral_sharded_container_remove((void *) 1, NULL),
+            CORAL_SHARDED_CONTAINER_ERROR_ENTRY_IS_NULL);
+}
+
+static void check_get_error_on_object_is_null(void **state) {
+    assert_int_equal(
+            coral_sharded_container_get(NULL, (void *) 1, (void *) 1),
+            CORAL_SHARDED_CONTAINER_ERROR_OBJECT_IS_NULL);
+}
+
+static void check_get_error_on_key_is_null(void **state) {
+    assert_int_equal(
+            coral_sharded_container_get((void *) 1, NULL, (void *) 1),
+            CORAL_SHARDED_CONTAINER_ERROR_KEY_IS_NULL);
+}
+
+static void check_get_error_on_out_is_null(void **state) {
+    assert_int_equal(
+            coral_sharded_container_get((void *) 1, (void *) 1, NULL),
+            CORAL_SHARDED_CONTAINER_ERROR_OUT_IS_NULL);
+}
+
+static int collect(struct coral_red_black_tree_container_entry *const entry,
+                   void *const context) {
+    uintmax_t **const out = context;
+    *(*out)++ = *(uintmax_t *) entry;
+    return 0;
+}
+
+static void check_for_each_error_on_object_is_null(void **state) {
+    assert_int_equal(
+            coral_sharded_container_for_each(NULL, collect, NULL),
+            CORAL_SHARDED_CONTAINER_ERROR_OBJECT_IS_NULL);
+}
+
+static void check_for_each_error_on_function_is_null(void **state) {
+    assert_int_equal(
+            coral_sharded_container_for_each((void *) 1, NULL, NULL),
+            CORAL_SHARDED_CONTAINER_ERROR_FUNCTION_IS_NULL);
+}
+
+static void check_for_each_error_on_memory_allocation_failed(void **state) {
+    struct coral_sharded_container object;
+    assert_int_equal(coral_sharded_container_init_with_hash(
+            &object, 4, hash, compare), 0);
+    malloc_is_overridden = true;
+    assert_int_equal(
+            coral_sharded_container_for_each(&object, collect, NULL),
+            CORAL_SHARDED_CONTAINER_ERROR_MEMORY_ALLOCATION_FAILED);
+    malloc_is_overridden = false;
+    assert_int_equal(coral_sharded_container_invalidate(&object, NULL), 0);
+}
+
+static void add_value(struct coral_sharded_container *const object,
+                      const uintmax_t value) {
+    struct coral_red_black_tree_container_entry *entry;
+    assert_int_equal(coral_red_black_tree_container_alloc(
+            sizeof(uintmax_t), &entry), 0);
+    *(uintmax_t *) entry = value;
+    assert_int_equal(coral_sharded_container_add(object, entry), 0);
+}
+
+static void check_add_get_and_remove(void **state) {
+    struct coral_sharded_container object;
+    assert_int_equal(coral_sharded_container_init_with_hash(
+            &object, 4, hash, compare), 0);
+    for (uintmax_t i = 0; i < 100; i++) {
+        add_value(&object, i);
+    }
+    uintmax_t count;
+    assert_int_equal(coral_sharded_container_count(&object, &count), 0);
+    assert_int_equal(count, 100);
+    /* every shard got some of the entries */
+    for (size_t i = 0; i < object.count; i++) {
+        assert_int_equal(coral_red_black_tree_container_count(
+                &object.shards[i].container, &count), 0);
+        assert_true(count);
+    }
+    struct coral_red_black_tree_container_entry *entry;
+    uintmax_t key = 42;
+    assert_int_equal(coral_sharded_container_get(&object, &key, &entry), 0);
+    assert_int_equal(*(uintmax_t *) entry, 42);
+    assert_int_equal(
+            coral_sharded_container_add(&object, entry),
+            CORAL_SHARDED_CONTAINER_ERROR_ENTRY_ALREADY_EXISTS);
+    assert_int_equal(coral_sharded_container_remove(&object, entry), 0);
+    assert_int_equal(
+            coral_sharded_container_remove(&object, entry),
+            CORAL_SHARDED_CONTAINER_ERROR_ENTRY_NOT_FOUND);
+    assert_int_equal(coral_red_black_tree_container_free(entry), 0);
+    assert_int_equal(
+            coral_sharded_container_get(&object, &key, &entry),
+            CORAL_SHARDED_CONTAINER_ERROR_ENTRY_NOT_FOUND);
+    /* an equal entry that is not a member leaves the member alone */
+    assert_int_equal(coral_red_black_tree_container_alloc(
+            sizeof(uintmax_t), &entry), 0);
+    *(uintmax_t *) entry = 43;
+    assert_int_equal(
+            coral_sharded_container_remove(&object, entry),
+            CORAL_SHARDED_CONTAINER_ERROR_ENTRY_NOT_FOUND);
+    assert_int_equal(coral_red_black_tree_container_free(entry), 0);
+    assert_int_equal(coral_sharded_container_count(&object, &count), 0);
+    assert_int_equal(count, 99);
+    assert_int_equal(coral_sharded_container_invalidate(&object, NULL), 0);
+}
+
+static void check_add_by_bounds(void **state) {
+    struct coral_sharded_container object;
+    assert_int_equal(coral_sharded_container_init_with_bounds(
+            &object, bounds, 3, compare), 0);
+    const uintmax_t values[] = {0, 99, 100, 150, 199, 200, 300, 1000};
+    const uintmax_t shards[] = {0, 0, 1, 1, 1, 2, 3, 3};
+    for (size_t i = 0; i < sizeof(values) / sizeof(values[0]); i++) {
+        add_value(&object, values[i]);
+        struct coral_red_black_tree_container_entry *entry;
+        assert_int_equal(coral_red_black_tree_container_get(
+                &object.shards[shards[i]].container, &values[i], &entry), 0);
+    }
+    struct coral_red_black_tree_container_entry *entry;
+    assert_int_equal(coral_sharded_container_get(
+            &object, &values[4], &entry), 0);
+    assert_int_equal(*(uintmax_t *) entry, 199);
+    assert_int_equal(coral_sharded_container_invalidate(&object, NULL), 0);
+}
+
+static void check_for_each_in_order(void **state) {
+    struct coral_sharded_container object;
+    assert_int_equal(coral_sharded_container_init_with_hash(
+            &object, 7, hash, compare), 0);
+    const uintmax_t limit = 1000;
+    for (uintmax_t i = 0; i < limit; i++) {
+        add_value(&object, (7919 * i) % limit);
+    }
+    uintmax_t *const values = malloc(limit * sizeof(uintmax_t));
+    assert_non_null(values);
+    uintmax_t *at = values;
+    assert_int_equal(coral_sharded_container_for_each(
+            &object, collect, &at), 0);
+    assert_int_equal(at - values, limit);
+    for (uintmax_t i = 0; i < limit; i++) {
+        assert_int_equal(values[i], i);
+    }
+    free(values);
+    assert_int_equal(coral_sharded_container_invalidate(&object, NULL), 0);
+}
+
+static int stop_at_ten(
+        struct coral_red_black_tree_container_entry *const entry,
+        void *const context) {
+    uintmax_t *const visited = context;
+    ++*visited;
+    return 10 == *(uintmax_t *) entry ? -1 : 0;
+}
+
+static void check_for_each_stops(void **state) {
+    struct coral_sharded_container object;
+    assert_int_equal(coral_sharded_container_init_with_bounds(
+            &object, bounds, 3, compare), 0);
+    for (uintmax_t i = 0; i < 400; i += 5) {
+        add_value(&object, i);
+    }
+    uintmax_t visited = 0;
+    assert_int_equal(
+            coral_sharded_container_for_each(&object, stop_at_ten, &visited),
+            -1);
+    assert_int_equal(visited, 3);
+    assert_int_equal(coral_sharded_container_invalidate(&object, NULL), 0);
+}
+
+static void check_for_each_on_empty(void **state) {
+    struct coral_sharded_container object;
+    assert_int_equal(coral_sharded_container_init_with_hash(
+            &object, 3, hash, compare), 0);
+    uintmax_t visited = 0;
+    assert_int_equal(coral_sharded_container_for_each(
+            &object, stop_at_ten, &visited), 0);
+    assert_int_equal(visited, 0);
+    assert_int_equal(coral_sharded_container_invalidate(&object, NULL), 0);
+}
+
+static uintmax_t destroyed_entries;
+
+static void on_destroy(
+        struct coral_red_black_tree_container_entry *const entry) {
+    destroyed_entries++;
+}
+
+static void check_invalidate_with_on_destroy(void **state) {
+    struct coral_sharded_container object;
+    assert_int_equal(coral_sharded_container_init_with_hash(
+            &object, 5, hash, compare), 0);
+    for (uintmax_t i = 0; i < 300; i++) {
+        add_value(&object, i);
+    }
+    destroyed_entries = 0;
+    assert_int_equal(coral_sharded_container_invalidate(
+            &object, on_destroy), 0);
+    assert_int_equal(destroyed_entries, 300);
+    assert_null(object.shards);
+}
+
+#define THREADS 4
+#define ROUNDS 2048
+#define VALUES 64
+
+struct worker {
+    struct coral_sharded_container *object;
+    uintmax_t index;
+};
+
+/* Each writer adds and removes values of its own, toggling each of them an
+ * even number of times, while iterating must always see them in order. */
+static void *writer(void *const argument) {
+    struct worker *const worker = argument;
+    for (uintmax_t i = 0; i < ROUNDS; i++) {
+        const uintmax_t key = (i % VALUES) * THREADS + worker->index;
+        struct coral_red_black_tree_container_entry *entry;
+        if (!coral_sharded_container_get(worker->object, &key, &entry)) {
+            seagrass_required_true(!coral_sharded_container_remove(
+                    worker->object, entry));
+            seagrass_required_true(!coral_red_black_tree_container_free(
+                    entry));
+        } else {
+            seagrass_required_true(!coral_red_black_tree_container_alloc(
+                    sizeof(uintmax_t), &entry));
+            *(uintmax_t *) entry = key;
+            seagrass_required_true(!coral_sharded_container_add(
+                    worker->object, entry));
+        }
+    }
+    return NULL;
+}
+
+static int ascending(struct coral_red_black_tree_container_entry *const entry,
+                     void *const context) {
+    uintmax_t *const last = context;
+    const uintmax_t value = *(uintmax_t *) entry;
+    seagrass_required_true(UINTMAX_MAX == *last || *last < value);
+    *last = value;
+    return 0;
+}
+
+static void *reader(void *const argument) {
+    struct worker *const worker = argument;
+    for (uintmax_t i = 0; i < ROUNDS / VALUES; i++) {
+        uintmax_t last = UINTMAX_MAX;
+        seagrass_required_true(!coral_sharded_container_for_each(
+                worker->object, ascending, &last));
+    }
+    return NULL;
+}
+
+static void check_readers_and_writers(void **state) {
+    struct coral_sharded_container object;
+    assert_int_equal(coral_sharded_container_init_with_hash(
+            &object, 8, hash, compare), 0);
+    pthread_t threads[2 * THREADS];
+    struct worker workers[2 * THREADS];
+    for (uintmax_t i = 0; i < 2 * THREADS; i++) {
+        workers[i] = (struct worker) {
+                .object = &object,
+                .index = i % THREADS
+        };
+        assert_int_equal(pthread_create(&threads[i], NULL,
+                                        i < THREADS ? writer : reader,
+                                        &workers[i]), 0);
+    }
+    for (uintmax_t i = 0; i < 2 * THREADS; i++) {
+        assert_int_equal(pthread_join(threads[i], NULL), 0);
+    }
+    uintmax_t count;
+    assert_int_equal(coral_sharded_container_count(&object, &count), 0);
+    assert_int_equal(count, 0);
+    assert_int_equal(coral_sharded_container_invalidate(&object, NULL), 0);
+}
+
+int main(int argc, char *argv[]) {
+    const struct CMUnitTest tests[] = {
+            cmocka_unit_test(check_init_with_hash_error_on_object_is_null),
+            cmocka_unit_test(check_init_with_hash_error_on_shards_is_zero),
+            cmocka_unit_test(check_init_with_hash_error_on_hash_is_null),
+            cmocka_unit_test(check_init_with_hash_error_on_compare_is_null),
+            cmocka_unit_test(
+                    check_init_with_hash_error_on_memory_allocation_failed),
+            cmocka_unit_test(check_init_with_hash),
+            cmocka_unit_test(check_init_with_bounds_error_on_object_is_null),
+            cmocka_unit_test(check_init_with_bounds_error_on_bounds_is_null),
+            cmocka_unit_test(check_init_with_bounds_error_on_compare_is_null),
+            cmocka_unit_test(
+                    check_init_with_bounds_error_on_bounds_are_not_sorted),
+            cmocka_unit_test(check_init_with_bounds),
+            cmocka_unit_test(check_invalidate_error_on_object_is_null),
+            cmocka_unit_test(check_count_error_on_object_is_null),
+            cmocka_unit_test(check_count_error_on_out_is_null),
+            cmocka_unit_test(check_add_error_on_object_is_null),
+            cmocka_unit_test(check_add_error_on_entry_is_null),
+            cmocka_unit_test(check_remove_error_on_object_is_null),
+            cmocka_unit_test(check_remove_error_on_entry_is_null),
+            cmocka_unit_test(check_get_error_on_object_is_null),
+            cmocka_unit_test(check_get_error_on_key_is_null),
+            cmocka_unit_test(check_get_error_on_out_is_null),
+            cmocka_unit_test(check_for_each_error_on_object_is_null),
+            cmocka_unit_test(check_for_each_error_on_function_is_null),
+            cmocka_unit_test(check_for_each_error_on_memory_allocation_failed),
+            cmocka_unit_test(check_add_get_and_remove),
+            cmocka_unit_test(check_add_by_bounds),
+            cmocka_unit_test(check_for_each_in_order),
+            cmocka_unit_test(check_for_each_stops),
+            cmocka_unit_test(check_for_each_on_empty),
+            cmocka_unit_test(check_invalidate_with_on_destroy),
+            cmocka_unit_test(check_readers_and_writers),
+    };
+    //cmocka_set_message_output(CM_OUTPUT_XML);
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
@@ -0,0 +1,451 @@
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <setjmp.h>
+#include <string.h>
+#include <cmocka.h>
+#include <coral.h>
+#include <seagrass.h>
+
+#include <test/cmocka.h>
+
+CORAL_TYPED_RED_BLACK_TREE_CONTAINER_DECLARE(
+        uintmax_t_tree, uintmax_t, CORAL_TYPED_RED_BLACK_TREE_CONTAINER_COMPARE)
+
+struct name {
+    char value[16];
+};
+
+static int compare_name(const struct name *const a,
+                        const struct name *const b) {
+    return strcmp(a->value, b->value);
+}
+
+CORAL_TYPED_RED_BLACK_TREE_CONTAINER_DECLARE(name_tree, struct name,
+                                             compare_name)
+
+static void add_values(struct uintmax_t_tree *const object,
+                       const uintmax_t count) {
+    for (uintmax_t i = 0; i < count; i++) {
+        const uintmax_t value = (i * 7) % count;
+        assert_int_equal(uintmax_t_tree_add(object, &value), 0);
+    }
+}
+
+static void check_init_error_on_object_is_null(void **state) {
+    assert_int_equal(
+            uintmax_t_tree_init(NULL),
+            CORAL_RED_BLACK_TREE_CONTAINER_ERROR_OBJECT_IS_NULL);
+}
+
+static void check_init(void **state) {
+    struct uintmax_t_tree object;
+    assert_int_equal(uintmax_t_tree_init(&object), 0);
+    assert_null(object.tree.root);
+    assert_int_equal(object.tree.count, 0);
+    assert_int_equal(uintmax_t_tree_invalidate(&object, NULL), 0);
+}
+
+static void check_invalidate_error_on_object_is_null(void **state) {
+    assert_int_equal(
+            uintmax_t_tree_invalidate(NULL, NULL),
+            CORAL_RED_BLACK_TREE_CONTAINER_ERROR_OBJECT_IS_NULL);
+}
+
+static uintmax_t destroyed;
+
+static void on_destroy(uintmax_t *const value) {
+    destroyed += *value;
+}
+
+static void check_invalidate(void **state) {
+    struct uintmax_t_tree object;
+    assert_int_equal(uintmax_t_tree_init(&object), 0);
+    add_values(&object, 64);
+    destroyed = 0;
+    assert_int_equal(uintmax_t_tree_invalidate(&object, on_destroy), 0);
+    assert_int_equal(destroyed, 64 * 63 / 2);
+    assert_null(object.tree.root);
+    assert_int_equal(object.tree.count, 0);
+}
+
+static void check_count_error_on_object_is_null(void **state) {
+    assert_int_equal(
+            uintmax_t_tree_count(NULL, (void *) 1),
+            CORAL_RED_BLACK_TREE_CONTAINER_ERROR_OBJECT_IS_NULL);
+}
+
+static void check_count_error_on_out_is_null(void **state) {
+    assert_int_equal(
+            uintmax_t_tree_count((void *) 1, NULL),
+            CORAL_RED_BLACK_TREE_CONTAINER_ERROR_OUT_IS_NULL);
+}
+
+static void check_count(void **state) {
+    struct uintmax_t_tree object;
+    assert_int_equal(uintmax_t_tree_init(&object), 0);
+    uintmax_t count;
+    assert_int_equal(uintmax_t_tree_count(&object, &count), 0);
+    assert_int_equal(count, 0);
+    add_values(&object, 16);
+    assert_int_equal(uintmax_t_tree_count(&object, &count), 0);
+    assert_int_equal(count, 16);
+    assert_int_equal(uintmax_t_tree_invalidate(&object, NULL), 0);
+}
+
+static void check_add_error_on_object_is_null(void **state) {
+    assert_int_equal(
+            uintmax_t_tree_add(NULL, (void *) 1),
+            CORAL_RED_BLACK_TREE_CONTAINER_ERROR_OBJECT_IS_NULL);
+}
+
+static void check_add_error_on_value_is_null(void **state) {
+    assert_int_equal(
+            uintmax_t_tree_add((void *) 1, NULL),
+            CORAL_RED_BLACK_TREE_CONTAINER_ERROR_ENTRY_IS_NULL);
+}
+
+static void check_add_error_on_entry_already_exists(void **state) {
+    struct uintmax_t_tree object;
+    assert_int_equal(uintmax_t_tree_init(&object), 0);
+    add_values(&object, 4);
+    const uintmax_t value = 2;
+    assert_int_equal(
+            uintmax_t_tree_add(&object, &value),
+            CORAL_RED_BLACK_TREE_CONTAINER_ERROR_ENTRY_ALREADY_EXISTS);
+    assert_int_equal(object.tree.count, 4);
+    assert_int_equal(uintmax_t_tree_invalidate(&object, NULL), 0);
+}
+
+static void check_add(void **state) {
+    struct uintmax_t_tree object;
+    assert_int_equal(uintmax_t_tree_init(&object), 0);
+    add_values(&object, 128);
+    assert_int_equal(object.tree.count, 128);
+    const uintmax_t *value;
+    assert_int_equal(uintmax_t_tree_first(&object, &value), 0);
+    for (uintmax_t i = 0; i < 128; i++) {
+        assert_int_equal(*value, i);
+        if (i + 1 < 128) {
+            assert_int_equal(uintmax_t_tree_next(value, &value), 0);
+        }
+    }
+    assert_int_equal(uintmax_t_tree_invalidate(&object, NULL), 0);
+}
+
+static void check_add_case_struct(void **state) {
+    struct name_tree object;
+    assert_int_equal(name_tree_init(&object), 0);
+    const struct name names[] = {{"coral"}, {"anemone"}, {"urchin"}};
+    for (uintmax_t i = 0; i < 3; i++) {
+        assert_int_equal(name_tree_add(&object, &names[i]), 0);
+    }
+    const struct name *name;
+    assert_int_equal(name_tree_first(&object, &name), 0);
+    assert_string_equal(name->value, "anemone");
+    assert_int_equal(name_tree_last(&object, &name), 0);
+    assert_string_equal(name->value, "urchin");
+    const struct name key = {"coral"};
+    assert_int_equal(name_tree_get(&object, &key, &name), 0);
+    assert_string_equal(name->value, "coral");
+    assert_ptr_not_equal(name, &names[0]);
+    assert_int_equal(name_tree_invalidate(&object, NULL), 0);
+}
+
+static void check_remove_error_on_object_is_null(void **state) {
+    assert_int_equal(
+            uintmax_t_tree_remove(NULL, (void *) 1),
+            CORAL_RED_BLACK_TREE_CONTAINER_ERROR_OBJECT_IS_NULL);
+}
+
+static void check_remove_error_on_key_is_null(void **state) {
+    assert_int_equal(
+            uintmax_t_tree_remove((void *) 1, NULL),
+            CORAL_RED_BLACK_TREE_CONTAINER_ERROR_KEY_IS_NULL);
+}
+
+static void check_remove_error_on_entry_not_found(void **state) {
+    struct uintmax_t_tree object;
+    assert_int_equal(uintmax_t_tree_init(&object), 0);
+    add_values(&object, 4);
+    const uintmax_t key = 4;
+    assert_int_equal(
+            uintmax_t_tree_remove(&object, &key),
+            CORAL_RED_BLACK_TREE_CONTAINER_ERROR_ENTRY_NOT_FOUND);
+    assert_int_equal(uintmax_t_tree_invalidate(&object, NULL), 0);
+}
+
+static void check_remove(void **state) {
+    struct uintmax_t_tree object;
+    assert_int_equal(uintmax_t_tree_init(&object), 0);
+    add_values(&object, 128);
+    for (uintmax_t i = 0; i < 128; i++) {
+        const uintmax_t key = (i * 5) % 128;
+        assert_int_equal(uintmax_t_tree_remove(&object, &key), 0);
+        bool contains;
+        assert_int_equal(uintmax_t_tree_contains(&object, &key, &contains),
+                         0);
+        assert_false(contains);
+        assert_int_equal(object.tree.count, 127 - i);
+    }
+    assert_null(object.tree.root);
+    assert_int_equal(uintmax_t_tree_invalidate(&object, NULL), 0);
+}
+
+static void check_contains_error_on_object_is_null(void **state) {
+    assert_int_equal(
+            uintmax_t_tree_contains(NULL, (void *) 1, (void *) 1),
+            CORAL_RED_BLACK_TREE_CONTAINER_ERROR_OBJECT_IS_NULL);
+}
+
+static void check_contains_error_on_key_is_null(void **state) {
+    assert_int_equal(
+            uintmax_t_tree_contains((void *) 1, NULL, (void *) 1),
+            CORAL_RED_BLACK_TREE_CONTAINER_ERROR_KEY_IS_NULL);
+}
+
+static void check_contains_error_on_out_is_null(void **state) {
+    assert_int_equal(
+            uintmax_t_tree_contains((void *) 1, (void *) 1, NULL),
+            CORAL_RED_BLACK_TREE_CONTAINER_ERROR_OUT_IS_NULL);
+}
+
+static void check_contains(void **state) {
+    struct uintmax_t_tree object;
+    assert_int_equal(uintmax_t_tree_init(&object), 0);
+    add_values(&object, 16);
+    for (uintmax_t i = 0; i < 32; i++) {
+        bool contains;
+        assert_int_equal(uintmax_t_tree_contains(&object, &i, &contains), 0);
+        assert_int_equal(contains, i < 16);
+    }
+    assert_int_equal(uintmax_t_tree_invalidate(&object, NULL), 0);
+}
+
+static void check_get_error_on_object_is_null(void **state) {
+    assert_int_equal(
+            uintmax_t_tree_get(NULL, (void *) 1, (void *) 1),
+            CORAL_RED_BLACK_TREE_CONTAINER_ERROR_OBJECT_IS_NULL);
+}
+
+static void check_get_error_on_key_is_null(void **state) {
+    assert_int_equal(
+            uintmax_t_tree_get((void *) 1, NULL, (void *) 1),
+            CORAL_RED_BLACK_TREE_CONTAINER_ERROR_KEY_IS_NULL);
+}
+
+static void check_get_error_on_out_is_null(void **state) {
+    assert_int_equal(
+            uintmax_t_tree_get((void *) 1, (void *) 1, NULL),
+            CORAL_RED_BLACK_TREE_CONTAINER_ERROR_OUT_IS_NULL);
+}
+
+static void check_get_error_on_entry_not_found(void **state) {
+    struct uintmax_t_tree object;
+    assert_int_equal(uintmax_t_tree_init(&object), 0);
+    add_values(&object, 4);
+    const uintmax_t key = 4;
+    const uintmax_t *value;
+    assert_int_equal(
+            uintmax_t_tree_get(&object, &key, &value),
+            CORAL_RED_BLACK_TREE_CONTAINER_ERROR_ENTRY_NOT_FOUND);
+    assert_int_equal(uintmax_t_tree_invalidate(&object, NULL), 0);
+}
+
+static void check_get(void **state) {
+    struct uintmax_t_tree object;
+    assert_int_equal(uintmax_t_tree_init(&object), 0);
+    add_values(&object, 16);
+    for (uintmax_t i = 0; i < 16; i++) {
+        const uintmax_t *value;
+        assert_int_equal(uintmax_t_tree_get(&object, &i, &value), 0);
+        assert_int_equal(*value, i);
+    }
+    assert_int_equal(uintmax_t_tree_invalidate(&object, NULL), 0);
+}
+
+static void check_first_error_on_object_is_null(void **state) {
+    assert_int_equal(
+            uintmax_t_tree_first(NULL, (void *) 1),
+            CORAL_RED_BLACK_TREE_CONTAINER_ERROR_OBJECT_IS_NULL);
+}
+
+static void check_first_error_on_out_is_null(void **state) {
+    assert_int_equal(
+            uintmax_t_tree_first((void *) 1, NULL),
+            CORAL_RED_BLACK_TREE_CONTAINER_ERROR_OUT_IS_NULL);
+}
+
+static void check_first_error_on_container_is_empty(void **state) {
+    struct uintmax_t_tree object;
+    assert_int_equal(uintmax_t_tree_init(&object), 0);
+    const uintmax_t *value;
+    assert_int_equal(
+            uintmax_t_tree_first(&object, &value),
+            CORAL_RED_BLACK_TREE_CONTAINER_ERROR_CONTAINER_IS_EMPTY);
+    assert_int_equal(uintmax_t_tree_invalidate(&object, NULL), 0);
+}
+
+static void check_first(void **state) {
+    struct uintmax_t_tree object;
+    assert_int_equal(uintmax_t_tree_init(&object), 0);
+    add_values(&object, 16);
+    const uintmax_t *value;
+    assert_int_equal(uintmax_t_tree_first(&object, &value), 0);
+    assert_int_equal(*value, 0);
+    assert_int_equal(uintmax_t_tree_invalidate(&object, NULL), 0);
+}
+
+static void check_last_error_on_object_is_null(void **state) {
+    assert_int_equal(
+            uintmax_t_tree_last(NULL, (void *) 1),
+            CORAL_RED_BLACK_TREE_CONTAINER_ERROR_OBJECT_IS_NULL);
+}
+
+static void check_last_error_on_out_is_null(void **state) {
+    assert_int_equal(
+            uintmax_t_tree_last((void *) 1, NULL),
+            CORAL_RED_BLACK_TREE_CONTAINER_ERROR_OUT_IS_NULL);
+}
+
+static void check_last_error_on_container_is_empty(void **state) {
+    struct uintmax_t_tree object;
+    assert_int_equal(uintmax_t_tree_init(&object), 0);
+    const uintmax_t *value;
+    assert_int_equal(
+            uintmax_t_tree_last(&object, &value),
+            CORAL_RED_BLACK_TREE_CONTAINER_ERROR_CONTAINER_IS_EMPTY);
+    assert_int_equal(uintmax_t_tree_invalidate(&object, NULL), 0);
+}
+
+static void check_last(void **state) {
+    struct uintmax_t_tree object;
+    assert_int_equal(uintmax_t_tree_init(&object), 0);
+    add_values(&object, 16);
+    const uintmax_t *value;
+    assert_int_equal(uintmax_t_tree_last(&object, &value), 0);
+    assert_int_equal(*value, 15);
+    assert_int_equal(uintmax_t_tree_invalidate(&object, NULL), 0);
+}
+
+static void check_next_error_on_value_is_null(void **state) {
+    assert_int_equal(
+            uintmax_t_tree_next(NULL, (void *) 1),
+            CORAL_RED_BLACK_TREE_CONTAINER_ERROR_ENTRY_IS_NULL);
+}
+
+static void check_next_error_on_out_is_null(void **state) {
+    assert_int_equal(
+            uintmax_t_tree_next((void *) 1, NULL),
+            CORAL_RED_BLACK_TREE_CONTAINER_ERROR_OUT_IS_NULL);
+}
+
+static void check_next_error_on_end_of_sequence(void **state) {
+    struct uintmax_t_tree object;
+    assert_int_equal(uintmax_t_tree_init(&object), 0);
+    add_values(&object, 4);
+    const uintmax_t *value;
+    assert_int_equal(uintmax_t_tree_last(&object, &value), 0);
+    assert_int_equal(
+            uintmax_t_tree_next(value, &value),
+            CORAL_RED_BLACK_TREE_CONTAINER_ERROR_END_OF_SEQUENCE);
+    assert_int_equal(uintmax_t_tree_invalidate(&object, NULL), 0);
+}
+
+static void check_next(void **state) {
+    struct uintmax_t_tree object;
+    assert_int_equal(uintmax_t_tree_init(&object), 0);
+    add_values(&object, 16);
+    const uintmax_t *value;
+    assert_int_equal(uintmax_t_tree_first(&object, &value), 0);
+    for (uintmax_t i = 1; i < 16; i++) {
+        assert_int_equal(uintmax_t_tree_next(value, &value), 0);
+        assert_int_equal(*value, i);
+    }
+    assert_int_equal(uintmax_t_tree_invalidate(&object, NULL), 0);
+}
+
+static void check_prev_error_on_value_is_null(void **state) {
+    assert_int_equal(
+            uintmax_t_tree_prev(NULL, (void *) 1),
+            CORAL_RED_BLACK_TREE_CONTAINER_ERROR_ENTRY_IS_NULL);
+}
+
+static void check_prev_error_on_out_is_null(void **state) {
+    assert_int_equal(
+            uintmax_t_tree_prev((void *) 1, NULL),
+            CORAL_RED_BLACK_TREE_CONTAINER_ERROR_OUT_IS_NULL);
+}
+
+static void check_prev_error_on_end_of_sequence(void **state) {
+    struct uintmax_t_tree object;
+    assert_int_equal(uintmax_t_tree_init(&object), 0);
+    add_values(&object, 4);
+    const uintmax_t *value;
+    assert_int_equal(uintmax_t_tree_first(&object, &value), 0);
+    assert_int_equal(
+            uintmax_t_tree_prev(value, &value),
+            CORAL_RED_BLACK_TREE_CONTAINER_ERROR_END_OF_SEQUENCE);
+    assert_int_equal(uintmax_t_tree_invalidate(&object, NULL), 0);
+}
+
+static void check_prev(void **state) {
+    struct uintmax_t_tree object;
+    assert_int_equal(uintmax_t_tree_init(&object), 0);
+    add_values(&object, 16);
+    const uintmax_t *value;
+    assert_int_equal(uintmax_t_tree_last(&object, &value), 0);
+    for (uintmax_t i = 15; i > 0; i--) {
+        assert_int_equal(uintmax_t_tree_prev(value, &value), 0);
+        assert_int_equal(*value, i - 1);
+    }
+    assert_int_equal(uintmax_t_tree_invalidate(&object, NULL), 0);
+}
+
+int main(int argc, char *argv[]) {
+    const struct CMUnitTest tests[] = {
+            cmocka_unit_test(check_init_error_on_object_is_null),
+            cmocka_unit_test(check_init),
+            cmocka_unit_test(check_invalidate_error_on_object_is_null),
+            cmocka_unit_test(check_invalidate),
+            cmocka_unit_test(check_count_error_on_object_is_null),
+            cmocka_unit_test(check_count_error_on_out_is_null),
+            cmocka_unit_test(check_count),
+            cmocka_unit_test(check_add_error_on_object_is_null),
+            cmocka_unit_test(check_add_error_on_value_is_null),
+            cmocka_unit_test(check_add_error_on_entry_already_exists),
+            cmocka_unit_test(check_add),
+            cmocka_unit_test(check_add_case_struct),
+            cmocka_unit_test(check_remove_error_on_object_is_null),
+            cmocka_unit_test(check_remove_error_on_key_is_null),
+            cmocka_unit_test(check_remove_error_on_entry_not_found),
+            cmocka_unit_test(check_remove),
+            cmocka_unit_test(check_contains_error_on_object_is_null),
+            cmocka_unit_test(check_contains_error_on_key_is_null),
+            cmocka_unit_test(check_contains_error_on_out_is_null),
+            cmocka_unit_test(check_contains),
+            cmocka_unit_test(check_get_error_on_object_is_null),
+            cmocka_unit_test(check_get_error_on_key_is_null),
+            cmocka_unit_test(check_get_error_on_out_is_null),
+            cmocka_unit_test(check_get_error_on_entry_not_found),
+            cmocka_unit_test(check_get),
+            cmocka_unit_test(check_first_error_on_object_is_null),
+            cmocka_unit_test(check_first_error_on_out_is_null),
+            cmocka_unit_test(check_first_error_on_container_is_empty),
+            cmocka_unit_test(check_first),
+            cmocka_unit_test(check_last_error_on_object_is_null),
+            cmocka_unit_test(check_last_error_on_out_is_null),
+            cmocka_unit_test(check_last_error_on_container_is_empty),
+            cmocka_unit_test(check_last),
+            cmocka_unit_test(check_next_error_on_value_is_null),
+            cmocka_unit_test(check_next_error_on_out_is_null),
+            cmocka_unit_test(check_next_error_on_end_of_sequence),
+            cmocka_unit_test(check_next),
+            cmocka_unit_test(check_prev_error_on_value_is_null),
+            cmocka_unit_test(check_prev_error_on_out_is_null),
+            cmocka_unit_test(check_prev_error_on_end_of_sequence),
+            cmocka_unit_test(check_prev),
+    };
+    //cmocka_set_message_output(CM_OUTPUT_XML);
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}